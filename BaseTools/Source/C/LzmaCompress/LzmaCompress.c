@@ -22,11 +22,18 @@
 #include "Sdk/C/LzmaDec.h"
 #include "Sdk/C/LzmaEnc.h"
 #include "Sdk/C/Bra.h"
+#include "Sdk/C/Threads.h"
 #include "CommonLib.h"
 #include "ParseInf.h"
 
 #define LZMA_HEADER_SIZE (LZMA_PROPS_SIZE + 8)
 
+//
+// Upper bound of --threads and of the number of files in one invocation.
+//
+#define MAX_THREADS 64
+#define MAX_FILES   1024
+
 typedef enum {
   NoConverter,
   X86Converter,
@@ -42,6 +49,26 @@ const char *kInvalidParamValMessage = "Invalid parameter value";
 static BoolInt mQuietMode = False;
 static CONVERTER_TYPE mConType = NoConverter;
 
+//
+// One input/output file pair. Every pair is compressed into an independent
+// LZMA stream, so several pairs can be processed in parallel.
+//
+typedef struct {
+  const char *inputFile;
+  const char *outputFile;
+  SRes res;
+  const char *errorMessage;
+} LZMA_FILE_JOB;
+
+typedef struct {
+  LZMA_FILE_JOB *jobs;
+  unsigned numJobs;
+  unsigned nextJob;
+  int encodeMode;
+  CLzmaEncProps props;
+  CCriticalSection cs;
+} LZMA_JOB_QUEUE;
+
 UINT64 mDictionarySize = 28;
 UINT64 mCompressionMode = 2;
 
@@ -55,10 +82,15 @@ void PrintHelp(char *buffer)
   strcat(buffer,
       "\n" UTILITY_NAME " - " INTEL_COPYRIGHT "\n"
       "Based on LZMA Utility " MY_VERSION_COPYRIGHT_DATE "\n"
-      "\nUsage:  LzmaCompress -e|-d [options] <inputFile>\n"
+      "\nUsage:  LzmaCompress -e|-d [options] <inputFile> [<inputFile> ...]\n"
              "  -e: encode file\n"
              "  -d: decode file\n"
              "  -o FileName, --output FileName: specify the output filename\n"
+             "     Several input files may be given, each paired in order with one -o\n"
+             "     output; every file is processed as an independent stream\n"
+             "  --threads N: use up to N threads, default: 2. 1 selects the single\n"
+             "     threaded match finder; 2 or more select the multithreaded match\n"
+             "     finder and process several input files in parallel\n"
              "  --f86: enable converter for x86 code\n"
              "  -v, --verbose: increase output messages\n"
              "  -q, --quiet: reduce output messages\n"
@@ -238,21 +270,11 @@ Done:
   return res;
 }
 
-int main2(int numArgs, const char *args[], char *rs)
+static void ProcessFile(LZMA_FILE_JOB *job, int encodeMode, CLzmaEncProps *props)
 {
   CFileSeqInStream inStream;
   CFileOutStream outStream;
-  int res;
-  int encodeMode = 0;
-  BoolInt modeWasSet = False;
-  const char *inputFile = NULL;
-  const char *outputFile = "file.tmp";
-  int param;
   UInt64 fileSize;
-  CLzmaEncProps props;
-
-  LzmaEncProps_Init(&props);
-  LzmaEncProps_Normalize(&props);
 
   FileSeqInStream_CreateVTable(&inStream);
   File_Construct(&inStream.file);
@@ -260,6 +282,102 @@ int main2(int numArgs, const char *args[], char *rs)
   FileOutStream_CreateVTable(&outStream);
   File_Construct(&outStream.file);
 
+  if (InFile_Open(&inStream.file, job->inputFile) != 0) {
+    job->errorMessage = "Can not open input file";
+    return;
+  }
+
+  if (OutFile_Open(&outStream.file, job->outputFile) != 0) {
+    File_Close(&inStream.file);
+    job->errorMessage = "Can not open output file";
+    return;
+  }
+
+  File_GetLength(&inStream.file, &fileSize);
+
+  if (encodeMode)
+    job->res = Encode(&outStream.vt, &inStream.vt, fileSize, props);
+  else
+    job->res = Decode(&outStream.vt, &inStream.vt, fileSize);
+
+  File_Close(&outStream.file);
+  File_Close(&inStream.file);
+}
+
+static THREAD_FUNC_DECL JobThread(void *param)
+{
+  LZMA_JOB_QUEUE *queue = (LZMA_JOB_QUEUE *)param;
+  CLzmaEncProps props = queue->props;
+  unsigned index;
+
+  for (;;) {
+    CriticalSection_Enter(&queue->cs);
+    index = queue->nextJob;
+    if (index < queue->numJobs)
+      queue->nextJob++;
+    CriticalSection_Leave(&queue->cs);
+
+    if (index >= queue->numJobs)
+      break;
+
+    ProcessFile(&queue->jobs[index], queue->encodeMode, &props);
+  }
+  return 0;
+}
+
+//
+// Processes all jobs with numWorkers threads, including the calling thread.
+// Jobs are claimed in order, so the work is balanced even if the files differ
+// in size. If a thread cannot be created, the remaining threads take over its
+// share.
+//
+static void ProcessJobs(LZMA_JOB_QUEUE *queue, unsigned numWorkers)
+{
+  CThread threads[MAX_THREADS];
+  unsigned i;
+
+  if (numWorkers > 1 && CriticalSection_Init(&queue->cs) != 0)
+    numWorkers = 1;
+
+  if (numWorkers <= 1) {
+    for (i = 0; i < queue->numJobs; i++)
+      ProcessFile(&queue->jobs[i], queue->encodeMode, &queue->props);
+    return;
+  }
+
+  for (i = 1; i < numWorkers; i++) {
+    Thread_Construct(&threads[i]);
+    Thread_Create(&threads[i], JobThread, queue);
+  }
+
+  JobThread(queue);
+
+  for (i = 1; i < numWorkers; i++) {
+    if (Thread_WasCreated(&threads[i])) {
+      Thread_Wait(&threads[i]);
+      Thread_Close(&threads[i]);
+    }
+  }
+
+  CriticalSection_Delete(&queue->cs);
+}
+
+int main2(int numArgs, const char *args[], char *rs)
+{
+  static LZMA_FILE_JOB jobs[MAX_FILES];
+  LZMA_JOB_QUEUE queue;
+  int encodeMode = 0;
+  BoolInt modeWasSet = False;
+  unsigned numInputs = 0;
+  unsigned numOutputs = 0;
+  unsigned numWorkers;
+  UInt64 numThreads = 0;
+  int param;
+  unsigned i;
+
+  LzmaEncProps_Init(&queue.props);
+  LzmaEncProps_Normalize(&queue.props);
+
   if (numArgs == 1)
   {
     PrintHelp(rs);
@@ -277,7 +395,18 @@ int main2(int numArgs, const char *args[], char *rs)
       if (numArgs < (param + 2)) {
         return PrintUserError(rs);
       }
-      outputFile = args[++param];
+      if (numOutputs == MAX_FILES) {
+        return PrintError(rs, "Too many output files");
+      }
+      jobs[numOutputs++].outputFile = args[++param];
+    } else if (strcmp(args[param], "--threads") == 0) {
+      if (numArgs < (param + 2)) {
+        return PrintUserError(rs);
+      }
+      if ((AsciiStringToUint64(args[++param], FALSE, &numThreads) != EFI_SUCCESS) ||
+          (numThreads == 0) || (numThreads > MAX_THREADS)) {
+        return PrintError(rs, kInvalidParamValMessage);
+      }
     } else if (strcmp(args[param], "--debug") == 0) {
       if (numArgs < (param + 2)) {
         return PrintUserError(rs);
@@ -290,7 +419,7 @@ int main2(int numArgs, const char *args[], char *rs)
     } else if (strcmp(args[param], "-a") == 0) {
       AsciiStringToUint64(args[param + 1],FALSE,&mCompressionMode);
       if ((mCompressionMode == 0)||(mCompressionMode == 1)){
-        props.algo = (int)mCompressionMode;
+        queue.props.algo = (int)mCompressionMode;
         param++;
         continue;
       } else {
@@ -300,9 +429,9 @@ int main2(int numArgs, const char *args[], char *rs)
       AsciiStringToUint64(args[param + 1],FALSE,&mDictionarySize);
       if (mDictionarySize <= 27) {
         if (mDictionarySize == 0) {
-          props.dictSize = 0;
+          queue.props.dictSize = 0;
         } else {
-          props.dictSize = (1 << mDictionarySize);
+          queue.props.dictSize = (1 << mDictionarySize);
         }
         param++;
         continue;
@@ -331,17 +460,27 @@ int main2(int numArgs, const char *args[], char *rs)
     } else if (strcmp(args[param], "--version") == 0) {
       PrintVersion(rs);
       return 0;
-    } else if (inputFile == NULL) {
-      inputFile = args[param];
+    } else if (numInputs < MAX_FILES) {
+      jobs[numInputs++].inputFile = args[param];
     } else {
-      return PrintUserError(rs);
+      return PrintError(rs, "Too many input files");
     }
   }
 
-  if ((inputFile == NULL) || !modeWasSet) {
+  if ((numInputs == 0) || !modeWasSet) {
     return PrintUserError(rs);
   }
 
+  //
+  // A single input file keeps the historical default output name. Several
+  // input files need one output file each.
+  //
+  if ((numInputs == 1) && (numOutputs == 0)) {
+    jobs[0].outputFile = "file.tmp";
+  } else if (numInputs != numOutputs) {
+    return PrintError(rs, "Every input file needs one output file");
+  }
+
   {
     size_t t4 = sizeof(UInt32);
     size_t t8 = sizeof(UInt64);
@@ -349,45 +488,50 @@ int main2(int numArgs, const char *args[], char *rs)
       return PrintError(rs, "Incorrect UInt32 or UInt64");
   }
 
-  if (InFile_Open(&inStream.file, inputFile) != 0)
-    return PrintError(rs, "Can not open input file");
-
-  if (OutFile_Open(&outStream.file, outputFile) != 0) {
-    File_Close(&inStream.file);
-    return PrintError(rs, "Can not open output file");
+  //
+  // Without --threads the encoder keeps the LZMA SDK default of two match
+  // finder threads. Extra threads go to parallel files first; the match
+  // finder thread is used only if every file worker can get one. The match
+  // finder produces the same stream either way, so the output does not
+  // depend on the thread count.
+  //
+  if (numThreads == 0)
+    numThreads = queue.props.numThreads;
+
+  numWorkers = (unsigned)numThreads;
+  if (numWorkers > numInputs)
+    numWorkers = numInputs;
+
+  queue.props.numThreads = (numThreads >= 2 * (UInt64)numWorkers) ? 2 : 1;
+  queue.jobs = jobs;
+  queue.numJobs = numInputs;
+  queue.nextJob = 0;
+  queue.encodeMode = encodeMode;
+
+  if (!mQuietMode) {
+    printf(encodeMode ? "Encoding\n" : "Decoding\n");
   }
 
-  File_GetLength(&inStream.file, &fileSize);
+  ProcessJobs(&queue, numWorkers);
 
-  if (encodeMode)
-  {
-    if (!mQuietMode) {
-      printf("Encoding\n");
-    }
-    res = Encode(&outStream.vt, &inStream.vt, fileSize, &props);
-  }
-  else
-  {
-    if (!mQuietMode) {
-      printf("Decoding\n");
-    }
-    res = Decode(&outStream.vt, &inStream.vt, fileSize);
-  }
+  for (i = 0; i < numInputs; i++) {
+    SRes res = jobs[i].res;
 
-  File_Close(&outStream.file);
-  File_Close(&inStream.file);
+    if (jobs[i].errorMessage != NULL)
+      return PrintError(rs, jobs[i].errorMessage);
 
-  if (res != SZ_OK)
-  {
-    if (res == SZ_ERROR_MEM)
-      return PrintError(rs, kCantAllocateMessage);
-    else if (res == SZ_ERROR_DATA)
-      return PrintError(rs, kDataErrorMessage);
-    else if (res == SZ_ERROR_WRITE)
-      return PrintError(rs, kCantWriteMessage);
-    else if (res == SZ_ERROR_READ)
-      return PrintError(rs, kCantReadMessage);
-    return PrintErrorNumber(rs, res);
+    if (res != SZ_OK)
+    {
+      if (res == SZ_ERROR_MEM)
+        return PrintError(rs, kCantAllocateMessage);
+      else if (res == SZ_ERROR_DATA)
+        return PrintError(rs, kDataErrorMessage);
+      else if (res == SZ_ERROR_WRITE)
+        return PrintError(rs, kCantWriteMessage);
+      else if (res == SZ_ERROR_READ)
+        return PrintError(rs, kCantReadMessage);
+      return PrintErrorNumber(rs, res);
+    }
   }
   return 0;
 }
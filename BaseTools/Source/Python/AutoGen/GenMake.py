@@ -1623,6 +1623,12 @@ class TopLevelMakefile(BuildFile):
             ExtraOption += " -c"
         if not GlobalData.gEnableGenfdsMultiThread:
             ExtraOption += " --no-genfds-multi-thread"
+        if not GlobalData.gEnableFfsCache:
+            ExtraOption += " --no-ffs-cache"
+        if GlobalData.gFfsCacheDir:
+            ExtraOption += " --ffs-cache " + GlobalData.gFfsCacheDir
+        if not GlobalData.gEnableInProcessTools:
+            ExtraOption += " --no-in-process-tools"
         if GlobalData.gIgnoreSource:
             ExtraOption += " --ignore-sources"
 
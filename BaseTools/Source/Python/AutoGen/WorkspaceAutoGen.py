@@ -899,6 +899,9 @@ class WorkspaceAutoGen(AutoGen):
             FdsCommandDict["quiet"] = True
 
         FdsCommandDict["GenfdsMultiThread"] = GlobalData.gEnableGenfdsMultiThread
+        FdsCommandDict["NoFfsCache"] = not GlobalData.gEnableFfsCache
+        FdsCommandDict["FfsCacheDir"] = GlobalData.gFfsCacheDir
+        FdsCommandDict["NoInProcessTools"] = not GlobalData.gEnableInProcessTools
         if GlobalData.gIgnoreSource:
             FdsCommandDict["IgnoreSources"] = True
 
@@ -119,6 +119,9 @@ gModuleAllCacheStatus = None
 gModuleCacheHit = None
 
 gEnableGenfdsMultiThread = True
+gEnableFfsCache = True
+gFfsCacheDir = None
+gEnableInProcessTools = True
 gSikpAutoGenCache = set()
 # Common lock for the file access in multiple process AutoGens
 file_lock = None
@@ -0,0 +1,196 @@
+## @file
+# Run a section, FFS or image tool from the makefile of a module through the
+# GenFds FFS cache and the in-process section and FFS generators
+#
+#  Copyright (c) 2026, Intel Corporation. All rights reserved.<BR>
+#
+#  SPDX-License-Identifier: BSD-2-Clause-Patent
+#
+
+##
+# Import Modules
+#
+from __future__ import print_function
+import sys
+import subprocess
+from optparse import OptionParser
+import Common.LongFilePathOs as os
+import Common.EdkLogger as EdkLogger
+from Common.BuildToolError import FatalError
+from Common.BuildVersion import gBUILD_VERSION
+from GenFds.FfsCache import FfsCache
+from GenFds.InProcessTools import InProcessTools
+
+# Version and Copyright
+__version_number__ = ("0.10" + " " + gBUILD_VERSION)
+__version__ = "%prog Version " + __version_number__
+__copyright__ = "Copyright (c) 2026, Intel Corporation. All rights reserved."
+
+## Parse the command line of GenSec for InProcessTools.GenerateSection()
+#
+#   @param  Args            Arguments of GenSec
+#
+#   @retval tuple           (Output, Input, Type)
+#   @retval None            The options are not handled in process
+#
+def ParseGenSec(Args):
+    Output = None
+    Type = None
+    Input = []
+    Index = 0
+    while Index < len(Args):
+        Arg = Args[Index]
+        if Arg in ('-o', '-s'):
+            if Index + 1 >= len(Args):
+                return None
+            if Arg == '-o':
+                Output = Args[Index + 1]
+            else:
+                Type = Args[Index + 1]
+            Index += 2
+        elif Arg.startswith('-'):
+            return None
+        else:
+            Input.append(Arg)
+            Index += 1
+    if not Output:
+        return None
+    return Output, Input, Type
+
+## Parse the command line of GenFfs for InProcessTools.GenerateFfs()
+#
+#   Optional section files that do not exist are dropped like GenFfs does.
+#
+#   @param  Args            Arguments of GenFfs
+#
+#   @retval tuple           (Output, Input, Type, Guid, Fixed, CheckSum, Align, SectionAlign)
+#   @retval None            The options are not handled in process
+#
+def ParseGenFfs(Args):
+    Output = None
+    Type = None
+    Guid = None
+    Align = None
+    Fixed = False
+    CheckSum = False
+    Input = []
+    SectionAlign = []
+    Skipped = False
+    Index = 0
+    while Index < len(Args):
+        Arg = Args[Index]
+        if Arg == '-x':
+            Fixed = True
+            Index += 1
+            continue
+        if Arg == '-s':
+            CheckSum = True
+            Index += 1
+            continue
+        if Arg not in ('-o', '-t', '-g', '-a', '-i', '-oi', '-n') or Index + 1 >= len(Args):
+            return None
+        Value = Args[Index + 1]
+        Index += 2
+        if Arg == '-o':
+            Output = Value
+        elif Arg == '-t':
+            Type = Value
+        elif Arg == '-g':
+            Guid = Value
+        elif Arg == '-a':
+            Align = Value
+        elif Arg == '-n':
+            #
+            # GenFfs rejects the alignment of a skipped optional file.
+            #
+            if Skipped or not Input or SectionAlign[-1] is not None:
+                return None
+            SectionAlign[-1] = Value
+        elif Arg == '-oi' and not os.path.exists(Value):
+            Skipped = True
+        else:
+            Skipped = False
+            Input.append(Value)
+            SectionAlign.append(None)
+    if not Output or not Type or not Guid:
+        return None
+    return Output, Input, Type, Guid, Fixed, CheckSum, Align, SectionAlign
+
+## Generate the output of a GenSec or GenFfs command line in process
+#
+#   @param  Cmd             Command line of the tool, tool name first
+#
+#   @retval True            The output was generated
+#   @retval False           The tool must be run
+#
+def RunInProcess(Cmd):
+    ToolName = os.path.splitext(os.path.basename(Cmd[0]))[0]
+    try:
+        if ToolName == 'GenSec':
+            Args = ParseGenSec(Cmd[1:])
+            return Args is not None and InProcessTools.GenerateSection(*Args)
+        if ToolName == 'GenFfs':
+            Args = ParseGenFfs(Cmd[1:])
+            return Args is not None and InProcessTools.GenerateFfs(*Args)
+    except FatalError:
+        return False
+    return False
+
+## Run a tool, or restore its output from the FFS cache
+#
+#   @param  Cmd             Command line of the tool, tool name first
+#
+#   @retval int             Exit status of the tool
+#
+def RunCached(Cmd):
+    Output = None
+    for Index in range(1, len(Cmd) - 1):
+        if Cmd[Index] == '-o':
+            Output = Cmd[Index + 1]
+    Key = None
+    if Output:
+        Key = FfsCache.GetKey(Cmd, Output)
+    if Key and FfsCache.Restore(Key, Output):
+        return 0
+    #
+    # Tools found through BinWrappers\WindowsLike are batch files.
+    #
+    try:
+        Status = subprocess.call(Cmd, shell=(sys.platform == "win32"))
+    except OSError as X:
+        print("FfsCacheTool: cannot run %s: %s" % (Cmd[0], X), file=sys.stderr)
+        return 1
+    if Key and Status == 0:
+        FfsCache.Save(Key, Output)
+    return Status
+
+def Options():
+    Parser = OptionParser(description=__copyright__, version=__version__, prog="FfsCacheTool",
+                          usage="%prog [options] Tool [ToolOptions]")
+    Parser.add_option("--cache-dir", action="store", type="string", dest="CacheDir",
+                      help="Directory of the FFS cache. The tool is run without the cache if it is not specified.")
+    Parser.add_option("--no-in-process", action="store_true", dest="NoInProcess", default=False,
+                      help="Always run GenSec and GenFfs instead of generating their output in process.")
+    #
+    # Everything from the tool name on belongs to the tool.
+    #
+    Parser.disable_interspersed_args()
+    Options, Cmd = Parser.parse_args()
+    if not Cmd:
+        Parser.error("no tool specified")
+    return Options, Cmd
+
+def Main():
+    EdkLogger.Initialize()
+    EdkLogger.SetLevel(EdkLogger.QUIET)
+    CommandOptions, Cmd = Options()
+    if not CommandOptions.NoInProcess and RunInProcess(Cmd):
+        return 0
+    FfsCache.SetDir(CommandOptions.CacheDir)
+    return RunCached(Cmd)
+
+if __name__ == '__main__':
+    r = Main()
+    ## 0-127 is a safe return range, and 1 is a standard default error
+    if r < 0 or r > 127: r = 1
+    sys.exit(r)
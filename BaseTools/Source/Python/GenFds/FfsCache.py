@@ -0,0 +1,253 @@
+## @file
+# Content-addressed cache of the files generated by the section, FFS and
+# compression tools that GenFds calls
+#
+#  Copyright (c) 2026, Intel Corporation. All rights reserved.<BR>
+#
+#  SPDX-License-Identifier: BSD-2-Clause-Patent
+#
+
+##
+# Import Modules
+#
+from __future__ import absolute_import
+import hashlib
+import shutil
+from os import getpid
+import Common.LongFilePathOs as os
+from Common import EdkLogger
+from Common.LongFilePathSupport import CopyLongFilePath
+from Common.LongFilePathSupport import OpenLongFilePath as open
+
+## Content-addressed cache of tool outputs
+#
+#  A cache entry is keyed on the tool, its options and the contents of every
+#  file passed on its command line, so an output is reused whenever a tool is
+#  called again with byte-identical inputs, even if the inputs were rewritten
+#  or moved to a different build directory. The output file itself is never
+#  part of the key.
+#
+#  Only tools whose sole output is the file given to "-o" may be cached.
+#
+#  The tool is identified by the contents of the program that actually runs,
+#  not of the BaseTools/BinWrappers script found on PATH, so that rebuilding a
+#  tool invalidates its entries. For Python tools every file in the tool's
+#  directory is part of the key, which covers default keys such as the test
+#  signing keys of Rsa2048Sha256Sign and Pkcs7Sign.
+#
+class FfsCache:
+    #
+    # Bump when the key layout changes to invalidate existing caches.
+    #
+    CACHE_VERSION = b'GenFds FFS cache 2\0'
+
+    #
+    # The least recently used entries are removed once the cache grows
+    # beyond this size.
+    #
+    MAX_SIZE = 0x40000000
+
+    CacheDir = None
+    Hits = 0
+    Misses = 0
+
+    #
+    # Digest of every hashed file, keyed on its path, size and modification
+    # time, so that files passed to several tools are read once per run.
+    #
+    _FileDigest = {}
+
+    #
+    # Digest of every tool, keyed on its name.
+    #
+    _ToolDigest = {}
+
+    ## Select the cache directory
+    #
+    #   @param  CacheDir        Directory that holds the cache entries, or
+    #                           None to disable the cache
+    #
+    @staticmethod
+    def SetDir(CacheDir):
+        FfsCache.CacheDir = CacheDir
+        FfsCache.Hits = 0
+        FfsCache.Misses = 0
+        FfsCache._FileDigest = {}
+        FfsCache._ToolDigest = {}
+
+    @staticmethod
+    def _HashFile(FileName):
+        Stat = os.stat(FileName)
+        StatKey = (FileName, Stat.st_size, Stat.st_mtime)
+        Digest = FfsCache._FileDigest.get(StatKey)
+        if Digest is None:
+            Hash = hashlib.sha256()
+            with open(FileName, 'rb') as File:
+                for Chunk in iter(lambda: File.read(0x100000), b''):
+                    Hash.update(Chunk)
+            Digest = Hash.hexdigest()
+            FfsCache._FileDigest[StatKey] = Digest
+        return Digest
+
+    ## Find the files that make up a tool
+    #
+    #   A BinWrappers script is followed the way it finds the program it runs:
+    #   the C tool binary in Conf/BaseToolsCBinaries or Source/C/bin, or the
+    #   Python tool directory in Source/Python.
+    #
+    #   @param  ToolPath        Path of the tool found on PATH
+    #
+    #   @retval list            The files whose contents identify the tool
+    #
+    @staticmethod
+    def _ToolFiles(ToolPath):
+        WrapperDir = os.path.dirname(os.path.realpath(ToolPath))
+        if os.path.basename(os.path.dirname(WrapperDir)) != 'BinWrappers':
+            return [ToolPath]
+
+        Name = os.path.splitext(os.path.basename(ToolPath))[0]
+        BaseToolsDir = os.path.dirname(os.path.dirname(WrapperDir))
+        Files = [ToolPath]
+        CBinDirs = []
+        if os.environ.get('WORKSPACE'):
+            CBinDirs.append(os.path.join(os.environ['WORKSPACE'], 'Conf', 'BaseToolsCBinaries'))
+        if os.environ.get('EDK_TOOLS_PATH'):
+            CBinDirs.append(os.path.join(os.environ['EDK_TOOLS_PATH'], 'Source', 'C', 'bin'))
+        CBinDirs.append(os.path.join(BaseToolsDir, 'Source', 'C', 'bin'))
+        for CBinDir in CBinDirs:
+            if os.path.isfile(os.path.join(CBinDir, Name)):
+                Files.append(os.path.join(CBinDir, Name))
+                break
+
+        PythonDir = os.path.join(BaseToolsDir, 'Source', 'Python', Name)
+        for Root, Dirs, Names in os.walk(PythonDir):
+            Dirs[:] = sorted(Dir for Dir in Dirs if Dir != '__pycache__')
+            Files += [os.path.join(Root, FileName) for FileName in sorted(Names) if not FileName.endswith('.pyc')]
+        return Files
+
+    @staticmethod
+    def _HashTool(ToolName):
+        Digest = FfsCache._ToolDigest.get(ToolName)
+        if Digest is None:
+            ToolPath = shutil.which(ToolName)
+            if ToolPath is None:
+                return None
+            Hash = hashlib.sha256()
+            for FileName in FfsCache._ToolFiles(ToolPath):
+                Hash.update(('%s:%s\0' % (os.path.basename(FileName), FfsCache._HashFile(FileName))).encode('utf-8'))
+            Digest = Hash.hexdigest()
+            FfsCache._ToolDigest[ToolName] = Digest
+        return Digest
+
+    @staticmethod
+    def _EntryPath(Key):
+        return os.path.join(FfsCache.CacheDir, Key[:2], Key)
+
+    ## Compute the cache key of a tool invocation
+    #
+    #   @param  Cmd             Command line of the tool, tool name first
+    #   @param  Output          Output file given on the command line
+    #
+    #   @retval string          The cache key
+    #   @retval None            The cache is disabled or the tool was not found
+    #
+    @staticmethod
+    def GetKey(Cmd, Output):
+        if not FfsCache.CacheDir:
+            return None
+
+        try:
+            #
+            # A rebuilt tool may generate different output for the same input.
+            #
+            ToolDigest = FfsCache._HashTool(Cmd[0])
+            if ToolDigest is None:
+                return None
+            Hash = hashlib.sha256(FfsCache.CACHE_VERSION)
+            Hash.update(('tool:%s\0' % ToolDigest).encode('utf-8'))
+            for Arg in Cmd[1:]:
+                if Arg == Output:
+                    Item = 'output'
+                elif os.path.isfile(Arg):
+                    Item = 'file:' + FfsCache._HashFile(Arg)
+                else:
+                    Item = 'arg:' + Arg
+                Hash.update(Item.encode('utf-8') + b'\0')
+        except (IOError, OSError):
+            return None
+        return Hash.hexdigest()
+
+    ## Restore the output of a cached tool invocation
+    #
+    #   @param  Key             Key returned by GetKey()
+    #   @param  Output          Path the cached output is copied to
+    #
+    #   @retval True            Output was restored from the cache
+    #   @retval False           Key is not in the cache
+    #
+    @staticmethod
+    def Restore(Key, Output):
+        Entry = FfsCache._EntryPath(Key)
+        if not os.path.isfile(Entry):
+            FfsCache.Misses += 1
+            return False
+        try:
+            CopyLongFilePath(Entry, Output)
+            #
+            # Mark the entry as recently used for Prune().
+            #
+            os.utime(Entry, None)
+        except (IOError, OSError) as X:
+            EdkLogger.debug(EdkLogger.DEBUG_5, "Cannot restore %s from FFS cache: %s" % (Output, X))
+            FfsCache.Misses += 1
+            return False
+        FfsCache.Hits += 1
+        return True
+
+    ## Add the output of a tool invocation to the cache
+    #
+    #   The entry is written to a temporary file first and renamed, so that
+    #   several GenFds processes may share one cache directory.
+    #
+    #   @param  Key             Key returned by GetKey()
+    #   @param  Output          Output file generated by the tool
+    #
+    @staticmethod
+    def Save(Key, Output):
+        Entry = FfsCache._EntryPath(Key)
+        TempEntry = '%s.%d.tmp' % (Entry, getpid())
+        try:
+            if not os.path.isdir(os.path.dirname(Entry)):
+                os.makedirs(os.path.dirname(Entry))
+            CopyLongFilePath(Output, TempEntry)
+            os.replace(TempEntry, Entry)
+        except (IOError, OSError) as X:
+            EdkLogger.debug(EdkLogger.DEBUG_5, "Cannot add %s to FFS cache: %s" % (Output, X))
+
+    ## Remove the least recently used entries beyond MAX_SIZE
+    #
+    @staticmethod
+    def Prune():
+        if not FfsCache.CacheDir or not os.path.isdir(FfsCache.CacheDir):
+            return
+        Entries = []
+        TotalSize = 0
+        for Root, Dirs, Names in os.walk(FfsCache.CacheDir):
+            for FileName in Names:
+                Entry = os.path.join(Root, FileName)
+                try:
+                    Stat = os.stat(Entry)
+                except (IOError, OSError):
+                    continue
+                Entries.append((Stat.st_mtime, Stat.st_size, Entry))
+                TotalSize += Stat.st_size
+        if TotalSize <= FfsCache.MAX_SIZE:
+            return
+        for Time, Size, Entry in sorted(Entries):
+            try:
+                os.remove(Entry)
+            except (IOError, OSError):
+                continue
+            TotalSize -= Size
+            if TotalSize <= FfsCache.MAX_SIZE:
+                break
@@ -34,6 +34,7 @@ from Workspace.WorkspaceDatabase import WorkspaceDatabase
 
 from .FdfParser import FdfParser, Warning
 from .GenFdsGlobalVariable import GenFdsGlobalVariable
+from .FfsCache import FfsCache
 from .FfsFileStatement import FileStatement
 import Common.DataType as DataType
 from struct import Struct
@@ -94,6 +95,9 @@ def resetFdsGlobalVariable():
     GenFdsGlobalVariable.CopyList   = []
     GenFdsGlobalVariable.ModuleFile = ''
     GenFdsGlobalVariable.EnableGenfdsMultiThread = True
+    GenFdsGlobalVariable.EnableFfsCache = True
+    GenFdsGlobalVariable.FfsCacheDir = None
+    GenFdsGlobalVariable.EnableInProcessTools = True
 
     GenFdsGlobalVariable.LargeFileInFvFlags = []
     GenFdsGlobalVariable.EFI_FIRMWARE_FILE_SYSTEM3_GUID = '5473C07A-3DCB-4dca-BD6F-1E9689E7349A'
@@ -142,6 +146,10 @@ def GenFdsApi(FdsCommandDict, WorkSpaceDataBase=None):
                 GenFdsGlobalVariable.EnableGenfdsMultiThread = True
             else:
                 GenFdsGlobalVariable.EnableGenfdsMultiThread = False
+            GenFdsGlobalVariable.EnableFfsCache = not FdsCommandDict.get("NoFfsCache")
+            if FdsCommandDict.get("FfsCacheDir"):
+                GenFdsGlobalVariable.FfsCacheDir = os.path.normpath(os.path.join(Workspace, FdsCommandDict.get("FfsCacheDir")))
+            GenFdsGlobalVariable.EnableInProcessTools = not FdsCommandDict.get("NoInProcessTools")
         os.chdir(GenFdsGlobalVariable.WorkSpaceDir)
 
         # set multiple workspace
@@ -369,6 +377,9 @@ def GenFdsApi(FdsCommandDict, WorkSpaceDataBase=None):
 
         """Call GenFds"""
         GenFds.GenFd('', FdfParserObj, BuildWorkSpace, ArchList)
+        if FfsCache.CacheDir:
+            GenFdsGlobalVariable.VerboseLogger("FFS cache %s: %d hits, %d misses" % (FfsCache.CacheDir, FfsCache.Hits, FfsCache.Misses))
+            FfsCache.Prune()
 
         """Generate GUID cross reference file"""
         GenFds.GenerateGuidXRefFile(BuildWorkSpace, ArchList, FdfParserObj)
@@ -407,6 +418,9 @@ def OptionsToCommandDict(Options):
     FdsCommandDict["debug"] = Options.debug
     FdsCommandDict["Workspace"] = Options.Workspace
     FdsCommandDict["GenfdsMultiThread"] = not Options.NoGenfdsMultiThread
+    FdsCommandDict["NoFfsCache"] = Options.NoFfsCache
+    FdsCommandDict["FfsCacheDir"] = Options.FfsCacheDir
+    FdsCommandDict["NoInProcessTools"] = Options.NoInProcessTools
     FdsCommandDict["fdf_file"] = [PathClass(Options.filename)] if Options.filename else []
     FdsCommandDict["build_target"] = Options.BuildTarget
     FdsCommandDict["toolchain_tag"] = Options.ToolChain
@@ -465,6 +479,9 @@ def myOptionParser():
     Parser.add_option("--pcd", action="append", dest="OptionPcd", help="Set PCD value by command line. Format: \"PcdName=Value\" ")
     Parser.add_option("--genfds-multi-thread", action="store_true", dest="GenfdsMultiThread", default=True, help="Enable GenFds multi thread to generate ffs file.")
     Parser.add_option("--no-genfds-multi-thread", action="store_true", dest="NoGenfdsMultiThread", default=False, help="Disable GenFds multi thread to generate ffs file.")
+    Parser.add_option("--ffs-cache", action="store", type="string", dest="FfsCacheDir", help="Enable the FFS cache of section, FFS and compression tool outputs in the specified directory.")
+    Parser.add_option("--no-ffs-cache", action="store_true", dest="NoFfsCache", default=False, help="Disable the FFS cache even if --ffs-cache is specified.")
+    Parser.add_option("--no-in-process-tools", action="store_true", dest="NoInProcessTools", default=False, help="Always run GenSec and GenFfs instead of generating plain sections and FFS files in process.")
 
     Options, _ = Parser.parse_args()
     return Options
@@ -33,6 +33,8 @@ from Common.MultipleWorkspace import MultipleWorkspace as mws
 import Common.GlobalData as GlobalData
 from Common.BuildToolError import *
 from AutoGen.AutoGen import CalculatePriorityValue
+from .FfsCache import FfsCache
+from .InProcessTools import InProcessTools
 
 ## Global variables
 #
@@ -73,6 +75,9 @@ class GenFdsGlobalVariable:
     CopyList   = []
     ModuleFile = ''
     EnableGenfdsMultiThread = True
+    EnableFfsCache = True
+    FfsCacheDir = None
+    EnableInProcessTools = True
 
     #
     # The list whose element are flags to indicate if large FFS or SECTION files exist in FV.
@@ -288,6 +293,10 @@ class GenFdsGlobalVariable:
         GenFdsGlobalVariable.FfsDir = os.path.join(GenFdsGlobalVariable.FvDir, 'Ffs')
         if not os.path.exists(GenFdsGlobalVariable.FfsDir):
             os.makedirs(GenFdsGlobalVariable.FfsDir)
+        if GenFdsGlobalVariable.EnableFfsCache and GenFdsGlobalVariable.FfsCacheDir:
+            FfsCache.SetDir(GenFdsGlobalVariable.FfsCacheDir)
+        else:
+            FfsCache.SetDir(None)
 
         #
         # Create FV Address inf file
@@ -332,6 +341,11 @@ class GenFdsGlobalVariable:
         GenFdsGlobalVariable.ActivePlatform = GlobalData.gActivePlatform
         GenFdsGlobalVariable.ConfDir  = GlobalData.gConfDirectory
         GenFdsGlobalVariable.EnableGenfdsMultiThread = GlobalData.gEnableGenfdsMultiThread
+        GenFdsGlobalVariable.EnableFfsCache = GlobalData.gEnableFfsCache
+        GenFdsGlobalVariable.FfsCacheDir = None
+        if GlobalData.gFfsCacheDir:
+            GenFdsGlobalVariable.FfsCacheDir = os.path.normpath(os.path.join(GlobalData.gWorkspace, GlobalData.gFfsCacheDir))
+        GenFdsGlobalVariable.EnableInProcessTools = GlobalData.gEnableInProcessTools
         for Arch in ArchList:
             GenFdsGlobalVariable.OutputDirDict[Arch] = os.path.normpath(
                 os.path.join(GlobalData.gWorkspace,
@@ -461,6 +475,7 @@ class GenFdsGlobalVariable:
                 else:
                     Cmd += ("-n", '"' + Ui + '"')
                 Cmd += ("-o", Output)
+                Cmd = GenFdsGlobalVariable.MakefileCmd(Cmd)
                 if ' '.join(Cmd).strip() not in GenFdsGlobalVariable.SecCmdList:
                     GenFdsGlobalVariable.SecCmdList.append(' '.join(Cmd).strip())
             else:
@@ -496,18 +511,20 @@ class GenFdsGlobalVariable:
 
             SaveFileOnChange(CommandFile, ' '.join(Cmd), False)
             if IsMakefile:
+                Cmd = GenFdsGlobalVariable.MakefileCmd(Cmd)
                 if ' '.join(Cmd).strip() not in GenFdsGlobalVariable.SecCmdList:
                     GenFdsGlobalVariable.SecCmdList.append(' '.join(Cmd).strip())
             else:
                 if not GenFdsGlobalVariable.NeedsUpdate(Output, list(Input) + [CommandFile]):
                     return
-                GenFdsGlobalVariable.CallExternalTool(Cmd, "Failed to generate section")
+                GenFdsGlobalVariable.CallCachedTool(Cmd, Output, "Failed to generate section")
         else:
             Cmd += ("-o", Output)
             Cmd += Input
 
             SaveFileOnChange(CommandFile, ' '.join(Cmd), False)
             if IsMakefile:
+                Cmd = GenFdsGlobalVariable.MakefileCmd(Cmd)
                 if sys.platform == "win32":
                     Cmd = ['if', 'exist', Input[0]] + Cmd
                 else:
@@ -516,7 +533,14 @@ class GenFdsGlobalVariable:
                     GenFdsGlobalVariable.SecCmdList.append(' '.join(Cmd).strip())
             elif GenFdsGlobalVariable.NeedsUpdate(Output, list(Input) + [CommandFile]):
                 GenFdsGlobalVariable.DebugLogger(EdkLogger.DEBUG_5, "%s needs update because of newer %s" % (Output, Input))
-                GenFdsGlobalVariable.CallExternalTool(Cmd, "Failed to generate section")
+                #
+                # Leaf and plain concatenated sections are generated without
+                # starting GenSec.
+                #
+                if (CompressionType or Guid or DummyFile or GuidHdrLen or GuidAttr or InputAlign or
+                    not GenFdsGlobalVariable.EnableInProcessTools or
+                    not InProcessTools.GenerateSection(Output, Input, Type)):
+                    GenFdsGlobalVariable.CallCachedTool(Cmd, Output, "Failed to generate section")
                 if (os.path.getsize(Output) >= GenFdsGlobalVariable.LARGE_FILE_SIZE and
                     GenFdsGlobalVariable.LargeFileInFvFlags):
                     GenFdsGlobalVariable.LargeFileInFvFlags[-1] = True
@@ -565,6 +589,7 @@ class GenFdsGlobalVariable:
 
         GenFdsGlobalVariable.DebugLogger(EdkLogger.DEBUG_5, "%s needs update because of newer %s" % (Output, Input))
         if MakefilePath:
+            Cmd = GenFdsGlobalVariable.MakefileCmd(Cmd)
             if (tuple(Cmd), tuple(GenFdsGlobalVariable.SecCmdList), tuple(GenFdsGlobalVariable.CopyList)) not in GenFdsGlobalVariable.FfsCmdDict:
                 GenFdsGlobalVariable.FfsCmdDict[tuple(Cmd), tuple(GenFdsGlobalVariable.SecCmdList), tuple(GenFdsGlobalVariable.CopyList)] = MakefilePath
             GenFdsGlobalVariable.SecCmdList = []
@@ -572,7 +597,9 @@ class GenFdsGlobalVariable:
         else:
             if not GenFdsGlobalVariable.NeedsUpdate(Output, list(Input) + [CommandFile]):
                 return
-            GenFdsGlobalVariable.CallExternalTool(Cmd, "Failed to generate FFS")
+            if (not GenFdsGlobalVariable.EnableInProcessTools or
+                not InProcessTools.GenerateFfs(Output, Input, Type, Guid, Fixed, CheckSum, Align, SectionAlign)):
+                GenFdsGlobalVariable.CallCachedTool(Cmd, Output, "Failed to generate FFS")
 
     @staticmethod
     def GenerateFirmwareVolume(Output, Input, BaseAddress=None, ForceRebase=None, Capsule=False, Dump=False,
@@ -638,10 +665,14 @@ class GenFdsGlobalVariable:
         Cmd += ("-o", Output)
         Cmd += Input
         if IsMakefile:
+            if not Replace:
+                Cmd = GenFdsGlobalVariable.MakefileCmd(Cmd)
             if " ".join(Cmd).strip() not in GenFdsGlobalVariable.SecCmdList:
                 GenFdsGlobalVariable.SecCmdList.append(" ".join(Cmd).strip())
-        else:
+        elif Replace:
             GenFdsGlobalVariable.CallExternalTool(Cmd, "Failed to generate firmware image")
+        else:
+            GenFdsGlobalVariable.CallCachedTool(Cmd, Output, "Failed to generate firmware image")
 
     @staticmethod
     def GenerateOptionRom(Output, EfiInput, BinaryInput, Compress=False, ClassCode=None,
@@ -697,10 +728,56 @@ class GenFdsGlobalVariable:
         Cmd += ("-o", Output)
         Cmd += Input
         if IsMakefile:
+            Cmd = GenFdsGlobalVariable.MakefileCmd(Cmd)
             if " ".join(Cmd).strip() not in GenFdsGlobalVariable.SecCmdList:
                 GenFdsGlobalVariable.SecCmdList.append(" ".join(Cmd).strip())
         else:
-            GenFdsGlobalVariable.CallExternalTool(Cmd, "Failed to call " + ToolPath, returnValue)
+            GenFdsGlobalVariable.CallCachedTool(Cmd, Output, "Failed to call " + ToolPath, returnValue)
+
+    ## MakefileCmd()
+    #
+    #   Run a command of the module makefile through FfsCacheTool when the FFS
+    #   cache is enabled, so that the FFS files generated by make also use the
+    #   cache and the in-process section and FFS generators. Without the cache
+    #   the tool is run directly, as starting Python for every section costs
+    #   more than GenSec and GenFfs themselves.
+    #
+    #   @param  Cmd             Command line of a tool whose only output is
+    #                           the file given to "-o"
+    #
+    #   @retval list            The command line to put in the makefile
+    #
+    @staticmethod
+    def MakefileCmd(Cmd):
+        if not GenFdsGlobalVariable.EnableFfsCache or not GenFdsGlobalVariable.FfsCacheDir:
+            return Cmd
+        Wrapper = ["FfsCacheTool", "--cache-dir", GenFdsGlobalVariable.FfsCacheDir]
+        if not GenFdsGlobalVariable.EnableInProcessTools:
+            Wrapper.append("--no-in-process")
+        return Wrapper + list(Cmd)
+
+    ## CallCachedTool()
+    #
+    #   Call a tool whose only output is the file Output, or restore the output
+    #   of an earlier call with the same tool, options and input contents from
+    #   the FFS cache.
+    #
+    #   @param  cmd             Command line of the tool
+    #   @param  Output          Output file of the tool
+    #   @param  errorMess       Error message if the tool fails
+    #   @param  returnValue     Same as for CallExternalTool()
+    #
+    @staticmethod
+    def CallCachedTool (cmd, Output, errorMess, returnValue=[]):
+        Key = FfsCache.GetKey(cmd, Output)
+        if Key and FfsCache.Restore(Key, Output):
+            GenFdsGlobalVariable.DebugLogger(EdkLogger.DEBUG_5, "%s restored from FFS cache" % Output)
+            if returnValue != []:
+                returnValue[0] = 0
+            return
+        GenFdsGlobalVariable.CallExternalTool(cmd, errorMess, returnValue)
+        if Key and (returnValue == [] or returnValue[0] == 0):
+            FfsCache.Save(Key, Output)
 
     @staticmethod
     def CallExternalTool (cmd, errorMess, returnValue=[]):
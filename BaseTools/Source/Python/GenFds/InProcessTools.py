@@ -0,0 +1,357 @@
+## @file
+# In-process generation of plain sections and FFS files
+#
+#  Copyright (c) 2026, Intel Corporation. All rights reserved.<BR>
+#
+#  SPDX-License-Identifier: BSD-2-Clause-Patent
+#
+
+##
+# Import Modules
+#
+from __future__ import absolute_import
+from struct import pack, unpack_from
+import Common.LongFilePathOs as os
+from Common import EdkLogger
+from Common.BuildToolError import FILE_CREATE_FAILURE
+from Common.Misc import PackGUID
+from Common.LongFilePathSupport import OpenLongFilePath as open
+
+MAX_SECTION_SIZE = 0x1000000
+MAX_FFS_SIZE = 0x1000000
+
+EFI_SECTION_COMPRESSION = 0x01
+EFI_SECTION_GUID_DEFINED = 0x02
+EFI_SECTION_PE32 = 0x10
+EFI_SECTION_TE = 0x12
+EFI_SECTION_VERSION = 0x14
+EFI_SECTION_USER_INTERFACE = 0x15
+EFI_SECTION_FIRMWARE_VOLUME_IMAGE = 0x17
+EFI_SECTION_FREEFORM_SUBTYPE_GUID = 0x18
+EFI_SECTION_RAW = 0x19
+
+EFI_GUIDED_SECTION_PROCESSING_REQUIRED = 0x01
+EFI_TE_IMAGE_HEADER_SIGNATURE = 0x5A56
+EFI_TE_IMAGE_HEADER_SIZE = 40
+
+FFS_ATTRIB_LARGE_FILE = 0x01
+FFS_ATTRIB_DATA_ALIGNMENT2 = 0x02
+FFS_ATTRIB_FIXED = 0x04
+FFS_ATTRIB_CHECKSUM = 0x40
+FFS_FIXED_CHECKSUM = 0xAA
+EFI_FILE_STATE = 0x07
+
+EFI_FFS_SECTION_ALIGNMENT_PADDING_GUID = '04132C8D-0A22-4FA8-826E-8BBFEFDB836C'
+
+#
+# Section types that GenSec generates as plain leaf sections, indexed like
+# mSectionTypeName[] in GenSec.c.
+#
+LeafSectionType = {
+    'EFI_SECTION_PE32'                  : 0x10,
+    'EFI_SECTION_PIC'                   : 0x11,
+    'EFI_SECTION_TE'                    : 0x12,
+    'EFI_SECTION_DXE_DEPEX'             : 0x13,
+    'EFI_SECTION_COMPATIBILITY16'       : 0x16,
+    'EFI_SECTION_FIRMWARE_VOLUME_IMAGE' : 0x17,
+    'EFI_SECTION_RAW'                   : 0x19,
+    'EFI_SECTION_PEI_DEPEX'             : 0x1B,
+    'EFI_SECTION_SMM_DEPEX'             : 0x1C
+}
+
+FfsFileType = {
+    'EFI_FV_FILETYPE_RAW'                   : 0x01,
+    'EFI_FV_FILETYPE_FREEFORM'              : 0x02,
+    'EFI_FV_FILETYPE_SECURITY_CORE'         : 0x03,
+    'EFI_FV_FILETYPE_PEI_CORE'              : 0x04,
+    'EFI_FV_FILETYPE_DXE_CORE'              : 0x05,
+    'EFI_FV_FILETYPE_PEIM'                  : 0x06,
+    'EFI_FV_FILETYPE_DRIVER'                : 0x07,
+    'EFI_FV_FILETYPE_COMBINED_PEIM_DRIVER'  : 0x08,
+    'EFI_FV_FILETYPE_APPLICATION'           : 0x09,
+    'EFI_FV_FILETYPE_SMM'                   : 0x0A,
+    'EFI_FV_FILETYPE_FIRMWARE_VOLUME_IMAGE' : 0x0B,
+    'EFI_FV_FILETYPE_COMBINED_SMM_DXE'      : 0x0C,
+    'EFI_FV_FILETYPE_SMM_CORE'              : 0x0D,
+    'EFI_FV_FILETYPE_MM_STANDALONE'         : 0x0E,
+    'EFI_FV_FILETYPE_MM_CORE_STANDALONE'    : 0x0F
+}
+
+AlignName = [
+    "1", "2", "4", "8", "16", "32", "64", "128", "256", "512",
+    "1K", "2K", "4K", "8K", "16K", "32K", "64K", "128K", "256K",
+    "512K", "1M", "2M", "4M", "8M", "16M"
+    ]
+
+FfsValidAlignName = [
+    "8", "16", "128", "512", "1K", "4K", "32K", "64K", "128K", "256K",
+    "512K", "1M", "2M", "4M", "8M", "16M"
+    ]
+
+FfsValidAlign = [0, 8, 16, 128, 512, 1024, 4096, 32768, 65536, 131072, 262144,
+                 524288, 1048576, 2097152, 4194304, 8388608, 16777216]
+
+## Generate plain sections and FFS files without launching GenSec and GenFfs
+#
+#  The generated files are byte-identical to the output of GenSec and GenFfs.
+#  Every method returns False, without touching the output file, for options
+#  and inputs it does not handle, including every input that makes the tools
+#  fail; the caller then runs the tool, which also reports the error.
+#
+class InProcessTools:
+
+    @staticmethod
+    def _ReadFiles(FileList):
+        DataList = []
+        for FileName in FileList:
+            if not os.path.isfile(FileName):
+                return None
+            with open(FileName, 'rb') as File:
+                DataList.append(File.read())
+        return DataList
+
+    @staticmethod
+    def _WriteFile(Output, DataList):
+        try:
+            with open(Output, 'wb') as File:
+                for Data in DataList:
+                    File.write(Data)
+        except IOError as X:
+            EdkLogger.error("GenFds", FILE_CREATE_FAILURE, ExtraData='IOError %s' % X)
+
+    @staticmethod
+    def _Checksum8(Data):
+        return (0x100 - (sum(bytearray(Data)) & 0xFF)) & 0xFF
+
+    ## Generate a section like GenSec does
+    #
+    #   Handles the common leaf sections built from one input file, and the
+    #   concatenation of several section files when no section type is given.
+    #
+    #   @param  Output          Path of the section file to generate
+    #   @param  Input           List of input files
+    #   @param  Type            Section type name, or None
+    #
+    #   @retval True            The section was generated
+    #   @retval False           GenSec must be called instead
+    #
+    @staticmethod
+    def GenerateSection(Output, Input, Type):
+        if not Input:
+            return False
+
+        if Type:
+            SectionType = LeafSectionType.get(Type.upper())
+            if SectionType is None or len(Input) != 1:
+                return False
+
+        DataList = InProcessTools._ReadFiles(Input)
+        if DataList is None:
+            return False
+
+        if not Type:
+            #
+            # Every section starts on a DWORD boundary.
+            #
+            Buffer = bytearray()
+            for Data in DataList:
+                Buffer += bytearray(-len(Buffer) & 0x03)
+                Buffer += Data
+            if not Buffer:
+                return False
+            InProcessTools._WriteFile(Output, [Buffer])
+            return True
+
+        Data = DataList[0]
+        TotalLength = 4 + len(Data)
+        if TotalLength < MAX_SECTION_SIZE:
+            Header = pack('<3BB', TotalLength & 0xFF, (TotalLength >> 8) & 0xFF, (TotalLength >> 16) & 0xFF, SectionType)
+        else:
+            TotalLength = 8 + len(Data)
+            if TotalLength > 0xFFFFFFFF:
+                return False
+            Header = pack('<3BBI', 0xFF, 0xFF, 0xFF, SectionType, TotalLength)
+        InProcessTools._WriteFile(Output, [Header, Data])
+        return True
+
+    ## Lay out the sections of an FFS file like GetSectionContents() in GenFfs
+    #
+    #   @param  DataList        Contents of the section files
+    #   @param  AlignList       Alignment of every section, 1 for none
+    #   @param  Fixed           Whether the FFS file has a fixed location
+    #
+    #   @retval tuple           (Buffer, MaxAlignment, PeSectionNum)
+    #   @retval None            A section header is truncated
+    #
+    @staticmethod
+    def _LayoutSections(DataList, AlignList, Fixed):
+        Buffer = bytearray()
+        MaxAlignment = 1
+        PeSectionNum = 0
+        PadList = []
+
+        for Data, Align in zip(DataList, AlignList):
+            Buffer += bytearray(-len(Buffer) & 0x03)
+
+            HeaderSize = 8 if len(Data) >= MAX_FFS_SIZE else 4
+            Type = bytearray(Data[3:4])[0] if len(Data) >= 4 else 0
+            TeOffset = 0
+            if Type == EFI_SECTION_TE:
+                PeSectionNum += 1
+                if len(Data) >= HeaderSize + EFI_TE_IMAGE_HEADER_SIZE:
+                    Signature, StrippedSize = unpack_from('<H4xH', Data, HeaderSize)
+                    if Signature == EFI_TE_IMAGE_HEADER_SIGNATURE:
+                        TeOffset = (StrippedSize - EFI_TE_IMAGE_HEADER_SIZE) & 0xFFFFFFFF
+            elif Type == EFI_SECTION_PE32:
+                PeSectionNum += 1
+            elif Type == EFI_SECTION_GUID_DEFINED:
+                if len(Data) < 24:
+                    return None
+                if len(Data) >= MAX_SECTION_SIZE:
+                    DataOffset, Attributes = unpack_from('<HH', Data, 24)
+                else:
+                    DataOffset, Attributes = unpack_from('<HH', Data, 20)
+                if (Attributes & EFI_GUIDED_SECTION_PROCESSING_REQUIRED) == 0:
+                    HeaderSize = DataOffset
+                PeSectionNum += 1
+            elif Type in (EFI_SECTION_COMPRESSION, EFI_SECTION_FIRMWARE_VOLUME_IMAGE):
+                #
+                # Encapsulation sections are assumed to contain a PE/TE section.
+                #
+                PeSectionNum += 1
+
+            if TeOffset != 0:
+                TeOffset = (Align - (TeOffset % Align)) % Align
+
+            Size = len(Buffer)
+            if ((Size + HeaderSize + TeOffset) % Align) != 0:
+                Offset = (Size + 4 + HeaderSize + TeOffset + Align - 1) & ~(Align - 1)
+                Offset = Offset - Size - HeaderSize - TeOffset
+                #
+                # A reducible padding section is only used for a fixed FFS file
+                # whose preceding sections have no alignment requirement.
+                #
+                if Fixed and MaxAlignment <= 1 and Offset >= 20:
+                    PadList.append((Size, Offset, True))
+                else:
+                    PadList.append((Size, Offset, False))
+                Buffer += bytearray(Offset)
+
+            MaxAlignment = max(MaxAlignment, Align)
+            Buffer += Data
+
+        #
+        # GenFfs does not write the header of a padding section that reaches
+        # the end of the file, which only happens before an empty section file.
+        #
+        for Size, Offset, Reducible in PadList:
+            if Size + Offset >= len(Buffer):
+                continue
+            if Reducible:
+                Buffer[Size:Size + 20] = pack('<3BB', Offset & 0xFF, (Offset >> 8) & 0xFF, (Offset >> 16) & 0xFF, EFI_SECTION_FREEFORM_SUBTYPE_GUID) + \
+                                         PackGUID(EFI_FFS_SECTION_ALIGNMENT_PADDING_GUID.split('-'))
+            else:
+                Buffer[Size:Size + 4] = pack('<3BB', Offset & 0xFF, (Offset >> 8) & 0xFF, (Offset >> 16) & 0xFF, EFI_SECTION_RAW)
+
+        return Buffer, MaxAlignment, PeSectionNum
+
+    ## Generate an FFS file like GenFfs does
+    #
+    #   @param  Output          Path of the FFS file to generate
+    #   @param  Input           List of section files
+    #   @param  Type            FFS file type name
+    #   @param  Guid            FFS file name GUID in registry format
+    #   @param  Fixed           Whether the FFS file has a fixed location
+    #   @param  CheckSum        Whether the file data is checksummed
+    #   @param  Align           FFS file alignment name, or None
+    #   @param  SectionAlign    Alignment name of every section file, or None
+    #
+    #   @retval True            The FFS file was generated
+    #   @retval False           GenFfs must be called instead
+    #
+    @staticmethod
+    def GenerateFfs(Output, Input, Type, Guid, Fixed=False, CheckSum=False, Align=None, SectionAlign=None):
+        FileType = FfsFileType.get(Type.upper()) if Type else None
+        if FileType is None or not Input:
+            return False
+
+        try:
+            FileGuid = PackGUID(Guid.split('-'))
+        except (AttributeError, IndexError, ValueError):
+            return False
+        if len(Guid) != 36 or FileGuid == bytes(16):
+            return False
+
+        FfsAlign = 0
+        if Align:
+            if Align.upper() in FfsValidAlignName:
+                FfsAlign = FfsValidAlignName.index(Align.upper())
+            elif Align not in ("1", "2", "4"):
+                return False
+
+        #
+        # Section alignment "0" is taken from the PE image by GenFfs.
+        #
+        AlignList = []
+        for Index in range(len(Input)):
+            SecAlign = SectionAlign[Index] if SectionAlign and Index < len(SectionAlign) else None
+            if not SecAlign:
+                AlignList.append(1)
+            elif SecAlign.upper() in AlignName:
+                AlignList.append(1 << AlignName.index(SecAlign.upper()))
+            else:
+                return False
+
+        DataList = InProcessTools._ReadFiles(Input)
+        if DataList is None:
+            return False
+
+        Layout = InProcessTools._LayoutSections(DataList, AlignList, Fixed)
+        if Layout is None:
+            return False
+        Buffer, MaxAlignment, PeSectionNum = Layout
+        if FileType in (0x03, 0x04, 0x05) and PeSectionNum != 1:
+            return False
+        if FileType in (0x06, 0x07, 0x08, 0x09) and PeSectionNum < 1:
+            return False
+
+        for Index in range(len(FfsValidAlign) - 1):
+            if MaxAlignment > FfsValidAlign[Index] and MaxAlignment <= FfsValidAlign[Index + 1]:
+                break
+        else:
+            Index = len(FfsValidAlign) - 1
+        FfsAlign = max(FfsAlign, Index)
+
+        Attributes = 0
+        if Fixed:
+            Attributes |= FFS_ATTRIB_FIXED
+        if CheckSum:
+            Attributes |= FFS_ATTRIB_CHECKSUM
+
+        FileSize = len(Buffer)
+        if FileSize + 24 >= MAX_FFS_SIZE:
+            Attributes |= FFS_ATTRIB_LARGE_FILE
+            FileSize += 32
+            SizeField = b'\0\0\0'
+            ExtendedSize = pack('<Q', FileSize & 0xFFFFFFFF)
+        else:
+            FileSize += 24
+            SizeField = pack('<3B', FileSize & 0xFF, (FileSize >> 8) & 0xFF, (FileSize >> 16) & 0xFF)
+            ExtendedSize = b''
+
+        if FfsAlign < 8:
+            Attributes |= FfsAlign << 3
+        else:
+            Attributes |= ((FfsAlign & 0x7) << 3) | FFS_ATTRIB_DATA_ALIGNMENT2
+        Attributes &= 0xFF
+
+        Header = bytearray(FileGuid + pack('<BBBB', 0, 0, FileType, Attributes) + SizeField + b'\0' + ExtendedSize)
+        Header[16] = InProcessTools._Checksum8(Header)
+        if Attributes & FFS_ATTRIB_CHECKSUM:
+            Header[17] = InProcessTools._Checksum8(Buffer)
+        else:
+            Header[17] = FFS_FIXED_CHECKSUM
+        Header[23] = EFI_FILE_STATE
+
+        InProcessTools._WriteFile(Output, [Header, Buffer])
+        return True
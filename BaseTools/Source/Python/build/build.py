@@ -765,6 +765,9 @@ class Build():
         GlobalData.gBinCacheDest   = BuildOptions.BinCacheDest
         GlobalData.gBinCacheSource = BuildOptions.BinCacheSource
         GlobalData.gEnableGenfdsMultiThread = not BuildOptions.NoGenfdsMultiThread
+        GlobalData.gEnableFfsCache = not BuildOptions.NoFfsCache
+        GlobalData.gFfsCacheDir = BuildOptions.FfsCacheDir
+        GlobalData.gEnableInProcessTools = not BuildOptions.NoInProcessTools
         GlobalData.gDisableIncludePathCheck = BuildOptions.DisableIncludePathCheck
 
         if GlobalData.gBinCacheDest and not GlobalData.gUseHashCache:
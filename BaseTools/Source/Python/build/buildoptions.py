@@ -102,5 +102,8 @@ class MyOptionParser():
         Parser.add_option("--binary-source", action="store", type="string", dest="BinCacheSource", help="Consume a cache of binary files from the specified directory.")
         Parser.add_option("--genfds-multi-thread", action="store_true", dest="GenfdsMultiThread", default=True, help="Enable GenFds multi thread to generate ffs file.")
         Parser.add_option("--no-genfds-multi-thread", action="store_true", dest="NoGenfdsMultiThread", default=False, help="Disable GenFds multi thread to generate ffs file.")
+        Parser.add_option("--ffs-cache", action="store", type="string", dest="FfsCacheDir", help="Enable the GenFds FFS cache of section, FFS and compression tool outputs in the specified directory.")
+        Parser.add_option("--no-ffs-cache", action="store_true", dest="NoFfsCache", default=False, help="Disable the GenFds FFS cache even if --ffs-cache is specified.")
+        Parser.add_option("--no-in-process-tools", action="store_true", dest="NoInProcessTools", default=False, help="Always run GenSec and GenFfs instead of generating plain sections and FFS files within GenFds.")
         Parser.add_option("--disable-include-path-check", action="store_true", dest="DisableIncludePathCheck", default=False, help="Disable the include path check for outside of package.")
         self.BuildOption, self.BuildTarget = Parser.parse_args()
@@ -1016,6 +1016,34 @@ CryptoServiceSha256HashAll (
   return CALL_BASECRYPTLIB (Sha256.Services.HashAll, Sha256HashAll, (Data, DataSize, HashValue), FALSE);
 }
 
+/**
+  Computes the SHA-256 message digests of several independent data buffers.
+
+  Implementations may digest the buffers in interleaved lanes, several blocks at
+  a time, so that the independent compression rounds execute in parallel. The
+  result for each buffer is identical to the one of Sha256HashAll().
+
+  If this interface is not supported, then return FALSE.
+
+  @param[in]  Buffers      Array of the buffers to be hashed. The HashValue of each
+                           entry receives its SHA-256 digest value (32 bytes).
+  @param[in]  BufferCount  Number of entries in Buffers.
+
+  @retval TRUE   SHA-256 digest computation succeeded for all the buffers.
+  @retval FALSE  SHA-256 digest computation failed.
+  @retval FALSE  This interface is not supported.
+
+**/
+BOOLEAN
+EFIAPI
+CryptoServiceSha256HashAllMultiBuffer (
+  IN CONST HASH_MULTI_BUFFER  *Buffers,
+  IN UINTN                    BufferCount
+  )
+{
+  return CALL_BASECRYPTLIB (Sha256.Services.HashAllMultiBuffer, Sha256HashAllMultiBuffer, (Buffers, BufferCount), FALSE);
+}
+
 /**
   Retrieves the size, in bytes, of the context buffer required for SHA-384 hash operations.
 
@@ -1165,6 +1193,34 @@ CryptoServiceSha384HashAll (
   return CALL_BASECRYPTLIB (Sha384.Services.HashAll, Sha384HashAll, (Data, DataSize, HashValue), FALSE);
 }
 
+/**
+  Computes the SHA-384 message digests of several independent data buffers.
+
+  Implementations may digest the buffers in interleaved lanes, several blocks at
+  a time, so that the independent compression rounds execute in parallel. The
+  result for each buffer is identical to the one of Sha384HashAll().
+
+  If this interface is not supported, then return FALSE.
+
+  @param[in]  Buffers      Array of the buffers to be hashed. The HashValue of each
+                           entry receives its SHA-384 digest value (48 bytes).
+  @param[in]  BufferCount  Number of entries in Buffers.
+
+  @retval TRUE   SHA-384 digest computation succeeded for all the buffers.
+  @retval FALSE  SHA-384 digest computation failed.
+  @retval FALSE  This interface is not supported.
+
+**/
+BOOLEAN
+EFIAPI
+CryptoServiceSha384HashAllMultiBuffer (
+  IN CONST HASH_MULTI_BUFFER  *Buffers,
+  IN UINTN                    BufferCount
+  )
+{
+  return CALL_BASECRYPTLIB (Sha384.Services.HashAllMultiBuffer, Sha384HashAllMultiBuffer, (Buffers, BufferCount), FALSE);
+}
+
 /**
   Retrieves the size, in bytes, of the context buffer required for SHA-512 hash operations.
 
@@ -7116,4 +7172,7 @@ const EDKII_CRYPTO_PROTOCOL  mEdkiiCrypto = {
   CryptoServicePkcs1v2Decrypt,
   CryptoServiceRsaOaepEncrypt,
   CryptoServiceRsaOaepDecrypt,
+  /// Sha256 & Sha384 (continued)
+  CryptoServiceSha256HashAllMultiBuffer,
+  CryptoServiceSha384HashAllMultiBuffer,
 };
@@ -82,6 +82,16 @@ typedef enum {
   RsaKeyQInv    ///< The CRT coefficient (== 1/q mod p)
 } RSA_KEY_TAG;
 
+///
+/// One of the independent messages digested by the multi-buffer hash functions,
+/// such as Sha256HashAllMultiBuffer().
+///
+typedef struct {
+  CONST VOID    *Data;      ///< Pointer to the message to be hashed.
+  UINTN         DataSize;   ///< Size of Data in bytes.
+  UINT8         *HashValue; ///< Pointer to a buffer that receives the digest of Data.
+} HASH_MULTI_BUFFER;
+
 // =====================================================================================
 //    One-Way Cryptographic Hash Primitives
 // =====================================================================================
@@ -505,6 +515,31 @@ Sha256HashAll (
   OUT  UINT8       *HashValue
   );
 
+/**
+  Computes the SHA-256 message digests of several independent data buffers.
+
+  Implementations may digest the buffers in interleaved lanes, several blocks at
+  a time, so that the independent compression rounds execute in parallel. The
+  result for each buffer is identical to the one of Sha256HashAll().
+
+  If this interface is not supported, then return FALSE.
+
+  @param[in]  Buffers      Array of the buffers to be hashed. The HashValue of each
+                           entry receives its SHA-256 digest value (32 bytes).
+  @param[in]  BufferCount  Number of entries in Buffers.
+
+  @retval TRUE   SHA-256 digest computation succeeded for all the buffers.
+  @retval FALSE  SHA-256 digest computation failed.
+  @retval FALSE  This interface is not supported.
+
+**/
+BOOLEAN
+EFIAPI
+Sha256HashAllMultiBuffer (
+  IN CONST HASH_MULTI_BUFFER  *Buffers,
+  IN UINTN                    BufferCount
+  );
+
 /**
   Retrieves the size, in bytes, of the context buffer required for SHA-384 hash operations.
 
@@ -636,6 +671,31 @@ Sha384HashAll (
   OUT  UINT8       *HashValue
   );
 
+/**
+  Computes the SHA-384 message digests of several independent data buffers.
+
+  Implementations may digest the buffers in interleaved lanes, several blocks at
+  a time, so that the independent compression rounds execute in parallel. The
+  result for each buffer is identical to the one of Sha384HashAll().
+
+  If this interface is not supported, then return FALSE.
+
+  @param[in]  Buffers      Array of the buffers to be hashed. The HashValue of each
+                           entry receives its SHA-384 digest value (48 bytes).
+  @param[in]  BufferCount  Number of entries in Buffers.
+
+  @retval TRUE   SHA-384 digest computation succeeded for all the buffers.
+  @retval FALSE  SHA-384 digest computation failed.
+  @retval FALSE  This interface is not supported.
+
+**/
+BOOLEAN
+EFIAPI
+Sha384HashAllMultiBuffer (
+  IN CONST HASH_MULTI_BUFFER  *Buffers,
+  IN UINTN                    BufferCount
+  );
+
 /**
   Retrieves the size, in bytes, of the context buffer required for SHA-512 hash operations.
 
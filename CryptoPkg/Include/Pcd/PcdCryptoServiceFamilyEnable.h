@@ -178,23 +178,25 @@ typedef struct {
   } Sha1;
   union {
     struct {
-      UINT8    GetContextSize : 1;
-      UINT8    Init           : 1;
-      UINT8    Duplicate      : 1;
-      UINT8    Update         : 1;
-      UINT8    Final          : 1;
-      UINT8    HashAll        : 1;
+      UINT8    GetContextSize     : 1;
+      UINT8    Init               : 1;
+      UINT8    Duplicate          : 1;
+      UINT8    Update             : 1;
+      UINT8    Final              : 1;
+      UINT8    HashAll            : 1;
+      UINT8    HashAllMultiBuffer : 1;
     } Services;
     UINT32    Family;
   } Sha256;
   union {
     struct {
-      UINT8    GetContextSize : 1;
-      UINT8    Init           : 1;
-      UINT8    Duplicate      : 1;
-      UINT8    Update         : 1;
-      UINT8    Final          : 1;
-      UINT8    HashAll        : 1;
+      UINT8    GetContextSize     : 1;
+      UINT8    Init               : 1;
+      UINT8    Duplicate          : 1;
+      UINT8    Update             : 1;
+      UINT8    Final              : 1;
+      UINT8    HashAll            : 1;
+      UINT8    HashAllMultiBuffer : 1;
     } Services;
     UINT32    Family;
   } Sha384;
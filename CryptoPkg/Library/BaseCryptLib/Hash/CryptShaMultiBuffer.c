@@ -0,0 +1,567 @@
+/** @file
+  Multi-buffer SHA-256 and SHA-384 Digest Implementation.
+
+  SHA-256 digests several independent messages in lockstep, one message per
+  lane. Every working variable of the compression function holds the value of
+  all the lanes in one SIMD vector, so each step of a round is a single vector
+  operation, and the rounds of the different messages overlap in the pipeline
+  instead of waiting on each other. Once too few lanes are left busy for that to
+  pay off, the remaining messages are completed one block at a time by the
+  scalar compression function, starting from the hash value the lanes have
+  reached. Messages are padded by the lanes themselves, so no hash context of
+  OpenSSL is involved.
+
+  The lanes use the generic vector types of GCC and Clang, which compile to SSE2
+  code on any X64 processor. SHA-384 works on 64-bit words, which SSE2 holds only
+  two at a time and cannot rotate, so lanes do not beat the 64-bit scalar code.
+  SHA-384, other targets and other toolchains digest the messages one at a time.
+
+Copyright (c) 2026, Intel Corporation. All rights reserved.<BR>
+SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include "InternalCryptLib.h"
+
+#if defined (MDE_CPU_X64) && defined (__GNUC__)
+
+#define SHA256_MB_LANES        8
+#define SHA256_MB_BLOCK_SIZE   64
+#define SHA256_MB_LENGTH_SIZE  8
+
+//
+// The lanes are only faster than the scalar code while at least this many of
+// them are busy. Below it the remaining messages are completed one at a time.
+//
+#define SHA256_MB_MIN_ACTIVE_LANES  (SHA256_MB_LANES / 2)
+
+#define SHA256_MB_IDLE_LANE  MAX_UINTN
+
+typedef UINT32 SHA256_MB_WORD __attribute__ ((vector_size (SHA256_MB_LANES * sizeof (UINT32))));
+
+///
+/// The message currently assigned to one lane.
+///
+typedef struct {
+  UINTN          Buffer;                         ///< Index of the message in the caller's array, or SHA256_MB_IDLE_LANE.
+  CONST UINT8    *Block;                         ///< Next full block of the message.
+  UINTN          BlockCount;                     ///< Full blocks of the message left.
+  UINTN          Remainder;                      ///< Bytes of the message after its last full block.
+  UINT8          *TailBlock;                     ///< Next padding block.
+  UINTN          TailCount;                      ///< Padding blocks left.
+  UINT8          Tail[2 * SHA256_MB_BLOCK_SIZE]; ///< Last partial block, padding and message length.
+} SHA256_MB_LANE;
+
+//
+// Fed to the lanes that have no message left, so that all the lanes always run
+// the same instructions. The results of those lanes are never used.
+//
+STATIC CONST UINT8  mSha256MbIdleBlock[SHA256_MB_BLOCK_SIZE] = { 0 };
+
+STATIC CONST UINT32  mSha256K[64] = {
+  0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+  0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+  0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+  0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+  0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+  0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+  0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+  0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+STATIC CONST UINT32  mSha256InitialHash[8] = {
+  0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+};
+
+//
+// Big-endian load that the compiler turns into a single load and byte swap,
+// without a call per message word.
+//
+#define SHA256_MB_LOAD32(p)  (((UINT32)(p)[0] << 24) | ((UINT32)(p)[1] << 16) | ((UINT32)(p)[2] << 8) | (UINT32)(p)[3])
+
+#define SHA256_MB_ROTR(x, n)  (((x) >> (n)) | ((x) << (32 - (n))))
+
+/**
+  Digests one 64-byte block into every lane.
+
+  @param[in, out]  State   The lane interleaved hash value.
+  @param[in]       Blocks  The block to digest into each lane.
+
+**/
+STATIC
+VOID
+Sha256MbCompress (
+  IN OUT SHA256_MB_WORD  *State,
+  IN     CONST UINT8     **Blocks
+  )
+{
+  SHA256_MB_WORD  W[16];
+  SHA256_MB_WORD  A;
+  SHA256_MB_WORD  B;
+  SHA256_MB_WORD  C;
+  SHA256_MB_WORD  D;
+  SHA256_MB_WORD  E;
+  SHA256_MB_WORD  F;
+  SHA256_MB_WORD  G;
+  SHA256_MB_WORD  H;
+  SHA256_MB_WORD  T1;
+  SHA256_MB_WORD  T2;
+  SHA256_MB_WORD  S0;
+  SHA256_MB_WORD  S1;
+  UINTN           Round;
+  UINTN           Lane;
+
+  for (Round = 0; Round < 16; Round++) {
+    for (Lane = 0; Lane < SHA256_MB_LANES; Lane++) {
+      W[Round][Lane] = SHA256_MB_LOAD32 (Blocks[Lane] + Round * sizeof (UINT32));
+    }
+  }
+
+  A = State[0];
+  B = State[1];
+  C = State[2];
+  D = State[3];
+  E = State[4];
+  F = State[5];
+  G = State[6];
+  H = State[7];
+
+  for (Round = 0; Round < 64; Round++) {
+    if (Round >= 16) {
+      //
+      // Extend the message schedule in place, W[t] overwrites W[t - 16].
+      //
+      S0             = W[(Round - 15) & 15];
+      S0             = SHA256_MB_ROTR (S0, 7) ^ SHA256_MB_ROTR (S0, 18) ^ (S0 >> 3);
+      S1             = W[(Round - 2) & 15];
+      S1             = SHA256_MB_ROTR (S1, 17) ^ SHA256_MB_ROTR (S1, 19) ^ (S1 >> 10);
+      W[Round & 15] += S0 + W[(Round - 7) & 15] + S1;
+    }
+
+    T1 = H + (SHA256_MB_ROTR (E, 6) ^ SHA256_MB_ROTR (E, 11) ^ SHA256_MB_ROTR (E, 25)) +
+         ((E & F) ^ (~E & G)) + mSha256K[Round] + W[Round & 15];
+    T2 = (SHA256_MB_ROTR (A, 2) ^ SHA256_MB_ROTR (A, 13) ^ SHA256_MB_ROTR (A, 22)) +
+         ((A & B) ^ (A & C) ^ (B & C));
+    H = G;
+    G = F;
+    F = E;
+    E = D + T1;
+    D = C;
+    C = B;
+    B = A;
+    A = T1 + T2;
+  }
+
+  State[0] += A;
+  State[1] += B;
+  State[2] += C;
+  State[3] += D;
+  State[4] += E;
+  State[5] += F;
+  State[6] += G;
+  State[7] += H;
+}
+
+/**
+  Digests one 64-byte block into the hash value of a single message.
+
+  @param[in, out]  State  The hash value of the message.
+  @param[in]       Block  The block to digest.
+
+**/
+STATIC
+VOID
+Sha256MbCompressOne (
+  IN OUT UINT32       *State,
+  IN     CONST UINT8  *Block
+  )
+{
+  UINT32  W[16];
+  UINT32  A;
+  UINT32  B;
+  UINT32  C;
+  UINT32  D;
+  UINT32  E;
+  UINT32  F;
+  UINT32  G;
+  UINT32  H;
+  UINT32  T1;
+  UINT32  T2;
+  UINT32  S0;
+  UINT32  S1;
+  UINTN   Round;
+
+  for (Round = 0; Round < 16; Round++) {
+    W[Round] = SHA256_MB_LOAD32 (Block + Round * sizeof (UINT32));
+  }
+
+  A = State[0];
+  B = State[1];
+  C = State[2];
+  D = State[3];
+  E = State[4];
+  F = State[5];
+  G = State[6];
+  H = State[7];
+
+  for (Round = 0; Round < 64; Round++) {
+    if (Round >= 16) {
+      S0             = W[(Round - 15) & 15];
+      S0             = SHA256_MB_ROTR (S0, 7) ^ SHA256_MB_ROTR (S0, 18) ^ (S0 >> 3);
+      S1             = W[(Round - 2) & 15];
+      S1             = SHA256_MB_ROTR (S1, 17) ^ SHA256_MB_ROTR (S1, 19) ^ (S1 >> 10);
+      W[Round & 15] += S0 + W[(Round - 7) & 15] + S1;
+    }
+
+    T1 = H + (SHA256_MB_ROTR (E, 6) ^ SHA256_MB_ROTR (E, 11) ^ SHA256_MB_ROTR (E, 25)) +
+         ((E & F) ^ (~E & G)) + mSha256K[Round] + W[Round & 15];
+    T2 = (SHA256_MB_ROTR (A, 2) ^ SHA256_MB_ROTR (A, 13) ^ SHA256_MB_ROTR (A, 22)) +
+         ((A & B) ^ (A & C) ^ (B & C));
+    H = G;
+    G = F;
+    F = E;
+    E = D + T1;
+    D = C;
+    C = B;
+    B = A;
+    A = T1 + T2;
+  }
+
+  State[0] += A;
+  State[1] += B;
+  State[2] += C;
+  State[3] += D;
+  State[4] += E;
+  State[5] += F;
+  State[6] += G;
+  State[7] += H;
+}
+
+/**
+  Assigns a message to a lane, sets the initial hash value of the lane and
+  builds the padding blocks of the message.
+
+  @param[in, out]  State    The lane interleaved hash value.
+  @param[in, out]  Lanes    The lanes.
+  @param[in]       Lane     The lane the message is assigned to.
+  @param[in]       Buffers  The caller's array of messages.
+  @param[in]       Buffer   Index of the message assigned to the lane.
+
+**/
+STATIC
+VOID
+Sha256MbLaneStart (
+  IN OUT SHA256_MB_WORD           *State,
+  IN OUT SHA256_MB_LANE           *Lanes,
+  IN     UINTN                    Lane,
+  IN     CONST HASH_MULTI_BUFFER  *Buffers,
+  IN     UINTN                    Buffer
+  )
+{
+  SHA256_MB_LANE  *Entry;
+  UINTN           TailSize;
+  UINTN           Index;
+
+  for (Index = 0; Index < 8; Index++) {
+    State[Index][Lane] = mSha256InitialHash[Index];
+  }
+
+  Entry             = &Lanes[Lane];
+  Entry->Buffer     = Buffer;
+  Entry->Block      = Buffers[Buffer].Data;
+  Entry->BlockCount = Buffers[Buffer].DataSize / SHA256_MB_BLOCK_SIZE;
+  Entry->Remainder  = Buffers[Buffer].DataSize % SHA256_MB_BLOCK_SIZE;
+
+  //
+  // The last bytes of the message, the 0x80 byte, the zero padding and the
+  // big-endian message length in bits fill one or two more blocks.
+  //
+  Entry->TailCount = (Entry->Remainder + 1 + SHA256_MB_LENGTH_SIZE <= SHA256_MB_BLOCK_SIZE) ? 1 : 2;
+  Entry->TailBlock = Entry->Tail;
+  TailSize         = Entry->TailCount * SHA256_MB_BLOCK_SIZE;
+
+  ZeroMem (Entry->Tail, TailSize);
+  if (Entry->Remainder != 0) {
+    CopyMem (Entry->Tail, Entry->Block + Entry->BlockCount * SHA256_MB_BLOCK_SIZE, Entry->Remainder);
+  }
+
+  Entry->Tail[Entry->Remainder] = 0x80;
+  WriteUnaligned64 (
+    (UINT64 *)(Entry->Tail + TailSize - sizeof (UINT64)),
+    SwapBytes64 ((UINT64)Buffers[Buffer].DataSize << 3)
+    );
+}
+
+/**
+  Returns the next block of the message assigned to a lane.
+
+  @param[in, out]  Lane  The lane.
+
+  @return The next block, or NULL when the whole message has been returned.
+
+**/
+STATIC
+CONST UINT8 *
+Sha256MbLaneNextBlock (
+  IN OUT SHA256_MB_LANE  *Lane
+  )
+{
+  CONST UINT8  *Block;
+
+  if (Lane->BlockCount != 0) {
+    Block        = Lane->Block;
+    Lane->Block += SHA256_MB_BLOCK_SIZE;
+    Lane->BlockCount--;
+    return Block;
+  }
+
+  if (Lane->TailCount != 0) {
+    Block            = Lane->TailBlock;
+    Lane->TailBlock += SHA256_MB_BLOCK_SIZE;
+    Lane->TailCount--;
+    return Block;
+  }
+
+  return NULL;
+}
+
+/**
+  Stores the digest value of a lane whose message has been fully digested.
+
+  @param[in]   State      The lane interleaved hash value.
+  @param[in]   Lane       The lane.
+  @param[out]  HashValue  Receives the 32-byte digest value.
+
+**/
+STATIC
+VOID
+Sha256MbLaneFinal (
+  IN  CONST SHA256_MB_WORD  *State,
+  IN  UINTN                 Lane,
+  OUT UINT8                 *HashValue
+  )
+{
+  UINTN  Index;
+
+  for (Index = 0; Index < SHA256_DIGEST_SIZE / sizeof (UINT32); Index++) {
+    WriteUnaligned32 ((UINT32 *)(HashValue + Index * sizeof (UINT32)), SwapBytes32 (State[Index][Lane]));
+  }
+}
+
+/**
+  Completes the message of a lane outside the lanes, from the hash value the
+  lane has reached, and stores its digest value.
+
+  @param[in]       State    The lane interleaved hash value.
+  @param[in, out]  Lanes    The lanes.
+  @param[in]       Lane     The lane.
+  @param[in]       Buffers  The caller's array of messages.
+
+**/
+STATIC
+VOID
+Sha256MbLaneComplete (
+  IN     CONST SHA256_MB_WORD     *State,
+  IN OUT SHA256_MB_LANE           *Lanes,
+  IN     UINTN                    Lane,
+  IN     CONST HASH_MULTI_BUFFER  *Buffers
+  )
+{
+  UINT32       Hash[8];
+  CONST UINT8  *Block;
+  UINT8        *HashValue;
+  UINTN        Index;
+
+  for (Index = 0; Index < 8; Index++) {
+    Hash[Index] = State[Index][Lane];
+  }
+
+  Block = Sha256MbLaneNextBlock (&Lanes[Lane]);
+  while (Block != NULL) {
+    Sha256MbCompressOne (Hash, Block);
+    Block = Sha256MbLaneNextBlock (&Lanes[Lane]);
+  }
+
+  HashValue = Buffers[Lanes[Lane].Buffer].HashValue;
+  for (Index = 0; Index < SHA256_DIGEST_SIZE / sizeof (UINT32); Index++) {
+    WriteUnaligned32 ((UINT32 *)(HashValue + Index * sizeof (UINT32)), SwapBytes32 (Hash[Index]));
+  }
+}
+
+/**
+  Digests several independent messages in the SHA-256 lanes.
+
+  A lane that completes its message is given the next one, so that all the
+  lanes stay busy as long as messages are left.
+
+  @param[in]  Buffers      Array of the messages.
+  @param[in]  BufferCount  Number of entries in Buffers.
+
+**/
+STATIC
+VOID
+Sha256MbHashAll (
+  IN CONST HASH_MULTI_BUFFER  *Buffers,
+  IN UINTN                    BufferCount
+  )
+{
+  SHA256_MB_WORD  State[8];
+  SHA256_MB_LANE  Lanes[SHA256_MB_LANES];
+  CONST UINT8     *Blocks[SHA256_MB_LANES];
+  UINTN           Next;
+  UINTN           Active;
+  UINTN           Lane;
+
+  ZeroMem (State, sizeof (State));
+  for (Lane = 0; Lane < SHA256_MB_LANES; Lane++) {
+    Lanes[Lane].Buffer = SHA256_MB_IDLE_LANE;
+  }
+
+  Next = 0;
+  for ( ; ;) {
+    Active = 0;
+    for (Lane = 0; Lane < SHA256_MB_LANES; Lane++) {
+      if ((Lanes[Lane].Buffer != SHA256_MB_IDLE_LANE) &&
+          (Lanes[Lane].BlockCount == 0) && (Lanes[Lane].TailCount == 0))
+      {
+        Sha256MbLaneFinal (State, Lane, Buffers[Lanes[Lane].Buffer].HashValue);
+        Lanes[Lane].Buffer = SHA256_MB_IDLE_LANE;
+      }
+
+      if ((Lanes[Lane].Buffer == SHA256_MB_IDLE_LANE) && (Next < BufferCount)) {
+        Sha256MbLaneStart (State, Lanes, Lane, Buffers, Next++);
+      }
+
+      if (Lanes[Lane].Buffer != SHA256_MB_IDLE_LANE) {
+        Active++;
+      }
+    }
+
+    if (Active < SHA256_MB_MIN_ACTIVE_LANES) {
+      //
+      // No message is waiting for a lane. Complete the messages still in the
+      // lanes one at a time.
+      //
+      for (Lane = 0; Lane < SHA256_MB_LANES; Lane++) {
+        if (Lanes[Lane].Buffer != SHA256_MB_IDLE_LANE) {
+          Sha256MbLaneComplete (State, Lanes, Lane, Buffers);
+          Lanes[Lane].Buffer = SHA256_MB_IDLE_LANE;
+        }
+      }
+
+      break;
+    }
+
+    for (Lane = 0; Lane < SHA256_MB_LANES; Lane++) {
+      if (Lanes[Lane].Buffer == SHA256_MB_IDLE_LANE) {
+        Blocks[Lane] = mSha256MbIdleBlock;
+      } else {
+        Blocks[Lane] = Sha256MbLaneNextBlock (&Lanes[Lane]);
+      }
+    }
+
+    Sha256MbCompress (State, Blocks);
+  }
+}
+
+#endif
+
+/**
+  Computes the SHA-256 message digests of several independent data buffers.
+
+  Implementations may digest the buffers in interleaved lanes, several blocks at
+  a time, so that the independent compression rounds execute in parallel. The
+  result for each buffer is identical to the one of Sha256HashAll().
+
+  If this interface is not supported, then return FALSE.
+
+  @param[in]  Buffers      Array of the buffers to be hashed. The HashValue of each
+                           entry receives its SHA-256 digest value (32 bytes).
+  @param[in]  BufferCount  Number of entries in Buffers.
+
+  @retval TRUE   SHA-256 digest computation succeeded for all the buffers.
+  @retval FALSE  SHA-256 digest computation failed.
+  @retval FALSE  This interface is not supported.
+
+**/
+BOOLEAN
+EFIAPI
+Sha256HashAllMultiBuffer (
+  IN CONST HASH_MULTI_BUFFER  *Buffers,
+  IN UINTN                    BufferCount
+  )
+{
+  UINTN  Index;
+
+  //
+  // Check input parameters.
+  //
+  if ((Buffers == NULL) && (BufferCount != 0)) {
+    return FALSE;
+  }
+
+  for (Index = 0; Index < BufferCount; Index++) {
+    if ((Buffers[Index].HashValue == NULL) ||
+        ((Buffers[Index].Data == NULL) && (Buffers[Index].DataSize != 0)))
+    {
+      return FALSE;
+    }
+  }
+
+ #if defined (MDE_CPU_X64) && defined (__GNUC__)
+  if (BufferCount >= SHA256_MB_MIN_ACTIVE_LANES) {
+    Sha256MbHashAll (Buffers, BufferCount);
+    return TRUE;
+  }
+
+ #endif
+
+  for (Index = 0; Index < BufferCount; Index++) {
+    if (!Sha256HashAll (Buffers[Index].Data, Buffers[Index].DataSize, Buffers[Index].HashValue)) {
+      return FALSE;
+    }
+  }
+
+  return TRUE;
+}
+
+/**
+  Computes the SHA-384 message digests of several independent data buffers.
+
+  The result for each buffer is identical to the one of Sha384HashAll().
+
+  If this interface is not supported, then return FALSE.
+
+  @param[in]  Buffers      Array of the buffers to be hashed. The HashValue of each
+                           entry receives its SHA-384 digest value (48 bytes).
+  @param[in]  BufferCount  Number of entries in Buffers.
+
+  @retval TRUE   SHA-384 digest computation succeeded for all the buffers.
+  @retval FALSE  SHA-384 digest computation failed.
+  @retval FALSE  This interface is not supported.
+
+**/
+BOOLEAN
+EFIAPI
+Sha384HashAllMultiBuffer (
+  IN CONST HASH_MULTI_BUFFER  *Buffers,
+  IN UINTN                    BufferCount
+  )
+{
+  UINTN  Index;
+
+  //
+  // Check input parameters.
+  //
+  if ((Buffers == NULL) && (BufferCount != 0)) {
+    return FALSE;
+  }
+
+  for (Index = 0; Index < BufferCount; Index++) {
+    if (!Sha384HashAll (Buffers[Index].Data, Buffers[Index].DataSize, Buffers[Index].HashValue)) {
+      return FALSE;
+    }
+  }
+
+  return TRUE;
+}
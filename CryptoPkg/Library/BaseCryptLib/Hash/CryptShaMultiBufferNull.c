@@ -0,0 +1,63 @@
+/** @file
+  Multi-buffer SHA-256 and SHA-384 Digest Null Implementation.
+
+Copyright (c) 2026, Intel Corporation. All rights reserved.<BR>
+SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include "InternalCryptLib.h"
+
+/**
+  Computes the SHA-256 message digests of several independent data buffers.
+
+  Implementations may digest the buffers in interleaved lanes, several blocks at
+  a time, so that the independent compression rounds execute in parallel. The
+  result for each buffer is identical to the one of Sha256HashAll().
+
+  If this interface is not supported, then return FALSE.
+
+  @param[in]  Buffers      Array of the buffers to be hashed. The HashValue of each
+                           entry receives its SHA-256 digest value (32 bytes).
+  @param[in]  BufferCount  Number of entries in Buffers.
+
+  @retval FALSE  This interface is not supported.
+
+**/
+BOOLEAN
+EFIAPI
+Sha256HashAllMultiBuffer (
+  IN CONST HASH_MULTI_BUFFER  *Buffers,
+  IN UINTN                    BufferCount
+  )
+{
+  ASSERT (FALSE);
+  return FALSE;
+}
+
+/**
+  Computes the SHA-384 message digests of several independent data buffers.
+
+  Implementations may digest the buffers in interleaved lanes, several blocks at
+  a time, so that the independent compression rounds execute in parallel. The
+  result for each buffer is identical to the one of Sha384HashAll().
+
+  If this interface is not supported, then return FALSE.
+
+  @param[in]  Buffers      Array of the buffers to be hashed. The HashValue of each
+                           entry receives its SHA-384 digest value (48 bytes).
+  @param[in]  BufferCount  Number of entries in Buffers.
+
+  @retval FALSE  This interface is not supported.
+
+**/
+BOOLEAN
+EFIAPI
+Sha384HashAllMultiBuffer (
+  IN CONST HASH_MULTI_BUFFER  *Buffers,
+  IN UINTN                    BufferCount
+  )
+{
+  ASSERT (FALSE);
+  return FALSE;
+}
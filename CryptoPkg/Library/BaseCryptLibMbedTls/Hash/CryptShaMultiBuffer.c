@@ -0,0 +1,97 @@
+/** @file
+  Multi-buffer SHA-256 and SHA-384 Digest Implementation over MbedTLS.
+
+  MbedTLS has no multi-buffer hashing, so the buffers are digested one at a time.
+
+Copyright (c) 2026, Intel Corporation. All rights reserved.<BR>
+SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include "InternalCryptLib.h"
+
+/**
+  Computes the SHA-256 message digests of several independent data buffers.
+
+  Implementations may digest the buffers in interleaved lanes, several blocks at
+  a time, so that the independent compression rounds execute in parallel. The
+  result for each buffer is identical to the one of Sha256HashAll().
+
+  If this interface is not supported, then return FALSE.
+
+  @param[in]  Buffers      Array of the buffers to be hashed. The HashValue of each
+                           entry receives its SHA-256 digest value (32 bytes).
+  @param[in]  BufferCount  Number of entries in Buffers.
+
+  @retval TRUE   SHA-256 digest computation succeeded for all the buffers.
+  @retval FALSE  SHA-256 digest computation failed.
+  @retval FALSE  This interface is not supported.
+
+**/
+BOOLEAN
+EFIAPI
+Sha256HashAllMultiBuffer (
+  IN CONST HASH_MULTI_BUFFER  *Buffers,
+  IN UINTN                    BufferCount
+  )
+{
+  UINTN  Index;
+
+  //
+  // Check input parameters.
+  //
+  if ((Buffers == NULL) && (BufferCount != 0)) {
+    return FALSE;
+  }
+
+  for (Index = 0; Index < BufferCount; Index++) {
+    if (!Sha256HashAll (Buffers[Index].Data, Buffers[Index].DataSize, Buffers[Index].HashValue)) {
+      return FALSE;
+    }
+  }
+
+  return TRUE;
+}
+
+/**
+  Computes the SHA-384 message digests of several independent data buffers.
+
+  Implementations may digest the buffers in interleaved lanes, several blocks at
+  a time, so that the independent compression rounds execute in parallel. The
+  result for each buffer is identical to the one of Sha384HashAll().
+
+  If this interface is not supported, then return FALSE.
+
+  @param[in]  Buffers      Array of the buffers to be hashed. The HashValue of each
+                           entry receives its SHA-384 digest value (48 bytes).
+  @param[in]  BufferCount  Number of entries in Buffers.
+
+  @retval TRUE   SHA-384 digest computation succeeded for all the buffers.
+  @retval FALSE  SHA-384 digest computation failed.
+  @retval FALSE  This interface is not supported.
+
+**/
+BOOLEAN
+EFIAPI
+Sha384HashAllMultiBuffer (
+  IN CONST HASH_MULTI_BUFFER  *Buffers,
+  IN UINTN                    BufferCount
+  )
+{
+  UINTN  Index;
+
+  //
+  // Check input parameters.
+  //
+  if ((Buffers == NULL) && (BufferCount != 0)) {
+    return FALSE;
+  }
+
+  for (Index = 0; Index < BufferCount; Index++) {
+    if (!Sha384HashAll (Buffers[Index].Data, Buffers[Index].DataSize, Buffers[Index].HashValue)) {
+      return FALSE;
+    }
+  }
+
+  return TRUE;
+}
@@ -572,6 +572,30 @@ Sha256HashAll (
   CALL_CRYPTO_SERVICE (Sha256HashAll, (Data, DataSize, HashValue), FALSE);
 }
 
+/**
+  Computes the SHA-256 message digests of several independent data buffers.
+
+  If this interface is not supported, then return FALSE.
+
+  @param[in]  Buffers      Array of buffers to be hashed. Every HashValue receives
+                           the SHA-256 digest value (32 bytes) of its Data.
+  @param[in]  BufferCount  Number of entries in Buffers.
+
+  @retval TRUE   SHA-256 digest computation succeeded for all the buffers.
+  @retval FALSE  SHA-256 digest computation failed.
+  @retval FALSE  This interface is not supported.
+
+**/
+BOOLEAN
+EFIAPI
+Sha256HashAllMultiBuffer (
+  IN CONST HASH_MULTI_BUFFER  *Buffers,
+  IN UINTN                    BufferCount
+  )
+{
+  CALL_CRYPTO_SERVICE (Sha256HashAllMultiBuffer, (Buffers, BufferCount), FALSE);
+}
+
 /**
   Retrieves the size, in bytes, of the context buffer required for SHA-384 hash operations.
 
@@ -721,6 +745,30 @@ Sha384HashAll (
   CALL_CRYPTO_SERVICE (Sha384HashAll, (Data, DataSize, HashValue), FALSE);
 }
 
+/**
+  Computes the SHA-384 message digests of several independent data buffers.
+
+  If this interface is not supported, then return FALSE.
+
+  @param[in]  Buffers      Array of buffers to be hashed. Every HashValue receives
+                           the SHA-384 digest value (48 bytes) of its Data.
+  @param[in]  BufferCount  Number of entries in Buffers.
+
+  @retval TRUE   SHA-384 digest computation succeeded for all the buffers.
+  @retval FALSE  SHA-384 digest computation failed.
+  @retval FALSE  This interface is not supported.
+
+**/
+BOOLEAN
+EFIAPI
+Sha384HashAllMultiBuffer (
+  IN CONST HASH_MULTI_BUFFER  *Buffers,
+  IN UINTN                    BufferCount
+  )
+{
+  CALL_CRYPTO_SERVICE (Sha384HashAllMultiBuffer, (Buffers, BufferCount), FALSE);
+}
+
 /**
   Retrieves the size, in bytes, of the context buffer required for SHA-512 hash operations.
 
@@ -134,6 +134,30 @@ HASH_TEST_CONTEXT  mSha384TestCtx = { SHA384_DIGEST_SIZE, Sha384GetContextSize,
 HASH_TEST_CONTEXT  mSha512TestCtx = { SHA512_DIGEST_SIZE, Sha512GetContextSize, Sha512Init, Sha512Update, Sha512Duplicate, Sha512Final, Sha512HashAll, Sha512Digest };
 HASH_TEST_CONTEXT  mSm3TestCtx    = { SM3_256_DIGEST_SIZE, Sm3GetContextSize, Sm3Init, Sm3Update, Sm3Duplicate, Sm3Final, Sm3HashAll, Sm3Digest };
 
+typedef
+BOOLEAN
+(EFIAPI *EFI_HASH_ALL_MULTI_BUFFER)(
+  IN CONST HASH_MULTI_BUFFER  *Buffers,
+  IN UINTN                    BufferCount
+  );
+
+typedef struct {
+  UINT32                       DigestSize;
+  EFI_HASH_ALL                 HashAll;
+  EFI_HASH_ALL_MULTI_BUFFER    HashAllMultiBuffer;
+} HASH_MULTI_BUFFER_TEST_CONTEXT;
+
+HASH_MULTI_BUFFER_TEST_CONTEXT  mSha256MultiBufferTestCtx = { SHA256_DIGEST_SIZE, Sha256HashAll, Sha256HashAllMultiBuffer };
+HASH_MULTI_BUFFER_TEST_CONTEXT  mSha384MultiBufferTestCtx = { SHA384_DIGEST_SIZE, Sha384HashAll, Sha384HashAllMultiBuffer };
+
+//
+// Message sizes for multi-buffer validation. They cover the empty message, the
+// padding boundaries, and buffers that finish long after the other ones.
+//
+GLOBAL_REMOVE_IF_UNREFERENCED CONST UINTN  mMultiBufferDataSizes[] = {
+  0, 3, 55, 56, 64, 111, 112, 119, 128, 1000, 4097, 200
+};
+
 UNIT_TEST_STATUS
 EFIAPI
 TestVerifyHashPreReq (
@@ -219,6 +243,63 @@ TestVerifyHash (
   return UNIT_TEST_PASSED;
 }
 
+UNIT_TEST_STATUS
+EFIAPI
+TestVerifyHashMultiBuffer (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  HASH_MULTI_BUFFER_TEST_CONTEXT  *HashTestContext;
+  HASH_MULTI_BUFFER               Buffers[ARRAY_SIZE (mMultiBufferDataSizes)];
+  UINT8                           Digests[ARRAY_SIZE (mMultiBufferDataSizes)][MAX_DIGEST_SIZE];
+  UINT8                           Digest[MAX_DIGEST_SIZE];
+  UINT8                           *Data;
+  UINTN                           MaxDataSize;
+  UINTN                           Index;
+  UINTN                           Count;
+  BOOLEAN                         Status;
+
+  HashTestContext = Context;
+
+  MaxDataSize = 0;
+  for (Index = 0; Index < ARRAY_SIZE (mMultiBufferDataSizes); Index++) {
+    MaxDataSize = MAX (MaxDataSize, mMultiBufferDataSizes[Index]);
+  }
+
+  Data = AllocatePool (MaxDataSize);
+  UT_ASSERT_NOT_NULL (Data);
+  for (Index = 0; Index < MaxDataSize; Index++) {
+    Data[Index] = (UINT8)(Index * 7 + (Index >> 8));
+  }
+
+  //
+  // Every buffer starts at a different offset so that no two messages are the
+  // same, and the digests must match the single buffer ones for any count.
+  //
+  for (Count = 0; Count <= ARRAY_SIZE (mMultiBufferDataSizes); Count++) {
+    for (Index = 0; Index < Count; Index++) {
+      Buffers[Index].DataSize  = mMultiBufferDataSizes[Index] - MIN (Index, mMultiBufferDataSizes[Index]);
+      Buffers[Index].Data      = Data + (mMultiBufferDataSizes[Index] - Buffers[Index].DataSize);
+      Buffers[Index].HashValue = Digests[Index];
+      ZeroMem (Digests[Index], MAX_DIGEST_SIZE);
+    }
+
+    Status = HashTestContext->HashAllMultiBuffer (Buffers, Count);
+    UT_ASSERT_TRUE (Status);
+
+    for (Index = 0; Index < Count; Index++) {
+      ZeroMem (Digest, MAX_DIGEST_SIZE);
+      Status = HashTestContext->HashAll (Buffers[Index].Data, Buffers[Index].DataSize, Digest);
+      UT_ASSERT_TRUE (Status);
+      UT_ASSERT_MEM_EQUAL (Digests[Index], Digest, HashTestContext->DigestSize);
+    }
+  }
+
+  FreePool (Data);
+
+  return UNIT_TEST_PASSED;
+}
+
 TEST_DESC  mHashTest[] = {
   //
   // -----Description----------------Class---------------------Function---------------Pre------------------Post------------Context
@@ -229,6 +310,8 @@ TEST_DESC  mHashTest[] = {
   { "TestVerifySha1()",   "CryptoPkg.BaseCryptLib.Hash", TestVerifyHash, TestVerifyHashPreReq, TestVerifyHashCleanUp, &mSha1TestCtx   },
   { "TestVerifySha256()", "CryptoPkg.BaseCryptLib.Hash", TestVerifyHash, TestVerifyHashPreReq, TestVerifyHashCleanUp, &mSha256TestCtx },
   { "TestVerifySha384()", "CryptoPkg.BaseCryptLib.Hash", TestVerifyHash, TestVerifyHashPreReq, TestVerifyHashCleanUp, &mSha384TestCtx },
+  { "TestVerifySha256MultiBuffer()", "CryptoPkg.BaseCryptLib.Hash", TestVerifyHashMultiBuffer, NULL, NULL, &mSha256MultiBufferTestCtx },
+  { "TestVerifySha384MultiBuffer()", "CryptoPkg.BaseCryptLib.Hash", TestVerifyHashMultiBuffer, NULL, NULL, &mSha384MultiBufferTestCtx },
   { "TestVerifySha512()", "CryptoPkg.BaseCryptLib.Hash", TestVerifyHash, TestVerifyHashPreReq, TestVerifyHashCleanUp, &mSha512TestCtx },
   { "TestVerifySm3()",    "CryptoPkg.BaseCryptLib.Hash", TestVerifyHash, TestVerifyHashPreReq, TestVerifyHashCleanUp, &mSm3TestCtx    },
 };
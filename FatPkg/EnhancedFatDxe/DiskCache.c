@@ -214,6 +214,7 @@ CacheFatDiskIo (
 
   When this function is called by write command, all entries in this range
   are older than the contents in disk, so they are invalid; just mark them invalid.
+  Entries the range covers only in part are updated with the written data instead.
 
   When this function is called by read command, if any entry in this range
   is dirty, it means that the relative info directly read from media is older than
@@ -221,62 +222,168 @@ CacheFatDiskIo (
 
   @param  Volume                - FAT file system volume.
   @param  IoMode                - This function is called by read command or write command
-  @param  StartPageNo           - First PageNo to be checked in the cache.
-  @param  EndPageNo             - Last PageNo to be checked in the cache.
-  @param  Buffer                - The user buffer need to update. Only when doing the read command
-                          and there is dirty cache in the cache range, this parameter will be used.
+  @param  EntryPos              - Offset of the range from the start of the Data cache area.
+  @param  Length                - Length of the range.
+  @param  Buffer                - The user buffer of the access. It is updated when doing the read
+                          command and there is dirty cache in the range, and is the source of
+                          the update of partly covered entries when doing the write command.
 
 **/
 STATIC
 VOID
 FatFlushDataCacheRange (
-  IN  FAT_VOLUME  *Volume,
-  IN  IO_MODE     IoMode,
-  IN  UINTN       StartPageNo,
-  IN  UINTN       EndPageNo,
-  OUT UINT8       *Buffer
+  IN     FAT_VOLUME  *Volume,
+  IN     IO_MODE     IoMode,
+  IN     UINT64      EntryPos,
+  IN     UINTN       Length,
+  IN OUT UINT8       *Buffer
   )
 {
   UINTN       PageNo;
+  UINTN       StartPageNo;
+  UINTN       EndPageNo;
   UINTN       GroupNo;
   UINTN       GroupMask;
-  UINTN       PageSize;
   UINT8       PageAlignment;
+  UINT64      PagePos;
+  UINT64      Start;
+  UINT64      End;
+  UINTN       Index;
+  UINTN       Count;
   DISK_CACHE  *DiskCache;
   CACHE_TAG   *CacheTag;
-  UINT8       *BaseAddress;
+  UINT8       *PageAddress;
 
   DiskCache     = &Volume->DiskCache[CacheData];
-  BaseAddress   = DiskCache->CacheBase;
   GroupMask     = DiskCache->GroupMask;
   PageAlignment = DiskCache->PageAlignment;
-  PageSize      = (UINTN)1 << PageAlignment;
+  StartPageNo   = (UINTN)RShiftU64 (EntryPos, PageAlignment);
+  EndPageNo     = (UINTN)RShiftU64 (EntryPos + Length - 1, PageAlignment);
+
+  //
+  // A range larger than the cache only has to look at every cache tag once.
+  //
+  Count = MIN (EndPageNo - StartPageNo, GroupMask) + 1;
+  for (Index = 0; Index < Count; Index++) {
+    CacheTag = &DiskCache->CacheTag[(StartPageNo + Index) & GroupMask];
+    PageNo   = CacheTag->PageNo;
+    if ((CacheTag->RealSize == 0) || (PageNo < StartPageNo) || (PageNo > EndPageNo)) {
+      continue;
+    }
 
-  for (PageNo = StartPageNo; PageNo < EndPageNo; PageNo++) {
-    GroupNo  = PageNo & GroupMask;
-    CacheTag = &DiskCache->CacheTag[GroupNo];
-    if ((CacheTag->RealSize > 0) && (CacheTag->PageNo == PageNo)) {
+    GroupNo     = PageNo & GroupMask;
+    PageAddress = DiskCache->CacheBase + (GroupNo << PageAlignment);
+    PagePos     = LShiftU64 (PageNo, PageAlignment);
+    Start       = MAX (PagePos, EntryPos);
+    End         = MIN (PagePos + CacheTag->RealSize, EntryPos + Length);
+    if (Start >= End) {
+      continue;
+    }
+
+    if (IoMode == ReadDisk) {
       //
       // When reading data from disk directly, if some dirty data
       // in cache is in this range, this data in the Buffer needs to
       // be updated with the cache's dirty data.
       //
-      if (IoMode == ReadDisk) {
-        if (CacheTag->Dirty) {
-          CopyMem (
-            Buffer + ((PageNo - StartPageNo) << PageAlignment),
-            BaseAddress + (GroupNo << PageAlignment),
-            PageSize
-            );
-        }
-      } else {
-        //
-        // Make all valid entries in this range invalid.
-        //
-        CacheTag->RealSize = 0;
+      if (CacheTag->Dirty) {
+        CopyMem (
+          Buffer + (UINTN)(Start - EntryPos),
+          PageAddress + (UINTN)(Start - PagePos),
+          (UINTN)(End - Start)
+          );
       }
+    } else if ((Start == PagePos) && (End == PagePos + CacheTag->RealSize)) {
+      //
+      // Make all valid entries in this range invalid.
+      //
+      CacheTag->RealSize = 0;
+    } else {
+      //
+      // Keep the partly written entry in sync with the disk.
+      //
+      CopyMem (
+        PageAddress + (UINTN)(Start - PagePos),
+        Buffer + (UINTN)(Start - EntryPos),
+        (UINTN)(End - Start)
+        );
+    }
+  }
+}
+
+/**
+
+  Read the cache page of CacheTag and the cache pages that follow it with one
+  disk read.
+
+  The read stops before a page that is already in the cache, before a dirty
+  cache page, at the end of the cache buffer and at the limit of the cache.
+
+  @param  Volume                - FAT file system volume.
+  @param  DataType              - Indicate the cache type.
+  @param  CacheTag              - The Cache Tag of the first cache page, with PageNo set.
+  @param  PageCount             - The maximum number of cache pages to read.
+
+  @retval EFI_SUCCESS           - The cache pages are read successfully.
+  @return Others                - An error occurred when reading the cache pages.
+
+**/
+STATIC
+EFI_STATUS
+FatReadAheadCachePages (
+  IN FAT_VOLUME       *Volume,
+  IN CACHE_DATA_TYPE  DataType,
+  IN CACHE_TAG        *CacheTag,
+  IN UINTN            PageCount
+  )
+{
+  EFI_STATUS  Status;
+  DISK_CACHE  *DiskCache;
+  CACHE_TAG   *NextTag;
+  UINTN       GroupNo;
+  UINTN       PageNo;
+  UINTN       PageSize;
+  UINTN       Index;
+  UINTN       ReadSize;
+  UINT64      EntryPos;
+  UINT8       PageAlignment;
+
+  DiskCache     = &Volume->DiskCache[DataType];
+  PageNo        = CacheTag->PageNo;
+  GroupNo       = PageNo & DiskCache->GroupMask;
+  PageAlignment = DiskCache->PageAlignment;
+  PageSize      = (UINTN)1 << PageAlignment;
+  EntryPos      = DiskCache->BaseAddress + LShiftU64 (PageNo, PageAlignment);
+
+  PageCount = MIN (PageCount, DiskCache->GroupMask + 1 - GroupNo);
+  for (Index = 1; Index < PageCount; Index++) {
+    NextTag = CacheTag + Index;
+    if ((NextTag->RealSize > 0) && (NextTag->Dirty || (NextTag->PageNo == PageNo + Index))) {
+      break;
+    }
+  }
+
+  PageCount = Index;
+  ReadSize  = PageCount << PageAlignment;
+  if (DiskCache->LimitAddress - EntryPos < ReadSize) {
+    DEBUG ((DEBUG_INFO, "FatDiskIo: Cache Page OutBound occurred! \n"));
+    ReadSize = (UINTN)(DiskCache->LimitAddress - EntryPos);
+  }
+
+  Status = FatDiskIo (Volume, ReadDisk, EntryPos, ReadSize, DiskCache->CacheBase + (GroupNo << PageAlignment), NULL);
+  for (Index = 0; Index < PageCount && ReadSize > 0; Index++) {
+    NextTag = CacheTag + Index;
+    ClearCacheTagDirtyState (NextTag);
+    NextTag->PageNo   = PageNo + Index;
+    NextTag->RealSize = 0;
+    if (!EFI_ERROR (Status)) {
+      NextTag->RealSize = MIN (ReadSize, PageSize);
     }
+
+    ReadSize -= MIN (ReadSize, PageSize);
   }
+
+  return Status;
 }
 
 /**
@@ -360,6 +467,8 @@ FatExchangeCachePage (
   @param  CacheDataType         - The cache type: CACHE_FAT or CACHE_DATA.
   @param  PageNo                - PageNo to match with the cache.
   @param  CacheTag              - The Cache Tag for the current cache page.
+  @param  PageCount             - The number of cache pages from PageNo to read
+                                  ahead on a cache miss.
 
   @retval EFI_SUCCESS           - Get the cache page successfully.
   @return other                 - An error occurred when accessing data.
@@ -371,7 +480,8 @@ FatGetCachePage (
   IN FAT_VOLUME       *Volume,
   IN CACHE_DATA_TYPE  CacheDataType,
   IN UINTN            PageNo,
-  IN CACHE_TAG        *CacheTag
+  IN CACHE_TAG        *CacheTag,
+  IN UINTN            PageCount
   )
 {
   EFI_STATUS  Status;
@@ -399,7 +509,11 @@ FatGetCachePage (
   // Load new data from disk;
   //
   CacheTag->PageNo = PageNo;
-  Status           = FatExchangeCachePage (Volume, CacheDataType, ReadDisk, CacheTag, NULL);
+  if (PageCount > 1) {
+    return FatReadAheadCachePages (Volume, CacheDataType, CacheTag, PageCount);
+  }
+
+  Status = FatExchangeCachePage (Volume, CacheDataType, ReadDisk, CacheTag, NULL);
 
   return Status;
 }
@@ -416,6 +530,8 @@ FatGetCachePage (
   @param  Offset                - The starting byte of cache page.
   @param  Length                - The number of bytes that is read or written
   @param  Buffer                - Buffer containing cache data.
+  @param  PageCount             - The number of cache pages from PageNo to read
+                                  ahead on a cache miss.
 
   @retval EFI_SUCCESS           - The data was accessed correctly.
   @return Others                - An error occurred when accessing unaligned cache page.
@@ -430,7 +546,8 @@ FatAccessUnalignedCachePage (
   IN     UINTN            PageNo,
   IN     UINTN            Offset,
   IN     UINTN            Length,
-  IN OUT VOID             *Buffer
+  IN OUT VOID             *Buffer,
+  IN     UINTN            PageCount
   )
 {
   EFI_STATUS  Status;
@@ -443,7 +560,7 @@ FatAccessUnalignedCachePage (
   DiskCache = &Volume->DiskCache[CacheDataType];
   GroupNo   = PageNo & DiskCache->GroupMask;
   CacheTag  = &DiskCache->CacheTag[GroupNo];
-  Status    = FatGetCachePage (Volume, CacheDataType, PageNo, CacheTag);
+  Status    = FatGetCachePage (Volume, CacheDataType, PageNo, CacheTag, PageCount);
   if (!EFI_ERROR (Status)) {
     Source      = DiskCache->CacheBase + (GroupNo << DiskCache->PageAlignment) + Offset;
     Destination = Buffer;
@@ -472,9 +589,13 @@ FatAccessUnalignedCachePage (
      page hit, just return the cache page; else update the related cache page and return
      the right cache page.
   2. Access of Data cache (CACHE_DATA):
-     The access data will be divided into UnderRun data, Aligned data and OverRun data;
+     An access of at least FAT_DIRECT_TRANSFER_MIN_PAGES cache pages is done with one
+     disk transfer from or to Buffer. Other accesses are divided into UnderRun data,
+     Aligned data and OverRun data;
      The UnderRun data and OverRun data will be accessed by the Data cache,
      but the Aligned data will be accessed with disk directly.
+     A Data cache miss of a read loads the cache pages up to DiskCache->ReadAhead
+     bytes after the access with the same disk read.
 
   @param  Volume                - FAT file system volume.
   @param  CacheDataType         - The type of cache: CACHE_DATA or CACHE_FAT.
@@ -509,6 +630,7 @@ FatAccessCache (
   UINTN       PageNo;
   UINTN       AlignedPageCount;
   UINTN       OverRunPageNo;
+  UINTN       ReadAheadPageNo;
   DISK_CACHE  *DiskCache;
   UINT64      EntryPos;
   UINT8       PageAlignment;
@@ -523,13 +645,46 @@ FatAccessCache (
   PageNo        = (UINTN)RShiftU64 (EntryPos, PageAlignment);
   UnderRun      = ((UINTN)EntryPos) & (PageSize - 1);
 
+  if ((CacheDataType == CacheData) && (BufferSize >= (FAT_DIRECT_TRANSFER_MIN_PAGES << PageAlignment))) {
+    //
+    // Large transfers bypass the cache, the cache pages they overlap are
+    // brought in sync afterwards.
+    //
+    Status = FatDiskIo (Volume, IoMode, Offset, BufferSize, Buffer, Task);
+    if (!EFI_ERROR (Status)) {
+      FatFlushDataCacheRange (Volume, IoMode, EntryPos, BufferSize, Buffer);
+    }
+
+    return Status;
+  }
+
+  //
+  // The page after the last page a cache miss may read ahead
+  //
+  ReadAheadPageNo = 0;
+  if ((IoMode == ReadDisk) && (DiskCache->ReadAhead != 0)) {
+    ReadAheadPageNo = (UINTN)RShiftU64 (EntryPos + BufferSize + DiskCache->ReadAhead - 1, PageAlignment) + 1;
+  }
+
   if (UnderRun > 0) {
     Length = PageSize - UnderRun;
     if (Length > BufferSize) {
       Length = BufferSize;
     }
 
-    Status = FatAccessUnalignedCachePage (Volume, CacheDataType, IoMode, PageNo, UnderRun, Length, Buffer);
+    //
+    // Only read ahead if no page after this one is read anyway.
+    //
+    Status = FatAccessUnalignedCachePage (
+               Volume,
+               CacheDataType,
+               IoMode,
+               PageNo,
+               UnderRun,
+               Length,
+               Buffer,
+               (Length == BufferSize && ReadAheadPageNo > PageNo) ? ReadAheadPageNo - PageNo : 1
+               );
     if (EFI_ERROR (Status)) {
       return Status;
     }
@@ -550,9 +705,9 @@ FatAccessCache (
     //
     ASSERT (CacheDataType == CacheData);
 
-    EntryPos    = Volume->RootPos + LShiftU64 (PageNo, PageAlignment);
+    EntryPos    = LShiftU64 (PageNo, PageAlignment);
     AlignedSize = AlignedPageCount << PageAlignment;
-    Status      = FatDiskIo (Volume, IoMode, EntryPos, AlignedSize, Buffer, Task);
+    Status      = FatDiskIo (Volume, IoMode, Volume->RootPos + EntryPos, AlignedSize, Buffer, Task);
     if (EFI_ERROR (Status)) {
       return Status;
     }
@@ -561,7 +716,7 @@ FatAccessCache (
     // If these access data over laps the relative cache range, these cache pages need
     // to be updated.
     //
-    FatFlushDataCacheRange (Volume, IoMode, PageNo, OverRunPageNo, Buffer);
+    FatFlushDataCacheRange (Volume, IoMode, EntryPos, AlignedSize, Buffer);
     Buffer     += AlignedSize;
     BufferSize -= AlignedSize;
   }
@@ -574,7 +729,16 @@ FatAccessCache (
     //
     // Last read is not a complete page
     //
-    Status = FatAccessUnalignedCachePage (Volume, CacheDataType, IoMode, OverRunPageNo, 0, OverRun, Buffer);
+    Status = FatAccessUnalignedCachePage (
+               Volume,
+               CacheDataType,
+               IoMode,
+               OverRunPageNo,
+               0,
+               OverRun,
+               Buffer,
+               (ReadAheadPageNo > OverRunPageNo) ? ReadAheadPageNo - OverRunPageNo : 1
+               );
   }
 
   return Status;
@@ -637,7 +801,49 @@ FatVolumeFlushCache (
 
 /**
 
-  Initialize the disk cache according to Volume's FatType.
+  Get the number of Data cache pages of a volume.
+
+  The Data cache is PcdFatDataCacheSize bytes, or a share of the volume size if
+  the PCD is FAT_DATACACHE_SIZE_VOLUME, rounded down to a power of two number
+  of cache pages between FAT_DATACACHE_GROUP_MIN_COUNT and
+  FAT_DATACACHE_GROUP_MAX_COUNT. The default of 0 keeps the minimum.
+
+  @param  Volume                - FAT file system volume.
+  @param  PageAlignment         - The alignment of the Data cache pages.
+
+  @return The number of Data cache pages.
+
+**/
+STATIC
+UINTN
+FatGetDataCacheGroupCount (
+  IN FAT_VOLUME  *Volume,
+  IN UINT8       PageAlignment
+  )
+{
+  UINT64  CacheSize;
+  UINT64  GroupCount;
+
+  CacheSize = PcdGet32 (PcdFatDataCacheSize);
+  if (CacheSize == FAT_DATACACHE_SIZE_VOLUME) {
+    CacheSize = RShiftU64 (Volume->VolumeSize, FAT_DATACACHE_VOLUME_SHIFT);
+  }
+
+  GroupCount = RShiftU64 (CacheSize, PageAlignment);
+  if (GroupCount <= FAT_DATACACHE_GROUP_MIN_COUNT) {
+    return FAT_DATACACHE_GROUP_MIN_COUNT;
+  }
+
+  if (GroupCount >= FAT_DATACACHE_GROUP_MAX_COUNT) {
+    return FAT_DATACACHE_GROUP_MAX_COUNT;
+  }
+
+  return GetPowerOfTwo32 ((UINT32)GroupCount);
+}
+
+/**
+
+  Initialize the disk cache according to Volume's FatType and size.
 
   @param  Volume                - FAT file system volume.
 
@@ -652,6 +858,7 @@ FatInitializeDiskCache (
 {
   DISK_CACHE  *DiskCache;
   UINTN       FatCacheGroupCount;
+  UINTN       DataCacheGroupCount;
   UINTN       DataCacheSize;
   UINTN       FatCacheSize;
   UINT8       *CacheBuffer;
@@ -670,18 +877,21 @@ FatInitializeDiskCache (
     DiskCache[CacheData].PageAlignment = FAT_DATACACHE_PAGE_MAX_ALIGNMENT;
   }
 
-  DiskCache[CacheData].GroupMask    = FAT_DATACACHE_GROUP_COUNT - 1;
-  DiskCache[CacheData].BaseAddress  = Volume->RootPos;
-  DiskCache[CacheData].LimitAddress = Volume->VolumeSize;
-  DiskCache[CacheFat].GroupMask     = FatCacheGroupCount - 1;
-  DiskCache[CacheFat].BaseAddress   = Volume->FatPos;
-  DiskCache[CacheFat].LimitAddress  = Volume->FatPos + Volume->FatSize;
-  FatCacheSize                      = FatCacheGroupCount << DiskCache[CacheFat].PageAlignment;
-  DataCacheSize                     = FAT_DATACACHE_GROUP_COUNT << DiskCache[CacheData].PageAlignment;
+  DataCacheGroupCount = FatGetDataCacheGroupCount (Volume, DiskCache[CacheData].PageAlignment);
+
+  DiskCache[CacheData].GroupMask      = DataCacheGroupCount - 1;
+  DiskCache[CacheData].BaseAddress    = Volume->RootPos;
+  DiskCache[CacheData].LimitAddress   = Volume->VolumeSize;
+  DiskCache[CacheData].ReadAheadLimit = (DataCacheGroupCount / 4) << DiskCache[CacheData].PageAlignment;
+  DiskCache[CacheFat].GroupMask       = FatCacheGroupCount - 1;
+  DiskCache[CacheFat].BaseAddress     = Volume->FatPos;
+  DiskCache[CacheFat].LimitAddress    = Volume->FatPos + Volume->FatSize;
+  FatCacheSize                        = FatCacheGroupCount << DiskCache[CacheFat].PageAlignment;
+  DataCacheSize                       = DataCacheGroupCount << DiskCache[CacheData].PageAlignment;
   //
-  // Allocate the Fat Cache buffer
+  // Allocate the Fat Cache buffer, the Data Cache buffer and the cache tags
   //
-  CacheBuffer = AllocateZeroPool (FatCacheSize + DataCacheSize);
+  CacheBuffer = AllocateZeroPool (FatCacheSize + DataCacheSize + (FatCacheGroupCount + DataCacheGroupCount) * sizeof (CACHE_TAG));
   if (CacheBuffer == NULL) {
     return EFI_OUT_OF_RESOURCES;
   }
@@ -689,6 +899,8 @@ FatInitializeDiskCache (
   Volume->CacheBuffer            = CacheBuffer;
   DiskCache[CacheFat].CacheBase  = CacheBuffer;
   DiskCache[CacheData].CacheBase = CacheBuffer + FatCacheSize;
+  DiskCache[CacheFat].CacheTag   = (CACHE_TAG *)(CacheBuffer + FatCacheSize + DataCacheSize);
+  DiskCache[CacheData].CacheTag  = DiskCache[CacheFat].CacheTag + FatCacheGroupCount;
 
   DiskCache[CacheFat].BlockSize  = Volume->BlockIo->Media->BlockSize;
   DiskCache[CacheData].BlockSize = Volume->BlockIo->Media->BlockSize;
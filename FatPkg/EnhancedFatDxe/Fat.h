@@ -80,10 +80,39 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #define FAT_FATCACHE_PAGE_MAX_ALIGNMENT   15
 #define FAT_DATACACHE_PAGE_MIN_ALIGNMENT  13
 #define FAT_DATACACHE_PAGE_MAX_ALIGNMENT  16
-#define FAT_DATACACHE_GROUP_COUNT         64
+#define FAT_DATACACHE_GROUP_MIN_COUNT     64
+#define FAT_DATACACHE_GROUP_MAX_COUNT     512
 #define FAT_FATCACHE_GROUP_MIN_COUNT      1
 #define FAT_FATCACHE_GROUP_MAX_COUNT      16
 
+//
+// If PcdFatDataCacheSize is FAT_DATACACHE_SIZE_VOLUME, the data cache is sized
+// to the volume size shifted right by FAT_DATACACHE_VOLUME_SHIFT.
+//
+#define FAT_DATACACHE_SIZE_VOLUME   MAX_UINT32
+#define FAT_DATACACHE_VOLUME_SHIFT  8
+
+//
+// Data cache accesses of at least FAT_DIRECT_TRANSFER_MIN_PAGES cache pages go
+// to the disk with a single transfer from or to the caller's buffer.
+//
+#define FAT_DIRECT_TRANSFER_MIN_PAGES  4
+
+//
+// The read-ahead window of a sequentially read file starts at
+// FAT_READ_AHEAD_MIN_SIZE and doubles with every read, up to a quarter of the
+// data cache.
+//
+#define FAT_READ_AHEAD_MIN_SIZE  SIZE_128KB
+
+//
+// The extent map of an OFile starts with room for FAT_EXTENT_MIN_COUNT extents
+// and stops growing at FAT_EXTENT_MAX_COUNT extents. The part of a more
+// fragmented file beyond the map is located by walking its cluster chain.
+//
+#define FAT_EXTENT_MIN_COUNT  16
+#define FAT_EXTENT_MAX_COUNT  4096
+
 // For cache block bits, use a UINT64
 typedef UINT64 DIRTY_BLOCKS;
 #define BITS_PER_BYTE         8
@@ -170,7 +199,13 @@ typedef struct {
   BOOLEAN      Dirty;
   UINT8        PageAlignment;
   UINTN        GroupMask;
-  CACHE_TAG    CacheTag[FAT_DATACACHE_GROUP_COUNT];
+  //
+  // The bytes after the current access that a cache miss may load with the
+  // same disk read, and the limit of the read-ahead window
+  //
+  UINTN        ReadAhead;
+  UINTN        ReadAheadLimit;
+  CACHE_TAG    *CacheTag;
 } DISK_CACHE;
 
 //
@@ -243,6 +278,15 @@ typedef struct {
   LIST_ENTRY            Link;
 } FAT_SUBTASK;
 
+//
+// FAT_EXTENT - A run of contiguous clusters of an opened file
+//
+typedef struct {
+  UINTN    Index;                             // Index of the first cluster in the file
+  UINTN    Cluster;                           // First cluster of the run
+  UINTN    Count;                             // Number of clusters in the run
+} FAT_EXTENT;
+
 //
 // FAT_OFILE - Each opened file
 //
@@ -266,6 +310,12 @@ struct _FAT_OFILE {
   UINTN         FileCluster;
   UINTN         FileCurrentCluster;
   UINTN         FileLastCluster;
+  //
+  // The extent map of the leading part of the cluster chain, built on demand
+  //
+  FAT_EXTENT    *Extents;
+  UINTN         ExtentCount;
+  UINTN         ExtentCapacity;
 
   //
   // Dirty is set if there have been any updates to the
@@ -286,6 +336,11 @@ struct _FAT_OFILE {
   UINT64        PosDisk;        // on the disk
   UINTN         PosRem;         // remaining in this disk run
   //
+  // Sequential read detection
+  //
+  UINTN         ReadAheadPosition; // where the next sequential read starts
+  UINTN         ReadAheadSize;     // current read-ahead window
+  //
   // The opened parent, full path length and currently opened child files
   //
   FAT_OFILE     *Parent;
@@ -713,7 +768,7 @@ FatWriteEx (
 
 /**
 
-  Initialize the disk cache according to Volume's FatType.
+  Initialize the disk cache according to Volume's FatType and size.
 
   @param  Volume                - FAT file system volume.
 
@@ -361,12 +361,25 @@ FatShrinkEof (
   UINTN       CurSize;
   UINTN       Cluster;
   UINTN       LastCluster;
+  FAT_EXTENT  *Extent;
 
   Volume = OFile->Volume;
   ASSERT_VOLUME_LOCKED (Volume);
 
   NewSize = FatSizeToClusters (Volume, OFile->FileSize);
 
+  //
+  // Drop the clusters to be freed from the extent map
+  //
+  while ((OFile->ExtentCount > 0) && (OFile->Extents[OFile->ExtentCount - 1].Index >= NewSize)) {
+    OFile->ExtentCount--;
+  }
+
+  if (OFile->ExtentCount > 0) {
+    Extent        = &OFile->Extents[OFile->ExtentCount - 1];
+    Extent->Count = MIN (Extent->Count, NewSize - Extent->Index);
+  }
+
   //
   // Find the address of the last cluster
   //
@@ -545,11 +558,141 @@ Done:
   return Status;
 }
 
+/**
+
+  Extend the extent map of OFile until it covers the cluster of the file at
+  ClusterIndex, or the end of the cluster chain.
+
+  @param  OFile                 - The open file.
+  @param  ClusterIndex          - The index of the cluster in the file.
+
+  @retval EFI_SUCCESS           - The map covers the cluster, or the whole cluster chain.
+  @retval EFI_OUT_OF_RESOURCES  - The map cannot grow any further.
+  @retval EFI_VOLUME_CORRUPTED  - Cluster chain corrupt.
+
+**/
+STATIC
+EFI_STATUS
+FatExtendExtentMap (
+  IN FAT_OFILE  *OFile,
+  IN UINTN      ClusterIndex
+  )
+{
+  FAT_VOLUME  *Volume;
+  FAT_EXTENT  *Extent;
+  FAT_EXTENT  *NewExtents;
+  UINTN       NewCapacity;
+  UINTN       Covered;
+  UINTN       Cluster;
+
+  Volume  = OFile->Volume;
+  Extent  = NULL;
+  Covered = 0;
+  if (OFile->ExtentCount > 0) {
+    Extent  = &OFile->Extents[OFile->ExtentCount - 1];
+    Covered = Extent->Index + Extent->Count;
+  }
+
+  while (Covered <= ClusterIndex) {
+    if (Extent == NULL) {
+      Cluster = OFile->FileCluster;
+      if (Cluster == FAT_CLUSTER_FREE) {
+        return EFI_SUCCESS;
+      }
+    } else {
+      Cluster = FatGetFatEntry (Volume, Extent->Cluster + Extent->Count - 1);
+    }
+
+    if (FAT_END_OF_FAT_CHAIN (Cluster)) {
+      return EFI_SUCCESS;
+    }
+
+    if ((Cluster < FAT_MIN_CLUSTER) || (Cluster > Volume->MaxCluster + 1)) {
+      return EFI_VOLUME_CORRUPTED;
+    }
+
+    if ((Extent != NULL) && (Cluster == Extent->Cluster + Extent->Count)) {
+      Extent->Count++;
+    } else {
+      if (OFile->ExtentCount == OFile->ExtentCapacity) {
+        if (OFile->ExtentCapacity >= FAT_EXTENT_MAX_COUNT) {
+          return EFI_OUT_OF_RESOURCES;
+        }
+
+        NewCapacity = MAX (OFile->ExtentCapacity * 2, FAT_EXTENT_MIN_COUNT);
+        NewExtents  = ReallocatePool (
+                        OFile->ExtentCapacity * sizeof (FAT_EXTENT),
+                        NewCapacity * sizeof (FAT_EXTENT),
+                        OFile->Extents
+                        );
+        if (NewExtents == NULL) {
+          return EFI_OUT_OF_RESOURCES;
+        }
+
+        OFile->Extents        = NewExtents;
+        OFile->ExtentCapacity = NewCapacity;
+      }
+
+      Extent          = &OFile->Extents[OFile->ExtentCount++];
+      Extent->Index   = Covered;
+      Extent->Cluster = Cluster;
+      Extent->Count   = 1;
+    }
+
+    Covered++;
+  }
+
+  return EFI_SUCCESS;
+}
+
+/**
+
+  Find the extent of OFile's extent map that contains the cluster of the file
+  at ClusterIndex.
+
+  @param  OFile                 - The open file.
+  @param  ClusterIndex          - The index of the cluster in the file.
+
+  @return The extent that contains the cluster, or NULL if the map does not cover it.
+
+**/
+STATIC
+FAT_EXTENT *
+FatFindExtent (
+  IN FAT_OFILE  *OFile,
+  IN UINTN      ClusterIndex
+  )
+{
+  FAT_EXTENT  *Extent;
+  UINTN       Low;
+  UINTN       High;
+  UINTN       Middle;
+
+  Low  = 0;
+  High = OFile->ExtentCount;
+  while (Low < High) {
+    Middle = (Low + High) / 2;
+    Extent = &OFile->Extents[Middle];
+    if (ClusterIndex < Extent->Index) {
+      High = Middle;
+    } else if (ClusterIndex >= Extent->Index + Extent->Count) {
+      Low = Middle + 1;
+    } else {
+      return Extent;
+    }
+  }
+
+  return NULL;
+}
+
 /**
 
   Seek OFile to requested position, and calculate the number of
   consecutive clusters from the position in the file
 
+  The clusters are located through the extent map of the file, which is
+  extended on demand up to the end of the access.
+
   @param  OFile                 - The open file.
   @param  Position              - The file's position which will be accessed.
   @param  PosLimit              - The maximum length current reading/writing may access
@@ -566,9 +709,14 @@ FatOFilePosition (
   )
 {
   FAT_VOLUME  *Volume;
+  FAT_EXTENT  *Extent;
+  EFI_STATUS  Status;
   UINTN       ClusterSize;
+  UINTN       ClusterIndex;
   UINTN       Cluster;
   UINTN       StartPos;
+  UINTN       LastCluster;
+  UINTN       MapEnd;
   UINTN       Run;
 
   Volume      = OFile->Volume;
@@ -585,36 +733,73 @@ FatOFilePosition (
     Run            = OFile->FileSize - Position;
   } else {
     //
-    // Run the file's cluster chain to find the current position
-    // If possible, run from the current cluster rather than
-    // start from beginning
-    // Assumption: OFile->Position is always consistent with
-    // OFile->FileCurrentCluster.
-    // OFile->Position is not modified outside this function;
-    // OFile->FileCurrentCluster is modified outside this function
-    // to be the same as OFile->FileCluster
-    // when OFile->FileCluster is updated, so make a check of this
-    // and invalidate the original OFile->Position in this case
+    // Map the cluster chain up to the end of the access
     //
-    Cluster  = OFile->FileCurrentCluster;
-    StartPos = OFile->Position;
-    if ((Position < StartPos) || (OFile->FileCluster == Cluster)) {
-      StartPos = 0;
-      Cluster  = OFile->FileCluster;
-    }
+    ClusterIndex = Position >> Volume->ClusterAlignment;
+    PosLimit     = MIN (MAX (PosLimit, 1), MAX_UINTN - Position);
+    Status       = FatExtendExtentMap (OFile, (Position + PosLimit - 1) >> Volume->ClusterAlignment);
+    Extent       = FatFindExtent (OFile, ClusterIndex);
+    if (Extent != NULL) {
+      Cluster  = Extent->Cluster + ClusterIndex - Extent->Index;
+      StartPos = ClusterIndex << Volume->ClusterAlignment;
+      Run      = ((Extent->Index + Extent->Count) << Volume->ClusterAlignment) - Position;
+    } else if (Status != EFI_OUT_OF_RESOURCES) {
+      DEBUG ((DEBUG_INIT | DEBUG_ERROR, "FatOFilePosition:" " cluster chain corrupt\n"));
+      return EFI_VOLUME_CORRUPTED;
+    } else {
+      //
+      // The position is beyond the extent map, run the file's cluster chain
+      // to find it. If possible, run from the current cluster or the end of
+      // the map rather than start from beginning
+      // Assumption: OFile->Position is always consistent with
+      // OFile->FileCurrentCluster.
+      // OFile->Position is not modified outside this function;
+      // OFile->FileCurrentCluster is modified outside this function
+      // to be the same as OFile->FileCluster
+      // when OFile->FileCluster is updated, so make a check of this
+      // and invalidate the original OFile->Position in this case
+      //
+      Cluster  = OFile->FileCurrentCluster;
+      StartPos = OFile->Position;
+      if ((Position < StartPos) || (OFile->FileCluster == Cluster)) {
+        StartPos = 0;
+        Cluster  = OFile->FileCluster;
+      }
 
-    while (StartPos + ClusterSize <= Position) {
-      StartPos += ClusterSize;
-      if ((Cluster == FAT_CLUSTER_FREE) || (Cluster >= FAT_CLUSTER_SPECIAL)) {
-        DEBUG ((DEBUG_INIT | DEBUG_ERROR, "FatOFilePosition:" " cluster chain corrupt\n"));
-        return EFI_VOLUME_CORRUPTED;
+      if (OFile->ExtentCount > 0) {
+        Extent = &OFile->Extents[OFile->ExtentCount - 1];
+        MapEnd = (Extent->Index + Extent->Count - 1) << Volume->ClusterAlignment;
+        if (MapEnd > StartPos) {
+          StartPos = MapEnd;
+          Cluster  = Extent->Cluster + Extent->Count - 1;
+        }
       }
 
-      Cluster = FatGetFatEntry (Volume, Cluster);
-    }
+      while (StartPos + ClusterSize <= Position) {
+        StartPos += ClusterSize;
+        if ((Cluster == FAT_CLUSTER_FREE) || (Cluster >= FAT_CLUSTER_SPECIAL)) {
+          DEBUG ((DEBUG_INIT | DEBUG_ERROR, "FatOFilePosition:" " cluster chain corrupt\n"));
+          return EFI_VOLUME_CORRUPTED;
+        }
 
-    if ((Cluster < FAT_MIN_CLUSTER) || (Cluster > Volume->MaxCluster + 1)) {
-      return EFI_VOLUME_CORRUPTED;
+        Cluster = FatGetFatEntry (Volume, Cluster);
+      }
+
+      if ((Cluster < FAT_MIN_CLUSTER) || (Cluster > Volume->MaxCluster + 1)) {
+        return EFI_VOLUME_CORRUPTED;
+      }
+
+      //
+      // Compute the number of consecutive clusters in the file
+      //
+      Run = StartPos + ClusterSize - Position;
+      if (!FAT_END_OF_FAT_CHAIN (Cluster)) {
+        LastCluster = Cluster;
+        while ((FatGetFatEntry (Volume, LastCluster) == LastCluster + 1) && Run < PosLimit) {
+          Run         += ClusterSize;
+          LastCluster += 1;
+        }
+      }
     }
 
     OFile->PosDisk = Volume->FirstClusterPos +
@@ -622,17 +807,6 @@ FatOFilePosition (
                      Position - StartPos;
     OFile->FileCurrentCluster = Cluster;
     OFile->Position           = StartPos;
-
-    //
-    // Compute the number of consecutive clusters in the file
-    //
-    Run = StartPos + ClusterSize - Position;
-    if (!FAT_END_OF_FAT_CHAIN (Cluster)) {
-      while ((FatGetFatEntry (Volume, Cluster) == Cluster + 1) && Run < PosLimit) {
-        Run     += ClusterSize;
-        Cluster += 1;
-      }
-    }
   }
 
   OFile->PosRem = Run;
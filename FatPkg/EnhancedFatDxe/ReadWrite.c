@@ -444,6 +444,8 @@ FatWriteEx (
 
   This function reads data from a file or writes data to a file.
   It uses OFile->PosRem to determine how much data can be accessed in one time.
+  While a file is read sequentially, the cache misses of a read also load the
+  data that follows it within the same run of clusters.
 
   @param  OFile                 - The open file.
   @param  IoMode                - Indicate whether the access mode is reading or writing.
@@ -467,20 +469,39 @@ FatAccessOFile (
   )
 {
   FAT_VOLUME  *Volume;
+  DISK_CACHE  *DiskCache;
   UINTN       Len;
   EFI_STATUS  Status;
   UINTN       BufferSize;
+  UINTN       ReadAhead;
 
   BufferSize = *DataBufferSize;
   Volume     = OFile->Volume;
+  DiskCache  = &Volume->DiskCache[CacheData];
   ASSERT_VOLUME_LOCKED (Volume);
 
+  //
+  // Grow the read-ahead window while the file is read sequentially
+  //
+  ReadAhead = 0;
+  if (IoMode == ReadData) {
+    if (Position != OFile->ReadAheadPosition) {
+      OFile->ReadAheadSize = 0;
+    } else if (OFile->ReadAheadSize == 0) {
+      OFile->ReadAheadSize = MIN (FAT_READ_AHEAD_MIN_SIZE, DiskCache->ReadAheadLimit);
+    } else {
+      OFile->ReadAheadSize = MIN (OFile->ReadAheadSize * 2, DiskCache->ReadAheadLimit);
+    }
+
+    ReadAhead = OFile->ReadAheadSize;
+  }
+
   Status = EFI_SUCCESS;
   while (BufferSize > 0) {
     //
     // Seek the OFile to the file position
     //
-    Status = FatOFilePosition (OFile, Position, BufferSize);
+    Status = FatOFilePosition (OFile, Position, BufferSize + ReadAhead);
     if (EFI_ERROR (Status)) {
       break;
     }
@@ -490,10 +511,18 @@ FatAccessOFile (
     //
     Len = BufferSize > OFile->PosRem ? OFile->PosRem : BufferSize;
 
+    //
+    // Only read ahead within the block run and the file
+    //
+    if (ReadAhead != 0) {
+      DiskCache->ReadAhead = MIN (ReadAhead, MIN (OFile->PosRem, OFile->FileSize - Position) - Len);
+    }
+
     //
     // Write the data
     //
-    Status = FatDiskIo (Volume, IoMode, OFile->PosDisk, Len, UserBuffer, Task);
+    Status               = FatDiskIo (Volume, IoMode, OFile->PosDisk, Len, UserBuffer, Task);
+    DiskCache->ReadAhead = 0;
     if (EFI_ERROR (Status)) {
       break;
     }
@@ -515,6 +544,10 @@ FatAccessOFile (
     ASSERT (Position <= OFile->FileSize);
   }
 
+  if (IoMode == ReadData) {
+    OFile->ReadAheadPosition = Position;
+  }
+
   //
   // Update the number of bytes accessed
   //
@@ -0,0 +1,448 @@
+/** @file
+  Host-based unit test and benchmark of the FAT disk cache.
+
+  DiskCache.c is linked against a FatDiskIo() backed by a simulated disk in
+  host memory. Every write is mirrored to a reference copy of the disk, so
+  the data read through the cache and the disk contents after a flush can be
+  checked byte for byte.
+
+  Copyright (c) 2026, Intel Corporation. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+
+#include "Fat.h"
+
+#include <Library/UnitTestLib.h>
+
+#define UNIT_TEST_APP_NAME     "FAT Disk Cache Unit Tests"
+#define UNIT_TEST_APP_VERSION  "1.0"
+
+#define TEST_DISK_SIZE          SIZE_8MB
+#define TEST_ROOT_POS           SIZE_4KB
+#define TEST_MAX_TRANSFER_SIZE  300000
+#define TEST_RANDOM_ACCESSES    20000
+#define TEST_FLUSH_INTERVAL     1000
+#define TEST_SEQUENTIAL_SIZE    SIZE_4MB
+#define TEST_SEQUENTIAL_READ    SIZE_4KB
+
+UINT8   *mTestDisk;
+UINT8   *mTestReference;
+UINT8   *mTestBuffer;
+UINTN   mTestDiskReads;
+UINT32  mTestSeed;
+
+FAT_VOLUME             mTestVolume;
+EFI_BLOCK_IO_PROTOCOL  mTestBlockIo;
+EFI_BLOCK_IO_MEDIA     mTestMedia;
+
+/**
+  Return the next value of a fixed-seed pseudo random sequence, so that every
+  run of the test issues the same accesses.
+
+  @return A pseudo random number between 0 and 0x7FFF.
+
+**/
+STATIC
+UINTN
+TestRandom (
+  VOID
+  )
+{
+  mTestSeed = mTestSeed * 1103515245 + 12345;
+  return (mTestSeed >> 16) & 0x7FFF;
+}
+
+/**
+  Return a pseudo random number of at least 30 bits.
+
+  @return A pseudo random number.
+
+**/
+STATIC
+UINTN
+TestRandomLarge (
+  VOID
+  )
+{
+  return (TestRandom () << 15) | TestRandom ();
+}
+
+/**
+  Raw disk access of the simulated disk. Reads are counted so that the
+  number of disk transfers issued by the cache can be reported.
+
+  @param  Volume                - FAT file system volume.
+  @param  IoMode                - The access mode (disk read/write or cache access).
+  @param  Offset                - The starting byte offset to read from.
+  @param  BufferSize            - Size of Buffer.
+  @param  Buffer                - Buffer containing read data.
+  @param  Task                    point to task instance.
+
+  @retval EFI_SUCCESS           - The operation is performed successfully.
+  @retval EFI_INVALID_PARAMETER - The access is beyond the end of the disk.
+
+**/
+EFI_STATUS
+FatDiskIo (
+  IN FAT_VOLUME  *Volume,
+  IN IO_MODE     IoMode,
+  IN UINT64      Offset,
+  IN UINTN       BufferSize,
+  IN OUT VOID    *Buffer,
+  IN FAT_TASK    *Task
+  )
+{
+  if ((Offset > TEST_DISK_SIZE) || (BufferSize > TEST_DISK_SIZE - Offset)) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  if (RAW_ACCESS (IoMode) == ReadDisk) {
+    mTestDiskReads++;
+    CopyMem (Buffer, mTestDisk + Offset, BufferSize);
+  } else {
+    CopyMem (mTestDisk + Offset, Buffer, BufferSize);
+  }
+
+  return EFI_SUCCESS;
+}
+
+/**
+  Flush the simulated disk. There is nothing to do.
+
+  @param  This              Indicates a pointer to the calling context.
+
+  @retval EFI_SUCCESS       All outstanding data was written to the device
+
+**/
+EFI_STATUS
+EFIAPI
+TestFlushBlocks (
+  IN EFI_BLOCK_IO_PROTOCOL  *This
+  )
+{
+  return EFI_SUCCESS;
+}
+
+/**
+  Fill the simulated disk with random data, describe it as a FAT32 volume and
+  initialize its disk cache.
+
+  @param[in]  Context  Unused.
+
+  @retval  UNIT_TEST_PASSED             The volume is ready.
+  @retval  UNIT_TEST_ERROR_TEST_FAILED  The volume could not be set up.
+
+**/
+STATIC
+UNIT_TEST_STATUS
+EFIAPI
+TestInitializeVolume (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  UINTN       Index;
+  EFI_STATUS  Status;
+
+  mTestDisk      = AllocatePool (TEST_DISK_SIZE);
+  mTestReference = AllocatePool (TEST_DISK_SIZE);
+  mTestBuffer    = AllocatePool (TEST_MAX_TRANSFER_SIZE);
+  UT_ASSERT_NOT_NULL (mTestDisk);
+  UT_ASSERT_NOT_NULL (mTestReference);
+  UT_ASSERT_NOT_NULL (mTestBuffer);
+
+  mTestSeed = 1;
+  for (Index = 0; Index < TEST_DISK_SIZE; Index++) {
+    mTestDisk[Index] = (UINT8)TestRandom ();
+  }
+
+  CopyMem (mTestReference, mTestDisk, TEST_DISK_SIZE);
+
+  ZeroMem (&mTestVolume, sizeof (mTestVolume));
+  ZeroMem (&mTestBlockIo, sizeof (mTestBlockIo));
+  ZeroMem (&mTestMedia, sizeof (mTestMedia));
+  mTestMedia.BlockSize     = 512;
+  mTestBlockIo.Media       = &mTestMedia;
+  mTestBlockIo.FlushBlocks = TestFlushBlocks;
+  mTestVolume.BlockIo      = &mTestBlockIo;
+  mTestVolume.FatType      = Fat32;
+  mTestVolume.VolumeSize   = TEST_DISK_SIZE;
+  mTestVolume.FatPos       = 512;
+  mTestVolume.FatSize      = 2048;
+  mTestVolume.NumFats      = 1;
+  mTestVolume.RootPos      = TEST_ROOT_POS;
+
+  Status = FatInitializeDiskCache (&mTestVolume);
+  UT_ASSERT_NOT_EFI_ERROR (Status);
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  Free the disk cache and the simulated disk.
+
+  @param[in]  Context  Unused.
+
+**/
+STATIC
+VOID
+EFIAPI
+TestFreeVolume (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  if (mTestVolume.CacheBuffer != NULL) {
+    FreePool (mTestVolume.CacheBuffer);
+    mTestVolume.CacheBuffer = NULL;
+  }
+
+  if (mTestDisk != NULL) {
+    FreePool (mTestDisk);
+    mTestDisk = NULL;
+  }
+
+  if (mTestReference != NULL) {
+    FreePool (mTestReference);
+    mTestReference = NULL;
+  }
+
+  if (mTestBuffer != NULL) {
+    FreePool (mTestBuffer);
+    mTestBuffer = NULL;
+  }
+}
+
+/**
+  Issue random Data cache reads and writes, small and large, with and
+  without read-ahead. Every read must return the reference data, and the
+  disk must match the reference after every flush.
+
+  @param[in]  Context  Unused.
+
+  @retval  UNIT_TEST_PASSED             The test passed.
+  @retval  UNIT_TEST_ERROR_TEST_FAILED  The test failed.
+
+**/
+STATIC
+UNIT_TEST_STATUS
+EFIAPI
+TestRandomAccessMatchesDisk (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  UINTN       Iteration;
+  UINTN       Index;
+  UINT64      Offset;
+  UINTN       Length;
+  DISK_CACHE  *DiskCache;
+  EFI_STATUS  Status;
+
+  DiskCache = &mTestVolume.DiskCache[CacheData];
+  for (Iteration = 0; Iteration < TEST_RANDOM_ACCESSES; Iteration++) {
+    Offset = TEST_ROOT_POS + TestRandomLarge () % (TEST_DISK_SIZE - TEST_ROOT_POS - TEST_MAX_TRANSFER_SIZE);
+    if (TestRandom () % 4 == 0) {
+      Length = 1 + TestRandomLarge () % TEST_MAX_TRANSFER_SIZE;
+    } else {
+      Length = 1 + TestRandom () % 9000;
+    }
+
+    if (TestRandom () % 2 == 0) {
+      DiskCache->ReadAhead = TestRandomLarge () % DiskCache->ReadAheadLimit;
+      Status               = FatAccessCache (&mTestVolume, CacheData, ReadDisk, Offset, Length, mTestBuffer, NULL);
+      DiskCache->ReadAhead = 0;
+      UT_ASSERT_NOT_EFI_ERROR (Status);
+      UT_ASSERT_MEM_EQUAL (mTestBuffer, mTestReference + Offset, Length);
+    } else {
+      for (Index = 0; Index < Length; Index++) {
+        mTestBuffer[Index] = (UINT8)TestRandom ();
+      }
+
+      CopyMem (mTestReference + Offset, mTestBuffer, Length);
+      Status = FatAccessCache (&mTestVolume, CacheData, WriteDisk, Offset, Length, mTestBuffer, NULL);
+      UT_ASSERT_NOT_EFI_ERROR (Status);
+    }
+
+    if ((Iteration + 1) % TEST_FLUSH_INTERVAL == 0) {
+      Status = FatVolumeFlushCache (&mTestVolume, NULL);
+      UT_ASSERT_NOT_EFI_ERROR (Status);
+      UT_ASSERT_MEM_EQUAL (mTestDisk, mTestReference, TEST_DISK_SIZE);
+    }
+  }
+
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  Read TEST_SEQUENTIAL_SIZE bytes in TEST_SEQUENTIAL_READ byte reads through
+  the Data cache, growing the read-ahead window the way FatAccessOFile() does
+  for a sequentially read file.
+
+  @param[in]   ReadAhead  Whether to use read-ahead.
+  @param[out]  DiskReads  The number of disk reads issued.
+
+  @retval  UNIT_TEST_PASSED             The data was read correctly.
+  @retval  UNIT_TEST_ERROR_TEST_FAILED  The test failed.
+
+**/
+STATIC
+UNIT_TEST_STATUS
+TestSequentialRead (
+  IN  BOOLEAN  ReadAhead,
+  OUT UINTN    *DiskReads
+  )
+{
+  UINT64      Offset;
+  UINTN       Window;
+  DISK_CACHE  *DiskCache;
+  EFI_STATUS  Status;
+
+  DiskCache      = &mTestVolume.DiskCache[CacheData];
+  Window         = 0;
+  mTestDiskReads = 0;
+  for (Offset = TEST_ROOT_POS + 100; Offset < TEST_ROOT_POS + 100 + TEST_SEQUENTIAL_SIZE; Offset += TEST_SEQUENTIAL_READ) {
+    if (ReadAhead) {
+      Window = (Window == 0) ? FAT_READ_AHEAD_MIN_SIZE : MIN (Window * 2, DiskCache->ReadAheadLimit);
+    }
+
+    DiskCache->ReadAhead = Window;
+    Status               = FatAccessCache (&mTestVolume, CacheData, ReadDisk, Offset, TEST_SEQUENTIAL_READ, mTestBuffer, NULL);
+    DiskCache->ReadAhead = 0;
+    UT_ASSERT_NOT_EFI_ERROR (Status);
+    UT_ASSERT_MEM_EQUAL (mTestBuffer, mTestReference + Offset, TEST_SEQUENTIAL_READ);
+  }
+
+  *DiskReads = mTestDiskReads;
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  Read a file sized range sequentially in small reads, once with a cold cache
+  and no read-ahead and once with a cold cache and read-ahead, and compare
+  the number of disk reads.
+
+  @param[in]  Context  Unused.
+
+  @retval  UNIT_TEST_PASSED             The test passed.
+  @retval  UNIT_TEST_ERROR_TEST_FAILED  The test failed.
+
+**/
+STATIC
+UNIT_TEST_STATUS
+EFIAPI
+TestSequentialReadAhead (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  UINTN             PlainReads;
+  UINTN             ReadAheadReads;
+  UNIT_TEST_STATUS  TestStatus;
+  EFI_STATUS        Status;
+
+  TestStatus = TestSequentialRead (FALSE, &PlainReads);
+  UT_ASSERT_EQUAL (TestStatus, UNIT_TEST_PASSED);
+
+  //
+  // Start again with a cold cache.
+  //
+  FreePool (mTestVolume.CacheBuffer);
+  mTestVolume.CacheBuffer = NULL;
+  Status                  = FatInitializeDiskCache (&mTestVolume);
+  UT_ASSERT_NOT_EFI_ERROR (Status);
+
+  TestStatus = TestSequentialRead (TRUE, &ReadAheadReads);
+  UT_ASSERT_EQUAL (TestStatus, UNIT_TEST_PASSED);
+
+  UT_LOG_INFO (
+    "%lu disk reads without read-ahead, %lu with read-ahead\n",
+    (UINT64)PlainReads,
+    (UINT64)ReadAheadReads
+    );
+  UT_ASSERT_TRUE (ReadAheadReads * 4 <= PlainReads);
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  Initialize the unit test framework, suite, and unit tests for the FAT disk
+  cache and run them.
+
+  @retval  EFI_SUCCESS           All test cases were dispatched.
+  @retval  EFI_OUT_OF_RESOURCES  There are not enough resources available to
+                                 initialize the unit tests.
+**/
+STATIC
+EFI_STATUS
+EFIAPI
+UnitTestingEntry (
+  VOID
+  )
+{
+  EFI_STATUS                  Status;
+  UNIT_TEST_FRAMEWORK_HANDLE  Framework;
+  UNIT_TEST_SUITE_HANDLE      DiskCacheTests;
+
+  Framework = NULL;
+
+  DEBUG ((DEBUG_INFO, "%a v%a\n", UNIT_TEST_APP_NAME, UNIT_TEST_APP_VERSION));
+
+  Status = InitUnitTestFramework (&Framework, UNIT_TEST_APP_NAME, gEfiCallerBaseName, UNIT_TEST_APP_VERSION);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "Failed in InitUnitTestFramework. Status = %r\n", Status));
+    goto EXIT;
+  }
+
+  Status = CreateUnitTestSuite (&DiskCacheTests, Framework, "Disk Cache Tests", "Fat.DiskCache", NULL, NULL);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "Failed in CreateUnitTestSuite for Disk Cache Tests\n"));
+    Status = EFI_OUT_OF_RESOURCES;
+    goto EXIT;
+  }
+
+  //
+  // --------------Suite-----------Description-------------------------------Name-------------Function----------------------Pre-------------------Post------------Context-----
+  //
+  AddTestCase (DiskCacheTests, "Random accesses match the disk", "RandomAccess", TestRandomAccessMatchesDisk, TestInitializeVolume, TestFreeVolume, NULL);
+  AddTestCase (DiskCacheTests, "Sequential read-ahead disk reads", "ReadAhead", TestSequentialReadAhead, TestInitializeVolume, TestFreeVolume, NULL);
+
+  //
+  // Execute the tests.
+  //
+  Status = RunAllTestSuites (Framework);
+
+EXIT:
+  if (Framework) {
+    FreeUnitTestFramework (Framework);
+  }
+
+  return Status;
+}
+
+///
+/// Avoid ECC error for function name that starts with lower case letter
+///
+#define DiskCacheUnitTestMain  main
+
+/**
+  Standard POSIX C entry point for host based unit test execution.
+
+  @param[in] Argc  Number of arguments
+  @param[in] Argv  Array of pointers to arguments
+
+  @retval 0      Success
+  @retval other  Error
+**/
+INT32
+DiskCacheUnitTestMain (
+  IN INT32  Argc,
+  IN CHAR8  *Argv[]
+  )
+{
+  UnitTestingEntry ();
+  return 0;
+}
@@ -638,6 +638,54 @@ DumpMemoryProfileMemoryRange (
   return (VOID *)Descriptor;
 }
 
+/**
+  Dump memory profile pool statistics information.
+
+  @param[in] PoolStatistics     Pointer to memory profile pool statistics.
+
+  @return Pointer to the end of memory profile pool statistics buffer.
+
+**/
+VOID *
+DumpMemoryProfilePoolStatistics (
+  IN MEMORY_PROFILE_POOL_STATISTICS  *PoolStatistics
+  )
+{
+  MEMORY_PROFILE_POOL_SIZE_CLASS  *SizeClass;
+  UINTN                           SizeClassIndex;
+
+  if (PoolStatistics->Header.Signature != MEMORY_PROFILE_POOL_STATISTICS_SIGNATURE) {
+    return NULL;
+  }
+
+  Print (L"MEMORY_PROFILE_POOL_STATISTICS\n");
+  Print (L"  Signature                     - 0x%08x\n", PoolStatistics->Header.Signature);
+  Print (L"  Length                        - 0x%04x\n", PoolStatistics->Header.Length);
+  Print (L"  Revision                      - 0x%04x\n", PoolStatistics->Header.Revision);
+  Print (L"  CurrentSlabPages              - 0x%016lx\n", PoolStatistics->CurrentSlabPages);
+  Print (L"  PeakSlabPages                 - 0x%016lx\n", PoolStatistics->PeakSlabPages);
+  Print (L"  SizeClassCount                - 0x%08x\n", PoolStatistics->SizeClassCount);
+
+  SizeClass = (MEMORY_PROFILE_POOL_SIZE_CLASS *)((UINTN)PoolStatistics + PoolStatistics->Header.Length);
+  for (SizeClassIndex = 0; SizeClassIndex < PoolStatistics->SizeClassCount; SizeClassIndex++) {
+    if (SizeClass->Header.Signature != MEMORY_PROFILE_POOL_SIZE_CLASS_SIGNATURE) {
+      return NULL;
+    }
+
+    Print (L"  MEMORY_PROFILE_POOL_SIZE_CLASS (0x%x)\n", SizeClassIndex);
+    Print (L"    ObjectSize              - 0x%08x\n", SizeClass->ObjectSize);
+    Print (L"    ObjectsPerSlab          - 0x%08x\n", SizeClass->ObjectsPerSlab);
+    Print (L"    AllocationCount         - 0x%016lx\n", SizeClass->AllocationCount);
+    Print (L"    FreeCount               - 0x%016lx\n", SizeClass->FreeCount);
+    Print (L"    BytesRequested          - 0x%016lx\n", SizeClass->BytesRequested);
+    Print (L"    BytesWasted             - 0x%016lx\n", SizeClass->BytesWasted);
+
+    SizeClass = (MEMORY_PROFILE_POOL_SIZE_CLASS *)((UINTN)SizeClass + SizeClass->Header.Length);
+  }
+
+  return (VOID *)SizeClass;
+}
+
 /**
   Scan memory profile by Signature.
 
@@ -695,9 +743,10 @@ DumpMemoryProfile (
   IN BOOLEAN           IsForSmm
   )
 {
-  MEMORY_PROFILE_CONTEXT       *Context;
-  MEMORY_PROFILE_FREE_MEMORY   *FreeMemory;
-  MEMORY_PROFILE_MEMORY_RANGE  *MemoryRange;
+  MEMORY_PROFILE_CONTEXT          *Context;
+  MEMORY_PROFILE_FREE_MEMORY      *FreeMemory;
+  MEMORY_PROFILE_MEMORY_RANGE     *MemoryRange;
+  MEMORY_PROFILE_POOL_STATISTICS  *PoolStatistics;
 
   Context = (MEMORY_PROFILE_CONTEXT *)ScanMemoryProfileBySignature (ProfileBuffer, ProfileSize, MEMORY_PROFILE_CONTEXT_SIGNATURE);
   if (Context != NULL) {
@@ -713,6 +762,11 @@ DumpMemoryProfile (
   if (MemoryRange != NULL) {
     DumpMemoryProfileMemoryRange (MemoryRange);
   }
+
+  PoolStatistics = (MEMORY_PROFILE_POOL_STATISTICS *)ScanMemoryProfileBySignature (ProfileBuffer, ProfileSize, MEMORY_PROFILE_POOL_STATISTICS_SIGNATURE);
+  if (PoolStatistics != NULL) {
+    DumpMemoryProfilePoolStatistics (PoolStatistics);
+  }
 }
 
 /**
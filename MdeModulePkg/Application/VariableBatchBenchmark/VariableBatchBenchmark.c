@@ -0,0 +1,493 @@
+/** @file
+  A shell application that measures a full enumeration of the variables of the
+  SMM variable driver, once with one MM communication per GetNextVariableName()
+  and GetVariable() request and once with SMM_VARIABLE_FUNCTION_GET_VARIABLE_BATCH,
+  and prints the number of SMIs and the wall time of both. The enumeration through
+  the UEFI runtime services is timed for reference.
+
+  Copyright (c) 2026, Intel Corporation. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include <Uefi.h>
+#include <Library/UefiLib.h>
+#include <Library/UefiApplicationEntryPoint.h>
+#include <Library/BaseMemoryLib.h>
+#include <Library/BaseLib.h>
+#include <Library/MemoryAllocationLib.h>
+#include <Library/DebugLib.h>
+#include <Library/TimerLib.h>
+#include <Library/UefiBootServicesTableLib.h>
+#include <Library/UefiRuntimeServicesTableLib.h>
+
+#include <Guid/SmmVariableCommon.h>
+#include <Guid/PiSmmCommunicationRegionTable.h>
+#include <Protocol/MmCommunication2.h>
+#include <Protocol/SmmVariable.h>
+
+typedef struct {
+  UINTN     Variables;
+  UINTN     DataBytes;
+  UINTN     Smis;
+  UINT64    TimeNs;
+} ENUMERATION_RESULT;
+
+EFI_MM_COMMUNICATION2_PROTOCOL  *mMmCommunication2 = NULL;
+EFI_MM_COMMUNICATE_HEADER       *mCommBuffer       = NULL;
+UINTN                           mPayloadSize;
+UINTN                           mSmiCount;
+CHAR16                          *mVariableName = NULL;
+VOID                            *mVariableData = NULL;
+
+/**
+  Gets the payload of the communication buffer.
+
+  @return The payload following the SMM variable communicate header.
+
+**/
+VOID *
+GetPayload (
+  VOID
+  )
+{
+  return ((SMM_VARIABLE_COMMUNICATE_HEADER *)mCommBuffer->Data)->Data;
+}
+
+/**
+  Sends the request in the communication buffer to the SMM variable driver.
+
+  @param[in] Function     The SMM variable function.
+  @param[in] PayloadSize  The size of the request payload.
+
+  @return The status of the MM communication, or the status returned by the
+          SMM variable driver.
+
+**/
+EFI_STATUS
+SendVariableRequest (
+  IN UINTN  Function,
+  IN UINTN  PayloadSize
+  )
+{
+  EFI_STATUS                       Status;
+  SMM_VARIABLE_COMMUNICATE_HEADER  *SmmVariableFunctionHeader;
+  UINTN                            CommSize;
+
+  CopyGuid (&mCommBuffer->HeaderGuid, &gEfiSmmVariableProtocolGuid);
+  mCommBuffer->MessageLength = SMM_VARIABLE_COMMUNICATE_HEADER_SIZE + PayloadSize;
+
+  SmmVariableFunctionHeader               = (SMM_VARIABLE_COMMUNICATE_HEADER *)mCommBuffer->Data;
+  SmmVariableFunctionHeader->Function     = Function;
+  SmmVariableFunctionHeader->ReturnStatus = EFI_PROTOCOL_ERROR;
+
+  CommSize = SMM_COMMUNICATE_HEADER_SIZE + SMM_VARIABLE_COMMUNICATE_HEADER_SIZE + PayloadSize;
+  Status   = mMmCommunication2->Communicate (mMmCommunication2, mCommBuffer, mCommBuffer, &CommSize);
+  mSmiCount++;
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  return SmmVariableFunctionHeader->ReturnStatus;
+}
+
+/**
+  Reads one variable with a single SMM_VARIABLE_FUNCTION_GET_VARIABLE request.
+
+  @param[in]  VariableName  Name of the variable.
+  @param[in]  VendorGuid    Vendor GUID of the variable.
+  @param[out] DataSize      The size of the variable data.
+
+  @return The status returned by the SMM variable driver.
+
+**/
+EFI_STATUS
+GetVariableFromSmm (
+  IN  CHAR16    *VariableName,
+  IN  EFI_GUID  *VendorGuid,
+  OUT UINTN     *DataSize
+  )
+{
+  EFI_STATUS                                Status;
+  SMM_VARIABLE_COMMUNICATE_ACCESS_VARIABLE  *SmmVariableHeader;
+
+  SmmVariableHeader = GetPayload ();
+  CopyGuid (&SmmVariableHeader->Guid, VendorGuid);
+  SmmVariableHeader->NameSize   = StrSize (VariableName);
+  SmmVariableHeader->DataSize   = mPayloadSize - OFFSET_OF (SMM_VARIABLE_COMMUNICATE_ACCESS_VARIABLE, Name) - SmmVariableHeader->NameSize;
+  SmmVariableHeader->Attributes = 0;
+  CopyMem (SmmVariableHeader->Name, VariableName, SmmVariableHeader->NameSize);
+
+  Status    = SendVariableRequest (SMM_VARIABLE_FUNCTION_GET_VARIABLE, mPayloadSize);
+  *DataSize = SmmVariableHeader->DataSize;
+  return Status;
+}
+
+/**
+  Enumerates all variables with one SMI per GetNextVariableName() and GetVariable().
+
+  @param[out] Result        The enumeration statistics.
+
+  @retval EFI_SUCCESS       All variables were enumerated.
+  @retval Others            The error returned by the SMM variable driver.
+
+**/
+EFI_STATUS
+EnumerateOneByOne (
+  OUT ENUMERATION_RESULT  *Result
+  )
+{
+  EFI_STATUS                                       Status;
+  SMM_VARIABLE_COMMUNICATE_GET_NEXT_VARIABLE_NAME  *SmmGetNextVariableName;
+  EFI_GUID                                         VendorGuid;
+  UINTN                                            NameSize;
+  UINTN                                            DataSize;
+  UINT64                                           StartTick;
+
+  ZeroMem (Result, sizeof (*Result));
+  ZeroMem (&VendorGuid, sizeof (VendorGuid));
+  mVariableName[0] = L'\0';
+  mSmiCount        = 0;
+
+  StartTick = GetPerformanceCounter ();
+  for ( ; ;) {
+    NameSize               = StrSize (mVariableName);
+    SmmGetNextVariableName = GetPayload ();
+    CopyGuid (&SmmGetNextVariableName->Guid, &VendorGuid);
+    SmmGetNextVariableName->NameSize = mPayloadSize - OFFSET_OF (SMM_VARIABLE_COMMUNICATE_GET_NEXT_VARIABLE_NAME, Name);
+    CopyMem (SmmGetNextVariableName->Name, mVariableName, NameSize);
+    ZeroMem ((UINT8 *)SmmGetNextVariableName->Name + NameSize, SmmGetNextVariableName->NameSize - NameSize);
+
+    Status = SendVariableRequest (SMM_VARIABLE_FUNCTION_GET_NEXT_VARIABLE_NAME, mPayloadSize);
+    if (Status == EFI_NOT_FOUND) {
+      Status = EFI_SUCCESS;
+      break;
+    }
+
+    if (EFI_ERROR (Status)) {
+      break;
+    }
+
+    CopyGuid (&VendorGuid, &SmmGetNextVariableName->Guid);
+    CopyMem (mVariableName, SmmGetNextVariableName->Name, SmmGetNextVariableName->NameSize);
+
+    Status = GetVariableFromSmm (mVariableName, &VendorGuid, &DataSize);
+    if (EFI_ERROR (Status)) {
+      break;
+    }
+
+    Result->Variables++;
+    Result->DataBytes += DataSize;
+  }
+
+  Result->TimeNs = GetTimeInNanoSecond (GetPerformanceCounter () - StartTick);
+  Result->Smis   = mSmiCount;
+  return Status;
+}
+
+/**
+  Enumerates all variables with SMM_VARIABLE_FUNCTION_GET_VARIABLE_BATCH.
+
+  @param[out] Result        The enumeration statistics.
+
+  @retval EFI_SUCCESS       All variables were enumerated.
+  @retval EFI_UNSUPPORTED   The SMM variable driver does not support batches.
+  @retval Others            The error returned by the SMM variable driver.
+
+**/
+EFI_STATUS
+EnumerateBatched (
+  OUT ENUMERATION_RESULT  *Result
+  )
+{
+  EFI_STATUS                                   Status;
+  SMM_VARIABLE_COMMUNICATE_GET_VARIABLE_BATCH  *SmmGetVariableBatch;
+  SMM_VARIABLE_BATCH_ENTRY                     *Entry;
+  EFI_GUID                                     VendorGuid;
+  EFI_GUID                                     OmittedGuid;
+  CHAR16                                       *OmittedName;
+  UINTN                                        NameSize;
+  UINTN                                        DataSize;
+  UINTN                                        Index;
+  UINTN                                        Offset;
+  BOOLEAN                                      EndOfVariables;
+  UINT64                                       StartTick;
+
+  ZeroMem (Result, sizeof (*Result));
+  ZeroMem (&VendorGuid, sizeof (VendorGuid));
+  mVariableName[0] = L'\0';
+  mSmiCount        = 0;
+  OmittedName      = mVariableData;
+
+  StartTick = GetPerformanceCounter ();
+  for ( ; ;) {
+    NameSize            = StrSize (mVariableName);
+    SmmGetVariableBatch = GetPayload ();
+    CopyGuid (&SmmGetVariableBatch->Guid, &VendorGuid);
+    SmmGetVariableBatch->NameSize = NameSize;
+    CopyMem (SmmGetVariableBatch->Name, mVariableName, NameSize);
+
+    Status = SendVariableRequest (SMM_VARIABLE_FUNCTION_GET_VARIABLE_BATCH, mPayloadSize);
+    if (EFI_ERROR (Status)) {
+      break;
+    }
+
+    OmittedName[0] = L'\0';
+    Entry          = NULL;
+    Offset         = SMM_VARIABLE_BATCH_FIRST_ENTRY_OFFSET (NameSize);
+    for (Index = 0; Index < SmmGetVariableBatch->EntryCount; Index++) {
+      Entry = (SMM_VARIABLE_BATCH_ENTRY *)((UINT8 *)SmmGetVariableBatch + Offset);
+      if ((Entry->Flags & SMM_VARIABLE_BATCH_ENTRY_DATA_OMITTED) != 0) {
+        CopyMem (OmittedName, Entry + 1, Entry->NameSize);
+        CopyGuid (&OmittedGuid, &Entry->Guid);
+      } else {
+        Result->DataBytes += Entry->DataSize;
+      }
+
+      Result->Variables++;
+      Offset += ALIGN_VALUE (SMM_VARIABLE_BATCH_ENTRY_SIZE (Entry), SMM_VARIABLE_BATCH_ENTRY_ALIGNMENT);
+    }
+
+    if (Entry != NULL) {
+      CopyGuid (&VendorGuid, &Entry->Guid);
+      CopyMem (mVariableName, Entry + 1, Entry->NameSize);
+    }
+
+    EndOfVariables = SmmGetVariableBatch->EndOfVariables;
+    if (OmittedName[0] != L'\0') {
+      //
+      // The data of a variable larger than a batch needs its own request.
+      //
+      Status = GetVariableFromSmm (OmittedName, &OmittedGuid, &DataSize);
+      if (EFI_ERROR (Status)) {
+        break;
+      }
+
+      Result->DataBytes += DataSize;
+    }
+
+    if (EndOfVariables) {
+      break;
+    }
+
+    if (Entry == NULL) {
+      Status = EFI_PROTOCOL_ERROR;
+      break;
+    }
+  }
+
+  Result->TimeNs = GetTimeInNanoSecond (GetPerformanceCounter () - StartTick);
+  Result->Smis   = mSmiCount;
+  return Status;
+}
+
+/**
+  Enumerates all variables through the UEFI runtime services.
+
+  @param[out] Result        The enumeration statistics. Smis is not known.
+
+  @retval EFI_SUCCESS       All variables were enumerated.
+  @retval Others            The error returned by the runtime services.
+
+**/
+EFI_STATUS
+EnumerateRuntimeServices (
+  OUT ENUMERATION_RESULT  *Result
+  )
+{
+  EFI_STATUS  Status;
+  EFI_GUID    VendorGuid;
+  UINTN       NameSize;
+  UINTN       DataSize;
+  UINT64      StartTick;
+
+  ZeroMem (Result, sizeof (*Result));
+  ZeroMem (&VendorGuid, sizeof (VendorGuid));
+  mVariableName[0] = L'\0';
+
+  StartTick = GetPerformanceCounter ();
+  for ( ; ;) {
+    NameSize = mPayloadSize;
+    Status   = gRT->GetNextVariableName (&NameSize, mVariableName, &VendorGuid);
+    if (Status == EFI_NOT_FOUND) {
+      Status = EFI_SUCCESS;
+      break;
+    }
+
+    if (EFI_ERROR (Status)) {
+      break;
+    }
+
+    DataSize = mPayloadSize;
+    Status   = gRT->GetVariable (mVariableName, &VendorGuid, NULL, &DataSize, mVariableData);
+    if (EFI_ERROR (Status)) {
+      break;
+    }
+
+    Result->Variables++;
+    Result->DataBytes += DataSize;
+  }
+
+  Result->TimeNs = GetTimeInNanoSecond (GetPerformanceCounter () - StartTick);
+  return Status;
+}
+
+/**
+  Prints one line of the benchmark report.
+
+  @param[in] Mode           Name of the enumeration method.
+  @param[in] Status         Status of the enumeration.
+  @param[in] Result         The enumeration statistics.
+  @param[in] PrintSmis      TRUE to print the SMI count.
+
+**/
+VOID
+PrintResult (
+  IN CHAR16              *Mode,
+  IN EFI_STATUS          Status,
+  IN ENUMERATION_RESULT  *Result,
+  IN BOOLEAN             PrintSmis
+  )
+{
+  if (EFI_ERROR (Status)) {
+    Print (L"%-16s %r\n", Mode, Status);
+    return;
+  }
+
+  if (PrintSmis) {
+    Print (L"%-16s %9d %12d %8d %12ld\n", Mode, Result->Variables, Result->DataBytes, Result->Smis, DivU64x32 (Result->TimeNs, 1000));
+  } else {
+    Print (L"%-16s %9d %12d %8s %12ld\n", Mode, Result->Variables, Result->DataBytes, L"-", DivU64x32 (Result->TimeNs, 1000));
+  }
+}
+
+/**
+  Finds the largest conventional memory MM communication region.
+
+  @retval EFI_SUCCESS       The communication buffer and payload size are set.
+  @retval Others            No usable communication region was found.
+
+**/
+EFI_STATUS
+InitCommunicationBuffer (
+  VOID
+  )
+{
+  EFI_STATUS                                 Status;
+  EDKII_PI_SMM_COMMUNICATION_REGION_TABLE    *PiSmmCommunicationRegionTable;
+  EFI_MEMORY_DESCRIPTOR                      *Entry;
+  SMM_VARIABLE_COMMUNICATE_GET_PAYLOAD_SIZE  *SmmGetPayloadSize;
+  UINTN                                      CommBufferSize;
+  UINTN                                      Size;
+  UINT32                                     Index;
+
+  Status = EfiGetSystemConfigurationTable (
+             &gEdkiiPiSmmCommunicationRegionTableGuid,
+             (VOID **)&PiSmmCommunicationRegionTable
+             );
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  CommBufferSize = 0;
+  Entry          = (EFI_MEMORY_DESCRIPTOR *)(PiSmmCommunicationRegionTable + 1);
+  for (Index = 0; Index < PiSmmCommunicationRegionTable->NumberOfEntries; Index++) {
+    if (Entry->Type == EfiConventionalMemory) {
+      Size = EFI_PAGES_TO_SIZE ((UINTN)Entry->NumberOfPages);
+      if (Size > CommBufferSize) {
+        CommBufferSize = Size;
+        mCommBuffer    = (EFI_MM_COMMUNICATE_HEADER *)(UINTN)Entry->PhysicalStart;
+      }
+    }
+
+    Entry = (EFI_MEMORY_DESCRIPTOR *)((UINT8 *)Entry + PiSmmCommunicationRegionTable->DescriptorSize);
+  }
+
+  if (CommBufferSize <= SMM_COMMUNICATE_HEADER_SIZE + SMM_VARIABLE_COMMUNICATE_HEADER_SIZE + sizeof (SMM_VARIABLE_COMMUNICATE_GET_PAYLOAD_SIZE)) {
+    return EFI_NOT_FOUND;
+  }
+
+  Status = SendVariableRequest (SMM_VARIABLE_FUNCTION_GET_PAYLOAD_SIZE, sizeof (SMM_VARIABLE_COMMUNICATE_GET_PAYLOAD_SIZE));
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  SmmGetPayloadSize = GetPayload ();
+  mPayloadSize      = MIN (
+                        SmmGetPayloadSize->VariablePayloadSize,
+                        CommBufferSize - SMM_COMMUNICATE_HEADER_SIZE - SMM_VARIABLE_COMMUNICATE_HEADER_SIZE
+                        );
+  return EFI_SUCCESS;
+}
+
+/**
+  The user Entry Point for Application. The user code starts with this function
+  as the real entry point for the application.
+
+  @param[in] ImageHandle    The firmware allocated handle for the EFI image.
+  @param[in] SystemTable    A pointer to the EFI System Table.
+
+  @retval EFI_SUCCESS       The entry point is executed successfully.
+  @retval other             Some error occurs when executing this entry point.
+
+**/
+EFI_STATUS
+EFIAPI
+UefiMain (
+  IN EFI_HANDLE        ImageHandle,
+  IN EFI_SYSTEM_TABLE  *SystemTable
+  )
+{
+  EFI_STATUS                 Status;
+  EFI_SMM_VARIABLE_PROTOCOL  *SmmVariable;
+  ENUMERATION_RESULT         OneByOne;
+  ENUMERATION_RESULT         Batched;
+  ENUMERATION_RESULT         RuntimeServices;
+  EFI_STATUS                 OneByOneStatus;
+  EFI_STATUS                 BatchedStatus;
+  EFI_STATUS                 RuntimeServicesStatus;
+
+  Status = gBS->LocateProtocol (&gEfiSmmVariableProtocolGuid, NULL, (VOID **)&SmmVariable);
+  if (!EFI_ERROR (Status)) {
+    Status = gBS->LocateProtocol (&gEfiMmCommunication2ProtocolGuid, NULL, (VOID **)&mMmCommunication2);
+  }
+
+  if (!EFI_ERROR (Status)) {
+    Status = InitCommunicationBuffer ();
+  }
+
+  if (EFI_ERROR (Status)) {
+    Print (L"The SMM variable driver is not available: %r\n", Status);
+    return Status;
+  }
+
+  mVariableName = AllocateZeroPool (mPayloadSize);
+  mVariableData = AllocateZeroPool (mPayloadSize);
+  if ((mVariableName == NULL) || (mVariableData == NULL)) {
+    Status = EFI_OUT_OF_RESOURCES;
+    goto Done;
+  }
+
+  OneByOneStatus        = EnumerateOneByOne (&OneByOne);
+  BatchedStatus         = EnumerateBatched (&Batched);
+  RuntimeServicesStatus = EnumerateRuntimeServices (&RuntimeServices);
+
+  Print (L"Full variable enumeration, MM payload size %d bytes:\n", mPayloadSize);
+  Print (L"%-16s %9s %12s %8s %12s\n", L"Method", L"Variables", L"Data bytes", L"SMIs", L"Time (us)");
+  PrintResult (L"One by one", OneByOneStatus, &OneByOne, TRUE);
+  PrintResult (L"Batched", BatchedStatus, &Batched, TRUE);
+  PrintResult (L"Runtime services", RuntimeServicesStatus, &RuntimeServices, FALSE);
+
+  Status = EFI_SUCCESS;
+
+Done:
+  if (mVariableName != NULL) {
+    FreePool (mVariableName);
+  }
+
+  if (mVariableData != NULL) {
+    FreePool (mVariableData);
+  }
+
+  return Status;
+}
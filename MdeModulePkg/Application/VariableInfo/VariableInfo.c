@@ -18,6 +18,7 @@
 #include <Library/UefiBootServicesTableLib.h>
 
 #include <Guid/VariableFormat.h>
+#include <Guid/VariableLatencyStatistics.h>
 #include <Guid/SmmVariableCommon.h>
 #include <Guid/PiSmmCommunicationRegionTable.h>
 #include <Protocol/MmCommunication2.h>
@@ -66,6 +67,94 @@ GetVariableStatisticsData (
   return Status;
 }
 
+/**
+  Prints one latency histogram of the variable driver.
+
+  @param[in] Name           Name of the measured operation.
+  @param[in] Histogram      The latency histogram.
+
+**/
+VOID
+PrintLatencyHistogram (
+  IN CONST CHAR16                *Name,
+  IN VARIABLE_LATENCY_HISTOGRAM  *Histogram
+  )
+{
+  UINTN  Bucket;
+
+  if (Histogram->Count == 0) {
+    return;
+  }
+
+  Print (L"%s latency: %d calls, max %ld us\n", Name, Histogram->Count, DivU64x32 (Histogram->MaxNs, 1000));
+  for (Bucket = 0; Bucket < VARIABLE_LATENCY_BUCKETS; Bucket++) {
+    if (Histogram->Bucket[Bucket] == 0) {
+      continue;
+    }
+
+    if (Bucket == 0) {
+      Print (L"  < 1 us: %d\n", Histogram->Bucket[Bucket]);
+    } else if (Bucket == VARIABLE_LATENCY_BUCKETS - 1) {
+      Print (L"  >= %ld us: %d\n", LShiftU64 (1, Bucket - 1), Histogram->Bucket[Bucket]);
+    } else {
+      Print (L"  [%ld, %ld) us: %d\n", LShiftU64 (1, Bucket - 1), LShiftU64 (1, Bucket), Histogram->Bucket[Bucket]);
+    }
+  }
+}
+
+/**
+  Prints the latency statistics of the variable driver.
+
+  @param[in] Latency        The latency statistics.
+
+**/
+VOID
+PrintLatencyStatistics (
+  IN VARIABLE_LATENCY_STATISTICS  *Latency
+  )
+{
+  PrintLatencyHistogram (L"SetVariable", &Latency->SetVariable);
+  PrintLatencyHistogram (L"Reclaim", &Latency->Reclaim);
+  PrintLatencyHistogram (L"Incremental reclaim step", &Latency->ReclaimStep);
+}
+
+/**
+  This function gets and prints the latency statistics from SMM variable driver.
+
+  @param[in, out] SmmCommunicateHeader A communicate buffer large enough for
+                                       the latency statistics.
+
+**/
+VOID
+PrintLatencyStatisticsFromSmm (
+  IN OUT  EFI_MM_COMMUNICATE_HEADER  *SmmCommunicateHeader
+  )
+{
+  EFI_STATUS                       Status;
+  SMM_VARIABLE_COMMUNICATE_HEADER  *SmmVariableFunctionHeader;
+  UINTN                            CommSize;
+
+  CommSize = SMM_COMMUNICATE_HEADER_SIZE + SMM_VARIABLE_COMMUNICATE_HEADER_SIZE + sizeof (VARIABLE_LATENCY_STATISTICS);
+  CopyGuid (&SmmCommunicateHeader->HeaderGuid, &gEfiSmmVariableProtocolGuid);
+  SmmCommunicateHeader->MessageLength = SMM_VARIABLE_COMMUNICATE_HEADER_SIZE + sizeof (VARIABLE_LATENCY_STATISTICS);
+
+  SmmVariableFunctionHeader           = (SMM_VARIABLE_COMMUNICATE_HEADER *)&SmmCommunicateHeader->Data[0];
+  SmmVariableFunctionHeader->Function = SMM_VARIABLE_FUNCTION_GET_LATENCY_STATISTICS;
+
+  Status = mMmCommunication2->Communicate (
+                                mMmCommunication2,
+                                SmmCommunicateHeader,
+                                SmmCommunicateHeader,
+                                &CommSize
+                                );
+  if (EFI_ERROR (Status) || EFI_ERROR (SmmVariableFunctionHeader->ReturnStatus)) {
+    return;
+  }
+
+  Print (L"SMM Driver Latency:\n");
+  PrintLatencyStatistics ((VARIABLE_LATENCY_STATISTICS *)SmmVariableFunctionHeader->Data);
+}
+
 /**
 
   This function get and print the variable statistics data from SMM variable driver.
@@ -193,6 +282,11 @@ PrintInfoFromSmm (
     }
   } while (TRUE);
 
+  if (RealCommSize >= SMM_COMMUNICATE_HEADER_SIZE + SMM_VARIABLE_COMMUNICATE_HEADER_SIZE + sizeof (VARIABLE_LATENCY_STATISTICS)) {
+    ZeroMem (CommBuffer, RealCommSize);
+    PrintLatencyStatisticsFromSmm (CommBuffer);
+  }
+
   return Status;
 }
 
@@ -215,10 +309,11 @@ UefiMain (
   IN EFI_SYSTEM_TABLE  *SystemTable
   )
 {
-  EFI_STATUS           RuntimeDxeStatus;
-  EFI_STATUS           SmmStatus;
-  VARIABLE_INFO_ENTRY  *VariableInfo;
-  VARIABLE_INFO_ENTRY  *Entry;
+  EFI_STATUS                   RuntimeDxeStatus;
+  EFI_STATUS                   SmmStatus;
+  VARIABLE_INFO_ENTRY          *VariableInfo;
+  VARIABLE_INFO_ENTRY          *Entry;
+  VARIABLE_LATENCY_STATISTICS  *Latency;
 
   RuntimeDxeStatus = EfiGetSystemConfigurationTable (&gEfiVariableGuid, (VOID **)&Entry);
   if (EFI_ERROR (RuntimeDxeStatus) || (Entry == NULL)) {
@@ -261,6 +356,11 @@ UefiMain (
 
       VariableInfo = VariableInfo->Next;
     } while (VariableInfo != NULL);
+
+    if (!EFI_ERROR (EfiGetSystemConfigurationTable (&gEdkiiVariableLatencyStatisticsGuid, (VOID **)&Latency))) {
+      Print (L"Runtime DXE Driver Latency:\n");
+      PrintLatencyStatistics (Latency);
+    }
   }
 
   SmmStatus = PrintInfoFromSmm ();
@@ -19,6 +19,15 @@ BOOLEAN  *mDepexEvaluationStack        = NULL;
 BOOLEAN  *mDepexEvaluationStackEnd     = NULL;
 BOOLEAN  *mDepexEvaluationStackPointer = NULL;
 
+//
+// Index of the drivers whose dependency expression evaluated to FALSE, keyed
+// by every protocol GUID the expression still waits for. Installing one of
+// those protocols marks the waiting drivers for re-evaluation, so a dispatch
+// pass only evaluates the expressions that may have changed.
+//
+LIST_ENTRY  mDepexWaiterIndex[DEPEX_WAITER_INDEX_SIZE];
+UINTN       mDepexWaiterCount = 0;
+
 //
 // Worker functions
 //
@@ -431,3 +440,249 @@ CoreIsSchedulable (
 Done:
   return FALSE;
 }
+
+/**
+  Initialize the index of drivers waiting for a protocol.
+
+**/
+VOID
+CoreInitializeDepexWaiterIndex (
+  VOID
+  )
+{
+  UINTN  Index;
+
+  for (Index = 0; Index < DEPEX_WAITER_INDEX_SIZE; Index++) {
+    InitializeListHead (&mDepexWaiterIndex[Index]);
+  }
+}
+
+/**
+  Add DriverEntry to the waiter index for every protocol GUID that its
+  dependency expression pushes and that has not been found installed yet.
+
+  An expression that uses NOT is not registered: it can become TRUE when a
+  protocol is uninstalled, which the index does not track.
+
+  @param  DriverEntry           The driver to register.
+
+  @retval EFI_SUCCESS           The driver was registered.
+  @retval EFI_UNSUPPORTED       The dependency expression uses NOT.
+  @retval EFI_OUT_OF_RESOURCES  There is not enough memory for the index entries.
+
+**/
+EFI_STATUS
+CoreRegisterDepexWaiters (
+  IN  EFI_CORE_DRIVER_ENTRY  *DriverEntry
+  )
+{
+  EFI_STATUS    Status;
+  UINT8         *Iterator;
+  UINT8         *End;
+  DEPEX_WAITER  *Waiter;
+  LIST_ENTRY    Waiters;
+
+  InitializeListHead (&Waiters);
+  Status = EFI_SUCCESS;
+
+  Iterator = DriverEntry->Depex;
+  End      = Iterator + DriverEntry->DepexSize;
+  while (Iterator < End) {
+    switch (*Iterator) {
+      case EFI_DEP_PUSH:
+        if (Iterator + 1 + sizeof (EFI_GUID) > End) {
+          break;
+        }
+
+        Waiter = AllocatePool (sizeof (DEPEX_WAITER));
+        if (Waiter == NULL) {
+          Status   = EFI_OUT_OF_RESOURCES;
+          Iterator = End;
+          continue;
+        }
+
+        Waiter->Signature   = DEPEX_WAITER_SIGNATURE;
+        Waiter->DriverEntry = DriverEntry;
+        CopyGuid (&Waiter->ProtocolGuid, (EFI_GUID *)(Iterator + 1));
+        InsertTailList (&Waiters, &Waiter->DriverLink);
+        Iterator += sizeof (EFI_GUID);
+        break;
+
+      case EFI_DEP_BEFORE:
+      case EFI_DEP_AFTER:
+      case EFI_DEP_REPLACE_TRUE:
+        Iterator += sizeof (EFI_GUID);
+        break;
+
+      case EFI_DEP_NOT:
+        //
+        // Uninstalling a protocol can make the expression TRUE, and only
+        // installs are reported to CoreDepexProtocolInstalled ().
+        //
+        Status   = EFI_UNSUPPORTED;
+        Iterator = End;
+        continue;
+
+      case EFI_DEP_END:
+        Iterator = End;
+        continue;
+
+      default:
+        break;
+    }
+
+    Iterator++;
+  }
+
+  if (EFI_ERROR (Status)) {
+    while (!IsListEmpty (&Waiters)) {
+      Waiter = CR (GetFirstNode (&Waiters), DEPEX_WAITER, DriverLink, DEPEX_WAITER_SIGNATURE);
+      RemoveEntryList (&Waiter->DriverLink);
+      FreePool (Waiter);
+    }
+
+    return Status;
+  }
+
+  //
+  // Publish the new entries in one step, a protocol may be installed by an
+  // event notification function at any time.
+  //
+  CoreAcquireDispatcherLock ();
+  while (!IsListEmpty (&Waiters)) {
+    Waiter = CR (GetFirstNode (&Waiters), DEPEX_WAITER, DriverLink, DEPEX_WAITER_SIGNATURE);
+    RemoveEntryList (&Waiter->DriverLink);
+    InsertTailList (&DriverEntry->DepexWaiters, &Waiter->DriverLink);
+    InsertTailList (
+      &mDepexWaiterIndex[CoreHashProtocolGuid (&Waiter->ProtocolGuid) & (DEPEX_WAITER_INDEX_SIZE - 1)],
+      &Waiter->IndexLink
+      );
+    mDepexWaiterCount++;
+  }
+
+  CoreReleaseDispatcherLock ();
+
+  return EFI_SUCCESS;
+}
+
+/**
+  Remove DriverEntry from the waiter index and free its index entries.
+
+  @param  DriverEntry           The driver to unregister.
+
+**/
+VOID
+CoreUnregisterDepexWaiters (
+  IN  EFI_CORE_DRIVER_ENTRY  *DriverEntry
+  )
+{
+  LIST_ENTRY    *Link;
+  DEPEX_WAITER  *Waiter;
+
+  if (IsListEmpty (&DriverEntry->DepexWaiters)) {
+    return;
+  }
+
+  CoreAcquireDispatcherLock ();
+  for (Link = DriverEntry->DepexWaiters.ForwardLink; Link != &DriverEntry->DepexWaiters; Link = Link->ForwardLink) {
+    Waiter = CR (Link, DEPEX_WAITER, DriverLink, DEPEX_WAITER_SIGNATURE);
+    RemoveEntryList (&Waiter->IndexLink);
+    mDepexWaiterCount--;
+  }
+
+  CoreReleaseDispatcherLock ();
+
+  while (!IsListEmpty (&DriverEntry->DepexWaiters)) {
+    Waiter = CR (GetFirstNode (&DriverEntry->DepexWaiters), DEPEX_WAITER, DriverLink, DEPEX_WAITER_SIGNATURE);
+    RemoveEntryList (&Waiter->DriverLink);
+    FreePool (Waiter);
+  }
+}
+
+/**
+  Called by the protocol database every time Protocol is installed or
+  reinstalled. Marks the drivers whose dependency expression waits for
+  Protocol for re-evaluation on the next dispatch pass.
+
+  @param  Protocol              The GUID of the protocol that was installed.
+
+**/
+VOID
+CoreDepexProtocolInstalled (
+  IN  EFI_GUID  *Protocol
+  )
+{
+  LIST_ENTRY    *Bucket;
+  LIST_ENTRY    *Link;
+  DEPEX_WAITER  *Waiter;
+
+  if (mDepexWaiterCount == 0) {
+    return;
+  }
+
+  Bucket = &mDepexWaiterIndex[CoreHashProtocolGuid (Protocol) & (DEPEX_WAITER_INDEX_SIZE - 1)];
+
+  CoreAcquireDispatcherLock ();
+  for (Link = Bucket->ForwardLink; Link != Bucket; Link = Link->ForwardLink) {
+    Waiter = CR (Link, DEPEX_WAITER, IndexLink, DEPEX_WAITER_SIGNATURE);
+    if (CompareGuid (&Waiter->ProtocolGuid, Protocol)) {
+      Waiter->DriverEntry->DepexReevaluate = TRUE;
+    }
+  }
+
+  CoreReleaseDispatcherLock ();
+}
+
+/**
+  Decide whether the dependency expression of a Dependent driver has to be
+  evaluated on this dispatch pass, and register the driver in the waiter index
+  the first time it is evaluated.
+
+  @param  DriverEntry           The driver in the Dependent state.
+
+  @retval TRUE                  CoreIsSchedulable() must be called for DriverEntry.
+  @retval FALSE                 None of the protocols the dependency expression
+                                waits for has been installed since the last
+                                evaluation, so the result cannot have changed.
+
+**/
+BOOLEAN
+CoreDepexNeedsEvaluation (
+  IN  EFI_CORE_DRIVER_ENTRY  *DriverEntry
+  )
+{
+  if (DriverEntry->Before || DriverEntry->After) {
+    //
+    // Processed by CoreInsertOnScheduledQueueWhileProcessingBeforeAndAfter ()
+    //
+    return FALSE;
+  }
+
+  if ((DriverEntry->Depex == NULL) || DriverEntry->DepexNotIndexed) {
+    //
+    // Waits for all the architectural protocols, which are not in the index,
+    // or could not be indexed.
+    //
+    return TRUE;
+  }
+
+  if (!DriverEntry->DepexReevaluate) {
+    return FALSE;
+  }
+
+  if (IsListEmpty (&DriverEntry->DepexWaiters)) {
+    if (EFI_ERROR (CoreRegisterDepexWaiters (DriverEntry))) {
+      //
+      // Not indexed, evaluate it on every pass.
+      //
+      DriverEntry->DepexNotIndexed = TRUE;
+      return TRUE;
+    }
+  }
+
+  CoreAcquireDispatcherLock ();
+  DriverEntry->DepexReevaluate = FALSE;
+  CoreReleaseDispatcherLock ();
+
+  return TRUE;
+}
@@ -279,6 +279,8 @@ CoreGetDepexSectionAndPreProccess (
     DriverEntry->DepexProtocolError = FALSE;
   }
 
+  DriverEntry->DepexReevaluate = TRUE;
+
   return Status;
 }
 
@@ -319,8 +321,9 @@ CoreSchedule (
       // Move the driver from the Unrequested to the Dependent state
       //
       CoreAcquireDispatcherLock ();
-      DriverEntry->Unrequested = FALSE;
-      DriverEntry->Dependent   = TRUE;
+      DriverEntry->Unrequested     = FALSE;
+      DriverEntry->Dependent       = TRUE;
+      DriverEntry->DepexReevaluate = TRUE;
       CoreReleaseDispatcherLock ();
 
       DEBUG ((DEBUG_DISPATCH, "Schedule FFS(%g) - EFI_SUCCESS\n", DriverName));
@@ -407,6 +410,9 @@ CoreDispatcher (
   EFI_CORE_DRIVER_ENTRY  *DriverEntry;
   BOOLEAN                ReadyToRun;
   EFI_EVENT              DxeDispatchEvent;
+  UINTN                  DepexEvaluated;
+  UINTN                  DepexSkipped;
+  CHAR8                  DepexToken[24];
 
   PERF_FUNCTION_BEGIN ();
 
@@ -433,6 +439,11 @@ CoreDispatcher (
 
   ReturnStatus = EFI_NOT_FOUND;
   do {
+    //
+    // Decode the scheduled drivers on the APs, if enabled
+    //
+    CoreParallelDecodeScheduledDrivers (&mScheduledQueue);
+
     //
     // Drain the Scheduled Queue
     //
@@ -528,6 +539,8 @@ CoreDispatcher (
       ReturnStatus = EFI_SUCCESS;
     }
 
+    CoreFreeParallelDecodeResults ();
+
     //
     // Now DXE Dispatcher finished one round of dispatch, signal an event group
     // so that SMM Dispatcher get chance to dispatch SMM Drivers which depend
@@ -540,7 +553,9 @@ CoreDispatcher (
     //
     // Search DriverList for items to place on Scheduled Queue
     //
-    ReadyToRun = FALSE;
+    ReadyToRun     = FALSE;
+    DepexEvaluated = 0;
+    DepexSkipped   = 0;
     for (Link = mDiscoveredList.ForwardLink; Link != &mDiscoveredList; Link = Link->ForwardLink) {
       DriverEntry = CR (Link, EFI_CORE_DRIVER_ENTRY, Link, EFI_CORE_DRIVER_ENTRY_SIGNATURE);
 
@@ -552,9 +567,17 @@ CoreDispatcher (
       }
 
       if (DriverEntry->Dependent) {
-        if (CoreIsSchedulable (DriverEntry)) {
-          CoreInsertOnScheduledQueueWhileProcessingBeforeAndAfter (DriverEntry);
-          ReadyToRun = TRUE;
+        //
+        // Only evaluate the Depex if a protocol it waits for was installed
+        //
+        if (!CoreDepexNeedsEvaluation (DriverEntry)) {
+          DepexSkipped++;
+        } else {
+          DepexEvaluated++;
+          if (CoreIsSchedulable (DriverEntry)) {
+            CoreInsertOnScheduledQueueWhileProcessingBeforeAndAfter (DriverEntry);
+            ReadyToRun = TRUE;
+          }
         }
       } else {
         if (DriverEntry->Unrequested) {
@@ -564,6 +587,15 @@ CoreDispatcher (
         }
       }
     }
+
+    //
+    // Log how many dependency expressions this pass evaluated and skipped
+    //
+    DEBUG ((DEBUG_DISPATCH, "DXE DEPEX pass: %d evaluated, %d skipped\n", (UINT32)DepexEvaluated, (UINT32)DepexSkipped));
+    PERF_CODE (
+      AsciiSPrint (DepexToken, sizeof (DepexToken), "DxeDepex:%d/%d", (UINT32)DepexEvaluated, (UINT32)(DepexEvaluated + DepexSkipped));
+      PERF_EVENT (DepexToken);
+      );
   } while (ReadyToRun);
 
   //
@@ -628,6 +660,8 @@ CoreInsertOnScheduledQueueWhileProcessingBeforeAndAfter (
 
   CoreReleaseDispatcherLock ();
 
+  CoreUnregisterDepexWaiters (InsertedDriverEntry);
+
   //
   // Process After Dependency
   //
@@ -873,6 +907,7 @@ CoreAddToDriverList (
   }
 
   DriverEntry->Signature = EFI_CORE_DRIVER_ENTRY_SIGNATURE;
+  InitializeListHead (&DriverEntry->DepexWaiters);
   CopyGuid (&DriverEntry->FileName, DriverName);
   DriverEntry->FvHandle         = FvHandle;
   DriverEntry->Fv               = Fv;
@@ -1421,6 +1456,7 @@ CoreFwVolEventProtocolNotify (
           DriverEntry->Scheduled = TRUE;
           InsertTailList (&mScheduledQueue, &DriverEntry->ScheduledLink);
           CoreReleaseDispatcherLock ();
+          CoreUnregisterDepexWaiters (DriverEntry);
           DEBUG ((DEBUG_DISPATCH, "Evaluate DXE DEPEX for FFS(%g)\n", &DriverEntry->FileName));
           DEBUG ((DEBUG_DISPATCH, "  RESULT = TRUE (Apriori)\n"));
           break;
@@ -1447,6 +1483,8 @@ CoreInitializeDispatcher (
 {
   PERF_FUNCTION_BEGIN ();
 
+  CoreInitializeDepexWaiterIndex ();
+
   mFwVolEvent = EfiCreateProtocolNotifyEvent (
                   &gEfiFirmwareVolume2ProtocolGuid,
                   TPL_CALLBACK,
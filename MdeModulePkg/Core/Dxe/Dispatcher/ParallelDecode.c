@@ -0,0 +1,875 @@
+/** @file
+  DXE Dispatcher parallel section decode.
+
+  When PcdDxeParallelImageDecode is TRUE and the MP Services protocol is
+  available, the dispatcher hands the compressed GUID defined sections of every
+  driver on the mScheduledQueue to the application processors before it starts
+  loading the drivers one by one on the BSP. Only the pure data transformation
+  done by an ExtractGuidedSectionLib decode handler runs on the APs. Reading
+  the FFS file, allocating the buffers, authenticating, relocating and calling
+  the entry point of an image stay on the BSP, in dispatch order.
+
+  When CoreLoadImage() later asks the section extraction code to open the same
+  GUID defined section, CreateChildNode() picks up the already decoded buffer
+  instead of running the decoder a second time. Each decoded section is indexed
+  by the FV handle and name of its FFS file and by its location in the file:
+  the instance number of the decoded section whose output holds it, or 0 for
+  the file itself, and its offset in that buffer. The section streams carry the
+  same location, so a lookup is a hash index probe rather than a compare of
+  the section against every job.
+
+  Compressed sections nested in other encapsulations are decoded too. Sections
+  inside GUID defined sections that do not require processing are queued with
+  their parent, and the output of every decoded section is searched for more
+  compressed sections, which are decoded in a further round. Each round starts
+  with the sections that have the largest output, so that a large driver or
+  nested FV does not start last and hold up the whole round.
+
+  Each decode is recorded in FPDT as a "DxeDecode:CPUn" start/end pair against
+  the GUID of the FFS file that holds the section. The records overlap the
+  LoadImage/StartImage records of the drivers dispatched in the same pass. The
+  time stamps are taken with GetPerformanceCounter() on the CPU that ran the
+  decode, so the platform TimerLib must use a counter that is synchronized
+  between processors.
+
+Copyright (c) 2026, Intel Corporation. All rights reserved.<BR>
+SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include "DxeMain.h"
+
+#define PARALLEL_DECODE_TOKEN_LENGTH  24
+
+///
+/// Number of buckets in the index of the decoded sections. Must be a power of 2.
+///
+#define PARALLEL_DECODE_INDEX_SIZE  64
+
+typedef struct {
+  //
+  // Set up by the BSP before the APs are started.
+  //
+  CONST EFI_COMMON_SECTION_HEADER    *Section;
+  UINTN                              SectionSize;
+  VOID                               *OutputBuffer;
+  UINT32                             OutputSize;
+  VOID                               *ScratchBuffer;
+  //
+  // Copy of a nested section, owned by the job because the decoded buffer of
+  // the parent may be freed before the section is extracted. NULL for the
+  // sections that point into a file buffer.
+  //
+  VOID                               *SectionBuffer;
+  EFI_HANDLE                         FvHandle;
+  CONST EFI_GUID                     *FileName;
+  UINT32                             Depth;
+  //
+  // Instance is unique for the life of the DXE core. Parent is the instance of
+  // the job whose output holds the section, or 0 if the section is in the file
+  // itself, and Offset the offset of the section in that buffer.
+  //
+  UINT32                             Instance;
+  UINT32                             Parent;
+  UINT32                             Offset;
+  LIST_ENTRY                         IndexLink;     // PARALLEL_DECODE_CONTEXT.Index
+  //
+  // Written by the processor that claimed the job.
+  //
+  EFI_STATUS                         Status;
+  UINT32                             AuthenticationStatus;
+  UINTN                              ProcessorNumber;
+  UINT64                             StartTicks;
+  UINT64                             EndTicks;
+  //
+  // TRUE once the output buffer was handed to the section extraction code.
+  //
+  BOOLEAN                            Consumed;
+} PARALLEL_DECODE_JOB;
+
+typedef struct {
+  EFI_MP_SERVICES_PROTOCOL    *MpServices;
+  PARALLEL_DECODE_JOB         *Jobs;
+  UINTN                       JobCount;
+  UINTN                       JobCapacity;
+  VOID                        **FileBuffers;
+  UINTN                       FileCount;
+  volatile UINT32             NextJob;
+  //
+  // Built once the last round is over and the job table no longer moves.
+  //
+  LIST_ENTRY                  Index[PARALLEL_DECODE_INDEX_SIZE];
+} PARALLEL_DECODE_CONTEXT;
+
+//
+// The GUID defined sections whose decode handlers only transform the input
+// data into the output and scratch buffers, so they can run on an AP. Handlers
+// such as the CRC32 one call boot services and are left to the BSP.
+//
+STATIC EFI_GUID  *mParallelDecodeGuids[] = {
+  &gLzmaCustomDecompressGuid,
+  &gLzmaF86CustomDecompressGuid,
+  &gBrotliCustomDecompressGuid,
+  &gTianoCustomDecompressGuid
+};
+
+PARALLEL_DECODE_CONTEXT  mParallelDecode;
+
+//
+// Last instance number given to a job. It is not reset between passes, since
+// the section streams that carry the instance numbers are cached by FwVol for
+// as long as the FV is around.
+//
+STATIC UINT32  mParallelDecodeLastInstance = 0;
+
+//
+// Number of times StartupAllAPs() is retried while the APs that returned from
+// the previous round have not been reported idle yet.
+//
+#define PARALLEL_DECODE_STARTUP_RETRIES  10000
+
+//
+// Signaled by the MP services once all the APs returned from a round. It is
+// kept across passes of the dispatcher.
+//
+STATIC EFI_EVENT  mParallelDecodeApDoneEvent = NULL;
+
+/**
+  Check whether a GUID defined section can be decoded on an AP.
+
+  @param  Section               The GUID defined section.
+
+  @retval TRUE                  The section is processing required and uses one
+                                of the decoders listed in mParallelDecodeGuids.
+  @retval FALSE                 The section must be extracted on the BSP.
+
+**/
+STATIC
+BOOLEAN
+IsParallelDecodeSection (
+  IN CONST EFI_COMMON_SECTION_HEADER  *Section
+  )
+{
+  CONST EFI_GUID  *SectionDefinitionGuid;
+  UINT16          Attributes;
+  UINTN           Index;
+
+  if (IS_SECTION2 (Section)) {
+    if (SECTION2_SIZE (Section) < sizeof (EFI_GUID_DEFINED_SECTION2)) {
+      return FALSE;
+    }
+
+    SectionDefinitionGuid = &((EFI_GUID_DEFINED_SECTION2 *)Section)->SectionDefinitionGuid;
+    Attributes            = ((EFI_GUID_DEFINED_SECTION2 *)Section)->Attributes;
+  } else {
+    if (SECTION_SIZE (Section) < sizeof (EFI_GUID_DEFINED_SECTION)) {
+      return FALSE;
+    }
+
+    SectionDefinitionGuid = &((EFI_GUID_DEFINED_SECTION *)Section)->SectionDefinitionGuid;
+    Attributes            = ((EFI_GUID_DEFINED_SECTION *)Section)->Attributes;
+  }
+
+  if ((Attributes & EFI_GUIDED_SECTION_PROCESSING_REQUIRED) == 0) {
+    return FALSE;
+  }
+
+  for (Index = 0; Index < ARRAY_SIZE (mParallelDecodeGuids); Index++) {
+    if (CompareGuid (SectionDefinitionGuid, mParallelDecodeGuids[Index])) {
+      return TRUE;
+    }
+  }
+
+  return FALSE;
+}
+
+/**
+  Queue one GUID defined section for parallel decode. The output and scratch
+  buffers are allocated here, on the BSP, so that the APs never call into the
+  memory services.
+
+  @param  Section               The GUID defined section to decode.
+  @param  SectionSize           The size of Section in bytes.
+  @param  FvHandle              The handle of the FV that holds the file.
+  @param  FileName              The name of the FFS file that holds Section.
+  @param  Parent                The instance of the job whose output holds
+                                Section, or 0 for the file itself.
+  @param  Offset                The offset of Section in that buffer.
+  @param  Depth                 The number of encapsulation sections around
+                                Section.
+  @param  CopySection           TRUE if the job must keep a copy of Section.
+
+**/
+STATIC
+VOID
+AddParallelDecodeJob (
+  IN CONST EFI_COMMON_SECTION_HEADER  *Section,
+  IN UINTN                            SectionSize,
+  IN EFI_HANDLE                       FvHandle,
+  IN CONST EFI_GUID                   *FileName,
+  IN UINT32                           Parent,
+  IN UINT32                           Offset,
+  IN UINT32                           Depth,
+  IN BOOLEAN                          CopySection
+  )
+{
+  EFI_STATUS           Status;
+  PARALLEL_DECODE_JOB  *Job;
+  PARALLEL_DECODE_JOB  *Jobs;
+  UINT32               OutputSize;
+  UINT32               ScratchSize;
+  UINT16               Attributes;
+
+  Status = ExtractGuidedSectionGetInfo (Section, &OutputSize, &ScratchSize, &Attributes);
+  if (EFI_ERROR (Status) || (OutputSize == 0)) {
+    return;
+  }
+
+  if (mParallelDecode.JobCount == mParallelDecode.JobCapacity) {
+    Jobs = ReallocatePool (
+             mParallelDecode.JobCapacity * sizeof (PARALLEL_DECODE_JOB),
+             (mParallelDecode.JobCapacity + 16) * sizeof (PARALLEL_DECODE_JOB),
+             mParallelDecode.Jobs
+             );
+    if (Jobs == NULL) {
+      return;
+    }
+
+    mParallelDecode.Jobs         = Jobs;
+    mParallelDecode.JobCapacity += 16;
+  }
+
+  Job = &mParallelDecode.Jobs[mParallelDecode.JobCount];
+  ZeroMem (Job, sizeof (PARALLEL_DECODE_JOB));
+  Job->Section     = Section;
+  Job->SectionSize = SectionSize;
+  Job->OutputSize  = OutputSize;
+  Job->FvHandle    = FvHandle;
+  Job->FileName    = FileName;
+  Job->Parent      = Parent;
+  Job->Offset      = Offset;
+  Job->Depth       = Depth;
+  Job->Status      = EFI_NOT_STARTED;
+
+  if (CopySection) {
+    Job->SectionBuffer = AllocateCopyPool (SectionSize, Section);
+    if (Job->SectionBuffer == NULL) {
+      return;
+    }
+
+    Job->Section = Job->SectionBuffer;
+  }
+
+  Job->OutputBuffer = AllocatePool (OutputSize);
+  if (Job->OutputBuffer == NULL) {
+    if (Job->SectionBuffer != NULL) {
+      FreePool (Job->SectionBuffer);
+    }
+
+    return;
+  }
+
+  if (ScratchSize > 0) {
+    Job->ScratchBuffer = AllocatePool (ScratchSize);
+    if (Job->ScratchBuffer == NULL) {
+      FreePool (Job->OutputBuffer);
+      if (Job->SectionBuffer != NULL) {
+        FreePool (Job->SectionBuffer);
+      }
+
+      return;
+    }
+  }
+
+  Job->Instance = ++mParallelDecodeLastInstance;
+  mParallelDecode.JobCount++;
+}
+
+/**
+  Queue the compressed GUID defined sections found in a section stream for
+  parallel decode. GUID defined sections whose data is readable in place are
+  searched too, up to PcdFwVolDxeMaxEncapsulationDepth.
+
+  @param  Buffer                The section stream.
+  @param  BufferSize            The size of Buffer in bytes.
+  @param  FvHandle              The handle of the FV that holds the file.
+  @param  FileName              The name of the FFS file the stream belongs to.
+  @param  Parent                The instance of the job whose output holds
+                                the stream, or 0 for the file itself.
+  @param  BaseOffset            The offset of the stream in that buffer.
+  @param  Depth                 The number of encapsulation sections around
+                                the stream.
+  @param  CopySections          TRUE if Buffer may be freed before the queued
+                                sections are extracted.
+
+**/
+STATIC
+VOID
+QueueParallelDecodeSections (
+  IN CONST VOID      *Buffer,
+  IN UINTN           BufferSize,
+  IN EFI_HANDLE      FvHandle,
+  IN CONST EFI_GUID  *FileName,
+  IN UINT32          Parent,
+  IN UINT32          BaseOffset,
+  IN UINT32          Depth,
+  IN BOOLEAN         CopySections
+  )
+{
+  CONST EFI_COMMON_SECTION_HEADER  *Section;
+  UINTN                            SectionSize;
+  UINTN                            Offset;
+  UINT16                           DataOffset;
+  UINT16                           Attributes;
+
+  if (Depth >= PcdGet32 (PcdFwVolDxeMaxEncapsulationDepth)) {
+    return;
+  }
+
+  Offset = 0;
+  while (Offset + sizeof (EFI_COMMON_SECTION_HEADER) <= BufferSize) {
+    Section = (CONST EFI_COMMON_SECTION_HEADER *)((CONST UINT8 *)Buffer + Offset);
+    if (IS_SECTION2 (Section)) {
+      if (Offset + sizeof (EFI_COMMON_SECTION_HEADER2) > BufferSize) {
+        break;
+      }
+
+      SectionSize = SECTION2_SIZE (Section);
+    } else {
+      SectionSize = SECTION_SIZE (Section);
+    }
+
+    if ((SectionSize < sizeof (EFI_COMMON_SECTION_HEADER)) || (SectionSize > BufferSize - Offset)) {
+      break;
+    }
+
+    if (Section->Type == EFI_SECTION_GUID_DEFINED) {
+      if (IsParallelDecodeSection (Section)) {
+        AddParallelDecodeJob (
+          Section,
+          SectionSize,
+          FvHandle,
+          FileName,
+          Parent,
+          BaseOffset + (UINT32)Offset,
+          Depth,
+          CopySections
+          );
+      } else {
+        //
+        // The data of a GUID defined section that does not require processing
+        // can be searched in place.
+        //
+        if (IS_SECTION2 (Section)) {
+          DataOffset = ((EFI_GUID_DEFINED_SECTION2 *)Section)->DataOffset;
+          Attributes = ((EFI_GUID_DEFINED_SECTION2 *)Section)->Attributes;
+          if (SectionSize < sizeof (EFI_GUID_DEFINED_SECTION2)) {
+            DataOffset = 0;
+          }
+        } else {
+          DataOffset = ((EFI_GUID_DEFINED_SECTION *)Section)->DataOffset;
+          Attributes = ((EFI_GUID_DEFINED_SECTION *)Section)->Attributes;
+          if (SectionSize < sizeof (EFI_GUID_DEFINED_SECTION)) {
+            DataOffset = 0;
+          }
+        }
+
+        if ((DataOffset != 0) && (DataOffset < SectionSize) &&
+            ((Attributes & EFI_GUIDED_SECTION_PROCESSING_REQUIRED) == 0))
+        {
+          QueueParallelDecodeSections (
+            (CONST UINT8 *)Section + DataOffset,
+            SectionSize - DataOffset,
+            FvHandle,
+            FileName,
+            Parent,
+            BaseOffset + (UINT32)Offset + DataOffset,
+            Depth + 1,
+            CopySections
+            );
+        }
+      }
+    }
+
+    Offset = ALIGN_VALUE (Offset + SectionSize, 4);
+  }
+}
+
+/**
+  Read one scheduled driver file and queue its GUID defined sections for
+  parallel decode.
+
+  @param  DriverEntry           The scheduled driver.
+
+**/
+STATIC
+VOID
+PrepareParallelDecodeFile (
+  IN EFI_CORE_DRIVER_ENTRY  *DriverEntry
+  )
+{
+  EFI_STATUS              Status;
+  VOID                    *FileBuffer;
+  UINTN                   FileSize;
+  EFI_FV_FILETYPE         FileType;
+  EFI_FV_FILE_ATTRIBUTES  FileAttributes;
+  UINT32                  AuthenticationStatus;
+  VOID                    **FileBuffers;
+  UINTN                   JobCount;
+
+  FileBuffer = NULL;
+  Status     = DriverEntry->Fv->ReadFile (
+                                  DriverEntry->Fv,
+                                  &DriverEntry->FileName,
+                                  &FileBuffer,
+                                  &FileSize,
+                                  &FileType,
+                                  &FileAttributes,
+                                  &AuthenticationStatus
+                                  );
+  if (EFI_ERROR (Status) || (FileBuffer == NULL)) {
+    return;
+  }
+
+  JobCount = mParallelDecode.JobCount;
+  QueueParallelDecodeSections (FileBuffer, FileSize, DriverEntry->FvHandle, &DriverEntry->FileName, 0, 0, 0, FALSE);
+
+  if (mParallelDecode.JobCount == JobCount) {
+    FreePool (FileBuffer);
+    return;
+  }
+
+  //
+  // The jobs point into the file buffer, keep it until the end of the pass.
+  //
+  FileBuffers = ReallocatePool (
+                  mParallelDecode.FileCount * sizeof (VOID *),
+                  (mParallelDecode.FileCount + 1) * sizeof (VOID *),
+                  mParallelDecode.FileBuffers
+                  );
+  if (FileBuffers == NULL) {
+    while (mParallelDecode.JobCount > JobCount) {
+      mParallelDecode.JobCount--;
+      FreePool (mParallelDecode.Jobs[mParallelDecode.JobCount].OutputBuffer);
+      if (mParallelDecode.Jobs[mParallelDecode.JobCount].ScratchBuffer != NULL) {
+        FreePool (mParallelDecode.Jobs[mParallelDecode.JobCount].ScratchBuffer);
+      }
+    }
+
+    FreePool (FileBuffer);
+    return;
+  }
+
+  FileBuffers[mParallelDecode.FileCount++] = FileBuffer;
+  mParallelDecode.FileBuffers              = FileBuffers;
+}
+
+/**
+  Return the bucket of the decoded section index for a section location.
+
+  @param  FileName              The name of the FFS file that holds the section.
+  @param  Parent                The instance of the job whose output holds the
+                                section, or 0 for the file itself.
+  @param  Offset                The offset of the section in that buffer.
+
+  @return The index bucket.
+
+**/
+STATIC
+LIST_ENTRY *
+ParallelDecodeIndexBucket (
+  IN CONST EFI_GUID  *FileName,
+  IN UINT32          Parent,
+  IN UINT32          Offset
+  )
+{
+  UINT32  Hash;
+
+  Hash = FileName->Data1 ^ (Parent * 0x9E3779B1) ^ (Offset >> 2);
+  Hash = Hash ^ (Hash >> 16);
+  return &mParallelDecode.Index[Hash & (PARALLEL_DECODE_INDEX_SIZE - 1)];
+}
+
+/**
+  Sort a range of jobs by decreasing output size, so that the longest decodes
+  are claimed first.
+
+  @param  First                 Index of the first job of the range.
+  @param  Last                  Index after the last job of the range.
+
+**/
+STATIC
+VOID
+SortParallelDecodeJobs (
+  IN UINTN  First,
+  IN UINTN  Last
+  )
+{
+  PARALLEL_DECODE_JOB  Job;
+  UINTN                Index;
+  UINTN                Insert;
+
+  for (Index = First + 1; Index < Last; Index++) {
+    CopyMem (&Job, &mParallelDecode.Jobs[Index], sizeof (Job));
+    for (Insert = Index; Insert > First; Insert--) {
+      if (mParallelDecode.Jobs[Insert - 1].OutputSize >= Job.OutputSize) {
+        break;
+      }
+
+      CopyMem (&mParallelDecode.Jobs[Insert], &mParallelDecode.Jobs[Insert - 1], sizeof (Job));
+    }
+
+    CopyMem (&mParallelDecode.Jobs[Insert], &Job, sizeof (Job));
+  }
+}
+
+/**
+  Decode worker run on the BSP and on every enabled AP. Each processor claims
+  jobs until none is left. No boot service, DEBUG() or other non MP-safe call
+  may be made from here.
+
+  @param  Buffer                Pointer to PARALLEL_DECODE_CONTEXT.
+
+**/
+STATIC
+VOID
+EFIAPI
+ParallelDecodeWorker (
+  IN OUT VOID  *Buffer
+  )
+{
+  PARALLEL_DECODE_CONTEXT  *Context;
+  PARALLEL_DECODE_JOB      *Job;
+  UINTN                    ProcessorNumber;
+  UINT32                   Index;
+  VOID                     *OutputBuffer;
+
+  Context = (PARALLEL_DECODE_CONTEXT *)Buffer;
+
+  ProcessorNumber = 0;
+  Context->MpServices->WhoAmI (Context->MpServices, &ProcessorNumber);
+
+  for ( ; ;) {
+    Index = InterlockedIncrement (&Context->NextJob) - 1;
+    if (Index >= Context->JobCount) {
+      break;
+    }
+
+    Job                  = &Context->Jobs[Index];
+    Job->ProcessorNumber = ProcessorNumber;
+    Job->StartTicks      = GetPerformanceCounter ();
+
+    OutputBuffer = Job->OutputBuffer;
+    Job->Status  = ExtractGuidedSectionDecode (
+                     Job->Section,
+                     &OutputBuffer,
+                     Job->ScratchBuffer,
+                     &Job->AuthenticationStatus
+                     );
+    if (!EFI_ERROR (Job->Status) && (OutputBuffer != Job->OutputBuffer)) {
+      CopyMem (Job->OutputBuffer, OutputBuffer, Job->OutputSize);
+    }
+
+    Job->EndTicks = GetPerformanceCounter ();
+  }
+}
+
+/**
+  Run ParallelDecodeWorker() on the BSP and on all the APs at the same time.
+
+  The APs are started in non-blocking mode so that the BSP claims jobs too.
+  Once the BSP runs out of jobs it waits for the completion event, so every AP
+  is idle again when this function returns. If the APs cannot be started the
+  BSP decodes the round alone.
+
+**/
+STATIC
+VOID
+ParallelDecodeRunRound (
+  VOID
+  )
+{
+  EFI_STATUS  Status;
+  UINTN       Retry;
+
+  if (mParallelDecodeApDoneEvent == NULL) {
+    Status = CoreCreateEvent (0, TPL_CALLBACK, NULL, NULL, &mParallelDecodeApDoneEvent);
+    if (EFI_ERROR (Status)) {
+      mParallelDecodeApDoneEvent = NULL;
+      ParallelDecodeWorker (&mParallelDecode);
+      return;
+    }
+  }
+
+  for (Retry = 0; ; Retry++) {
+    Status = mParallelDecode.MpServices->StartupAllAPs (
+                                          mParallelDecode.MpServices,
+                                          ParallelDecodeWorker,
+                                          FALSE,
+                                          mParallelDecodeApDoneEvent,
+                                          0,
+                                          &mParallelDecode,
+                                          NULL
+                                          );
+    if ((Status != EFI_NOT_READY) || (Retry == PARALLEL_DECODE_STARTUP_RETRIES)) {
+      break;
+    }
+
+    CpuPause ();
+  }
+
+  ParallelDecodeWorker (&mParallelDecode);
+
+  if (EFI_ERROR (Status)) {
+    //
+    // EFI_NOT_STARTED on a single processor system, the BSP did all the work.
+    //
+    return;
+  }
+
+  //
+  // The MP services signal the event from their periodic AP status check.
+  //
+  while (CoreCheckEvent (mParallelDecodeApDoneEvent) == EFI_NOT_READY) {
+    CpuPause ();
+  }
+}
+
+/**
+  Decode the compressed GUID defined sections of all drivers on the scheduled
+  queue on the application processors. This is a no-op unless
+  PcdDxeParallelImageDecode is TRUE and the MP Services protocol is installed.
+
+  The BSP decodes alongside the APs. The call returns once every section has
+  been decoded and every AP is idle, so the entry points of the scheduled
+  drivers are free to use the MP Services protocol themselves.
+
+  @param  ScheduledQueue        The dispatcher's mScheduledQueue.
+
+**/
+VOID
+CoreParallelDecodeScheduledDrivers (
+  IN LIST_ENTRY  *ScheduledQueue
+  )
+{
+  EFI_STATUS             Status;
+  LIST_ENTRY             *Link;
+  EFI_CORE_DRIVER_ENTRY  *DriverEntry;
+  PARALLEL_DECODE_JOB    *Job;
+  UINTN                  Index;
+  UINTN                  RoundStart;
+  UINTN                  RoundEnd;
+  CHAR8                  Token[PARALLEL_DECODE_TOKEN_LENGTH];
+
+  if (!PcdGetBool (PcdDxeParallelImageDecode)) {
+    return;
+  }
+
+  CoreFreeParallelDecodeResults ();
+
+  Status = CoreLocateProtocol (&gEfiMpServiceProtocolGuid, NULL, (VOID **)&mParallelDecode.MpServices);
+  if (EFI_ERROR (Status)) {
+    return;
+  }
+
+  PERF_INMODULE_BEGIN ("DxeDecodePrepare");
+  for (Link = ScheduledQueue->ForwardLink; Link != ScheduledQueue; Link = Link->ForwardLink) {
+    DriverEntry = CR (Link, EFI_CORE_DRIVER_ENTRY, ScheduledLink, EFI_CORE_DRIVER_ENTRY_SIGNATURE);
+    if (DriverEntry->ImageHandle == NULL) {
+      PrepareParallelDecodeFile (DriverEntry);
+    }
+  }
+
+  PERF_INMODULE_END ("DxeDecodePrepare");
+
+  if (mParallelDecode.JobCount < 2) {
+    //
+    // Nothing to overlap, let CoreLoadImage() decode inline.
+    //
+    CoreFreeParallelDecodeResults ();
+    return;
+  }
+
+  DEBUG ((DEBUG_DISPATCH, "Parallel decode of %d sections\n", (UINT32)mParallelDecode.JobCount));
+
+  PERF_INMODULE_BEGIN ("DxeDecode");
+  for (RoundStart = 0; RoundStart < mParallelDecode.JobCount; RoundStart = RoundEnd) {
+    RoundEnd = mParallelDecode.JobCount;
+    SortParallelDecodeJobs (RoundStart, RoundEnd);
+
+    mParallelDecode.NextJob = (UINT32)RoundStart;
+    ParallelDecodeRunRound ();
+
+    //
+    // Queue the compressed sections nested in this round's output for the
+    // next round. The output buffers may be handed over to the section
+    // extraction code and freed before the nested sections are extracted, so
+    // the nested jobs keep a copy of their section.
+    //
+    for (Index = RoundStart; Index < RoundEnd; Index++) {
+      Job = &mParallelDecode.Jobs[Index];
+      if (Job->ScratchBuffer != NULL) {
+        FreePool (Job->ScratchBuffer);
+        Job->ScratchBuffer = NULL;
+      }
+
+      if (!EFI_ERROR (Job->Status)) {
+        QueueParallelDecodeSections (
+          Job->OutputBuffer,
+          Job->OutputSize,
+          Job->FvHandle,
+          Job->FileName,
+          Job->Instance,
+          0,
+          Job->Depth + 1,
+          TRUE
+          );
+      }
+    }
+
+    if (mParallelDecode.JobCount > RoundEnd) {
+      DEBUG ((DEBUG_DISPATCH, "Parallel decode of %d nested sections\n", (UINT32)(mParallelDecode.JobCount - RoundEnd)));
+    }
+  }
+
+  PERF_INMODULE_END ("DxeDecode");
+
+  for (Index = 0; Index < PARALLEL_DECODE_INDEX_SIZE; Index++) {
+    InitializeListHead (&mParallelDecode.Index[Index]);
+  }
+
+  for (Index = 0; Index < mParallelDecode.JobCount; Index++) {
+    Job = &mParallelDecode.Jobs[Index];
+    if (Job->Status == EFI_NOT_STARTED) {
+      continue;
+    }
+
+    if (!EFI_ERROR (Job->Status)) {
+      InsertTailList (ParallelDecodeIndexBucket (Job->FileName, Job->Parent, Job->Offset), &Job->IndexLink);
+    }
+
+    //
+    // The records carry the GUID of the FFS file. The handle passed to the
+    // performance library is the file name in the driver entry, which stays
+    // valid and unique for the life of the DXE core.
+    //
+    AsciiSPrint (Token, sizeof (Token), "DxeDecode:CPU%d", (UINT32)Job->ProcessorNumber);
+    PERF_START_EX ((VOID *)Job->FileName, Token, NULL, Job->StartTicks, 0);
+    PERF_END_EX ((VOID *)Job->FileName, Token, NULL, Job->EndTicks, 0);
+  }
+}
+
+/**
+  Hand over the result of a parallel decode to the section extraction code.
+
+  @param  Location              The location of the GUID defined section being
+                                extracted.
+  @param  Section               The GUID defined section being extracted.
+  @param  OutputBuffer          On success, the decoded data. Ownership of the
+                                pool buffer passes to the caller.
+  @param  OutputSize            On success, the size of OutputBuffer in bytes.
+  @param  AuthenticationStatus  On success, the authentication status returned
+                                by the decode handler.
+  @param  OutputLocation        On success, the location of the decoded data,
+                                for the section stream opened on it.
+
+  @retval TRUE                  The section was already decoded.
+  @retval FALSE                 No decoded copy of the section exists, the
+                                caller must extract it.
+
+**/
+BOOLEAN
+CoreGetParallelDecodedSection (
+  IN  CONST CORE_SECTION_LOCATION  *Location,
+  IN  CONST VOID                   *Section,
+  OUT VOID                         **OutputBuffer,
+  OUT UINTN                        *OutputSize,
+  OUT UINT32                       *AuthenticationStatus,
+  OUT CORE_SECTION_LOCATION        *OutputLocation
+  )
+{
+  LIST_ENTRY           *Bucket;
+  LIST_ENTRY           *Link;
+  PARALLEL_DECODE_JOB  *Job;
+  UINTN                SectionSize;
+
+  if ((mParallelDecode.JobCount == 0) || (Location->FvHandle == NULL)) {
+    return FALSE;
+  }
+
+  if (IS_SECTION2 (Section)) {
+    SectionSize = SECTION2_SIZE (Section);
+  } else {
+    SectionSize = SECTION_SIZE (Section);
+  }
+
+  Bucket = ParallelDecodeIndexBucket (&Location->FileName, Location->Parent, Location->Offset);
+  for (Link = Bucket->ForwardLink; Link != Bucket; Link = Link->ForwardLink) {
+    Job = BASE_CR (Link, PARALLEL_DECODE_JOB, IndexLink);
+    if ((Job->Offset != Location->Offset) || (Job->Parent != Location->Parent) ||
+        (Job->FvHandle != Location->FvHandle) || !CompareGuid (Job->FileName, &Location->FileName))
+    {
+      continue;
+    }
+
+    if (Job->Consumed || (Job->SectionSize != SectionSize)) {
+      return FALSE;
+    }
+
+    Job->Consumed         = TRUE;
+    *OutputBuffer         = Job->OutputBuffer;
+    *OutputSize           = Job->OutputSize;
+    *AuthenticationStatus = Job->AuthenticationStatus;
+
+    OutputLocation->FvHandle = Job->FvHandle;
+    CopyGuid (&OutputLocation->FileName, Job->FileName);
+    OutputLocation->Parent = Job->Instance;
+    OutputLocation->Offset = 0;
+    return TRUE;
+  }
+
+  return FALSE;
+}
+
+/**
+  Free the decoded sections that were not consumed by CoreLoadImage(), along
+  with the file copies and job table of the last pass.
+
+**/
+VOID
+CoreFreeParallelDecodeResults (
+  VOID
+  )
+{
+  PARALLEL_DECODE_JOB  *Job;
+  UINTN                Index;
+
+  for (Index = 0; Index < mParallelDecode.JobCount; Index++) {
+    Job = &mParallelDecode.Jobs[Index];
+    if (!Job->Consumed) {
+      FreePool (Job->OutputBuffer);
+    }
+
+    if (Job->ScratchBuffer != NULL) {
+      FreePool (Job->ScratchBuffer);
+    }
+
+    if (Job->SectionBuffer != NULL) {
+      FreePool (Job->SectionBuffer);
+    }
+  }
+
+  for (Index = 0; Index < mParallelDecode.FileCount; Index++) {
+    FreePool (mParallelDecode.FileBuffers[Index]);
+  }
+
+  if (mParallelDecode.Jobs != NULL) {
+    FreePool (mParallelDecode.Jobs);
+  }
+
+  if (mParallelDecode.FileBuffers != NULL) {
+    FreePool (mParallelDecode.FileBuffers);
+  }
+
+  ZeroMem (&mParallelDecode, sizeof (mParallelDecode));
+}
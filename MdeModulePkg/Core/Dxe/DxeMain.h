@@ -45,6 +45,7 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #include <Protocol/HiiPackageList.h>
 #include <Protocol/SmmBase2.h>
 #include <Protocol/PeCoffImageEmulator.h>
+#include <Protocol/MpService.h>
 #include <Guid/MemoryTypeInformation.h>
 #include <Guid/FirmwareFileSystem2.h>
 #include <Guid/FirmwareFileSystem3.h>
@@ -77,6 +78,9 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #include <Library/PeCoffGetEntryPointLib.h>
 #include <Library/PeCoffExtraActionLib.h>
 #include <Library/PcdLib.h>
+#include <Library/PrintLib.h>
+#include <Library/SynchronizationLib.h>
+#include <Library/TimerLib.h>
 #include <Library/MemoryAllocationLib.h>
 #include <Library/DevicePathLib.h>
 #include <Library/UefiBootServicesTableLib.h>
@@ -113,6 +117,11 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 ///
 #define DEPEX_STACK_SIZE_INCREMENT  0x1000
 
+///
+/// Number of buckets in the index of drivers waiting for a protocol. Must be a power of 2.
+///
+#define DEPEX_WAITER_INDEX_SIZE  64
+
 typedef struct {
   EFI_GUID     *ProtocolGuid;
   VOID         **Protocol;
@@ -158,11 +167,43 @@ typedef struct {
   BOOLEAN                          Untrusted;
   BOOLEAN                          Initialized;
   BOOLEAN                          DepexProtocolError;
+  //
+  // TRUE if the Depex has to be evaluated again on the next dispatch pass.
+  //
+  BOOLEAN                          DepexReevaluate;
+  //
+  // TRUE if the Depex is not in the waiter index and is evaluated on every pass.
+  //
+  BOOLEAN                          DepexNotIndexed;
+  LIST_ENTRY                       DepexWaiters;    // DEPEX_WAITER.DriverLink
 
   EFI_HANDLE                       ImageHandle;
   BOOLEAN                          IsFvImage;
 } EFI_CORE_DRIVER_ENTRY;
 
+//
+// Where a section lives in an FFS file, used to find the sections decoded by
+// the parallel decode in the dispatcher. Parent is the instance number of the
+// decoded GUID defined section whose output holds the section, or 0 for the
+// file itself, and Offset is the offset in that buffer. FvHandle is NULL if
+// the location is unknown.
+//
+typedef struct {
+  EFI_HANDLE    FvHandle;
+  EFI_GUID      FileName;
+  UINT32        Parent;
+  UINT32        Offset;
+} CORE_SECTION_LOCATION;
+
+#define DEPEX_WAITER_SIGNATURE  SIGNATURE_32('d','p','x','w')
+typedef struct {
+  UINTN                    Signature;
+  LIST_ENTRY               IndexLink;       // mDepexWaiterIndex
+  LIST_ENTRY               DriverLink;      // EFI_CORE_DRIVER_ENTRY.DepexWaiters
+  EFI_GUID                 ProtocolGuid;
+  EFI_CORE_DRIVER_ENTRY    *DriverEntry;
+} DEPEX_WAITER;
+
 //
 // The data structure of GCD memory map entry
 //
@@ -484,6 +525,147 @@ CorePreProcessDepex (
   IN  EFI_CORE_DRIVER_ENTRY  *DriverEntry
   );
 
+/**
+  Enter critical section by gaining lock on mDispatcherLock.
+
+**/
+VOID
+CoreAcquireDispatcherLock (
+  VOID
+  );
+
+/**
+  Exit critical section by releasing lock on mDispatcherLock.
+
+**/
+VOID
+CoreReleaseDispatcherLock (
+  VOID
+  );
+
+/**
+  Initialize the index of drivers waiting for a protocol.
+
+**/
+VOID
+CoreInitializeDepexWaiterIndex (
+  VOID
+  );
+
+/**
+  Add DriverEntry to the waiter index for every protocol GUID that its
+  dependency expression pushes and that has not been found installed yet.
+
+  An expression that uses NOT is not registered: it can become TRUE when a
+  protocol is uninstalled, which the index does not track.
+
+  @param  DriverEntry           The driver to register.
+
+  @retval EFI_SUCCESS           The driver was registered.
+  @retval EFI_UNSUPPORTED       The dependency expression uses NOT.
+  @retval EFI_OUT_OF_RESOURCES  There is not enough memory for the index entries.
+
+**/
+EFI_STATUS
+CoreRegisterDepexWaiters (
+  IN  EFI_CORE_DRIVER_ENTRY  *DriverEntry
+  );
+
+/**
+  Remove DriverEntry from the waiter index and free its index entries.
+
+  @param  DriverEntry           The driver to unregister.
+
+**/
+VOID
+CoreUnregisterDepexWaiters (
+  IN  EFI_CORE_DRIVER_ENTRY  *DriverEntry
+  );
+
+/**
+  Called by the protocol database every time Protocol is installed or
+  reinstalled. Marks the drivers whose dependency expression waits for
+  Protocol for re-evaluation on the next dispatch pass.
+
+  @param  Protocol              The GUID of the protocol that was installed.
+
+**/
+VOID
+CoreDepexProtocolInstalled (
+  IN  EFI_GUID  *Protocol
+  );
+
+/**
+  Decide whether the dependency expression of a Dependent driver has to be
+  evaluated on this dispatch pass, and register the driver in the waiter index
+  the first time it is evaluated.
+
+  @param  DriverEntry           The driver in the Dependent state.
+
+  @retval TRUE                  CoreIsSchedulable() must be called for DriverEntry.
+  @retval FALSE                 None of the protocols the dependency expression
+                                waits for has been installed since the last
+                                evaluation, and the expression does not use NOT,
+                                so the result cannot have changed.
+
+**/
+BOOLEAN
+CoreDepexNeedsEvaluation (
+  IN  EFI_CORE_DRIVER_ENTRY  *DriverEntry
+  );
+
+/**
+  Decode the compressed GUID defined sections of all drivers on the scheduled
+  queue on the application processors. This is a no-op unless
+  PcdDxeParallelImageDecode is TRUE and the MP Services protocol is installed.
+
+  @param  ScheduledQueue        The dispatcher's mScheduledQueue.
+
+**/
+VOID
+CoreParallelDecodeScheduledDrivers (
+  IN LIST_ENTRY  *ScheduledQueue
+  );
+
+/**
+  Hand over the result of a parallel decode to the section extraction code.
+
+  @param  Location              The location of the GUID defined section being
+                                extracted.
+  @param  Section               The GUID defined section being extracted.
+  @param  OutputBuffer          On success, the decoded data. Ownership of the
+                                pool buffer passes to the caller.
+  @param  OutputSize            On success, the size of OutputBuffer in bytes.
+  @param  AuthenticationStatus  On success, the authentication status returned
+                                by the decode handler.
+  @param  OutputLocation        On success, the location of the decoded data,
+                                for the section stream opened on it.
+
+  @retval TRUE                  The section was already decoded.
+  @retval FALSE                 No decoded copy of the section exists, the
+                                caller must extract it.
+
+**/
+BOOLEAN
+CoreGetParallelDecodedSection (
+  IN  CONST CORE_SECTION_LOCATION  *Location,
+  IN  CONST VOID                   *Section,
+  OUT VOID                         **OutputBuffer,
+  OUT UINTN                        *OutputSize,
+  OUT UINT32                       *AuthenticationStatus,
+  OUT CORE_SECTION_LOCATION        *OutputLocation
+  );
+
+/**
+  Free the decoded sections that were not consumed by CoreLoadImage(), along
+  with the file copies and job table of the last pass.
+
+**/
+VOID
+CoreFreeParallelDecodeResults (
+  VOID
+  );
+
 /**
   Terminates all boot services.
 
@@ -674,6 +856,19 @@ CoreInstallProtocolInterfaceNotify (
   IN BOOLEAN             Notify
   );
 
+/**
+  Computes the bucket-independent hash value of a protocol GUID.
+
+  @param  Protocol               The ID of the protocol
+
+  @return The hash value of Protocol.
+
+**/
+UINTN
+CoreHashProtocolGuid (
+  IN CONST EFI_GUID  *Protocol
+  );
+
 /**
   Installs a list of protocol interface into the boot services environment.
   This function calls InstallProtocolInterface() in a loop. If any error
@@ -2322,6 +2517,23 @@ GetSection (
   IN BOOLEAN           IsFfs3Fv
   );
 
+/**
+  Record the FFS file a section stream was opened on, so that the sections
+  decoded ahead of time by the dispatcher can be found while the stream is
+  parsed.
+
+  @param  SectionStreamHandle    The stream opened on the data of the file.
+  @param  FvHandle               The handle of the FV that holds the file.
+  @param  FileName               The name of the file.
+
+**/
+VOID
+CoreSetSectionStreamFile (
+  IN UINTN           SectionStreamHandle,
+  IN EFI_HANDLE      FvHandle,
+  IN CONST EFI_GUID  *FileName
+  );
+
 /**
   SEP member function.  Deletes an existing section stream
 
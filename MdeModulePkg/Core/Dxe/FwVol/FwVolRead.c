@@ -500,6 +500,8 @@ FvReadFileSection (
     if (EFI_ERROR (Status)) {
       goto Done;
     }
+
+    CoreSetSectionStreamFile (FfsEntry->StreamHandle, FvDevice->Handle, NameGuid);
   }
 
   //
@@ -10,16 +10,22 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #include "Handle.h"
 
 //
-// mProtocolDatabase     - A list of all protocols in the system.  (simple list for now)
+// mProtocolDatabase     - A list of all protocols in the system, in creation order
+// mProtocolHashTable    - Hash index of mProtocolDatabase keyed by protocol GUID
+// mInterfaceHashTable   - Hash index of all protocol interfaces keyed by (handle, protocol)
 // gHandleList           - A list of all the handles in the system
 // gProtocolDatabaseLock - Lock to protect the mProtocolDatabase
 // gHandleDatabaseKey    -  The Key to show that the handle has been created/modified
 //
 LIST_ENTRY          mProtocolDatabase     = INITIALIZE_LIST_HEAD_VARIABLE (mProtocolDatabase);
-LIST_ENTRY          gHandleList           = INITIALIZE_LIST_HEAD_VARIABLE (gHandleList);
-EFI_LOCK            gProtocolDatabaseLock = EFI_INITIALIZE_LOCK_VARIABLE (TPL_NOTIFY);
-UINT64              gHandleDatabaseKey    = 0;
-ORDERED_COLLECTION  *gOrderedHandleList   = NULL;
+LIST_ENTRY          mProtocolHashTable[PROTOCOL_HASH_TABLE_SIZE];
+LIST_ENTRY          *mInterfaceHashTable     = NULL;
+UINTN               mInterfaceHashTableSize  = 0;
+UINTN               mInterfaceHashTableCount = 0;
+LIST_ENTRY          gHandleList              = INITIALIZE_LIST_HEAD_VARIABLE (gHandleList);
+EFI_LOCK            gProtocolDatabaseLock    = EFI_INITIALIZE_LOCK_VARIABLE (TPL_NOTIFY);
+UINT64              gHandleDatabaseKey       = 0;
+ORDERED_COLLECTION  *gOrderedHandleList      = NULL;
 
 /**
   Acquire lock on gProtocolDatabaseLock.
@@ -79,6 +85,199 @@ PointerCompare (
   return 1;
 }
 
+/**
+  Computes the bucket-independent hash value of a protocol GUID.
+
+  @param  Protocol               The ID of the protocol
+
+  @return The hash value of Protocol.
+
+**/
+UINTN
+CoreHashProtocolGuid (
+  IN CONST EFI_GUID  *Protocol
+  )
+{
+  CONST UINT32  *Data;
+  UINT32        Hash;
+
+  Data = (CONST UINT32 *)Protocol;
+  Hash = ReadUnaligned32 (&Data[0]);
+  Hash = (Hash * 0x9E3779B1) ^ ReadUnaligned32 (&Data[1]);
+  Hash = (Hash * 0x9E3779B1) ^ ReadUnaligned32 (&Data[2]);
+  Hash = (Hash * 0x9E3779B1) ^ ReadUnaligned32 (&Data[3]);
+
+  return (UINTN)(Hash ^ (Hash >> 16));
+}
+
+/**
+  Computes the bucket-independent hash value of a protocol interface from the
+  handle it is installed on and its protocol entry.
+
+  @param  Handle                 The handle the interface is installed on
+  @param  ProtEntry              The protocol entry of the interface
+
+  @return The hash value of (Handle, ProtEntry).
+
+**/
+STATIC
+UINTN
+CoreHashProtocolInterface (
+  IN IHANDLE         *Handle,
+  IN PROTOCOL_ENTRY  *ProtEntry
+  )
+{
+  UINT32  Hash;
+
+  //
+  // Both structures are pool allocations, so the low 3 bits carry no entropy.
+  //
+  Hash  = (UINT32)((UINTN)Handle >> 3) * 0x9E3779B1;
+  Hash ^= (UINT32)((UINTN)ProtEntry >> 3) * 0x85EBCA77;
+
+  return (UINTN)(Hash ^ (Hash >> 15));
+}
+
+/**
+  Doubles the number of buckets in mInterfaceHashTable and redistributes the
+  protocol interfaces. If the new table cannot be allocated the current one
+  is kept, which only affects the lookup performance.
+  The gProtocolDatabaseLock must be owned
+
+**/
+STATIC
+VOID
+CoreGrowInterfaceHashTable (
+  VOID
+  )
+{
+  LIST_ENTRY          *NewTable;
+  UINTN               NewSize;
+  UINTN               Index;
+  LIST_ENTRY          *Link;
+  PROTOCOL_INTERFACE  *Prot;
+
+  ASSERT_LOCKED (&gProtocolDatabaseLock);
+
+  NewSize  = mInterfaceHashTableSize * 2;
+  NewTable = AllocatePool (NewSize * sizeof (LIST_ENTRY));
+  if (NewTable == NULL) {
+    return;
+  }
+
+  for (Index = 0; Index < NewSize; Index++) {
+    InitializeListHead (&NewTable[Index]);
+  }
+
+  for (Index = 0; Index < mInterfaceHashTableSize; Index++) {
+    while (!IsListEmpty (&mInterfaceHashTable[Index])) {
+      Link = GetFirstNode (&mInterfaceHashTable[Index]);
+      Prot = CR (Link, PROTOCOL_INTERFACE, HashLink, PROTOCOL_INTERFACE_SIGNATURE);
+      RemoveEntryList (Link);
+      InsertTailList (
+        &NewTable[CoreHashProtocolInterface (Prot->Handle, Prot->Protocol) & (NewSize - 1)],
+        Link
+        );
+    }
+  }
+
+  CoreFreePool (mInterfaceHashTable);
+  mInterfaceHashTable     = NewTable;
+  mInterfaceHashTableSize = NewSize;
+}
+
+/**
+  Adds a protocol interface to the (handle, protocol) hash index.
+  The gProtocolDatabaseLock must be owned
+
+  @param  Prot                   The protocol interface to add. Prot->Handle and
+                                 Prot->Protocol must already be set.
+
+**/
+STATIC
+VOID
+CoreInsertInterfaceHash (
+  IN PROTOCOL_INTERFACE  *Prot
+  )
+{
+  UINTN  Bucket;
+
+  ASSERT_LOCKED (&gProtocolDatabaseLock);
+
+  if (mInterfaceHashTableCount >= mInterfaceHashTableSize * INTERFACE_HASH_LOAD_FACTOR) {
+    CoreGrowInterfaceHashTable ();
+  }
+
+  Bucket = CoreHashProtocolInterface (Prot->Handle, Prot->Protocol) & (mInterfaceHashTableSize - 1);
+  InsertTailList (&mInterfaceHashTable[Bucket], &Prot->HashLink);
+  mInterfaceHashTableCount++;
+}
+
+/**
+  Removes a protocol interface from the (handle, protocol) hash index.
+  The gProtocolDatabaseLock must be owned
+
+  @param  Prot                   The protocol interface to remove.
+
+**/
+STATIC
+VOID
+CoreRemoveInterfaceHash (
+  IN PROTOCOL_INTERFACE  *Prot
+  )
+{
+  ASSERT_LOCKED (&gProtocolDatabaseLock);
+  ASSERT (mInterfaceHashTableCount > 0);
+
+  RemoveEntryList (&Prot->HashLink);
+  mInterfaceHashTableCount--;
+}
+
+/**
+  Finds the protocol interface of a protocol entry on a handle. Short
+  protocol lists are walked, long ones are looked up in the (handle, protocol)
+  hash index.
+  The gProtocolDatabaseLock must be owned
+
+  @param  Handle                 The handle to search the protocol on
+  @param  ProtEntry              The protocol entry to search for
+
+  @return Protocol instance (NULL: Not found)
+
+**/
+STATIC
+PROTOCOL_INTERFACE *
+CoreFindHandleInterface (
+  IN IHANDLE         *Handle,
+  IN PROTOCOL_ENTRY  *ProtEntry
+  )
+{
+  LIST_ENTRY          *Head;
+  LIST_ENTRY          *Link;
+  PROTOCOL_INTERFACE  *Prot;
+
+  if (Handle->ProtocolCount <= HANDLE_PROTOCOL_LIST_WALK_MAX) {
+    for (Link = Handle->Protocols.ForwardLink; Link != &Handle->Protocols; Link = Link->ForwardLink) {
+      Prot = CR (Link, PROTOCOL_INTERFACE, Link, PROTOCOL_INTERFACE_SIGNATURE);
+      if (Prot->Protocol == ProtEntry) {
+        return Prot;
+      }
+    }
+
+    return NULL;
+  }
+
+  Head = &mInterfaceHashTable[CoreHashProtocolInterface (Handle, ProtEntry) & (mInterfaceHashTableSize - 1)];
+  for (Link = Head->ForwardLink; Link != Head; Link = Link->ForwardLink) {
+    Prot = CR (Link, PROTOCOL_INTERFACE, HashLink, PROTOCOL_INTERFACE_SIGNATURE);
+    if ((Prot->Handle == Handle) && (Prot->Protocol == ProtEntry)) {
+      return Prot;
+    }
+  }
+
+  return NULL;
+}
+
 /**
   Initializes "handle" support.
 
@@ -90,12 +289,32 @@ CoreInitializeHandleServices (
   VOID
   )
 {
+  UINTN  Index;
+
   gOrderedHandleList = OrderedCollectionInit (PointerCompare, PointerCompare);
 
   if (gOrderedHandleList == NULL) {
     return EFI_OUT_OF_RESOURCES;
   }
 
+  for (Index = 0; Index < PROTOCOL_HASH_TABLE_SIZE; Index++) {
+    InitializeListHead (&mProtocolHashTable[Index]);
+  }
+
+  mInterfaceHashTable = AllocatePool (INTERFACE_HASH_TABLE_MIN_SIZE * sizeof (LIST_ENTRY));
+  if (mInterfaceHashTable == NULL) {
+    OrderedCollectionUninit (gOrderedHandleList);
+    gOrderedHandleList = NULL;
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  for (Index = 0; Index < INTERFACE_HASH_TABLE_MIN_SIZE; Index++) {
+    InitializeListHead (&mInterfaceHashTable[Index]);
+  }
+
+  mInterfaceHashTableSize  = INTERFACE_HASH_TABLE_MIN_SIZE;
+  mInterfaceHashTableCount = 0;
+
   return EFI_SUCCESS;
 }
 
@@ -146,6 +365,7 @@ CoreFindProtocolEntry (
   IN BOOLEAN   Create
   )
 {
+  LIST_ENTRY      *Bucket;
   LIST_ENTRY      *Link;
   PROTOCOL_ENTRY  *Item;
   PROTOCOL_ENTRY  *ProtEntry;
@@ -153,15 +373,16 @@ CoreFindProtocolEntry (
   ASSERT_LOCKED (&gProtocolDatabaseLock);
 
   //
-  // Search the database for the matching GUID
+  // Search the hash bucket of the GUID for the matching entry
   //
 
   ProtEntry = NULL;
-  for (Link = mProtocolDatabase.ForwardLink;
-       Link != &mProtocolDatabase;
+  Bucket    = &mProtocolHashTable[CoreHashProtocolGuid (Protocol) & (PROTOCOL_HASH_TABLE_SIZE - 1)];
+  for (Link = Bucket->ForwardLink;
+       Link != Bucket;
        Link = Link->ForwardLink)
   {
-    Item = CR (Link, PROTOCOL_ENTRY, AllEntries, PROTOCOL_ENTRY_SIGNATURE);
+    Item = CR (Link, PROTOCOL_ENTRY, HashLink, PROTOCOL_ENTRY_SIGNATURE);
     if (CompareGuid (&Item->ProtocolID, Protocol)) {
       //
       // This is the protocol entry
@@ -189,9 +410,10 @@ CoreFindProtocolEntry (
       InitializeListHead (&ProtEntry->Notify);
 
       //
-      // Add it to protocol database
+      // Add it to protocol database and its hash index
       //
       InsertTailList (&mProtocolDatabase, &ProtEntry->AllEntries);
+      InsertTailList (Bucket, &ProtEntry->HashLink);
     }
   }
 
@@ -219,7 +441,6 @@ CoreFindProtocolInterface (
 {
   PROTOCOL_INTERFACE  *Prot;
   PROTOCOL_ENTRY      *ProtEntry;
-  LIST_ENTRY          *Link;
 
   ASSERT_LOCKED (&gProtocolDatabaseLock);
   Prot = NULL;
@@ -231,17 +452,11 @@ CoreFindProtocolInterface (
   ProtEntry = CoreFindProtocolEntry (Protocol, FALSE);
   if (ProtEntry != NULL) {
     //
-    // Look at each protocol interface for any matches
+    // A protocol can only be installed once on a handle, so the
+    // (handle, protocol) lookup yields the only candidate
     //
-    for (Link = Handle->Protocols.ForwardLink; Link != &Handle->Protocols; Link = Link->ForwardLink) {
-      //
-      // If this protocol interface matches, remove it
-      //
-      Prot = CR (Link, PROTOCOL_INTERFACE, Link, PROTOCOL_INTERFACE_SIGNATURE);
-      if ((Prot->Interface == Interface) && (Prot->Protocol == ProtEntry)) {
-        break;
-      }
-
+    Prot = CoreFindHandleInterface (Handle, ProtEntry);
+    if ((Prot != NULL) && (Prot->Interface != Interface)) {
       Prot = NULL;
     }
   }
@@ -563,6 +778,7 @@ CoreInstallProtocolInterfaceNotify (
   // protocol list for this handle
   //
   InsertHeadList (&Handle->Protocols, &Prot->Link);
+  Handle->ProtocolCount++;
 
   //
   // Add this protocol interface to the tail of the
@@ -570,6 +786,16 @@ CoreInstallProtocolInterfaceNotify (
   //
   InsertTailList (&ProtEntry->Protocols, &Prot->ByProtocol);
 
+  //
+  // Add this protocol interface to the (handle, protocol) index
+  //
+  CoreInsertInterfaceHash (Prot);
+
+  //
+  // Let the dispatcher know which dependency expressions may have changed
+  //
+  CoreDepexProtocolInstalled (&ProtEntry->ProtocolID);
+
   //
   // Notify the notification list for this protocol
   //
@@ -870,9 +1096,11 @@ CoreUninstallProtocolInterface (
     Handle->Key = gHandleDatabaseKey;
 
     //
-    // Remove the protocol interface from the handle
+    // Remove the protocol interface from the handle and the (handle, protocol) index
     //
     RemoveEntryList (&Prot->Link);
+    CoreRemoveInterfaceHash (Prot);
+    Handle->ProtocolCount--;
 
     //
     // Free the memory
@@ -999,25 +1227,17 @@ CoreGetProtocolInterface (
   IN  EFI_GUID    *Protocol
   )
 {
-  PROTOCOL_ENTRY      *ProtEntry;
-  PROTOCOL_INTERFACE  *Prot;
-  IHANDLE             *Handle;
-  LIST_ENTRY          *Link;
-
-  Handle = (IHANDLE *)UserHandle;
+  PROTOCOL_ENTRY  *ProtEntry;
 
   //
-  // Look at each protocol interface for a match
+  // A protocol without an entry in the database cannot be installed anywhere
   //
-  for (Link = Handle->Protocols.ForwardLink; Link != &Handle->Protocols; Link = Link->ForwardLink) {
-    Prot      = CR (Link, PROTOCOL_INTERFACE, Link, PROTOCOL_INTERFACE_SIGNATURE);
-    ProtEntry = Prot->Protocol;
-    if (CompareGuid (&ProtEntry->ProtocolID, Protocol)) {
-      return Prot;
-    }
+  ProtEntry = CoreFindProtocolEntry (Protocol, FALSE);
+  if (ProtEntry == NULL) {
+    return NULL;
   }
 
-  return NULL;
+  return CoreFindHandleInterface ((IHANDLE *)UserHandle, ProtEntry);
 }
 
 /**
@@ -20,6 +20,8 @@ typedef struct {
   LIST_ENTRY    AllHandles;
   /// List of PROTOCOL_INTERFACE's for this handle
   LIST_ENTRY    Protocols;
+  /// Number of PROTOCOL_INTERFACE's on Protocols
+  UINTN         ProtocolCount;
   UINTN         LocateRequest;
   /// The Handle Database Key value when this handle was last created or modified
   UINT64        Key;
@@ -38,6 +40,8 @@ typedef struct {
   UINTN         Signature;
   /// Link Entry inserted to mProtocolDatabase
   LIST_ENTRY    AllEntries;
+  /// Link Entry inserted to the mProtocolHashTable bucket of ProtocolID
+  LIST_ENTRY    HashLink;
   /// ID of the protocol
   EFI_GUID      ProtocolID;
   /// All protocol interfaces
@@ -48,6 +52,25 @@ typedef struct {
 
 #define PROTOCOL_INTERFACE_SIGNATURE  SIGNATURE_32('p','i','f','c')
 
+///
+/// Number of buckets in the protocol GUID hash index. Must be a power of 2.
+///
+#define PROTOCOL_HASH_TABLE_SIZE  256
+
+///
+/// Initial number of buckets in the (handle, protocol) interface hash index.
+/// The index doubles whenever it holds more than INTERFACE_HASH_LOAD_FACTOR
+/// interfaces per bucket. Must be a power of 2.
+///
+#define INTERFACE_HASH_TABLE_MIN_SIZE  256
+#define INTERFACE_HASH_LOAD_FACTOR     2
+
+///
+/// Handles with up to this many protocol interfaces are searched by walking
+/// IHANDLE.Protocols, which is cheaper than a hash lookup for short lists.
+///
+#define HANDLE_PROTOCOL_LIST_WALK_MAX  8
+
 ///
 /// PROTOCOL_INTERFACE - each protocol installed on a handle is tracked
 /// with a protocol interface structure
@@ -60,6 +83,8 @@ typedef struct {
   IHANDLE           *Handle;
   /// Link on PROTOCOL_ENTRY.Protocols
   LIST_ENTRY        ByProtocol;
+  /// Link on the mInterfaceHashTable bucket of (Handle, Protocol)
+  LIST_ENTRY        HashLink;
   /// The protocol ID
   PROTOCOL_ENTRY    *Protocol;
   /// The interface value
@@ -99,6 +99,22 @@ CoreFreePoolI (
   OUT EFI_MEMORY_TYPE  *PoolType OPTIONAL
   );
 
+/**
+  Retrieve the slab pool allocator statistics.
+
+  @param  Statistics             The buffer to receive a POOL_STATISTICS record
+                                 followed by one POOL_SIZE_CLASS record for each
+                                 slab size class. May be NULL to query the size.
+
+  @return The size in bytes of the statistics records, or 0 if the slab pool
+          allocator is disabled.
+
+**/
+UINTN
+CoreGetPoolStatistics (
+  OUT MEMORY_PROFILE_POOL_STATISTICS  *Statistics OPTIONAL
+  );
+
 /**
   Enter critical section by gaining lock on gMemoryLock.
 
@@ -59,6 +59,64 @@ STATIC CONST UINT16  mPoolSizeTable[] = {
 
 #define MAX_POOL_SIZE  (MAX_ADDRESS - POOL_OVERHEAD)
 
+//
+// When PcdDxePoolSlabAllocator is set, small requests are served from single
+// page slabs holding objects of one size class. The slab header lives at the
+// start of the page, so an object carries no pool head or tail. On free, the
+// page of an object is looked up in a hash of all slab pages, which is owned by
+// the allocator, so that the content of the page is never trusted before the
+// page is known to be a slab.
+//
+#define POOL_SLAB_SIGNATURE  SIGNATURE_32('p','s','l','b')
+
+typedef struct _POOL_SLAB_OBJECT POOL_SLAB_OBJECT;
+struct _POOL_SLAB_OBJECT {
+  POOL_SLAB_OBJECT    *Next;
+};
+
+typedef struct _POOL_SLAB POOL_SLAB;
+struct _POOL_SLAB {
+  UINT32              Signature;
+  UINT16              Class;
+  UINT16              FreeCount;
+  EFI_MEMORY_TYPE     Type;
+  POOL_SLAB_OBJECT    *FreeList;
+  LIST_ENTRY          Link;
+  LIST_ENTRY          HashLink;
+};
+
+#define POOL_SLAB_HEADER_SIZE  ALIGN_VALUE (sizeof (POOL_SLAB), 16)
+
+//
+// Size classes are 16 bytes apart up to 128 bytes, then four classes per
+// power of two. Anything larger than the last class uses the binned pool.
+//
+STATIC CONST UINT16  mPoolSlabSizeTable[] = {
+  16,  32,  48,  64,  80,  96,  112, 128, 160, 192,
+  224, 256, 320, 384, 448, 512, 640, 768, 896, 1024
+};
+
+#define POOL_SLAB_CLASS_COUNT      (ARRAY_SIZE (mPoolSlabSizeTable))
+#define POOL_SLAB_GRANULE          16
+#define POOL_SLAB_MAX_OBJECT_SIZE  1024
+
+#define POOL_SLAB_CAPACITY(Class) \
+  ((EFI_PAGE_SIZE - POOL_SLAB_HEADER_SIZE) / mPoolSlabSizeTable[Class])
+
+//
+// Maps (Size + POOL_SLAB_GRANULE - 1) / POOL_SLAB_GRANULE to a size class.
+//
+STATIC UINT8  mPoolSlabClassIndex[POOL_SLAB_MAX_OBJECT_SIZE / POOL_SLAB_GRANULE + 1];
+
+#define POOL_SLAB_HASH_SIZE  512
+#define POOL_SLAB_HASH(Page)  (((UINTN)(Page) >> EFI_PAGE_SHIFT) % POOL_SLAB_HASH_SIZE)
+
+STATIC LIST_ENTRY  mPoolSlabHash[POOL_SLAB_HASH_SIZE];
+
+STATIC MEMORY_PROFILE_POOL_SIZE_CLASS  mPoolSlabStatistics[POOL_SLAB_CLASS_COUNT];
+STATIC UINT64                          mPoolSlabPages;
+STATIC UINT64                          mPoolSlabPeakPages;
+
 //
 // Globals
 //
@@ -69,6 +127,10 @@ typedef struct {
   UINTN              Used;
   EFI_MEMORY_TYPE    MemoryType;
   LIST_ENTRY         FreeList[MAX_POOL_LIST];
+  //
+  // Per memory type magazine of slabs that have at least one free object
+  //
+  LIST_ENTRY         SlabList[POOL_SLAB_CLASS_COUNT];
   LIST_ENTRY         Link;
 } POOL;
 
@@ -118,6 +180,7 @@ CoreInitializePool (
 {
   UINTN  Type;
   UINTN  Index;
+  UINTN  Class;
 
   for (Type = 0; Type < EfiMaxMemoryType; Type++) {
     mPoolHead[Type].Signature  = 0;
@@ -126,6 +189,31 @@ CoreInitializePool (
     for (Index = 0; Index < MAX_POOL_LIST; Index++) {
       InitializeListHead (&mPoolHead[Type].FreeList[Index]);
     }
+
+    for (Class = 0; Class < POOL_SLAB_CLASS_COUNT; Class++) {
+      InitializeListHead (&mPoolHead[Type].SlabList[Class]);
+    }
+  }
+
+  Class = 0;
+  for (Index = 0; Index < ARRAY_SIZE (mPoolSlabClassIndex); Index++) {
+    while (mPoolSlabSizeTable[Class] < Index * POOL_SLAB_GRANULE) {
+      Class++;
+    }
+
+    mPoolSlabClassIndex[Index] = (UINT8)Class;
+  }
+
+  for (Index = 0; Index < POOL_SLAB_HASH_SIZE; Index++) {
+    InitializeListHead (&mPoolSlabHash[Index]);
+  }
+
+  for (Class = 0; Class < POOL_SLAB_CLASS_COUNT; Class++) {
+    mPoolSlabStatistics[Class].Header.Signature = MEMORY_PROFILE_POOL_SIZE_CLASS_SIGNATURE;
+    mPoolSlabStatistics[Class].Header.Length    = sizeof (MEMORY_PROFILE_POOL_SIZE_CLASS);
+    mPoolSlabStatistics[Class].Header.Revision  = MEMORY_PROFILE_POOL_SIZE_CLASS_REVISION;
+    mPoolSlabStatistics[Class].ObjectSize       = mPoolSlabSizeTable[Class];
+    mPoolSlabStatistics[Class].ObjectsPerSlab   = (UINT32)POOL_SLAB_CAPACITY (Class);
   }
 }
 
@@ -175,6 +263,10 @@ LookupPoolHead (
       InitializeListHead (&Pool->FreeList[Index]);
     }
 
+    for (Index = 0; Index < POOL_SLAB_CLASS_COUNT; Index++) {
+      InitializeListHead (&Pool->SlabList[Index]);
+    }
+
     InsertHeadList (&mPoolHeadList, &Pool->Link);
 
     return Pool;
@@ -336,6 +428,108 @@ CoreAllocatePoolPagesI (
   return Buffer;
 }
 
+/**
+  Internal function to allocate pool from a size-class slab.
+  Caller must have the memory lock held
+
+  @param  Pool                   The pool head of the memory type to allocate
+  @param  Size                   The amount of pool to allocate, at most
+                                 POOL_SLAB_MAX_OBJECT_SIZE
+
+  @return The allocated pool, or NULL
+
+**/
+STATIC
+VOID *
+CoreAllocatePoolSlab (
+  IN POOL   *Pool,
+  IN UINTN  Size
+  )
+{
+  POOL_SLAB                       *Slab;
+  POOL_SLAB_OBJECT                *Object;
+  MEMORY_PROFILE_POOL_SIZE_CLASS  *Statistics;
+  LIST_ENTRY                      *SlabList;
+  UINTN                           Class;
+  UINTN                           ObjectSize;
+  UINTN                           Index;
+  CHAR8                           *Data;
+
+  ASSERT_LOCKED (&mPoolMemoryLock);
+  ASSERT (Size <= POOL_SLAB_MAX_OBJECT_SIZE);
+
+  Class      = mPoolSlabClassIndex[(Size + POOL_SLAB_GRANULE - 1) / POOL_SLAB_GRANULE];
+  ObjectSize = mPoolSlabSizeTable[Class];
+  SlabList   = &Pool->SlabList[Class];
+
+  if (IsListEmpty (SlabList)) {
+    Slab = CoreAllocatePoolPagesI (Pool->MemoryType, 1, EFI_PAGE_SIZE, FALSE);
+    if (Slab == NULL) {
+      DEBUG ((DEBUG_ERROR | DEBUG_POOL, "AllocatePool: failed to allocate %ld bytes\n", (UINT64)Size));
+      return NULL;
+    }
+
+    Slab->Signature = POOL_SLAB_SIGNATURE;
+    Slab->Class     = (UINT16)Class;
+    Slab->FreeCount = (UINT16)POOL_SLAB_CAPACITY (Class);
+    Slab->Type      = Pool->MemoryType;
+
+    //
+    // Thread the objects in address order so the first allocations are
+    // served from the start of the page
+    //
+    Data           = (CHAR8 *)Slab + POOL_SLAB_HEADER_SIZE;
+    Slab->FreeList = (POOL_SLAB_OBJECT *)Data;
+    for (Index = 1; Index < Slab->FreeCount; Index++) {
+      ((POOL_SLAB_OBJECT *)Data)->Next = (POOL_SLAB_OBJECT *)(Data + ObjectSize);
+      Data                            += ObjectSize;
+    }
+
+    ((POOL_SLAB_OBJECT *)Data)->Next = NULL;
+    InsertHeadList (SlabList, &Slab->Link);
+    InsertHeadList (&mPoolSlabHash[POOL_SLAB_HASH (Slab)], &Slab->HashLink);
+
+    mPoolSlabPages++;
+    if (mPoolSlabPages > mPoolSlabPeakPages) {
+      mPoolSlabPeakPages = mPoolSlabPages;
+    }
+  } else {
+    Slab = CR (SlabList->ForwardLink, POOL_SLAB, Link, POOL_SLAB_SIGNATURE);
+  }
+
+  ASSERT (Slab->FreeCount > 0);
+  Object         = Slab->FreeList;
+  Slab->FreeList = Object->Next;
+  Slab->FreeCount--;
+
+  //
+  // Full slabs leave the magazine until one of their objects is freed
+  //
+  if (Slab->FreeCount == 0) {
+    RemoveEntryList (&Slab->Link);
+  }
+
+  Statistics = &mPoolSlabStatistics[Class];
+  Statistics->AllocationCount++;
+  Statistics->BytesRequested += Size;
+  Statistics->BytesWasted    += ObjectSize - Size;
+
+  Pool->Used += ObjectSize;
+
+  DEBUG_CLEAR_MEMORY (Object, ObjectSize);
+
+  DEBUG ((
+    DEBUG_POOL,
+    "AllocatePoolI: Type %x, Addr %p (len %lx) %,ld\n",
+    Pool->MemoryType,
+    Object,
+    (UINT64)ObjectSize,
+    (UINT64)Pool->Used
+    ));
+
+  return Object;
+}
+
 /**
   Internal function to allocate pool of a particular type.
   Caller must have the memory lock held
@@ -399,6 +593,19 @@ CoreAllocatePoolI (
                   ((PcdGet8 (PcdHeapGuardPropertyMask) & BIT7) == 0));
   PageAsPool = (IsHeapGuardEnabled (GUARD_HEAP_TYPE_FREED) && !mOnGuarding);
 
+  //
+  // Small requests of the fixed memory types are served from slabs. Guarded
+  // and page-as-pool requests need the pool head, so they never use slabs.
+  //
+  if (PcdGetBool (PcdDxePoolSlabAllocator) &&
+      (Size <= POOL_SLAB_MAX_OBJECT_SIZE) &&
+      ((UINT32)PoolType < EfiMaxMemoryType) &&
+      (Granularity == EFI_PAGE_SIZE) &&
+      !NeedGuard && !PageAsPool)
+  {
+    return CoreAllocatePoolSlab (&mPoolHead[PoolType], Size);
+  }
+
   //
   // Adjusting the Size to be of proper alignment so that
   // we don't get an unaligned access fault later when
@@ -676,6 +883,128 @@ CoreFreePoolPagesWithGuard (
   }
 }
 
+/**
+  Internal function to find the slab of the page holding a buffer.
+  Caller must have the memory lock held
+
+  Only the slab headers on the hash chain are read, Buffer itself and the
+  page holding it are not accessed.
+
+  @param  Buffer                 The buffer to look up
+
+  @return The slab header of the page holding Buffer, or NULL if the page is
+          not a slab
+
+**/
+STATIC
+POOL_SLAB *
+CoreLookupPoolSlab (
+  IN VOID  *Buffer
+  )
+{
+  LIST_ENTRY  *Bucket;
+  LIST_ENTRY  *Link;
+  POOL_SLAB   *Slab;
+  UINTN       Page;
+
+  ASSERT_LOCKED (&mPoolMemoryLock);
+
+  Page   = (UINTN)Buffer & ~(UINTN)EFI_PAGE_MASK;
+  Bucket = &mPoolSlabHash[POOL_SLAB_HASH (Page)];
+  for (Link = Bucket->ForwardLink; Link != Bucket; Link = Link->ForwardLink) {
+    Slab = CR (Link, POOL_SLAB, HashLink, POOL_SLAB_SIGNATURE);
+    if ((UINTN)Slab == Page) {
+      return Slab;
+    }
+  }
+
+  return NULL;
+}
+
+/**
+  Internal function to return an object to its slab.
+  Caller must have the memory lock held
+
+  @param  Slab                   The slab header of the page holding Buffer
+  @param  Buffer                 The allocated pool entry to free
+  @param  PoolType               Pointer to pool type
+
+  @retval EFI_INVALID_PARAMETER  Buffer is not an allocated object of Slab
+  @retval EFI_SUCCESS            Buffer successfully freed.
+
+**/
+STATIC
+EFI_STATUS
+CoreFreePoolSlab (
+  IN POOL_SLAB         *Slab,
+  IN VOID              *Buffer,
+  OUT EFI_MEMORY_TYPE  *PoolType OPTIONAL
+  )
+{
+  POOL              *Pool;
+  POOL_SLAB_OBJECT  *Object;
+  LIST_ENTRY        *SlabList;
+  UINTN             Capacity;
+  UINTN             ObjectSize;
+  UINTN             Offset;
+
+  ASSERT_LOCKED (&mPoolMemoryLock);
+
+  if ((Slab->Class >= POOL_SLAB_CLASS_COUNT) || ((UINT32)Slab->Type >= EfiMaxMemoryType)) {
+    ASSERT (FALSE);
+    return EFI_INVALID_PARAMETER;
+  }
+
+  ObjectSize = mPoolSlabSizeTable[Slab->Class];
+  Capacity   = POOL_SLAB_CAPACITY (Slab->Class);
+  Offset     = (UINTN)Buffer - (UINTN)Slab - POOL_SLAB_HEADER_SIZE;
+  if (((UINTN)Buffer < (UINTN)Slab + POOL_SLAB_HEADER_SIZE) ||
+      (Offset >= Capacity * ObjectSize) ||
+      ((Offset % ObjectSize) != 0) ||
+      (Slab->FreeCount >= Capacity))
+  {
+    ASSERT (FALSE);
+    return EFI_INVALID_PARAMETER;
+  }
+
+  Pool        = &mPoolHead[Slab->Type];
+  Pool->Used -= ObjectSize;
+  DEBUG ((DEBUG_POOL, "FreePool: %p (len %lx) %,ld\n", Buffer, (UINT64)ObjectSize, (UINT64)Pool->Used));
+
+  if (PoolType != NULL) {
+    *PoolType = Slab->Type;
+  }
+
+  DEBUG_CLEAR_MEMORY (Buffer, ObjectSize);
+
+  Object         = Buffer;
+  Object->Next   = Slab->FreeList;
+  Slab->FreeList = Object;
+  Slab->FreeCount++;
+  mPoolSlabStatistics[Slab->Class].FreeCount++;
+
+  SlabList = &Pool->SlabList[Slab->Class];
+  if (Slab->FreeCount == 1) {
+    InsertHeadList (SlabList, &Slab->Link);
+  }
+
+  //
+  // Release an empty slab unless it is the last one of its class, so that a
+  // steady alloc/free pattern does not keep bouncing the page allocator
+  //
+  if ((Slab->FreeCount == Capacity) &&
+      ((Slab->Link.ForwardLink != SlabList) || (Slab->Link.BackLink != SlabList)))
+  {
+    RemoveEntryList (&Slab->Link);
+    RemoveEntryList (&Slab->HashLink);
+    Slab->Signature = 0;
+    mPoolSlabPages--;
+    CoreFreePoolPagesI (Pool->MemoryType, (EFI_PHYSICAL_ADDRESS)(UINTN)Slab, 1);
+  }
+
+  return EFI_SUCCESS;
+}
+
 /**
   Internal function to free a pool entry.
   Caller must have the memory lock held
@@ -707,8 +1036,20 @@ CoreFreePoolI (
   BOOLEAN    IsGuarded;
   BOOLEAN    HasPoolTail;
   BOOLEAN    PageAsPool;
+  POOL_SLAB  *Slab;
 
   ASSERT (Buffer != NULL);
+
+  //
+  // Slab objects have no pool head, their page is looked up in the slab hash
+  //
+  if (PcdGetBool (PcdDxePoolSlabAllocator)) {
+    Slab = CoreLookupPoolSlab (Buffer);
+    if (Slab != NULL) {
+      return CoreFreePoolSlab (Slab, Buffer, PoolType);
+    }
+  }
+
   //
   // Get the head & tail of the pool entry
   //
@@ -880,3 +1221,40 @@ CoreFreePoolI (
 
   return EFI_SUCCESS;
 }
+
+/**
+  Retrieve the slab pool allocator statistics.
+
+  @param  Statistics             The buffer to receive a POOL_STATISTICS record
+                                 followed by one POOL_SIZE_CLASS record for each
+                                 slab size class. May be NULL to query the size.
+
+  @return The size in bytes of the statistics records, or 0 if the slab pool
+          allocator is disabled.
+
+**/
+UINTN
+CoreGetPoolStatistics (
+  OUT MEMORY_PROFILE_POOL_STATISTICS  *Statistics OPTIONAL
+  )
+{
+  if (!PcdGetBool (PcdDxePoolSlabAllocator)) {
+    return 0;
+  }
+
+  if (Statistics != NULL) {
+    Statistics->Header.Signature = MEMORY_PROFILE_POOL_STATISTICS_SIGNATURE;
+    Statistics->Header.Length    = sizeof (MEMORY_PROFILE_POOL_STATISTICS);
+    Statistics->Header.Revision  = MEMORY_PROFILE_POOL_STATISTICS_REVISION;
+    Statistics->SizeClassCount   = POOL_SLAB_CLASS_COUNT;
+    ZeroMem (Statistics->Reserved, sizeof (Statistics->Reserved));
+
+    CoreAcquireLock (&mPoolMemoryLock);
+    Statistics->CurrentSlabPages = mPoolSlabPages;
+    Statistics->PeakSlabPages    = mPoolSlabPeakPages;
+    CopyMem (Statistics + 1, mPoolSlabStatistics, sizeof (mPoolSlabStatistics));
+    CoreReleaseLock (&mPoolMemoryLock);
+  }
+
+  return sizeof (MEMORY_PROFILE_POOL_STATISTICS) + sizeof (mPoolSlabStatistics);
+}
@@ -72,16 +72,20 @@ typedef struct {
   CR (Node, CORE_SECTION_STREAM_NODE, Link, CORE_SECTION_STREAM_SIGNATURE)
 
 typedef struct {
-  UINT32        Signature;
-  LIST_ENTRY    Link;
-  UINTN         StreamHandle;
-  UINT8         *StreamBuffer;
-  UINTN         StreamLength;
-  LIST_ENTRY    Children;
+  UINT32                   Signature;
+  LIST_ENTRY               Link;
+  UINTN                    StreamHandle;
+  UINT8                    *StreamBuffer;
+  UINTN                    StreamLength;
+  LIST_ENTRY               Children;
   //
   // Authentication status is from GUIDed encapsulations.
   //
-  UINT32        AuthenticationStatus;
+  UINT32                   AuthenticationStatus;
+  //
+  // Where the stream lives in its FFS file, for the parallel decode lookups.
+  //
+  CORE_SECTION_LOCATION    Location;
 } CORE_SECTION_STREAM_NODE;
 
 #define NULL_STREAM_HANDLE  0
@@ -385,6 +389,7 @@ OpenSectionStreamEx (
   NewStream->StreamLength = SectionStreamLength;
   InitializeListHead (&NewStream->Children);
   NewStream->AuthenticationStatus = AuthenticationStatus;
+  ZeroMem (&NewStream->Location, sizeof (NewStream->Location));
 
   //
   // Add new stream to stream list
@@ -684,6 +689,9 @@ CreateChildNode (
   UINT32                                  UncompressedLength;
   UINT8                                   CompressionType;
   UINT16                                  GuidedSectionAttributes;
+  UINT16                                  GuidedSectionDataOffset;
+  CORE_SECTION_LOCATION                   Location;
+  CORE_SECTION_LOCATION                   NewStreamLocation;
 
   CORE_SECTION_CHILD_NODE  *Node;
 
@@ -833,23 +841,53 @@ CreateChildNode (
       if (IS_SECTION2 (GuidedHeader)) {
         Node->EncapsulationGuid = &(((EFI_GUID_DEFINED_SECTION2 *)GuidedHeader)->SectionDefinitionGuid);
         GuidedSectionAttributes = ((EFI_GUID_DEFINED_SECTION2 *)GuidedHeader)->Attributes;
+        GuidedSectionDataOffset = ((EFI_GUID_DEFINED_SECTION2 *)GuidedHeader)->DataOffset;
       } else {
         Node->EncapsulationGuid = &GuidedHeader->SectionDefinitionGuid;
         GuidedSectionAttributes = GuidedHeader->Attributes;
+        GuidedSectionDataOffset = GuidedHeader->DataOffset;
+      }
+
+      //
+      // The stream of a section that does not require processing is the data
+      // of the section, so it keeps the location in the file. The stream of a
+      // section that is decoded here is not known to the parallel decode.
+      //
+      CopyMem (&Location, &Stream->Location, sizeof (Location));
+      Location.Offset += ChildOffset;
+      ZeroMem (&NewStreamLocation, sizeof (NewStreamLocation));
+      if ((Location.FvHandle != NULL) && ((GuidedSectionAttributes & EFI_GUIDED_SECTION_PROCESSING_REQUIRED) == 0)) {
+        CopyMem (&NewStreamLocation, &Location, sizeof (NewStreamLocation));
+        NewStreamLocation.Offset += GuidedSectionDataOffset;
       }
 
       if (VerifyGuidedSectionGuid (Node->EncapsulationGuid, &GuidedExtraction)) {
         //
         // NewStreamBuffer is always allocated by ExtractSection... No caller
-        // allocation here.
+        // allocation here. The dispatcher may already have decoded the section
+        // on an AP through the same ExtractGuidedSectionLib handler.
         //
-        Status = GuidedExtraction->ExtractSection (
-                                     GuidedExtraction,
-                                     GuidedHeader,
-                                     &NewStreamBuffer,
-                                     &NewStreamBufferSize,
-                                     &AuthenticationStatus
-                                     );
+        if ((GuidedExtraction == &mCustomGuidedSectionExtractionProtocol) &&
+            CoreGetParallelDecodedSection (
+              &Location,
+              GuidedHeader,
+              &NewStreamBuffer,
+              &NewStreamBufferSize,
+              &AuthenticationStatus,
+              &NewStreamLocation
+              ))
+        {
+          Status = EFI_SUCCESS;
+        } else {
+          Status = GuidedExtraction->ExtractSection (
+                                       GuidedExtraction,
+                                       GuidedHeader,
+                                       &NewStreamBuffer,
+                                       &NewStreamBufferSize,
+                                       &AuthenticationStatus
+                                       );
+        }
+
         if (EFI_ERROR (Status)) {
           CoreFreePool (*ChildNode);
           return EFI_PROTOCOL_ERROR;
@@ -884,6 +922,12 @@ CreateChildNode (
           CoreFreePool (NewStreamBuffer);
           return Status;
         }
+
+        CopyMem (
+          &((CORE_SECTION_STREAM_NODE *)Node->EncapsulatedStreamHandle)->Location,
+          &NewStreamLocation,
+          sizeof (NewStreamLocation)
+          );
       } else {
         //
         // There's no GUIDed section extraction protocol available.
@@ -926,6 +970,12 @@ CreateChildNode (
             CoreFreePool (Node);
             return Status;
           }
+
+          CopyMem (
+            &((CORE_SECTION_STREAM_NODE *)Node->EncapsulatedStreamHandle)->Location,
+            &NewStreamLocation,
+            sizeof (NewStreamLocation)
+            );
         }
       }
 
@@ -1179,6 +1229,35 @@ FindStreamNode (
   return EFI_NOT_FOUND;
 }
 
+/**
+  Record the FFS file a section stream was opened on, so that the sections
+  decoded ahead of time by the dispatcher can be found while the stream is
+  parsed.
+
+  @param  SectionStreamHandle    The stream opened on the data of the file.
+  @param  FvHandle               The handle of the FV that holds the file.
+  @param  FileName               The name of the file.
+
+**/
+VOID
+CoreSetSectionStreamFile (
+  IN UINTN           SectionStreamHandle,
+  IN EFI_HANDLE      FvHandle,
+  IN CONST EFI_GUID  *FileName
+  )
+{
+  CORE_SECTION_STREAM_NODE  *StreamNode;
+
+  if (EFI_ERROR (FindStreamNode (SectionStreamHandle, &StreamNode))) {
+    return;
+  }
+
+  StreamNode->Location.FvHandle = FvHandle;
+  CopyGuid (&StreamNode->Location.FileName, FileName);
+  StreamNode->Location.Parent = 0;
+  StreamNode->Location.Offset = 0;
+}
+
 /**
   SEP member function.  Retrieves requested section from section stream.
 
@@ -0,0 +1,818 @@
+/** @file
+  Host-based unit test of the DXE dispatcher parallel section decode.
+
+  Dispatcher/ParallelDecode.c is linked against an MP Services protocol that
+  reports a single processor, or that starts APs which never claim a job, so
+  every section is decoded by ParallelDecodeWorker() on the BSP. The
+  ExtractGuidedSectionLib decode handler is replaced by an XOR transform on the
+  LZMA custom decompress GUID, so the tests can build the FFS files in memory
+  and check which section each decoded buffer is handed out for.
+
+  Copyright (c) 2026, Intel Corporation. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+
+#include "DxeMain.h"
+
+#include <Library/UnitTestLib.h>
+
+#define UNIT_TEST_APP_NAME     "DXE Core Parallel Decode Unit Tests"
+#define UNIT_TEST_APP_VERSION  "1.0"
+
+#define TEST_FILE_SIZE      512
+#define TEST_PAYLOAD_SIZE   64
+#define TEST_ENCODE_KEY     0xA5
+#define TEST_SCRATCH_SIZE   0x10
+#define TEST_MAX_DRIVERS    3
+
+typedef struct {
+  EFI_GUID    Name;
+  UINT8       Data[TEST_FILE_SIZE];
+  UINTN       Size;
+} TEST_FFS_FILE;
+
+//
+// A GUID defined section that does not require processing, so the sections
+// inside it are decoded in place.
+//
+EFI_GUID  mTestWrapperGuid = {
+  0x3c7e5a12, 0x8d41, 0x4f0b, { 0x96, 0x2e, 0x1a, 0x5c, 0x7d, 0x84, 0xb3, 0x60 }
+};
+
+EFI_HANDLE  mTestFvHandle      = (EFI_HANDLE)(UINTN)0x1000;
+EFI_HANDLE  mTestOtherFvHandle = (EFI_HANDLE)(UINTN)0x2000;
+
+TEST_FFS_FILE  mTestFiles[TEST_MAX_DRIVERS] = {
+  { { 0x0a1b2c3d, 0x1111, 0x4a4a, { 0x80, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07 } }, { 0 }, 0 },
+  { { 0x0a1b2c3d, 0x2222, 0x4a4a, { 0x80, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07 } }, { 0 }, 0 },
+  { { 0x5e6f7081, 0x3333, 0x4b4b, { 0x90, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17 } }, { 0 }, 0 }
+};
+
+EFI_CORE_DRIVER_ENTRY  mTestDrivers[TEST_MAX_DRIVERS];
+LIST_ENTRY             mTestScheduledQueue;
+
+UINTN       mTestDecodeCount;
+UINTN       mTestDecodeProcessorMask;
+EFI_STATUS  mTestStartupAllApsStatus;
+UINTN       mTestStartupAllApsCount;
+UINTN       mTestCheckEventCount;
+UINT64      mTestTicks;
+
+/**
+  Stub of the timer library. The ticks only need to increase.
+
+  @return The next tick.
+
+**/
+UINT64
+EFIAPI
+GetPerformanceCounter (
+  VOID
+  )
+{
+  return ++mTestTicks;
+}
+
+/**
+  Report which processor is running. The host test only has the BSP.
+
+  @param  This                  A pointer to the EFI_MP_SERVICES_PROTOCOL instance.
+  @param  ProcessorNumber       The number of the processor.
+
+  @retval EFI_SUCCESS           The current processor number was returned.
+
+**/
+EFI_STATUS
+EFIAPI
+TestWhoAmI (
+  IN  EFI_MP_SERVICES_PROTOCOL  *This,
+  OUT UINTN                     *ProcessorNumber
+  )
+{
+  *ProcessorNumber = 0;
+  return EFI_SUCCESS;
+}
+
+/**
+  Stub of StartupAllAPs(). It returns mTestStartupAllApsStatus and, on
+  success, leaves every job to the BSP as if the APs were slow to start.
+
+  @retval mTestStartupAllApsStatus
+
+**/
+EFI_STATUS
+EFIAPI
+TestStartupAllAps (
+  IN  EFI_MP_SERVICES_PROTOCOL  *This,
+  IN  EFI_AP_PROCEDURE          Procedure,
+  IN  BOOLEAN                   SingleThread,
+  IN  EFI_EVENT                 WaitEvent               OPTIONAL,
+  IN  UINTN                     TimeoutInMicroSeconds,
+  IN  VOID                      *ProcedureArgument      OPTIONAL,
+  OUT UINTN                     **FailedCpuList         OPTIONAL
+  )
+{
+  mTestStartupAllApsCount++;
+  return mTestStartupAllApsStatus;
+}
+
+EFI_MP_SERVICES_PROTOCOL  mTestMpServices = {
+  NULL,
+  NULL,
+  TestStartupAllAps,
+  NULL,
+  NULL,
+  NULL,
+  TestWhoAmI
+};
+
+/**
+  Stub of the DXE core protocol database, which only holds the MP Services
+  protocol.
+
+  @param  Protocol              The requested protocol.
+  @param  Registration          Unused.
+  @param  Interface             The protocol interface.
+
+  @retval EFI_SUCCESS           The MP Services protocol was returned.
+  @retval EFI_NOT_FOUND         Any other protocol was requested.
+
+**/
+EFI_STATUS
+EFIAPI
+CoreLocateProtocol (
+  IN  EFI_GUID  *Protocol,
+  IN  VOID      *Registration OPTIONAL,
+  OUT VOID      **Interface
+  )
+{
+  if (!CompareGuid (Protocol, &gEfiMpServiceProtocolGuid)) {
+    return EFI_NOT_FOUND;
+  }
+
+  *Interface = &mTestMpServices;
+  return EFI_SUCCESS;
+}
+
+/**
+  Stub of the DXE core event services.
+
+  @retval EFI_SUCCESS           A dummy event was returned.
+
+**/
+EFI_STATUS
+EFIAPI
+CoreCreateEvent (
+  IN UINT32            Type,
+  IN EFI_TPL           NotifyTpl,
+  IN EFI_EVENT_NOTIFY  NotifyFunction  OPTIONAL,
+  IN VOID              *NotifyContext  OPTIONAL,
+  OUT EFI_EVENT        *Event
+  )
+{
+  *Event = (EFI_EVENT)&mTestCheckEventCount;
+  return EFI_SUCCESS;
+}
+
+/**
+  Stub of the DXE core event services. The APs are always done.
+
+  @retval EFI_SUCCESS           The event is signaled.
+
+**/
+EFI_STATUS
+EFIAPI
+CoreCheckEvent (
+  IN EFI_EVENT  UserEvent
+  )
+{
+  mTestCheckEventCount++;
+  return EFI_SUCCESS;
+}
+
+/**
+  Fake ExtractGuidedSectionLib handler. Sections with the LZMA custom
+  decompress GUID hold their output XORed with TEST_ENCODE_KEY.
+
+  @param  InputSection          The GUID defined section.
+  @param  OutputBufferSize      The size of the decoded data.
+  @param  ScratchBufferSize     The size of the scratch buffer.
+  @param  SectionAttribute      The attributes of the section.
+
+  @retval RETURN_SUCCESS        The information was returned.
+  @retval RETURN_UNSUPPORTED    The section does not use the LZMA GUID.
+
+**/
+RETURN_STATUS
+EFIAPI
+ExtractGuidedSectionGetInfo (
+  IN  CONST VOID  *InputSection,
+  OUT       UINT32  *OutputBufferSize,
+  OUT       UINT32  *ScratchBufferSize,
+  OUT       UINT16  *SectionAttribute
+  )
+{
+  CONST EFI_GUID_DEFINED_SECTION  *Section;
+
+  Section = InputSection;
+  if (!CompareGuid (&Section->SectionDefinitionGuid, &gLzmaCustomDecompressGuid)) {
+    return RETURN_UNSUPPORTED;
+  }
+
+  *OutputBufferSize  = SECTION_SIZE (Section) - Section->DataOffset;
+  *ScratchBufferSize = TEST_SCRATCH_SIZE;
+  *SectionAttribute  = Section->Attributes;
+  return RETURN_SUCCESS;
+}
+
+/**
+  Fake ExtractGuidedSectionLib handler, see ExtractGuidedSectionGetInfo().
+
+  @param  InputSection          The GUID defined section.
+  @param  OutputBuffer          The buffer that receives the decoded data.
+  @param  ScratchBuffer         The scratch buffer.
+  @param  AuthenticationStatus  The authentication status.
+
+  @retval RETURN_SUCCESS        The section was decoded.
+
+**/
+RETURN_STATUS
+EFIAPI
+ExtractGuidedSectionDecode (
+  IN  CONST VOID  *InputSection,
+  OUT       VOID  **OutputBuffer,
+  IN        VOID  *ScratchBuffer  OPTIONAL,
+  OUT       UINT32  *AuthenticationStatus
+  )
+{
+  CONST EFI_GUID_DEFINED_SECTION  *Section;
+  CONST UINT8                     *Data;
+  UINT8                           *Output;
+  UINTN                           Index;
+  UINTN                           ProcessorNumber;
+
+  Section = InputSection;
+  Data    = (CONST UINT8 *)Section + Section->DataOffset;
+  Output  = *OutputBuffer;
+  for (Index = 0; Index < SECTION_SIZE (Section) - Section->DataOffset; Index++) {
+    Output[Index] = Data[Index] ^ TEST_ENCODE_KEY;
+  }
+
+  TestWhoAmI (&mTestMpServices, &ProcessorNumber);
+  mTestDecodeProcessorMask |= LShiftU64 (1, ProcessorNumber);
+  mTestDecodeCount++;
+  *AuthenticationStatus = 0;
+  return RETURN_SUCCESS;
+}
+
+/**
+  Set the size of a section with a common section header.
+
+  @param  Header                The section header.
+  @param  Size                  The size of the section, including the header.
+
+**/
+STATIC
+VOID
+TestSetSectionSize (
+  OUT EFI_COMMON_SECTION_HEADER  *Header,
+  IN  UINT32                     Size
+  )
+{
+  Header->Size[0] = (UINT8)Size;
+  Header->Size[1] = (UINT8)(Size >> 8);
+  Header->Size[2] = (UINT8)(Size >> 16);
+}
+
+/**
+  Append a leaf section to a section stream.
+
+  @param  Stream                The section stream.
+  @param  Offset                The end of the stream, updated on return.
+  @param  Type                  The section type.
+  @param  Fill                  The byte the payload is filled with.
+  @param  PayloadSize           The size of the payload.
+
+  @return The offset of the new section.
+
+**/
+STATIC
+UINT32
+TestAppendLeafSection (
+  IN OUT UINT8   *Stream,
+  IN OUT UINT32  *Offset,
+  IN     UINT8   Type,
+  IN     UINT8   Fill,
+  IN     UINT32  PayloadSize
+  )
+{
+  EFI_COMMON_SECTION_HEADER  *Header;
+  UINT32                     SectionOffset;
+
+  SectionOffset = ALIGN_VALUE (*Offset, 4);
+  Header        = (EFI_COMMON_SECTION_HEADER *)(Stream + SectionOffset);
+  Header->Type  = Type;
+  TestSetSectionSize (Header, sizeof (EFI_COMMON_SECTION_HEADER) + PayloadSize);
+  SetMem (Header + 1, PayloadSize, Fill);
+  *Offset = SectionOffset + sizeof (EFI_COMMON_SECTION_HEADER) + PayloadSize;
+  return SectionOffset;
+}
+
+/**
+  Append a GUID defined section that holds a section stream.
+
+  @param  Stream                The section stream.
+  @param  Offset                The end of the stream, updated on return.
+  @param  Guid                  The section definition GUID.
+  @param  Inner                 The section stream to encapsulate.
+  @param  InnerSize             The size of Inner.
+
+  @return The offset of the new section.
+
+**/
+STATIC
+UINT32
+TestAppendGuidedSection (
+  IN OUT UINT8           *Stream,
+  IN OUT UINT32          *Offset,
+  IN     CONST EFI_GUID  *Guid,
+  IN     CONST UINT8     *Inner,
+  IN     UINT32          InnerSize
+  )
+{
+  EFI_GUID_DEFINED_SECTION  *Section;
+  UINT32                    SectionOffset;
+  UINT8                     *Data;
+  UINT32                    Index;
+
+  SectionOffset = ALIGN_VALUE (*Offset, 4);
+  Section       = (EFI_GUID_DEFINED_SECTION *)(Stream + SectionOffset);
+  CopyGuid (&Section->SectionDefinitionGuid, Guid);
+  Section->DataOffset = sizeof (EFI_GUID_DEFINED_SECTION);
+  Data                = (UINT8 *)(Section + 1);
+  if (CompareGuid (Guid, &gLzmaCustomDecompressGuid)) {
+    Section->Attributes = EFI_GUIDED_SECTION_PROCESSING_REQUIRED;
+    for (Index = 0; Index < InnerSize; Index++) {
+      Data[Index] = Inner[Index] ^ TEST_ENCODE_KEY;
+    }
+  } else {
+    Section->Attributes = EFI_GUIDED_SECTION_AUTH_STATUS_VALID;
+    CopyMem (Data, Inner, InnerSize);
+  }
+
+  Section->CommonHeader.Type = EFI_SECTION_GUID_DEFINED;
+  TestSetSectionSize (&Section->CommonHeader, sizeof (EFI_GUID_DEFINED_SECTION) + InnerSize);
+  *Offset = SectionOffset + sizeof (EFI_GUID_DEFINED_SECTION) + InnerSize;
+  return SectionOffset;
+}
+
+/**
+  Stub of the FV ReadFile() service on the in-memory test files.
+
+  @retval EFI_SUCCESS           A pool copy of the file was returned.
+  @retval EFI_NOT_FOUND         No test file has that name.
+
+**/
+EFI_STATUS
+EFIAPI
+TestReadFile (
+  IN CONST  EFI_FIRMWARE_VOLUME2_PROTOCOL  *This,
+  IN CONST  EFI_GUID                       *NameGuid,
+  IN OUT    VOID                           **Buffer,
+  IN OUT    UINTN                          *BufferSize,
+  OUT       EFI_FV_FILETYPE                *FoundType,
+  OUT       EFI_FV_FILE_ATTRIBUTES         *FileAttributes,
+  OUT       UINT32                         *AuthenticationStatus
+  )
+{
+  UINTN  Index;
+
+  for (Index = 0; Index < TEST_MAX_DRIVERS; Index++) {
+    if (CompareGuid (NameGuid, &mTestFiles[Index].Name)) {
+      *Buffer               = AllocateCopyPool (mTestFiles[Index].Size, mTestFiles[Index].Data);
+      *BufferSize           = mTestFiles[Index].Size;
+      *FoundType            = EFI_FV_FILETYPE_DRIVER;
+      *FileAttributes       = 0;
+      *AuthenticationStatus = 0;
+      return (*Buffer == NULL) ? EFI_OUT_OF_RESOURCES : EFI_SUCCESS;
+    }
+  }
+
+  return EFI_NOT_FOUND;
+}
+
+EFI_FIRMWARE_VOLUME2_PROTOCOL  mTestFv;
+
+//
+// Offsets of the compressed sections in the test files.
+//
+UINT32  mTestFileACompressedOffset;
+UINT32  mTestFileCOuterOffset;
+UINT32  mTestFileCInnerOffset;
+
+/**
+  Build the test files and put the drivers on the scheduled queue.
+
+  File 0 and file 1 have the same contents: a RAW section and an LZMA section
+  around a PE32 section filled with 0x11. File 2 has a GUID defined section
+  that does not require processing around an LZMA section, whose output holds
+  a RAW section and another LZMA section around a PE32 section filled with
+  0x33.
+
+  @param  DriverCount           The number of drivers to schedule.
+
+**/
+STATIC
+VOID
+TestScheduleDrivers (
+  IN UINTN  DriverCount
+  )
+{
+  UINT8   Inner[TEST_FILE_SIZE];
+  UINT8   Outer[TEST_FILE_SIZE];
+  UINT32  InnerSize;
+  UINT32  OuterSize;
+  UINT32  Size;
+  UINTN   Index;
+
+  ZeroMem (&mTestFv, sizeof (mTestFv));
+  mTestFv.ReadFile = TestReadFile;
+
+  InnerSize = 0;
+  TestAppendLeafSection (Inner, &InnerSize, EFI_SECTION_PE32, 0x11, TEST_PAYLOAD_SIZE);
+  Size = 0;
+  TestAppendLeafSection (mTestFiles[0].Data, &Size, EFI_SECTION_RAW, 0xEE, 5);
+  mTestFileACompressedOffset = TestAppendGuidedSection (mTestFiles[0].Data, &Size, &gLzmaCustomDecompressGuid, Inner, InnerSize);
+  mTestFiles[0].Size         = Size;
+  CopyMem (mTestFiles[1].Data, mTestFiles[0].Data, Size);
+  mTestFiles[1].Size = Size;
+
+  InnerSize = 0;
+  TestAppendLeafSection (Inner, &InnerSize, EFI_SECTION_PE32, 0x33, TEST_PAYLOAD_SIZE);
+  OuterSize = 0;
+  TestAppendLeafSection (Outer, &OuterSize, EFI_SECTION_RAW, 0xDD, 9);
+  mTestFileCInnerOffset = TestAppendGuidedSection (Outer, &OuterSize, &gLzmaCustomDecompressGuid, Inner, InnerSize);
+  InnerSize             = 0;
+  TestAppendGuidedSection (Inner, &InnerSize, &gLzmaCustomDecompressGuid, Outer, OuterSize);
+  Size = 0;
+  TestAppendGuidedSection (mTestFiles[2].Data, &Size, &mTestWrapperGuid, Inner, InnerSize);
+  mTestFileCOuterOffset = sizeof (EFI_GUID_DEFINED_SECTION);
+  mTestFiles[2].Size    = Size;
+
+  InitializeListHead (&mTestScheduledQueue);
+  for (Index = 0; Index < DriverCount; Index++) {
+    ZeroMem (&mTestDrivers[Index], sizeof (mTestDrivers[Index]));
+    mTestDrivers[Index].Signature = EFI_CORE_DRIVER_ENTRY_SIGNATURE;
+    mTestDrivers[Index].FvHandle  = mTestFvHandle;
+    mTestDrivers[Index].Fv        = &mTestFv;
+    CopyGuid (&mTestDrivers[Index].FileName, &mTestFiles[Index].Name);
+    InsertTailList (&mTestScheduledQueue, &mTestDrivers[Index].ScheduledLink);
+  }
+
+  mTestDecodeCount         = 0;
+  mTestDecodeProcessorMask = 0;
+  mTestStartupAllApsCount  = 0;
+  mTestCheckEventCount     = 0;
+}
+
+/**
+  Look up the decoded copy of a section of a test file.
+
+  @param  FvHandle              The FV handle of the location.
+  @param  FileIndex             The test file of the location.
+  @param  Parent                The parent instance of the location.
+  @param  Offset                The offset of the location.
+  @param  Section               The section being extracted.
+  @param  OutputBuffer          The decoded data.
+  @param  OutputLocation        The location of the decoded data.
+
+  @return The value returned by CoreGetParallelDecodedSection().
+
+**/
+STATIC
+BOOLEAN
+TestGetDecodedSection (
+  IN  EFI_HANDLE             FvHandle,
+  IN  UINTN                  FileIndex,
+  IN  UINT32                 Parent,
+  IN  UINT32                 Offset,
+  IN  CONST VOID             *Section,
+  OUT VOID                   **OutputBuffer,
+  OUT CORE_SECTION_LOCATION  *OutputLocation
+  )
+{
+  CORE_SECTION_LOCATION  Location;
+  UINTN                  OutputSize;
+  UINT32                 AuthenticationStatus;
+
+  Location.FvHandle = FvHandle;
+  CopyGuid (&Location.FileName, &mTestFiles[FileIndex].Name);
+  Location.Parent = Parent;
+  Location.Offset = Offset;
+
+  *OutputBuffer = NULL;
+  return CoreGetParallelDecodedSection (
+           &Location,
+           Section,
+           OutputBuffer,
+           &OutputSize,
+           &AuthenticationStatus,
+           OutputLocation
+           );
+}
+
+/**
+  Check that a decoded buffer holds a PE32 section filled with Fill at Offset.
+
+  @param  Buffer                The decoded buffer.
+  @param  Offset                The offset of the PE32 section.
+  @param  Fill                  The expected payload byte.
+
+  @retval TRUE                  The buffer holds the expected section.
+
+**/
+STATIC
+BOOLEAN
+TestIsPe32Section (
+  IN CONST UINT8  *Buffer,
+  IN UINT32       Offset,
+  IN UINT8        Fill
+  )
+{
+  CONST EFI_COMMON_SECTION_HEADER  *Header;
+  UINTN                            Index;
+
+  Header = (CONST EFI_COMMON_SECTION_HEADER *)(Buffer + Offset);
+  if ((Header->Type != EFI_SECTION_PE32) || (SECTION_SIZE (Header) != sizeof (*Header) + TEST_PAYLOAD_SIZE)) {
+    return FALSE;
+  }
+
+  for (Index = 0; Index < TEST_PAYLOAD_SIZE; Index++) {
+    if (((CONST UINT8 *)(Header + 1))[Index] != Fill) {
+      return FALSE;
+    }
+  }
+
+  return TRUE;
+}
+
+/**
+  Run a pass over three drivers and check that every section is decoded on
+  the BSP and handed out once, for its own file and location only.
+
+  @retval UNIT_TEST_PASSED      The decoded sections were found as expected.
+
+**/
+STATIC
+UNIT_TEST_STATUS
+TestDecodeAndLookup (
+  VOID
+  )
+{
+  VOID                   *BufferA;
+  VOID                   *BufferB;
+  VOID                   *BufferOuter;
+  VOID                   *BufferInner;
+  VOID                   *Unused;
+  CORE_SECTION_LOCATION  LocationA;
+  CORE_SECTION_LOCATION  LocationB;
+  CORE_SECTION_LOCATION  LocationOuter;
+  CORE_SECTION_LOCATION  LocationInner;
+  CONST UINT8            *SectionA;
+  CONST UINT8            *SectionOuter;
+  CONST UINT8            *SectionInner;
+
+  CoreParallelDecodeScheduledDrivers (&mTestScheduledQueue);
+
+  //
+  // Files 0 and 1 and both levels of file 2, all on processor 0.
+  //
+  UT_ASSERT_EQUAL (mTestDecodeCount, 4);
+  UT_ASSERT_EQUAL (mTestDecodeProcessorMask, 1);
+
+  SectionA     = mTestFiles[0].Data + mTestFileACompressedOffset;
+  SectionOuter = mTestFiles[2].Data + mTestFileCOuterOffset;
+
+  //
+  // The wrong FV, parent or offset does not find the section.
+  //
+  UT_ASSERT_FALSE (TestGetDecodedSection (mTestOtherFvHandle, 0, 0, mTestFileACompressedOffset, SectionA, &Unused, &LocationA));
+  UT_ASSERT_FALSE (TestGetDecodedSection (mTestFvHandle, 0, 1, mTestFileACompressedOffset, SectionA, &Unused, &LocationA));
+  UT_ASSERT_FALSE (TestGetDecodedSection (mTestFvHandle, 0, 0, 0, SectionA, &Unused, &LocationA));
+
+  //
+  // Files 0 and 1 have the same contents but each gets its own buffer, once.
+  //
+  UT_ASSERT_TRUE (TestGetDecodedSection (mTestFvHandle, 0, 0, mTestFileACompressedOffset, SectionA, &BufferA, &LocationA));
+  UT_ASSERT_TRUE (TestIsPe32Section (BufferA, 0, 0x11));
+  UT_ASSERT_FALSE (TestGetDecodedSection (mTestFvHandle, 0, 0, mTestFileACompressedOffset, SectionA, &Unused, &LocationA));
+
+  UT_ASSERT_TRUE (TestGetDecodedSection (mTestFvHandle, 1, 0, mTestFileACompressedOffset, SectionA, &BufferB, &LocationB));
+  UT_ASSERT_TRUE (TestIsPe32Section (BufferB, 0, 0x11));
+  UT_ASSERT_TRUE (BufferA != BufferB);
+  UT_ASSERT_TRUE (LocationA.Parent != LocationB.Parent);
+  UT_ASSERT_TRUE (LocationA.FvHandle == mTestFvHandle);
+  UT_ASSERT_TRUE (CompareGuid (&LocationB.FileName, &mTestFiles[1].Name));
+  UT_ASSERT_EQUAL (LocationB.Offset, 0);
+
+  //
+  // The nested section is found in the output of its parent.
+  //
+  UT_ASSERT_TRUE (TestGetDecodedSection (mTestFvHandle, 2, 0, mTestFileCOuterOffset, SectionOuter, &BufferOuter, &LocationOuter));
+  SectionInner = (CONST UINT8 *)BufferOuter + mTestFileCInnerOffset;
+  UT_ASSERT_FALSE (TestGetDecodedSection (mTestFvHandle, 2, 0, mTestFileCInnerOffset, SectionInner, &Unused, &LocationInner));
+  UT_ASSERT_TRUE (TestGetDecodedSection (mTestFvHandle, 2, LocationOuter.Parent, mTestFileCInnerOffset, SectionInner, &BufferInner, &LocationInner));
+  UT_ASSERT_TRUE (TestIsPe32Section (BufferInner, 0, 0x33));
+
+  FreePool (BufferA);
+  FreePool (BufferB);
+  FreePool (BufferOuter);
+  FreePool (BufferInner);
+  CoreFreeParallelDecodeResults ();
+
+  UT_ASSERT_FALSE (TestGetDecodedSection (mTestFvHandle, 1, 0, mTestFileACompressedOffset, SectionA, &Unused, &LocationA));
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  Decode a pass on a single processor system, where StartupAllAPs() fails.
+
+  @param  Context               Unused.
+
+  @retval UNIT_TEST_PASSED      The BSP decoded every section.
+
+**/
+UNIT_TEST_STATUS
+EFIAPI
+TestBspDecodesAlone (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  TestScheduleDrivers (TEST_MAX_DRIVERS);
+  mTestStartupAllApsStatus = EFI_NOT_STARTED;
+
+  if (TestDecodeAndLookup () != UNIT_TEST_PASSED) {
+    return UNIT_TEST_ERROR_TEST_FAILED;
+  }
+
+  //
+  // Two rounds, the second one for the nested section. Nothing to wait for.
+  //
+  UT_ASSERT_EQUAL (mTestStartupAllApsCount, 2);
+  UT_ASSERT_EQUAL (mTestCheckEventCount, 0);
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  Decode a pass where the APs are started but claim no job, so the BSP decodes
+  every section and then waits for the APs.
+
+  @param  Context               Unused.
+
+  @retval UNIT_TEST_PASSED      The BSP decoded every section.
+
+**/
+UNIT_TEST_STATUS
+EFIAPI
+TestBspDecodesWhileApsRun (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  TestScheduleDrivers (TEST_MAX_DRIVERS);
+  mTestStartupAllApsStatus = EFI_SUCCESS;
+
+  if (TestDecodeAndLookup () != UNIT_TEST_PASSED) {
+    return UNIT_TEST_ERROR_TEST_FAILED;
+  }
+
+  UT_ASSERT_EQUAL (mTestStartupAllApsCount, 2);
+  UT_ASSERT_EQUAL (mTestCheckEventCount, 2);
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  A pass with a single compressed section is left to CoreLoadImage().
+
+  @param  Context               Unused.
+
+  @retval UNIT_TEST_PASSED      Nothing was decoded ahead of time.
+
+**/
+UNIT_TEST_STATUS
+EFIAPI
+TestSingleSectionIsNotDecoded (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  VOID                   *Buffer;
+  CORE_SECTION_LOCATION  Location;
+
+  TestScheduleDrivers (1);
+  mTestStartupAllApsStatus = EFI_SUCCESS;
+
+  CoreParallelDecodeScheduledDrivers (&mTestScheduledQueue);
+
+  UT_ASSERT_EQUAL (mTestDecodeCount, 0);
+  UT_ASSERT_EQUAL (mTestStartupAllApsCount, 0);
+  UT_ASSERT_FALSE (
+    TestGetDecodedSection (
+      mTestFvHandle,
+      0,
+      0,
+      mTestFileACompressedOffset,
+      mTestFiles[0].Data + mTestFileACompressedOffset,
+      &Buffer,
+      &Location
+      )
+    );
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  Initialize the unit test framework, suite, and unit tests for the parallel
+  decode and run them.
+
+  @retval  EFI_SUCCESS           All test cases were dispatched.
+  @retval  EFI_OUT_OF_RESOURCES  There are not enough resources available to
+                                 initialize the unit tests.
+**/
+STATIC
+EFI_STATUS
+EFIAPI
+UnitTestingEntry (
+  VOID
+  )
+{
+  EFI_STATUS                  Status;
+  UNIT_TEST_FRAMEWORK_HANDLE  Framework;
+  UNIT_TEST_SUITE_HANDLE      DecodeTests;
+
+  Framework = NULL;
+
+  DEBUG ((DEBUG_INFO, "%a v%a\n", UNIT_TEST_APP_NAME, UNIT_TEST_APP_VERSION));
+
+  Status = InitUnitTestFramework (&Framework, UNIT_TEST_APP_NAME, gEfiCallerBaseName, UNIT_TEST_APP_VERSION);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "Failed in InitUnitTestFramework. Status = %r\n", Status));
+    goto EXIT;
+  }
+
+  Status = CreateUnitTestSuite (&DecodeTests, Framework, "Parallel Decode Tests", "Core.Dxe.ParallelDecode", NULL, NULL);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "Failed in CreateUnitTestSuite for Parallel Decode Tests\n"));
+    Status = EFI_OUT_OF_RESOURCES;
+    goto EXIT;
+  }
+
+  //
+  // --------------Suite---------Description---------------------------------------Name------------------Function-----------------------Pre---Post---Context-----
+  //
+  AddTestCase (DecodeTests, "BSP decodes alone on a single processor", "BspAlone", TestBspDecodesAlone, NULL, NULL, NULL);
+  AddTestCase (DecodeTests, "BSP decodes while the APs run", "BspWhileApsRun", TestBspDecodesWhileApsRun, NULL, NULL, NULL);
+  AddTestCase (DecodeTests, "Single section is left to LoadImage", "SingleSection", TestSingleSectionIsNotDecoded, NULL, NULL, NULL);
+
+  //
+  // Execute the tests.
+  //
+  Status = RunAllTestSuites (Framework);
+
+EXIT:
+  if (Framework) {
+    FreeUnitTestFramework (Framework);
+  }
+
+  return Status;
+}
+
+///
+/// Avoid ECC error for function name that starts with lower case letter
+///
+#define ParallelDecodeUnitTestMain  main
+
+/**
+  Standard POSIX C entry point for host based unit test execution.
+
+  @param[in] Argc  Number of arguments
+  @param[in] Argv  Array of pointers to arguments
+
+  @retval 0      Success
+  @retval other  Error
+**/
+INT32
+ParallelDecodeUnitTestMain (
+  IN INT32  Argc,
+  IN CHAR8  *Argv[]
+  )
+{
+  UnitTestingEntry ();
+  return 0;
+}
@@ -0,0 +1,652 @@
+/** @file
+  Host-based unit test and benchmark of the DXE core pool allocator.
+
+  Mem/Pool.c is linked against a page allocator backed by the host heap, with
+  heap guard and memory protection disabled, so the slab and binned pool
+  engines can be exercised side by side.
+
+  Copyright (c) 2026, Intel Corporation. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <time.h>
+#include <cmocka.h>
+
+#include "DxeMain.h"
+#include "Imem.h"
+#include "HeapGuard.h"
+
+#include <Library/UnitTestLib.h>
+
+#define UNIT_TEST_APP_NAME     "DXE Core Pool Unit Tests"
+#define UNIT_TEST_APP_VERSION  "1.0"
+
+#define TEST_MAX_SLAB_SIZE     1024
+#define TEST_CHURN_LIVE_COUNT  4096
+#define TEST_CHURN_ROUNDS      400
+
+EFI_LOCK  gMemoryLock = EFI_INITIALIZE_LOCK_VARIABLE (TPL_NOTIFY);
+BOOLEAN   mOnGuarding = FALSE;
+
+UINTN  mTestPagesAllocated;
+
+VOID  *mTestBuffers[TEST_CHURN_LIVE_COUNT];
+
+/**
+  Stub of the DXE core TPL service. The host test runs at TPL_APPLICATION.
+
+  @param  NewTpl  New, higher, task priority
+
+  @return The previous task priority level
+
+**/
+EFI_TPL
+EFIAPI
+CoreRaiseTpl (
+  IN EFI_TPL  NewTpl
+  )
+{
+  return TPL_APPLICATION;
+}
+
+/**
+  Stub of the DXE core TPL service.
+
+  @param  NewTpl  New, lower, task priority
+
+**/
+VOID
+EFIAPI
+CoreRestoreTpl (
+  IN EFI_TPL  NewTpl
+  )
+{
+}
+
+/**
+  Stub of the DXE core memory lock.
+
+**/
+VOID
+CoreAcquireMemoryLock (
+  VOID
+  )
+{
+  CoreAcquireLock (&gMemoryLock);
+}
+
+/**
+  Stub of the DXE core memory lock.
+
+**/
+VOID
+CoreReleaseMemoryLock (
+  VOID
+  )
+{
+  CoreReleaseLock (&gMemoryLock);
+}
+
+/**
+  Page allocator backed by the host heap.
+
+  @param  PoolType               The type of memory for the new pool pages
+  @param  NumberOfPages          No of pages to allocate
+  @param  Alignment              Bits to align.
+  @param  NeedGuard              Flag to indicate Guard page is needed or not
+
+  @return The allocated memory, or NULL
+
+**/
+VOID *
+CoreAllocatePoolPages (
+  IN EFI_MEMORY_TYPE  PoolType,
+  IN UINTN            NumberOfPages,
+  IN UINTN            Alignment,
+  IN BOOLEAN          NeedGuard
+  )
+{
+  VOID  *Buffer;
+
+  Buffer = aligned_alloc (Alignment, EFI_PAGES_TO_SIZE (NumberOfPages));
+  if (Buffer != NULL) {
+    mTestPagesAllocated += NumberOfPages;
+  }
+
+  return Buffer;
+}
+
+/**
+  Page allocator backed by the host heap.
+
+  @param  Memory                 The base address to free
+  @param  NumberOfPages          The number of pages to free
+
+**/
+VOID
+CoreFreePoolPages (
+  IN EFI_PHYSICAL_ADDRESS  Memory,
+  IN UINTN                 NumberOfPages
+  )
+{
+  ASSERT (mTestPagesAllocated >= NumberOfPages);
+  mTestPagesAllocated -= NumberOfPages;
+  free ((VOID *)(UINTN)Memory);
+}
+
+/**
+  Stub of the heap guard service. Pool guard is disabled.
+
+  @param  MemoryType    Pool type to check.
+
+  @return FALSE
+
+**/
+BOOLEAN
+IsPoolTypeToGuard (
+  IN EFI_MEMORY_TYPE  MemoryType
+  )
+{
+  return FALSE;
+}
+
+/**
+  Stub of the heap guard service. Heap guard is disabled.
+
+  @param  GuardType   Specify the sub-type(s) of Heap Guard.
+
+  @return FALSE
+
+**/
+BOOLEAN
+IsHeapGuardEnabled (
+  UINT8  GuardType
+  )
+{
+  return FALSE;
+}
+
+/**
+  Stub of the heap guard service. No memory is guarded.
+
+  @param  Address   The address to check.
+
+  @return FALSE
+
+**/
+BOOLEAN
+EFIAPI
+IsMemoryGuarded (
+  IN EFI_PHYSICAL_ADDRESS  Address
+  )
+{
+  return FALSE;
+}
+
+/**
+  Stub of the heap guard service.
+
+  @param  Memory          Base address of memory to set guard for.
+  @param  NumberOfPages   Memory size in pages.
+
+**/
+VOID
+SetGuardForMemory (
+  IN EFI_PHYSICAL_ADDRESS  Memory,
+  IN UINTN                 NumberOfPages
+  )
+{
+}
+
+/**
+  Stub of the heap guard service.
+
+  @param  Memory          Base address of memory to unset guard for.
+  @param  NumberOfPages   Memory size in pages.
+
+**/
+VOID
+UnsetGuardForMemory (
+  IN EFI_PHYSICAL_ADDRESS  Memory,
+  IN UINTN                 NumberOfPages
+  )
+{
+}
+
+/**
+  Stub of the heap guard service.
+
+  @param  Memory          Base address of memory to free.
+  @param  NumberOfPages   Size of memory to free.
+
+**/
+VOID
+AdjustMemoryF (
+  IN OUT EFI_PHYSICAL_ADDRESS  *Memory,
+  IN OUT UINTN                 *NumberOfPages
+  )
+{
+}
+
+/**
+  Stub of the heap guard service.
+
+  @param  Memory    Base address of memory allocated.
+  @param  NoPages   Number of pages actually allocated.
+  @param  Size      Size of memory requested.
+
+  @return Memory
+
+**/
+VOID *
+AdjustPoolHeadA (
+  IN EFI_PHYSICAL_ADDRESS  Memory,
+  IN UINTN                 NoPages,
+  IN UINTN                 Size
+  )
+{
+  return (VOID *)(UINTN)Memory;
+}
+
+/**
+  Stub of the heap guard service.
+
+  @param  Memory    Base address of memory to free.
+  @param  NoPages   Number of pages actually freed.
+  @param  Size      Size of memory requested.
+
+  @return Memory
+
+**/
+VOID *
+AdjustPoolHeadF (
+  IN EFI_PHYSICAL_ADDRESS  Memory,
+  IN UINTN                 NoPages,
+  IN UINTN                 Size
+  )
+{
+  return (VOID *)(UINTN)Memory;
+}
+
+/**
+  Stub of the heap guard service.
+
+  @param  BaseAddress   Base address of just freed pages.
+  @param  Pages         Number of freed pages.
+
+**/
+VOID
+EFIAPI
+GuardFreedPagesChecked (
+  IN  EFI_PHYSICAL_ADDRESS  BaseAddress,
+  IN  UINTN                 Pages
+  )
+{
+}
+
+/**
+  Stub of the memory protection service.
+
+  @param  OldType   The old memory type.
+  @param  NewType   The new memory type.
+  @param  Memory    The base address of the memory range.
+  @param  Length    The size in bytes of the memory range.
+
+  @retval EFI_SUCCESS   Nothing to do.
+
+**/
+EFI_STATUS
+EFIAPI
+ApplyMemoryProtectionPolicy (
+  IN  EFI_MEMORY_TYPE       OldType,
+  IN  EFI_MEMORY_TYPE       NewType,
+  IN  EFI_PHYSICAL_ADDRESS  Memory,
+  IN  UINT64                Length
+  )
+{
+  return EFI_SUCCESS;
+}
+
+/**
+  Stub of the memory profile service. Memory profile is disabled.
+
+  @param  CallerAddress   Address of caller who call Allocate or Free.
+  @param  Action          This Allocate or Free action.
+  @param  MemoryType      Memory type.
+  @param  Size            Buffer size.
+  @param  Buffer          Buffer address.
+  @param  ActionString    String for memory profile action.
+
+  @retval EFI_UNSUPPORTED   Memory profile is unsupported.
+
+**/
+EFI_STATUS
+EFIAPI
+CoreUpdateProfile (
+  IN EFI_PHYSICAL_ADDRESS   CallerAddress,
+  IN MEMORY_PROFILE_ACTION  Action,
+  IN EFI_MEMORY_TYPE        MemoryType,
+  IN UINTN                  Size,
+  IN VOID                   *Buffer,
+  IN CHAR8                  *ActionString OPTIONAL
+  )
+{
+  return EFI_UNSUPPORTED;
+}
+
+/**
+  Stub of the memory attributes table service.
+
+  @param  MemoryType    EFI memory type.
+
+**/
+VOID
+InstallMemoryAttributesTableOnMemoryAllocation (
+  IN EFI_MEMORY_TYPE  MemoryType
+  )
+{
+}
+
+/**
+  Return the size class statistics record with the given object size.
+
+  @param  Statistics             The statistics returned by CoreGetPoolStatistics.
+  @param  ObjectSize             The object size of the class.
+
+  @return The size class record, or NULL.
+
+**/
+STATIC
+MEMORY_PROFILE_POOL_SIZE_CLASS *
+TestFindSizeClass (
+  IN MEMORY_PROFILE_POOL_STATISTICS  *Statistics,
+  IN UINT32                          ObjectSize
+  )
+{
+  MEMORY_PROFILE_POOL_SIZE_CLASS  *SizeClass;
+  UINTN                           Index;
+
+  SizeClass = (MEMORY_PROFILE_POOL_SIZE_CLASS *)(Statistics + 1);
+  for (Index = 0; Index < Statistics->SizeClassCount; Index++) {
+    if (SizeClass[Index].ObjectSize == ObjectSize) {
+      return &SizeClass[Index];
+    }
+  }
+
+  return NULL;
+}
+
+/**
+  Every size up to and past the largest slab class returns an aligned buffer
+  that can be written in full without disturbing its neighbours, and reports
+  the memory type it was allocated from when freed.
+
+  @param[in]  Context    Unused.
+
+  @retval  UNIT_TEST_PASSED             The test passed.
+  @retval  UNIT_TEST_ERROR_TEST_FAILED  The test failed.
+
+**/
+UNIT_TEST_STATUS
+EFIAPI
+TestAllocateFreeAllSizes (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  EFI_STATUS       Status;
+  EFI_MEMORY_TYPE  Type;
+  UINTN            Size;
+  UINTN            Index;
+  UINT8            *Buffer;
+
+  for (Size = 0; Size <= 2 * TEST_MAX_SLAB_SIZE; Size += 8) {
+    Index = Size / 8;
+    Type  = (Index % 2 == 0) ? EfiBootServicesData : EfiLoaderData;
+
+    Status = CoreInternalAllocatePool (Type, Size, (VOID **)&Buffer);
+    UT_ASSERT_NOT_EFI_ERROR (Status);
+    UT_ASSERT_EQUAL ((UINTN)Buffer & 7, 0);
+    SetMem (Buffer, Size, (UINT8)Index);
+    mTestBuffers[Index] = Buffer;
+  }
+
+  for (Size = 0; Size <= 2 * TEST_MAX_SLAB_SIZE; Size += 8) {
+    Index  = Size / 8;
+    Buffer = mTestBuffers[Index];
+    while (Size > 0 && Buffer < (UINT8 *)mTestBuffers[Index] + Size) {
+      UT_ASSERT_EQUAL (*Buffer, (UINT8)Index);
+      Buffer++;
+    }
+
+    Status = CoreInternalFreePool (mTestBuffers[Index], &Type);
+    UT_ASSERT_NOT_EFI_ERROR (Status);
+    UT_ASSERT_EQUAL (Type, (Index % 2 == 0) ? EfiBootServicesData : EfiLoaderData);
+  }
+
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  Slab allocations are accounted in the pool statistics, and slabs that drain
+  are returned to the page allocator except for one per size class.
+
+  @param[in]  Context    Unused.
+
+  @retval  UNIT_TEST_PASSED             The test passed.
+  @retval  UNIT_TEST_ERROR_TEST_FAILED  The test failed.
+
+**/
+UNIT_TEST_STATUS
+EFIAPI
+TestSlabStatistics (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  EFI_STATUS                      Status;
+  MEMORY_PROFILE_POOL_STATISTICS  *Before;
+  MEMORY_PROFILE_POOL_STATISTICS  *After;
+  MEMORY_PROFILE_POOL_SIZE_CLASS  *ClassBefore;
+  MEMORY_PROFILE_POOL_SIZE_CLASS  *ClassAfter;
+  UINTN                           StatisticsSize;
+  UINTN                           PagesBefore;
+  UINTN                           Index;
+
+  StatisticsSize = CoreGetPoolStatistics (NULL);
+  if (StatisticsSize == 0) {
+    UT_LOG_WARNING ("PcdDxePoolSlabAllocator is disabled\n");
+    return UNIT_TEST_SKIPPED;
+  }
+
+  UT_ASSERT_TRUE (StatisticsSize > sizeof (MEMORY_PROFILE_POOL_STATISTICS));
+
+  Before = AllocatePool (StatisticsSize);
+  After  = AllocatePool (StatisticsSize);
+  UT_ASSERT_NOT_NULL (Before);
+  UT_ASSERT_NOT_NULL (After);
+
+  UT_ASSERT_EQUAL (CoreGetPoolStatistics (Before), StatisticsSize);
+  UT_ASSERT_EQUAL (Before->Header.Signature, MEMORY_PROFILE_POOL_STATISTICS_SIGNATURE);
+  PagesBefore = mTestPagesAllocated;
+
+  //
+  // 40 byte requests land in the 48 byte class
+  //
+  for (Index = 0; Index < TEST_CHURN_LIVE_COUNT; Index++) {
+    Status = CoreInternalAllocatePool (EfiBootServicesData, 40, &mTestBuffers[Index]);
+    UT_ASSERT_NOT_EFI_ERROR (Status);
+  }
+
+  CoreGetPoolStatistics (After);
+  ClassBefore = TestFindSizeClass (Before, 48);
+  ClassAfter  = TestFindSizeClass (After, 48);
+  UT_ASSERT_NOT_NULL (ClassBefore);
+  UT_ASSERT_NOT_NULL (ClassAfter);
+  UT_ASSERT_EQUAL (ClassAfter->AllocationCount - ClassBefore->AllocationCount, TEST_CHURN_LIVE_COUNT);
+  UT_ASSERT_EQUAL (ClassAfter->BytesRequested - ClassBefore->BytesRequested, TEST_CHURN_LIVE_COUNT * 40);
+  UT_ASSERT_EQUAL (ClassAfter->BytesWasted - ClassBefore->BytesWasted, TEST_CHURN_LIVE_COUNT * 8);
+  UT_ASSERT_TRUE (
+    mTestPagesAllocated - PagesBefore >=
+    (TEST_CHURN_LIVE_COUNT + ClassAfter->ObjectsPerSlab - 1) / ClassAfter->ObjectsPerSlab - 1
+    );
+  UT_ASSERT_TRUE (After->PeakSlabPages >= After->CurrentSlabPages);
+
+  for (Index = 0; Index < TEST_CHURN_LIVE_COUNT; Index++) {
+    Status = CoreInternalFreePool (mTestBuffers[Index], NULL);
+    UT_ASSERT_NOT_EFI_ERROR (Status);
+  }
+
+  CoreGetPoolStatistics (After);
+  ClassAfter = TestFindSizeClass (After, 48);
+  UT_ASSERT_EQUAL (ClassAfter->FreeCount - ClassBefore->FreeCount, TEST_CHURN_LIVE_COUNT);
+  UT_ASSERT_TRUE (mTestPagesAllocated <= PagesBefore + 1);
+  UT_ASSERT_TRUE (After->CurrentSlabPages <= Before->CurrentSlabPages + 1);
+
+  FreePool (Before);
+  FreePool (After);
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  Measure a random alloc/free churn of small requests, the dominant pattern
+  of the DXE phase.
+
+  @param[in]  Context    Unused.
+
+  @retval  UNIT_TEST_PASSED             The test passed.
+  @retval  UNIT_TEST_ERROR_TEST_FAILED  The test failed.
+
+**/
+UNIT_TEST_STATUS
+EFIAPI
+TestPoolChurnThroughput (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  EFI_STATUS  Status;
+  UINTN       Round;
+  UINTN       Index;
+  UINTN       Size;
+  UINT32      Seed;
+  clock_t     Start;
+  double      Seconds;
+
+  ZeroMem (mTestBuffers, sizeof (mTestBuffers));
+  Seed  = 1;
+  Start = clock ();
+  for (Round = 0; Round < TEST_CHURN_ROUNDS; Round++) {
+    for (Index = 0; Index < TEST_CHURN_LIVE_COUNT; Index++) {
+      Seed = Seed * 1103515245 + 12345;
+      if (mTestBuffers[Index] != NULL) {
+        Status = CoreInternalFreePool (mTestBuffers[Index], NULL);
+        UT_ASSERT_NOT_EFI_ERROR (Status);
+      }
+
+      Size   = (Seed >> 16) % 512;
+      Status = CoreInternalAllocatePool (EfiBootServicesData, Size, &mTestBuffers[Index]);
+      UT_ASSERT_NOT_EFI_ERROR (Status);
+    }
+  }
+
+  Seconds = (double)(clock () - Start) / CLOCKS_PER_SEC;
+
+  for (Index = 0; Index < TEST_CHURN_LIVE_COUNT; Index++) {
+    Status = CoreInternalFreePool (mTestBuffers[Index], NULL);
+    UT_ASSERT_NOT_EFI_ERROR (Status);
+  }
+
+  UT_LOG_INFO (
+    "%d alloc/free pairs in %d ms, %d pages in use\n",
+    TEST_CHURN_ROUNDS * TEST_CHURN_LIVE_COUNT,
+    (int)(Seconds * 1000),
+    mTestPagesAllocated
+    );
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  Initialize the unit test framework, suite, and unit tests for the pool
+  allocator and run them.
+
+  @retval  EFI_SUCCESS           All test cases were dispatched.
+  @retval  EFI_OUT_OF_RESOURCES  There are not enough resources available to
+                                 initialize the unit tests.
+**/
+STATIC
+EFI_STATUS
+EFIAPI
+UnitTestingEntry (
+  VOID
+  )
+{
+  EFI_STATUS                  Status;
+  UNIT_TEST_FRAMEWORK_HANDLE  Framework;
+  UNIT_TEST_SUITE_HANDLE      PoolTests;
+
+  Framework = NULL;
+
+  DEBUG ((DEBUG_INFO, "%a v%a\n", UNIT_TEST_APP_NAME, UNIT_TEST_APP_VERSION));
+
+  Status = InitUnitTestFramework (&Framework, UNIT_TEST_APP_NAME, gEfiCallerBaseName, UNIT_TEST_APP_VERSION);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "Failed in InitUnitTestFramework. Status = %r\n", Status));
+    goto EXIT;
+  }
+
+  Status = CreateUnitTestSuite (&PoolTests, Framework, "Pool Allocator Tests", "Core.Dxe.Pool", NULL, NULL);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "Failed in CreateUnitTestSuite for Pool Allocator Tests\n"));
+    Status = EFI_OUT_OF_RESOURCES;
+    goto EXIT;
+  }
+
+  //
+  // --------------Suite------Description---------------------------------Name--------------Function------------------Pre---Post---Context-----
+  //
+  AddTestCase (PoolTests, "Allocate and free all small sizes", "AllSizes", TestAllocateFreeAllSizes, NULL, NULL, NULL);
+  AddTestCase (PoolTests, "Slab statistics and page release", "SlabStatistics", TestSlabStatistics, NULL, NULL, NULL);
+  AddTestCase (PoolTests, "Alloc/free churn throughput", "ChurnThroughput", TestPoolChurnThroughput, NULL, NULL, NULL);
+
+  //
+  // Execute the tests.
+  //
+  CoreInitializePool ();
+  Status = RunAllTestSuites (Framework);
+
+EXIT:
+  if (Framework) {
+    FreeUnitTestFramework (Framework);
+  }
+
+  return Status;
+}
+
+///
+/// Avoid ECC error for function name that starts with lower case letter
+///
+#define PoolUnitTestMain  main
+
+/**
+  Standard POSIX C entry point for host based unit test execution.
+
+  @param[in] Argc  Number of arguments
+  @param[in] Argv  Array of pointers to arguments
+
+  @retval 0      Success
+  @retval other  Error
+**/
+INT32
+PoolUnitTestMain (
+  IN INT32  Argc,
+  IN CHAR8  *Argv[]
+  )
+{
+  UnitTestingEntry ();
+  return 0;
+}
@@ -0,0 +1,720 @@
+/** @file
+  Host-based unit test and benchmark of the DXE core protocol database.
+
+  The handle services in Hand/ are linked against stubbed TPL, event and
+  driver model services, so the protocol and interface hash indexes can be
+  validated against the ordering semantics of the linked lists they index.
+
+  Copyright (c) 2026, Intel Corporation. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include <stdio.h>
+#include <string.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <time.h>
+#include <cmocka.h>
+
+#include "DxeMain.h"
+#include "Handle.h"
+
+#include <Library/UnitTestLib.h>
+
+#define UNIT_TEST_APP_NAME     "DXE Core Protocol Database Unit Tests"
+#define UNIT_TEST_APP_VERSION  "1.0"
+
+//
+// Every handle carries the common protocol plus TEST_PROTOCOLS_PER_HANDLE
+// of the TEST_PROTOCOL_COUNT test protocols, similar to the shape of the
+// handle database on a large server platform.
+//
+#define TEST_HANDLE_COUNT          10000
+#define TEST_PROTOCOL_COUNT        512
+#define TEST_PROTOCOLS_PER_HANDLE  4
+#define TEST_PROTOCOL_STRIDE       131
+#define TEST_ROUNDS                10
+#define TEST_LARGE_HANDLE_COUNT    64
+
+EFI_HANDLE  gDxeCoreImageHandle = NULL;
+
+EFI_HANDLE  mTestHandles[TEST_HANDLE_COUNT];
+UINTN       mTestCommonInterfaces[TEST_HANDLE_COUNT];
+UINTN       mTestInterfaces[TEST_HANDLE_COUNT][TEST_PROTOCOLS_PER_HANDLE];
+BOOLEAN     mTestInstalled[TEST_HANDLE_COUNT][TEST_PROTOCOLS_PER_HANDLE];
+EFI_GUID    mTestCommonGuid = {
+  0x5b1a7e3c, 0x44d2, 0x4c1e, { 0x9f, 0x0e, 0x2a, 0x61, 0x7b, 0x33, 0xc4, 0x10 }
+};
+EFI_GUID    mTestGuids[TEST_PROTOCOL_COUNT];
+
+/**
+  Stub of the DXE core TPL service. The host test runs at TPL_APPLICATION.
+
+  @param  NewTpl  New, higher, task priority
+
+  @return The previous task priority level
+
+**/
+EFI_TPL
+EFIAPI
+CoreRaiseTpl (
+  IN EFI_TPL  NewTpl
+  )
+{
+  return TPL_APPLICATION;
+}
+
+/**
+  Stub of the DXE core TPL service.
+
+  @param  NewTpl  New, lower, task priority
+
+**/
+VOID
+EFIAPI
+CoreRestoreTpl (
+  IN EFI_TPL  NewTpl
+  )
+{
+}
+
+/**
+  Stub of the DXE core pool service.
+
+  @param  Buffer                 The allocated pool entry to free
+
+  @retval EFI_SUCCESS            Pool successfully freed.
+
+**/
+EFI_STATUS
+EFIAPI
+CoreFreePool (
+  IN VOID  *Buffer
+  )
+{
+  FreePool (Buffer);
+  return EFI_SUCCESS;
+}
+
+/**
+  Stub of the DXE core event service. No protocol notifies are registered by
+  the tests.
+
+  @param  UserEvent              The event to signal .
+
+  @retval EFI_SUCCESS            The event was signaled.
+
+**/
+EFI_STATUS
+EFIAPI
+CoreSignalEvent (
+  IN EFI_EVENT  UserEvent
+  )
+{
+  return EFI_SUCCESS;
+}
+
+/**
+  Stub of the DXE dispatcher dependency expression index. No drivers are
+  dispatched by the tests.
+
+  @param  Protocol              The GUID of the protocol that was installed.
+
+**/
+VOID
+CoreDepexProtocolInstalled (
+  IN  EFI_GUID  *Protocol
+  )
+{
+}
+
+/**
+  Stub of the DXE core driver model service. No drivers are registered by the
+  tests.
+
+  @param  ControllerHandle      The handle of the controller to which driver(s) are to be connected.
+  @param  DriverImageHandle     A pointer to an ordered list handles that support the
+                                EFI_DRIVER_BINDING_PROTOCOL.
+  @param  RemainingDevicePath   A pointer to the device path that specifies a child of the
+                                controller specified by ControllerHandle.
+  @param  Recursive             If TRUE, then ConnectController() is called recursively.
+
+  @retval EFI_NOT_FOUND         No drivers were connected to ControllerHandle.
+
+**/
+EFI_STATUS
+EFIAPI
+CoreConnectController (
+  IN  EFI_HANDLE                ControllerHandle,
+  IN  EFI_HANDLE                *DriverImageHandle    OPTIONAL,
+  IN  EFI_DEVICE_PATH_PROTOCOL  *RemainingDevicePath  OPTIONAL,
+  IN  BOOLEAN                   Recursive
+  )
+{
+  return EFI_NOT_FOUND;
+}
+
+/**
+  Stub of the DXE core driver model service. No drivers are registered by the
+  tests.
+
+  @param  ControllerHandle      ControllerHandle The handle of the controller from which
+                                driver(s)  are to be disconnected.
+  @param  DriverImageHandle     DriverImageHandle The driver to disconnect from ControllerHandle.
+  @param  ChildHandle           ChildHandle The handle of the child to destroy.
+
+  @retval EFI_SUCCESS           There are no drivers managing ControllerHandle.
+
+**/
+EFI_STATUS
+EFIAPI
+CoreDisconnectController (
+  IN  EFI_HANDLE  ControllerHandle,
+  IN  EFI_HANDLE  DriverImageHandle  OPTIONAL,
+  IN  EFI_HANDLE  ChildHandle        OPTIONAL
+  )
+{
+  return EFI_SUCCESS;
+}
+
+/**
+  Returns the processor time elapsed since Start in microseconds.
+
+  @param  Start  The processor time at the start of the measurement.
+
+  @return Elapsed time in microseconds.
+
+**/
+STATIC
+UINT64
+ElapsedMicroseconds (
+  IN clock_t  Start
+  )
+{
+  return (UINT64)(clock () - Start) * 1000000 / CLOCKS_PER_SEC;
+}
+
+/**
+  Logs the throughput of a benchmark step.
+
+  @param  Name        The name of the measured operation.
+  @param  Operations  The number of operations performed.
+  @param  Start       The processor time at the start of the measurement.
+
+**/
+STATIC
+VOID
+LogThroughput (
+  IN CONST CHAR8  *Name,
+  IN UINTN        Operations,
+  IN clock_t      Start
+  )
+{
+  UINT64  Elapsed;
+
+  Elapsed = ElapsedMicroseconds (Start);
+  if (Elapsed == 0) {
+    Elapsed = 1;
+  }
+
+  UT_LOG_INFO (
+    "%a: %ld operations in %ld us (%ld ops/s)\n",
+    Name,
+    (UINT64)Operations,
+    Elapsed,
+    (UINT64)Operations * 1000000 / Elapsed
+    );
+}
+
+/**
+  Returns the test protocol GUID installed in slot Slot of handle Index.
+
+  @param  Index  The index of the handle in mTestHandles.
+  @param  Slot   The protocol slot on the handle.
+
+  @return The protocol GUID.
+
+**/
+STATIC
+EFI_GUID *
+TestProtocol (
+  IN UINTN  Index,
+  IN UINTN  Slot
+  )
+{
+  return &mTestGuids[(Index + Slot * TEST_PROTOCOL_STRIDE) % TEST_PROTOCOL_COUNT];
+}
+
+/**
+  Checks that a ByProtocol search for a test protocol returns exactly the
+  handles it is installed on, in installation order.
+
+  @param  Protocol  The index of the protocol in mTestGuids.
+
+  @retval UNIT_TEST_PASSED             The handles were returned in order.
+  @retval UNIT_TEST_ERROR_TEST_FAILED  The handles did not match.
+
+**/
+STATIC
+UNIT_TEST_STATUS
+CheckLocateByProtocol (
+  IN UINTN  Protocol
+  )
+{
+  EFI_STATUS  Status;
+  EFI_HANDLE  *Buffer;
+  UINTN       Count;
+  UINTN       Found;
+  UINTN       Index;
+  UINTN       Slot;
+
+  Status = CoreLocateHandleBuffer (ByProtocol, &mTestGuids[Protocol], NULL, &Count, &Buffer);
+  if (EFI_ERROR (Status)) {
+    UT_ASSERT_STATUS_EQUAL (Status, EFI_NOT_FOUND);
+    Count  = 0;
+    Buffer = NULL;
+  }
+
+  Found = 0;
+  for (Index = 0; Index < TEST_HANDLE_COUNT; Index++) {
+    for (Slot = 0; Slot < TEST_PROTOCOLS_PER_HANDLE; Slot++) {
+      if (mTestInstalled[Index][Slot] && (TestProtocol (Index, Slot) == &mTestGuids[Protocol])) {
+        UT_ASSERT_TRUE (Found < Count);
+        UT_ASSERT_EQUAL ((UINTN)Buffer[Found], (UINTN)mTestHandles[Index]);
+        Found++;
+      }
+    }
+  }
+
+  UT_ASSERT_EQUAL (Found, Count);
+
+  if (Buffer != NULL) {
+    FreePool (Buffer);
+  }
+
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  Installs TEST_HANDLE_COUNT handles and checks that LocateHandleBuffer()
+  returns them in installation order.
+
+  @param[in]  Context    [Optional] An optional parameter that enables:
+                         1) test-case reuse with varied parameters and
+                         2) test-case re-entry for Target tests that need a
+                         reboot.  This parameter is a VOID* and it is the
+                         responsibility of the test author to ensure that the
+                         contents are well understood by all test cases that may
+                         consume it.
+
+  @retval  UNIT_TEST_PASSED             The Unit test has completed and the test
+                                        case was successful.
+  @retval  UNIT_TEST_ERROR_TEST_FAILED  A test case assertion has failed.
+**/
+UNIT_TEST_STATUS
+EFIAPI
+InstallAndLocateHandles (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  EFI_STATUS  Status;
+  EFI_HANDLE  *Buffer;
+  UINTN       Count;
+  UINTN       Index;
+  UINTN       Slot;
+  UINTN       Round;
+  clock_t     Start;
+
+  Start = clock ();
+  for (Index = 0; Index < TEST_HANDLE_COUNT; Index++) {
+    mTestHandles[Index] = NULL;
+    Status              = CoreInstallProtocolInterface (
+                            &mTestHandles[Index],
+                            &mTestCommonGuid,
+                            EFI_NATIVE_INTERFACE,
+                            &mTestCommonInterfaces[Index]
+                            );
+    UT_ASSERT_NOT_EFI_ERROR (Status);
+
+    for (Slot = 0; Slot < TEST_PROTOCOLS_PER_HANDLE; Slot++) {
+      Status = CoreInstallProtocolInterface (
+                 &mTestHandles[Index],
+                 TestProtocol (Index, Slot),
+                 EFI_NATIVE_INTERFACE,
+                 &mTestInterfaces[Index][Slot]
+                 );
+      UT_ASSERT_NOT_EFI_ERROR (Status);
+      mTestInstalled[Index][Slot] = TRUE;
+    }
+  }
+
+  LogThroughput ("InstallProtocolInterface", TEST_HANDLE_COUNT * (TEST_PROTOCOLS_PER_HANDLE + 1), Start);
+
+  Status = CoreLocateHandleBuffer (AllHandles, NULL, NULL, &Count, &Buffer);
+  UT_ASSERT_NOT_EFI_ERROR (Status);
+  UT_ASSERT_EQUAL (Count, TEST_HANDLE_COUNT);
+  for (Index = 0; Index < Count; Index++) {
+    UT_ASSERT_EQUAL ((UINTN)Buffer[Index], (UINTN)mTestHandles[Index]);
+  }
+
+  FreePool (Buffer);
+
+  Status = CoreLocateHandleBuffer (ByProtocol, &mTestCommonGuid, NULL, &Count, &Buffer);
+  UT_ASSERT_NOT_EFI_ERROR (Status);
+  UT_ASSERT_EQUAL (Count, TEST_HANDLE_COUNT);
+  for (Index = 0; Index < Count; Index++) {
+    UT_ASSERT_EQUAL ((UINTN)Buffer[Index], (UINTN)mTestHandles[Index]);
+  }
+
+  FreePool (Buffer);
+
+  for (Index = 0; Index < TEST_PROTOCOL_COUNT; Index++) {
+    UT_ASSERT_EQUAL (CheckLocateByProtocol (Index), UNIT_TEST_PASSED);
+  }
+
+  Start = clock ();
+  for (Round = 0; Round < TEST_ROUNDS; Round++) {
+    for (Index = 0; Index < TEST_PROTOCOL_COUNT; Index++) {
+      Status = CoreLocateHandleBuffer (ByProtocol, &mTestGuids[Index], NULL, &Count, &Buffer);
+      UT_ASSERT_NOT_EFI_ERROR (Status);
+      FreePool (Buffer);
+    }
+  }
+
+  LogThroughput ("LocateHandleBuffer", TEST_ROUNDS * TEST_PROTOCOL_COUNT, Start);
+
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  Opens every installed protocol interface and checks that the protocols not
+  installed on a handle are reported as unsupported.
+
+  @param[in]  Context    [Optional] An optional parameter that enables:
+                         1) test-case reuse with varied parameters and
+                         2) test-case re-entry for Target tests that need a
+                         reboot.  This parameter is a VOID* and it is the
+                         responsibility of the test author to ensure that the
+                         contents are well understood by all test cases that may
+                         consume it.
+
+  @retval  UNIT_TEST_PASSED             The Unit test has completed and the test
+                                        case was successful.
+  @retval  UNIT_TEST_ERROR_TEST_FAILED  A test case assertion has failed.
+**/
+UNIT_TEST_STATUS
+EFIAPI
+OpenInstalledProtocols (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  EFI_STATUS  Status;
+  VOID        *Interface;
+  UINTN       Index;
+  UINTN       Slot;
+  UINTN       Round;
+  clock_t     Start;
+
+  Start = clock ();
+  for (Round = 0; Round < TEST_ROUNDS; Round++) {
+    for (Index = 0; Index < TEST_HANDLE_COUNT; Index++) {
+      for (Slot = 0; Slot < TEST_PROTOCOLS_PER_HANDLE; Slot++) {
+        Status = CoreOpenProtocol (
+                   mTestHandles[Index],
+                   TestProtocol (Index, Slot),
+                   &Interface,
+                   gDxeCoreImageHandle,
+                   NULL,
+                   EFI_OPEN_PROTOCOL_GET_PROTOCOL
+                   );
+        UT_ASSERT_NOT_EFI_ERROR (Status);
+        UT_ASSERT_EQUAL ((UINTN)Interface, (UINTN)&mTestInterfaces[Index][Slot]);
+      }
+    }
+  }
+
+  LogThroughput ("OpenProtocol", TEST_ROUNDS * TEST_HANDLE_COUNT * TEST_PROTOCOLS_PER_HANDLE, Start);
+
+  for (Index = 0; Index < TEST_HANDLE_COUNT; Index++) {
+    Status = CoreHandleProtocol (mTestHandles[Index], &mTestCommonGuid, &Interface);
+    UT_ASSERT_NOT_EFI_ERROR (Status);
+    UT_ASSERT_EQUAL ((UINTN)Interface, (UINTN)&mTestCommonInterfaces[Index]);
+
+    //
+    // The protocol of the next handle is never installed on this one.
+    //
+    Status = CoreHandleProtocol (mTestHandles[Index], TestProtocol (Index + 1, 0), &Interface);
+    UT_ASSERT_STATUS_EQUAL (Status, EFI_UNSUPPORTED);
+  }
+
+  Status = CoreHandleProtocol (mTestHandles[0], &gEfiDevicePathProtocolGuid, &Interface);
+  UT_ASSERT_STATUS_EQUAL (Status, EFI_UNSUPPORTED);
+
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  Reinstalls and uninstalls protocol interfaces and checks that the indexes
+  stay coherent with the protocol and handle lists.
+
+  @param[in]  Context    [Optional] An optional parameter that enables:
+                         1) test-case reuse with varied parameters and
+                         2) test-case re-entry for Target tests that need a
+                         reboot.  This parameter is a VOID* and it is the
+                         responsibility of the test author to ensure that the
+                         contents are well understood by all test cases that may
+                         consume it.
+
+  @retval  UNIT_TEST_PASSED             The Unit test has completed and the test
+                                        case was successful.
+  @retval  UNIT_TEST_ERROR_TEST_FAILED  A test case assertion has failed.
+**/
+UNIT_TEST_STATUS
+EFIAPI
+UninstallProtocols (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  EFI_STATUS  Status;
+  VOID        *Interface;
+  EFI_HANDLE  *Buffer;
+  UINTN       Count;
+  UINTN       Index;
+  UINTN       Slot;
+  UINTN       Last;
+
+  //
+  // Swap the common interface of the last handle and make sure the old
+  // interface is gone and the new one is found. Reinstalling moves the
+  // interface to the tail of the protocol list, which the last handle
+  // already occupies.
+  //
+  Last   = TEST_HANDLE_COUNT - 1;
+  Status = CoreReinstallProtocolInterface (
+             mTestHandles[Last],
+             &mTestCommonGuid,
+             &mTestCommonInterfaces[Last],
+             &mTestInterfaces[Last][0]
+             );
+  UT_ASSERT_NOT_EFI_ERROR (Status);
+  Status = CoreUninstallProtocolInterface (mTestHandles[Last], &mTestCommonGuid, &mTestCommonInterfaces[Last]);
+  UT_ASSERT_STATUS_EQUAL (Status, EFI_NOT_FOUND);
+  Status = CoreHandleProtocol (mTestHandles[Last], &mTestCommonGuid, &Interface);
+  UT_ASSERT_NOT_EFI_ERROR (Status);
+  UT_ASSERT_EQUAL ((UINTN)Interface, (UINTN)&mTestInterfaces[Last][0]);
+  Status = CoreReinstallProtocolInterface (
+             mTestHandles[Last],
+             &mTestCommonGuid,
+             &mTestInterfaces[Last][0],
+             &mTestCommonInterfaces[Last]
+             );
+  UT_ASSERT_NOT_EFI_ERROR (Status);
+
+  //
+  // Remove one protocol from every odd handle.
+  //
+  for (Index = 1; Index < TEST_HANDLE_COUNT; Index += 2) {
+    Status = CoreUninstallProtocolInterface (
+               mTestHandles[Index],
+               TestProtocol (Index, 1),
+               &mTestInterfaces[Index][1]
+               );
+    UT_ASSERT_NOT_EFI_ERROR (Status);
+    mTestInstalled[Index][1] = FALSE;
+
+    Status = CoreHandleProtocol (mTestHandles[Index], TestProtocol (Index, 1), &Interface);
+    UT_ASSERT_STATUS_EQUAL (Status, EFI_UNSUPPORTED);
+  }
+
+  for (Index = 0; Index < TEST_PROTOCOL_COUNT; Index++) {
+    UT_ASSERT_EQUAL (CheckLocateByProtocol (Index), UNIT_TEST_PASSED);
+  }
+
+  //
+  // Remove everything that is left. The handles are freed with their last protocol.
+  //
+  for (Index = 0; Index < TEST_HANDLE_COUNT; Index++) {
+    for (Slot = 0; Slot < TEST_PROTOCOLS_PER_HANDLE; Slot++) {
+      if (mTestInstalled[Index][Slot]) {
+        Status = CoreUninstallProtocolInterface (
+                   mTestHandles[Index],
+                   TestProtocol (Index, Slot),
+                   &mTestInterfaces[Index][Slot]
+                   );
+        UT_ASSERT_NOT_EFI_ERROR (Status);
+        mTestInstalled[Index][Slot] = FALSE;
+      }
+    }
+
+    Status = CoreUninstallProtocolInterface (mTestHandles[Index], &mTestCommonGuid, &mTestCommonInterfaces[Index]);
+    UT_ASSERT_NOT_EFI_ERROR (Status);
+  }
+
+  for (Index = 0; Index < TEST_PROTOCOL_COUNT; Index++) {
+    UT_ASSERT_EQUAL (CheckLocateByProtocol (Index), UNIT_TEST_PASSED);
+  }
+
+  Status = CoreLocateHandleBuffer (AllHandles, NULL, NULL, &Count, &Buffer);
+  UT_ASSERT_STATUS_EQUAL (Status, EFI_NOT_FOUND);
+
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  Installs more protocols on one handle than are searched by walking the
+  handle's protocol list and checks the lookups through the hash index.
+
+  @param[in]  Context    [Optional] An optional parameter that enables:
+                         1) test-case reuse with varied parameters and
+                         2) test-case re-entry for Target tests that need a
+                         reboot.  This parameter is a VOID* and it is the
+                         responsibility of the test author to ensure that the
+                         contents are well understood by all test cases that may
+                         consume it.
+
+  @retval  UNIT_TEST_PASSED             The Unit test has completed and the test
+                                        case was successful.
+  @retval  UNIT_TEST_ERROR_TEST_FAILED  A test case assertion has failed.
+**/
+UNIT_TEST_STATUS
+EFIAPI
+HandleWithManyProtocols (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  EFI_STATUS  Status;
+  EFI_HANDLE  Handle;
+  VOID        *Interface;
+  UINTN       Index;
+
+  Handle = NULL;
+  for (Index = 0; Index < TEST_LARGE_HANDLE_COUNT; Index++) {
+    Status = CoreInstallProtocolInterface (&Handle, &mTestGuids[Index], EFI_NATIVE_INTERFACE, &mTestCommonInterfaces[Index]);
+    UT_ASSERT_NOT_EFI_ERROR (Status);
+  }
+
+  for (Index = 0; Index < TEST_LARGE_HANDLE_COUNT; Index += 2) {
+    Status = CoreUninstallProtocolInterface (Handle, &mTestGuids[Index], &mTestCommonInterfaces[Index]);
+    UT_ASSERT_NOT_EFI_ERROR (Status);
+  }
+
+  for (Index = 0; Index < TEST_LARGE_HANDLE_COUNT; Index++) {
+    Status = CoreHandleProtocol (Handle, &mTestGuids[Index], &Interface);
+    if ((Index % 2) == 0) {
+      UT_ASSERT_STATUS_EQUAL (Status, EFI_UNSUPPORTED);
+    } else {
+      UT_ASSERT_NOT_EFI_ERROR (Status);
+      UT_ASSERT_EQUAL ((UINTN)Interface, (UINTN)&mTestCommonInterfaces[Index]);
+    }
+  }
+
+  for (Index = 1; Index < TEST_LARGE_HANDLE_COUNT; Index += 2) {
+    Status = CoreUninstallProtocolInterface (Handle, &mTestGuids[Index], &mTestCommonInterfaces[Index]);
+    UT_ASSERT_NOT_EFI_ERROR (Status);
+  }
+
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  Initialize the unit test framework, suite, and unit tests for the
+  protocol database and run the unit tests.
+
+  @retval  EFI_SUCCESS           All test cases were dispatched.
+  @retval  EFI_OUT_OF_RESOURCES  There are not enough resources available to
+                                 initialize the unit tests.
+**/
+STATIC
+EFI_STATUS
+EFIAPI
+UnitTestingEntry (
+  VOID
+  )
+{
+  EFI_STATUS                  Status;
+  UNIT_TEST_FRAMEWORK_HANDLE  Framework;
+  UNIT_TEST_SUITE_HANDLE      HandleTests;
+  UINTN                       Index;
+
+  Framework = NULL;
+
+  DEBUG ((DEBUG_INFO, "%a v%a\n", UNIT_TEST_APP_NAME, UNIT_TEST_APP_VERSION));
+
+  //
+  // The test GUIDs only differ in Data1, like many GUID families do.
+  //
+  for (Index = 0; Index < TEST_PROTOCOL_COUNT; Index++) {
+    CopyGuid (&mTestGuids[Index], &mTestCommonGuid);
+    mTestGuids[Index].Data1 += (UINT32)Index + 1;
+  }
+
+  Status = CoreInitializeHandleServices ();
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "Failed in CoreInitializeHandleServices. Status = %r\n", Status));
+    goto EXIT;
+  }
+
+  //
+  // Start setting up the test framework for running the tests.
+  //
+  Status = InitUnitTestFramework (&Framework, UNIT_TEST_APP_NAME, gEfiCallerBaseName, UNIT_TEST_APP_VERSION);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "Failed in InitUnitTestFramework. Status = %r\n", Status));
+    goto EXIT;
+  }
+
+  Status = CreateUnitTestSuite (&HandleTests, Framework, "Protocol Database Tests", "DxeCore.ProtocolDatabase", NULL, NULL);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "Failed in CreateUnitTestSuite for Protocol Database Tests\n"));
+    Status = EFI_OUT_OF_RESOURCES;
+    goto EXIT;
+  }
+
+  //
+  // The test cases share the handle database and must run in this order.
+  //
+  // --------------Suite--------Description------------------------------Name---------Function----------------Pre---Post---Context-----------
+  //
+  AddTestCase (HandleTests, "Install and locate 10k handles", "Locate", InstallAndLocateHandles, NULL, NULL, NULL);
+  AddTestCase (HandleTests, "Open installed protocols", "Open", OpenInstalledProtocols, NULL, NULL, NULL);
+  AddTestCase (HandleTests, "Reinstall and uninstall protocols", "Uninstall", UninstallProtocols, NULL, NULL, NULL);
+  AddTestCase (HandleTests, "Handle with many protocols", "ManyProtocols", HandleWithManyProtocols, NULL, NULL, NULL);
+
+  //
+  // Execute the tests.
+  //
+  Status = RunAllTestSuites (Framework);
+
+EXIT:
+  if (Framework) {
+    FreeUnitTestFramework (Framework);
+  }
+
+  return Status;
+}
+
+///
+/// Avoid ECC error for function name that starts with lower case letter
+///
+#define ProtocolDatabaseUnitTestMain  main
+
+/**
+  Standard POSIX C entry point for host based unit test execution.
+
+  @param[in] Argc  Number of arguments
+  @param[in] Argv  Array of pointers to arguments
+
+  @retval 0      Success
+  @retval other  Error
+**/
+INT32
+ProtocolDatabaseUnitTestMain (
+  IN INT32  Argc,
+  IN CHAR8  *Argv[]
+  )
+{
+  UnitTestingEntry ();
+  return 0;
+}
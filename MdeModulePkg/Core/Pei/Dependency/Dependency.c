@@ -250,3 +250,69 @@ PeimDispatchReadiness (
     }
   }
 }
+
+/**
+  Return the bit that represents a PPI GUID in PEI_DEPEX_WAIT.WaitMask.
+
+  @param Guid                   The PPI GUID.
+
+  @return A UINT64 with exactly one bit set.
+
+**/
+UINT64
+PeiDepexGuidMask (
+  IN CONST EFI_GUID  *Guid
+  )
+{
+  UINT32  Hash;
+
+  Hash = ReadUnaligned32 ((CONST UINT32 *)Guid) ^ ReadUnaligned32 ((CONST UINT32 *)Guid + 3);
+  return LShiftU64 (1, (Hash * 0x9E3779B1) >> 26);
+}
+
+/**
+  Compute the PEI_DEPEX_WAIT.WaitMask of a dependency expression, the set of
+  PPI GUIDs whose installation may change the result of the expression.
+
+  @param DependencyExpression   Pointer to a dependency expression.
+
+  @return The mask of all PPI GUIDs pushed by the expression. MAX_UINT64 if
+          the expression is malformed, so that it is evaluated every time.
+
+**/
+UINT64
+PeiDepexWaitMask (
+  IN VOID  *DependencyExpression
+  )
+{
+  DEPENDENCY_EXPRESSION_OPERAND  *Iterator;
+  UINT64                         WaitMask;
+  UINTN                          Count;
+
+  Iterator = DependencyExpression;
+  WaitMask = 0;
+
+  for (Count = 0; Count < MAX_GRAMMAR_SIZE * 2; Count++) {
+    switch (*(Iterator++)) {
+      case (EFI_DEP_PUSH):
+        WaitMask |= PeiDepexGuidMask ((EFI_GUID *)Iterator);
+        Iterator  = Iterator + sizeof (EFI_GUID);
+        break;
+
+      case (EFI_DEP_AND):
+      case (EFI_DEP_OR):
+      case (EFI_DEP_NOT):
+      case (EFI_DEP_TRUE):
+      case (EFI_DEP_FALSE):
+        break;
+
+      case (EFI_DEP_END):
+        return WaitMask;
+
+      default:
+        return MAX_UINT64;
+    }
+  }
+
+  return MAX_UINT64;
+}
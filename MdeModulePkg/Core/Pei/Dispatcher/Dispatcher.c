@@ -488,6 +488,8 @@ DiscoverPeimsAndOrderWithApriori (
   CoreFileHandle->PeimCount = PeimCount;
   CoreFileHandle->PeimState = AllocateZeroPool (sizeof (UINT8) * PeimCount);
   ASSERT (CoreFileHandle->PeimState != NULL);
+  CoreFileHandle->DepexWait = AllocateZeroPool (sizeof (PEI_DEPEX_WAIT) * PeimCount);
+  ASSERT (CoreFileHandle->DepexWait != NULL);
   CoreFileHandle->FvFileHandles = AllocateZeroPool (sizeof (EFI_PEI_FILE_HANDLE) * PeimCount);
   ASSERT (CoreFileHandle->FvFileHandles != NULL);
 
@@ -1796,6 +1798,7 @@ PeiDispatcher (
   PEI_CORE_FV_HANDLE      *CoreFvHandle;
   EFI_HOB_GUID_TYPE       *GuidHob;
   UINT32                  TableSize;
+  CHAR8                   DepexToken[24];
 
   PeiServices    = (CONST EFI_PEI_SERVICES **)&Private->Ps;
   PeimEntryPoint = NULL;
@@ -1898,6 +1901,8 @@ PeiDispatcher (
     if (!Private->PeimDispatcherReenter) {
       Private->PeimNeedingDispatch    = FALSE;
       Private->PeimDispatchOnThisPass = FALSE;
+      Private->DepexEvaluated         = 0;
+      Private->DepexSkipped           = 0;
     } else {
       Private->PeimDispatcherReenter = FALSE;
     }
@@ -2101,6 +2106,15 @@ PeiDispatcher (
     //
     Private->CurrentPeimFvCount = 0;
 
+    //
+    // Log how many dependency expressions this pass evaluated and skipped
+    //
+    DEBUG ((DEBUG_DISPATCH, "PEI DEPEX pass: %d evaluated, %d skipped\n", (UINT32)Private->DepexEvaluated, (UINT32)Private->DepexSkipped));
+    PERF_CODE (
+      AsciiSPrint (DepexToken, sizeof (DepexToken), "PeiDepex:%d/%d", (UINT32)Private->DepexEvaluated, (UINT32)(Private->DepexEvaluated + Private->DepexSkipped));
+      PERF_EVENT (DepexToken);
+      );
+
     //
     // PeimNeedingDispatch being TRUE means we found a PEIM/FV that did not get
     //  dispatched. So we need to make another pass
@@ -2168,6 +2182,33 @@ DepexSatisfied (
   EFI_STATUS        Status;
   VOID              *DepexData;
   EFI_FV_FILE_INFO  FileInfo;
+  PEI_DEPEX_WAIT    *DepexWait;
+  PEI_PPI_LIST      *PpiList;
+  UINT64            InstalledMask;
+  UINTN             Index;
+
+  //
+  // The DEPEX can only change from FALSE to TRUE once one of the PPIs it
+  // pushes is installed. PPIs are never uninstalled and are appended to the
+  // PPI list, so only the GUIDs installed since the last evaluation need to
+  // be checked against the DEPEX.
+  //
+  DepexWait = &Private->Fv[Private->CurrentPeimFvCount].DepexWait[PeimCount];
+  PpiList   = &Private->PpiData.PpiList;
+  if ((DepexWait->PpiCount != 0) && (DepexWait->PpiCount <= PpiList->CurrentCount)) {
+    InstalledMask = 0;
+    for (Index = DepexWait->PpiCount; Index < PpiList->CurrentCount; Index++) {
+      InstalledMask |= PeiDepexGuidMask (PpiList->PpiPtrs[Index].Ppi->Guid);
+    }
+
+    DepexWait->PpiCount = PpiList->CurrentCount;
+    if ((InstalledMask & DepexWait->WaitMask) == 0) {
+      Private->DepexSkipped++;
+      return FALSE;
+    }
+  }
+
+  Private->DepexEvaluated++;
 
   Status = PeiServicesFfsGetFileInfo (FileHandle, &FileInfo);
   if (EFI_ERROR (Status)) {
@@ -2204,7 +2245,13 @@ DepexSatisfied (
   //
   // Evaluate a given DEPEX
   //
-  return PeimDispatchReadiness (&Private->Ps, DepexData);
+  if (PeimDispatchReadiness (&Private->Ps, DepexData)) {
+    return TRUE;
+  }
+
+  DepexWait->PpiCount = PpiList->CurrentCount;
+  DepexWait->WaitMask = PeiDepexWaitMask (DepexData);
+  return FALSE;
 }
 
 /**
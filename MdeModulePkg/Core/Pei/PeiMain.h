@@ -46,6 +46,7 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #include <Library/MemoryAllocationLib.h>
 #include <Library/TimerLib.h>
 #include <Library/SafeIntLib.h>
+#include <Library/PrintLib.h>
 #include <Guid/FirmwareFileSystem2.h>
 #include <Guid/FirmwareFileSystem3.h>
 #include <Guid/AprioriFileName.h>
@@ -137,6 +138,22 @@ typedef struct {
 //
 #define FV_GROWTH_STEP  8
 
+///
+/// State recorded when the DEPEX of a PEIM evaluates to FALSE. The DEPEX is
+/// only evaluated again once a PPI whose GUID hashes into WaitMask has been
+/// installed, see DepexSatisfied().
+///
+typedef struct {
+  ///
+  /// PpiList.CurrentCount when the DEPEX was last evaluated, 0 if never.
+  ///
+  UINTN     PpiCount;
+  ///
+  /// One bit per PPI GUID pushed by the DEPEX, see PeiDepexGuidMask().
+  ///
+  UINT64    WaitMask;
+} PEI_DEPEX_WAIT;
+
 typedef struct {
   EFI_FIRMWARE_VOLUME_HEADER     *FvHeader;
   EFI_PEI_FIRMWARE_VOLUME_PPI    *FvPpi;
@@ -149,6 +166,10 @@ typedef struct {
   //
   // Pointer to the buffer with the PeimCount number of Entries.
   //
+  PEI_DEPEX_WAIT                 *DepexWait;
+  //
+  // Pointer to the buffer with the PeimCount number of Entries.
+  //
   EFI_PEI_FILE_HANDLE            *FvFileHandles;
   BOOLEAN                        ScanFv;
   UINT32                         AuthenticationStatus;
@@ -277,6 +298,11 @@ struct _PEI_CORE_INSTANCE {
   BOOLEAN                           PeimNeedingDispatch;
   BOOLEAN                           PeimDispatchOnThisPass;
   BOOLEAN                           PeimDispatcherReenter;
+  ///
+  /// Number of DEPEX evaluated and skipped by DepexSatisfied() on this pass.
+  ///
+  UINTN                             DepexEvaluated;
+  UINTN                             DepexSkipped;
   EFI_PEI_HOB_POINTERS              HobList;
   BOOLEAN                           SwitchStackSignal;
   BOOLEAN                           PeiMemoryInstalled;
@@ -423,6 +449,34 @@ PeimDispatchReadiness (
   IN VOID              *DependencyExpression
   );
 
+/**
+  Return the bit that represents a PPI GUID in PEI_DEPEX_WAIT.WaitMask.
+
+  @param Guid                   The PPI GUID.
+
+  @return A UINT64 with exactly one bit set.
+
+**/
+UINT64
+PeiDepexGuidMask (
+  IN CONST EFI_GUID  *Guid
+  );
+
+/**
+  Compute the PEI_DEPEX_WAIT.WaitMask of a dependency expression, the set of
+  PPI GUIDs whose installation may change the result of the expression.
+
+  @param DependencyExpression   Pointer to a dependency expression.
+
+  @return The mask of all PPI GUIDs pushed by the expression. MAX_UINT64 if
+          the expression is malformed, so that it is evaluated every time.
+
+**/
+UINT64
+PeiDepexWaitMask (
+  IN VOID  *DependencyExpression
+  );
+
 /**
   Migrate a PEIM from temporary RAM to permanent memory.
 
@@ -238,6 +238,10 @@ PeiCore (
             OldCoreData->Fv[Index].PeimState = (UINT8 *)OldCoreData->Fv[Index].PeimState + OldCoreData->HeapOffset;
           }
 
+          if (OldCoreData->Fv[Index].DepexWait != NULL) {
+            OldCoreData->Fv[Index].DepexWait = (PEI_DEPEX_WAIT *)((UINT8 *)OldCoreData->Fv[Index].DepexWait + OldCoreData->HeapOffset);
+          }
+
           if (OldCoreData->Fv[Index].FvFileHandles != NULL) {
             OldCoreData->Fv[Index].FvFileHandles = (EFI_PEI_FILE_HANDLE *)((UINT8 *)OldCoreData->Fv[Index].FvFileHandles + OldCoreData->HeapOffset);
           }
@@ -273,6 +277,10 @@ PeiCore (
             OldCoreData->Fv[Index].PeimState = (UINT8 *)OldCoreData->Fv[Index].PeimState - OldCoreData->HeapOffset;
           }
 
+          if (OldCoreData->Fv[Index].DepexWait != NULL) {
+            OldCoreData->Fv[Index].DepexWait = (PEI_DEPEX_WAIT *)((UINT8 *)OldCoreData->Fv[Index].DepexWait - OldCoreData->HeapOffset);
+          }
+
           if (OldCoreData->Fv[Index].FvFileHandles != NULL) {
             OldCoreData->Fv[Index].FvFileHandles = (EFI_PEI_FILE_HANDLE *)((UINT8 *)OldCoreData->Fv[Index].FvFileHandles - OldCoreData->HeapOffset);
           }
@@ -179,6 +179,31 @@ typedef struct {
   // MEMORY_PROFILE_DESCRIPTOR     MemoryDescriptor[MemoryRangeCount];
 } MEMORY_PROFILE_MEMORY_RANGE;
 
+#define MEMORY_PROFILE_POOL_SIZE_CLASS_SIGNATURE  SIGNATURE_32 ('M','P','S','C')
+#define MEMORY_PROFILE_POOL_SIZE_CLASS_REVISION   0x0001
+
+typedef struct {
+  MEMORY_PROFILE_COMMON_HEADER    Header;
+  UINT32                          ObjectSize;
+  UINT32                          ObjectsPerSlab;
+  UINT64                          AllocationCount;
+  UINT64                          FreeCount;
+  UINT64                          BytesRequested;
+  UINT64                          BytesWasted;
+} MEMORY_PROFILE_POOL_SIZE_CLASS;
+
+#define MEMORY_PROFILE_POOL_STATISTICS_SIGNATURE  SIGNATURE_32 ('M','P','P','S')
+#define MEMORY_PROFILE_POOL_STATISTICS_REVISION   0x0001
+
+typedef struct {
+  MEMORY_PROFILE_COMMON_HEADER    Header;
+  UINT64                          CurrentSlabPages;
+  UINT64                          PeakSlabPages;
+  UINT32                          SizeClassCount;
+  UINT8                           Reserved[4];
+  // MEMORY_PROFILE_POOL_SIZE_CLASS  SizeClass[SizeClassCount];
+} MEMORY_PROFILE_POOL_STATISTICS;
+
 //
 // UEFI memory profile layout:
 // +--------------------------------+
@@ -196,6 +221,12 @@ typedef struct {
 // +--------------------------------+
 // | ALLOC_INFO(n, mn)              |
 // +--------------------------------+
+// | POOL_STATISTICS (optional)     |
+// +--------------------------------+
+// | POOL_SIZE_CLASS(1)             |
+// +--------------------------------+
+// | POOL_SIZE_CLASS(c)             |
+// +--------------------------------+
 //
 
 typedef struct _EDKII_MEMORY_PROFILE_PROTOCOL EDKII_MEMORY_PROFILE_PROTOCOL;
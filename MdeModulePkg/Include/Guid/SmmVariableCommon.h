@@ -10,6 +10,7 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #define _SMM_VARIABLE_COMMON_H_
 
 #include <Guid/VariableFormat.h>
+#include <Guid/VariableLatencyStatistics.h>
 #include <Protocol/VarCheck.h>
 
 #define EFI_SMM_VARIABLE_WRITE_GUID \
@@ -77,6 +78,18 @@ typedef struct {
 // The payload for this function is SMM_VARIABLE_COMMUNICATE_GET_RUNTIME_CACHE_INFO
 //
 #define SMM_VARIABLE_FUNCTION_GET_RUNTIME_CACHE_INFO  14
+//
+// The payload for this function is SMM_VARIABLE_COMMUNICATE_GET_VARIABLE_BATCH
+//
+#define SMM_VARIABLE_FUNCTION_GET_VARIABLE_BATCH  15
+//
+// The payload for this function is SMM_VARIABLE_COMMUNICATE_VARIABLE_BATCH_CONTEXT
+//
+#define SMM_VARIABLE_FUNCTION_INIT_VARIABLE_BATCH_CONTEXT  16
+//
+// The payload for this function is VARIABLE_LATENCY_STATISTICS.
+//
+#define SMM_VARIABLE_FUNCTION_GET_LATENCY_STATISTICS  17
 
 ///
 /// Size of SMM communicate header, without including the payload.
@@ -138,6 +151,7 @@ typedef struct {
   VARIABLE_STORE_HEADER    *RuntimeHobCache;
   VARIABLE_STORE_HEADER    *RuntimeNvCache;
   VARIABLE_STORE_HEADER    *RuntimeVolatileCache;
+  UINT32                   *FlushCount;
 } SMM_VARIABLE_COMMUNICATE_RUNTIME_VARIABLE_CACHE_CONTEXT;
 
 typedef struct {
@@ -147,4 +161,55 @@ typedef struct {
   BOOLEAN    AuthenticatedVariableUsage;
 } SMM_VARIABLE_COMMUNICATE_GET_RUNTIME_CACHE_INFO;
 
+///
+/// This structure is used to communicate with SMI handler by the batched
+/// variable enumeration. Guid and Name identify the variable to continue after,
+/// an empty Name starts at the first variable. On return, the rest of the
+/// payload from SMM_VARIABLE_BATCH_FIRST_ENTRY_OFFSET () holds EntryCount
+/// SMM_VARIABLE_BATCH_ENTRY records in GetNextVariableName () order.
+///
+typedef struct {
+  EFI_GUID    Guid;
+  UINTN       NameSize;
+  UINT64      Generation;         // Return the variable store generation the entries belong to
+  UINTN       EntryCount;         // Return number of entries
+  BOOLEAN     EndOfVariables;     // Return TRUE if no variable follows the last entry
+  CHAR16      Name[1];
+} SMM_VARIABLE_COMMUNICATE_GET_VARIABLE_BATCH;
+
+///
+/// Generation points to a runtime buffer outside of SMRAM that the SMI handler
+/// keeps equal to the variable store generation, which is advanced whenever a
+/// variable is updated or deleted. A batch is current as long as its
+/// Generation matches the buffer.
+///
+typedef struct {
+  UINT64    *Generation;
+} SMM_VARIABLE_COMMUNICATE_VARIABLE_BATCH_CONTEXT;
+
+///
+/// One variable of a batch. The Null-terminated name follows the structure,
+/// then the data. If the data did not fit into the batch, the data is omitted
+/// and DataSize is the size of the variable data. The next entry starts at the
+/// next SMM_VARIABLE_BATCH_ENTRY_ALIGNMENT boundary.
+///
+typedef struct {
+  EFI_GUID    Guid;
+  UINT32      Attributes;
+  UINT32      NameSize;
+  UINT32      DataSize;
+  UINT32      Flags;
+} SMM_VARIABLE_BATCH_ENTRY;
+
+#define SMM_VARIABLE_BATCH_ENTRY_DATA_OMITTED  BIT0
+
+#define SMM_VARIABLE_BATCH_ENTRY_ALIGNMENT  sizeof (UINT64)
+
+#define SMM_VARIABLE_BATCH_FIRST_ENTRY_OFFSET(NameSize) \
+  ALIGN_VALUE (OFFSET_OF (SMM_VARIABLE_COMMUNICATE_GET_VARIABLE_BATCH, Name) + (NameSize), SMM_VARIABLE_BATCH_ENTRY_ALIGNMENT)
+
+#define SMM_VARIABLE_BATCH_ENTRY_SIZE(Entry)                                                  \
+  (sizeof (SMM_VARIABLE_BATCH_ENTRY) + (Entry)->NameSize +                                    \
+   ((((Entry)->Flags & SMM_VARIABLE_BATCH_ENTRY_DATA_OMITTED) != 0) ? 0 : (Entry)->DataSize))
+
 #endif // _SMM_VARIABLE_COMMON_H_
@@ -0,0 +1,54 @@
+/** @file
+  Latency statistics of the variable driver.
+
+  When PcdVariableCollectStatistics is TRUE, the variable driver keeps
+  histograms of the SetVariable () and non-volatile store reclaim latencies.
+  The runtime DXE variable driver publishes them as a configuration table with
+  this GUID at ReadyToBoot, the MM variable driver returns them through
+  SMM_VARIABLE_FUNCTION_GET_LATENCY_STATISTICS.
+
+  Copyright (c) 2026, Intel Corporation. All rights reserved.<BR>
+
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#ifndef VARIABLE_LATENCY_STATISTICS_H_
+#define VARIABLE_LATENCY_STATISTICS_H_
+
+#define EDKII_VARIABLE_LATENCY_STATISTICS_GUID \
+  { \
+    0xfccbb713, 0xab41, 0x4634, {0x8b, 0xdd, 0x89, 0xea, 0x43, 0xbb, 0xad, 0x8e}  \
+  }
+
+///
+/// Number of buckets of a latency histogram. Bucket 0 counts operations that
+/// took less than 1us, bucket N counts [2^(N-1), 2^N) us, the last bucket
+/// also counts everything slower.
+///
+#define VARIABLE_LATENCY_BUCKETS  24
+
+typedef struct {
+  UINT32    Count;
+  UINT64    MaxNs;
+  UINT32    Bucket[VARIABLE_LATENCY_BUCKETS];
+} VARIABLE_LATENCY_HISTOGRAM;
+
+typedef struct {
+  ///
+  /// SetVariable () calls, including any reclaim they triggered.
+  ///
+  VARIABLE_LATENCY_HISTOGRAM    SetVariable;
+  ///
+  /// Reclaim () of a whole variable store.
+  ///
+  VARIABLE_LATENCY_HISTOGRAM    Reclaim;
+  ///
+  /// Steps of the incremental reclaim of the non-volatile variable store.
+  ///
+  VARIABLE_LATENCY_HISTOGRAM    ReclaimStep;
+} VARIABLE_LATENCY_STATISTICS;
+
+extern EFI_GUID  gEdkiiVariableLatencyStatisticsGuid;
+
+#endif
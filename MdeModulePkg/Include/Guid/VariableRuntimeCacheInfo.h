@@ -35,6 +35,11 @@ typedef struct {
   /// TRUE indicates all HOB variables have been flushed in flash.
   ///
   BOOLEAN    HobFlushComplete;
+  ///
+  /// Incremented each time updates are flushed to the runtime caches, so that
+  /// data derived from the cache content can be invalidated.
+  ///
+  UINT32     FlushCount;
 } CACHE_INFO_FLAG;
 
 typedef struct {
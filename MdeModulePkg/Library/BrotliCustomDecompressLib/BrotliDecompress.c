@@ -56,115 +56,6 @@ BrFree (
   //
 }
 
-/**
-  Decompresses a Brotli compressed source buffer.
-
-  Extracts decompressed data to its original form.
-  If the compressed source data specified by Source is successfully decompressed
-  into Destination, then EFI_SUCCESS is returned. If the compressed source data
-  specified by Source is not in a valid compressed data format,
-  then EFI_INVALID_PARAMETER is returned.
-
-  @param  Source      The source buffer containing the compressed data.
-  @param  SourceSize  The size of source buffer.
-  @param  Destination The destination buffer to store the decompressed data.
-  @param  DestSize    The destination buffer size.
-  @param  BuffInfo    The pointer to the BROTLI_BUFF instance.
-
-  @retval EFI_SUCCESS Decompression completed successfully, and
-                      the uncompressed buffer is returned in Destination.
-  @retval EFI_INVALID_PARAMETER
-                      The source buffer specified by Source is corrupted
-                      (not in a valid compressed format).
-**/
-EFI_STATUS
-BrotliDecompress (
-  IN CONST VOID  *Source,
-  IN UINTN       SourceSize,
-  IN OUT VOID    *Destination,
-  IN OUT UINTN   DestSize,
-  IN VOID        *BuffInfo
-  )
-{
-  UINT8                *Input;
-  UINT8                *Output;
-  const UINT8          *NextIn;
-  UINT8                *NextOut;
-  size_t               TotalOut;
-  size_t               AvailableIn;
-  size_t               AvailableOut;
-  VOID                 *Temp;
-  BrotliDecoderResult  Result;
-  BrotliDecoderState   *BroState;
-
-  TotalOut     = 0;
-  AvailableOut = FILE_BUFFER_SIZE;
-  Result       = BROTLI_DECODER_RESULT_ERROR;
-  BroState     = BrotliDecoderCreateInstance (BrAlloc, BrFree, BuffInfo);
-  Temp         = Destination;
-
-  if (BroState == NULL) {
-    return EFI_INVALID_PARAMETER;
-  }
-
-  Input  = (UINT8 *)BrAlloc (BuffInfo, FILE_BUFFER_SIZE);
-  Output = (UINT8 *)BrAlloc (BuffInfo, FILE_BUFFER_SIZE);
-  if ((Input == NULL) || (Output == NULL)) {
-    BrFree (BuffInfo, Input);
-    BrFree (BuffInfo, Output);
-    BrotliDecoderDestroyInstance (BroState);
-    return EFI_INVALID_PARAMETER;
-  }
-
-  NextOut = Output;
-  Result  = BROTLI_DECODER_RESULT_NEEDS_MORE_INPUT;
-  while (1) {
-    if (Result == BROTLI_DECODER_RESULT_NEEDS_MORE_INPUT) {
-      if (SourceSize == 0) {
-        break;
-      }
-
-      if (SourceSize >= FILE_BUFFER_SIZE) {
-        AvailableIn = FILE_BUFFER_SIZE;
-      } else {
-        AvailableIn = SourceSize;
-      }
-
-      CopyMem (Input, Source, AvailableIn);
-      Source      = (VOID *)((UINT8 *)Source + AvailableIn);
-      SourceSize -= AvailableIn;
-      NextIn      = Input;
-    } else if (Result == BROTLI_DECODER_RESULT_NEEDS_MORE_OUTPUT) {
-      CopyMem (Temp, Output, FILE_BUFFER_SIZE);
-      AvailableOut = FILE_BUFFER_SIZE;
-      Temp         = (VOID *)((UINT8 *)Temp +FILE_BUFFER_SIZE);
-      NextOut      = Output;
-    } else {
-      break; /* Error or success. */
-    }
-
-    Result = BrotliDecoderDecompressStream (
-               BroState,
-               &AvailableIn,
-               &NextIn,
-               &AvailableOut,
-               &NextOut,
-               &TotalOut
-               );
-  }
-
-  if (NextOut != Output) {
-    CopyMem (Temp, Output, (size_t)(NextOut - Output));
-  }
-
-  DestSize = TotalOut;
-
-  BrFree (BuffInfo, Input);
-  BrFree (BuffInfo, Output);
-  BrotliDecoderDestroyInstance (BroState);
-  return (Result == BROTLI_DECODER_RESULT_SUCCESS) ? EFI_SUCCESS : EFI_INVALID_PARAMETER;
-}
-
 /**
   Get the size of the uncompressed buffer by parsing EncodeData header.
 
@@ -245,6 +136,137 @@ BrotliUefiDecompressGetInfo (
   return EFI_SUCCESS;
 }
 
+/**
+  Starts the streaming decompression of a Brotli compressed source buffer.
+
+  The decompressed data is produced in Destination by successive calls to
+  BrotliUefiDecompressStreamRun(), so the caller may consume the beginning of
+  the output while the rest is still being decoded. The decoder reads Source
+  and writes Destination directly. The stream state is kept in Scratch, there
+  is nothing to free once the caller is done with it.
+
+  @param  Source      The source buffer containing the compressed data.
+  @param  SourceSize  The size of source buffer.
+  @param  Destination The destination buffer to store the decompressed data. It
+                      must be as large as the size returned by
+                      BrotliUefiDecompressGetInfo().
+  @param  Scratch     A temporary scratch buffer of the size returned by
+                      BrotliUefiDecompressGetInfo().
+  @param  Stream      On output, the stream to pass to BrotliUefiDecompressStreamRun().
+
+  @retval EFI_SUCCESS The stream was started.
+  @retval EFI_INVALID_PARAMETER
+                      The source buffer specified by Source is corrupted
+                      (not in a valid compressed format).
+**/
+EFI_STATUS
+EFIAPI
+BrotliUefiDecompressStreamInit (
+  IN  CONST VOID  *Source,
+  IN  UINTN       SourceSize,
+  IN  OUT VOID    *Destination,
+  IN  OUT VOID    *Scratch,
+  OUT VOID        **Stream
+  )
+{
+  BROTLI_DECOMPRESS_STREAM  *Private;
+  UINT64                    ScratchSize;
+  UINTN                     StateSize;
+
+  if (SourceSize < BROTLI_SCRATCH_MAX) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  ScratchSize = BrGetDecodedSizeOfBuf ((UINT8 *)Source, BROTLI_SCRATCH_MAX - BROTLI_INFO_SIZE, BROTLI_SCRATCH_MAX);
+  StateSize   = ALIGN_VALUE (sizeof (BROTLI_DECOMPRESS_STREAM), sizeof (UINT64));
+  if (ScratchSize < StateSize) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  Private                    = (BROTLI_DECOMPRESS_STREAM *)Scratch;
+  Private->BuffInfo.Buff     = (UINT8 *)Scratch + StateSize;
+  Private->BuffInfo.BuffSize = (UINTN)ScratchSize - StateSize;
+  Private->Input             = (CONST UINT8 *)Source + BROTLI_SCRATCH_MAX;
+  Private->InputSize         = SourceSize - BROTLI_SCRATCH_MAX;
+  Private->Destination       = Destination;
+  Private->DecodedSize       = (UINTN)BrGetDecodedSizeOfBuf ((UINT8 *)Source, BROTLI_DECODE_MAX - BROTLI_INFO_SIZE, BROTLI_DECODE_MAX);
+  Private->OutputSize        = 0;
+
+  Private->Decoder = BrotliDecoderCreateInstance (BrAlloc, BrFree, &Private->BuffInfo);
+  if (Private->Decoder == NULL) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  *Stream = Private;
+  return EFI_SUCCESS;
+}
+
+/**
+  Continues the streaming decompression of a Brotli compressed source buffer.
+
+  @param  Stream      The stream returned by BrotliUefiDecompressStreamInit().
+  @param  OutputLimit Decode until this many bytes of Destination are produced.
+                      Values larger than the decompressed size decode the
+                      whole stream.
+  @param  OutputSize  On output, the number of bytes at the start of Destination
+                      that hold decompressed data.
+
+  @retval EFI_SUCCESS The whole stream was decompressed.
+  @retval EFI_NOT_READY
+                      OutputLimit bytes were produced, the stream is not
+                      finished yet.
+  @retval EFI_INVALID_PARAMETER
+                      The source buffer is corrupted (not in a valid
+                      compressed format).
+**/
+EFI_STATUS
+EFIAPI
+BrotliUefiDecompressStreamRun (
+  IN  VOID   *Stream,
+  IN  UINTN  OutputLimit,
+  OUT UINTN  *OutputSize
+  )
+{
+  BROTLI_DECOMPRESS_STREAM  *Private;
+  BrotliDecoderResult       Result;
+  const UINT8               *NextIn;
+  UINT8                     *NextOut;
+  size_t                    AvailableOut;
+
+  Private = (BROTLI_DECOMPRESS_STREAM *)Stream;
+  if (Private->Decoder == NULL) {
+    *OutputSize = Private->OutputSize;
+    return EFI_SUCCESS;
+  }
+
+  NextIn       = Private->Input;
+  NextOut      = Private->Destination + Private->OutputSize;
+  AvailableOut = MIN (OutputLimit, Private->DecodedSize) - MIN (Private->OutputSize, OutputLimit);
+  Result       = BrotliDecoderDecompressStream (
+                   Private->Decoder,
+                   &Private->InputSize,
+                   &NextIn,
+                   &AvailableOut,
+                   &NextOut,
+                   NULL
+                   );
+  Private->Input      = NextIn;
+  Private->OutputSize = (UINTN)(NextOut - Private->Destination);
+  *OutputSize         = Private->OutputSize;
+
+  if ((Result == BROTLI_DECODER_RESULT_NEEDS_MORE_OUTPUT) && (Private->OutputSize < Private->DecodedSize)) {
+    return EFI_NOT_READY;
+  }
+
+  //
+  // The decoder allocated from Scratch, destroying it only releases its
+  // internal state.
+  //
+  BrotliDecoderDestroyInstance (Private->Decoder);
+  Private->Decoder = NULL;
+  return (Result == BROTLI_DECODER_RESULT_SUCCESS) ? EFI_SUCCESS : EFI_INVALID_PARAMETER;
+}
+
 /**
   Decompresses a Brotli compressed source buffer.
 
@@ -276,25 +298,14 @@ BrotliUefiDecompress (
   IN OUT VOID    *Scratch
   )
 {
-  UINTN        DestSize = 0;
-  EFI_STATUS   Status;
-  BROTLI_BUFF  BroBuff;
-  UINT64       GetSize;
-  UINT8        MaxOffset;
-
-  MaxOffset = BROTLI_SCRATCH_MAX;
-  GetSize   = BrGetDecodedSizeOfBuf ((UINT8 *)Source, MaxOffset - BROTLI_INFO_SIZE, MaxOffset);
-
-  BroBuff.Buff     = Scratch;
-  BroBuff.BuffSize = (UINTN)GetSize;
-
-  Status = BrotliDecompress (
-             (VOID *)((UINT8 *)Source + BROTLI_SCRATCH_MAX),
-             SourceSize - BROTLI_SCRATCH_MAX,
-             Destination,
-             DestSize,
-             (VOID *)(&BroBuff)
-             );
-
-  return Status;
+  EFI_STATUS  Status;
+  VOID        *Stream;
+  UINTN       OutputSize;
+
+  Status = BrotliUefiDecompressStreamInit (Source, SourceSize, Destination, Scratch, &Stream);
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  return BrotliUefiDecompressStreamRun (Stream, MAX_UINTN, &OutputSize);
 }
@@ -21,7 +21,20 @@ typedef struct {
   UINTN    BuffSize;
 } BROTLI_BUFF;
 
-#define FILE_BUFFER_SIZE    65536
+//
+// State of a streaming decode. It is kept at the start of the scratch buffer,
+// the rest of the scratch buffer serves the allocations of the Brotli decoder.
+//
+typedef struct {
+  BrotliDecoderState    *Decoder;
+  BROTLI_BUFF           BuffInfo;
+  CONST UINT8           *Input;
+  size_t                InputSize;
+  UINT8                 *Destination;
+  UINTN                 DecodedSize;
+  UINTN                 OutputSize;
+} BROTLI_DECOMPRESS_STREAM;
+
 #define BROTLI_INFO_SIZE    8
 #define BROTLI_DECODE_MAX   8
 #define BROTLI_SCRATCH_MAX  16
@@ -44,4 +57,22 @@ BrotliUefiDecompress (
   IN OUT VOID    *Scratch
   );
 
+EFI_STATUS
+EFIAPI
+BrotliUefiDecompressStreamInit (
+  IN  CONST VOID  *Source,
+  IN  UINTN       SourceSize,
+  IN  OUT VOID    *Destination,
+  IN  OUT VOID    *Scratch,
+  OUT VOID        **Stream
+  );
+
+EFI_STATUS
+EFIAPI
+BrotliUefiDecompressStreamRun (
+  IN  VOID   *Stream,
+  IN  UINTN  OutputLimit,
+  OUT UINTN  *OutputSize
+  );
+
 #endif
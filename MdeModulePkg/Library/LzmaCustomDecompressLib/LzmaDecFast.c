@@ -0,0 +1,475 @@
+/** @file
+  Speed optimized main loop of the LZMA decoder.
+
+  The LZMA SDK lets LzmaDec_DecodeReal_3 () be provided outside of LzmaDec.c
+  when _LZMA_DEC_OPT is defined; upstream uses that hook for its x64 assembly
+  decoder. This file is a portable C replacement for that assembly, so that
+  IA32, X64, ARM and AARCH64 builds can all select it.
+
+  The bits of the literal, length, position slot and distance trees are
+  decoded without conditional branches: the range coder computes an all-ones
+  or all-zeros mask from the comparison of code and bound, and updates range,
+  code, the probability and the tree index from that mask. These bits are
+  close to random, so the branches the generic loop takes on them are
+  mispredicted about half of the time. The IsMatch and IsRep decisions remain
+  branches since they are well predicted and select different code paths.
+
+  Matches that do not overlap their source, and runs of a repeated byte, are
+  copied with CopyMem () and SetMem ().
+
+  The file must produce the same output and accept the same input as the
+  generic loop in Sdk/C/LzmaDec.c, including the handling of corrupted input.
+  The constants below duplicate the private definitions of LzmaDec.c.
+
+  Copyright (c) 2026, Intel Corporation. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include "LzmaDecompressLibInternal.h"
+#include "Sdk/C/7zTypes.h"
+#include "Sdk/C/LzmaDec.h"
+
+#ifdef _LZMA_DEC_OPT
+
+#define kNumTopBits  24
+#define kTopValue    ((UInt32)1 << kNumTopBits)
+
+#define kNumBitModelTotalBits  11
+#define kBitModelTotal         (1 << kNumBitModelTotalBits)
+#define kNumMoveBits           5
+
+#define kNumPosBitsMax    4
+#define kNumPosStatesMax  (1 << kNumPosBitsMax)
+
+#define kLenNumLowBits      3
+#define kLenNumLowSymbols   (1 << kLenNumLowBits)
+#define kLenNumHighBits     8
+#define kLenNumHighSymbols  (1 << kLenNumHighBits)
+
+#define LenLow        0
+#define LenHigh       (LenLow + 2 * (kNumPosStatesMax << kLenNumLowBits))
+#define kNumLenProbs  (LenHigh + kLenNumHighSymbols)
+
+#define LenChoice   LenLow
+#define LenChoice2  (LenLow + (1 << kLenNumLowBits))
+
+#define kNumStates     12
+#define kNumStates2    16
+#define kNumLitStates  7
+
+#define kStartPosModelIndex  4
+#define kEndPosModelIndex    14
+#define kNumFullDistances    (1 << (kEndPosModelIndex >> 1))
+
+#define kNumPosSlotBits     6
+#define kNumLenToPosStates  4
+
+#define kNumAlignBits    4
+#define kAlignTableSize  (1 << kNumAlignBits)
+
+#define kMatchMinLen        2
+#define kMatchSpecLenStart  (kMatchMinLen + kLenNumLowSymbols * 2 + kLenNumHighSymbols)
+
+#define kStartOffset  1664
+#define GET_PROBS     p->probs_1664
+
+#define SpecPos         (-kStartOffset)
+#define IsRep0Long      (SpecPos + kNumFullDistances)
+#define RepLenCoder     (IsRep0Long + (kNumStates2 << kNumPosBitsMax))
+#define LenCoder        (RepLenCoder + kNumLenProbs)
+#define IsMatch         (LenCoder + kNumLenProbs)
+#define Align           (IsMatch + (kNumStates2 << kNumPosBitsMax))
+#define IsRep           (Align + kAlignTableSize)
+#define IsRepG0         (IsRep + kNumStates)
+#define IsRepG1         (IsRepG0 + kNumStates)
+#define IsRepG2         (IsRepG1 + kNumStates)
+#define PosSlot         (IsRepG2 + kNumStates)
+#define Literal         (PosSlot + (kNumLenToPosStates << kNumPosSlotBits))
+#define NUM_BASE_PROBS  (Literal + kStartOffset)
+
+#if NUM_BASE_PROBS != 1984
+  #error Stop_Compiling_Bad_LZMA_PROBS
+#endif
+
+#define CALC_POS_STATE(processedPos, pbMask)  (((processedPos) & (pbMask)) << 4)
+#define COMBINED_PS_STATE  (posState + state)
+#define GET_LEN_STATE      (posState)
+
+//
+// Matches at least this long are copied with CopyMem () or SetMem () when
+// possible. Shorter ones are not worth the call.
+//
+#define LZMA_FAST_MIN_BULK_COPY  16
+
+#define NORMALIZE  if (range < kTopValue) { range <<= 8; code = (code << 8) | (*buf++); }
+
+//
+// Decision bits, decoded with a branch.
+//
+#define IF_BIT_0(p)  ttt = *(p); NORMALIZE; bound = (range >> kNumBitModelTotalBits) * (UInt32)ttt; if (code < bound)
+#define UPDATE_0(p)  range = bound; *(p) = (CLzmaProb)(ttt + ((kBitModelTotal - ttt) >> kNumMoveBits));
+#define UPDATE_1(p)  range -= bound; code -= bound; *(p) = (CLzmaProb)(ttt - (ttt >> kNumMoveBits));
+
+//
+// Decodes one bit with probability *(p) without a branch. mask is set to
+// 0xFFFFFFFF if the bit is 1 and to 0 if it is 0.
+//
+#define BIT_MASK(p, mask) \
+  { \
+    UInt32  t_ = *(p); \
+    UInt32  p0_; \
+    UInt32  p1_; \
+    NORMALIZE; \
+    bound  = (range >> kNumBitModelTotalBits) * t_; \
+    mask   = (UInt32)0 - (UInt32)(code >= bound); \
+    range  = bound + ((range - bound - bound) & mask); \
+    code  -= bound & mask; \
+    p0_    = t_ + ((kBitModelTotal - t_) >> kNumMoveBits); \
+    p1_    = t_ - (t_ >> kNumMoveBits); \
+    *(p)   = (CLzmaProb)(p0_ ^ ((p0_ ^ p1_) & mask)); \
+  }
+
+#define TREE_BIT(probs, i)  { BIT_MASK (probs + i, mask); i = i + i + (mask & 1); }
+
+//
+// Reverse tree bits: the index grows by m for a 0 and by 2 * m for a 1.
+//
+#define REV_BIT(probs, i, m)       { BIT_MASK (probs + i, mask); i += m + (m & mask); }
+#define REV_BIT_VAR(probs, i, m)   { REV_BIT (probs, i, m); m += m; }
+#define REV_BIT_LAST(probs, i, m)  { BIT_MASK (probs + i, mask); i -= m & ~mask; }
+
+#define MATCHED_LITER_DEC \
+  matchByte += matchByte; \
+  bit        = offs; \
+  offs      &= matchByte; \
+  probLit    = prob + (offs + bit + symbol); \
+  BIT_MASK (probLit, mask); \
+  symbol = symbol + symbol + (mask & 1); \
+  offs  ^= bit & ~mask;
+
+/**
+  Decodes LZMA symbols into the dictionary.
+
+  Replaces the generic LzmaDec_DecodeReal_3 () of LzmaDec.c and follows its
+  contract: the range coder is normalized on entry and exit, symbols are
+  decoded while p->buf < bufLimit and p->dicPos < limit, and the first
+  symbol is decoded in any case.
+
+  @param[in, out] p         The decoder state.
+  @param[in]      limit     The dictionary position to stop at.
+  @param[in]      bufLimit  The input position to stop at.
+
+  @retval SZ_OK          Symbols were decoded. p->remainLen is the length of
+                         the unfinished match, or kMatchSpecLenStart if the
+                         end marker was decoded.
+  @retval SZ_ERROR_DATA  The input is corrupted.
+
+**/
+int MY_FAST_CALL
+LzmaDec_DecodeReal_3 (
+  CLzmaDec    *p,
+  SizeT       limit,
+  const Byte  *bufLimit
+  )
+{
+  CLzmaProb  *probs = GET_PROBS;
+  unsigned   state  = (unsigned)p->state;
+  UInt32     rep0   = p->reps[0], rep1 = p->reps[1], rep2 = p->reps[2], rep3 = p->reps[3];
+  unsigned   pbMask = ((unsigned)1 << (p->prop.pb)) - 1;
+  unsigned   lc     = p->prop.lc;
+  unsigned   lpMask = ((unsigned)0x100 << p->prop.lp) - ((unsigned)0x100 >> lc);
+
+  Byte   *dic       = p->dic;
+  SizeT  dicBufSize = p->dicBufSize;
+  SizeT  dicPos     = p->dicPos;
+
+  UInt32    processedPos = p->processedPos;
+  UInt32    checkDicSize = p->checkDicSize;
+  unsigned  len          = 0;
+
+  const Byte  *buf  = p->buf;
+  UInt32      range = p->range;
+  UInt32      code  = p->code;
+
+  do {
+    CLzmaProb  *prob;
+    UInt32     bound;
+    UInt32     mask;
+    unsigned   ttt;
+    unsigned   posState = CALC_POS_STATE (processedPos, pbMask);
+
+    prob = probs + IsMatch + COMBINED_PS_STATE;
+    IF_BIT_0 (prob) {
+      unsigned  symbol;
+
+      UPDATE_0 (prob);
+      prob = probs + Literal;
+      if ((processedPos != 0) || (checkDicSize != 0)) {
+        prob += (UInt32)3 * ((((processedPos << 8) + dic[(dicPos == 0 ? dicBufSize : dicPos) - 1]) & lpMask) << lc);
+      }
+
+      processedPos++;
+
+      symbol = 1;
+      if (state < kNumLitStates) {
+        state -= (state < 4) ? state : 3;
+        TREE_BIT (prob, symbol);
+        TREE_BIT (prob, symbol);
+        TREE_BIT (prob, symbol);
+        TREE_BIT (prob, symbol);
+        TREE_BIT (prob, symbol);
+        TREE_BIT (prob, symbol);
+        TREE_BIT (prob, symbol);
+        TREE_BIT (prob, symbol);
+      } else {
+        unsigned   matchByte = dic[dicPos - rep0 + (dicPos < rep0 ? dicBufSize : 0)];
+        unsigned   offs      = 0x100;
+        unsigned   bit;
+        CLzmaProb  *probLit;
+
+        state -= (state < 10) ? 3 : 6;
+        MATCHED_LITER_DEC
+        MATCHED_LITER_DEC
+        MATCHED_LITER_DEC
+        MATCHED_LITER_DEC
+        MATCHED_LITER_DEC
+        MATCHED_LITER_DEC
+        MATCHED_LITER_DEC
+        MATCHED_LITER_DEC
+      }
+
+      dic[dicPos++] = (Byte)symbol;
+      continue;
+    }
+
+    {
+      UPDATE_1 (prob);
+      prob = probs + IsRep + state;
+      IF_BIT_0 (prob) {
+        UPDATE_0 (prob);
+        state += kNumStates;
+        prob   = probs + LenCoder;
+      } else {
+        UPDATE_1 (prob);
+        prob = probs + IsRepG0 + state;
+        IF_BIT_0 (prob) {
+          UPDATE_0 (prob);
+          prob = probs + IsRep0Long + COMBINED_PS_STATE;
+          IF_BIT_0 (prob) {
+            UPDATE_0 (prob);
+            dic[dicPos] = dic[dicPos - rep0 + (dicPos < rep0 ? dicBufSize : 0)];
+            dicPos++;
+            processedPos++;
+            state = state < kNumLitStates ? 9 : 11;
+            continue;
+          }
+          UPDATE_1 (prob);
+        } else {
+          UInt32  distance;
+          UPDATE_1 (prob);
+          prob = probs + IsRepG1 + state;
+          IF_BIT_0 (prob) {
+            UPDATE_0 (prob);
+            distance = rep1;
+          } else {
+            UPDATE_1 (prob);
+            prob = probs + IsRepG2 + state;
+            IF_BIT_0 (prob) {
+              UPDATE_0 (prob);
+              distance = rep2;
+            } else {
+              UPDATE_1 (prob);
+              distance = rep3;
+              rep3     = rep2;
+            }
+            rep2 = rep1;
+          }
+          rep1 = rep0;
+          rep0 = distance;
+        }
+        state = state < kNumLitStates ? 8 : 11;
+        prob  = probs + RepLenCoder;
+      }
+
+      {
+        CLzmaProb  *probLen = prob + LenChoice;
+        IF_BIT_0 (probLen) {
+          UPDATE_0 (probLen);
+          probLen = prob + LenLow + GET_LEN_STATE;
+          len     = 1;
+          TREE_BIT (probLen, len);
+          TREE_BIT (probLen, len);
+          TREE_BIT (probLen, len);
+          len -= 8;
+        } else {
+          UPDATE_1 (probLen);
+          probLen = prob + LenChoice2;
+          IF_BIT_0 (probLen) {
+            UPDATE_0 (probLen);
+            probLen = prob + LenLow + GET_LEN_STATE + (1 << kLenNumLowBits);
+            len     = 1;
+            TREE_BIT (probLen, len);
+            TREE_BIT (probLen, len);
+            TREE_BIT (probLen, len);
+          } else {
+            UPDATE_1 (probLen);
+            probLen = prob + LenHigh;
+            len     = 1;
+            TREE_BIT (probLen, len);
+            TREE_BIT (probLen, len);
+            TREE_BIT (probLen, len);
+            TREE_BIT (probLen, len);
+            TREE_BIT (probLen, len);
+            TREE_BIT (probLen, len);
+            TREE_BIT (probLen, len);
+            TREE_BIT (probLen, len);
+            len -= kLenNumHighSymbols - kLenNumLowSymbols * 2;
+          }
+        }
+      }
+
+      if (state >= kNumStates) {
+        UInt32  distance;
+        prob = probs + PosSlot +
+               ((len < kNumLenToPosStates ? len : kNumLenToPosStates - 1) << kNumPosSlotBits);
+        distance = 1;
+        TREE_BIT (prob, distance);
+        TREE_BIT (prob, distance);
+        TREE_BIT (prob, distance);
+        TREE_BIT (prob, distance);
+        TREE_BIT (prob, distance);
+        TREE_BIT (prob, distance);
+        distance -= 0x40;
+        if (distance >= kStartPosModelIndex) {
+          unsigned  posSlot       = (unsigned)distance;
+          unsigned  numDirectBits = (unsigned)(((distance >> 1) - 1));
+          distance = (2 | (distance & 1));
+          if (posSlot < kEndPosModelIndex) {
+            distance <<= numDirectBits;
+            prob       = probs + SpecPos;
+            {
+              UInt32  m = 1;
+              distance++;
+              do {
+                REV_BIT_VAR (prob, distance, m);
+              } while (--numDirectBits);
+
+              distance -= m;
+            }
+          } else {
+            numDirectBits -= kNumAlignBits;
+            do {
+              UInt32  t;
+
+              NORMALIZE;
+              range   >>= 1;
+              code     -= range;
+              t         = (0 - ((UInt32)code >> 31));
+              distance  = (distance << 1) + (t + 1);
+              code     += range & t;
+            } while (--numDirectBits);
+
+            prob       = probs + Align;
+            distance <<= kNumAlignBits;
+            {
+              unsigned  i = 1;
+              REV_BIT (prob, i, 1);
+              REV_BIT (prob, i, 2);
+              REV_BIT (prob, i, 4);
+              REV_BIT_LAST (prob, i, 8);
+              distance |= i;
+            }
+            if (distance == (UInt32)0xFFFFFFFF) {
+              len    = kMatchSpecLenStart;
+              state -= kNumStates;
+              break;
+            }
+          }
+        }
+
+        rep3  = rep2;
+        rep2  = rep1;
+        rep1  = rep0;
+        rep0  = distance + 1;
+        state = (state < kNumStates + kNumLitStates) ? kNumLitStates : kNumLitStates + 3;
+        if (distance >= ((checkDicSize == 0) ? processedPos : checkDicSize)) {
+          p->dicPos = dicPos;
+          return SZ_ERROR_DATA;
+        }
+      }
+
+      len += kMatchMinLen;
+
+      {
+        SizeT     rem;
+        unsigned  curLen;
+        SizeT     pos;
+
+        if ((rem = limit - dicPos) == 0) {
+          p->dicPos = dicPos;
+          return SZ_ERROR_DATA;
+        }
+
+        curLen = ((rem < len) ? (unsigned)rem : len);
+        pos    = dicPos - rep0 + (dicPos < rep0 ? dicBufSize : 0);
+
+        processedPos += (UInt32)curLen;
+
+        len -= curLen;
+        if (curLen <= dicBufSize - pos) {
+          Byte        *dest = dic + dicPos;
+          ptrdiff_t   src   = (ptrdiff_t)pos - (ptrdiff_t)dicPos;
+          const Byte  *lim  = dest + curLen;
+
+          dicPos += (SizeT)curLen;
+          if (curLen >= LZMA_FAST_MIN_BULK_COPY) {
+            //
+            // The source precedes the destination unless the dictionary
+            // wrapped. A match with distance 1 repeats the previous byte, a
+            // match not longer than its distance does not overlap.
+            //
+            if (rep0 == 1) {
+              SetMem (dest, curLen, dest[-1]);
+              continue;
+            }
+
+            if ((src < 0) && ((UInt32)(-src) >= curLen)) {
+              CopyMem (dest, dest + src, curLen);
+              continue;
+            }
+          }
+
+          do {
+            *(dest) = (Byte)*(dest + src);
+          } while (++dest != lim);
+        } else {
+          do {
+            dic[dicPos++] = dic[pos];
+            if (++pos == dicBufSize) {
+              pos = 0;
+            }
+          } while (--curLen != 0);
+        }
+      }
+    }
+  } while (dicPos < limit && buf < bufLimit);
+
+  NORMALIZE;
+
+  p->buf          = buf;
+  p->range        = range;
+  p->code         = code;
+  p->remainLen    = (UInt32)len;
+  p->dicPos       = dicPos;
+  p->processedPos = processedPos;
+  p->reps[0]      = rep0;
+  p->reps[1]      = rep1;
+  p->reps[2]      = rep2;
+  p->reps[3]      = rep3;
+  p->state        = (UInt32)state;
+
+  return SZ_OK;
+}
+
+#endif
@@ -19,6 +19,18 @@ typedef struct {
   UINTN       BufferSize;
 } ISzAllocWithData;
 
+//
+// State of a streaming decode. It is kept at the start of the scratch buffer,
+// the rest of the scratch buffer serves the allocations of the LZMA decoder.
+//
+typedef struct {
+  CLzmaDec            Decoder;
+  ISzAllocWithData    AllocFuncs;
+  CONST UINT8         *Input;
+  SizeT               InputSize;
+  SizeT               DecodedSize;
+} LZMA_DECOMPRESS_STREAM;
+
 /**
   Allocation routine used by LZMA decompression.
 
@@ -155,6 +167,125 @@ LzmaUefiDecompressGetInfo (
   return RETURN_SUCCESS;
 }
 
+/**
+  Starts the streaming decompression of a Lzma compressed source buffer.
+
+  The decompressed data is produced in Destination by successive calls to
+  LzmaUefiDecompressStreamRun(), so the caller may consume the beginning of the
+  output while the rest is still being decoded. The stream state is kept in
+  Scratch, there is nothing to free once the caller is done with it.
+
+  @param  Source      The source buffer containing the compressed data.
+  @param  SourceSize  The size of source buffer.
+  @param  Destination The destination buffer to store the decompressed data. It
+                      must be as large as the size returned by
+                      LzmaUefiDecompressGetInfo().
+  @param  Scratch     A temporary scratch buffer of the size returned by
+                      LzmaUefiDecompressGetInfo().
+  @param  Stream      On output, the stream to pass to LzmaUefiDecompressStreamRun().
+
+  @retval  RETURN_SUCCESS The stream was started.
+  @retval  RETURN_INVALID_PARAMETER
+                          The source buffer specified by Source is corrupted
+                          (not in a valid compressed format).
+**/
+RETURN_STATUS
+EFIAPI
+LzmaUefiDecompressStreamInit (
+  IN  CONST VOID  *Source,
+  IN  UINTN       SourceSize,
+  IN  OUT VOID    *Destination,
+  IN  OUT VOID    *Scratch,
+  OUT VOID        **Stream
+  )
+{
+  LZMA_DECOMPRESS_STREAM  *Private;
+
+  if (SourceSize < LZMA_HEADER_SIZE) {
+    return RETURN_INVALID_PARAMETER;
+  }
+
+  Private                             = (LZMA_DECOMPRESS_STREAM *)Scratch;
+  Private->AllocFuncs.Functions.Alloc = SzAlloc;
+  Private->AllocFuncs.Functions.Free  = SzFree;
+  Private->AllocFuncs.Buffer          = (UINT8 *)Scratch + ALIGN_VALUE (sizeof (LZMA_DECOMPRESS_STREAM), sizeof (UINT64));
+  Private->AllocFuncs.BufferSize      = SCRATCH_BUFFER_REQUEST_SIZE - ALIGN_VALUE (sizeof (LZMA_DECOMPRESS_STREAM), sizeof (UINT64));
+  Private->Input                      = (CONST UINT8 *)Source + LZMA_HEADER_SIZE;
+  Private->InputSize                  = (SizeT)(SourceSize - LZMA_HEADER_SIZE);
+  Private->DecodedSize                = (SizeT)GetDecodedSizeOfBuf ((UINT8 *)Source);
+
+  LzmaDec_Construct (&Private->Decoder);
+  if (LzmaDec_AllocateProbs (&Private->Decoder, Source, LZMA_PROPS_SIZE, &Private->AllocFuncs.Functions) != SZ_OK) {
+    return RETURN_INVALID_PARAMETER;
+  }
+
+  Private->Decoder.dic        = Destination;
+  Private->Decoder.dicBufSize = Private->DecodedSize;
+  LzmaDec_Init (&Private->Decoder);
+
+  *Stream = Private;
+  return RETURN_SUCCESS;
+}
+
+/**
+  Continues the streaming decompression of a Lzma compressed source buffer.
+
+  @param  Stream      The stream returned by LzmaUefiDecompressStreamInit().
+  @param  OutputLimit Decode until this many bytes of Destination are produced.
+                      Values larger than the decompressed size decode the
+                      whole stream.
+  @param  OutputSize  On output, the number of bytes at the start of Destination
+                      that hold decompressed data.
+
+  @retval  RETURN_SUCCESS The whole stream was decompressed.
+  @retval  RETURN_NOT_READY
+                          OutputLimit bytes were produced, the stream is not
+                          finished yet.
+  @retval  RETURN_INVALID_PARAMETER
+                          The source buffer is corrupted (not in a valid
+                          compressed format).
+**/
+RETURN_STATUS
+EFIAPI
+LzmaUefiDecompressStreamRun (
+  IN  VOID   *Stream,
+  IN  UINTN  OutputLimit,
+  OUT UINTN  *OutputSize
+  )
+{
+  LZMA_DECOMPRESS_STREAM  *Private;
+  SRes                    LzmaResult;
+  ELzmaStatus             Status;
+  SizeT                   DicLimit;
+  SizeT                   InputSize;
+
+  Private  = (LZMA_DECOMPRESS_STREAM *)Stream;
+  DicLimit = MIN ((SizeT)OutputLimit, Private->DecodedSize);
+
+  InputSize  = Private->InputSize;
+  LzmaResult = LzmaDec_DecodeToDic (
+                 &Private->Decoder,
+                 DicLimit,
+                 Private->Input,
+                 &InputSize,
+                 (DicLimit == Private->DecodedSize) ? LZMA_FINISH_END : LZMA_FINISH_ANY,
+                 &Status
+                 );
+  Private->Input     += InputSize;
+  Private->InputSize -= InputSize;
+  *OutputSize         = Private->Decoder.dicPos;
+
+  if ((LzmaResult != SZ_OK) || (Status == LZMA_STATUS_NEEDS_MORE_INPUT)) {
+    return RETURN_INVALID_PARAMETER;
+  }
+
+  if (Private->Decoder.dicPos < Private->DecodedSize) {
+    return RETURN_NOT_READY;
+  }
+
+  return RETURN_SUCCESS;
+}
+
 /**
   Decompresses a Lzma compressed source buffer.
 
@@ -186,35 +317,14 @@ LzmaUefiDecompress (
   IN OUT VOID    *Scratch
   )
 {
-  SRes              LzmaResult;
-  ELzmaStatus       Status;
-  SizeT             DecodedBufSize;
-  SizeT             EncodedDataSize;
-  ISzAllocWithData  AllocFuncs;
-
-  AllocFuncs.Functions.Alloc = SzAlloc;
-  AllocFuncs.Functions.Free  = SzFree;
-  AllocFuncs.Buffer          = Scratch;
-  AllocFuncs.BufferSize      = SCRATCH_BUFFER_REQUEST_SIZE;
-
-  DecodedBufSize  = (SizeT)GetDecodedSizeOfBuf ((UINT8 *)Source);
-  EncodedDataSize = (SizeT)(SourceSize - LZMA_HEADER_SIZE);
-
-  LzmaResult = LzmaDecode (
-                 Destination,
-                 &DecodedBufSize,
-                 (Byte *)((UINT8 *)Source + LZMA_HEADER_SIZE),
-                 &EncodedDataSize,
-                 Source,
-                 LZMA_PROPS_SIZE,
-                 LZMA_FINISH_END,
-                 &Status,
-                 &(AllocFuncs.Functions)
-                 );
+  RETURN_STATUS  Status;
+  VOID           *Stream;
+  UINTN          OutputSize;
 
-  if (LzmaResult == SZ_OK) {
-    return RETURN_SUCCESS;
-  } else {
-    return RETURN_INVALID_PARAMETER;
+  Status = LzmaUefiDecompressStreamInit (Source, SourceSize, Destination, Scratch, &Stream);
+  if (RETURN_ERROR (Status)) {
+    return Status;
   }
+
+  return LzmaUefiDecompressStreamRun (Stream, MAX_UINTN, &OutputSize);
 }
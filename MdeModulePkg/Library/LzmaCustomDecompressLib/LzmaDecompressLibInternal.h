@@ -91,4 +91,62 @@ LzmaUefiDecompress (
   IN OUT VOID    *Scratch
   );
 
+/**
+  Starts the streaming decompression of a Lzma compressed source buffer.
+
+  The decompressed data is produced in Destination by successive calls to
+  LzmaUefiDecompressStreamRun(), so the caller may consume the beginning of the
+  output while the rest is still being decoded. The stream state is kept in
+  Scratch, there is nothing to free once the caller is done with it.
+
+  @param  Source      The source buffer containing the compressed data.
+  @param  SourceSize  The size of source buffer.
+  @param  Destination The destination buffer to store the decompressed data. It
+                      must be as large as the size returned by
+                      LzmaUefiDecompressGetInfo().
+  @param  Scratch     A temporary scratch buffer of the size returned by
+                      LzmaUefiDecompressGetInfo().
+  @param  Stream      On output, the stream to pass to LzmaUefiDecompressStreamRun().
+
+  @retval  RETURN_SUCCESS The stream was started.
+  @retval  RETURN_INVALID_PARAMETER
+                          The source buffer specified by Source is corrupted
+                          (not in a valid compressed format).
+**/
+RETURN_STATUS
+EFIAPI
+LzmaUefiDecompressStreamInit (
+  IN  CONST VOID  *Source,
+  IN  UINTN       SourceSize,
+  IN  OUT VOID    *Destination,
+  IN  OUT VOID    *Scratch,
+  OUT VOID        **Stream
+  );
+
+/**
+  Continues the streaming decompression of a Lzma compressed source buffer.
+
+  @param  Stream      The stream returned by LzmaUefiDecompressStreamInit().
+  @param  OutputLimit Decode until this many bytes of Destination are produced.
+                      Values larger than the decompressed size decode the
+                      whole stream.
+  @param  OutputSize  On output, the number of bytes at the start of Destination
+                      that hold decompressed data.
+
+  @retval  RETURN_SUCCESS The whole stream was decompressed.
+  @retval  RETURN_NOT_READY
+                          OutputLimit bytes were produced, the stream is not
+                          finished yet.
+  @retval  RETURN_INVALID_PARAMETER
+                          The source buffer is corrupted (not in a valid
+                          compressed format).
+**/
+RETURN_STATUS
+EFIAPI
+LzmaUefiDecompressStreamRun (
+  IN  VOID   *Stream,
+  IN  UINTN  OutputLimit,
+  OUT UINTN  *OutputSize
+  );
+
 #endif
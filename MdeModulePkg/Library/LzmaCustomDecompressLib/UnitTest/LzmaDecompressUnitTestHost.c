@@ -0,0 +1,804 @@
+/** @file
+  Host-based unit test and benchmark of the LZMA decompress library.
+
+  The test decompresses a vector generated by TestGeneratePlainText () and
+  compressed with the BaseTools LzmaCompress tool, and checks the output
+  byte for byte. It is built twice: LzmaDecompressUnitTestHost.inf links the
+  generic decode loop of the LZMA SDK, LzmaDecFastUnitTestHost.inf links the
+  LzmaDecFast.c loop selected by _LZMA_DEC_OPT. Both must produce the same
+  output and reject the same corrupted input, and the throughput reported by
+  the two builds compares the loops.
+
+  Copyright (c) 2026, Intel Corporation. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <time.h>
+#include <cmocka.h>
+
+#include "LzmaDecompressLibInternal.h"
+
+#include <Library/MemoryAllocationLib.h>
+#include <Library/UnitTestLib.h>
+
+#define UNIT_TEST_APP_NAME     "LZMA Decompress Library Unit Tests"
+#define UNIT_TEST_APP_VERSION  "1.0"
+
+#define TEST_PLAIN_TEXT_SIZE     0xC000
+#define TEST_HEADER_SIZE         13
+#define TEST_GUARD_SIZE          64
+#define TEST_GUARD_BYTE          0xA5
+#define TEST_STREAM_STEP         1531
+#define TEST_CORRUPTION_ROUNDS   256
+#define TEST_THROUGHPUT_ROUNDS   400
+
+//
+// Plain text generated by TestGeneratePlainText (), compressed with
+// "LzmaCompress -e".
+//
+STATIC CONST UINT8  mTestCompressed[] = {
+  0x5D, 0x00, 0x00, 0x00, 0x01, 0x00, 0xC0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x28, 0x1C,
+  0x89, 0xE7, 0x77, 0xF5, 0x8E, 0x0C, 0x6D, 0x11, 0x03, 0x14, 0x56, 0x51, 0x4C, 0x96, 0x42, 0xE6,
+  0x48, 0xAD, 0xCD, 0x6D, 0xD1, 0x59, 0x97, 0xB0, 0x91, 0x77, 0x18, 0x98, 0x68, 0xB6, 0x2C, 0x75,
+  0x0A, 0xF7, 0x73, 0x49, 0x06, 0xE6, 0xCF, 0x1C, 0xB2, 0xEB, 0xA9, 0xF9, 0x78, 0x06, 0x0E, 0xF2,
+  0x5C, 0x90, 0xEA, 0x95, 0x8E, 0xAD, 0x17, 0x4B, 0xD8, 0xB9, 0xDF, 0xF4, 0xEE, 0xF3, 0x0F, 0xC7,
+  0x71, 0x4E, 0x1D, 0x7C, 0x3A, 0xF3, 0x48, 0xE9, 0xA7, 0x07, 0x25, 0xC9, 0x84, 0x43, 0x59, 0x03,
+  0xB8, 0xEF, 0xF3, 0xED, 0x06, 0x1F, 0x9F, 0x1E, 0xB1, 0x93, 0x47, 0x16, 0x75, 0x32, 0x62, 0x7A,
+  0x55, 0xEB, 0x32, 0xDD, 0x3D, 0x50, 0xC2, 0x14, 0xBE, 0xEF, 0x7A, 0x3D, 0x93, 0xA5, 0x73, 0xA3,
+  0x12, 0x29, 0x7E, 0x80, 0xB1, 0x33, 0x2F, 0x53, 0x98, 0x9D, 0xFF, 0x90, 0x65, 0xD2, 0x83, 0xE4,
+  0x2C, 0xAC, 0x0C, 0x71, 0x23, 0x68, 0xBE, 0x34, 0x12, 0xFE, 0xA1, 0xAB, 0x7A, 0xC3, 0x34, 0xB2,
+  0x84, 0xD0, 0x58, 0x2B, 0x19, 0x2B, 0xA9, 0x76, 0xAA, 0x00, 0xD0, 0xE1, 0x4D, 0xDE, 0xD2, 0xD6,
+  0x07, 0x95, 0x83, 0x72, 0xCC, 0x15, 0xF6, 0xCF, 0xFD, 0x5E, 0xE0, 0x6A, 0x53, 0xC8, 0xD0, 0x9A,
+  0x62, 0x8B, 0x56, 0x86, 0x27, 0x77, 0x03, 0x72, 0x9F, 0xC7, 0x02, 0xFF, 0x74, 0x43, 0x25, 0xFC,
+  0x66, 0x72, 0x35, 0x61, 0x75, 0xD8, 0x32, 0x0D, 0x34, 0x83, 0xE0, 0x5E, 0xC3, 0x7F, 0xBD, 0xA5,
+  0xCB, 0x41, 0x48, 0xF9, 0x58, 0xEC, 0xEF, 0x20, 0xA4, 0x2B, 0xB8, 0xB8, 0x6D, 0xBF, 0x3A, 0x89,
+  0x9B, 0x8B, 0xAB, 0x1F, 0x64, 0xD7, 0x0F, 0x23, 0x48, 0x0A, 0x6B, 0xA5, 0x03, 0x61, 0x00, 0x5D,
+  0x45, 0xEC, 0x83, 0xF9, 0xF5, 0x0B, 0x8B, 0xC6, 0x79, 0xE9, 0x7A, 0xD2, 0xA8, 0x8A, 0x75, 0xB9,
+  0x0A, 0xAD, 0x1C, 0xB9, 0xFF, 0x4A, 0x93, 0x89, 0xC1, 0xBE, 0x37, 0xBE, 0x6B, 0xBD, 0xDD, 0xD6,
+  0xAA, 0xCA, 0xAB, 0x1C, 0x8E, 0xE6, 0x0B, 0x68, 0x9D, 0x93, 0xA0, 0x7A, 0xC5, 0x96, 0x42, 0xC4,
+  0xD3, 0x5C, 0xC5, 0x52, 0xA9, 0xD7, 0x40, 0xD5, 0x11, 0x27, 0xD8, 0xBE, 0xE9, 0x39, 0x0D, 0x43,
+  0x11, 0x33, 0x12, 0xBE, 0xAE, 0x96, 0xD4, 0xBE, 0x97, 0x1D, 0xFC, 0xCC, 0x7E, 0x48, 0x32, 0x58,
+  0xE2, 0x1E, 0x9F, 0xF7, 0x22, 0x32, 0x0A, 0xB9, 0xA7, 0x67, 0xB5, 0xFD, 0x34, 0x6F, 0x53, 0xA3,
+  0x83, 0xAD, 0xF6, 0x06, 0xE4, 0x82, 0xCD, 0x2C, 0x69, 0x79, 0x85, 0x60, 0xE1, 0x5B, 0xE2, 0x52,
+  0x77, 0x91, 0x43, 0x0F, 0x8B, 0x3B, 0x04, 0x64, 0xA0, 0xC7, 0x83, 0x5E, 0x6F, 0x88, 0x44, 0x2C,
+  0x49, 0xB7, 0xD1, 0x93, 0x83, 0xDB, 0xBA, 0x68, 0xAA, 0xFF, 0x1F, 0x66, 0xF2, 0xE0, 0x2C, 0x40,
+  0x4B, 0xCE, 0xB8, 0x48, 0x0D, 0xD2, 0xFB, 0x0E, 0xD3, 0xB4, 0x12, 0x2F, 0xDA, 0x42, 0x00, 0x16,
+  0xFC, 0x4A, 0x6D, 0x33, 0xAF, 0x48, 0x17, 0xC0, 0x29, 0x6C, 0x15, 0xF8, 0x90, 0xEF, 0x58, 0xB4,
+  0x35, 0x17, 0x84, 0xF9, 0x83, 0xF3, 0x43, 0xC3, 0xA2, 0xCE, 0xEA, 0x62, 0x29, 0x67, 0xF2, 0xB9,
+  0x97, 0x34, 0xC2, 0x17, 0xF2, 0xDE, 0x7C, 0x52, 0xC4, 0xB4, 0xEC, 0xAE, 0xD1, 0x92, 0x0B, 0xF8,
+  0x59, 0x05, 0x67, 0x7F, 0xE1, 0x73, 0x13, 0x06, 0x58, 0x3D, 0xDB, 0xCA, 0x46, 0x25, 0xA1, 0x25,
+  0xFD, 0x57, 0x94, 0x1B, 0xA6, 0x33, 0xF0, 0xF8, 0x88, 0xCD, 0x79, 0xF1, 0x42, 0x22, 0x3D, 0xA8,
+  0x74, 0xA9, 0xC9, 0x13, 0xE5, 0x6B, 0xBA, 0xCB, 0xB3, 0x52, 0x2D, 0x69, 0xE7, 0x84, 0xEE, 0x88,
+  0xC0, 0xA0, 0x60, 0x2B, 0xB1, 0xF4, 0xFE, 0x1A, 0x36, 0xDA, 0x88, 0x24, 0x9B, 0x4A, 0x4C, 0x97,
+  0x51, 0x67, 0xCA, 0xCF, 0xAA, 0xA3, 0x3D, 0x69, 0xA8, 0x1E, 0x83, 0x5B, 0x38, 0x77, 0x43, 0x54,
+  0x51, 0x57, 0x53, 0xAC, 0x05, 0xEE, 0x83, 0x73, 0xEE, 0x43, 0x65, 0xF0, 0x60, 0xCB, 0xED, 0xD6,
+  0x27, 0xB3, 0xC2, 0xE3, 0xA6, 0x5C, 0x17, 0x35, 0x53, 0x4A, 0x75, 0xE7, 0x77, 0xFF, 0xEA, 0x3B,
+  0xA2, 0x6B, 0x4C, 0xB6, 0x7A, 0x33, 0x50, 0x73, 0x74, 0xEF, 0xBE, 0xF6, 0xF3, 0x2B, 0xEE, 0x2D,
+  0xCC, 0x92, 0xB1, 0x72, 0x48, 0x00, 0x2D, 0x96, 0x21, 0x25, 0xE9, 0xB9, 0x6F, 0x35, 0xCD, 0xD4,
+  0x0A, 0xD0, 0x08, 0x92, 0xFB, 0x34, 0x2A, 0xFB, 0xEE, 0xD5, 0xDB, 0xC1, 0x8A, 0x0B, 0x7A, 0x51,
+  0x87, 0x3A, 0xCF, 0x64, 0x09, 0x95, 0x3C, 0x79, 0xD9, 0x4E, 0x8E, 0x5C, 0xDD, 0x9A, 0x39, 0xE5,
+  0x2D, 0x1A, 0xC9, 0x86, 0x8D, 0xA6, 0xC2, 0x2F, 0xE9, 0x30, 0x5E, 0x86, 0x2F, 0x48, 0x61, 0x16,
+  0xDE, 0x0B, 0x81, 0xF3, 0xCE, 0x26, 0x34, 0xFD, 0x40, 0xC3, 0xB4, 0x06, 0xCD, 0x68, 0x8D, 0xB4,
+  0x52, 0x04, 0x81, 0xC6, 0x1D, 0x50, 0x43, 0xD8, 0xAF, 0x01, 0xCB, 0x94, 0xD2, 0xB8, 0xE5, 0x74,
+  0x70, 0xD7, 0x48, 0x82, 0x74, 0x14, 0x86, 0xC0, 0x00, 0x13, 0x73, 0x27, 0xEF, 0xEA, 0xA7, 0xC5,
+  0xE3, 0xB9, 0x63, 0xEF, 0x4B, 0xE4, 0x94, 0x75, 0x68, 0x91, 0x09, 0x36, 0x4E, 0xDE, 0x98, 0x6C,
+  0xE7, 0x6D, 0x11, 0xFE, 0x79, 0xFF, 0x39, 0xB5, 0xF9, 0x84, 0x6C, 0x65, 0x28, 0x66, 0xCF, 0x28,
+  0x0F, 0xAF, 0xAC, 0x48, 0x4C, 0xDC, 0xA5, 0x62, 0xC6, 0x67, 0x48, 0x3C, 0x5B, 0xDA, 0xF6, 0x5F,
+  0x84, 0x1D, 0x64, 0x2E, 0x29, 0xD1, 0xB8, 0x7A, 0x46, 0x92, 0x8A, 0xB4, 0xDA, 0x76, 0xF1, 0x88,
+  0xD9, 0x58, 0xCF, 0x99, 0x4C, 0x7B, 0x0C, 0x33, 0xE7, 0xFF, 0x6E, 0x34, 0xEB, 0x63, 0x0B, 0x1A,
+  0x34, 0x35, 0x4C, 0xF4, 0x49, 0xAC, 0x7E, 0x27, 0x3B, 0xC1, 0xE4, 0x99, 0x79, 0x80, 0xBA, 0x0B,
+  0x7A, 0x01, 0x14, 0xC8, 0x86, 0xEE, 0x77, 0xEB, 0x02, 0x50, 0x29, 0xB3, 0x61, 0xF1, 0xB3, 0x57,
+  0x45, 0xB5, 0x5D, 0x8E, 0x8C, 0xBD, 0x69, 0xBE, 0xF1, 0x2C, 0x2B, 0x41, 0xA2, 0xD8, 0x0B, 0xEF,
+  0x00, 0xE1, 0xC9, 0x34, 0xDA, 0xEA, 0xB8, 0x16, 0x41, 0xDB, 0x8A, 0xDB, 0x2F, 0xB7, 0x28, 0x17,
+  0x4B, 0x4C, 0x82, 0x6A, 0xB2, 0x35, 0x0A, 0x0D, 0x50, 0xF0, 0xDE, 0x74, 0xF9, 0xBC, 0x5B, 0x22,
+  0x09, 0x10, 0x0E, 0x7F, 0x8E, 0xD4, 0x45, 0x42, 0x66, 0x4D, 0xBF, 0x6A, 0x36, 0x48, 0xED, 0x20,
+  0x09, 0xB6, 0x7A, 0xEC, 0xC9, 0x1F, 0xEE, 0x0C, 0xFB, 0x3E, 0xC2, 0xFD, 0x2A, 0x7B, 0x5C, 0x78,
+  0x25, 0xCB, 0x0D, 0xBA, 0x03, 0x60, 0x95, 0x3C, 0x37, 0x95, 0x90, 0xD7, 0x09, 0x68, 0xF2, 0x96,
+  0x16, 0xC1, 0x6E, 0x9B, 0x3A, 0x11, 0x50, 0x89, 0x97, 0x14, 0x4D, 0x29, 0x32, 0xCF, 0x6D, 0x88,
+  0xB9, 0xBE, 0x9B, 0x1E, 0x75, 0x89, 0x18, 0x3D, 0xCF, 0xDB, 0x4E, 0x37, 0xA0, 0xB7, 0x81, 0x8F,
+  0xF0, 0xEC, 0x44, 0xB6, 0x1B, 0xFC, 0x18, 0x25, 0x21, 0x63, 0xC1, 0xBF, 0x68, 0x66, 0xA3, 0x07,
+  0x2E, 0xB5, 0x51, 0xB4, 0x2E, 0x10, 0x18, 0x59, 0xDD, 0xC7, 0x8A, 0x86, 0x40, 0x6F, 0xBC, 0x47,
+  0xC0, 0x98, 0x2A, 0x52, 0x93, 0xE8, 0x2D, 0x2F, 0x6C, 0xFB, 0xA3, 0x9B, 0x33, 0x30, 0x58, 0xF5,
+  0x4A, 0x4A, 0x1D, 0xD9, 0x7B, 0x92, 0x47, 0x01, 0xE3, 0x5E, 0x28, 0x4A, 0x53, 0xE5, 0xC9, 0xEA,
+  0xF4, 0x86, 0xEA, 0x5C, 0xFB, 0xB7, 0xE3, 0xA1, 0x96, 0x4E, 0x62, 0x84, 0x72, 0x3D, 0xE8, 0xD5,
+  0xAF, 0x2D, 0xFB, 0x8E, 0xFD, 0x6F, 0xD2, 0xD9, 0x04, 0x61, 0x04, 0xE5, 0x01, 0x38, 0x3F, 0x29,
+  0xE4, 0xE5, 0xB2, 0xC9, 0x02, 0xEC, 0x95, 0xC4, 0x32, 0x31, 0x23, 0x5A, 0x95, 0x29, 0x88, 0xEE,
+  0xBC, 0x54, 0x20, 0xF1, 0xB1, 0x85, 0x6A, 0x1C, 0xB1, 0x40, 0xE9, 0xF8, 0x7F, 0x98, 0x0F, 0xA6,
+  0x68, 0x3B, 0xB3, 0x63, 0x2F, 0x79, 0x77, 0x75, 0xDC, 0xDE, 0xCA, 0x57, 0x32, 0x0F, 0x55, 0x51,
+  0xE9, 0x57, 0x72, 0xBF, 0x4C, 0x9A, 0x86, 0xCC, 0x5A, 0x17, 0x3E, 0x62, 0x24, 0xB4, 0x88, 0x0A,
+  0x77, 0xEB, 0xE1, 0xFE, 0x7B, 0x6A, 0x17, 0xD9, 0xD8, 0x80, 0x61, 0x6C, 0x3B, 0xF1, 0xBB, 0x11,
+  0x30, 0x4C, 0xD1, 0x48, 0xA8, 0x9B, 0xA1, 0xE5, 0x05, 0x41, 0xDD, 0x4F, 0x43, 0x36, 0x29, 0x78,
+  0x00, 0x0C, 0x3A, 0xCE, 0xDB, 0x88, 0xD0, 0xC3, 0x10, 0x4D, 0x7C, 0xB3, 0xDD, 0x0F, 0xF5, 0x13,
+  0xBC, 0x36, 0x3F, 0x75, 0x37, 0x7C, 0x14, 0xCC, 0x24, 0xA8, 0x39, 0x1E, 0x68, 0xCF, 0xCE, 0xD3,
+  0x13, 0x12, 0xD0, 0xD7, 0x4D, 0x55, 0xCA, 0x96, 0x1E, 0x0B, 0x57, 0x59, 0x84, 0x3A, 0x36, 0xA5,
+  0x21, 0x9C, 0x4D, 0xA8, 0xB0, 0x80, 0x0A, 0x89, 0x9F, 0x40, 0x08, 0xF8, 0x0F, 0xCB, 0x9E, 0x14,
+  0x81, 0xB3, 0xB5, 0x7C, 0xD4, 0x6A, 0x28, 0x51, 0x74, 0x18, 0xC2, 0xC6, 0x4E, 0xC6, 0x48, 0xCC,
+  0x30, 0xFD, 0x2B, 0x44, 0x71, 0xA9, 0x65, 0xE8, 0x4B, 0x99, 0x12, 0xCC, 0x62, 0x4C, 0x7D, 0x6A,
+  0x48, 0x60, 0x2F, 0xA4, 0xBF, 0x32, 0xD5, 0xAE, 0xF0, 0xED, 0x01, 0xF6, 0x91, 0x58, 0x88, 0xE1,
+  0x44, 0xF2, 0x5D, 0xA1, 0x04, 0x0B, 0x0F, 0x6A, 0x83, 0xD4, 0x6E, 0x0B, 0x1B, 0x77, 0x98, 0x28,
+  0xA3, 0xDA, 0x19, 0x15, 0xD5, 0x08, 0x81, 0xA3, 0x11, 0xB2, 0x3C, 0xCF, 0x70, 0x09, 0x02, 0x60,
+  0x78, 0x6B, 0x54, 0x61, 0x64, 0xE8, 0x29, 0x30, 0xF1, 0x6B, 0xDC, 0xC2, 0xE2, 0xAB, 0x0D, 0xF7,
+  0xA3, 0x52, 0x62, 0x46, 0x63, 0x41, 0x86, 0x3E, 0xEE, 0x60, 0xC3, 0x21, 0xC6, 0xA7, 0xCB, 0xD2,
+  0xC5, 0x13, 0x68, 0xAD, 0xDA, 0xE2, 0x12, 0xBC, 0xEE, 0xB2, 0x70, 0xA2, 0xB4, 0x17, 0x9A, 0x65,
+  0x30, 0x70, 0x5B, 0x25, 0x47, 0x18, 0xEA, 0xEE, 0x45, 0x03, 0x21, 0x56, 0x02, 0xEE, 0x01, 0x42,
+  0xF8, 0x80, 0x6F, 0x44, 0xC2, 0x85, 0x85, 0x25, 0x12, 0xDD, 0xF9, 0x61, 0x5D, 0x15, 0xD3, 0xD3,
+  0x96, 0x85, 0xF5, 0x09, 0x1F, 0x5C, 0x01, 0xA6, 0x61, 0x37, 0x71, 0x73, 0xA4, 0xFB, 0xFA, 0x4D,
+  0x00, 0x3C, 0x80, 0x5A, 0x46, 0xC6, 0xA8, 0x9E, 0xF4, 0x35, 0x4D, 0xA4, 0xFE, 0xD0, 0x6A, 0xE4,
+  0x70, 0xB7, 0x5C, 0xC2, 0xA1, 0x5D, 0xCC, 0x53, 0xA6, 0xC1, 0xE5, 0x53, 0xE6, 0x07, 0x3A, 0x4C,
+  0xDB, 0x10, 0xF9, 0xEE, 0x80, 0x61, 0xEB, 0xD7, 0xFE, 0x87, 0x05, 0xC1, 0x9F, 0x06, 0xB7, 0xDD,
+  0xC3, 0xD9, 0xE8, 0x2A, 0x6A, 0x6E, 0xD0, 0xD6, 0x18, 0xD1, 0xA6, 0x4A, 0xB3, 0xB6, 0xBD, 0x4B,
+  0xBE, 0xC9, 0xAA, 0xC2, 0xB1, 0xAF, 0x24, 0x18, 0xDC, 0x60, 0x19, 0x71, 0x1E, 0x8C, 0x2F, 0x37,
+  0x58, 0xE7, 0x60, 0x62, 0x03, 0x77, 0x7A, 0x5E, 0xE4, 0xBE, 0x19, 0xED, 0xA3, 0x74, 0x50, 0xED,
+  0x51, 0x04, 0x1D, 0x14, 0xBD, 0x41, 0xF8, 0x9E, 0x86, 0xFC, 0xB8, 0x73, 0xE4, 0x1A, 0x92, 0x1A,
+  0xC9, 0x0C, 0x8A, 0xA5, 0x99, 0xAB, 0x90, 0x3E, 0x4C, 0xE8, 0x88, 0xB7, 0xDB, 0x30, 0x60, 0xB1,
+  0x60, 0x1E, 0x67, 0x0E, 0x9D, 0xC9, 0x57, 0x91, 0xB8, 0xDD, 0xAD, 0xCA, 0x4B, 0xA2, 0x41, 0xDE,
+  0x3A, 0x7A, 0xAC, 0xF5, 0xD6, 0x0C, 0x73, 0xE1, 0xA9, 0xCD, 0xE1, 0x25, 0xA6, 0xB5, 0x52, 0x4A,
+  0x09, 0x01, 0xED, 0x82, 0x02, 0xB5, 0xBC, 0xD6, 0xEB, 0x56, 0x22, 0x37, 0xDC, 0xF7, 0x93, 0x4D,
+  0xFA, 0x96, 0xA4, 0x96, 0xAD, 0xA6, 0xDB, 0x87, 0xF6, 0x5B, 0xBE, 0xBE, 0x2C, 0xFF, 0x45, 0x76,
+  0x2E, 0xA4, 0x83, 0x5A, 0x55, 0xA6, 0x90, 0xDA, 0x2F, 0x77, 0xF5, 0xB9, 0x71, 0x85, 0x24, 0xB5,
+  0x66, 0xA3, 0xD9, 0xEC, 0xC4, 0x14, 0xB1, 0x90, 0xE2, 0x21, 0xCD, 0x9D, 0x17, 0x8C, 0xAA, 0x2B,
+  0x8D, 0x65, 0x9F, 0xEB, 0x82, 0x32, 0x4E, 0x60, 0x76, 0x6E, 0xA1, 0x32, 0xA4, 0x87, 0xDA, 0xF0,
+  0x6B, 0x18, 0x0C, 0xD6, 0x23, 0x44, 0x20, 0xAB, 0xA9, 0x33, 0x48, 0x6F, 0xAE, 0x24, 0x31, 0x64,
+  0x5F, 0x4E, 0xB4, 0x39, 0x53, 0x0E, 0xF7, 0x23, 0xA0, 0x78, 0x16, 0x20, 0x0C, 0xB9, 0x26, 0xAF,
+  0xB2, 0x57, 0xE3, 0x76, 0x74, 0xC1, 0x18, 0x35, 0x9A, 0x20, 0x60, 0x8D, 0x47, 0x32, 0xC7, 0x98,
+  0xA0, 0x60, 0x63, 0x3F, 0xA0, 0x3A, 0xE0, 0x20, 0x23, 0xD1, 0xB5, 0x72, 0x7F, 0x67, 0x85, 0x11,
+  0x83, 0x54, 0xF1, 0x64, 0x15, 0x9F, 0x14, 0x30, 0xCA, 0x48, 0x64, 0x4D, 0xC2, 0x56, 0x03, 0x40,
+  0x9F, 0xF6, 0x52, 0x56, 0x08, 0x3A, 0xA8, 0xC3, 0xDC, 0x2D, 0x86, 0xFE, 0x2D, 0x5E, 0x3A, 0xDC,
+  0xC5, 0x16, 0x4C, 0xE9, 0xD7, 0x88, 0x01, 0x87, 0xAF, 0xBB, 0x02, 0xC0, 0x15, 0xE6, 0x74, 0xF9,
+  0x07, 0xC2, 0xA8, 0x46, 0x46, 0x7F, 0x56, 0x00, 0x97, 0x26, 0x7D, 0x5C, 0x06, 0xED, 0xDD, 0x87,
+  0x7E, 0xEB, 0x72, 0xFC, 0x2A, 0xF9, 0xA0, 0xD8, 0x48, 0x04, 0x7E, 0x6B, 0x97, 0xD4, 0x5D, 0xF4,
+  0x21, 0x6B, 0x3F, 0xC8, 0xD7, 0xD7, 0xDC, 0xF2, 0xA1, 0xE0, 0xF9, 0xEE, 0x46, 0x70, 0x3D, 0x03,
+  0xFD, 0xF6, 0xC1, 0x99, 0xC0, 0xDD, 0x96, 0x89, 0x81, 0xE7, 0xDF, 0xDF, 0xB2, 0x09, 0x22, 0x81,
+  0x57, 0x82, 0x3A, 0x27, 0xED, 0xD0, 0x8C, 0x88, 0x3B, 0x91, 0x7B, 0x97, 0xE6, 0xE4, 0x1A, 0xE0,
+  0x81, 0x34, 0xED, 0x68, 0xF7, 0x93, 0x6D, 0xE7, 0x69, 0xC2, 0xC6, 0x28, 0x6D, 0xD0, 0x3A, 0x58,
+  0x2D, 0xA6, 0xC0, 0xDF, 0x4C, 0x57, 0x25, 0x56, 0x24, 0xB1, 0xC0, 0x06, 0x29, 0x78, 0xA3, 0x27,
+  0xCE, 0x81, 0xAB, 0x55, 0x0B, 0xA2, 0x0C, 0x46, 0x40, 0xF9, 0x8A, 0x0A, 0xF3, 0x01, 0xEC, 0x97,
+  0x04, 0x80, 0x56, 0x3E, 0x02, 0x8C, 0x07, 0xC6, 0x3C, 0xCC, 0x93, 0xCB, 0x9A, 0x53, 0x66, 0xC0,
+  0x23, 0x2E, 0x97, 0xFE, 0xBC, 0xF4, 0x0D, 0x86, 0x88, 0x8E, 0x48, 0xEB, 0x3C, 0xAC, 0x97, 0xF2,
+  0x07, 0x1D, 0x1B, 0x71, 0x61, 0x83, 0x49, 0xF3, 0xBB, 0x43, 0x9E, 0x22, 0xA3, 0xD7, 0x55, 0x80,
+  0xC3, 0x50, 0x36, 0xC8, 0x85, 0x45, 0xC5, 0xF8, 0x0A, 0xC4, 0xB6, 0x36, 0x11, 0x8E, 0xAC, 0xF5,
+  0xB9, 0x1C, 0x2B, 0xAB, 0x9C, 0x39, 0x9D, 0x46, 0xD6, 0x31, 0xF8, 0x38, 0x56, 0x36, 0x31, 0x72,
+  0xA0, 0xE3, 0xBA, 0x52, 0x51, 0xE2, 0xA7, 0x7E, 0x1D, 0xDB, 0x79, 0x41, 0xCB, 0xFF, 0x50, 0x01,
+  0x3C, 0x2D, 0xAD, 0x7F, 0x1D, 0xB0, 0xAF, 0x20, 0x04, 0xD3, 0x9A, 0x07, 0xBD, 0x4E, 0xD0, 0x2C,
+  0x92, 0x46, 0x2E, 0xEA, 0x39, 0x91, 0xF5, 0x81, 0x5E, 0x3D, 0x60, 0x6D, 0x32, 0x0F, 0x45, 0xF0,
+  0xBB, 0xA7, 0xAA, 0x17, 0x9A, 0xBF, 0x56, 0xD0, 0x2B, 0x35, 0x31, 0x27, 0x78, 0x9E, 0x5F, 0xED,
+  0xEF, 0xBD, 0x2D, 0xA2, 0x33, 0x9B, 0x99, 0x58, 0xFA, 0xEF, 0xA6, 0x64, 0xE4, 0x92, 0xDC, 0x86,
+  0x5D, 0x32, 0x77, 0xEE, 0xA7, 0xA9, 0xA3, 0x3A, 0x12, 0x56, 0xFD, 0xF9, 0x2D, 0xC1, 0xB0, 0xB5,
+  0x25, 0x4F, 0x9D, 0xAB, 0x9D, 0x4A, 0xBA, 0x8A, 0xBF, 0x9F, 0xC8, 0x79, 0x8F, 0x7E, 0x7F, 0x0C,
+  0x53, 0x51, 0xA9, 0x03, 0x0D, 0x14, 0xC6, 0xA0, 0xDC, 0x0D, 0xE1, 0xA4, 0xC0, 0x62, 0xE5, 0xC0,
+  0xAF, 0xA8, 0x97, 0xDE, 0x06, 0xB4, 0x02, 0x84, 0x22, 0x7C, 0x0E, 0x28, 0xA3, 0x97, 0x7F, 0x51,
+  0xA1, 0xCF, 0x08, 0x60, 0x01, 0xC0, 0xE4, 0xC9, 0xD7, 0x14, 0x71, 0x94, 0xC6, 0x4E, 0x50, 0x49,
+  0x91, 0xBE, 0xF8, 0xB3, 0x73, 0x18, 0xFD, 0x2E, 0x0E, 0x93, 0x24, 0x42, 0x24, 0x7D, 0x1D, 0x7F,
+  0x48, 0xA1, 0x19, 0x16, 0xA7, 0xD4, 0x29, 0xE3, 0xCC, 0x30, 0x01, 0xA1, 0x6A, 0xE5, 0xCA, 0x97,
+  0xD6, 0x95, 0x3F, 0xD3, 0xEE, 0x84, 0xFB, 0x6B, 0x0B, 0x48, 0x4A, 0xE5, 0x6A, 0x6A, 0x55, 0xFF,
+  0xD0, 0x04, 0xE9, 0xFD, 0xC3, 0x83, 0x9E, 0x24, 0xEC, 0x6E, 0x08, 0xA5, 0xCF, 0xBC, 0x10, 0x6B,
+  0x0C, 0xA7, 0xF2, 0xFE, 0x5A, 0x4E, 0xB9, 0xD8, 0x66, 0x12, 0x9F, 0xB7, 0xA1, 0x34, 0xC9, 0x31,
+  0xFA, 0xD1, 0xF7, 0x35, 0x89, 0x2E, 0xFA, 0x09, 0xDB, 0x37, 0x8D, 0xE7, 0x10, 0x49, 0x34, 0x55,
+  0xD6, 0xF1, 0x15, 0x51, 0xAD, 0x51, 0xB4, 0xEE, 0xCC, 0x4E, 0xB1, 0x8F, 0x26, 0x77, 0x2B, 0x01,
+  0x47, 0x9E, 0x32, 0x62, 0x1D, 0xEE, 0x35, 0x6F, 0xF9, 0x5B, 0x74, 0xE0, 0x4F, 0xBA, 0xB3, 0x66,
+  0x60, 0x5B, 0xCC, 0x15, 0xA4, 0xD2, 0xBB, 0x5E, 0x8F, 0xD3, 0x34, 0xC3, 0xFB, 0x48, 0xAF, 0x83,
+  0x26, 0xE2, 0xA4, 0x0A, 0xB4, 0x3C, 0x72, 0xCE, 0x21, 0x65, 0x44, 0x46, 0x65, 0xCA, 0xFB, 0x07,
+  0x99, 0x7C, 0x44, 0xF1, 0xAB, 0x8A, 0x62, 0xA9, 0xFA, 0x9D, 0xA3, 0x32, 0xEA, 0xB8, 0xC3, 0xDF,
+  0x86, 0x69, 0xAD, 0xCF, 0x18, 0x8A, 0x1C, 0xE3, 0x52, 0x2D, 0xA8, 0x0C, 0x6C, 0x66, 0x04, 0xD8,
+  0x1B, 0x99, 0xFD, 0x42, 0xD4, 0x83, 0xC9, 0x36, 0x58, 0xFB, 0x7F, 0x14, 0x0B, 0x23, 0x39, 0x8A,
+  0x4C, 0x48, 0xA8, 0x31, 0x3D, 0x30, 0x54, 0x3D, 0x49, 0x7A, 0x1C, 0x8C, 0x8D, 0x8E, 0x35, 0xF0,
+  0x52, 0x8C, 0xE8, 0xE7, 0x5F, 0x77, 0xCB, 0xCC, 0x34, 0x67, 0x61, 0xB0, 0x60, 0xC2, 0xF8, 0x52,
+  0xD1, 0xA9, 0x77, 0x80, 0x69, 0x6E, 0xAC, 0x1F, 0xBB, 0x77, 0xCC, 0xBC, 0x4C, 0xD4, 0x9C, 0x7A,
+  0x80, 0x1C, 0xC6, 0xB2, 0x1B, 0x1F, 0xFE, 0xAC, 0x34, 0xFC, 0x3C, 0xB1, 0xF9, 0xBA, 0x4A, 0xAD,
+  0xEE, 0x37, 0xEC, 0x11, 0xB5, 0xA9, 0x7F, 0xCC, 0x2B, 0xC1, 0x25, 0x06, 0x8D, 0xE4, 0x9A, 0xD3,
+  0x2C, 0xEA, 0x7F, 0x68, 0x59, 0x52, 0xD3, 0x72, 0x52, 0xAD, 0xBB, 0xDC, 0x08, 0x3E, 0x5B, 0xB7,
+  0x03, 0x9F, 0xF1, 0xD6, 0xC3, 0x04, 0xAB, 0xE5, 0xAF, 0xCC, 0xC2, 0x7E, 0xC4, 0xAF, 0x17, 0xF8,
+  0xC8, 0xFC, 0xC4, 0xB8, 0x8C, 0x65, 0x87, 0xBD, 0x32, 0xC0, 0x59, 0xF4, 0x57, 0x98, 0x01, 0x94,
+  0xB5, 0xFB, 0x48, 0x65, 0x12, 0x1D, 0x07, 0x92, 0xCD, 0x15, 0xAF, 0x17, 0x52, 0xD0, 0x8F, 0x5B,
+  0x27, 0x9D, 0xC8, 0x9A, 0x1E, 0x77, 0x91, 0x85, 0xF9, 0xE6, 0x41, 0xBD, 0x75, 0x1C, 0x78, 0xB0,
+  0x76, 0x6C, 0xB5, 0x0B, 0xFB, 0x0D, 0x47, 0x57, 0x27, 0x27, 0xDF, 0xE4, 0x46, 0x04, 0xF0, 0x1C,
+  0x1E, 0x27, 0x11, 0x62, 0x98, 0x49, 0xDA, 0x46, 0x2B, 0xD6, 0xD4, 0x30, 0x28, 0xDE, 0x3C, 0xF7,
+  0x16, 0x93, 0x01, 0xD8, 0x59, 0xC2, 0xEB, 0x8E, 0x42, 0x19, 0x81, 0x4A, 0xEB, 0x1B, 0x46, 0x07,
+  0x5D, 0xDE, 0xA5, 0x5F, 0xBA, 0x7B, 0x4B, 0x62, 0x55, 0xA1, 0xB7, 0x18, 0x01, 0x77, 0x43, 0x7F,
+  0x34, 0xDB, 0x62, 0x0F, 0x5F, 0x34, 0xE9, 0x72, 0x46, 0xC3, 0x75, 0x4E, 0x99, 0xBF, 0x7D, 0x31,
+  0x11, 0x30, 0xFD, 0x6C, 0x70, 0x2D, 0x9D, 0x38, 0xA5, 0x03, 0x8A, 0x08, 0x1E, 0xDC, 0x74, 0xB3,
+  0x71, 0xE2, 0xB5, 0x2C, 0x94, 0x73, 0x50, 0xD3, 0xC9, 0x41, 0x20, 0x37, 0x52, 0x11, 0x19, 0xA8,
+  0x1B, 0x7D, 0xE1, 0x03, 0x9D, 0x68, 0xC3, 0xCE, 0x7B, 0xD4, 0x5E, 0x68, 0x73, 0x9C, 0x28, 0x98,
+  0x2D, 0x9D, 0x04, 0x0E, 0xB0, 0x7F, 0xDF, 0x3A, 0x67, 0x04, 0xEC, 0x6C, 0x20, 0x31, 0x8B, 0xC1,
+  0x2B, 0x3D, 0xF6, 0x10, 0x7E, 0x3D, 0x6A, 0x39, 0x0F, 0xCF, 0xC7, 0xA4, 0xF9, 0x8C, 0x18, 0xC4,
+  0xF3, 0xCE, 0x21, 0x98, 0x52, 0x8D, 0xAB, 0xF5, 0xB8, 0x9F, 0x95, 0x04, 0x4A, 0xC6, 0x7C, 0x1A,
+  0xA8, 0x63, 0x5B, 0xCE, 0x3C, 0x02, 0x7E, 0xEB, 0x96, 0x61, 0xE1, 0x98, 0xC7, 0x96, 0x9A, 0x35,
+  0x3B, 0xD2, 0x40, 0x3C, 0x6E, 0xBF, 0xFF, 0xCC, 0x1E, 0x81, 0xBD, 0x83, 0xF8, 0x84, 0x14, 0x77,
+  0x17, 0x14, 0xB2, 0x3C, 0x4E, 0x36, 0x15, 0x90, 0xB0, 0x47, 0x69, 0x48, 0x55, 0xA5, 0x29, 0x1C,
+  0xE4, 0x54, 0x0C, 0xFE, 0x28, 0x36, 0x42, 0x15, 0x12, 0x2B, 0xD0, 0x98, 0x4E, 0xEB, 0xB3, 0xAE,
+  0x0A, 0x45, 0x50, 0xDA, 0x93, 0xF0, 0xBA, 0xBC, 0xA2, 0xBA, 0xDD, 0x1C, 0x98, 0xBC, 0x95, 0x5F,
+  0xA8, 0x5E, 0x40, 0xF2, 0x1B, 0x42, 0x68, 0xCC, 0xC0, 0x5E, 0x2D, 0xE8, 0xC5, 0x3A, 0xBB, 0x65,
+  0xB1, 0x4A, 0xB1, 0x91, 0x5A, 0x30, 0x0A, 0xD3, 0x5E, 0xA1, 0xED, 0x50, 0x01, 0x1A, 0xA8, 0xC4,
+  0xEA, 0x37, 0x89, 0xB1, 0xF3, 0xB1, 0x3C, 0x21, 0x05, 0x1A, 0x6A, 0x41, 0xEF, 0x81, 0xE8, 0x4B,
+  0xB1, 0x06, 0x41, 0xE1, 0xA9, 0xAD, 0xA2, 0x42, 0xBC, 0xBE, 0x94, 0x9C, 0xC5, 0x6D, 0x97, 0xA3,
+  0x89, 0xA3, 0x7E, 0xE5, 0xBF, 0x95, 0x9D, 0xBD, 0x32, 0x86, 0xDF, 0xE1, 0x8E, 0x65, 0xFB, 0x51,
+  0x83, 0xAA, 0xE5, 0x8C, 0xEF, 0x91, 0x9E, 0x41, 0x9B, 0xBB, 0xC4, 0xAF, 0x5F, 0xD5, 0x9B, 0xB6,
+  0xE2, 0x04, 0xA0, 0x96, 0x3B, 0xE6, 0xD5, 0x04, 0x04, 0x23, 0xAD, 0x60, 0x7E, 0x65, 0x6A, 0x90,
+  0x40, 0x32, 0x52, 0x90, 0x92, 0x6A, 0x84, 0xBF, 0x49, 0x4B, 0x29, 0xFB, 0xAC, 0xE5, 0x6D, 0x3D,
+  0x51, 0xC4, 0xF3, 0xA1, 0x21, 0xE7, 0x31, 0x24, 0x4F, 0x03, 0x6A, 0xA1, 0x96, 0x26, 0x46, 0x77,
+  0xC1, 0xE2, 0x9E, 0x62, 0xC6, 0xD8, 0x0C, 0x5C, 0x43, 0x58, 0xA6, 0x93, 0x01, 0x2A, 0xE2, 0xCA,
+  0x43, 0x3B, 0x24, 0x3B, 0x46, 0x95, 0xCE, 0x36, 0x59, 0xF1, 0x6D, 0xBC, 0xC4, 0xD6, 0x6D, 0xCB,
+  0x41, 0x84, 0xD8, 0x1C, 0xF7, 0xC0, 0x51, 0x6B, 0x96, 0xA3, 0x8B, 0x10, 0xED, 0x57, 0x7C, 0xE6,
+  0xF8, 0x4B, 0x3D, 0x28, 0x7B, 0xC2, 0xD4, 0x05, 0xD4, 0x26, 0xE9, 0xD0, 0x72, 0x48, 0xF3, 0xB4,
+  0xFE, 0x2D, 0x45, 0xE9, 0xEE, 0x9F, 0x8A, 0x18, 0x40, 0x5B, 0xCC, 0xB5, 0x60, 0x24, 0xFF, 0xF1,
+  0x3B, 0xA2, 0xD0, 0x63, 0x40, 0x5B, 0x8E, 0xE8, 0x57, 0xC8, 0xFF, 0x53, 0x4F, 0xB5, 0x79, 0x94,
+  0x6C, 0x42, 0x0B, 0xD4, 0x6B, 0x52, 0x6A, 0x5F, 0x81, 0x6A, 0x41, 0xD5, 0x50, 0xF2, 0xA2, 0xCD,
+  0x58, 0x32, 0xD3, 0xE0, 0x5D, 0x0F, 0x9D, 0x2B, 0xE1, 0xBA, 0xE4, 0x09, 0x9E, 0xA4, 0x65, 0xFA,
+  0x92, 0x10, 0x32, 0x46, 0x4D, 0xCA, 0x64, 0x2D, 0x3D, 0x15, 0x06, 0x1F, 0xDD, 0xF7, 0x79, 0x93,
+  0x74, 0x32, 0xDF, 0x5F, 0x87, 0x1C, 0x08, 0x33, 0xFE, 0xA4, 0x2E, 0xE3, 0xEA, 0xA0, 0x09, 0xB9,
+  0x9E, 0xED, 0x45, 0x92, 0xC5, 0xCC, 0x14, 0xAB, 0x8A, 0xB7, 0x98, 0xBD, 0x47, 0x69, 0x5D, 0xFF,
+  0x25, 0xE3, 0x9A, 0x92, 0x76, 0xA5, 0x99, 0xF6, 0x48, 0x13, 0x80, 0x62, 0x00, 0x50, 0xE4, 0x98,
+  0x1E, 0x81, 0x2F, 0xA3, 0x95, 0xA7, 0xC9, 0xD5, 0xDF, 0xA2, 0xBD, 0xCD, 0xC1, 0x35, 0x73, 0xD8,
+  0xAE, 0x37, 0x25, 0x4C, 0x89, 0xDE, 0xBE, 0xF5, 0xE5, 0x91, 0xD0, 0x43, 0x5E, 0x6A, 0xAC, 0x32,
+  0x36, 0x3F, 0xED, 0xD2, 0x00, 0xC1, 0xF8, 0x18, 0x28, 0x6A, 0xC1, 0xFF, 0x92, 0xF7, 0xC1, 0x53,
+  0xB4, 0xE9, 0xCB, 0x06, 0x63, 0xDF, 0xCA, 0x3E, 0xF6, 0x88, 0xBB, 0x65, 0x58, 0x7B, 0xBF, 0x8A,
+  0x1E, 0xF2, 0x97, 0x2F, 0x46, 0xAE, 0x1C, 0x2F, 0xAA, 0x68, 0xA7, 0xED, 0x06, 0x60, 0x5B, 0x64,
+  0x7D, 0xCB, 0x7A, 0xBF, 0x6A, 0x47, 0x4A, 0x74, 0x4D, 0xF1, 0x41, 0x62, 0x2D, 0x8A, 0xB2, 0x5A,
+  0x23, 0x6A, 0xB5, 0x3B, 0x44, 0x3A, 0x95, 0x8B, 0x3A, 0xD1, 0xFF, 0xBF, 0xDB, 0x80, 0xC8, 0x94,
+  0x05, 0xE9, 0x2B, 0x0F, 0x44, 0xBA, 0x38, 0x9E, 0x45, 0x08, 0xC0, 0xA9, 0xFD, 0x5E, 0x8F, 0x40,
+  0x50, 0xF6, 0xA8, 0x16, 0xA7, 0xA3, 0xFF, 0xE0, 0xF4, 0x83, 0x67, 0xB1, 0xF8, 0x87, 0x34, 0x86,
+  0x23, 0x0B, 0x7C, 0x6D, 0xF8, 0x36, 0xB2, 0x29, 0x71, 0xBF, 0x7F, 0xAA, 0x53, 0x8D, 0x31, 0x80,
+  0xA6, 0x01, 0x59, 0x79, 0x40, 0xD1, 0xBC, 0x6C, 0x22, 0x8F, 0x05, 0xE3, 0xBA, 0x0F, 0xE9, 0x43,
+  0x16, 0x15, 0x0D, 0x5A, 0xB7, 0xF3, 0x9B, 0x82, 0xCA, 0xB2, 0x1A, 0x4F, 0x04, 0x45, 0x3F, 0x00,
+  0x3B, 0x15, 0xA6, 0xB4, 0x2C, 0x19, 0x90, 0x42, 0x88, 0x34, 0xF3, 0x17, 0x64, 0x2F, 0xC9, 0xCD,
+  0x0E, 0x28, 0xD7, 0x1A, 0x15, 0xDF, 0x3F, 0xD2, 0x7F, 0x53, 0x2D, 0xEF, 0xA0, 0x61, 0xA7, 0xA9,
+  0xF8, 0x54, 0x87, 0x05, 0xF1, 0xA2, 0xEC, 0x11, 0x76, 0x25, 0xED, 0x17, 0x8E, 0xC8, 0x2F, 0x07,
+  0x12, 0x81, 0xE2, 0x25, 0xF7, 0x5C, 0x65, 0x92, 0xC2, 0xCE, 0x3B, 0xD1, 0xE3, 0xAB, 0xDD, 0xF5,
+  0xC6, 0x2D, 0xDD, 0x67, 0x44, 0xF0, 0x0A, 0xAA, 0x26, 0xA3, 0x36, 0x70, 0x5D, 0xE7, 0xB0, 0x7F,
+  0xC4, 0x06, 0x11, 0x58, 0xB2, 0x0D, 0x71, 0x6E, 0xE6, 0xBE, 0x36, 0xD0, 0xEB, 0x39, 0xF3, 0x2A,
+  0x27, 0xAA, 0x15, 0x9F, 0x52, 0xB9, 0x9A, 0xE0, 0x36, 0x8E, 0x0C, 0x86, 0x24, 0x43, 0x03, 0xCB,
+  0x1E, 0x28, 0xB2, 0xF6, 0xB7, 0xB6, 0x93, 0x66, 0xC5, 0x41, 0x6E, 0xA7, 0x5C, 0xF1, 0xD8, 0xCA,
+  0x06, 0x64, 0x1E, 0xCC, 0x84, 0x2A, 0xF0, 0x05, 0xA0, 0xCA, 0x0D, 0xC4, 0xD2, 0x25, 0xEC, 0xB4,
+  0x54, 0x39, 0xDB, 0xE2, 0xD9, 0xAD, 0x12, 0xD9, 0x53, 0xEE, 0x0B, 0x87, 0x35, 0x6B, 0x8D, 0x56,
+  0x26, 0x8D, 0xBC, 0xB8, 0xBE, 0x3D, 0x5F, 0x58, 0x1E, 0x8C, 0x89, 0x36, 0x4E, 0x06, 0x55, 0xF5,
+  0x3D, 0xDC, 0xE7, 0x34, 0x28, 0x44, 0x6C, 0xA9, 0xAA, 0x9C, 0x98, 0xB2, 0xD6, 0xE1, 0x98, 0xCA,
+  0x83, 0xD5, 0xE4, 0x15, 0xEB, 0xD0, 0x22, 0x1A, 0xDF, 0x30, 0x25, 0x43, 0x9E, 0x6E, 0x03, 0x09,
+  0x7B, 0x98, 0xB7, 0x44, 0x61, 0x47, 0xB1, 0xC7, 0x17, 0xA6, 0x95, 0x32, 0xA4, 0x9A, 0x5D, 0x2D,
+  0x55, 0x99, 0x4B, 0xED, 0x27, 0xB2, 0x54, 0xD1, 0x46, 0x64, 0x53, 0xEC, 0xC4, 0x06, 0x1E, 0x35,
+  0x9F, 0x28, 0xB1, 0x04, 0x5C, 0x84, 0xCE, 0xBD, 0xBB, 0xA9, 0xE4, 0xFE, 0xD3, 0xFA, 0x77, 0x65,
+  0xF6, 0xB0, 0xF2, 0x6D, 0xC2, 0x0A, 0xE1, 0xD9, 0xF3, 0x79, 0x29, 0xD2, 0x23, 0x50, 0x5D, 0xD4,
+  0xC8, 0xF6, 0x2A, 0x65, 0xA2, 0x47, 0xF6, 0x9F, 0xF8, 0xB3, 0x4F, 0x69, 0x6A, 0x9B, 0xDA, 0x82,
+  0xC3, 0xFA, 0xA7, 0x19, 0x19, 0xF8, 0x63, 0x5A, 0x61, 0xE9, 0x6E, 0x31, 0x2D, 0xBA, 0x61, 0xC7,
+  0xA2, 0xB6, 0x3E, 0x39, 0x3E, 0x6A, 0x32, 0x72, 0x59, 0x9C, 0x0C, 0x69, 0x46, 0xF7, 0x62, 0x6C,
+  0xF8, 0xE7, 0xD8, 0xC6, 0xF0, 0x6B, 0x83, 0xC6, 0xD7, 0x84, 0x4A, 0xC5, 0xE4, 0x52, 0xB9, 0xDB,
+  0xBE, 0xAB, 0xAA, 0x20, 0xB6, 0x59, 0xF1, 0xC4, 0x2C, 0x17, 0x2A, 0x65, 0xFD, 0x28, 0x11, 0x4C,
+  0x7E, 0x13, 0x81, 0x0E, 0xB9, 0x16, 0x00, 0xFE, 0x90, 0x93, 0x1C, 0x38, 0xEE, 0xE7, 0xF7, 0x7B,
+  0xD6, 0xCF, 0xE1, 0xC5, 0xE8, 0xC0, 0xC0, 0x8F, 0xD2, 0x08, 0x71, 0x4D, 0xE8, 0xE2, 0x79, 0x31,
+  0xC9, 0xC9, 0xAA, 0x5C, 0x21, 0xAE, 0x1F, 0x6C, 0x67, 0x38, 0xB2, 0xC7, 0x84, 0xB7, 0xFB, 0xAC,
+  0xDD, 0x84, 0x78, 0xE3, 0x18, 0x4F, 0xBA, 0x7E, 0xF8, 0x18, 0x46, 0xBF, 0x35, 0xE6, 0xC3, 0xB5,
+  0xDD, 0x50, 0xA3, 0xBC, 0xAD, 0xE7, 0x1B, 0xFC, 0x10, 0x7F, 0xD0, 0x38, 0xDC, 0xE6, 0xB4, 0x25,
+  0xA3, 0x54, 0x9F, 0x52, 0x8C, 0x8B, 0xF8, 0x12, 0x6D, 0x6B, 0xB7, 0x25, 0xC1, 0x30, 0x10, 0x35,
+  0xDC, 0xBA, 0x41, 0x39, 0xA4, 0x84, 0xEE, 0x53, 0xA3, 0x7A, 0xE9, 0x77, 0xE9, 0xE6, 0x14, 0x10,
+  0x28, 0x9F, 0xEA, 0x85, 0xA5, 0x2E, 0x64, 0xAE, 0xA9, 0x27, 0xBF, 0x12, 0x93, 0xE9, 0x08, 0xF3,
+  0xB9, 0x40, 0xCC, 0xB3, 0x41, 0x13, 0xAF, 0xC9, 0x43, 0xD8, 0x4D, 0xE4, 0x90, 0x5B, 0x69, 0x8B,
+  0x6A, 0xC7, 0x53, 0x13, 0x44, 0xD8, 0x6D, 0x71, 0x32, 0x90, 0x6A, 0x7A, 0x68, 0xB7, 0x56, 0x1D,
+  0x9B, 0x59, 0xFA, 0x1F, 0xE9, 0xC0, 0x4A, 0x54, 0xCC, 0xDA, 0x84, 0x20, 0x58, 0x0D, 0x9C, 0xB1,
+  0xCC, 0x38, 0x17, 0x17, 0x5B, 0x6E, 0xDB, 0xB1, 0x11, 0x11, 0x96, 0xCA, 0x33, 0x08, 0xE1, 0x00,
+  0xB3, 0x35, 0x92, 0x6F, 0xC6, 0x82, 0xF7, 0x44, 0x4F, 0xEE, 0x4A, 0x43, 0x11, 0x3D, 0xDC, 0xC4,
+  0x72, 0x8D, 0x96, 0xAC, 0xFD, 0x08, 0x1C, 0xA3, 0x00, 0xEA, 0x42, 0xC9, 0x89, 0x42, 0x1C, 0xEF,
+  0xDC, 0x20, 0x99, 0xC0, 0xB1, 0xF2, 0xD0, 0xF0, 0x72, 0x3B, 0x5E, 0x0A, 0xE0, 0x77, 0x2C, 0x3F,
+  0x0C, 0xB3, 0xFD, 0xF9, 0x9D, 0xDB, 0x38, 0x97, 0xD5, 0xCE, 0xDD, 0xD9, 0xF0, 0x55, 0x8B, 0x2F,
+  0xA1, 0x18, 0x12, 0xDD, 0xD2, 0x7D, 0xEC, 0x70, 0xA9, 0xB1, 0x5C, 0x14, 0x56, 0xE0, 0xD8, 0x00,
+  0xD6, 0x76, 0x45, 0xAB, 0xE1, 0x2F, 0xC4, 0x7C, 0xE4, 0xC2, 0x63, 0x7D, 0x2B, 0x92, 0xA6, 0xCC,
+  0x49, 0xE9, 0xD0, 0x7B, 0x03, 0xEB, 0xA3, 0x89, 0x1A, 0x1C, 0x86, 0xDB, 0x4A, 0xED, 0x79, 0x36,
+  0xDF, 0x01, 0xBC, 0x40, 0xA4, 0xEF, 0x34, 0x77, 0xA4, 0xB7, 0xC2, 0x69, 0xE7, 0x39, 0x14, 0xCE,
+  0x9E, 0xBA, 0xFF, 0x34, 0xFB, 0xE7, 0xC9, 0xCB, 0xD7, 0x1B, 0x97, 0x4D, 0xA3, 0x9F, 0x71, 0xE0,
+  0x16, 0xE4, 0xF3, 0xFF, 0x96, 0x04, 0x78, 0x34, 0x5D, 0x38, 0xC1, 0x71, 0x63, 0x1E, 0xD5, 0x17,
+  0x62, 0x5B, 0x2F, 0x9C, 0xD4, 0x3B, 0xF8, 0x0F, 0x9F, 0x99, 0x40, 0xCC, 0xBE, 0x12, 0x6B, 0xF4,
+  0x24, 0x29, 0xE0, 0x64, 0x7C, 0x86, 0x67, 0x79, 0xE1, 0x4F, 0x37, 0x80, 0x45, 0x62, 0xB7, 0x89,
+  0x1A, 0x75, 0xFD, 0x10, 0x5F, 0x82, 0x99, 0x70, 0x7F, 0xE7, 0xDD, 0x01, 0xF7, 0xD9, 0x27, 0x15,
+  0x57, 0xF4, 0x89, 0xD7, 0x25, 0x49, 0xA8, 0x5E, 0xE8, 0x1B, 0x0F, 0x5A, 0x40, 0x3E, 0xE8, 0x42,
+  0x1C, 0x82, 0xA4, 0x2C, 0xAC, 0x6B, 0x10, 0xA4, 0xE5, 0xC1, 0x97, 0x53, 0xB9, 0xB8, 0x44, 0x7B,
+  0x34, 0x10, 0x66, 0xC4, 0x58, 0x86, 0x12, 0x9E, 0x53, 0xA4, 0x1B, 0x84, 0x25, 0x21, 0xF2, 0x5F,
+  0x6E, 0xF1, 0xC4, 0xDC, 0xF6, 0x93, 0xBE, 0xC6, 0x84, 0x0C, 0xF2, 0x0D, 0xE2, 0x8D, 0x2A, 0x63,
+  0x0C, 0x23, 0xB7, 0x9F, 0x8F, 0x2F, 0xF0, 0xA0, 0x6E, 0xE3, 0x7C, 0xC5, 0x64, 0xD6, 0x8B, 0xC2,
+  0x8A, 0x77, 0x7C, 0x1E, 0xB0, 0x38, 0xF7, 0x29, 0x3F, 0x4E, 0xE7, 0x18, 0x4D, 0x77, 0xFF, 0x77,
+  0x87, 0xEA, 0x53, 0x22, 0x95, 0x93, 0xB6, 0x58, 0x25, 0x27, 0x12, 0x33, 0x14, 0xFC, 0xD5, 0x43,
+  0x58, 0x6A, 0x41,
+};
+
+STATIC CONST CHAR8  *mTestWords[] = {
+  "Firmware", "Volume", "Section", "EFI_STATUS", "Protocol", "Handle",
+  "Image",    "Driver", "Buffer",  "Status",     "Length",   "Success"
+};
+
+STATIC UINT8  *mTestPlainText;
+
+/**
+  Returns the next value of a linear congruential generator.
+
+  @param[in, out] Seed  The generator state.
+
+  @return The new state.
+
+**/
+STATIC
+UINT32
+TestRandom (
+  IN OUT UINT32  *Seed
+  )
+{
+  *Seed = *Seed * 1103515245 + 12345;
+  return *Seed;
+}
+
+/**
+  Generates the plain text of mTestCompressed.
+
+  The text mixes the content LZMA sees in firmware volumes: runs of zeros,
+  near and far repeats, random bytes, strings and code-like byte patterns.
+  Together they exercise literals, matched literals, rep matches, all length
+  coders and distances with direct and align bits.
+
+  @param[out] Buffer  Receives TEST_PLAIN_TEXT_SIZE bytes.
+
+**/
+STATIC
+VOID
+TestGeneratePlainText (
+  OUT UINT8  *Buffer
+  )
+{
+  UINT32       Seed;
+  UINT32       Value;
+  UINTN        Position;
+  UINTN        Length;
+  UINTN        Distance;
+  UINTN        Index;
+  UINTN        Index2;
+  UINTN        WordLength;
+  CONST CHAR8  *Word;
+  UINT8        Code[9];
+
+  Seed     = 0x4C5A4D41;
+  Position = 0;
+  while (Position < TEST_PLAIN_TEXT_SIZE) {
+    Index = (TestRandom (&Seed) >> 16) % 8;
+    Value = TestRandom (&Seed) >> 8;
+    switch (Index) {
+      case 0:
+        Length = 16 + Value % 600;
+        for (Index2 = 0; Index2 < Length && Position < TEST_PLAIN_TEXT_SIZE; Index2++) {
+          Buffer[Position++] = 0;
+        }
+
+        break;
+
+      case 1:
+      case 2:
+      case 3:
+        if (Position < 4) {
+          break;
+        }
+
+        Distance = 1 + Value % ((Position < SIZE_4KB) ? Position : ((Index == 3) ? Position : SIZE_4KB));
+        Length   = 2 + (Value >> 12) % 200;
+        for (Index2 = 0; Index2 < Length && Position < TEST_PLAIN_TEXT_SIZE; Index2++, Position++) {
+          Buffer[Position] = Buffer[Position - Distance];
+        }
+
+        if ((Position < TEST_PLAIN_TEXT_SIZE) && ((Value & 1) != 0)) {
+          Buffer[Position++] ^= (UINT8)(Value >> 4);
+        }
+
+        break;
+
+      case 4:
+        Length = 1 + Value % 24;
+        for (Index2 = 0; Index2 < Length && Position < TEST_PLAIN_TEXT_SIZE; Index2++) {
+          Buffer[Position++] = (UINT8)(TestRandom (&Seed) >> 16);
+        }
+
+        break;
+
+      case 5:
+        Length = 1 + Value % 6;
+        for (Index2 = 0; Index2 < Length; Index2++) {
+          Word       = mTestWords[(Value >> (Index2 * 3)) % ARRAY_SIZE (mTestWords)];
+          WordLength = AsciiStrLen (Word);
+          for (Index = 0; Index < WordLength && Position < TEST_PLAIN_TEXT_SIZE; Index++) {
+            Buffer[Position++] = Word[Index];
+          }
+
+          if (Position < TEST_PLAIN_TEXT_SIZE) {
+            Buffer[Position++] = ' ';
+          }
+        }
+
+        break;
+
+      default:
+        Length = 1 + Value % 8;
+        for (Index2 = 0; Index2 < Length; Index2++) {
+          Code[0] = 0x48;
+          Code[1] = 0x8B;
+          Code[2] = (UINT8)(0x40 | ((Value >> (Index2 * 2)) & 0x3F));
+          Code[3] = (UINT8)(Value >> (Index2 + 8));
+          Code[4] = 0xE8;
+          Code[5] = (UINT8)(Value >> Index2);
+          Code[6] = 0;
+          Code[7] = 0;
+          Code[8] = 0;
+          for (Index = 0; Index < sizeof (Code) && Position < TEST_PLAIN_TEXT_SIZE; Index++) {
+            Buffer[Position++] = Code[Index];
+          }
+        }
+
+        break;
+    }
+  }
+}
+
+/**
+  Decompresses Source into a buffer followed by a guard area.
+
+  @param[in]  Source      The compressed data.
+  @param[in]  SourceSize  The size of Source.
+  @param[out] Output      Receives the output buffer, TEST_PLAIN_TEXT_SIZE
+                          bytes followed by TEST_GUARD_SIZE guard bytes, or
+                          NULL if it could not be allocated.
+
+  @retval RETURN_UNSUPPORTED       The header does not describe the test vector.
+  @retval RETURN_OUT_OF_RESOURCES  The buffers could not be allocated.
+  @return The status returned by LzmaUefiDecompress ().
+
+**/
+STATIC
+RETURN_STATUS
+TestDecompress (
+  IN  CONST UINT8  *Source,
+  IN  UINTN        SourceSize,
+  OUT UINT8        **Output
+  )
+{
+  RETURN_STATUS  Status;
+  UINT32         DestinationSize;
+  UINT32         ScratchSize;
+  VOID           *Scratch;
+
+  *Output = NULL;
+  Status  = LzmaUefiDecompressGetInfo (Source, (UINT32)SourceSize, &DestinationSize, &ScratchSize);
+  if (RETURN_ERROR (Status) || (DestinationSize != TEST_PLAIN_TEXT_SIZE)) {
+    return RETURN_UNSUPPORTED;
+  }
+
+  Scratch = AllocatePool (ScratchSize);
+  if (Scratch == NULL) {
+    return RETURN_OUT_OF_RESOURCES;
+  }
+
+  *Output = AllocatePool (TEST_PLAIN_TEXT_SIZE + TEST_GUARD_SIZE);
+  if (*Output == NULL) {
+    FreePool (Scratch);
+    return RETURN_OUT_OF_RESOURCES;
+  }
+
+  SetMem (*Output, TEST_PLAIN_TEXT_SIZE + TEST_GUARD_SIZE, TEST_GUARD_BYTE);
+  Status = LzmaUefiDecompress (Source, SourceSize, *Output, Scratch);
+  FreePool (Scratch);
+  return Status;
+}
+
+/**
+  Checks that the guard area following the output is intact.
+
+  @param[in] Output  The buffer returned by TestDecompress ().
+
+  @retval TRUE   The guard area is intact.
+  @retval FALSE  The decoder wrote past the output.
+
+**/
+STATIC
+BOOLEAN
+TestGuardIntact (
+  IN CONST UINT8  *Output
+  )
+{
+  UINTN  Index;
+
+  for (Index = 0; Index < TEST_GUARD_SIZE; Index++) {
+    if (Output[TEST_PLAIN_TEXT_SIZE + Index] != TEST_GUARD_BYTE) {
+      return FALSE;
+    }
+  }
+
+  return TRUE;
+}
+
+/**
+  Decompresses the test vector in one call.
+
+  @param[in]  Context    Unused.
+
+  @retval  UNIT_TEST_PASSED             The test passed.
+  @retval  UNIT_TEST_ERROR_TEST_FAILED  The test failed.
+
+**/
+UNIT_TEST_STATUS
+EFIAPI
+TestDecompressVector (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  RETURN_STATUS  Status;
+  UINT8          *Output;
+
+  Status = TestDecompress (mTestCompressed, sizeof (mTestCompressed), &Output);
+  UT_ASSERT_NOT_EFI_ERROR (Status);
+  UT_ASSERT_NOT_NULL (Output);
+  UT_ASSERT_MEM_EQUAL (Output, mTestPlainText, TEST_PLAIN_TEXT_SIZE);
+  UT_ASSERT_TRUE (TestGuardIntact (Output));
+
+  FreePool (Output);
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  Decompresses the test vector in small steps with the streaming interface,
+  so that decoding stops in the middle of matches and at every kind of
+  symbol.
+
+  @param[in]  Context    Unused.
+
+  @retval  UNIT_TEST_PASSED             The test passed.
+  @retval  UNIT_TEST_ERROR_TEST_FAILED  The test failed.
+
+**/
+UNIT_TEST_STATUS
+EFIAPI
+TestDecompressStream (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  RETURN_STATUS  Status;
+  UINT32         DestinationSize;
+  UINT32         ScratchSize;
+  UINT8          *Output;
+  VOID           *Scratch;
+  VOID           *Stream;
+  UINTN          OutputLimit;
+  UINTN          OutputSize;
+
+  Status = LzmaUefiDecompressGetInfo (mTestCompressed, sizeof (mTestCompressed), &DestinationSize, &ScratchSize);
+  UT_ASSERT_NOT_EFI_ERROR (Status);
+
+  Output  = AllocateZeroPool (DestinationSize);
+  Scratch = AllocatePool (ScratchSize);
+  UT_ASSERT_NOT_NULL (Output);
+  UT_ASSERT_NOT_NULL (Scratch);
+
+  Status = LzmaUefiDecompressStreamInit (mTestCompressed, sizeof (mTestCompressed), Output, Scratch, &Stream);
+  UT_ASSERT_NOT_EFI_ERROR (Status);
+
+  OutputLimit = 0;
+  do {
+    OutputLimit += TEST_STREAM_STEP;
+    Status       = LzmaUefiDecompressStreamRun (Stream, OutputLimit, &OutputSize);
+    UT_ASSERT_TRUE (Status == RETURN_SUCCESS || Status == RETURN_NOT_READY);
+    UT_ASSERT_EQUAL (OutputSize, MIN (OutputLimit, DestinationSize));
+    UT_ASSERT_MEM_EQUAL (Output, mTestPlainText, OutputSize);
+  } while (Status == RETURN_NOT_READY);
+
+  UT_ASSERT_EQUAL (OutputSize, TEST_PLAIN_TEXT_SIZE);
+
+  FreePool (Scratch);
+  FreePool (Output);
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  Decompresses corrupted and truncated copies of the test vector. The decoder
+  may fail or produce wrong output, but must not write past the output.
+
+  @param[in]  Context    Unused.
+
+  @retval  UNIT_TEST_PASSED             The test passed.
+  @retval  UNIT_TEST_ERROR_TEST_FAILED  The test failed.
+
+**/
+UNIT_TEST_STATUS
+EFIAPI
+TestDecompressCorrupted (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  RETURN_STATUS  Status;
+  UINT8          *Source;
+  UINT8          *Output;
+  UINTN          Round;
+  UINTN          Offset;
+  UINT32         Seed;
+  UINT32         Failures;
+
+  Source = AllocateCopyPool (sizeof (mTestCompressed), mTestCompressed);
+  UT_ASSERT_NOT_NULL (Source);
+
+  Seed     = 1;
+  Failures = 0;
+  for (Round = 0; Round < TEST_CORRUPTION_ROUNDS; Round++) {
+    //
+    // Keep the 13 byte header, it holds the properties and the output size.
+    //
+    Offset          = TEST_HEADER_SIZE + (TestRandom (&Seed) >> 8) % (sizeof (mTestCompressed) - TEST_HEADER_SIZE);
+    Source[Offset] ^= (UINT8)(1 << ((TestRandom (&Seed) >> 16) % 8));
+
+    Status = TestDecompress (Source, sizeof (mTestCompressed), &Output);
+    UT_ASSERT_NOT_NULL (Output);
+    if (RETURN_ERROR (Status)) {
+      Failures++;
+    }
+
+    UT_ASSERT_TRUE (TestGuardIntact (Output));
+    FreePool (Output);
+
+    CopyMem (Source, mTestCompressed, sizeof (mTestCompressed));
+  }
+
+  UT_LOG_INFO ("%d of %d corrupted inputs rejected\n", Failures, TEST_CORRUPTION_ROUNDS);
+
+  Status = TestDecompress (Source, sizeof (mTestCompressed) / 2, &Output);
+  UT_ASSERT_STATUS_EQUAL (Status, RETURN_INVALID_PARAMETER);
+  UT_ASSERT_NOT_NULL (Output);
+  UT_ASSERT_TRUE (TestGuardIntact (Output));
+  FreePool (Output);
+
+  FreePool (Source);
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  Measures the decompression throughput of the decode loop this test is
+  built with.
+
+  @param[in]  Context    Unused.
+
+  @retval  UNIT_TEST_PASSED             The test passed.
+  @retval  UNIT_TEST_ERROR_TEST_FAILED  The test failed.
+
+**/
+UNIT_TEST_STATUS
+EFIAPI
+TestDecompressThroughput (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  RETURN_STATUS  Status;
+  UINT32         DestinationSize;
+  UINT32         ScratchSize;
+  UINT8          *Output;
+  VOID           *Scratch;
+  UINTN          Round;
+  clock_t        Start;
+  double         Seconds;
+
+  Status = LzmaUefiDecompressGetInfo (mTestCompressed, sizeof (mTestCompressed), &DestinationSize, &ScratchSize);
+  UT_ASSERT_NOT_EFI_ERROR (Status);
+
+  Output  = AllocatePool (DestinationSize);
+  Scratch = AllocatePool (ScratchSize);
+  UT_ASSERT_NOT_NULL (Output);
+  UT_ASSERT_NOT_NULL (Scratch);
+
+  Start = clock ();
+  for (Round = 0; Round < TEST_THROUGHPUT_ROUNDS; Round++) {
+    Status = LzmaUefiDecompress (mTestCompressed, sizeof (mTestCompressed), Output, Scratch);
+    UT_ASSERT_NOT_EFI_ERROR (Status);
+  }
+
+  Seconds = (double)(clock () - Start) / CLOCKS_PER_SEC;
+  UT_ASSERT_MEM_EQUAL (Output, mTestPlainText, TEST_PLAIN_TEXT_SIZE);
+
+  UT_LOG_INFO (
+    "%a decode loop: %d KB in %d ms\n",
+ #ifdef _LZMA_DEC_OPT
+    "LzmaDecFast",
+ #else
+    "Generic",
+ #endif
+    TEST_THROUGHPUT_ROUNDS * TEST_PLAIN_TEXT_SIZE / SIZE_1KB,
+    (int)(Seconds * 1000)
+    );
+
+  FreePool (Scratch);
+  FreePool (Output);
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  Initialize the unit test framework, suite, and unit tests for the LZMA
+  decompress library and run them.
+
+  @retval  EFI_SUCCESS           All test cases were dispatched.
+  @retval  EFI_OUT_OF_RESOURCES  There are not enough resources available to
+                                 initialize the unit tests.
+**/
+STATIC
+EFI_STATUS
+EFIAPI
+UnitTestingEntry (
+  VOID
+  )
+{
+  EFI_STATUS                  Status;
+  UNIT_TEST_FRAMEWORK_HANDLE  Framework;
+  UNIT_TEST_SUITE_HANDLE      LzmaTests;
+
+  Framework = NULL;
+
+  DEBUG ((DEBUG_INFO, "%a v%a\n", UNIT_TEST_APP_NAME, UNIT_TEST_APP_VERSION));
+
+  Status = InitUnitTestFramework (&Framework, UNIT_TEST_APP_NAME, gEfiCallerBaseName, UNIT_TEST_APP_VERSION);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "Failed in InitUnitTestFramework. Status = %r\n", Status));
+    goto EXIT;
+  }
+
+  Status = CreateUnitTestSuite (&LzmaTests, Framework, "LZMA Decompress Tests", "Library.LzmaDecompress", NULL, NULL);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "Failed in CreateUnitTestSuite for LZMA Decompress Tests\n"));
+    Status = EFI_OUT_OF_RESOURCES;
+    goto EXIT;
+  }
+
+  //
+  // --------------Suite------Description-----------------------------Name------------Function------------------Pre---Post---Context-----
+  //
+  AddTestCase (LzmaTests, "Decompress the test vector", "Vector", TestDecompressVector, NULL, NULL, NULL);
+  AddTestCase (LzmaTests, "Decompress the test vector in steps", "Stream", TestDecompressStream, NULL, NULL, NULL);
+  AddTestCase (LzmaTests, "Corrupted and truncated input", "Corrupted", TestDecompressCorrupted, NULL, NULL, NULL);
+  AddTestCase (LzmaTests, "Decompression throughput", "Throughput", TestDecompressThroughput, NULL, NULL, NULL);
+
+  mTestPlainText = AllocatePool (TEST_PLAIN_TEXT_SIZE);
+  if (mTestPlainText == NULL) {
+    Status = EFI_OUT_OF_RESOURCES;
+    goto EXIT;
+  }
+
+  TestGeneratePlainText (mTestPlainText);
+
+  //
+  // Execute the tests.
+  //
+  Status = RunAllTestSuites (Framework);
+
+EXIT:
+  if (mTestPlainText != NULL) {
+    FreePool (mTestPlainText);
+  }
+
+  if (Framework) {
+    FreeUnitTestFramework (Framework);
+  }
+
+  return Status;
+}
+
+///
+/// Avoid ECC error for function name that starts with lower case letter
+///
+#define LzmaDecompressUnitTestMain  main
+
+/**
+  Standard POSIX C entry point for host based unit test execution.
+
+  @param[in] Argc  Number of arguments
+  @param[in] Argv  Array of pointers to arguments
+
+  @retval 0      Success
+  @retval other  Error
+**/
+INT32
+LzmaDecompressUnitTestMain (
+  IN INT32  Argc,
+  IN CHAR8  *Argv[]
+  )
+{
+  return UnitTestingEntry ();
+}
@@ -0,0 +1,415 @@
+/** @file
+  Incremental reclaim of the non-volatile variable store.
+
+  The store is compacted a bounded region per SetVariable () call instead of
+  being rebuilt at once by Reclaim () when it is full. Every step is a single
+  Fault Tolerant Write that leaves a valid variable store behind.
+
+Copyright (c) 2026, Intel Corporation. All rights reserved.<BR>
+SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include "Variable.h"
+#include "VariableParsing.h"
+#include "VariableIndex.h"
+#include "VariableRuntimeCache.h"
+
+/**
+  Writes a range of the non-volatile variable store during incremental reclaim
+  and mirrors it into the non-volatile variable cache.
+
+  @param[in] Offset         Offset of the range in the variable store.
+  @param[in] Length         Length of the range in bytes.
+  @param[in] Buffer         Data to write.
+
+  @retval EFI_SUCCESS       The range was written.
+  @retval Others            The Fault Tolerant Write failed, the store is unchanged.
+
+**/
+STATIC
+EFI_STATUS
+IncrementalReclaimWrite (
+  IN UINTN  Offset,
+  IN UINTN  Length,
+  IN VOID   *Buffer
+  )
+{
+  EFI_STATUS  Status;
+
+  Status = FtwVariableRange (
+             mVariableModuleGlobal->VariableGlobal.NonVolatileVariableBase,
+             Offset,
+             Length,
+             Buffer
+             );
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  CopyMem ((UINT8 *)mNvVariableCache + Offset, Buffer, Length);
+  VariableIndexInvalidate (mNvVariableCache);
+  return SynchronizeRuntimeVariableCache (
+           &mVariableModuleGlobal->VariableGlobal.VariableRuntimeCacheContext.VariableRuntimeNvCache,
+           Offset,
+           Length
+           );
+}
+
+/**
+  Recalculates the non-volatile variable total sizes from the variables
+  present in the non-volatile variable store.
+
+**/
+STATIC
+VOID
+RecalculateNvVariableTotalSize (
+  VOID
+  )
+{
+  VARIABLE_HEADER  *Variable;
+  VARIABLE_HEADER  *NextVariable;
+  UINTN            VariableSize;
+
+  mVariableModuleGlobal->HwErrVariableTotalSize      = 0;
+  mVariableModuleGlobal->CommonVariableTotalSize     = 0;
+  mVariableModuleGlobal->CommonUserVariableTotalSize = 0;
+
+  Variable = GetStartPointer (mNvVariableCache);
+  while (IsValidVariableHeader (Variable, GetEndPointer (mNvVariableCache))) {
+    NextVariable = GetNextVariablePtr (Variable, mVariableModuleGlobal->VariableGlobal.AuthFormat);
+    VariableSize = (UINTN)NextVariable - (UINTN)Variable;
+    if ((Variable->Attributes & EFI_VARIABLE_HARDWARE_ERROR_RECORD) == EFI_VARIABLE_HARDWARE_ERROR_RECORD) {
+      mVariableModuleGlobal->HwErrVariableTotalSize += VariableSize;
+    } else {
+      mVariableModuleGlobal->CommonVariableTotalSize += VariableSize;
+      if (IsUserVariable (Variable)) {
+        mVariableModuleGlobal->CommonUserVariableTotalSize += VariableSize;
+      }
+    }
+
+    Variable = NextVariable;
+  }
+}
+
+/**
+  Compacts the variables of the next region of the non-volatile variable store.
+
+  The valid variables found in the next PcdVariableReclaimStepSize bytes after
+  ScanOffset are moved down to CompactedOffset, and a deleted padding variable
+  covers the space between them and the first variable not scanned yet. Both
+  are written by one Fault Tolerant Write, so the store is valid whether or not
+  the write completes.
+
+  @param[in, out] Progress      The incremental reclaim progress.
+  @param[in]      StepSize      Number of store bytes to scan.
+  @param[in]      AuthFormat    TRUE indicates authenticated variables are used.
+                                FALSE indicates authenticated variables are not used.
+
+  @retval EFI_SUCCESS           The region was compacted.
+  @retval EFI_VOLUME_CORRUPTED  The store does not have the expected layout.
+  @retval EFI_BUFFER_TOO_SMALL  A variable does not fit in the reclaim buffer.
+  @retval Others                The Fault Tolerant Write failed.
+
+**/
+STATIC
+EFI_STATUS
+IncrementalReclaimCompact (
+  IN OUT VARIABLE_INCREMENTAL_RECLAIM  *Progress,
+  IN     UINTN                         StepSize,
+  IN     BOOLEAN                       AuthFormat
+  )
+{
+  VARIABLE_HEADER  *Variable;
+  VARIABLE_HEADER  *Padding;
+  UINTN            LastOffset;
+  UINTN            ScannedSize;
+  UINTN            CopiedSize;
+  UINTN            VariableSize;
+  UINTN            PaddingSize;
+  UINTN            PaddingHeaderSize;
+  EFI_STATUS       Status;
+
+  LastOffset        = mVariableModuleGlobal->NonVolatileLastVariableOffset;
+  PaddingHeaderSize = GetVariableHeaderSize (AuthFormat) + sizeof (CHAR16);
+  ScannedSize       = 0;
+  CopiedSize        = 0;
+
+  while ((Progress->ScanOffset < LastOffset) && (ScannedSize < StepSize)) {
+    Variable = (VARIABLE_HEADER *)((UINTN)mNvVariableCache + Progress->ScanOffset);
+    if (!IsValidVariableHeader (Variable, GetEndPointer (mNvVariableCache))) {
+      return EFI_VOLUME_CORRUPTED;
+    }
+
+    VariableSize = (UINTN)GetNextVariablePtr (Variable, AuthFormat) - (UINTN)Variable;
+    if ((Variable->State == VAR_ADDED) || (Variable->State == (VAR_IN_DELETED_TRANSITION & VAR_ADDED))) {
+      if (Progress->CompactedOffset == Progress->ScanOffset) {
+        //
+        // Nothing was reclaimed in front of the variable yet, it stays in place.
+        //
+        Progress->CompactedOffset += VariableSize;
+        Progress->ScanOffset      += VariableSize;
+        continue;
+      }
+
+      //
+      // Keep the variable order, so that an IN_DELETED_TRANSITION variable
+      // still precedes the ADDED one that replaces it.
+      //
+      if (CopiedSize + VariableSize + PaddingHeaderSize > Progress->BufferSize) {
+        if (CopiedSize == 0) {
+          return EFI_BUFFER_TOO_SMALL;
+        }
+
+        break;
+      }
+
+      CopyMem (Progress->Buffer + CopiedSize, Variable, VariableSize);
+      CopiedSize += VariableSize;
+    }
+
+    ScannedSize          += VariableSize;
+    Progress->ScanOffset += VariableSize;
+  }
+
+  PaddingSize = Progress->ScanOffset - (Progress->CompactedOffset + CopiedSize);
+  if (PaddingSize == 0) {
+    return EFI_SUCCESS;
+  }
+
+  //
+  // Every variable is larger than the padding header, so the space freed by
+  // dropping at least one of them always fits the padding variable.
+  //
+  if (PaddingSize < PaddingHeaderSize) {
+    return EFI_VOLUME_CORRUPTED;
+  }
+
+  Padding = (VARIABLE_HEADER *)(Progress->Buffer + CopiedSize);
+  ZeroMem (Padding, PaddingHeaderSize);
+  Padding->StartId = VARIABLE_DATA;
+  Padding->State   = VAR_ADDED & VAR_DELETED;
+  SetNameSizeOfVariable (Padding, sizeof (CHAR16), AuthFormat);
+  SetDataSizeOfVariable (Padding, PaddingSize - GetVariableDataOffset (Padding, AuthFormat), AuthFormat);
+
+  Status = IncrementalReclaimWrite (Progress->CompactedOffset, CopiedSize + PaddingHeaderSize, Progress->Buffer);
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  Progress->CompactedOffset += CopiedSize;
+  return EFI_SUCCESS;
+}
+
+/**
+  Erases the next region of the body of the padding variable, from the top down.
+
+  @param[in, out] Progress      The incremental reclaim progress.
+  @param[in]      StepSize      Maximum number of store bytes to erase.
+
+  @retval EFI_SUCCESS           The region was erased.
+  @retval Others                The Fault Tolerant Write failed.
+
+**/
+STATIC
+EFI_STATUS
+IncrementalReclaimErase (
+  IN OUT VARIABLE_INCREMENTAL_RECLAIM  *Progress,
+  IN     UINTN                         StepSize
+  )
+{
+  UINTN       EraseStart;
+  EFI_STATUS  Status;
+
+  if (Progress->EraseEnd - Progress->EraseFloor > StepSize) {
+    EraseStart = Progress->EraseEnd - StepSize;
+  } else {
+    EraseStart = Progress->EraseFloor;
+  }
+
+  SetMem (Progress->Buffer, Progress->EraseEnd - EraseStart, 0xff);
+  Status = IncrementalReclaimWrite (EraseStart, Progress->EraseEnd - EraseStart, Progress->Buffer);
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  Progress->EraseEnd = EraseStart;
+  Progress->Erasing  = (BOOLEAN)(EraseStart != Progress->EraseFloor);
+  return EFI_SUCCESS;
+}
+
+/**
+  Completes the incremental reclaim once the body of the padding variable is
+  erased.
+
+  The variables set behind the padding variable meanwhile are moved down to
+  CompactedOffset over the padding variable header, which leaves the erased
+  body as free space at the end of the store. Their old copies, beyond the new
+  end of the store, are erased right after.
+
+  @param[in, out] Progress      The incremental reclaim progress.
+  @param[in]      AuthFormat    TRUE indicates authenticated variables are used.
+                                FALSE indicates authenticated variables are not used.
+
+  @retval EFI_SUCCESS           The reclaim is complete.
+  @retval EFI_VOLUME_CORRUPTED  The store does not have the expected layout.
+  @retval Others                The Fault Tolerant Write failed.
+
+**/
+STATIC
+EFI_STATUS
+IncrementalReclaimClose (
+  IN OUT VARIABLE_INCREMENTAL_RECLAIM  *Progress,
+  IN     BOOLEAN                       AuthFormat
+  )
+{
+  VARIABLE_HEADER  *Variable;
+  UINTN            LastOffset;
+  UINTN            Offset;
+  UINTN            CopiedSize;
+  UINTN            WriteSize;
+  UINTN            VariableSize;
+  UINTN            EraseStart;
+  EFI_STATUS       Status;
+
+  LastOffset = mVariableModuleGlobal->NonVolatileLastVariableOffset;
+  CopiedSize = 0;
+  for (Offset = Progress->ScanOffset; Offset < LastOffset; Offset += VariableSize) {
+    Variable = (VARIABLE_HEADER *)((UINTN)mNvVariableCache + Offset);
+    if (!IsValidVariableHeader (Variable, GetEndPointer (mNvVariableCache))) {
+      return EFI_VOLUME_CORRUPTED;
+    }
+
+    VariableSize = (UINTN)GetNextVariablePtr (Variable, AuthFormat) - (UINTN)Variable;
+    if ((Variable->State == VAR_ADDED) || (Variable->State == (VAR_IN_DELETED_TRANSITION & VAR_ADDED))) {
+      CopyMem (Progress->Buffer + CopiedSize, Variable, VariableSize);
+      CopiedSize += VariableSize;
+    }
+  }
+
+  WriteSize = MAX (CopiedSize, GetVariableHeaderSize (AuthFormat) + sizeof (CHAR16));
+  SetMem (Progress->Buffer + CopiedSize, WriteSize - CopiedSize, 0xff);
+  Status = IncrementalReclaimWrite (Progress->CompactedOffset, WriteSize, Progress->Buffer);
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  mVariableModuleGlobal->NonVolatileLastVariableOffset = Progress->CompactedOffset + CopiedSize;
+  RecalculateNvVariableTotalSize ();
+  Progress->Active                 = FALSE;
+  Progress->LastOffsetAtCompletion = mVariableModuleGlobal->NonVolatileLastVariableOffset;
+
+  //
+  // A reset before the old copies are erased leaves them behind the end of
+  // the store, where the next boot detects them and reclaims the store.
+  //
+  EraseStart = MAX (Progress->ScanOffset, Progress->CompactedOffset + WriteSize);
+  if (EraseStart < LastOffset) {
+    SetMem (Progress->Buffer, LastOffset - EraseStart, 0xff);
+    Status = IncrementalReclaimWrite (EraseStart, LastOffset - EraseStart, Progress->Buffer);
+  }
+
+  return Status;
+}
+
+/**
+  Performs one bounded step of the incremental reclaim of the non-volatile
+  variable store, if PcdVariableReclaimStepSize enables it.
+
+  A pass starts once half of the common variable space is used and the store
+  grew by an eighth of it since the previous pass. Each step then compacts the
+  next PcdVariableReclaimStepSize bytes of the store, or erases that much of
+  the space freed so far, with a single Fault Tolerant Write, so the latency a
+  step adds to SetVariable () is bounded. Reclaim () remains the fallback when
+  the store runs out of space anyway.
+
+  Caution: This function may be invoked at SMM mode.
+
+**/
+VOID
+IncrementalReclaimStep (
+  VOID
+  )
+{
+  VARIABLE_INCREMENTAL_RECLAIM  *Progress;
+  UINTN                         StepSize;
+  UINTN                         CommonVariableSpace;
+  UINTN                         ScanOffset;
+  UINTN                         PaddingHeaderSize;
+  BOOLEAN                       AuthFormat;
+  UINT64                        StartTick;
+  EFI_STATUS                    Status;
+
+  Progress = &mVariableModuleGlobal->IncrementalReclaim;
+  if ((Progress->Buffer == NULL) || (AtRuntime () && !Progress->AllowedAtRuntime)) {
+    return;
+  }
+
+  StepSize          = PcdGet32 (PcdVariableReclaimStepSize);
+  AuthFormat        = mVariableModuleGlobal->VariableGlobal.AuthFormat;
+  PaddingHeaderSize = GetVariableHeaderSize (AuthFormat) + sizeof (CHAR16);
+
+  if (!Progress->Active) {
+    CommonVariableSpace = mVariableModuleGlobal->CommonVariableSpace;
+    if ((mVariableModuleGlobal->CommonVariableTotalSize < CommonVariableSpace / 2) ||
+        (mVariableModuleGlobal->NonVolatileLastVariableOffset < Progress->LastOffsetAtCompletion + CommonVariableSpace / 8))
+    {
+      return;
+    }
+
+    Progress->Active          = TRUE;
+    Progress->Scanned         = FALSE;
+    Progress->Erasing         = FALSE;
+    Progress->CompactedOffset = (UINTN)GetStartPointer (mNvVariableCache) - (UINTN)mNvVariableCache;
+    Progress->ScanOffset      = Progress->CompactedOffset;
+  }
+
+  StartTick = VariableLatencyStart ();
+  if (Progress->Erasing) {
+    Status = IncrementalReclaimErase (Progress, StepSize);
+  } else if (!Progress->Scanned) {
+    //
+    // First pass over the store, garbage is collected into the padding variable.
+    //
+    Status = IncrementalReclaimCompact (Progress, StepSize, AuthFormat);
+    if (!EFI_ERROR (Status) && (Progress->ScanOffset == mVariableModuleGlobal->NonVolatileLastVariableOffset)) {
+      if (Progress->CompactedOffset == Progress->ScanOffset) {
+        //
+        // The whole store was valid, there is nothing to free.
+        //
+        Progress->Active                 = FALSE;
+        Progress->LastOffsetAtCompletion = Progress->ScanOffset;
+      } else {
+        Progress->Scanned    = TRUE;
+        Progress->Erasing    = TRUE;
+        Progress->EraseFloor = Progress->CompactedOffset + PaddingHeaderSize;
+        Progress->EraseEnd   = Progress->ScanOffset;
+      }
+    }
+  } else if (mVariableModuleGlobal->NonVolatileLastVariableOffset - Progress->ScanOffset <= StepSize) {
+    Status = IncrementalReclaimClose (Progress, AuthFormat);
+  } else {
+    //
+    // Too many variables were set behind the padding variable while it was
+    // erased, move a step worth of them and erase their old copies first.
+    //
+    ScanOffset = Progress->ScanOffset;
+    Status     = IncrementalReclaimCompact (Progress, StepSize, AuthFormat);
+    if (!EFI_ERROR (Status)) {
+      Progress->EraseFloor = MAX (ScanOffset, Progress->CompactedOffset + PaddingHeaderSize);
+      Progress->EraseEnd   = Progress->ScanOffset;
+      Progress->Erasing    = (BOOLEAN)(Progress->EraseEnd > Progress->EraseFloor);
+    }
+  }
+
+  VariableLatencyRecord (&mVariableModuleGlobal->Latency.ReclaimStep, StartTick);
+
+  if (EFI_ERROR (Status)) {
+    //
+    // The store is still valid, leave the rest to Reclaim ().
+    //
+    DEBUG ((DEBUG_WARN, "Variable: incremental reclaim step failed - %r\n", Status));
+    Progress->Active                 = FALSE;
+    Progress->LastOffsetAtCompletion = mVariableModuleGlobal->NonVolatileLastVariableOffset;
+  }
+}
@@ -86,14 +86,13 @@ GetLbaAndOffsetByAddress (
 }
 
 /**
-  Writes a buffer to variable storage space, in the working block.
-
-  This function writes a buffer to variable storage space into a firmware
-  volume block device. The destination is specified by parameter
-  VariableBase. Fault Tolerant Write protocol is used for writing.
+  Writes a buffer to a range of the variable storage space, in the working
+  block, using the Fault Tolerant Write protocol.
 
-  @param  VariableBase   Base address of variable to write
-  @param  VariableBuffer Point to the variable data buffer.
+  @param  VariableBase   Base address of the variable store.
+  @param  Offset         Offset of the range in the variable store.
+  @param  Length         Length of the range in bytes.
+  @param  Buffer         Point to the data to write.
 
   @retval EFI_SUCCESS    The function completed successfully.
   @retval EFI_NOT_FOUND  Fail to locate Fault Tolerant Write protocol.
@@ -101,16 +100,17 @@ GetLbaAndOffsetByAddress (
 
 **/
 EFI_STATUS
-FtwVariableSpace (
-  IN EFI_PHYSICAL_ADDRESS   VariableBase,
-  IN VARIABLE_STORE_HEADER  *VariableBuffer
+FtwVariableRange (
+  IN EFI_PHYSICAL_ADDRESS  VariableBase,
+  IN UINTN                 Offset,
+  IN UINTN                 Length,
+  IN VOID                  *Buffer
   )
 {
   EFI_STATUS                         Status;
   EFI_HANDLE                         FvbHandle;
   EFI_LBA                            VarLba;
   UINTN                              VarOffset;
-  UINTN                              FtwBufferSize;
   EFI_FAULT_TOLERANT_WRITE_PROTOCOL  *FtwProtocol;
 
   //
@@ -132,14 +132,11 @@ FtwVariableSpace (
   //
   // Get LBA and Offset by address.
   //
-  Status = GetLbaAndOffsetByAddress (VariableBase, &VarLba, &VarOffset);
+  Status = GetLbaAndOffsetByAddress (VariableBase + Offset, &VarLba, &VarOffset);
   if (EFI_ERROR (Status)) {
     return EFI_ABORTED;
   }
 
-  FtwBufferSize = ((VARIABLE_STORE_HEADER *)((UINTN)VariableBase))->Size;
-  ASSERT (FtwBufferSize == VariableBuffer->Size);
-
   //
   // FTW write record.
   //
@@ -147,11 +144,168 @@ FtwVariableSpace (
                           FtwProtocol,
                           VarLba,                // LBA
                           VarOffset,             // Offset
-                          FtwBufferSize,         // NumBytes
+                          Length,                // NumBytes
                           NULL,                  // PrivateData NULL
                           FvbHandle,             // Fvb Handle
-                          (VOID *)VariableBuffer // write buffer
+                          Buffer                 // write buffer
                           );
 
   return Status;
 }
+
+/**
+  Writes a buffer to variable storage space, in the working block.
+
+  This function writes a buffer to variable storage space into a firmware
+  volume block device. The destination is specified by parameter
+  VariableBase. Fault Tolerant Write protocol is used for writing.
+
+  @param  VariableBase   Base address of variable to write
+  @param  VariableBuffer Point to the variable data buffer.
+
+  @retval EFI_SUCCESS    The function completed successfully.
+  @retval EFI_NOT_FOUND  Fail to locate Fault Tolerant Write protocol.
+  @retval EFI_ABORTED    The function could not complete successfully.
+
+**/
+EFI_STATUS
+FtwVariableSpace (
+  IN EFI_PHYSICAL_ADDRESS   VariableBase,
+  IN VARIABLE_STORE_HEADER  *VariableBuffer
+  )
+{
+  UINTN  FtwBufferSize;
+
+  FtwBufferSize = ((VARIABLE_STORE_HEADER *)((UINTN)VariableBase))->Size;
+  ASSERT (FtwBufferSize == VariableBuffer->Size);
+
+  return FtwVariableRange (VariableBase, 0, FtwBufferSize, VariableBuffer);
+}
+
+/**
+  Starts timing an operation for a latency histogram.
+
+  @return The current performance counter value, or 0 if variable statistics
+          are not collected.
+
+**/
+UINT64
+VariableLatencyStart (
+  VOID
+  )
+{
+  if (!FeaturePcdGet (PcdVariableCollectStatistics)) {
+    return 0;
+  }
+
+  return GetPerformanceCounter ();
+}
+
+/**
+  Records the latency of an operation in a latency histogram.
+
+  @param[in, out] Histogram     The latency histogram.
+  @param[in]      StartTick     The value VariableLatencyStart () returned when
+                                the operation started.
+
+**/
+VOID
+VariableLatencyRecord (
+  IN OUT VARIABLE_LATENCY_HISTOGRAM  *Histogram,
+  IN     UINT64                      StartTick
+  )
+{
+  UINT64  EndTick;
+  UINT64  CounterStart;
+  UINT64  CounterEnd;
+  UINT64  ElapsedNs;
+  UINT64  ElapsedUs;
+  UINTN   Bucket;
+
+  if (!FeaturePcdGet (PcdVariableCollectStatistics)) {
+    return;
+  }
+
+  EndTick = GetPerformanceCounter ();
+  GetPerformanceCounterProperties (&CounterStart, &CounterEnd);
+  if (CounterEnd < CounterStart) {
+    //
+    // The performance counter counts down.
+    //
+    ElapsedNs = GetTimeInNanoSecond (StartTick - EndTick);
+  } else {
+    ElapsedNs = GetTimeInNanoSecond (EndTick - StartTick);
+  }
+
+  ElapsedUs = DivU64x32 (ElapsedNs, 1000);
+  Bucket    = (ElapsedUs == 0) ? 0 : (UINTN)HighBitSet64 (ElapsedUs) + 1;
+  if (Bucket >= VARIABLE_LATENCY_BUCKETS) {
+    Bucket = VARIABLE_LATENCY_BUCKETS - 1;
+  }
+
+  Histogram->Count++;
+  Histogram->Bucket[Bucket]++;
+  if (ElapsedNs > Histogram->MaxNs) {
+    Histogram->MaxNs = ElapsedNs;
+  }
+}
+
+/**
+  Reports one latency histogram to the debug log.
+
+  @param[in] Name           Name of the measured operation.
+  @param[in] Histogram      The latency histogram.
+
+**/
+STATIC
+VOID
+DumpLatencyHistogram (
+  IN CONST CHAR8                 *Name,
+  IN VARIABLE_LATENCY_HISTOGRAM  *Histogram
+  )
+{
+  UINTN  Bucket;
+
+  if (Histogram->Count == 0) {
+    return;
+  }
+
+  DEBUG ((
+    DEBUG_INFO,
+    "Variable: %a latency - %d calls, max %ld us\n",
+    Name,
+    Histogram->Count,
+    DivU64x32 (Histogram->MaxNs, 1000)
+    ));
+  for (Bucket = 0; Bucket < VARIABLE_LATENCY_BUCKETS; Bucket++) {
+    if (Histogram->Bucket[Bucket] == 0) {
+      continue;
+    }
+
+    if (Bucket == 0) {
+      DEBUG ((DEBUG_INFO, "  < 1 us: %d\n", Histogram->Bucket[Bucket]));
+    } else if (Bucket == VARIABLE_LATENCY_BUCKETS - 1) {
+      DEBUG ((DEBUG_INFO, "  >= %ld us: %d\n", LShiftU64 (1, Bucket - 1), Histogram->Bucket[Bucket]));
+    } else {
+      DEBUG ((DEBUG_INFO, "  [%ld, %ld) us: %d\n", LShiftU64 (1, Bucket - 1), LShiftU64 (1, Bucket), Histogram->Bucket[Bucket]));
+    }
+  }
+}
+
+/**
+  Reports the SetVariable () and reclaim latency histograms to the debug log.
+
+**/
+VOID
+VariableDumpLatencyStatistics (
+  VOID
+  )
+{
+  if (!FeaturePcdGet (PcdVariableCollectStatistics)) {
+    return;
+  }
+
+  DumpLatencyHistogram ("SetVariable", &mVariableModuleGlobal->Latency.SetVariable);
+  DumpLatencyHistogram ("Reclaim", &mVariableModuleGlobal->Latency.Reclaim);
+  DumpLatencyHistogram ("Incremental reclaim step", &mVariableModuleGlobal->Latency.ReclaimStep);
+}
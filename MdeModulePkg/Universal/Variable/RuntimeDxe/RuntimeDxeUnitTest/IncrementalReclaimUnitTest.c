@@ -0,0 +1,591 @@
+/** @file
+  Host-based unit test of the incremental reclaim of the non-volatile variable
+  store.
+
+  Variables are updated at random in a small store, with an incremental reclaim
+  step after every update, as SetVariable () does. The Fault Tolerant Write is
+  simulated on a copy of the flash, which is checked after every write as if
+  the system lost power right after it: it must always be a valid variable
+  store holding every variable with its latest data. Failed writes must leave
+  the store as it was.
+
+  Copyright (c) 2026, Intel Corporation. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include <stdio.h>
+#include <string.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <setjmp.h>
+#include <cmocka.h>
+
+#include "../Variable.h"
+#include "../VariableParsing.h"
+#include "../VariableRuntimeCache.h"
+
+#include <Library/UnitTestLib.h>
+#include <Library/PrintLib.h>
+
+#define UNIT_TEST_APP_NAME     "Variable Incremental Reclaim Unit Tests"
+#define UNIT_TEST_APP_VERSION  "1.0"
+
+#define TEST_STORE_SIZE       SIZE_64KB
+#define TEST_VARIABLE_COUNT   200
+#define TEST_NAME_LENGTH      8
+#define TEST_MAX_DATA_SIZE    60
+#define TEST_UPDATE_COUNT     8000
+#define TEST_MAX_UPDATE_SIZE  (sizeof (AUTHENTICATED_VARIABLE_HEADER) + TEST_NAME_LENGTH * sizeof (CHAR16) + TEST_MAX_DATA_SIZE + 4)
+
+//
+// Sized like the variable driver does: a step worth of variables, the largest
+// variable and the padding variable behind them.
+//
+#define TEST_RECLAIM_BUFFER_SIZE  \
+  (PcdGet32 (PcdVariableReclaimStepSize) + TEST_MAX_UPDATE_SIZE + sizeof (AUTHENTICATED_VARIABLE_HEADER) + sizeof (CHAR16))
+
+typedef struct {
+  BOOLEAN    AuthFormat;
+  UINTN      FailEvery;
+} INCREMENTAL_RECLAIM_TEST_CONTEXT;
+
+VARIABLE_MODULE_GLOBAL  mTestGlobal;
+VARIABLE_MODULE_GLOBAL  *mVariableModuleGlobal = &mTestGlobal;
+VARIABLE_STORE_HEADER   *mNvVariableCache;
+
+///
+/// The simulated flash the Fault Tolerant Write updates.
+///
+VARIABLE_STORE_HEADER  *mTestFlash;
+UINTN                  mTestWriteCount;
+UINTN                  mTestFailedWriteCount;
+UINTN                  mTestMaxWriteLength;
+UINTN                  mTestFailEvery;
+BOOLEAN                mTestFlashValid;
+
+///
+/// The latest data of every test variable.
+///
+UINT8    mTestData[TEST_VARIABLE_COUNT][TEST_MAX_DATA_SIZE];
+UINTN    mTestDataSize[TEST_VARIABLE_COUNT];
+BOOLEAN  mTestLive[TEST_VARIABLE_COUNT];
+
+INCREMENTAL_RECLAIM_TEST_CONTEXT  mTestNormal    = { FALSE, 0 };
+INCREMENTAL_RECLAIM_TEST_CONTEXT  mTestAuth      = { TRUE, 0 };
+INCREMENTAL_RECLAIM_TEST_CONTEXT  mTestFailWrite = { FALSE, 61 };
+
+/**
+  Stub of the variable driver runtime indicator.
+
+  @retval FALSE             The test runs at boot time.
+
+**/
+BOOLEAN
+AtRuntime (
+  VOID
+  )
+{
+  return FALSE;
+}
+
+/**
+  Stub of the user variable check, all test variables are system variables.
+
+  @param[in] Variable   Pointer to variable header.
+
+  @retval FALSE         System variable.
+
+**/
+BOOLEAN
+IsUserVariable (
+  IN VARIABLE_HEADER  *Variable
+  )
+{
+  return FALSE;
+}
+
+/**
+  Stub of the runtime cache synchronization, the test has no runtime cache.
+
+  @param[in] VariableRuntimeCache Variable runtime cache structure.
+  @param[in] Offset               Offset in bytes to apply the update.
+  @param[in] Length               Length of data in bytes of the update.
+
+  @retval EFI_SUCCESS             Always.
+
+**/
+EFI_STATUS
+SynchronizeRuntimeVariableCache (
+  IN  VARIABLE_RUNTIME_CACHE  *VariableRuntimeCache,
+  IN  UINTN                   Offset,
+  IN  UINTN                   Length
+  )
+{
+  return EFI_SUCCESS;
+}
+
+/**
+  Stub of the latency statistics, not collected by the test.
+
+  @return 0.
+
+**/
+UINT64
+VariableLatencyStart (
+  VOID
+  )
+{
+  return 0;
+}
+
+/**
+  Stub of the latency statistics, not collected by the test.
+
+  @param[in, out] Histogram     The latency histogram.
+  @param[in]      StartTick     The start of the operation.
+
+**/
+VOID
+VariableLatencyRecord (
+  IN OUT VARIABLE_LATENCY_HISTOGRAM  *Histogram,
+  IN     UINT64                      StartTick
+  )
+{
+}
+
+/**
+  Builds the name of test variable Index.
+
+  @param  Index  The index of the variable.
+  @param  Name   Buffer of TEST_NAME_LENGTH characters receiving the name.
+
+**/
+STATIC
+VOID
+TestVariableName (
+  IN  UINTN   Index,
+  OUT CHAR16  *Name
+  )
+{
+  UnicodeSPrint (Name, TEST_NAME_LENGTH * sizeof (CHAR16), L"V%d", (UINT32)Index);
+}
+
+/**
+  Returns the index of the test variable a variable of the store is.
+
+  @param  Variable  The variable.
+
+  @return The index of the test variable, or TEST_VARIABLE_COUNT if the
+          variable is not a test variable.
+
+**/
+STATIC
+UINTN
+TestVariableIndex (
+  IN VARIABLE_HEADER  *Variable
+  )
+{
+  CHAR16   *Name;
+  BOOLEAN  AuthFormat;
+  UINTN    Index;
+
+  AuthFormat = mTestGlobal.VariableGlobal.AuthFormat;
+  Name       = GetVariableNamePtr (Variable, AuthFormat);
+  if ((NameSizeOfVariable (Variable, AuthFormat) > TEST_NAME_LENGTH * sizeof (CHAR16)) || (*Name != L'V')) {
+    return TEST_VARIABLE_COUNT;
+  }
+
+  Index = 0;
+  for (Name++; (*Name >= L'0') && (*Name <= L'9'); Name++) {
+    Index = Index * 10 + (*Name - L'0');
+  }
+
+  if ((*Name != L'\0') || (Index > TEST_VARIABLE_COUNT)) {
+    return TEST_VARIABLE_COUNT;
+  }
+
+  return Index;
+}
+
+/**
+  Checks that a variable store holds every live test variable exactly once,
+  with its latest data, and nothing else.
+
+  @param  Store  The variable store to check.
+  @param  When   Description of the check for the log.
+
+  @retval TRUE   The store is as expected.
+  @retval FALSE  The store is not as expected.
+
+**/
+STATIC
+BOOLEAN
+CheckStore (
+  IN VARIABLE_STORE_HEADER  *Store,
+  IN CONST CHAR8            *When
+  )
+{
+  VARIABLE_HEADER  *Variable;
+  BOOLEAN          Seen[TEST_VARIABLE_COUNT];
+  BOOLEAN          AuthFormat;
+  UINTN            Index;
+
+  AuthFormat = mTestGlobal.VariableGlobal.AuthFormat;
+  ZeroMem (Seen, sizeof (Seen));
+
+  Variable = GetStartPointer (Store);
+  while (IsValidVariableHeader (Variable, GetEndPointer (Store))) {
+    if (Variable->State == VAR_ADDED) {
+      Index = TestVariableIndex (Variable);
+      if ((Index == TEST_VARIABLE_COUNT) || !mTestLive[Index] || Seen[Index]) {
+        UT_LOG_ERROR ("%a: unexpected variable at 0x%x\n", When, (UINTN)Variable - (UINTN)Store);
+        return FALSE;
+      }
+
+      if ((DataSizeOfVariable (Variable, AuthFormat) != mTestDataSize[Index]) ||
+          (CompareMem (GetVariableDataPtr (Variable, AuthFormat), mTestData[Index], mTestDataSize[Index]) != 0))
+      {
+        UT_LOG_ERROR ("%a: wrong data of V%d\n", When, Index);
+        return FALSE;
+      }
+
+      Seen[Index] = TRUE;
+    }
+
+    Variable = GetNextVariablePtr (Variable, AuthFormat);
+  }
+
+  for (Index = 0; Index < TEST_VARIABLE_COUNT; Index++) {
+    if (mTestLive[Index] && !Seen[Index]) {
+      UT_LOG_ERROR ("%a: lost V%d\n", When, Index);
+      return FALSE;
+    }
+  }
+
+  return TRUE;
+}
+
+/**
+  Simulated Fault Tolerant Write of a range of the variable store.
+
+  Every mTestFailEvery-th write fails without changing the flash. After a
+  write, the flash is checked as it would be found after a power loss.
+
+  @param[in] VariableBase   Base address of the variable store.
+  @param[in] Offset         Offset of the range in the variable store.
+  @param[in] Length         Length of the range in bytes.
+  @param[in] Buffer         Data to write.
+
+  @retval EFI_SUCCESS       The range was written.
+  @retval EFI_DEVICE_ERROR  The write was made to fail.
+
+**/
+EFI_STATUS
+FtwVariableRange (
+  IN EFI_PHYSICAL_ADDRESS  VariableBase,
+  IN UINTN                 Offset,
+  IN UINTN                 Length,
+  IN VOID                  *Buffer
+  )
+{
+  mTestWriteCount++;
+  if ((mTestFailEvery != 0) && ((mTestWriteCount % mTestFailEvery) == 0)) {
+    mTestFailedWriteCount++;
+    return EFI_DEVICE_ERROR;
+  }
+
+  if ((Offset > TEST_STORE_SIZE) || (Length > TEST_STORE_SIZE - Offset)) {
+    UT_LOG_ERROR ("write [0x%x, +0x%x) past the end of the store\n", Offset, Length);
+    mTestFlashValid = FALSE;
+    return EFI_DEVICE_ERROR;
+  }
+
+  mTestMaxWriteLength = MAX (mTestMaxWriteLength, Length);
+  CopyMem ((UINT8 *)mTestFlash + Offset, Buffer, Length);
+  if (!CheckStore (mTestFlash, "flash after write")) {
+    mTestFlashValid = FALSE;
+  }
+
+  return EFI_SUCCESS;
+}
+
+/**
+  Sets a test variable to new random data the way UpdateVariable () does,
+  marking the old copy deleted and appending the new one, in both the flash
+  and the non-volatile variable cache.
+
+  @param  Index     The index of the variable.
+  @param  DataSize  The size of the new data.
+
+  @retval EFI_SUCCESS           The variable was set.
+  @retval EFI_OUT_OF_RESOURCES  The store is full.
+
+**/
+STATIC
+EFI_STATUS
+SetTestVariable (
+  IN UINTN  Index,
+  IN UINTN  DataSize
+  )
+{
+  VARIABLE_HEADER  *Variable;
+  CHAR16           Name[TEST_NAME_LENGTH];
+  BOOLEAN          AuthFormat;
+  UINTN            Offset;
+  UINTN            VariableSize;
+  UINTN            DataIndex;
+
+  AuthFormat = mTestGlobal.VariableGlobal.AuthFormat;
+  TestVariableName (Index, Name);
+
+  Offset = mTestGlobal.NonVolatileLastVariableOffset;
+  if (Offset + TEST_MAX_UPDATE_SIZE > TEST_STORE_SIZE) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  Variable = GetStartPointer (mNvVariableCache);
+  while ((UINTN)Variable - (UINTN)mNvVariableCache < Offset) {
+    if ((Variable->State == VAR_ADDED) && (TestVariableIndex (Variable) == Index)) {
+      Variable->State &= VAR_DELETED;
+      ((VARIABLE_HEADER *)((UINT8 *)mTestFlash + ((UINTN)Variable - (UINTN)mNvVariableCache)))->State = Variable->State;
+    }
+
+    Variable = GetNextVariablePtr (Variable, AuthFormat);
+  }
+
+  Variable = (VARIABLE_HEADER *)((UINT8 *)mNvVariableCache + Offset);
+  ZeroMem (Variable, GetVariableHeaderSize (AuthFormat));
+  Variable->StartId    = VARIABLE_DATA;
+  Variable->State      = VAR_ADDED;
+  Variable->Attributes = EFI_VARIABLE_NON_VOLATILE | EFI_VARIABLE_BOOTSERVICE_ACCESS;
+  SetNameSizeOfVariable (Variable, StrSize (Name), AuthFormat);
+  SetDataSizeOfVariable (Variable, DataSize, AuthFormat);
+  CopyMem (GetVariableNamePtr (Variable, AuthFormat), Name, StrSize (Name));
+  for (DataIndex = 0; DataIndex < DataSize; DataIndex++) {
+    mTestData[Index][DataIndex] = (UINT8)rand ();
+  }
+
+  CopyMem (GetVariableDataPtr (Variable, AuthFormat), mTestData[Index], DataSize);
+  mTestDataSize[Index] = DataSize;
+  mTestLive[Index]     = TRUE;
+
+  VariableSize = (UINTN)GetNextVariablePtr (Variable, AuthFormat) - (UINTN)Variable;
+  CopyMem ((UINT8 *)mTestFlash + Offset, Variable, VariableSize);
+  mTestGlobal.NonVolatileLastVariableOffset += VariableSize;
+  mTestGlobal.CommonVariableTotalSize       += VariableSize;
+  return EFI_SUCCESS;
+}
+
+/**
+  Formats an empty store in the flash and the cache, and resets the driver
+  state.
+
+  @param  AuthFormat  TRUE to use the authenticated variable format.
+
+**/
+STATIC
+VOID
+ResetTestStore (
+  IN BOOLEAN  AuthFormat
+  )
+{
+  UINT8  *Buffer;
+
+  Buffer = mTestGlobal.IncrementalReclaim.Buffer;
+  ZeroMem (&mTestGlobal, sizeof (mTestGlobal));
+  mTestGlobal.VariableGlobal.AuthFormat     = AuthFormat;
+  mTestGlobal.CommonVariableSpace           = TEST_STORE_SIZE;
+  mTestGlobal.IncrementalReclaim.BufferSize = TEST_RECLAIM_BUFFER_SIZE;
+  mTestGlobal.IncrementalReclaim.Buffer     = Buffer;
+
+  SetMem (mNvVariableCache, TEST_STORE_SIZE, 0xff);
+  ZeroMem (mNvVariableCache, sizeof (VARIABLE_STORE_HEADER));
+  CopyGuid (&mNvVariableCache->Signature, AuthFormat ? &gEfiAuthenticatedVariableGuid : &gEfiVariableGuid);
+  mNvVariableCache->Size   = TEST_STORE_SIZE;
+  mNvVariableCache->Format = VARIABLE_STORE_FORMATTED;
+  mNvVariableCache->State  = VARIABLE_STORE_HEALTHY;
+  CopyMem (mTestFlash, mNvVariableCache, TEST_STORE_SIZE);
+
+  mTestGlobal.NonVolatileLastVariableOffset = (UINTN)GetStartPointer (mNvVariableCache) - (UINTN)mNvVariableCache;
+
+  ZeroMem (mTestLive, sizeof (mTestLive));
+  mTestWriteCount       = 0;
+  mTestFailedWriteCount = 0;
+  mTestMaxWriteLength   = 0;
+  mTestFlashValid       = TRUE;
+}
+
+/**
+  Updates variables at random with a reclaim step after each update, and
+  checks the store after every step and every write.
+
+  @param[in]  Context    The INCREMENTAL_RECLAIM_TEST_CONTEXT of the test.
+
+  @retval  UNIT_TEST_PASSED             The Unit test has completed and the test
+                                        case was successful.
+  @retval  UNIT_TEST_ERROR_TEST_FAILED  A test case assertion has failed.
+
+**/
+UNIT_TEST_STATUS
+EFIAPI
+ReclaimWhileUpdating (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  INCREMENTAL_RECLAIM_TEST_CONTEXT  *TestContext;
+  VARIABLE_INCREMENTAL_RECLAIM      *Progress;
+  UINTN                             Update;
+  UINTN                             Passes;
+  UINTN                             Steps;
+  BOOLEAN                           WasActive;
+
+  TestContext = (INCREMENTAL_RECLAIM_TEST_CONTEXT *)Context;
+  Progress    = &mTestGlobal.IncrementalReclaim;
+
+  srand (1);
+  ResetTestStore (TestContext->AuthFormat);
+  mTestFailEvery = TestContext->FailEvery;
+  Passes         = 0;
+  Steps          = 0;
+
+  for (Update = 0; Update < TEST_UPDATE_COUNT; Update++) {
+    UT_ASSERT_NOT_EFI_ERROR (SetTestVariable (rand () % TEST_VARIABLE_COUNT, 1 + rand () % TEST_MAX_DATA_SIZE));
+
+    WasActive = Progress->Active;
+    IncrementalReclaimStep ();
+    if (Progress->Active) {
+      Steps++;
+    } else if (WasActive) {
+      Passes++;
+    }
+
+    UT_ASSERT_TRUE (mTestFlashValid);
+    UT_ASSERT_MEM_EQUAL (mTestFlash, mNvVariableCache, TEST_STORE_SIZE);
+    UT_ASSERT_TRUE (CheckStore (mNvVariableCache, "cache after step"));
+  }
+
+  UT_LOG_INFO (
+    "%d updates: %d passes, %d steps, %d writes (%d failed), longest write %d bytes\n",
+    TEST_UPDATE_COUNT,
+    Passes,
+    Steps,
+    mTestWriteCount,
+    mTestFailedWriteCount,
+    mTestMaxWriteLength
+    );
+
+  //
+  // The store never filled up, and was compacted at most a buffer at a time.
+  //
+  UT_ASSERT_TRUE (Passes > 0);
+  UT_ASSERT_TRUE (mTestMaxWriteLength <= Progress->BufferSize);
+  if (TestContext->FailEvery != 0) {
+    UT_ASSERT_TRUE (mTestFailedWriteCount > 0);
+  }
+
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  Initialize the unit test framework, suite, and unit tests for the
+  incremental reclaim and run the unit tests.
+
+  @retval  EFI_SUCCESS           All test cases were dispatched.
+  @retval  EFI_OUT_OF_RESOURCES  There are not enough resources available to
+                                 initialize the unit tests.
+**/
+EFI_STATUS
+EFIAPI
+UnitTestingEntry (
+  VOID
+  )
+{
+  EFI_STATUS                  Status;
+  UNIT_TEST_FRAMEWORK_HANDLE  Framework;
+  UNIT_TEST_SUITE_HANDLE      ReclaimTests;
+
+  Framework = NULL;
+
+  DEBUG ((DEBUG_INFO, "%a v%a\n", UNIT_TEST_APP_NAME, UNIT_TEST_APP_VERSION));
+
+  mNvVariableCache                      = AllocatePool (TEST_STORE_SIZE);
+  mTestFlash                            = AllocatePool (TEST_STORE_SIZE);
+  mTestGlobal.IncrementalReclaim.Buffer = AllocatePool (TEST_RECLAIM_BUFFER_SIZE);
+  if ((mNvVariableCache == NULL) || (mTestFlash == NULL) || (mTestGlobal.IncrementalReclaim.Buffer == NULL)) {
+    Status = EFI_OUT_OF_RESOURCES;
+    goto EXIT;
+  }
+
+  //
+  // Start setting up the test framework for running the tests.
+  //
+  Status = InitUnitTestFramework (&Framework, UNIT_TEST_APP_NAME, gEfiCallerBaseName, UNIT_TEST_APP_VERSION);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "Failed in InitUnitTestFramework. Status = %r\n", Status));
+    goto EXIT;
+  }
+
+  Status = CreateUnitTestSuite (&ReclaimTests, Framework, "Variable Incremental Reclaim Tests", "Variable.IncrementalReclaim", NULL, NULL);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "Failed in CreateUnitTestSuite for Variable Incremental Reclaim Tests\n"));
+    Status = EFI_OUT_OF_RESOURCES;
+    goto EXIT;
+  }
+
+  //
+  // --------------Suite----------Description--------------------------------------------Name-----------Function--------------Pre---Post---Context--------------
+  //
+  AddTestCase (ReclaimTests, "Store is valid after every write", "Compact", ReclaimWhileUpdating, NULL, NULL, &mTestNormal);
+  AddTestCase (ReclaimTests, "Store is valid after every write, authenticated format", "CompactAuth", ReclaimWhileUpdating, NULL, NULL, &mTestAuth);
+  AddTestCase (ReclaimTests, "Failed writes leave the store unchanged", "FailedWrite", ReclaimWhileUpdating, NULL, NULL, &mTestFailWrite);
+
+  //
+  // Execute the tests.
+  //
+  Status = RunAllTestSuites (Framework);
+
+EXIT:
+  if (Framework) {
+    FreeUnitTestFramework (Framework);
+  }
+
+  if (mNvVariableCache != NULL) {
+    FreePool (mNvVariableCache);
+  }
+
+  if (mTestFlash != NULL) {
+    FreePool (mTestFlash);
+  }
+
+  if (mTestGlobal.IncrementalReclaim.Buffer != NULL) {
+    FreePool (mTestGlobal.IncrementalReclaim.Buffer);
+  }
+
+  return Status;
+}
+
+///
+/// Avoid ECC error for function name that starts with lower case letter
+///
+#define IncrementalReclaimUnitTestMain  main
+
+/**
+  Standard POSIX C entry point for host based unit test execution.
+
+  @param[in] Argc  Number of arguments
+  @param[in] Argv  Array of pointers to arguments
+
+  @retval 0      Success
+  @retval other  Error
+**/
+INT32
+IncrementalReclaimUnitTestMain (
+  IN INT32  Argc,
+  IN CHAR8  *Argv[]
+  )
+{
+  UnitTestingEntry ();
+  return 0;
+}
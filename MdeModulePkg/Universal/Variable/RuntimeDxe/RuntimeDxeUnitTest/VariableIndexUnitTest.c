@@ -0,0 +1,604 @@
+/** @file
+  Host-based unit test and benchmark of the variable store (name, GUID) index.
+
+  A variable store of several thousand variables is built in memory, and every
+  lookup through the index is checked against the linear walk of
+  FindVariableEx () it replaces, across updates, reclaim and runtime.
+
+  Copyright (c) 2026, Intel Corporation. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include <stdio.h>
+#include <string.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <time.h>
+#include <cmocka.h>
+
+#include "../VariableIndex.h"
+
+#include <Library/UnitTestLib.h>
+#include <Library/PrintLib.h>
+
+#define UNIT_TEST_APP_NAME     "Variable Store Index Unit Tests"
+#define UNIT_TEST_APP_VERSION  "1.0"
+
+#define TEST_VARIABLE_COUNT  4096
+#define TEST_NAME_LENGTH     16
+#define TEST_STORE_SIZE      SIZE_1MB
+#define TEST_LOOKUP_COUNT    20000
+
+EFI_GUID  mTestGuidA = {
+  0x5c1a3b8e, 0x6a2f, 0x4d0b, { 0x9e, 0x31, 0x7f, 0x2a, 0x44, 0x0c, 0x1d, 0x65 }
+};
+EFI_GUID  mTestGuidB = {
+  0x5c1a3b8f, 0x6a2f, 0x4d0b, { 0x9e, 0x31, 0x7f, 0x2a, 0x44, 0x0c, 0x1d, 0x65 }
+};
+
+VARIABLE_STORE_HEADER  *mTestStore;
+VARIABLE_HEADER        *mTestStoreEnd;
+BOOLEAN                mTestAtRuntime;
+
+/**
+  Stub of the variable driver runtime indicator.
+
+  @retval TRUE              The test simulates runtime.
+  @retval FALSE             The test simulates boot time.
+
+**/
+BOOLEAN
+AtRuntime (
+  VOID
+  )
+{
+  return mTestAtRuntime;
+}
+
+/**
+  Returns the processor time elapsed since Start in microseconds.
+
+  @param  Start  The processor time at the start of the measurement.
+
+  @return Elapsed time in microseconds.
+
+**/
+STATIC
+UINT64
+ElapsedMicroseconds (
+  IN clock_t  Start
+  )
+{
+  return (UINT64)(clock () - Start) * 1000000 / CLOCKS_PER_SEC;
+}
+
+/**
+  Builds the name of test variable Index.
+
+  @param  Index  The index of the variable.
+  @param  Name   Buffer of TEST_NAME_LENGTH characters receiving the name.
+
+**/
+STATIC
+VOID
+TestVariableName (
+  IN  UINTN   Index,
+  OUT CHAR16  *Name
+  )
+{
+  UnicodeSPrint (Name, TEST_NAME_LENGTH * sizeof (CHAR16), L"TestVar%05d", (UINT32)Index);
+}
+
+/**
+  Returns the vendor GUID of test variable Index.
+
+  Every name is used by two variables in a row with different GUIDs, so the
+  index has to tell them apart by GUID.
+
+  @param  Index  The index of the variable.
+
+  @return The vendor GUID.
+
+**/
+STATIC
+EFI_GUID *
+TestVariableGuid (
+  IN UINTN  Index
+  )
+{
+  return ((Index & 1) == 0) ? &mTestGuidA : &mTestGuidB;
+}
+
+/**
+  Appends a variable at the end of the test store.
+
+  @param  Name        The variable name.
+  @param  Guid        The vendor GUID.
+  @param  Attributes  The variable attributes.
+  @param  State       The variable state.
+
+  @return The header of the new variable.
+
+**/
+STATIC
+VARIABLE_HEADER *
+AppendVariable (
+  IN CHAR16    *Name,
+  IN EFI_GUID  *Guid,
+  IN UINT32    Attributes,
+  IN UINT8     State
+  )
+{
+  VARIABLE_HEADER  *Variable;
+  UINT32           Data;
+
+  Variable             = mTestStoreEnd;
+  Data                 = 0x5a5a5a5a;
+  Variable->StartId    = VARIABLE_DATA;
+  Variable->State      = State;
+  Variable->Reserved   = 0;
+  Variable->Attributes = Attributes;
+  SetNameSizeOfVariable (Variable, StrSize (Name), FALSE);
+  SetDataSizeOfVariable (Variable, sizeof (Data), FALSE);
+  CopyGuid (GetVendorGuidPtr (Variable, FALSE), Guid);
+  CopyMem (GetVariableNamePtr (Variable, FALSE), Name, StrSize (Name));
+  CopyMem (GetVariableDataPtr (Variable, FALSE), &Data, sizeof (Data));
+
+  mTestStoreEnd = GetNextVariablePtr (Variable, FALSE);
+  return Variable;
+}
+
+/**
+  Looks a variable up through the index and by walking the store, and checks
+  that both return the same result.
+
+  @param  Name   The variable name.
+  @param  Guid   The vendor GUID.
+  @param  Track  Receives the result of the lookup.
+
+  @return The status of the lookup.
+
+**/
+STATIC
+EFI_STATUS
+FindAndCompare (
+  IN  CHAR16                  *Name,
+  IN  EFI_GUID                *Guid,
+  OUT VARIABLE_POINTER_TRACK  *Track
+  )
+{
+  VARIABLE_POINTER_TRACK  Walk;
+  EFI_STATUS              Status;
+  EFI_STATUS              WalkStatus;
+  BOOLEAN                 Enabled;
+
+  Track->StartPtr = GetStartPointer (mTestStore);
+  Track->EndPtr   = GetEndPointer (mTestStore);
+  Status          = FindVariableEx (Name, Guid, FALSE, Track, FALSE);
+
+  Enabled                                                = mVariableStoreIndex[VariableStoreTypeVolatile].Enabled;
+  mVariableStoreIndex[VariableStoreTypeVolatile].Enabled = FALSE;
+  Walk.StartPtr                                          = Track->StartPtr;
+  Walk.EndPtr                                            = Track->EndPtr;
+  WalkStatus                                             = FindVariableEx (Name, Guid, FALSE, &Walk, FALSE);
+  mVariableStoreIndex[VariableStoreTypeVolatile].Enabled = Enabled;
+
+  if ((Status != WalkStatus) ||
+      (!EFI_ERROR (Status) &&
+       ((Track->CurrPtr != Walk.CurrPtr) || (Track->InDeletedTransitionPtr != Walk.InDeletedTransitionPtr))))
+  {
+    UT_LOG_ERROR ("%s: index %r %p/%p, walk %r %p/%p\n", Name, Status, Track->CurrPtr, Track->InDeletedTransitionPtr, WalkStatus, Walk.CurrPtr, Walk.InDeletedTransitionPtr);
+    return EFI_ABORTED;
+  }
+
+  return Status;
+}
+
+/**
+  Checks every test variable, plus names that do not exist, against the walk.
+
+  @param  Count  The number of test variables to check.
+
+  @retval TRUE   All lookups matched.
+  @retval FALSE  A lookup did not match.
+
+**/
+STATIC
+BOOLEAN
+AllLookupsMatch (
+  IN UINTN  Count
+  )
+{
+  VARIABLE_POINTER_TRACK  Track;
+  CHAR16                  Name[TEST_NAME_LENGTH];
+  UINTN                   Index;
+
+  for (Index = 0; Index < Count + 16; Index++) {
+    TestVariableName (Index / 2, Name);
+    if (FindAndCompare (Name, TestVariableGuid (Index), &Track) == EFI_ABORTED) {
+      return FALSE;
+    }
+  }
+
+  return TRUE;
+}
+
+/**
+  Fills the store and checks lookups through the index against the walk.
+
+  @param[in]  Context    [Optional] An optional parameter that enables:
+                         1) test-case reuse with varied parameters and
+                         2) test-case re-entry for Target tests that need a
+                         reboot.  This parameter is a VOID* and it is the
+                         responsibility of the test author to ensure that the
+                         contents are well understood by all test cases that may
+                         consume it.
+
+  @retval  UNIT_TEST_PASSED             The Unit test has completed and the test
+                                        case was successful.
+  @retval  UNIT_TEST_ERROR_TEST_FAILED  A test case assertion has failed.
+
+**/
+UNIT_TEST_STATUS
+EFIAPI
+LookupMatchesWalk (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  VARIABLE_POINTER_TRACK  Track;
+  CHAR16                  Name[TEST_NAME_LENGTH];
+  UINTN                   Index;
+
+  for (Index = 0; Index < TEST_VARIABLE_COUNT; Index++) {
+    TestVariableName (Index / 2, Name);
+    AppendVariable (Name, TestVariableGuid (Index), EFI_VARIABLE_BOOTSERVICE_ACCESS | EFI_VARIABLE_RUNTIME_ACCESS, VAR_ADDED);
+  }
+
+  UT_ASSERT_NOT_EFI_ERROR (VariableIndexRegisterStore (VariableStoreTypeVolatile, mTestStore, FALSE));
+  UT_ASSERT_TRUE (mVariableStoreIndex[VariableStoreTypeVolatile].Enabled);
+  UT_ASSERT_EQUAL (mVariableStoreIndex[VariableStoreTypeVolatile].Count, TEST_VARIABLE_COUNT);
+  UT_ASSERT_TRUE (AllLookupsMatch (TEST_VARIABLE_COUNT));
+
+  //
+  // The empty name returns the first variable of the store.
+  //
+  UT_ASSERT_NOT_EFI_ERROR (FindAndCompare (L"", &mTestGuidA, &Track));
+  UT_ASSERT_TRUE (Track.CurrPtr == GetStartPointer (mTestStore));
+
+  TestVariableName (TEST_VARIABLE_COUNT, Name);
+  UT_ASSERT_STATUS_EQUAL (FindAndCompare (Name, &mTestGuidA, &Track), EFI_NOT_FOUND);
+
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  Updates, deletes and appends variables the way UpdateVariable () does, then
+  reclaims the store, and checks the index stays coherent.
+
+  @param[in]  Context    [Optional] An optional parameter that enables:
+                         1) test-case reuse with varied parameters and
+                         2) test-case re-entry for Target tests that need a
+                         reboot.  This parameter is a VOID* and it is the
+                         responsibility of the test author to ensure that the
+                         contents are well understood by all test cases that may
+                         consume it.
+
+  @retval  UNIT_TEST_PASSED             The Unit test has completed and the test
+                                        case was successful.
+  @retval  UNIT_TEST_ERROR_TEST_FAILED  A test case assertion has failed.
+
+**/
+UNIT_TEST_STATUS
+EFIAPI
+UpdateAndReclaim (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  VARIABLE_POINTER_TRACK  Track;
+  VARIABLE_HEADER         *OldVariable;
+  VARIABLE_HEADER         *NewVariable;
+  VARIABLE_HEADER         *Variable;
+  VARIABLE_HEADER         *NextVariable;
+  UINT8                   *Buffer;
+  UINT8                   *CurrPtr;
+  CHAR16                  Name[TEST_NAME_LENGTH];
+  UINTN                   Index;
+
+  //
+  // Replace a variable: the old copy goes through IN_DELETED_TRANSITION while
+  // the new copy is added at the end of the store.
+  //
+  TestVariableName (10, Name);
+  UT_ASSERT_NOT_EFI_ERROR (FindAndCompare (Name, &mTestGuidB, &Track));
+  OldVariable         = Track.CurrPtr;
+  OldVariable->State &= VAR_IN_DELETED_TRANSITION;
+  UT_ASSERT_NOT_EFI_ERROR (FindAndCompare (Name, &mTestGuidB, &Track));
+  UT_ASSERT_TRUE (Track.CurrPtr == OldVariable);
+
+  NewVariable = AppendVariable (Name, &mTestGuidB, EFI_VARIABLE_BOOTSERVICE_ACCESS | EFI_VARIABLE_RUNTIME_ACCESS, VAR_HEADER_VALID_ONLY);
+  UT_ASSERT_NOT_EFI_ERROR (FindAndCompare (Name, &mTestGuidB, &Track));
+  UT_ASSERT_TRUE (Track.CurrPtr == OldVariable);
+
+  NewVariable->State = VAR_ADDED;
+  UT_ASSERT_NOT_EFI_ERROR (FindAndCompare (Name, &mTestGuidB, &Track));
+  UT_ASSERT_TRUE (Track.CurrPtr == NewVariable);
+  UT_ASSERT_TRUE (Track.InDeletedTransitionPtr == OldVariable);
+
+  OldVariable->State &= VAR_DELETED;
+  UT_ASSERT_NOT_EFI_ERROR (FindAndCompare (Name, &mTestGuidB, &Track));
+  UT_ASSERT_TRUE (Track.CurrPtr == NewVariable);
+  UT_ASSERT_TRUE (Track.InDeletedTransitionPtr == NULL);
+
+  //
+  // Delete every third variable and add new ones.
+  //
+  for (Index = 0; Index < TEST_VARIABLE_COUNT; Index += 3) {
+    TestVariableName (Index / 2, Name);
+    UT_ASSERT_NOT_EFI_ERROR (FindAndCompare (Name, TestVariableGuid (Index), &Track));
+    Track.CurrPtr->State &= VAR_DELETED;
+  }
+
+  for (Index = TEST_VARIABLE_COUNT; Index < TEST_VARIABLE_COUNT + 64; Index++) {
+    TestVariableName (Index / 2, Name);
+    AppendVariable (Name, TestVariableGuid (Index), EFI_VARIABLE_BOOTSERVICE_ACCESS | EFI_VARIABLE_RUNTIME_ACCESS, VAR_ADDED);
+  }
+
+  UT_ASSERT_TRUE (AllLookupsMatch (TEST_VARIABLE_COUNT + 64));
+
+  //
+  // Reclaim moves the remaining variables, the index must be invalidated.
+  //
+  Buffer = AllocatePool (TEST_STORE_SIZE);
+  UT_ASSERT_NOT_NULL (Buffer);
+  SetMem (Buffer, TEST_STORE_SIZE, 0xff);
+  CopyMem (Buffer, mTestStore, sizeof (VARIABLE_STORE_HEADER));
+  CurrPtr = (UINT8 *)GetStartPointer ((VARIABLE_STORE_HEADER *)Buffer);
+  for (Variable = GetStartPointer (mTestStore); IsValidVariableHeader (Variable, GetEndPointer (mTestStore)); Variable = NextVariable) {
+    NextVariable = GetNextVariablePtr (Variable, FALSE);
+    if (Variable->State == VAR_ADDED) {
+      CopyMem (CurrPtr, Variable, (UINTN)NextVariable - (UINTN)Variable);
+      CurrPtr += (UINTN)NextVariable - (UINTN)Variable;
+    }
+  }
+
+  CopyMem (mTestStore, Buffer, TEST_STORE_SIZE);
+  mTestStoreEnd = (VARIABLE_HEADER *)((UINTN)mTestStore + ((UINTN)CurrPtr - (UINTN)Buffer));
+  FreePool (Buffer);
+
+  VariableIndexInvalidate (mTestStore);
+  UT_ASSERT_TRUE (AllLookupsMatch (TEST_VARIABLE_COUNT + 64));
+  UT_ASSERT_EQUAL (
+    mVariableStoreIndex[VariableStoreTypeVolatile].IndexedEnd,
+    (UINTN)mTestStoreEnd - (UINTN)mTestStore
+    );
+
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  Checks the runtime access filter and the fallback to walking the store when
+  the index cannot grow at runtime.
+
+  @param[in]  Context    [Optional] An optional parameter that enables:
+                         1) test-case reuse with varied parameters and
+                         2) test-case re-entry for Target tests that need a
+                         reboot.  This parameter is a VOID* and it is the
+                         responsibility of the test author to ensure that the
+                         contents are well understood by all test cases that may
+                         consume it.
+
+  @retval  UNIT_TEST_PASSED             The Unit test has completed and the test
+                                        case was successful.
+  @retval  UNIT_TEST_ERROR_TEST_FAILED  A test case assertion has failed.
+
+**/
+UNIT_TEST_STATUS
+EFIAPI
+RuntimeFallback (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  VARIABLE_POINTER_TRACK  Track;
+  VARIABLE_STORE_INDEX    *Index;
+  CHAR16                  Name[TEST_NAME_LENGTH];
+  UINTN                   Extra;
+
+  Index = &mVariableStoreIndex[VariableStoreTypeVolatile];
+
+  //
+  // Boot service only variables are not visible at runtime.
+  //
+  AppendVariable (L"BootOnly", &mTestGuidA, EFI_VARIABLE_BOOTSERVICE_ACCESS, VAR_ADDED);
+  UT_ASSERT_NOT_EFI_ERROR (FindAndCompare (L"BootOnly", &mTestGuidA, &Track));
+
+  mTestAtRuntime = TRUE;
+  UT_ASSERT_STATUS_EQUAL (FindAndCompare (L"BootOnly", &mTestGuidA, &Track), EFI_NOT_FOUND);
+
+  //
+  // Outgrow the index at runtime, lookups walk the store instead.
+  //
+  for (Extra = 0; Index->Count + Extra <= Index->Capacity; Extra++) {
+    UnicodeSPrint (Name, sizeof (Name), L"Runtime%05d", (UINT32)Extra);
+    AppendVariable (Name, &mTestGuidA, EFI_VARIABLE_BOOTSERVICE_ACCESS | EFI_VARIABLE_RUNTIME_ACCESS, VAR_ADDED);
+  }
+
+  UT_ASSERT_NOT_EFI_ERROR (FindAndCompare (Name, &mTestGuidA, &Track));
+  UT_ASSERT_FALSE (Index->Enabled);
+  UT_ASSERT_TRUE (AllLookupsMatch (TEST_VARIABLE_COUNT + 64));
+
+  //
+  // Back at boot time the next invalidation rebuilds a larger index.
+  //
+  mTestAtRuntime = FALSE;
+  VariableIndexInvalidate (NULL);
+  UT_ASSERT_NOT_EFI_ERROR (FindAndCompare (Name, &mTestGuidA, &Track));
+  UT_ASSERT_TRUE (Index->Enabled);
+  UT_ASSERT_TRUE (AllLookupsMatch (TEST_VARIABLE_COUNT + 64));
+
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  Measures lookup time through the index against walking the store.
+
+  @param[in]  Context    [Optional] An optional parameter that enables:
+                         1) test-case reuse with varied parameters and
+                         2) test-case re-entry for Target tests that need a
+                         reboot.  This parameter is a VOID* and it is the
+                         responsibility of the test author to ensure that the
+                         contents are well understood by all test cases that may
+                         consume it.
+
+  @retval  UNIT_TEST_PASSED             The Unit test has completed and the test
+                                        case was successful.
+  @retval  UNIT_TEST_ERROR_TEST_FAILED  A test case assertion has failed.
+
+**/
+UNIT_TEST_STATUS
+EFIAPI
+LookupTime (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  VARIABLE_POINTER_TRACK  Track;
+  CHAR16                  Name[TEST_NAME_LENGTH];
+  UINTN                   Index;
+  UINTN                   Round;
+  clock_t                 Start;
+  UINT64                  IndexTime;
+  UINT64                  WalkTime;
+
+  IndexTime = 0;
+  WalkTime  = 0;
+  for (Round = 0; Round < 2; Round++) {
+    mVariableStoreIndex[VariableStoreTypeVolatile].Enabled = (BOOLEAN)(Round == 0);
+
+    Start = clock ();
+    for (Index = 0; Index < TEST_LOOKUP_COUNT; Index++) {
+      TestVariableName ((Index * 7919) % (TEST_VARIABLE_COUNT / 2), Name);
+      Track.StartPtr = GetStartPointer (mTestStore);
+      Track.EndPtr   = GetEndPointer (mTestStore);
+      FindVariableEx (Name, TestVariableGuid (Index), FALSE, &Track, FALSE);
+    }
+
+    if (Round == 0) {
+      IndexTime = ElapsedMicroseconds (Start);
+    } else {
+      WalkTime = ElapsedMicroseconds (Start);
+    }
+  }
+
+  mVariableStoreIndex[VariableStoreTypeVolatile].Enabled = TRUE;
+
+  UT_LOG_INFO (
+    "%d lookups in %d variables: index %ld us, walk %ld us\n",
+    TEST_LOOKUP_COUNT,
+    mVariableStoreIndex[VariableStoreTypeVolatile].Count,
+    IndexTime,
+    WalkTime
+    );
+  UT_ASSERT_TRUE (IndexTime < WalkTime);
+
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  Initialize the unit test framework, suite, and unit tests for the
+  variable store index and run the unit tests.
+
+  @retval  EFI_SUCCESS           All test cases were dispatched.
+  @retval  EFI_OUT_OF_RESOURCES  There are not enough resources available to
+                                 initialize the unit tests.
+**/
+EFI_STATUS
+EFIAPI
+UnitTestingEntry (
+  VOID
+  )
+{
+  EFI_STATUS                  Status;
+  UNIT_TEST_FRAMEWORK_HANDLE  Framework;
+  UNIT_TEST_SUITE_HANDLE      IndexTests;
+
+  Framework = NULL;
+
+  DEBUG ((DEBUG_INFO, "%a v%a\n", UNIT_TEST_APP_NAME, UNIT_TEST_APP_VERSION));
+
+  mTestStore = AllocatePool (TEST_STORE_SIZE);
+  if (mTestStore == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  SetMem (mTestStore, TEST_STORE_SIZE, 0xff);
+  ZeroMem (mTestStore, sizeof (VARIABLE_STORE_HEADER));
+  CopyGuid (&mTestStore->Signature, &gEfiVariableGuid);
+  mTestStore->Size   = TEST_STORE_SIZE;
+  mTestStore->Format = VARIABLE_STORE_FORMATTED;
+  mTestStore->State  = VARIABLE_STORE_HEALTHY;
+  mTestStoreEnd      = GetStartPointer (mTestStore);
+
+  //
+  // Start setting up the test framework for running the tests.
+  //
+  Status = InitUnitTestFramework (&Framework, UNIT_TEST_APP_NAME, gEfiCallerBaseName, UNIT_TEST_APP_VERSION);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "Failed in InitUnitTestFramework. Status = %r\n", Status));
+    goto EXIT;
+  }
+
+  Status = CreateUnitTestSuite (&IndexTests, Framework, "Variable Store Index Tests", "Variable.Index", NULL, NULL);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "Failed in CreateUnitTestSuite for Variable Store Index Tests\n"));
+    Status = EFI_OUT_OF_RESOURCES;
+    goto EXIT;
+  }
+
+  //
+  // The test cases share the variable store and must run in this order.
+  //
+  // --------------Suite--------Description----------------------------------Name--------Function-----------Pre---Post---Context-----------
+  //
+  AddTestCase (IndexTests, "Lookup through the index matches the walk", "Lookup", LookupMatchesWalk, NULL, NULL, NULL);
+  AddTestCase (IndexTests, "Index follows updates and reclaim", "Update", UpdateAndReclaim, NULL, NULL, NULL);
+  AddTestCase (IndexTests, "Runtime filter and fallback", "Runtime", RuntimeFallback, NULL, NULL, NULL);
+  AddTestCase (IndexTests, "Lookup time in thousands of variables", "Time", LookupTime, NULL, NULL, NULL);
+
+  //
+  // Execute the tests.
+  //
+  Status = RunAllTestSuites (Framework);
+
+EXIT:
+  if (Framework) {
+    FreeUnitTestFramework (Framework);
+  }
+
+  FreePool (mTestStore);
+  return Status;
+}
+
+///
+/// Avoid ECC error for function name that starts with lower case letter
+///
+#define VariableIndexUnitTestMain  main
+
+/**
+  Standard POSIX C entry point for host based unit test execution.
+
+  @param[in] Argc  Number of arguments
+  @param[in] Argv  Array of pointers to arguments
+
+  @retval 0      Success
+  @retval other  Error
+**/
+INT32
+VariableIndexUnitTestMain (
+  IN INT32  Argc,
+  IN CHAR8  *Argv[]
+  )
+{
+  UnitTestingEntry ();
+  return 0;
+}
@@ -28,6 +28,7 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #include "Variable.h"
 #include "VariableNonVolatile.h"
 #include "VariableParsing.h"
+#include "VariableIndex.h"
 #include "VariableRuntimeCache.h"
 
 VARIABLE_MODULE_GLOBAL  *mVariableModuleGlobal;
@@ -545,7 +546,9 @@ Reclaim (
   VARIABLE_HEADER        *UpdatingVariable;
   VARIABLE_HEADER        *UpdatingInDeletedTransition;
   BOOLEAN                AuthFormat;
+  UINT64                 StartTick;
 
+  StartTick                   = VariableLatencyStart ();
   AuthFormat                  = mVariableModuleGlobal->VariableGlobal.AuthFormat;
   UpdatingVariable            = NULL;
   UpdatingInDeletedTransition = NULL;
@@ -792,6 +795,11 @@ Reclaim (
   }
 
 Done:
+  //
+  // Variables have moved, the index of the store is rebuilt on the next lookup.
+  //
+  VariableIndexInvalidate (IsVolatile ? VariableStoreHeader : mNvVariableCache);
+
   DoneStatus = EFI_SUCCESS;
   if (IsVolatile || mVariableModuleGlobal->VariableGlobal.EmuNvMode) {
     DoneStatus = SynchronizeRuntimeVariableCache (
@@ -812,6 +820,14 @@ Done:
                    VariableStoreHeader->Size
                    );
     ASSERT_EFI_ERROR (DoneStatus);
+
+    //
+    // The store was rebuilt from scratch, any incremental reclaim in progress is void.
+    //
+    mVariableModuleGlobal->IncrementalReclaim.Active                 = FALSE;
+    mVariableModuleGlobal->IncrementalReclaim.Erasing                = FALSE;
+    mVariableModuleGlobal->IncrementalReclaim.LastOffsetAtCompletion = *LastVariableOffset;
+    VariableLatencyRecord (&mVariableModuleGlobal->Latency.Reclaim, StartTick);
   }
 
   if (!EFI_ERROR (Status) && EFI_ERROR (DoneStatus)) {
@@ -1656,6 +1672,22 @@ AutoUpdateLangVariable (
   }
 }
 
+/**
+  Advance the variable store generation, and publish it to the buffer
+  registered for the batched variable enumeration, if any.
+
+**/
+VOID
+AdvanceVariableGeneration (
+  VOID
+  )
+{
+  mVariableModuleGlobal->Generation++;
+  if (mVariableModuleGlobal->GenerationBuffer != NULL) {
+    *(mVariableModuleGlobal->GenerationBuffer) = mVariableModuleGlobal->Generation;
+  }
+}
+
 /**
   Update the variable region with Variable information. If EFI_VARIABLE_AUTHENTICATED_WRITE_ACCESS is set,
   index of associated public key is needed.
@@ -1758,6 +1790,7 @@ UpdateVariable (
         //
         UpdateVariableInfo (VariableName, VendorGuid, FALSE, FALSE, FALSE, TRUE, FALSE, &gVariableInfo);
         FlushHobVariableToFlash (VariableName, VendorGuid);
+        AdvanceVariableGeneration ();
         return EFI_SUCCESS;
       }
     }
@@ -2349,6 +2382,11 @@ UpdateVariable (
   }
 
 Done:
+  //
+  // Also on failure, as a failed update may still have changed the store.
+  //
+  AdvanceVariableGeneration ();
+
   if (!EFI_ERROR (Status)) {
     if (((Variable->CurrPtr != NULL) && !Variable->Volatile) || ((Attributes & EFI_VARIABLE_NON_VOLATILE) != 0)) {
       VolatileCacheInstance = &(mVariableModuleGlobal->VariableGlobal.VariableRuntimeCacheContext.VariableRuntimeNvCache);
@@ -2386,6 +2424,7 @@ Done:
                                     data, this value contains the required size.
   @param Data                       The buffer to return the contents of the variable. May be NULL
                                     with a zero DataSize in order to determine the size buffer needed.
+  @param RecordRead                 TRUE to count a successful read in the variable statistics.
 
   @retval EFI_SUCCESS               The function completed successfully.
   @retval EFI_NOT_FOUND             The variable was not found.
@@ -2403,13 +2442,13 @@ Done:
 
 **/
 EFI_STATUS
-EFIAPI
-VariableServiceGetVariable (
+VariableServiceGetVariableInternal (
   IN      CHAR16    *VariableName,
   IN      EFI_GUID  *VendorGuid,
   OUT     UINT32    *Attributes OPTIONAL,
   IN OUT  UINTN     *DataSize,
-  OUT     VOID      *Data OPTIONAL
+  OUT     VOID      *Data OPTIONAL,
+  IN      BOOLEAN   RecordRead
   )
 {
   EFI_STATUS              Status;
@@ -2446,7 +2485,9 @@ VariableServiceGetVariable (
     CopyMem (Data, GetVariableDataPtr (Variable.CurrPtr, mVariableModuleGlobal->VariableGlobal.AuthFormat), VarDataSize);
 
     *DataSize = VarDataSize;
-    UpdateVariableInfo (VariableName, VendorGuid, Variable.Volatile, TRUE, FALSE, FALSE, FALSE, &gVariableInfo);
+    if (RecordRead) {
+      UpdateVariableInfo (VariableName, VendorGuid, Variable.Volatile, TRUE, FALSE, FALSE, FALSE, &gVariableInfo);
+    }
 
     Status = EFI_SUCCESS;
     goto Done;
@@ -2467,6 +2508,50 @@ Done:
   return Status;
 }
 
+/**
+
+  This code finds variable in storage blocks (Volatile or Non-Volatile).
+
+  Caution: This function may receive untrusted input.
+  This function may be invoked in SMM mode, and datasize is external input.
+  This function will do basic validation, before parse the data.
+
+  @param VariableName               Name of Variable to be found.
+  @param VendorGuid                 Variable vendor GUID.
+  @param Attributes                 Attribute value of the variable found.
+  @param DataSize                   Size of Data found. If size is less than the
+                                    data, this value contains the required size.
+  @param Data                       The buffer to return the contents of the variable. May be NULL
+                                    with a zero DataSize in order to determine the size buffer needed.
+
+  @retval EFI_SUCCESS               The function completed successfully.
+  @retval EFI_NOT_FOUND             The variable was not found.
+  @retval EFI_BUFFER_TOO_SMALL      The DataSize is too small for the result.
+  @retval EFI_INVALID_PARAMETER     VariableName is NULL.
+  @retval EFI_INVALID_PARAMETER     VendorGuid is NULL.
+  @retval EFI_INVALID_PARAMETER     DataSize is NULL.
+  @retval EFI_INVALID_PARAMETER     The DataSize is not too small and Data is NULL.
+  @retval EFI_DEVICE_ERROR          The variable could not be retrieved due to a hardware error.
+  @retval EFI_SECURITY_VIOLATION    The variable could not be retrieved due to an authentication failure.
+  @retval EFI_UNSUPPORTED           After ExitBootServices() has been called, this return code may be returned
+                                    if no variable storage is supported. The platform should describe this
+                                    runtime service as unsupported at runtime via an EFI_RT_PROPERTIES_TABLE
+                                    configuration table.
+
+**/
+EFI_STATUS
+EFIAPI
+VariableServiceGetVariable (
+  IN      CHAR16    *VariableName,
+  IN      EFI_GUID  *VendorGuid,
+  OUT     UINT32    *Attributes OPTIONAL,
+  IN OUT  UINTN     *DataSize,
+  OUT     VOID      *Data OPTIONAL
+  )
+{
+  return VariableServiceGetVariableInternal (VariableName, VendorGuid, Attributes, DataSize, Data, TRUE);
+}
+
 /**
 
   This code Finds the Next available variable.
@@ -2623,6 +2708,7 @@ VariableServiceSetVariable (
   EFI_PHYSICAL_ADDRESS    Point;
   UINTN                   PayloadSize;
   BOOLEAN                 AuthFormat;
+  UINT64                  StartTick;
 
   AuthFormat = mVariableModuleGlobal->VariableGlobal.AuthFormat;
 
@@ -2841,6 +2927,7 @@ VariableServiceSetVariable (
   }
 
   AcquireLockOnlyAtBootTime (&mVariableModuleGlobal->VariableGlobal.VariableServicesLock);
+  StartTick = VariableLatencyStart ();
 
   //
   // Consider reentrant in MCA/INIT/NMI. It needs be reupdated.
@@ -2900,7 +2987,20 @@ VariableServiceSetVariable (
     Status = UpdateVariable (VariableName, VendorGuid, Data, DataSize, Attributes, 0, 0, &Variable, NULL);
   }
 
+  if (!EFI_ERROR (Status) &&
+      (mVariableModuleGlobal->VariableGlobal.ReentrantState == 1) &&
+      (((Attributes & EFI_VARIABLE_NON_VOLATILE) != 0) || ((Variable.CurrPtr != NULL) && !Variable.Volatile)))
+  {
+    //
+    // Spread the garbage collection of the non-volatile store over the
+    // SetVariable () calls that updated it instead of reclaiming it all at
+    // once when full. Failed and volatile updates do not pay for a step.
+    //
+    IncrementalReclaimStep ();
+  }
+
 Done:
+  VariableLatencyRecord (&mVariableModuleGlobal->Latency.SetVariable, StartTick);
   InterlockedDecrement (&mVariableModuleGlobal->VariableGlobal.ReentrantState);
   ReleaseLockOnlyAtBootTime (&mVariableModuleGlobal->VariableGlobal.VariableServicesLock);
 
@@ -3305,6 +3405,7 @@ FlushHobVariableToFlash (
     // Set HobVariableBase to 0, it can avoid SetVariable to call back.
     //
     mVariableModuleGlobal->VariableGlobal.HobVariableBase = 0;
+    VariableIndexRegisterStore (VariableStoreTypeHob, NULL, AuthFormat);
     for ( Variable = GetStartPointer (VariableStoreHeader)
           ; IsValidVariableHeader (Variable, GetEndPointer (VariableStoreHeader))
           ; Variable = GetNextVariablePtr (Variable, AuthFormat)
@@ -3451,6 +3552,22 @@ VariableWriteServiceInitialize (
 
   FlushHobVariableToFlash (NULL, NULL);
 
+  if ((PcdGet32 (PcdVariableReclaimStepSize) != 0) && !mVariableModuleGlobal->VariableGlobal.EmuNvMode) {
+    //
+    // The buffer holds the variables moved by one incremental reclaim step:
+    // up to a step worth of variables, the largest variable and the padding
+    // variable behind them.
+    //
+    mVariableModuleGlobal->IncrementalReclaim.BufferSize = PcdGet32 (PcdVariableReclaimStepSize) +
+                                                           GetNonVolatileMaxVariableSize () +
+                                                           GetVariableHeaderSize (mVariableModuleGlobal->VariableGlobal.AuthFormat) +
+                                                           sizeof (CHAR16);
+    mVariableModuleGlobal->IncrementalReclaim.Buffer     = AllocateRuntimePool (mVariableModuleGlobal->IncrementalReclaim.BufferSize);
+    if (mVariableModuleGlobal->IncrementalReclaim.Buffer == NULL) {
+      DEBUG ((DEBUG_WARN, "Variable: no buffer for incremental reclaim, only full reclaim is used\n"));
+    }
+  }
+
   Status = EFI_SUCCESS;
   ZeroMem (&mAuthContextOut, sizeof (mAuthContextOut));
   if (mVariableModuleGlobal->VariableGlobal.AuthFormat) {
@@ -3796,6 +3913,18 @@ VariableCommonInitialize (
   VolatileVariableStore->Reserved  = 0;
   VolatileVariableStore->Reserved1 = 0;
 
+  //
+  // Build the (name, GUID) index of each variable store. Lookups in a store
+  // without an index walk the store, so a failure here is not fatal.
+  //
+  VariableIndexRegisterStore (VariableStoreTypeVolatile, VolatileVariableStore, mVariableModuleGlobal->VariableGlobal.AuthFormat);
+  VariableIndexRegisterStore (VariableStoreTypeNv, mNvVariableCache, mVariableModuleGlobal->VariableGlobal.AuthFormat);
+  VariableIndexRegisterStore (
+    VariableStoreTypeHob,
+    (VARIABLE_STORE_HEADER *)(UINTN)mVariableModuleGlobal->VariableGlobal.HobVariableBase,
+    mVariableModuleGlobal->VariableGlobal.AuthFormat
+    );
+
   return EFI_SUCCESS;
 }
 
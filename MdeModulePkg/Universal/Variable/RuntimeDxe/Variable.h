@@ -33,12 +33,14 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #include <Library/VarCheckLib.h>
 #include <Library/VariableFlashInfoLib.h>
 #include <Library/SafeIntLib.h>
+#include <Library/TimerLib.h>
 #include <Guid/GlobalVariable.h>
 #include <Guid/EventGroup.h>
 #include <Guid/VariableFormat.h>
 #include <Guid/SystemNvDataGuid.h>
 #include <Guid/FaultTolerantWrite.h>
 #include <Guid/VarErrorFlag.h>
+#include <Guid/VariableLatencyStatistics.h>
 
 #include "PrivilegePolymorphic.h"
 
@@ -71,6 +73,7 @@ typedef struct {
   BOOLEAN                   *ReadLock;
   BOOLEAN                   *PendingUpdate;
   BOOLEAN                   *HobFlushComplete;
+  UINT32                    *FlushCount;
   VARIABLE_RUNTIME_CACHE    VariableRuntimeHobCache;
   VARIABLE_RUNTIME_CACHE    VariableRuntimeNvCache;
   VARIABLE_RUNTIME_CACHE    VariableRuntimeVolatileCache;
@@ -102,6 +105,30 @@ typedef struct {
   BOOLEAN                           EmuNvMode;
 } VARIABLE_GLOBAL;
 
+///
+/// Progress of the incremental reclaim of the non-volatile variable store.
+///
+/// While Active, the store is laid out as the compacted variables up to
+/// CompactedOffset, one deleted padding variable up to ScanOffset, and the
+/// variables not moved yet up to NonVolatileLastVariableOffset, so it is a
+/// valid variable store between any two steps. Once Scanned, the body of the
+/// padding variable is erased, [EraseFloor, EraseEnd) being what is left to
+/// erase while Erasing.
+///
+typedef struct {
+  BOOLEAN    Active;
+  BOOLEAN    Scanned;
+  BOOLEAN    Erasing;
+  BOOLEAN    AllowedAtRuntime;
+  UINTN      CompactedOffset;
+  UINTN      ScanOffset;
+  UINTN      EraseFloor;
+  UINTN      EraseEnd;
+  UINTN      LastOffsetAtCompletion;
+  UINTN      BufferSize;
+  UINT8      *Buffer;
+} VARIABLE_INCREMENTAL_RECLAIM;
+
 typedef struct {
   VARIABLE_GLOBAL                       VariableGlobal;
   UINTN                                 VolatileLastVariableOffset;
@@ -121,6 +148,10 @@ typedef struct {
   CHAR8                                 *PlatformLang;
   CHAR8                                 Lang[ISO_639_2_ENTRY_SIZE + 1];
   EFI_FIRMWARE_VOLUME_BLOCK_PROTOCOL    *FvbInstance;
+  VARIABLE_INCREMENTAL_RECLAIM          IncrementalReclaim;
+  VARIABLE_LATENCY_STATISTICS           Latency;
+  UINT64                                Generation;
+  UINT64                                *GenerationBuffer;
 } VARIABLE_MODULE_GLOBAL;
 
 /**
@@ -157,6 +188,63 @@ FtwVariableSpace (
   IN VARIABLE_STORE_HEADER  *VariableBuffer
   );
 
+/**
+  Writes a buffer to a range of the variable storage space, in the working
+  block, using the Fault Tolerant Write protocol.
+
+  @param  VariableBase   Base address of the variable store.
+  @param  Offset         Offset of the range in the variable store.
+  @param  Length         Length of the range in bytes.
+  @param  Buffer         Point to the data to write.
+
+  @retval EFI_SUCCESS    The function completed successfully.
+  @retval EFI_NOT_FOUND  Fail to locate Fault Tolerant Write protocol.
+  @retval EFI_ABORTED    The function could not complete successfully.
+
+**/
+EFI_STATUS
+FtwVariableRange (
+  IN EFI_PHYSICAL_ADDRESS  VariableBase,
+  IN UINTN                 Offset,
+  IN UINTN                 Length,
+  IN VOID                  *Buffer
+  );
+
+/**
+  Starts timing an operation for a latency histogram.
+
+  @return The current performance counter value, or 0 if variable statistics
+          are not collected.
+
+**/
+UINT64
+VariableLatencyStart (
+  VOID
+  );
+
+/**
+  Records the latency of an operation in a latency histogram.
+
+  @param[in, out] Histogram     The latency histogram.
+  @param[in]      StartTick     The value VariableLatencyStart () returned when
+                                the operation started.
+
+**/
+VOID
+VariableLatencyRecord (
+  IN OUT VARIABLE_LATENCY_HISTOGRAM  *Histogram,
+  IN     UINT64                      StartTick
+  );
+
+/**
+  Reports the SetVariable () and reclaim latency histograms to the debug log.
+
+**/
+VOID
+VariableDumpLatencyStatistics (
+  VOID
+  );
+
 /**
   Finds variable in storage blocks of volatile and non-volatile storage areas.
 
@@ -368,6 +456,30 @@ VariableCommonInitialize (
   VOID
   );
 
+/**
+  Is user variable?
+
+  @param[in] Variable   Pointer to variable header.
+
+  @retval TRUE          User variable.
+  @retval FALSE         System variable.
+
+**/
+BOOLEAN
+IsUserVariable (
+  IN VARIABLE_HEADER  *Variable
+  );
+
+/**
+  Performs one bounded step of the incremental reclaim of the non-volatile
+  variable store, if PcdVariableReclaimStepSize enables it.
+
+**/
+VOID
+IncrementalReclaimStep (
+  VOID
+  );
+
 /**
   This function reclaims variable storage if free size is below the threshold.
 
@@ -471,6 +583,48 @@ VariableServiceGetVariable (
   OUT     VOID      *Data OPTIONAL
   );
 
+/**
+
+  This code finds variable in storage blocks (Volatile or Non-Volatile).
+
+  Caution: This function may receive untrusted input.
+  This function may be invoked in SMM mode, and datasize and data are external input.
+  This function will do basic validation, before parse the data.
+
+  @param VariableName               Name of Variable to be found.
+  @param VendorGuid                 Variable vendor GUID.
+  @param Attributes                 Attribute value of the variable found.
+  @param DataSize                   Size of Data found. If size is less than the
+                                    data, this value contains the required size.
+  @param Data                       The buffer to return the contents of the variable. May be NULL
+                                    with a zero DataSize in order to determine the size buffer needed.
+  @param RecordRead                 TRUE to count a successful read in the variable statistics.
+
+  @retval EFI_SUCCESS            The function completed successfully.
+  @retval EFI_NOT_FOUND          The variable was not found.
+  @retval EFI_BUFFER_TOO_SMALL   The DataSize is too small for the result.
+  @retval EFI_INVALID_PARAMETER  VariableName is NULL.
+  @retval EFI_INVALID_PARAMETER  VendorGuid is NULL.
+  @retval EFI_INVALID_PARAMETER  DataSize is NULL.
+  @retval EFI_INVALID_PARAMETER  The DataSize is not too small and Data is NULL.
+  @retval EFI_DEVICE_ERROR       The variable could not be retrieved due to a hardware error.
+  @retval EFI_SECURITY_VIOLATION The variable could not be retrieved due to an authentication failure.
+  @retval EFI_UNSUPPORTED        After ExitBootServices() has been called, this return code may be returned
+                                 if no variable storage is supported. The platform should describe this
+                                 runtime service as unsupported at runtime via an EFI_RT_PROPERTIES_TABLE
+                                 configuration table.
+
+**/
+EFI_STATUS
+VariableServiceGetVariableInternal (
+  IN      CHAR16    *VariableName,
+  IN      EFI_GUID  *VendorGuid,
+  OUT     UINT32    *Attributes OPTIONAL,
+  IN OUT  UINTN     *DataSize,
+  OUT     VOID      *Data OPTIONAL,
+  IN      BOOLEAN   RecordRead
+  );
+
 /**
 
   This code Finds the Next available variable.
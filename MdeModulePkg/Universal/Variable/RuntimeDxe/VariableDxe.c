@@ -11,6 +11,7 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 **/
 
 #include "Variable.h"
+#include "VariableIndex.h"
 
 #include <Protocol/VariablePolicy.h>
 #include <Library/VariablePolicyLib.h>
@@ -268,6 +269,12 @@ VariableClassAddressChangeEvent (
   EfiConvertPointer (0x0, (VOID **)&mNvVariableCache);
   EfiConvertPointer (0x0, (VOID **)&mNvFvHeaderCache);
 
+  for (Index = 0; Index < VariableStoreTypeMax; Index++) {
+    EfiConvertPointer (EFI_OPTIONAL_PTR, (VOID **)&mVariableStoreIndex[Index].Store);
+    EfiConvertPointer (EFI_OPTIONAL_PTR, (VOID **)&mVariableStoreIndex[Index].Buckets);
+    EfiConvertPointer (EFI_OPTIONAL_PTR, (VOID **)&mVariableStoreIndex[Index].Entries);
+  }
+
   if (mAuthContextOut.AddressPointer != NULL) {
     for (Index = 0; Index < mAuthContextOut.AddressPointerCount; Index++) {
       EfiConvertPointer (0x0, (VOID **)mAuthContextOut.AddressPointer[Index]);
@@ -318,12 +325,15 @@ OnReadyToBoot (
   }
 
   ReclaimForOS ();
+  VariableDumpLatencyStatistics ();
   if (FeaturePcdGet (PcdVariableCollectStatistics)) {
     if (mVariableModuleGlobal->VariableGlobal.AuthFormat) {
       gBS->InstallConfigurationTable (&gEfiAuthenticatedVariableGuid, gVariableInfo);
     } else {
       gBS->InstallConfigurationTable (&gEfiVariableGuid, gVariableInfo);
     }
+
+    gBS->InstallConfigurationTable (&gEdkiiVariableLatencyStatisticsGuid, &mVariableModuleGlobal->Latency);
   }
 
   gBS->CloseEvent (Event);
@@ -0,0 +1,399 @@
+/** @file
+  In-memory (name, GUID) hash index over a variable store.
+
+  Each registered store owns a chained hash table of variable header offsets.
+  Every valid header is indexed whatever its state, because a header written
+  with VAR_HEADER_VALID_ONLY becomes VAR_ADDED later without moving; the state
+  is checked at lookup time exactly as the linear walk in FindVariableEx ()
+  does. Headers appended after the last lookup are indexed on the next one.
+  The index memory is only allocated or grown before ExitBootServices; if a
+  store outgrows its index at runtime, lookups in that store fall back to
+  walking it.
+
+Copyright (c) 2026, Intel Corporation. All rights reserved.<BR>
+SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include "VariableIndex.h"
+
+VARIABLE_STORE_INDEX  mVariableStoreIndex[VariableStoreTypeMax];
+
+/**
+  Computes the FNV-1a hash of a variable name and vendor GUID.
+
+  @param[in] Name           Pointer to the variable name.
+  @param[in] NameSize       Size of the variable name in bytes.
+  @param[in] Guid           Pointer to the vendor GUID.
+
+  @return The 32-bit hash value.
+
+**/
+STATIC
+UINT32
+VariableIndexHash (
+  IN CONST VOID      *Name,
+  IN UINTN           NameSize,
+  IN CONST EFI_GUID  *Guid
+  )
+{
+  CONST UINT8  *Byte;
+  UINT32       Hash;
+  UINTN        Index;
+
+  Hash = 0x811C9DC5;
+  Byte = (CONST UINT8 *)Name;
+  for (Index = 0; Index < NameSize; Index++) {
+    Hash = (Hash ^ Byte[Index]) * 0x01000193;
+  }
+
+  Byte = (CONST UINT8 *)Guid;
+  for (Index = 0; Index < sizeof (EFI_GUID); Index++) {
+    Hash = (Hash ^ Byte[Index]) * 0x01000193;
+  }
+
+  return Hash;
+}
+
+/**
+  Doubles the capacity of an index and rehashes its entries.
+
+  @param[in, out] Index     The index to grow.
+
+  @retval EFI_SUCCESS           The index was grown.
+  @retval EFI_OUT_OF_RESOURCES  Memory could not be allocated, or the system is
+                                at runtime.
+
+**/
+STATIC
+EFI_STATUS
+VariableIndexGrow (
+  IN OUT VARIABLE_STORE_INDEX  *Index
+  )
+{
+  UINT32                Capacity;
+  UINT32                Slot;
+  UINT32                Bucket;
+  UINT32                *Buckets;
+  VARIABLE_INDEX_ENTRY  *Entries;
+
+  if (AtRuntime ()) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  Capacity = (Index->Capacity == 0) ? VARIABLE_INDEX_MIN_CAPACITY : Index->Capacity * 2;
+  Buckets  = AllocateRuntimePool (Capacity * sizeof (UINT32));
+  Entries  = AllocateRuntimePool (Capacity * sizeof (VARIABLE_INDEX_ENTRY));
+  if ((Buckets == NULL) || (Entries == NULL)) {
+    if (Buckets != NULL) {
+      FreePool (Buckets);
+    }
+
+    if (Entries != NULL) {
+      FreePool (Entries);
+    }
+
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  //
+  // The capacity is a power of two, so one bucket per entry keeps the chains short.
+  //
+  SetMem (Buckets, Capacity * sizeof (UINT32), 0xff);
+  for (Slot = 0; Slot < Index->Count; Slot++) {
+    Bucket               = Index->Entries[Slot].Hash & (Capacity - 1);
+    Entries[Slot].Hash   = Index->Entries[Slot].Hash;
+    Entries[Slot].Offset = Index->Entries[Slot].Offset;
+    Entries[Slot].Next   = Buckets[Bucket];
+    Buckets[Bucket]      = Slot;
+  }
+
+  if (Index->Buckets != NULL) {
+    FreePool (Index->Buckets);
+    FreePool (Index->Entries);
+  }
+
+  Index->Buckets    = Buckets;
+  Index->Entries    = Entries;
+  Index->Capacity   = Capacity;
+  Index->BucketMask = Capacity - 1;
+  return EFI_SUCCESS;
+}
+
+/**
+  Brings an index up to date with its store.
+
+  Rebuilds the index if it was invalidated, then indexes the headers appended
+  since the last call.
+
+  @param[in, out] Index     The index to synchronize.
+
+  @retval TRUE              The index covers the whole store.
+  @retval FALSE             The index is disabled.
+
+**/
+STATIC
+BOOLEAN
+VariableIndexSync (
+  IN OUT VARIABLE_STORE_INDEX  *Index
+  )
+{
+  VARIABLE_HEADER  *Variable;
+  VARIABLE_HEADER  *EndPtr;
+  UINT32           Hash;
+  UINT32           Slot;
+
+  if (!Index->Enabled) {
+    return FALSE;
+  }
+
+  if (Index->IndexedEnd == 0) {
+    SetMem (Index->Buckets, Index->Capacity * sizeof (UINT32), 0xff);
+    Index->Count      = 0;
+    Index->IndexedEnd = (UINT32)((UINTN)GetStartPointer (Index->Store) - (UINTN)Index->Store);
+  }
+
+  EndPtr   = GetEndPointer (Index->Store);
+  Variable = (VARIABLE_HEADER *)((UINTN)Index->Store + Index->IndexedEnd);
+  while (IsValidVariableHeader (Variable, EndPtr)) {
+    if ((Index->Count == Index->Capacity) && EFI_ERROR (VariableIndexGrow (Index))) {
+      Index->Enabled = FALSE;
+      return FALSE;
+    }
+
+    Hash = VariableIndexHash (
+             GetVariableNamePtr (Variable, Index->AuthFormat),
+             NameSizeOfVariable (Variable, Index->AuthFormat),
+             GetVendorGuidPtr (Variable, Index->AuthFormat)
+             );
+    Slot                                     = Index->Count++;
+    Index->Entries[Slot].Hash                = Hash;
+    Index->Entries[Slot].Offset              = (UINT32)((UINTN)Variable - (UINTN)Index->Store);
+    Index->Entries[Slot].Next                = Index->Buckets[Hash & Index->BucketMask];
+    Index->Buckets[Hash & Index->BucketMask] = Slot;
+
+    Variable          = GetNextVariablePtr (Variable, Index->AuthFormat);
+    Index->IndexedEnd = (UINT32)((UINTN)Variable - (UINTN)Index->Store);
+  }
+
+  return TRUE;
+}
+
+/**
+  Checks whether an indexed variable header is the one FindVariableEx () would
+  consider for the given name and GUID.
+
+  @param[in] Variable       Pointer to the variable header.
+  @param[in] VariableName   Name of the variable to be found.
+  @param[in] VendorGuid     Vendor GUID to be found.
+  @param[in] IgnoreRtCheck  Ignore EFI_VARIABLE_RUNTIME_ACCESS attribute
+                            check at runtime when searching variable.
+  @param[in] AuthFormat     TRUE indicates authenticated variables are used.
+                            FALSE indicates authenticated variables are not used.
+
+  @retval TRUE              The variable matches.
+  @retval FALSE             The variable does not match.
+
+**/
+STATIC
+BOOLEAN
+VariableIndexMatch (
+  IN VARIABLE_HEADER  *Variable,
+  IN CHAR16           *VariableName,
+  IN EFI_GUID         *VendorGuid,
+  IN BOOLEAN          IgnoreRtCheck,
+  IN BOOLEAN          AuthFormat
+  )
+{
+  if ((Variable->State != VAR_ADDED) && (Variable->State != (VAR_IN_DELETED_TRANSITION & VAR_ADDED))) {
+    return FALSE;
+  }
+
+  if (!IgnoreRtCheck && AtRuntime () && ((Variable->Attributes & EFI_VARIABLE_RUNTIME_ACCESS) == 0)) {
+    return FALSE;
+  }
+
+  if (!CompareGuid (VendorGuid, GetVendorGuidPtr (Variable, AuthFormat))) {
+    return FALSE;
+  }
+
+  return (BOOLEAN)(CompareMem (VariableName, GetVariableNamePtr (Variable, AuthFormat), NameSizeOfVariable (Variable, AuthFormat)) == 0);
+}
+
+/**
+  Attaches an index to a variable store and builds it.
+
+  Passing a NULL Store detaches the index of the given store type. The index
+  buffers are released if that is still possible.
+
+  @param[in] Type           Type of the variable store.
+  @param[in] Store          Pointer to the variable store header, or NULL.
+  @param[in] AuthFormat     TRUE indicates authenticated variables are used.
+                            FALSE indicates authenticated variables are not used.
+
+  @retval EFI_SUCCESS           The index was built or detached.
+  @retval EFI_INVALID_PARAMETER Type is out of range.
+  @retval EFI_OUT_OF_RESOURCES  The index could not be allocated; lookups in
+                                this store will walk the store.
+
+**/
+EFI_STATUS
+VariableIndexRegisterStore (
+  IN VARIABLE_STORE_TYPE    Type,
+  IN VARIABLE_STORE_HEADER  *Store  OPTIONAL,
+  IN BOOLEAN                AuthFormat
+  )
+{
+  VARIABLE_STORE_INDEX  *Index;
+  EFI_STATUS            Status;
+
+  if (Type >= VariableStoreTypeMax) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  Index = &mVariableStoreIndex[Type];
+  if ((Index->Buckets != NULL) && !AtRuntime ()) {
+    FreePool (Index->Buckets);
+    FreePool (Index->Entries);
+  }
+
+  ZeroMem (Index, sizeof (VARIABLE_STORE_INDEX));
+  if (Store == NULL) {
+    return EFI_SUCCESS;
+  }
+
+  Index->Store      = Store;
+  Index->AuthFormat = AuthFormat;
+  Status            = VariableIndexGrow (Index);
+  if (EFI_ERROR (Status)) {
+    Index->Store = NULL;
+    return Status;
+  }
+
+  Index->Enabled = TRUE;
+  VariableIndexSync (Index);
+  return EFI_SUCCESS;
+}
+
+/**
+  Invalidates the index of a variable store after it was rewritten in place.
+
+  The index is rebuilt on the next lookup in that store.
+
+  @param[in] Store          Pointer to the variable store header, or NULL to
+                            invalidate all indexes.
+
+**/
+VOID
+VariableIndexInvalidate (
+  IN VARIABLE_STORE_HEADER  *Store  OPTIONAL
+  )
+{
+  VARIABLE_STORE_TYPE  Type;
+
+  for (Type = (VARIABLE_STORE_TYPE)0; Type < VariableStoreTypeMax; Type++) {
+    if ((mVariableStoreIndex[Type].Store == NULL) ||
+        ((Store != NULL) && (mVariableStoreIndex[Type].Store != Store)))
+    {
+      continue;
+    }
+
+    mVariableStoreIndex[Type].IndexedEnd = 0;
+    mVariableStoreIndex[Type].Enabled    = (BOOLEAN)(mVariableStoreIndex[Type].Buckets != NULL);
+  }
+}
+
+/**
+  Finds a variable through the index of the store PtrTrack describes.
+
+  The result is identical to a FindVariableEx () walk of the same store.
+
+  @param[in]       VariableName        Name of the variable to be found, not empty.
+  @param[in]       VendorGuid          Vendor GUID to be found.
+  @param[in]       IgnoreRtCheck       Ignore EFI_VARIABLE_RUNTIME_ACCESS attribute
+                                       check at runtime when searching variable.
+  @param[in, out]  PtrTrack            Variable Track Pointer structure that contains Variable Information.
+  @param[in]       AuthFormat          TRUE indicates authenticated variables are used.
+                                       FALSE indicates authenticated variables are not used.
+
+  @retval EFI_SUCCESS           Variable found successfully.
+  @retval EFI_NOT_FOUND         Variable not found.
+  @retval EFI_UNSUPPORTED       No usable index covers this store; the caller
+                                must walk the store.
+
+**/
+EFI_STATUS
+VariableIndexFind (
+  IN     CHAR16                  *VariableName,
+  IN     EFI_GUID                *VendorGuid,
+  IN     BOOLEAN                 IgnoreRtCheck,
+  IN OUT VARIABLE_POINTER_TRACK  *PtrTrack,
+  IN     BOOLEAN                 AuthFormat
+  )
+{
+  VARIABLE_STORE_INDEX  *Index;
+  VARIABLE_STORE_TYPE   Type;
+  VARIABLE_HEADER       *Variable;
+  VARIABLE_HEADER       *AddedVariable;
+  VARIABLE_HEADER       *InDeletedVariable;
+  UINT32                Hash;
+  UINT32                Slot;
+
+  Index = NULL;
+  for (Type = (VARIABLE_STORE_TYPE)0; Type < VariableStoreTypeMax; Type++) {
+    if ((mVariableStoreIndex[Type].Store != NULL) &&
+        (mVariableStoreIndex[Type].AuthFormat == AuthFormat) &&
+        (GetStartPointer (mVariableStoreIndex[Type].Store) == PtrTrack->StartPtr) &&
+        (GetEndPointer (mVariableStoreIndex[Type].Store) == PtrTrack->EndPtr))
+    {
+      Index = &mVariableStoreIndex[Type];
+      break;
+    }
+  }
+
+  if ((Index == NULL) || !VariableIndexSync (Index)) {
+    return EFI_UNSUPPORTED;
+  }
+
+  Hash = VariableIndexHash (VariableName, StrSize (VariableName), VendorGuid);
+
+  //
+  // The walk returns the first VAR_ADDED match in store order, together with
+  // the last in-deleted-transition match that precedes it. Without an added
+  // match, the last in-deleted-transition match is returned instead.
+  //
+  AddedVariable = NULL;
+  for (Slot = Index->Buckets[Hash & Index->BucketMask]; Slot != VARIABLE_INDEX_END; Slot = Index->Entries[Slot].Next) {
+    Variable = (VARIABLE_HEADER *)((UINTN)Index->Store + Index->Entries[Slot].Offset);
+    if ((Index->Entries[Slot].Hash == Hash) &&
+        (Variable->State == VAR_ADDED) &&
+        ((AddedVariable == NULL) || (Variable < AddedVariable)) &&
+        VariableIndexMatch (Variable, VariableName, VendorGuid, IgnoreRtCheck, AuthFormat))
+    {
+      AddedVariable = Variable;
+    }
+  }
+
+  InDeletedVariable = NULL;
+  for (Slot = Index->Buckets[Hash & Index->BucketMask]; Slot != VARIABLE_INDEX_END; Slot = Index->Entries[Slot].Next) {
+    Variable = (VARIABLE_HEADER *)((UINTN)Index->Store + Index->Entries[Slot].Offset);
+    if ((Index->Entries[Slot].Hash == Hash) &&
+        (Variable->State == (VAR_IN_DELETED_TRANSITION & VAR_ADDED)) &&
+        ((AddedVariable == NULL) || (Variable < AddedVariable)) &&
+        ((InDeletedVariable == NULL) || (Variable > InDeletedVariable)) &&
+        VariableIndexMatch (Variable, VariableName, VendorGuid, IgnoreRtCheck, AuthFormat))
+    {
+      InDeletedVariable = Variable;
+    }
+  }
+
+  if (AddedVariable != NULL) {
+    PtrTrack->CurrPtr                = AddedVariable;
+    PtrTrack->InDeletedTransitionPtr = InDeletedVariable;
+    return EFI_SUCCESS;
+  }
+
+  PtrTrack->CurrPtr                = InDeletedVariable;
+  PtrTrack->InDeletedTransitionPtr = NULL;
+  return (PtrTrack->CurrPtr == NULL) ? EFI_NOT_FOUND : EFI_SUCCESS;
+}
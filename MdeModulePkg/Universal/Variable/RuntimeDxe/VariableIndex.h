@@ -0,0 +1,118 @@
+/** @file
+  In-memory (name, GUID) hash index over a variable store, shared by the
+  variable driver source files.
+
+  The index records the offset of every variable header in a registered store,
+  so a lookup only has to compare the variables whose hash matches instead of
+  walking the whole store. Headers appended to the store are picked up lazily
+  on the next lookup; any operation that rewrites the store in place (reclaim,
+  runtime cache synchronization) must invalidate the index.
+
+Copyright (c) 2026, Intel Corporation. All rights reserved.<BR>
+SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#ifndef _VARIABLE_INDEX_H_
+#define _VARIABLE_INDEX_H_
+
+#include "VariableParsing.h"
+
+#define VARIABLE_INDEX_END           MAX_UINT32
+#define VARIABLE_INDEX_MIN_CAPACITY  64
+
+typedef struct {
+  UINT32    Hash;
+  UINT32    Offset;
+  UINT32    Next;
+} VARIABLE_INDEX_ENTRY;
+
+typedef struct {
+  VARIABLE_STORE_HEADER    *Store;
+  BOOLEAN                  AuthFormat;
+  //
+  // FALSE when the store outgrew the index at runtime; lookups walk the store
+  // until the next invalidation rebuilds the index.
+  //
+  BOOLEAN                  Enabled;
+  //
+  // Offset of the first variable header not yet in the index, 0 if the index
+  // must be rebuilt from the start of the store.
+  //
+  UINT32                   IndexedEnd;
+  UINT32                   Count;
+  UINT32                   Capacity;
+  UINT32                   BucketMask;
+  UINT32                   *Buckets;
+  VARIABLE_INDEX_ENTRY     *Entries;
+} VARIABLE_STORE_INDEX;
+
+extern VARIABLE_STORE_INDEX  mVariableStoreIndex[VariableStoreTypeMax];
+
+/**
+  Attaches an index to a variable store and builds it.
+
+  Passing a NULL Store detaches the index of the given store type. The index
+  buffers are released if that is still possible.
+
+  @param[in] Type           Type of the variable store.
+  @param[in] Store          Pointer to the variable store header, or NULL.
+  @param[in] AuthFormat     TRUE indicates authenticated variables are used.
+                            FALSE indicates authenticated variables are not used.
+
+  @retval EFI_SUCCESS           The index was built or detached.
+  @retval EFI_INVALID_PARAMETER Type is out of range.
+  @retval EFI_OUT_OF_RESOURCES  The index could not be allocated; lookups in
+                                this store will walk the store.
+
+**/
+EFI_STATUS
+VariableIndexRegisterStore (
+  IN VARIABLE_STORE_TYPE    Type,
+  IN VARIABLE_STORE_HEADER  *Store  OPTIONAL,
+  IN BOOLEAN                AuthFormat
+  );
+
+/**
+  Invalidates the index of a variable store after it was rewritten in place.
+
+  The index is rebuilt on the next lookup in that store.
+
+  @param[in] Store          Pointer to the variable store header, or NULL to
+                            invalidate all indexes.
+
+**/
+VOID
+VariableIndexInvalidate (
+  IN VARIABLE_STORE_HEADER  *Store  OPTIONAL
+  );
+
+/**
+  Finds a variable through the index of the store PtrTrack describes.
+
+  The result is identical to a FindVariableEx () walk of the same store.
+
+  @param[in]       VariableName        Name of the variable to be found, not empty.
+  @param[in]       VendorGuid          Vendor GUID to be found.
+  @param[in]       IgnoreRtCheck       Ignore EFI_VARIABLE_RUNTIME_ACCESS attribute
+                                       check at runtime when searching variable.
+  @param[in, out]  PtrTrack            Variable Track Pointer structure that contains Variable Information.
+  @param[in]       AuthFormat          TRUE indicates authenticated variables are used.
+                                       FALSE indicates authenticated variables are not used.
+
+  @retval EFI_SUCCESS           Variable found successfully.
+  @retval EFI_NOT_FOUND         Variable not found.
+  @retval EFI_UNSUPPORTED       No usable index covers this store; the caller
+                                must walk the store.
+
+**/
+EFI_STATUS
+VariableIndexFind (
+  IN     CHAR16                  *VariableName,
+  IN     EFI_GUID                *VendorGuid,
+  IN     BOOLEAN                 IgnoreRtCheck,
+  IN OUT VARIABLE_POINTER_TRACK  *PtrTrack,
+  IN     BOOLEAN                 AuthFormat
+  );
+
+#endif
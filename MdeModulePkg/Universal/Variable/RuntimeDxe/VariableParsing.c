@@ -8,6 +8,7 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 **/
 
 #include "VariableParsing.h"
+#include "VariableIndex.h"
 
 /**
 
@@ -468,11 +469,22 @@ FindVariableEx (
   IN     BOOLEAN                 AuthFormat
   )
 {
+  EFI_STATUS       Status;
   VARIABLE_HEADER  *InDeletedVariable;
   VOID             *Point;
 
   PtrTrack->InDeletedTransitionPtr = NULL;
 
+  //
+  // Use the (name, GUID) index of the store when there is one.
+  //
+  if (VariableName[0] != 0) {
+    Status = VariableIndexFind (VariableName, VendorGuid, IgnoreRtCheck, PtrTrack, AuthFormat);
+    if (Status != EFI_UNSUPPORTED) {
+      return Status;
+    }
+  }
+
   //
   // Find the variable by walk through HOB, volatile and non-volatile variable store.
   //
@@ -88,6 +88,13 @@ FlushPendingRuntimeVariableCacheUpdates (
     VariableRuntimeCacheContext->VariableRuntimeVolatileCache.PendingUpdateLength = 0;
     VariableRuntimeCacheContext->VariableRuntimeVolatileCache.PendingUpdateOffset = 0;
     *(VariableRuntimeCacheContext->PendingUpdate)                                 = FALSE;
+
+    //
+    // Variables may have moved, tell the runtime side to rebuild its variable index.
+    //
+    if (VariableRuntimeCacheContext->FlushCount != NULL) {
+      (*(VariableRuntimeCacheContext->FlushCount))++;
+    }
   }
 
   return EFI_SUCCESS;
@@ -12,7 +12,8 @@
 
   Each sub function VariableServiceGetVariable(), VariableServiceGetNextVariableName(),
   VariableServiceSetVariable(), VariableServiceQueryVariableInfo(), ReclaimForOS(),
-  SmmVariableGetStatistics() should also do validation based on its own knowledge.
+  SmmVariableGetStatistics(), SmmVariableGetVariableBatch() should also do validation
+  based on its own knowledge.
 
 Copyright (c) 2010 - 2024, Intel Corporation. All rights reserved.<BR>
 Copyright (c) 2018, Linaro, Ltd. All rights reserved.<BR>
@@ -424,6 +425,113 @@ SmmVariableGetStatistics (
   return EFI_SUCCESS;
 }
 
+/**
+  Fills a batch with the variables that follow a given variable.
+
+  Each entry is produced by VariableServiceGetNextVariableName () and
+  VariableServiceGetVariableInternal (), so a batch returns the same variables,
+  in the same order and with the same runtime access checks, as the equivalent
+  sequence of single GetNextVariableName () and GetVariable () requests. The
+  reads are not counted in the variable statistics, as the caller may never
+  consume the data, and Generation tells the caller which state of the
+  variable store the entries reflect.
+
+  @param[in, out]  Batch        The batch request. On input, Guid and Name are the variable
+                                to continue after. On output, the batch entries.
+  @param[in]       BatchSize    The size of the batch request buffer.
+
+  @retval EFI_SUCCESS           At least one entry is returned, or EndOfVariables is set.
+  @retval EFI_BUFFER_TOO_SMALL  The buffer is too small to hold the next variable name.
+  @retval Others                The error VariableServiceGetNextVariableName () returned
+                                for the input variable.
+
+**/
+EFI_STATUS
+SmmVariableGetVariableBatch (
+  IN OUT SMM_VARIABLE_COMMUNICATE_GET_VARIABLE_BATCH  *Batch,
+  IN     UINTN                                        BatchSize
+  )
+{
+  EFI_STATUS                Status;
+  SMM_VARIABLE_BATCH_ENTRY  *Entry;
+  CHAR16                    *PreviousName;
+  UINTN                     PreviousNameSize;
+  EFI_GUID                  *PreviousGuid;
+  CHAR16                    *Name;
+  UINTN                     NameSize;
+  UINTN                     DataSize;
+  UINT32                    Attributes;
+  UINT32                    Flags;
+  UINTN                     Offset;
+
+  PreviousName     = Batch->Name;
+  PreviousNameSize = StrSize (Batch->Name);
+  PreviousGuid     = &Batch->Guid;
+
+  Batch->Generation     = mVariableModuleGlobal->Generation;
+  Batch->EntryCount     = 0;
+  Batch->EndOfVariables = FALSE;
+
+  Status = EFI_BUFFER_TOO_SMALL;
+  Offset = SMM_VARIABLE_BATCH_FIRST_ENTRY_OFFSET (Batch->NameSize);
+  while ((Offset < BatchSize) && (BatchSize - Offset > sizeof (SMM_VARIABLE_BATCH_ENTRY) + PreviousNameSize)) {
+    Entry    = (SMM_VARIABLE_BATCH_ENTRY *)((UINT8 *)Batch + Offset);
+    Name     = (CHAR16 *)(Entry + 1);
+    NameSize = BatchSize - Offset - sizeof (SMM_VARIABLE_BATCH_ENTRY);
+
+    CopyMem (Name, PreviousName, PreviousNameSize);
+    CopyGuid (&Entry->Guid, PreviousGuid);
+    Status = VariableServiceGetNextVariableName (&NameSize, Name, &Entry->Guid);
+    if (Status == EFI_NOT_FOUND) {
+      Batch->EndOfVariables = TRUE;
+      Status                = EFI_SUCCESS;
+      break;
+    }
+
+    if (EFI_ERROR (Status)) {
+      break;
+    }
+
+    Flags    = 0;
+    DataSize = BatchSize - Offset - sizeof (SMM_VARIABLE_BATCH_ENTRY) - NameSize;
+    Status   = VariableServiceGetVariableInternal (Name, &Entry->Guid, &Attributes, &DataSize, (UINT8 *)Name + NameSize, FALSE);
+    if (Status == EFI_BUFFER_TOO_SMALL) {
+      if (Batch->EntryCount != 0) {
+        //
+        // Leave the variable to the next batch, which has room for its data.
+        //
+        Status = EFI_SUCCESS;
+        break;
+      }
+
+      Flags  = SMM_VARIABLE_BATCH_ENTRY_DATA_OMITTED;
+      Status = EFI_SUCCESS;
+    } else if (EFI_ERROR (Status)) {
+      break;
+    }
+
+    Entry->Attributes = Attributes;
+    Entry->NameSize   = (UINT32)NameSize;
+    Entry->DataSize   = (UINT32)DataSize;
+    Entry->Flags      = Flags;
+    Batch->EntryCount++;
+
+    PreviousName     = Name;
+    PreviousNameSize = NameSize;
+    PreviousGuid     = &Entry->Guid;
+    Offset          += ALIGN_VALUE (SMM_VARIABLE_BATCH_ENTRY_SIZE (Entry), SMM_VARIABLE_BATCH_ENTRY_ALIGNMENT);
+  }
+
+  if (Batch->EntryCount != 0) {
+    //
+    // Errors past the first entry only end the batch early.
+    //
+    Status = EFI_SUCCESS;
+  }
+
+  return Status;
+}
+
 /**
   Communication service SMI Handler entry.
 
@@ -433,7 +541,8 @@ SmmVariableGetStatistics (
   This variable data and communicate buffer are external input, so this function will do basic validation.
   Each sub function VariableServiceGetVariable(), VariableServiceGetNextVariableName(),
   VariableServiceSetVariable(), VariableServiceQueryVariableInfo(), ReclaimForOS(),
-  SmmVariableGetStatistics() should also do validation based on its own knowledge.
+  SmmVariableGetStatistics(), SmmVariableGetVariableBatch() should also do validation
+  based on its own knowledge.
 
   @param[in]     DispatchHandle  The unique handle assigned to this handler by SmiHandlerRegister().
   @param[in]     RegisterContext Points to an optional handler context which was specified when the
@@ -463,10 +572,12 @@ SmmVariableHandler (
   SMM_VARIABLE_COMMUNICATE_HEADER                          *SmmVariableFunctionHeader;
   SMM_VARIABLE_COMMUNICATE_ACCESS_VARIABLE                 *SmmVariableHeader;
   SMM_VARIABLE_COMMUNICATE_GET_NEXT_VARIABLE_NAME          *GetNextVariableName;
+  SMM_VARIABLE_COMMUNICATE_GET_VARIABLE_BATCH              *GetVariableBatch;
   SMM_VARIABLE_COMMUNICATE_QUERY_VARIABLE_INFO             *QueryVariableInfo;
   SMM_VARIABLE_COMMUNICATE_GET_PAYLOAD_SIZE                *GetPayloadSize;
   SMM_VARIABLE_COMMUNICATE_RUNTIME_VARIABLE_CACHE_CONTEXT  *RuntimeVariableCacheContext;
   SMM_VARIABLE_COMMUNICATE_GET_RUNTIME_CACHE_INFO          *GetRuntimeCacheInfo;
+  SMM_VARIABLE_COMMUNICATE_VARIABLE_BATCH_CONTEXT          *VariableBatchContext;
   SMM_VARIABLE_COMMUNICATE_LOCK_VARIABLE                   *VariableToLock;
   SMM_VARIABLE_COMMUNICATE_VAR_CHECK_VARIABLE_PROPERTY     *CommVariableProperty;
   VARIABLE_INFO_ENTRY                                      *VariableInfo;
@@ -608,6 +719,54 @@ SmmVariableHandler (
       CopyMem (SmmVariableFunctionHeader->Data, mVariableBufferPayload, CommBufferPayloadSize);
       break;
 
+    case SMM_VARIABLE_FUNCTION_GET_VARIABLE_BATCH:
+      if (CommBufferPayloadSize < OFFSET_OF (SMM_VARIABLE_COMMUNICATE_GET_VARIABLE_BATCH, Name)) {
+        DEBUG ((DEBUG_ERROR, "GetVariableBatch: SMM communication buffer size invalid!\n"));
+        return EFI_SUCCESS;
+      }
+
+      //
+      // Copy the input communicate buffer payload to pre-allocated SMM variable buffer payload.
+      //
+      CopyMem (mVariableBufferPayload, SmmVariableFunctionHeader->Data, CommBufferPayloadSize);
+      GetVariableBatch = (SMM_VARIABLE_COMMUNICATE_GET_VARIABLE_BATCH *)mVariableBufferPayload;
+      if ((UINTN)(~0) - GetVariableBatch->NameSize < OFFSET_OF (SMM_VARIABLE_COMMUNICATE_GET_VARIABLE_BATCH, Name)) {
+        //
+        // Prevent InfoSize overflow happen
+        //
+        Status = EFI_ACCESS_DENIED;
+        goto EXIT;
+      }
+
+      InfoSize = OFFSET_OF (SMM_VARIABLE_COMMUNICATE_GET_VARIABLE_BATCH, Name) + GetVariableBatch->NameSize;
+
+      //
+      // SMRAM range check already covered before
+      //
+      if (InfoSize > CommBufferPayloadSize) {
+        DEBUG ((DEBUG_ERROR, "GetVariableBatch: Data size exceed communication buffer size limit!\n"));
+        Status = EFI_ACCESS_DENIED;
+        goto EXIT;
+      }
+
+      //
+      // The VariableSpeculationBarrier() call here is to ensure the previous
+      // range/content checks for the CommBuffer have been completed before the
+      // subsequent consumption of the CommBuffer content.
+      //
+      VariableSpeculationBarrier ();
+      if ((GetVariableBatch->NameSize < sizeof (CHAR16)) || (GetVariableBatch->Name[GetVariableBatch->NameSize/sizeof (CHAR16) - 1] != L'\0')) {
+        //
+        // Make sure input VariableName is A Null-terminated string.
+        //
+        Status = EFI_ACCESS_DENIED;
+        goto EXIT;
+      }
+
+      Status = SmmVariableGetVariableBatch (GetVariableBatch, CommBufferPayloadSize);
+      CopyMem (SmmVariableFunctionHeader->Data, mVariableBufferPayload, CommBufferPayloadSize);
+      break;
+
     case SMM_VARIABLE_FUNCTION_SET_VARIABLE:
       if (CommBufferPayloadSize < OFFSET_OF (SMM_VARIABLE_COMMUNICATE_ACCESS_VARIABLE, Name)) {
         DEBUG ((DEBUG_ERROR, "SetVariable: SMM communication buffer size invalid!\n"));
@@ -711,6 +870,7 @@ SmmVariableHandler (
       }
 
       ReclaimForOS ();
+      VariableDumpLatencyStatistics ();
       Status = EFI_SUCCESS;
       break;
 
@@ -737,6 +897,22 @@ SmmVariableHandler (
       *CommBufferSize = InfoSize + SMM_VARIABLE_COMMUNICATE_HEADER_SIZE;
       break;
 
+    case SMM_VARIABLE_FUNCTION_GET_LATENCY_STATISTICS:
+      if (!FeaturePcdGet (PcdVariableCollectStatistics)) {
+        Status = EFI_UNSUPPORTED;
+        break;
+      }
+
+      if (CommBufferPayloadSize < sizeof (VARIABLE_LATENCY_STATISTICS)) {
+        DEBUG ((DEBUG_ERROR, "GetLatencyStatistics: SMM communication buffer size invalid!\n"));
+        Status = EFI_BUFFER_TOO_SMALL;
+        break;
+      }
+
+      CopyMem (SmmVariableFunctionHeader->Data, &mVariableModuleGlobal->Latency, sizeof (VARIABLE_LATENCY_STATISTICS));
+      Status = EFI_SUCCESS;
+      break;
+
     case SMM_VARIABLE_FUNCTION_LOCK_VARIABLE:
       if (mEndOfDxe) {
         Status = EFI_ACCESS_DENIED;
@@ -924,6 +1100,17 @@ SmmVariableHandler (
         goto EXIT;
       }
 
+      if ((RuntimeVariableCacheContext->FlushCount != NULL) &&
+          !VariableSmmIsNonPrimaryBufferValid (
+             (UINTN)RuntimeVariableCacheContext->FlushCount,
+             sizeof (*(RuntimeVariableCacheContext->FlushCount))
+             ))
+      {
+        DEBUG ((DEBUG_ERROR, "InitRuntimeVariableCacheContext: Runtime cache flush count buffer in SMRAM or overflow!\n"));
+        Status = EFI_ACCESS_DENIED;
+        goto EXIT;
+      }
+
       VariableCacheContext                                     = &mVariableModuleGlobal->VariableGlobal.VariableRuntimeCacheContext;
       VariableCacheContext->VariableRuntimeHobCache.Store      = RuntimeVariableCacheContext->RuntimeHobCache;
       VariableCacheContext->VariableRuntimeVolatileCache.Store = RuntimeVariableCacheContext->RuntimeVolatileCache;
@@ -931,6 +1118,7 @@ SmmVariableHandler (
       VariableCacheContext->PendingUpdate                      = RuntimeVariableCacheContext->PendingUpdate;
       VariableCacheContext->ReadLock                           = RuntimeVariableCacheContext->ReadLock;
       VariableCacheContext->HobFlushComplete                   = RuntimeVariableCacheContext->HobFlushComplete;
+      VariableCacheContext->FlushCount                         = RuntimeVariableCacheContext->FlushCount;
 
       // Set up the intial pending request since the RT cache needs to be in sync with SMM cache
       VariableCacheContext->VariableRuntimeHobCache.PendingUpdateOffset = 0;
@@ -983,6 +1171,46 @@ SmmVariableHandler (
       GetRuntimeCacheInfo->TotalNvStorageSize         = (UINTN)VariableCache->Size;
       GetRuntimeCacheInfo->AuthenticatedVariableUsage = mVariableModuleGlobal->VariableGlobal.AuthFormat;
 
+      Status = EFI_SUCCESS;
+      break;
+    case SMM_VARIABLE_FUNCTION_INIT_VARIABLE_BATCH_CONTEXT:
+      if (CommBufferPayloadSize < sizeof (SMM_VARIABLE_COMMUNICATE_VARIABLE_BATCH_CONTEXT)) {
+        DEBUG ((DEBUG_ERROR, "InitVariableBatchContext: SMM communication buffer size invalid!\n"));
+        Status = EFI_ACCESS_DENIED;
+        goto EXIT;
+      }
+
+      if (mEndOfDxe) {
+        DEBUG ((DEBUG_ERROR, "InitVariableBatchContext: Cannot init context after end of DXE!\n"));
+        Status = EFI_ACCESS_DENIED;
+        goto EXIT;
+      }
+
+      //
+      // Copy the input communicate buffer payload to the pre-allocated SMM variable payload buffer.
+      //
+      CopyMem (mVariableBufferPayload, SmmVariableFunctionHeader->Data, CommBufferPayloadSize);
+      VariableBatchContext = (SMM_VARIABLE_COMMUNICATE_VARIABLE_BATCH_CONTEXT *)mVariableBufferPayload;
+
+      if (VariableBatchContext->Generation == NULL) {
+        DEBUG ((DEBUG_ERROR, "InitVariableBatchContext: Generation buffer is NULL!\n"));
+        Status = EFI_ACCESS_DENIED;
+        goto EXIT;
+      }
+
+      if (!VariableSmmIsNonPrimaryBufferValid (
+             (UINTN)VariableBatchContext->Generation,
+             sizeof (*(VariableBatchContext->Generation))
+             ))
+      {
+        DEBUG ((DEBUG_ERROR, "InitVariableBatchContext: Generation buffer in SMRAM or overflow!\n"));
+        Status = EFI_ACCESS_DENIED;
+        goto EXIT;
+      }
+
+      mVariableModuleGlobal->GenerationBuffer    = VariableBatchContext->Generation;
+      *(mVariableModuleGlobal->GenerationBuffer) = mVariableModuleGlobal->Generation;
+
       Status = EFI_SUCCESS;
       break;
 
@@ -1163,6 +1391,11 @@ MmVariableServiceInitialize (
   Status = VariableCommonInitialize ();
   ASSERT_EFI_ERROR (Status);
 
+  //
+  // The MM Fault Tolerant Write protocol remains available at OS runtime.
+  //
+  mVariableModuleGlobal->IncrementalReclaim.AllowedAtRuntime = TRUE;
+
   //
   // Install the Smm Variable Protocol on a new handle.
   //
@@ -43,6 +43,7 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 
 #include "PrivilegePolymorphic.h"
 #include "VariableParsing.h"
+#include "VariableIndex.h"
 
 EFI_HANDLE                      mHandle                    = NULL;
 EFI_SMM_VARIABLE_PROTOCOL       *mSmmVariable              = NULL;
@@ -59,6 +60,23 @@ EDKII_VARIABLE_LOCK_PROTOCOL    mVariableLock;
 EDKII_VAR_CHECK_PROTOCOL        mVarCheck;
 VARIABLE_RUNTIME_CACHE_INFO     mVariableRtCacheInfo;
 BOOLEAN                         mIsRuntimeCacheEnabled = FALSE;
+UINT32                          mRuntimeCacheFlushCount;
+
+//
+// Copy of the last SMM_VARIABLE_FUNCTION_GET_VARIABLE_BATCH result. It serves
+// sequential GetNextVariableName () calls, and the GetVariable () of the
+// variable just enumerated, without an SMI each when the runtime cache is
+// disabled. SMM keeps mVariableBatchGeneration equal to the variable store
+// generation, so the copy is only used while no variable has changed since
+// it was fetched, whoever changed it.
+//
+UINT8    *mVariableBatch           = NULL;
+UINT64   *mVariableBatchGeneration = NULL;
+BOOLEAN  mVariableBatchSupported   = FALSE;
+BOOLEAN  mVariableBatchValid       = FALSE;
+UINTN    mVariableBatchCurrent     = 0;
+UINTN    mVariableBatchNext        = 0;
+UINTN    mVariableBatchRemaining   = 0;
 
 /**
   The logic to initialize the VariablePolicy engine is in its own file.
@@ -461,6 +479,51 @@ Done:
   return Status;
 }
 
+/**
+  Registers mVariableBatchGeneration with SMM, which keeps it up to date from
+  then on.
+
+  @retval EFI_SUCCESS                The buffer was registered.
+  @retval Others                     Failure is returned from the function in SMM.
+
+**/
+EFI_STATUS
+SendVariableBatchContextToSmm (
+  VOID
+  )
+{
+  EFI_STATUS                                       Status;
+  SMM_VARIABLE_COMMUNICATE_VARIABLE_BATCH_CONTEXT  *SmmVariableBatchContext;
+
+  AcquireLockOnlyAtBootTime (&mVariableServicesLock);
+
+  //
+  // Init the communicate buffer. The buffer data size is:
+  // SMM_COMMUNICATE_HEADER_SIZE + SMM_VARIABLE_COMMUNICATE_HEADER_SIZE + sizeof (SMM_VARIABLE_COMMUNICATE_VARIABLE_BATCH_CONTEXT).
+  //
+  Status = InitCommunicateBuffer (
+             (VOID **)&SmmVariableBatchContext,
+             sizeof (SMM_VARIABLE_COMMUNICATE_VARIABLE_BATCH_CONTEXT),
+             SMM_VARIABLE_FUNCTION_INIT_VARIABLE_BATCH_CONTEXT
+             );
+  if (EFI_ERROR (Status)) {
+    goto Done;
+  }
+
+  ASSERT (SmmVariableBatchContext != NULL);
+
+  SmmVariableBatchContext->Generation = mVariableBatchGeneration;
+
+  //
+  // Send data to SMM.
+  //
+  Status = SendCommunicateBuffer (sizeof (SMM_VARIABLE_COMMUNICATE_VARIABLE_BATCH_CONTEXT));
+
+Done:
+  ReleaseLockOnlyAtBootTime (&mVariableServicesLock);
+  return Status;
+}
+
 /**
   Signals SMM to synchronize any pending variable updates with the runtime cache(s).
 
@@ -509,6 +572,30 @@ CheckForRuntimeCacheSync (
   //
   if ((CacheInfoFlag->HobFlushComplete) && (mVariableRtCacheInfo.RuntimeHobCacheBuffer != 0)) {
     mVariableRtCacheInfo.RuntimeHobCacheBuffer = 0;
+    VariableIndexRegisterStore (VariableStoreTypeHob, NULL, mVariableAuthFormat);
+  }
+}
+
+/**
+  Invalidates the variable index of the runtime caches if SMM flushed updates
+  into them since the last lookup.
+
+  Must be called with the runtime cache read lock held, so no flush can happen
+  while the caches are being searched.
+
+**/
+VOID
+CheckForRuntimeCacheIndexSync (
+  VOID
+  )
+{
+  CACHE_INFO_FLAG  *CacheInfoFlag;
+
+  CacheInfoFlag = (CACHE_INFO_FLAG *)(UINTN)mVariableRtCacheInfo.CacheInfoFlagBuffer;
+
+  if (CacheInfoFlag->FlushCount != mRuntimeCacheFlushCount) {
+    mRuntimeCacheFlushCount = CacheInfoFlag->FlushCount;
+    VariableIndexInvalidate (NULL);
   }
 }
 
@@ -567,6 +654,8 @@ FindVariableInRuntimeCache (
   CheckForRuntimeCacheSync ();
 
   if (!(CacheInfoFlag->PendingUpdate)) {
+    CheckForRuntimeCacheIndexSync ();
+
     //
     // 0: Volatile, 1: HOB, 2: Non-Volatile.
     // The index and attributes mapping must be kept in this order as FindVariable
@@ -744,6 +833,198 @@ Done:
   return Status;
 }
 
+/**
+  Drops the cached variable batch.
+
+  This must be called whenever a variable may have changed through this driver.
+
+**/
+VOID
+InvalidateVariableBatch (
+  VOID
+  )
+{
+  mVariableBatchValid     = FALSE;
+  mVariableBatchCurrent   = 0;
+  mVariableBatchRemaining = 0;
+}
+
+/**
+  Gets the batch entry last returned by GetNextVariableName () if it is the given variable.
+
+  @param[in]      VariableName       Name of the variable.
+  @param[in]      VendorGuid         Variable vendor GUID.
+
+  @return  The batch entry of the variable, or NULL if the variable is not the
+           one last enumerated from the batch, or a variable has changed since
+           the batch was fetched.
+
+**/
+SMM_VARIABLE_BATCH_ENTRY *
+GetCurrentVariableBatchEntry (
+  IN      CHAR16    *VariableName,
+  IN      EFI_GUID  *VendorGuid
+  )
+{
+  SMM_VARIABLE_BATCH_ENTRY  *Entry;
+
+  if (mVariableBatchValid &&
+      (((SMM_VARIABLE_COMMUNICATE_GET_VARIABLE_BATCH *)mVariableBatch)->Generation != *mVariableBatchGeneration))
+  {
+    InvalidateVariableBatch ();
+  }
+
+  if (!mVariableBatchValid || (mVariableBatchCurrent == 0)) {
+    return NULL;
+  }
+
+  Entry = (SMM_VARIABLE_BATCH_ENTRY *)(mVariableBatch + mVariableBatchCurrent);
+  if (!CompareGuid (&Entry->Guid, VendorGuid) || (StrCmp ((CHAR16 *)(Entry + 1), VariableName) != 0)) {
+    return NULL;
+  }
+
+  return Entry;
+}
+
+/**
+  Fetches the variables that follow the given variable from SMM in one batch.
+
+  @param[in]      VariableName       Name of the variable to continue after, or an
+                                     empty string to start at the first variable.
+  @param[in]      VendorGuid         Variable vendor GUID.
+
+  @retval EFI_SUCCESS                The batch was fetched.
+  @retval EFI_INVALID_PARAMETER      VariableName exceeds the SMM payload limit.
+  @retval EFI_DEVICE_ERROR           SMM returned a malformed batch.
+  @retval Others                     Failure is returned from the function in SMM.
+
+**/
+EFI_STATUS
+FetchVariableBatch (
+  IN      CHAR16    *VariableName,
+  IN      EFI_GUID  *VendorGuid
+  )
+{
+  EFI_STATUS                                   Status;
+  SMM_VARIABLE_COMMUNICATE_GET_VARIABLE_BATCH  *SmmGetVariableBatch;
+  SMM_VARIABLE_BATCH_ENTRY                     *Entry;
+  UINTN                                        VariableNameSize;
+  UINTN                                        Index;
+  UINTN                                        Offset;
+  UINTN                                        EntrySize;
+
+  InvalidateVariableBatch ();
+
+  VariableNameSize    = StrSize (VariableName);
+  SmmGetVariableBatch = NULL;
+
+  //
+  // If input string exceeds SMM payload limit. Return failure
+  //
+  if (VariableNameSize > mVariableBufferPayloadSize - OFFSET_OF (SMM_VARIABLE_COMMUNICATE_GET_VARIABLE_BATCH, Name)) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  //
+  // The batch fills the whole payload.
+  //
+  Status = InitCommunicateBuffer ((VOID **)&SmmGetVariableBatch, mVariableBufferPayloadSize, SMM_VARIABLE_FUNCTION_GET_VARIABLE_BATCH);
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  ASSERT (SmmGetVariableBatch != NULL);
+
+  CopyGuid (&SmmGetVariableBatch->Guid, VendorGuid);
+  SmmGetVariableBatch->NameSize = VariableNameSize;
+  CopyMem (SmmGetVariableBatch->Name, VariableName, VariableNameSize);
+
+  Status = SendCommunicateBuffer (mVariableBufferPayloadSize);
+  if (Status == EFI_UNSUPPORTED) {
+    //
+    // The SMM variable driver does not know the batch request.
+    //
+    mVariableBatchSupported = FALSE;
+  }
+
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  Offset = SMM_VARIABLE_BATCH_FIRST_ENTRY_OFFSET (VariableNameSize);
+  for (Index = 0; Index < SmmGetVariableBatch->EntryCount; Index++) {
+    if ((Offset >= mVariableBufferPayloadSize) || (mVariableBufferPayloadSize - Offset < sizeof (SMM_VARIABLE_BATCH_ENTRY))) {
+      return EFI_DEVICE_ERROR;
+    }
+
+    Entry     = (SMM_VARIABLE_BATCH_ENTRY *)((UINT8 *)SmmGetVariableBatch + Offset);
+    EntrySize = SMM_VARIABLE_BATCH_ENTRY_SIZE (Entry);
+    if ((Entry->NameSize < sizeof (CHAR16)) || (EntrySize > mVariableBufferPayloadSize - Offset)) {
+      return EFI_DEVICE_ERROR;
+    }
+
+    Offset += ALIGN_VALUE (EntrySize, SMM_VARIABLE_BATCH_ENTRY_ALIGNMENT);
+  }
+
+  CopyMem (mVariableBatch, SmmGetVariableBatch, MIN (Offset, mVariableBufferPayloadSize));
+
+  mVariableBatchValid     = TRUE;
+  mVariableBatchNext      = SMM_VARIABLE_BATCH_FIRST_ENTRY_OFFSET (VariableNameSize);
+  mVariableBatchRemaining = SmmGetVariableBatch->EntryCount;
+  return EFI_SUCCESS;
+}
+
+/**
+  Finds the variable last enumerated from the variable batch.
+
+  @param[in]      VariableName       Name of Variable to be found.
+  @param[in]      VendorGuid         Variable vendor GUID.
+  @param[out]     Attributes         Attribute value of the variable found.
+  @param[in, out] DataSize           Size of Data found. If size is less than the
+                                     data, this value contains the required size.
+  @param[out]     Data               Data pointer.
+
+  @retval EFI_SUCCESS                Found the specified variable.
+  @retval EFI_BUFFER_TOO_SMALL       The DataSize is too small for the result.
+  @retval EFI_INVALID_PARAMETER      The DataSize is not too small and Data is NULL.
+  @retval EFI_NOT_FOUND              The variable is not in the batch, the caller
+                                     must ask SMM.
+
+**/
+EFI_STATUS
+FindVariableInBatch (
+  IN      CHAR16    *VariableName,
+  IN      EFI_GUID  *VendorGuid,
+  OUT     UINT32    *Attributes OPTIONAL,
+  IN OUT  UINTN     *DataSize,
+  OUT     VOID      *Data OPTIONAL
+  )
+{
+  SMM_VARIABLE_BATCH_ENTRY  *Entry;
+
+  Entry = GetCurrentVariableBatchEntry (VariableName, VendorGuid);
+  if ((Entry == NULL) || ((Entry->Flags & SMM_VARIABLE_BATCH_ENTRY_DATA_OMITTED) != 0)) {
+    return EFI_NOT_FOUND;
+  }
+
+  if (Attributes != NULL) {
+    *Attributes = Entry->Attributes;
+  }
+
+  if (*DataSize < Entry->DataSize) {
+    *DataSize = Entry->DataSize;
+    return EFI_BUFFER_TOO_SMALL;
+  }
+
+  *DataSize = Entry->DataSize;
+  if (Data == NULL) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  CopyMem (Data, (UINT8 *)(Entry + 1) + Entry->NameSize, Entry->DataSize);
+  return EFI_SUCCESS;
+}
+
 /**
   This code finds variable in storage blocks (Volatile or Non-Volatile).
 
@@ -796,7 +1077,14 @@ RuntimeServiceGetVariable (
   if (mIsRuntimeCacheEnabled) {
     Status = FindVariableInRuntimeCache (VariableName, VendorGuid, Attributes, DataSize, Data);
   } else {
-    Status = FindVariableInSmm (VariableName, VendorGuid, Attributes, DataSize, Data);
+    Status = EFI_NOT_FOUND;
+    if (mVariableBatchSupported) {
+      Status = FindVariableInBatch (VariableName, VendorGuid, Attributes, DataSize, Data);
+    }
+
+    if (Status == EFI_NOT_FOUND) {
+      Status = FindVariableInSmm (VariableName, VendorGuid, Attributes, DataSize, Data);
+    }
   }
 
   ReleaseLockOnlyAtBootTime (&mVariableServicesLock);
@@ -857,6 +1145,8 @@ GetNextVariableNameInRuntimeCache (
 
   CacheInfoFlag->ReadLock = TRUE;
   if (!(CacheInfoFlag->PendingUpdate)) {
+    CheckForRuntimeCacheIndexSync ();
+
     //
     // 0: Volatile, 1: HOB, 2: Non-Volatile.
     // The index and attributes mapping must be kept in this order as FindVariable
@@ -1006,6 +1296,74 @@ Done:
   return Status;
 }
 
+/**
+  Finds the next available variable through the variable batch.
+
+  Sequential enumeration is served from the batch, and the next batch is
+  fetched with one SMI once the batch is exhausted. Any other request starts a
+  new batch after the given variable.
+
+  @param[in, out] VariableNameSize   Size of the variable name.
+  @param[in, out] VariableName       Pointer to variable name.
+  @param[in, out] VendorGuid         Variable Vendor Guid.
+
+  @retval EFI_SUCCESS                The function completed successfully.
+  @retval EFI_NOT_FOUND              The next variable was not found.
+  @retval EFI_BUFFER_TOO_SMALL       The VariableNameSize is too small for the result.
+                                     VariableNameSize has been updated with the size needed to complete the request.
+  @retval Others                     See GetNextVariableNameInSmm ().
+
+**/
+EFI_STATUS
+GetNextVariableNameInBatch (
+  IN OUT  UINTN     *VariableNameSize,
+  IN OUT  CHAR16    *VariableName,
+  IN OUT  EFI_GUID  *VendorGuid
+  )
+{
+  EFI_STATUS                                   Status;
+  SMM_VARIABLE_COMMUNICATE_GET_VARIABLE_BATCH  *Batch;
+  SMM_VARIABLE_BATCH_ENTRY                     *Entry;
+
+  Batch = (SMM_VARIABLE_COMMUNICATE_GET_VARIABLE_BATCH *)mVariableBatch;
+  if ((GetCurrentVariableBatchEntry (VariableName, VendorGuid) == NULL) ||
+      ((mVariableBatchRemaining == 0) && !Batch->EndOfVariables))
+  {
+    Status = FetchVariableBatch (VariableName, VendorGuid);
+    if (EFI_ERROR (Status)) {
+      //
+      // Let the single request report the error, or serve the variable the
+      // batch could not hold.
+      //
+      return GetNextVariableNameInSmm (VariableNameSize, VariableName, VendorGuid);
+    }
+  }
+
+  if (mVariableBatchRemaining == 0) {
+    if (Batch->EndOfVariables) {
+      return EFI_NOT_FOUND;
+    }
+
+    InvalidateVariableBatch ();
+    return GetNextVariableNameInSmm (VariableNameSize, VariableName, VendorGuid);
+  }
+
+  Entry = (SMM_VARIABLE_BATCH_ENTRY *)(mVariableBatch + mVariableBatchNext);
+  if (Entry->NameSize > *VariableNameSize) {
+    *VariableNameSize = Entry->NameSize;
+    return EFI_BUFFER_TOO_SMALL;
+  }
+
+  CopyGuid (VendorGuid, &Entry->Guid);
+  CopyMem (VariableName, Entry + 1, Entry->NameSize);
+  *VariableNameSize = Entry->NameSize;
+
+  mVariableBatchCurrent = mVariableBatchNext;
+  mVariableBatchNext   += ALIGN_VALUE (SMM_VARIABLE_BATCH_ENTRY_SIZE (Entry), SMM_VARIABLE_BATCH_ENTRY_ALIGNMENT);
+  mVariableBatchRemaining--;
+  return EFI_SUCCESS;
+}
+
 /**
   This code Finds the Next available variable.
 
@@ -1063,6 +1421,8 @@ RuntimeServiceGetNextVariableName (
   AcquireLockOnlyAtBootTime (&mVariableServicesLock);
   if (mIsRuntimeCacheEnabled) {
     Status = GetNextVariableNameInRuntimeCache (VariableNameSize, VariableName, VendorGuid);
+  } else if (mVariableBatchSupported) {
+    Status = GetNextVariableNameInBatch (VariableNameSize, VariableName, VendorGuid);
   } else {
     Status = GetNextVariableNameInSmm (VariableNameSize, VariableName, VendorGuid);
   }
@@ -1143,6 +1503,7 @@ RuntimeServiceSetVariable (
   }
 
   AcquireLockOnlyAtBootTime (&mVariableServicesLock);
+  InvalidateVariableBatch ();
 
   //
   // Init the communicate buffer. The buffer data size is:
@@ -1277,6 +1638,11 @@ OnExitBootServices (
   //
   InitCommunicateBuffer (NULL, 0, SMM_VARIABLE_FUNCTION_EXIT_BOOT_SERVICE);
 
+  //
+  // Variables without runtime access disappear from the enumeration.
+  //
+  InvalidateVariableBatch ();
+
   //
   // Send data to SMM.
   //
@@ -1341,12 +1707,22 @@ VariableAddressChangeEvent (
   IN VOID       *Context
   )
 {
+  UINTN  Index;
+
   EfiConvertPointer (0x0, (VOID **)&mVariableBuffer);
   EfiConvertPointer (0x0, (VOID **)&mMmCommunication2);
+  EfiConvertPointer (EFI_OPTIONAL_PTR, (VOID **)&mVariableBatch);
+  EfiConvertPointer (EFI_OPTIONAL_PTR, (VOID **)&mVariableBatchGeneration);
   EfiConvertPointer (EFI_OPTIONAL_PTR, (VOID **)&mVariableRtCacheInfo.CacheInfoFlagBuffer);
   EfiConvertPointer (EFI_OPTIONAL_PTR, (VOID **)&mVariableRtCacheInfo.RuntimeHobCacheBuffer);
   EfiConvertPointer (EFI_OPTIONAL_PTR, (VOID **)&mVariableRtCacheInfo.RuntimeNvCacheBuffer);
   EfiConvertPointer (EFI_OPTIONAL_PTR, (VOID **)&mVariableRtCacheInfo.RuntimeVolatileCacheBuffer);
+
+  for (Index = 0; Index < VariableStoreTypeMax; Index++) {
+    EfiConvertPointer (EFI_OPTIONAL_PTR, (VOID **)&mVariableStoreIndex[Index].Store);
+    EfiConvertPointer (EFI_OPTIONAL_PTR, (VOID **)&mVariableStoreIndex[Index].Buckets);
+    EfiConvertPointer (EFI_OPTIONAL_PTR, (VOID **)&mVariableStoreIndex[Index].Entries);
+  }
 }
 
 /**
@@ -1577,6 +1953,14 @@ InitVariableCache (
     InitVariableStoreHeader ((VOID *)(UINTN)mVariableRtCacheInfo.RuntimeHobCacheBuffer, AllocatedHobCacheSize);
     InitVariableStoreHeader ((VOID *)(UINTN)mVariableRtCacheInfo.RuntimeNvCacheBuffer, AllocatedNvCacheSize);
     InitVariableStoreHeader ((VOID *)(UINTN)mVariableRtCacheInfo.RuntimeVolatileCacheBuffer, AllocatedVolatileCacheSize);
+
+    //
+    // Index the runtime caches. SMM bumps the flush count whenever it copies
+    // updates into them, which invalidates the index before the next lookup.
+    //
+    VariableIndexRegisterStore (VariableStoreTypeHob, (VARIABLE_STORE_HEADER *)(UINTN)mVariableRtCacheInfo.RuntimeHobCacheBuffer, mVariableAuthFormat);
+    VariableIndexRegisterStore (VariableStoreTypeNv, (VARIABLE_STORE_HEADER *)(UINTN)mVariableRtCacheInfo.RuntimeNvCacheBuffer, mVariableAuthFormat);
+    VariableIndexRegisterStore (VariableStoreTypeVolatile, (VARIABLE_STORE_HEADER *)(UINTN)mVariableRtCacheInfo.RuntimeVolatileCacheBuffer, mVariableAuthFormat);
   }
 
   return Status;
@@ -1633,6 +2017,7 @@ SendRuntimeVariableCacheContextToSmm (
   SmmRuntimeVarCacheContext->PendingUpdate        = &((CACHE_INFO_FLAG *)(UINTN)mVariableRtCacheInfo.CacheInfoFlagBuffer)->PendingUpdate;
   SmmRuntimeVarCacheContext->ReadLock             = &((CACHE_INFO_FLAG *)(UINTN)mVariableRtCacheInfo.CacheInfoFlagBuffer)->ReadLock;
   SmmRuntimeVarCacheContext->HobFlushComplete     = &((CACHE_INFO_FLAG *)(UINTN)mVariableRtCacheInfo.CacheInfoFlagBuffer)->HobFlushComplete;
+  SmmRuntimeVarCacheContext->FlushCount           = &((CACHE_INFO_FLAG *)(UINTN)mVariableRtCacheInfo.CacheInfoFlagBuffer)->FlushCount;
 
   //
   // Send data to SMM.
@@ -1714,6 +2099,17 @@ SmmVariableReady (
     ASSERT_EFI_ERROR (Status);
   } else {
     DEBUG ((DEBUG_INFO, "Variable driver runtime cache is disabled.\n"));
+
+    mVariableBatch           = AllocateRuntimePool (mVariableBufferPayloadSize);
+    mVariableBatchGeneration = AllocateRuntimeZeroPool (sizeof (*mVariableBatchGeneration));
+    if ((mVariableBatch != NULL) && (mVariableBatchGeneration != NULL)) {
+      //
+      // Without the generation, a variable changed by another agent, such as
+      // an SMM driver, could be served from a stale batch.
+      //
+      Status                  = SendVariableBatchContextToSmm ();
+      mVariableBatchSupported = (BOOLEAN)!EFI_ERROR (Status);
+    }
   }
 
   gRT->GetVariable         = RuntimeServiceGetVariable;
@@ -0,0 +1,51 @@
+/** @file
+  CRC32 acceleration with the ARMv8 CRC32 instructions.
+
+  Copyright (c) 2026, Intel Corporation. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include "BaseLibInternals.h"
+
+#define CRC32_ARMV8_MIN_LENGTH  64
+
+/**
+  Updates a running CRC32 value with the CRC instructions of the processor.
+
+  The unaligned head of the buffer is processed in software, so the CRC32
+  instructions only ever load naturally aligned doublewords.
+
+  @param[in, out]  Crc     The running CRC32 value, not inverted.
+  @param[in]       Buffer  A pointer to the data.
+  @param[in]       Length  The number of bytes in Buffer.
+
+  @retval TRUE   Crc was updated with all of Buffer.
+  @retval FALSE  Crc is unchanged; the caller must compute it in software.
+
+**/
+BOOLEAN
+InternalCrc32Accelerated (
+  IN OUT UINT32       *Crc,
+  IN     CONST UINT8  *Buffer,
+  IN     UINTN        Length
+  )
+{
+  UINT64  Isar0;
+  UINTN   Head;
+
+  if (Length < CRC32_ARMV8_MIN_LENGTH) {
+    return FALSE;
+  }
+
+  Isar0 = ArmReadIdAA64Isar0Reg ();
+  if (((Isar0 >> ARM_ID_AA64ISAR0_EL1_CRC32_SHIFT) & ARM_ID_AA64ISAR0_EL1_CRC32_MASK) == 0) {
+    return FALSE;
+  }
+
+  Head = ((UINTN)0 - (UINTN)Buffer) & 0x7;
+
+  *Crc = InternalCrc32SliceBy8 (*Crc, Buffer, Head);
+  *Crc = InternalCrc32Armv8 (*Crc, Buffer + Head, Length - Head);
+  return TRUE;
+}
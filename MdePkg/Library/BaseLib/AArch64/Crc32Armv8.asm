@@ -0,0 +1,51 @@
+;------------------------------------------------------------------------------
+;
+; InternalCrc32Armv8() for AArch64
+;
+; Copyright (c) 2026, Intel Corporation. All rights reserved.<BR>
+;
+; SPDX-License-Identifier: BSD-2-Clause-Patent
+;
+;------------------------------------------------------------------------------
+
+  EXPORT InternalCrc32Armv8
+  AREA BaseLib_LowLevel, CODE, READONLY
+
+;/**
+;  Updates a running CRC32 value with the ARMv8 CRC32 instructions.
+;
+;  @param  Crc     The running CRC32 value, not inverted.
+;  @param  Buffer  A pointer to the data, 8-byte aligned.
+;  @param  Length  The number of bytes in Buffer.
+;
+;  @return The updated running CRC32 value.
+;
+;**/
+;UINT32
+;EFIAPI
+;InternalCrc32Armv8 (
+;  IN UINT32      Crc,
+;  IN CONST VOID  *Buffer,
+;  IN UINTN       Length
+;  );
+;
+InternalCrc32Armv8
+  cmp     x2, #8
+  b.lo    Crc32Armv8Bytes
+Crc32Armv8Loop
+  ldr     x3, [x1], #8
+  crc32x  w0, w0, x3
+  sub     x2, x2, #8
+  cmp     x2, #8
+  b.hs    Crc32Armv8Loop
+Crc32Armv8Bytes
+  cbz     x2, Crc32Armv8Done
+Crc32Armv8ByteLoop
+  ldrb    w3, [x1], #1
+  crc32b  w0, w0, w3
+  subs    x2, x2, #1
+  b.ne    Crc32Armv8ByteLoop
+Crc32Armv8Done
+  ret
+
+  END
@@ -553,11 +553,72 @@ InternalAsciiHexCharToUintn (
   IN      CHAR8  Char
   );
 
+/**
+  Updates a running CRC32 value with the bytes of a buffer, eight bytes per
+  step with the slicing-by-8 tables.
+
+  @param[in]  Crc          The running CRC32 value, not inverted.
+  @param[in]  Buffer       A pointer to the data.
+  @param[in]  Length       The number of bytes in Buffer.
+
+  @return The updated running CRC32 value.
+
+**/
+UINT32
+InternalCrc32SliceBy8 (
+  IN UINT32       Crc,
+  IN CONST UINT8  *Buffer,
+  IN UINTN        Length
+  );
+
+/**
+  Updates a running CRC32 value with the CRC instructions of the processor.
+
+  The processor is probed on every call, so the implementation only does so
+  for buffers large enough to amortize the probe.
+
+  @param[in, out]  Crc     The running CRC32 value, not inverted.
+  @param[in]       Buffer  A pointer to the data.
+  @param[in]       Length  The number of bytes in Buffer.
+
+  @retval TRUE   Crc was updated with all of Buffer.
+  @retval FALSE  Crc is unchanged; the caller must compute it in software.
+
+**/
+BOOLEAN
+InternalCrc32Accelerated (
+  IN OUT UINT32       *Crc,
+  IN     CONST UINT8  *Buffer,
+  IN     UINTN        Length
+  );
+
 //
 // Ia32 and x64 specific functions
 //
 #if defined (MDE_CPU_IA32) || defined (MDE_CPU_X64)
 
+/**
+  Folds a 16-byte aligned buffer into a running CRC32 value with the
+  PCLMULQDQ instruction.
+
+  The caller must check for PCLMULQDQ and SSE4.1 support.
+
+  @param[in]  Crc          The running CRC32 value, not inverted.
+  @param[in]  Buffer       A pointer to the data, 16-byte aligned.
+  @param[in]  Length       The number of bytes in Buffer, a multiple of 16 and
+                           at least 64.
+
+  @return The updated running CRC32 value.
+
+**/
+UINT32
+EFIAPI
+InternalCrc32Pclmul (
+  IN UINT32      Crc,
+  IN CONST VOID  *Buffer,
+  IN UINTN       Length
+  );
+
 /**
   Reads the current Global Descriptor Table Register(GDTR) descriptor.
 
@@ -850,7 +911,27 @@ InternalX86RdRand64  (
   OUT     UINT64  *Rand
   );
 
-#else
+#elif defined (MDE_CPU_AARCH64)
+
+/**
+  Updates a running CRC32 value with the ARMv8 CRC32 instructions.
+
+  The caller must check ID_AA64ISAR0_EL1 for CRC32 support.
+
+  @param[in]  Crc          The running CRC32 value, not inverted.
+  @param[in]  Buffer       A pointer to the data, 8-byte aligned.
+  @param[in]  Length       The number of bytes in Buffer.
+
+  @return The updated running CRC32 value.
+
+**/
+UINT32
+EFIAPI
+InternalCrc32Armv8 (
+  IN UINT32      Crc,
+  IN CONST VOID  *Buffer,
+  IN UINTN       Length
+  );
 
 #endif
 
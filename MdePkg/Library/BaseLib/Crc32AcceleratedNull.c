@@ -0,0 +1,29 @@
+/** @file
+  CRC32 acceleration for processors without CRC instructions.
+
+  Copyright (c) 2026, Intel Corporation. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include "BaseLibInternals.h"
+
+/**
+  Updates a running CRC32 value with the CRC instructions of the processor.
+
+  @param[in, out]  Crc     The running CRC32 value, not inverted.
+  @param[in]       Buffer  A pointer to the data.
+  @param[in]       Length  The number of bytes in Buffer.
+
+  @retval FALSE  Always; the caller must compute the CRC in software.
+
+**/
+BOOLEAN
+InternalCrc32Accelerated (
+  IN OUT UINT32       *Crc,
+  IN     CONST UINT8  *Buffer,
+  IN     UINTN        Length
+  )
+{
+  return FALSE;
+}
@@ -0,0 +1,59 @@
+/** @file
+  CRC32 acceleration with the PCLMULQDQ instruction.
+
+  Copyright (c) 2026, Intel Corporation. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include "BaseLibInternals.h"
+#include <Register/Intel/Cpuid.h>
+
+//
+// CPUID may cause a VM exit, so only probe for buffers where the folding
+// saves more than the probe costs.
+//
+#define CRC32_PCLMUL_MIN_LENGTH  SIZE_2KB
+
+/**
+  Updates a running CRC32 value with the CRC instructions of the processor.
+
+  The unaligned head and the tail of the buffer are processed in software;
+  everything in between is folded with PCLMULQDQ.
+
+  @param[in, out]  Crc     The running CRC32 value, not inverted.
+  @param[in]       Buffer  A pointer to the data.
+  @param[in]       Length  The number of bytes in Buffer.
+
+  @retval TRUE   Crc was updated with all of Buffer.
+  @retval FALSE  Crc is unchanged; the caller must compute it in software.
+
+**/
+BOOLEAN
+InternalCrc32Accelerated (
+  IN OUT UINT32       *Crc,
+  IN     CONST UINT8  *Buffer,
+  IN     UINTN        Length
+  )
+{
+  CPUID_VERSION_INFO_ECX  Ecx;
+  UINTN                   Head;
+  UINTN                   Bulk;
+
+  if (Length < CRC32_PCLMUL_MIN_LENGTH) {
+    return FALSE;
+  }
+
+  AsmCpuid (CPUID_VERSION_INFO, NULL, NULL, &Ecx.Uint32, NULL);
+  if ((Ecx.Bits.PCLMULQDQ == 0) || (Ecx.Bits.SSE4_1 == 0)) {
+    return FALSE;
+  }
+
+  Head = ((UINTN)0 - (UINTN)Buffer) & 0xF;
+  Bulk = (Length - Head) & ~(UINTN)0xF;
+
+  *Crc = InternalCrc32SliceBy8 (*Crc, Buffer, Head);
+  *Crc = InternalCrc32Pclmul (*Crc, Buffer + Head, Bulk);
+  *Crc = InternalCrc32SliceBy8 (*Crc, Buffer + Head + Bulk, Length - Head - Bulk);
+  return TRUE;
+}
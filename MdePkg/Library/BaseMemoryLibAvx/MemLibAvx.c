@@ -0,0 +1,364 @@
+/** @file
+  Runtime selection of the vector width used by BaseMemoryLibAvx.
+
+  The library constructor probes CPUID and XCR0 once and records the widest
+  register set both the processor and the enabled OS state support. The
+  InternalMem* functions then dispatch to the AVX-512, AVX2 or SSE2 worker.
+  Functions that do not benefit from wider registers always use SSE2.
+
+  The AVX workers keep data in the upper halves of the YMM and ZMM registers,
+  which the DXE interrupt entry does not save, and they end with VZEROUPPER.
+  A worker interrupted by a timer event that runs another worker would get
+  its registers zeroed. The AVX workers therefore run with interrupts
+  disabled, in chunks of at most MEM_LIB_VECTOR_CHUNK_SIZE bytes so that
+  interrupts are never held off for long.
+
+  Copyright (c) 2026, Intel Corporation. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include "MemLibInternals.h"
+#include <Register/Intel/Cpuid.h>
+
+//
+// XCR0 state components that must be enabled before YMM and ZMM registers
+// may be used: SSE and AVX for AVX2, plus opmask, ZMM_Hi256 and Hi16_ZMM
+// for AVX-512.
+//
+#define MEM_LIB_XCR0_AVX_STATE     (BIT1 | BIT2)
+#define MEM_LIB_XCR0_AVX512_STATE  (MEM_LIB_XCR0_AVX_STATE | BIT5 | BIT6 | BIT7)
+
+//
+// The largest number of bytes an AVX worker handles with interrupts disabled.
+// It is a multiple of the non-temporal threshold of the workers, so long
+// copies and fills still use non-temporal stores.
+//
+#define MEM_LIB_VECTOR_CHUNK_SIZE  SIZE_4MB
+
+MEM_LIB_VECTOR_LEVEL  mMemLibVectorLevel = MemLibVectorSse2;
+
+/**
+  Detects the widest vector register set usable by the memory functions.
+
+  @return The vector level the InternalMem* functions should dispatch to.
+
+**/
+STATIC
+MEM_LIB_VECTOR_LEVEL
+InternalMemDetectVectorLevel (
+  VOID
+  )
+{
+  UINT32                                       MaxLeaf;
+  CPUID_VERSION_INFO_ECX                       VersionEcx;
+  CPUID_STRUCTURED_EXTENDED_FEATURE_FLAGS_EBX  ExtendedEbx;
+  UINT64                                       Xcr0;
+
+  AsmCpuid (CPUID_SIGNATURE, &MaxLeaf, NULL, NULL, NULL);
+  if (MaxLeaf < CPUID_STRUCTURED_EXTENDED_FEATURE_FLAGS) {
+    return MemLibVectorSse2;
+  }
+
+  AsmCpuid (CPUID_VERSION_INFO, NULL, NULL, &VersionEcx.Uint32, NULL);
+  if ((VersionEcx.Bits.OSXSAVE == 0) || (VersionEcx.Bits.AVX == 0)) {
+    return MemLibVectorSse2;
+  }
+
+  AsmCpuidEx (
+    CPUID_STRUCTURED_EXTENDED_FEATURE_FLAGS,
+    CPUID_STRUCTURED_EXTENDED_FEATURE_FLAGS_SUB_LEAF_INFO,
+    NULL,
+    &ExtendedEbx.Uint32,
+    NULL,
+    NULL
+    );
+  if (ExtendedEbx.Bits.AVX2 == 0) {
+    return MemLibVectorSse2;
+  }
+
+  Xcr0 = AsmXGetBv (0);
+  if ((Xcr0 & MEM_LIB_XCR0_AVX_STATE) != MEM_LIB_XCR0_AVX_STATE) {
+    return MemLibVectorSse2;
+  }
+
+  if ((ExtendedEbx.Bits.AVX512F != 0) &&
+      ((Xcr0 & MEM_LIB_XCR0_AVX512_STATE) == MEM_LIB_XCR0_AVX512_STATE))
+  {
+    return MemLibVectorAvx512;
+  }
+
+  return MemLibVectorAvx2;
+}
+
+/**
+  The constructor function selects the vector width of the memory functions.
+
+  @retval RETURN_SUCCESS   The constructor always returns RETURN_SUCCESS.
+
+**/
+RETURN_STATUS
+EFIAPI
+BaseMemoryLibAvxConstructor (
+  VOID
+  )
+{
+  mMemLibVectorLevel = InternalMemDetectVectorLevel ();
+  return RETURN_SUCCESS;
+}
+
+/**
+  Copy Length bytes from Source to Destination.
+
+  @param  DestinationBuffer The target of the copy request.
+  @param  SourceBuffer      The place to copy from.
+  @param  Length            The number of bytes to copy.
+
+  @return Destination
+
+**/
+VOID *
+EFIAPI
+InternalMemCopyMem (
+  OUT     VOID        *DestinationBuffer,
+  IN      CONST VOID  *SourceBuffer,
+  IN      UINTN       Length
+  )
+{
+  UINT8        *Destination;
+  CONST UINT8  *Source;
+  BOOLEAN      Backward;
+  BOOLEAN      InterruptState;
+  UINTN        Offset;
+  UINTN        ChunkOffset;
+  UINTN        ChunkSize;
+
+  if (mMemLibVectorLevel == MemLibVectorSse2) {
+    return InternalMemCopyMemSse2 (DestinationBuffer, SourceBuffer, Length);
+  }
+
+  //
+  // If Destination overlaps the end of Source, the chunks are copied from the
+  // last one down, so no chunk overwrites Source bytes not yet copied.
+  //
+  Destination = DestinationBuffer;
+  Source      = SourceBuffer;
+  Backward    = (BOOLEAN)((Destination > Source) && (Destination < Source + Length));
+
+  for (Offset = 0; Offset < Length; Offset += ChunkSize) {
+    ChunkSize   = MIN (Length - Offset, MEM_LIB_VECTOR_CHUNK_SIZE);
+    ChunkOffset = Offset;
+    if (Backward) {
+      ChunkOffset = Length - Offset - ChunkSize;
+    }
+
+    InterruptState = SaveAndDisableInterrupts ();
+    if (mMemLibVectorLevel == MemLibVectorAvx512) {
+      InternalMemCopyMemAvx512 (Destination + ChunkOffset, Source + ChunkOffset, ChunkSize);
+    } else {
+      InternalMemCopyMemAvx2 (Destination + ChunkOffset, Source + ChunkOffset, ChunkSize);
+    }
+
+    SetInterruptState (InterruptState);
+  }
+
+  return DestinationBuffer;
+}
+
+/**
+  Set Buffer to Value for Size bytes.
+
+  @param  Buffer   The memory to set.
+  @param  Length   The number of bytes to set.
+  @param  Value    The value of the set operation.
+
+  @return Buffer
+
+**/
+VOID *
+EFIAPI
+InternalMemSetMem (
+  OUT     VOID   *Buffer,
+  IN      UINTN  Length,
+  IN      UINT8  Value
+  )
+{
+  BOOLEAN  InterruptState;
+  UINTN    Offset;
+  UINTN    ChunkSize;
+
+  if (mMemLibVectorLevel == MemLibVectorSse2) {
+    return InternalMemSetMemSse2 (Buffer, Length, Value);
+  }
+
+  for (Offset = 0; Offset < Length; Offset += ChunkSize) {
+    ChunkSize = MIN (Length - Offset, MEM_LIB_VECTOR_CHUNK_SIZE);
+
+    InterruptState = SaveAndDisableInterrupts ();
+    if (mMemLibVectorLevel == MemLibVectorAvx512) {
+      InternalMemSetMemAvx512 ((UINT8 *)Buffer + Offset, ChunkSize, Value);
+    } else {
+      InternalMemSetMemAvx2 ((UINT8 *)Buffer + Offset, ChunkSize, Value);
+    }
+
+    SetInterruptState (InterruptState);
+  }
+
+  return Buffer;
+}
+
+/**
+  Set Buffer to 0 for Size bytes.
+
+  @param  Buffer Memory to set.
+  @param  Length The number of bytes to set
+
+  @return Buffer
+
+**/
+VOID *
+EFIAPI
+InternalMemZeroMem (
+  OUT     VOID   *Buffer,
+  IN      UINTN  Length
+  )
+{
+  if (mMemLibVectorLevel == MemLibVectorSse2) {
+    return InternalMemZeroMemSse2 (Buffer, Length);
+  }
+
+  return InternalMemSetMem (Buffer, Length, 0);
+}
+
+/**
+  Compares two memory buffers of a given length.
+
+  @param  DestinationBuffer The first memory buffer.
+  @param  SourceBuffer      The second memory buffer.
+  @param  Length            The length of DestinationBuffer and SourceBuffer memory
+                            regions to compare. Must be non-zero.
+
+  @return 0                 All Length bytes of the two buffers are identical.
+  @retval Non-zero          The first mismatched byte in SourceBuffer subtracted from the first
+                            mismatched byte in DestinationBuffer.
+
+**/
+INTN
+EFIAPI
+InternalMemCompareMem (
+  IN      CONST VOID  *DestinationBuffer,
+  IN      CONST VOID  *SourceBuffer,
+  IN      UINTN       Length
+  )
+{
+  BOOLEAN  InterruptState;
+  UINTN    Offset;
+  UINTN    ChunkSize;
+  INTN     Result;
+
+  if (mMemLibVectorLevel == MemLibVectorSse2) {
+    return InternalMemCompareMemSse2 (DestinationBuffer, SourceBuffer, Length);
+  }
+
+  for (Offset = 0; Offset < Length; Offset += ChunkSize) {
+    ChunkSize = MIN (Length - Offset, MEM_LIB_VECTOR_CHUNK_SIZE);
+
+    InterruptState = SaveAndDisableInterrupts ();
+    Result         = InternalMemCompareMemAvx2 (
+                       (CONST UINT8 *)DestinationBuffer + Offset,
+                       (CONST UINT8 *)SourceBuffer + Offset,
+                       ChunkSize
+                       );
+    SetInterruptState (InterruptState);
+
+    if (Result != 0) {
+      return Result;
+    }
+  }
+
+  return 0;
+}
+
+/**
+  Scans a target buffer for an 8-bit value, and returns a pointer to the
+  matching 8-bit value in the target buffer.
+
+  @param  Buffer  The pointer to the target buffer to scan.
+  @param  Length  The count of 8-bit value to scan. Must be non-zero.
+  @param  Value   The value to search for in the target buffer.
+
+  @return The pointer to the first occurrence or NULL if not found.
+
+**/
+CONST VOID *
+EFIAPI
+InternalMemScanMem8 (
+  IN      CONST VOID  *Buffer,
+  IN      UINTN       Length,
+  IN      UINT8       Value
+  )
+{
+  BOOLEAN     InterruptState;
+  UINTN       Offset;
+  UINTN       ChunkSize;
+  CONST VOID  *Result;
+
+  if (mMemLibVectorLevel == MemLibVectorSse2) {
+    return InternalMemScanMem8Sse2 (Buffer, Length, Value);
+  }
+
+  for (Offset = 0; Offset < Length; Offset += ChunkSize) {
+    ChunkSize = MIN (Length - Offset, MEM_LIB_VECTOR_CHUNK_SIZE);
+
+    InterruptState = SaveAndDisableInterrupts ();
+    Result         = InternalMemScanMem8Avx2 ((CONST UINT8 *)Buffer + Offset, ChunkSize, Value);
+    SetInterruptState (InterruptState);
+
+    if (Result != NULL) {
+      return Result;
+    }
+  }
+
+  return NULL;
+}
+
+/**
+  Checks whether the contents of a buffer are all zeros.
+
+  @param  Buffer  The pointer to the buffer to be checked.
+  @param  Length  The size of the buffer (in bytes) to be checked.
+
+  @retval TRUE    Contents of the buffer are all zeros.
+  @retval FALSE   Contents of the buffer are not all zeros.
+
+**/
+BOOLEAN
+EFIAPI
+InternalMemIsZeroBuffer (
+  IN CONST VOID  *Buffer,
+  IN UINTN       Length
+  )
+{
+  BOOLEAN  InterruptState;
+  UINTN    Offset;
+  UINTN    ChunkSize;
+  BOOLEAN  IsZero;
+
+  if (mMemLibVectorLevel == MemLibVectorSse2) {
+    return InternalMemIsZeroBufferSse2 (Buffer, Length);
+  }
+
+  for (Offset = 0; Offset < Length; Offset += ChunkSize) {
+    ChunkSize = MIN (Length - Offset, MEM_LIB_VECTOR_CHUNK_SIZE);
+
+    InterruptState = SaveAndDisableInterrupts ();
+    IsZero         = InternalMemIsZeroBufferAvx2 ((CONST UINT8 *)Buffer + Offset, ChunkSize);
+    SetInterruptState (InterruptState);
+
+    if (!IsZero) {
+      return FALSE;
+    }
+  }
+
+  return TRUE;
+}
@@ -6,9 +6,13 @@
 **/
 
 #include <gtest/gtest.h>
+#include <chrono>
+#include <cstdio>
+#include <vector>
 extern "C" {
   #include <Base.h>
   #include <Library/BaseLib.h>
+  #include <Library/UnitTestHostBaseLib.h>
 }
 
 // Precomputed crc32c and crc16-ansi for "hello" (without the null byte)
@@ -62,3 +66,189 @@ TEST (Crc16, MultipartCheck) {
   val = CalculateCrc16Ansi ("hel", 3, CRC16ANSI_INIT);
   EXPECT_EQ (CalculateCrc16Ansi (&"hello"[3], 2, val), mHelloCrc16);
 }
+
+// Bit-at-a-time CRC32 (ITU-T V.42) used as the reference for the table and
+// carry-less multiply engines behind CalculateCrc32.
+STATIC
+UINT32
+ReferenceCrc32 (
+  CONST UINT8  *Buffer,
+  UINTN        Length
+  )
+{
+  UINT32  Crc;
+  UINTN   Bit;
+
+  Crc = 0xFFFFFFFF;
+  while (Length-- > 0) {
+    Crc ^= *Buffer++;
+    for (Bit = 0; Bit < 8; Bit++) {
+      Crc = (Crc >> 1) ^ ((Crc & 1) != 0 ? 0xEDB88320 : 0);
+    }
+  }
+
+  return Crc ^ 0xFFFFFFFF;
+}
+
+STATIC
+std::vector<UINT8>
+PatternBuffer (
+  UINTN  Length
+  )
+{
+  std::vector<UINT8>  Buffer (Length);
+  UINT32              Seed;
+  UINTN               Index;
+
+  Seed = 0x12345678;
+  for (Index = 0; Index < Length; Index++) {
+    Seed          = Seed * 1103515245 + 12345;
+    Buffer[Index] = (UINT8)(Seed >> 16);
+  }
+
+  return Buffer;
+}
+
+// Checks every length up to a few KB at every 16-byte alignment, so the
+// unaligned head, the bulk and the tail of each engine are all covered,
+// plus a few buffers large enough for the bulk loops to run many times.
+STATIC
+VOID
+CheckCrc32AgainstReference (
+  VOID
+  )
+{
+  std::vector<UINT8>  Buffer;
+  UINTN               Length;
+  UINTN               Offset;
+
+  Buffer = PatternBuffer (SIZE_1MB + 16);
+  for (Length = 0; Length <= SIZE_4KB + 64; Length += (Length < 256) ? 1 : 61) {
+    for (Offset = 0; Offset < 16; Offset++) {
+      ASSERT_EQ (
+        CalculateCrc32 (&Buffer[Offset], Length),
+        ReferenceCrc32 (&Buffer[Offset], Length)
+        ) << "Length " << Length << " Offset " << Offset;
+    }
+  }
+
+  for (Length = SIZE_64KB - 1; Length <= SIZE_1MB; Length = Length * 4 + 7) {
+    EXPECT_EQ (CalculateCrc32 (&Buffer[3], Length), ReferenceCrc32 (&Buffer[3], Length));
+  }
+}
+
+TEST (Crc32, BasicCheck) {
+  // Check value from the CRC catalogue for CRC-32/ISO-HDLC
+  EXPECT_EQ (CalculateCrc32 ((VOID *)"123456789", 9), 0xCBF43926U);
+  EXPECT_EQ (CalculateCrc32 ((VOID *)"h", 1), 0x916B06E7U);
+
+  // Check if a checksum with no bytes correctly yields 0
+  EXPECT_EQ (CalculateCrc32 ((VOID *)"", 0), 0U);
+}
+
+TEST (Crc32, MatchesReference) {
+  CheckCrc32AgainstReference ();
+}
+
+#if defined (MDE_CPU_X64) && defined (__GNUC__)
+
+// Reports the host's PCLMULQDQ and SSE4.1 support through the mocked CPUID,
+// so CalculateCrc32 selects the carry-less multiply engine.
+STATIC
+UINT32
+EFIAPI
+Crc32HostAsmCpuid (
+  IN      UINT32  Index,
+  OUT     UINT32  *Eax   OPTIONAL,
+  OUT     UINT32  *Ebx   OPTIONAL,
+  OUT     UINT32  *Ecx   OPTIONAL,
+  OUT     UINT32  *Edx   OPTIONAL
+  )
+{
+  if (Eax != NULL) {
+    *Eax = 0;
+  }
+
+  if (Ebx != NULL) {
+    *Ebx = 0;
+  }
+
+  if (Ecx != NULL) {
+    *Ecx = (Index == 1) ? (BIT1 | BIT19) : 0;
+  }
+
+  if (Edx != NULL) {
+    *Edx = 0;
+  }
+
+  return Index;
+}
+
+TEST (Crc32, PclmulMatchesReference) {
+  UNIT_TEST_HOST_BASE_LIB_ASM_CPUID  SavedAsmCpuid;
+
+  if (!__builtin_cpu_supports ("pclmul") || !__builtin_cpu_supports ("sse4.1")) {
+    GTEST_SKIP () << "Host has no PCLMULQDQ";
+  }
+
+  SavedAsmCpuid                      = gUnitTestHostBaseLib.X86->AsmCpuid;
+  gUnitTestHostBaseLib.X86->AsmCpuid = Crc32HostAsmCpuid;
+  CheckCrc32AgainstReference ();
+  gUnitTestHostBaseLib.X86->AsmCpuid = SavedAsmCpuid;
+}
+
+#endif
+
+// Prints the throughput of CalculateCrc32 over 1 KB to 64 MB buffers.
+STATIC
+VOID
+MeasureCrc32Throughput (
+  CONST CHAR8  *Engine
+  )
+{
+  std::vector<UINT8>  Buffer;
+  UINTN               Length;
+  UINTN               Rounds;
+  UINTN               Index;
+  UINT32              Crc;
+
+  Buffer = PatternBuffer (SIZE_64MB);
+  for (Length = SIZE_1KB; Length <= SIZE_64MB; Length *= 4) {
+    Rounds = MAX (SIZE_256MB / Length, 1);
+    Crc    = 0;
+
+    auto  Start = std::chrono::steady_clock::now ();
+
+    for (Index = 0; Index < Rounds; Index++) {
+      Crc += CalculateCrc32 (Buffer.data (), Length);
+    }
+
+    std::chrono::duration<double>  Elapsed = std::chrono::steady_clock::now () - Start;
+
+    std::printf (
+      "CalculateCrc32 (%s) %10llu bytes: %8.1f MB/s (%08x)\n",
+      Engine,
+      (unsigned long long)Length,
+      (double)Length * Rounds / Elapsed.count () / 1e6,
+      Crc
+      );
+  }
+}
+
+// Disabled by default; run with
+// --gtest_also_run_disabled_tests --gtest_filter=Crc32.DISABLED_Throughput
+TEST (Crc32, DISABLED_Throughput) {
+  MeasureCrc32Throughput ("table");
+
+ #if defined (MDE_CPU_X64) && defined (__GNUC__)
+  UNIT_TEST_HOST_BASE_LIB_ASM_CPUID  SavedAsmCpuid;
+
+  if (__builtin_cpu_supports ("pclmul") && __builtin_cpu_supports ("sse4.1")) {
+    SavedAsmCpuid                      = gUnitTestHostBaseLib.X86->AsmCpuid;
+    gUnitTestHostBaseLib.X86->AsmCpuid = Crc32HostAsmCpuid;
+    MeasureCrc32Throughput ("pclmulqdq");
+    gUnitTestHostBaseLib.X86->AsmCpuid = SavedAsmCpuid;
+  }
+
+ #endif
+}
@@ -0,0 +1,565 @@
+/** @file
+  Unit tests and a throughput benchmark for the BaseMemoryLib instances.
+
+  The same tests are built against every BaseMemoryLib instance that can run
+  on the host, see MdePkgHostTest.dsc.
+
+  Copyright (c) 2026, Intel Corporation. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+**/
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+extern "C" {
+  #include <Base.h>
+  #include <Library/BaseMemoryLib.h>
+}
+
+#include "TestBaseMemoryLib.h"
+
+//
+// Bytes checked on either side of every destination range.
+//
+#define GUARD_SIZE  64
+
+//
+// Lengths above the small range, chosen around the loop strides of the
+// vector implementations and the 1 MB non-temporal threshold.
+//
+STATIC CONST UINTN  mLargeLengths[] = {
+  511,
+  512,
+  513,
+  SIZE_4KB - 1,
+  SIZE_4KB,
+  SIZE_4KB + 1,
+  SIZE_64KB + 13,
+  SIZE_1MB - 1,
+  SIZE_1MB,
+  SIZE_1MB + 37,
+  SIZE_2MB + 5
+};
+
+//
+// Every length up to SMALL_LENGTH_MAX is checked at every alignment.
+//
+#define SMALL_LENGTH_MAX  300
+#define MAX_TEST_LENGTH   (SIZE_2MB + 5)
+
+STATIC
+VOID
+FillPattern (
+  UINT8   *Buffer,
+  UINTN   Length,
+  UINT32  Seed
+  )
+{
+  UINTN  Index;
+
+  for (Index = 0; Index < Length; Index++) {
+    Seed          = Seed * 1103515245 + 12345;
+    Buffer[Index] = (UINT8)(Seed >> 16);
+  }
+}
+
+STATIC
+BOOLEAN
+IsFilledWith (
+  CONST UINT8  *Buffer,
+  UINTN        Length,
+  UINT8        Value
+  )
+{
+  while (Length-- > 0) {
+    if (*Buffer++ != Value) {
+      return FALSE;
+    }
+  }
+
+  return TRUE;
+}
+
+//
+// Calls Check (Length, Offset, Offset2) for every small length at a spread of
+// alignment pairs and for the large lengths at a few alignment pairs.
+//
+template<typename CHECK>
+STATIC
+VOID
+ForEachLengthAndAlignment (
+  CHECK  Check
+  )
+{
+  STATIC CONST UINTN  SmallOffsets[] = { 0, 1, 7, 31, 32, 63 };
+  STATIC CONST UINTN  LargeOffsets[][2] = {
+    { 0,  0  },
+    { 1,  3  },
+    { 32, 0  },
+    { 63, 17 }
+  };
+  UINTN               Length;
+  UINTN               Offset;
+  UINTN               Index;
+
+  for (Length = 0; Length <= SMALL_LENGTH_MAX; Length++) {
+    for (Offset = 0; Offset < 64; Offset++) {
+      for (Index = 0; Index < ARRAY_SIZE (SmallOffsets); Index++) {
+        Check (Length, Offset, SmallOffsets[Index]);
+        if (::testing::Test::HasFatalFailure ()) {
+          return;
+        }
+      }
+    }
+  }
+
+  for (Length = 0; Length < ARRAY_SIZE (mLargeLengths); Length++) {
+    for (Index = 0; Index < ARRAY_SIZE (LargeOffsets); Index++) {
+      Check (mLargeLengths[Length], LargeOffsets[Index][0], LargeOffsets[Index][1]);
+      if (::testing::Test::HasFatalFailure ()) {
+        return;
+      }
+    }
+  }
+}
+
+VOID
+CheckCopyMem (
+  VOID
+  )
+{
+  std::vector<UINT8>  Destination (MAX_TEST_LENGTH + 2 * GUARD_SIZE + 64);
+  std::vector<UINT8>  Source (MAX_TEST_LENGTH + 64);
+
+  FillPattern (Source.data (), Source.size (), 1);
+  std::memset (Destination.data (), 0xA5, Destination.size ());
+
+  ForEachLengthAndAlignment (
+    [&](UINTN Length, UINTN DestinationOffset, UINTN SourceOffset) {
+    UINT8  *Dest;
+    UINT8  *Src;
+
+    Dest = Destination.data () + GUARD_SIZE + DestinationOffset;
+    Src  = Source.data () + SourceOffset;
+    ASSERT_EQ (CopyMem (Dest, Src, Length), Dest);
+    ASSERT_EQ (std::memcmp (Dest, Src, Length), 0)
+      << "Length " << Length << " Offsets " << DestinationOffset << "/" << SourceOffset;
+    ASSERT_TRUE (IsFilledWith (Dest - GUARD_SIZE, GUARD_SIZE, 0xA5));
+    ASSERT_TRUE (IsFilledWith (Dest + Length, GUARD_SIZE, 0xA5));
+    std::memset (Dest, 0xA5, Length);
+  }
+    );
+}
+
+VOID
+CheckCopyMemOverlap (
+  VOID
+  )
+{
+  STATIC CONST INTN   Distances[] = { -300, -64, -33, -32, -31, -1, 1, 31, 32, 33, 64, 300 };
+  STATIC CONST UINTN  Lengths[]   = { 1, 2, 15, 16, 33, 64, 100, 255, 256, 1000, SIZE_64KB + 7, SIZE_1MB + 37, SIZE_2MB + 5 };
+  std::vector<UINT8>  Buffer (MAX_TEST_LENGTH + 1024);
+  std::vector<UINT8>  Expected (MAX_TEST_LENGTH + 1024);
+  UINTN               LengthIndex;
+  UINTN               Index;
+  UINTN               Length;
+  UINT8               *Src;
+  UINT8               *Dest;
+
+  for (LengthIndex = 0; LengthIndex < ARRAY_SIZE (Lengths); LengthIndex++) {
+    Length = Lengths[LengthIndex];
+    for (Index = 0; Index < ARRAY_SIZE (Distances); Index++) {
+      FillPattern (Buffer.data (), Length + 1024, (UINT32)Index);
+      std::memcpy (Expected.data (), Buffer.data (), Length + 1024);
+
+      Src  = Buffer.data () + 400;
+      Dest = Src + Distances[Index];
+      std::memmove (Expected.data () + 400 + Distances[Index], Expected.data () + 400, Length);
+      ASSERT_EQ (CopyMem (Dest, Src, Length), Dest);
+      ASSERT_EQ (std::memcmp (Buffer.data (), Expected.data (), Length + 1024), 0)
+        << "Length " << Length << " Distance " << Distances[Index];
+    }
+  }
+}
+
+VOID
+CheckSetMem (
+  VOID
+  )
+{
+  std::vector<UINT8>  Buffer (MAX_TEST_LENGTH + 2 * GUARD_SIZE + 64, 0xA5);
+
+  ForEachLengthAndAlignment (
+    [&](UINTN Length, UINTN Offset, UINTN ValueIndex) {
+    UINT8  *Dest;
+    UINT8  Value;
+
+    Dest  = Buffer.data () + GUARD_SIZE + Offset;
+    Value = (UINT8)(0x11 * (ValueIndex + 1));
+    ASSERT_EQ (SetMem (Dest, Length, Value), Dest);
+    ASSERT_TRUE (IsFilledWith (Dest, Length, Value))
+      << "Length " << Length << " Offset " << Offset;
+    ASSERT_TRUE (IsFilledWith (Dest - GUARD_SIZE, GUARD_SIZE, 0xA5));
+    ASSERT_TRUE (IsFilledWith (Dest + Length, GUARD_SIZE, 0xA5));
+    std::memset (Dest, 0xA5, Length);
+  }
+    );
+}
+
+VOID
+CheckZeroMem (
+  VOID
+  )
+{
+  std::vector<UINT8>  Buffer (MAX_TEST_LENGTH + 2 * GUARD_SIZE + 64, 0xA5);
+
+  ForEachLengthAndAlignment (
+    [&](UINTN Length, UINTN Offset, UINTN Unused) {
+    UINT8  *Dest;
+
+    if (Unused != 0) {
+      return;
+    }
+
+    Dest = Buffer.data () + GUARD_SIZE + Offset;
+    ASSERT_EQ (ZeroMem (Dest, Length), Dest);
+    ASSERT_TRUE (IsFilledWith (Dest, Length, 0))
+      << "Length " << Length << " Offset " << Offset;
+    ASSERT_TRUE (IsFilledWith (Dest - GUARD_SIZE, GUARD_SIZE, 0xA5));
+    ASSERT_TRUE (IsFilledWith (Dest + Length, GUARD_SIZE, 0xA5));
+    std::memset (Dest, 0xA5, Length);
+  }
+    );
+}
+
+VOID
+CheckSetMemN (
+  VOID
+  )
+{
+  std::vector<UINT8>  Buffer (MAX_TEST_LENGTH + 2 * GUARD_SIZE + 64, 0xA5);
+
+  ForEachLengthAndAlignment (
+    [&](UINTN Length, UINTN Offset, UINTN Unused) {
+    UINT8   *Dest;
+    UINTN   Index;
+    UINT16  Value16;
+    UINT32  Value32;
+    UINT64  Value64;
+
+    if (Unused != 0) {
+      return;
+    }
+
+    Dest = Buffer.data () + GUARD_SIZE + (Offset & ~(UINTN)7);
+
+    ASSERT_EQ (SetMem16 (Dest, Length & ~(UINTN)1, 0x1234), Dest);
+    for (Index = 0; Index < (Length & ~(UINTN)1); Index += sizeof (Value16)) {
+      std::memcpy (&Value16, Dest + Index, sizeof (Value16));
+      ASSERT_EQ (Value16, 0x1234) << "Length " << Length;
+    }
+
+    ASSERT_TRUE (IsFilledWith (Dest + (Length & ~(UINTN)1), GUARD_SIZE, 0xA5));
+
+    ASSERT_EQ (SetMem32 (Dest, Length & ~(UINTN)3, 0x89ABCDEF), Dest);
+    for (Index = 0; Index < (Length & ~(UINTN)3); Index += sizeof (Value32)) {
+      std::memcpy (&Value32, Dest + Index, sizeof (Value32));
+      ASSERT_EQ (Value32, 0x89ABCDEFU) << "Length " << Length;
+    }
+
+    ASSERT_EQ (SetMem64 (Dest, Length & ~(UINTN)7, 0x0123456789ABCDEFULL), Dest);
+    for (Index = 0; Index < (Length & ~(UINTN)7); Index += sizeof (Value64)) {
+      std::memcpy (&Value64, Dest + Index, sizeof (Value64));
+      ASSERT_EQ (Value64, 0x0123456789ABCDEFULL) << "Length " << Length;
+    }
+
+    ASSERT_TRUE (IsFilledWith (Dest - GUARD_SIZE, GUARD_SIZE, 0xA5));
+    std::memset (Dest, 0xA5, Length + GUARD_SIZE);
+  }
+    );
+}
+
+VOID
+CheckCompareMem (
+  VOID
+  )
+{
+  std::vector<UINT8>  Destination (MAX_TEST_LENGTH + 64);
+  std::vector<UINT8>  Source (MAX_TEST_LENGTH + 64);
+
+  FillPattern (Source.data (), Source.size (), 2);
+
+  ForEachLengthAndAlignment (
+    [&](UINTN Length, UINTN DestinationOffset, UINTN SourceOffset) {
+    UINT8        *Dest;
+    UINT8        *Src;
+    CONST UINTN  Positions[] = { 0, 1, 15, 31, 32, 63, 64, Length / 2, Length - 1 };
+    UINTN        Index;
+    UINTN        Position;
+    UINT8        Saved;
+
+    if (Length == 0) {
+      return;
+    }
+
+    Dest = Destination.data () + DestinationOffset;
+    Src  = Source.data () + SourceOffset;
+    std::memcpy (Dest, Src, Length);
+    ASSERT_EQ (CompareMem (Dest, Src, Length), 0)
+      << "Length " << Length << " Offsets " << DestinationOffset << "/" << SourceOffset;
+
+    for (Index = 0; Index < ARRAY_SIZE (Positions); Index++) {
+      Position = Positions[Index];
+      if (Position >= Length) {
+        continue;
+      }
+
+      //
+      // A later mismatch must not hide the first one.
+      //
+      if (Length - 1 > Position) {
+        Dest[Length - 1] ^= 0xFF;
+      }
+
+      Saved          = Dest[Position];
+      Dest[Position] = (UINT8)(Src[Position] + 0x40);
+      ASSERT_EQ (CompareMem (Dest, Src, Length), (INTN)Dest[Position] - (INTN)Src[Position])
+        << "Length " << Length << " Position " << Position;
+      Dest[Position] = (UINT8)(Src[Position] - 0x40);
+      ASSERT_EQ (CompareMem (Dest, Src, Length), (INTN)Dest[Position] - (INTN)Src[Position])
+        << "Length " << Length << " Position " << Position;
+      Dest[Position] = Saved;
+      if (Length - 1 > Position) {
+        Dest[Length - 1] ^= 0xFF;
+      }
+    }
+  }
+    );
+}
+
+VOID
+CheckScanMem (
+  VOID
+  )
+{
+  std::vector<UINT8>  Buffer (MAX_TEST_LENGTH + 64, 0xA5);
+
+  ForEachLengthAndAlignment (
+    [&](UINTN Length, UINTN Offset, UINTN Position) {
+    UINT8   *Scan;
+    UINT16  Value16;
+    UINT32  Value32;
+    UINT64  Value64;
+    UINTN   Aligned;
+
+    if (Length == 0) {
+      return;
+    }
+
+    Scan     = Buffer.data () + Offset;
+    Position = (Position * 5 + Length / 3) % Length;
+    ASSERT_EQ (ScanMem8 (Scan, Length, 0x5A), (VOID *)NULL) << "Length " << Length;
+    Scan[Position] = 0x5A;
+    if (Position + 1 < Length) {
+      Scan[Length - 1] = 0x5A;
+    }
+
+    ASSERT_EQ (ScanMem8 (Scan, Length, 0x5A), (VOID *)(Scan + Position))
+      << "Length " << Length << " Offset " << Offset << " Position " << Position;
+    Scan[Position]   = 0xA5;
+    Scan[Length - 1] = 0xA5;
+
+    //
+    // The wider scans need naturally aligned buffers and whole elements.
+    //
+    Scan    = Buffer.data () + (Offset & ~(UINTN)7);
+    Aligned = Length & ~(UINTN)7;
+    if (Aligned == 0) {
+      return;
+    }
+
+    Position = (Position % Aligned) & ~(UINTN)7;
+    Value16  = 0x5A5A;
+    Value32  = 0x5A5A5A5A;
+    Value64  = 0x5A5A5A5A5A5A5A5AULL;
+    ASSERT_EQ (ScanMem16 (Scan, Aligned, Value16), (VOID *)NULL);
+    ASSERT_EQ (ScanMem32 (Scan, Aligned, Value32), (VOID *)NULL);
+    ASSERT_EQ (ScanMem64 (Scan, Aligned, Value64), (VOID *)NULL);
+    std::memcpy (Scan + Position, &Value64, sizeof (Value64));
+    ASSERT_EQ (ScanMem16 (Scan, Aligned, Value16), (VOID *)(Scan + Position));
+    ASSERT_EQ (ScanMem32 (Scan, Aligned, Value32), (VOID *)(Scan + Position));
+    ASSERT_EQ (ScanMem64 (Scan, Aligned, Value64), (VOID *)(Scan + Position));
+    std::memset (Scan + Position, 0xA5, sizeof (Value64));
+  }
+    );
+}
+
+VOID
+CheckIsZeroBuffer (
+  VOID
+  )
+{
+  std::vector<UINT8>  Buffer (MAX_TEST_LENGTH + 64, 0);
+
+  ForEachLengthAndAlignment (
+    [&](UINTN Length, UINTN Offset, UINTN Position) {
+    UINT8  *Check;
+
+    //
+    // IsZeroBuffer () asserts on a zero Length.
+    //
+    if (Length == 0) {
+      return;
+    }
+
+    Check = Buffer.data () + Offset;
+    ASSERT_TRUE (IsZeroBuffer (Check, Length)) << "Length " << Length;
+
+    Position        = (Position * 5 + Length / 3) % Length;
+    Check[Position] = 1;
+    ASSERT_FALSE (IsZeroBuffer (Check, Length))
+      << "Length " << Length << " Offset " << Offset << " Position " << Position;
+    Check[Position] = 0;
+  }
+    );
+}
+
+TEST (BaseMemoryLib, CopyMem) {
+  CheckCopyMem ();
+}
+
+TEST (BaseMemoryLib, CopyMemOverlap) {
+  CheckCopyMemOverlap ();
+}
+
+TEST (BaseMemoryLib, SetMem) {
+  CheckSetMem ();
+}
+
+TEST (BaseMemoryLib, ZeroMem) {
+  CheckZeroMem ();
+}
+
+TEST (BaseMemoryLib, SetMemN) {
+  CheckSetMemN ();
+}
+
+TEST (BaseMemoryLib, CompareMem) {
+  CheckCompareMem ();
+}
+
+TEST (BaseMemoryLib, ScanMem) {
+  CheckScanMem ();
+}
+
+TEST (BaseMemoryLib, IsZeroBuffer) {
+  CheckIsZeroBuffer ();
+}
+
+typedef enum {
+  BenchmarkCopyMem,
+  BenchmarkSetMem,
+  BenchmarkZeroMem,
+  BenchmarkCompareMem,
+  BenchmarkScanMem8,
+  BenchmarkIsZeroBuffer,
+  BenchmarkMax
+} BENCHMARK_OPERATION;
+
+STATIC CONST CHAR8  *mBenchmarkNames[BenchmarkMax] = {
+  "CopyMem",
+  "SetMem",
+  "ZeroMem",
+  "CompareMem",
+  "ScanMem8",
+  "IsZeroBuffer"
+};
+
+//
+// Prints the throughput of each operation by size class, once with 64-byte
+// aligned buffers and once with the destination and source misaligned.
+//
+VOID
+MeasureBaseMemoryLibThroughput (
+  CONST CHAR8  *Instance
+  )
+{
+  STATIC CONST UINTN  SizeClasses[] = { 16, 64, 256, SIZE_1KB, SIZE_4KB, SIZE_64KB, SIZE_1MB, SIZE_16MB };
+  std::vector<UINT8>  DestinationBuffer (SIZE_16MB + 128);
+  std::vector<UINT8>  SourceBuffer (SIZE_16MB + 128);
+  UINT8               *Dest;
+  UINT8               *Src;
+  UINTN               Operation;
+  UINTN               SizeIndex;
+  UINTN               Misaligned;
+  UINTN               Length;
+  UINTN               Rounds;
+  UINTN               Index;
+  UINTN               Sink;
+
+  for (Operation = 0; Operation < BenchmarkMax; Operation++) {
+    for (Misaligned = 0; Misaligned < 2; Misaligned++) {
+      Dest = (UINT8 *)ALIGN_POINTER (DestinationBuffer.data (), 64) + Misaligned;
+      Src  = (UINT8 *)ALIGN_POINTER (SourceBuffer.data (), 64) + 3 * Misaligned;
+      std::memset (Dest, 0, SIZE_16MB);
+      std::memset (Src, 0, SIZE_16MB);
+
+      for (SizeIndex = 0; SizeIndex < ARRAY_SIZE (SizeClasses); SizeIndex++) {
+        Length = SizeClasses[SizeIndex];
+        Rounds = MAX (SIZE_256MB / Length, 16);
+        Rounds = MIN (Rounds, 4000000);
+        Sink   = 0;
+
+        auto  Start = std::chrono::steady_clock::now ();
+
+        for (Index = 0; Index < Rounds; Index++) {
+          switch (Operation) {
+            case BenchmarkCopyMem:
+              Sink += (UINTN)CopyMem (Dest, Src, Length);
+              break;
+            case BenchmarkSetMem:
+              Sink += (UINTN)SetMem (Dest, Length, 0x5A);
+              break;
+            case BenchmarkZeroMem:
+              Sink += (UINTN)ZeroMem (Dest, Length);
+              break;
+            case BenchmarkCompareMem:
+              Sink += (UINTN)CompareMem (Dest, Src, Length);
+              break;
+            case BenchmarkScanMem8:
+              Sink += (UINTN)ScanMem8 (Src, Length, 0x5A);
+              break;
+            default:
+              Sink += IsZeroBuffer (Src, Length);
+              break;
+          }
+        }
+
+        std::chrono::duration<double>  Elapsed = std::chrono::steady_clock::now () - Start;
+
+        std::printf (
+          "%-20s %-12s %-9s %9llu bytes: %9.1f MB/s (%llx)\n",
+          Instance,
+          mBenchmarkNames[Operation],
+          (Misaligned != 0) ? "unaligned" : "aligned",
+          (unsigned long long)Length,
+          (double)Length * Rounds / Elapsed.count () / 1e6,
+          (unsigned long long)(Sink & 0xF)
+          );
+      }
+    }
+  }
+}
+
+// Disabled by default; run with
+// --gtest_also_run_disabled_tests --gtest_filter=BaseMemoryLib.DISABLED_Throughput
+// The instance is identified by the FILE_GUID of its test module, see
+// MdePkgHostTest.dsc.
+TEST (BaseMemoryLib, DISABLED_Throughput) {
+  CHAR8  Instance[16];
+
+  std::snprintf (Instance, sizeof (Instance), "%08X", gEfiCallerIdGuid.Data1);
+  MeasureBaseMemoryLibThroughput (Instance);
+}
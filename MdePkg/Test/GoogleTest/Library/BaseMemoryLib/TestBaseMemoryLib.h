@@ -0,0 +1,59 @@
+/** @file
+  Checks shared by the BaseMemoryLib google tests.
+
+  Each check compares one BaseMemoryLib function against a byte-wise
+  reference over a range of lengths and buffer alignments.
+
+  Copyright (c) 2026, Intel Corporation. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+**/
+
+#ifndef TEST_BASE_MEMORY_LIB_H_
+#define TEST_BASE_MEMORY_LIB_H_
+
+VOID
+CheckCopyMem (
+  VOID
+  );
+
+VOID
+CheckCopyMemOverlap (
+  VOID
+  );
+
+VOID
+CheckSetMem (
+  VOID
+  );
+
+VOID
+CheckZeroMem (
+  VOID
+  );
+
+VOID
+CheckSetMemN (
+  VOID
+  );
+
+VOID
+CheckCompareMem (
+  VOID
+  );
+
+VOID
+CheckScanMem (
+  VOID
+  );
+
+VOID
+CheckIsZeroBuffer (
+  VOID
+  );
+
+VOID
+MeasureBaseMemoryLibThroughput (
+  CONST CHAR8  *Instance
+  );
+
+#endif
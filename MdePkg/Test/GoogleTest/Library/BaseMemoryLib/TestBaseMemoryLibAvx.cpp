@@ -0,0 +1,244 @@
+/** @file
+  Unit tests for the vector width selection of BaseMemoryLibAvx.
+
+  The host CPUID is passed through the UnitTestHostBaseLib mock with the
+  AVX-512 or AVX feature bits optionally hidden, so the library constructor
+  selects each of its SSE2, AVX2 and AVX-512 paths in turn and the shared
+  BaseMemoryLib checks run against every path the host supports.
+
+  Copyright (c) 2026, Intel Corporation. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+**/
+
+#include <gtest/gtest.h>
+#include <cstring>
+#include <vector>
+#if defined (__GNUC__)
+  #include <cpuid.h>
+#endif
+extern "C" {
+  #include <Base.h>
+  #include <Library/BaseLib.h>
+  #include <Library/BaseMemoryLib.h>
+  #include <Library/UnitTestHostBaseLib.h>
+  #include <Register/Intel/Cpuid.h>
+
+  RETURN_STATUS
+  EFIAPI
+  BaseMemoryLibAvxConstructor (
+    VOID
+    );
+}
+
+#include "TestBaseMemoryLib.h"
+
+#if defined (MDE_CPU_X64) && defined (__GNUC__)
+
+typedef enum {
+  VectorLevelSse2,
+  VectorLevelAvx2,
+  VectorLevelAvx512
+} VECTOR_LEVEL;
+
+//
+// Widest vector level the mocked CPUID reports.
+//
+STATIC VECTOR_LEVEL  mReportedLevel;
+
+STATIC
+UINT32
+EFIAPI
+HostAsmCpuidEx (
+  IN      UINT32  Index,
+  IN      UINT32  SubIndex,
+  OUT     UINT32  *Eax   OPTIONAL,
+  OUT     UINT32  *Ebx   OPTIONAL,
+  OUT     UINT32  *Ecx   OPTIONAL,
+  OUT     UINT32  *Edx   OPTIONAL
+  )
+{
+  CPUID_VERSION_INFO_ECX                       VersionEcx;
+  CPUID_STRUCTURED_EXTENDED_FEATURE_FLAGS_EBX  ExtendedEbx;
+  UINT32                                       Registers[4];
+
+  __cpuid_count (Index, SubIndex, Registers[0], Registers[1], Registers[2], Registers[3]);
+
+  if (Index == CPUID_VERSION_INFO) {
+    VersionEcx.Uint32 = Registers[2];
+    if (mReportedLevel == VectorLevelSse2) {
+      VersionEcx.Bits.AVX = 0;
+    }
+
+    Registers[2] = VersionEcx.Uint32;
+  } else if ((Index == CPUID_STRUCTURED_EXTENDED_FEATURE_FLAGS) &&
+             (SubIndex == CPUID_STRUCTURED_EXTENDED_FEATURE_FLAGS_SUB_LEAF_INFO))
+  {
+    ExtendedEbx.Uint32 = Registers[1];
+    if (mReportedLevel != VectorLevelAvx512) {
+      ExtendedEbx.Bits.AVX512F = 0;
+    }
+
+    if (mReportedLevel == VectorLevelSse2) {
+      ExtendedEbx.Bits.AVX2 = 0;
+    }
+
+    Registers[1] = ExtendedEbx.Uint32;
+  }
+
+  if (Eax != NULL) {
+    *Eax = Registers[0];
+  }
+
+  if (Ebx != NULL) {
+    *Ebx = Registers[1];
+  }
+
+  if (Ecx != NULL) {
+    *Ecx = Registers[2];
+  }
+
+  if (Edx != NULL) {
+    *Edx = Registers[3];
+  }
+
+  return Index;
+}
+
+STATIC
+UINT32
+EFIAPI
+HostAsmCpuid (
+  IN      UINT32  Index,
+  OUT     UINT32  *Eax   OPTIONAL,
+  OUT     UINT32  *Ebx   OPTIONAL,
+  OUT     UINT32  *Ecx   OPTIONAL,
+  OUT     UINT32  *Edx   OPTIONAL
+  )
+{
+  return HostAsmCpuidEx (Index, 0, Eax, Ebx, Ecx, Edx);
+}
+
+//
+// Runs the library constructor against the host CPUID limited to a vector
+// level, and restores the SSE2 selection of the default CPUID mock after
+// the test.
+//
+class BaseMemoryLibAvxTest : public ::testing::TestWithParam<VECTOR_LEVEL> {
+protected:
+  UNIT_TEST_HOST_BASE_LIB_ASM_CPUID SavedAsmCpuid;
+  UNIT_TEST_HOST_BASE_LIB_ASM_CPUID_EX SavedAsmCpuidEx;
+
+  void
+  SetUp (
+    ) override
+  {
+    if ((GetParam () == VectorLevelAvx2) && !__builtin_cpu_supports ("avx2")) {
+      GTEST_SKIP () << "Host has no AVX2";
+    }
+
+    if ((GetParam () == VectorLevelAvx512) && !__builtin_cpu_supports ("avx512f")) {
+      GTEST_SKIP () << "Host has no AVX-512";
+    }
+
+    SavedAsmCpuid                        = gUnitTestHostBaseLib.X86->AsmCpuid;
+    SavedAsmCpuidEx                      = gUnitTestHostBaseLib.X86->AsmCpuidEx;
+    gUnitTestHostBaseLib.X86->AsmCpuid   = HostAsmCpuid;
+    gUnitTestHostBaseLib.X86->AsmCpuidEx = HostAsmCpuidEx;
+    mReportedLevel                       = GetParam ();
+    ASSERT_EQ (BaseMemoryLibAvxConstructor (), RETURN_SUCCESS);
+  }
+
+  void
+  TearDown (
+    ) override
+  {
+    if (IsSkipped ()) {
+      return;
+    }
+
+    gUnitTestHostBaseLib.X86->AsmCpuid   = SavedAsmCpuid;
+    gUnitTestHostBaseLib.X86->AsmCpuidEx = SavedAsmCpuidEx;
+    BaseMemoryLibAvxConstructor ();
+  }
+};
+
+TEST_P (BaseMemoryLibAvxTest, CopyMem) {
+  CheckCopyMem ();
+  CheckCopyMemOverlap ();
+}
+
+TEST_P (BaseMemoryLibAvxTest, SetMem) {
+  CheckSetMem ();
+  CheckZeroMem ();
+  CheckSetMemN ();
+}
+
+TEST_P (BaseMemoryLibAvxTest, CompareMem) {
+  CheckCompareMem ();
+}
+
+TEST_P (BaseMemoryLibAvxTest, ScanMem) {
+  CheckScanMem ();
+  CheckIsZeroBuffer ();
+}
+
+//
+// Buffers larger than the chunk the AVX workers handle with interrupts
+// disabled, with Destination on either side of an overlapping Source and the
+// difference in the last chunk.
+//
+TEST_P (BaseMemoryLibAvxTest, LargeBuffers) {
+  CONST UINTN         Length = SIZE_8MB + SIZE_1MB + 7;
+  CONST UINTN         Shift  = 3 * SIZE_1MB + 5;
+  std::vector<UINT8>  Buffer (Length + Shift);
+  std::vector<UINT8>  Expected (Length + Shift);
+  UINTN               Index;
+
+  EnableInterrupts ();
+
+  for (Index = 0; Index < Buffer.size (); Index++) {
+    Buffer[Index] = (UINT8)(Index * 7 + (Index >> 12));
+  }
+
+  Expected = Buffer;
+  memmove (&Expected[0], &Expected[Shift], Length);
+  CopyMem (&Buffer[0], &Buffer[Shift], Length);
+  EXPECT_TRUE (Buffer == Expected);
+
+  Expected = Buffer;
+  memmove (&Expected[Shift], &Expected[0], Length);
+  CopyMem (&Buffer[Shift], &Buffer[0], Length);
+  EXPECT_TRUE (Buffer == Expected);
+
+  SetMem (&Buffer[1], Length, 0x5A);
+  memset (&Expected[1], 0x5A, Length);
+  EXPECT_TRUE (Buffer == Expected);
+  EXPECT_EQ (CompareMem (&Buffer[1], &Expected[1], Length), 0);
+
+  Buffer[Length - 2] = 0x5B;
+  EXPECT_GT (CompareMem (&Buffer[1], &Expected[1], Length), 0);
+  EXPECT_EQ (ScanMem8 (&Buffer[1], Length, 0x5B), &Buffer[Length - 2]);
+
+  ZeroMem (&Buffer[1], Length);
+  EXPECT_TRUE (IsZeroBuffer (&Buffer[1], Length));
+  Buffer[Length] = 1;
+  EXPECT_FALSE (IsZeroBuffer (&Buffer[1], Length));
+
+  EXPECT_TRUE (GetInterruptState ());
+}
+
+// Disabled by default; run with --gtest_also_run_disabled_tests
+// --gtest_filter=*/BaseMemoryLibAvxTest.DISABLED_Throughput/*
+TEST_P (BaseMemoryLibAvxTest, DISABLED_Throughput) {
+  STATIC CONST CHAR8  *Names[] = { "Avx (sse2)", "Avx (avx2)", "Avx (avx512)" };
+
+  MeasureBaseMemoryLibThroughput (Names[GetParam ()]);
+}
+
+INSTANTIATE_TEST_SUITE_P (
+  VectorLevels,
+  BaseMemoryLibAvxTest,
+  ::testing::Values (VectorLevelSse2, VectorLevelAvx2, VectorLevelAvx512)
+  );
+
+#endif
@@ -597,25 +597,32 @@ HttpBootHttpIoCallback (
 }
 
 /**
-  Create a HttpIo instance for the file download.
+  Create and configure a HttpIo instance on the HTTP Boot controller.
 
   @param[in]    Private        The pointer to the driver's private data.
+  @param[in]    Callback       Callback function which will be invoked when specified
+                               HTTP_IO_CALLBACK_EVENT happened, may be NULL.
+  @param[in]    Context        The Context data which will be passed to the Callback function.
+  @param[out]   HttpIo         The HttpIo instance to create.
 
   @retval EFI_SUCCESS          Successfully created.
   @retval Others               Failed to create HttpIo.
 
 **/
 EFI_STATUS
-HttpBootCreateHttpIo (
-  IN     HTTP_BOOT_PRIVATE_DATA  *Private
+HttpBootCreateHttpIoInstance (
+  IN     HTTP_BOOT_PRIVATE_DATA  *Private,
+  IN     HTTP_IO_CALLBACK        Callback  OPTIONAL,
+  IN     VOID                    *Context  OPTIONAL,
+  OUT    HTTP_IO                 *HttpIo
   )
 {
   HTTP_IO_CONFIG_DATA  ConfigData;
-  EFI_STATUS           Status;
   EFI_HANDLE           ImageHandle;
   UINT32               TimeoutValue;
 
   ASSERT (Private != NULL);
+  ASSERT (HttpIo != NULL);
 
   //
   // Get HTTP timeout value
@@ -636,11 +643,37 @@ HttpBootCreateHttpIo (
     ImageHandle = Private->Ip6Nic->ImageHandle;
   }
 
-  Status = HttpIoCreateIo (
-             ImageHandle,
-             Private->Controller,
-             Private->UsingIpv6 ? IP_VERSION_6 : IP_VERSION_4,
-             &ConfigData,
+  return HttpIoCreateIo (
+           ImageHandle,
+           Private->Controller,
+           Private->UsingIpv6 ? IP_VERSION_6 : IP_VERSION_4,
+           &ConfigData,
+           Callback,
+           Context,
+           HttpIo
+           );
+}
+
+/**
+  Create a HttpIo instance for the file download.
+
+  @param[in]    Private        The pointer to the driver's private data.
+
+  @retval EFI_SUCCESS          Successfully created.
+  @retval Others               Failed to create HttpIo.
+
+**/
+EFI_STATUS
+HttpBootCreateHttpIo (
+  IN     HTTP_BOOT_PRIVATE_DATA  *Private
+  )
+{
+  EFI_STATUS  Status;
+
+  ASSERT (Private != NULL);
+
+  Status = HttpBootCreateHttpIoInstance (
+             Private,
              HttpBootHttpIoCallback,
              (VOID *)Private,
              &Private->HttpIo
@@ -1543,6 +1576,20 @@ HttpBootGetBootFile (
     Private->LastModifiedOrEtag = AllocateCopyPool (AsciiStrSize (HttpHeader->FieldValue), HttpHeader->FieldValue);
   }
 
+  //
+  // Record whether the server accepts byte range requests for this file,
+  // the boot file could then be downloaded over parallel connections.
+  //
+  if (HeaderOnly) {
+    HttpHeader = HttpFindHeader (
+                   ResponseData->HeaderCount,
+                   ResponseData->Headers,
+                   HTTP_HEADER_ACCEPT_RANGES
+                   );
+    Private->AcceptRanges = (BOOLEAN)((HttpHeader != NULL) &&
+                                      (AsciiStriCmp (HttpHeader->FieldValue, "bytes") == 0));
+  }
+
   //
   // 3.2.2 Validate the range response. If operation is being resumed,
   // server must respond with Content-Range.
@@ -72,6 +72,27 @@ HttpBootDiscoverBootInfo (
   IN OUT HTTP_BOOT_PRIVATE_DATA  *Private
   );
 
+/**
+  Create and configure a HttpIo instance on the HTTP Boot controller.
+
+  @param[in]    Private        The pointer to the driver's private data.
+  @param[in]    Callback       Callback function which will be invoked when specified
+                               HTTP_IO_CALLBACK_EVENT happened, may be NULL.
+  @param[in]    Context        The Context data which will be passed to the Callback function.
+  @param[out]   HttpIo         The HttpIo instance to create.
+
+  @retval EFI_SUCCESS          Successfully created.
+  @retval Others               Failed to create HttpIo.
+
+**/
+EFI_STATUS
+HttpBootCreateHttpIoInstance (
+  IN     HTTP_BOOT_PRIVATE_DATA  *Private,
+  IN     HTTP_IO_CALLBACK        Callback  OPTIONAL,
+  IN     VOID                    *Context  OPTIONAL,
+  OUT    HTTP_IO                 *HttpIo
+  );
+
 /**
   Create a HttpIo instance for the file download.
 
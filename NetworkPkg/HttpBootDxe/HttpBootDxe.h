@@ -108,6 +108,7 @@ typedef enum  {
 #include "HttpBootImpl.h"
 #include "HttpBootSupport.h"
 #include "HttpBootClient.h"
+#include "HttpBootRange.h"
 #include "HttpBootConfig.h"
 
 typedef union {
@@ -216,6 +217,7 @@ struct _HTTP_BOOT_PRIVATE_DATA {
   UINTN                                        BootFileSize;
   UINTN                                        PartialTransferredSize;
   CHAR8                                        *LastModifiedOrEtag;
+  BOOLEAN                                      AcceptRanges;
   BOOLEAN                                      NoGateway;
   HTTP_BOOT_IMAGE_TYPE                         ImageType;
 
@@ -394,6 +394,19 @@ HttpBootGetBootFileCaller (
           return Status;
         }
 
+        //
+        // Try to load the boot file into Buffer over parallel range requests first,
+        // fall back to the single connection download if that is not possible.
+        //
+        Status = HttpBootGetBootFileRanged (Private, BufferSize, Buffer, ImageType);
+        if (!EFI_ERROR (Status)) {
+          return Status;
+        }
+
+        if (Status != EFI_UNSUPPORTED) {
+          DEBUG ((DEBUG_WARN | DEBUG_INFO, "HttpBootGetBootFileCaller: Ranged download failed - %r, fall back to single connection.\n", Status));
+        }
+
         //
         // Load the boot file into Buffer
         //
@@ -584,6 +597,7 @@ HttpBootStop (
   Private->SelectIndex            = 0;
   Private->SelectProxyType        = HttpOfferTypeMax;
   Private->PartialTransferredSize = 0;
+  Private->AcceptRanges           = FALSE;
 
   if (!Private->UsingIpv6) {
     //
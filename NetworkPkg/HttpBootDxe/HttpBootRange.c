@@ -0,0 +1,674 @@
+/** @file
+  Implementation of the parallel ranged boot file download.
+
+  The boot file is split into segments which are requested with HTTP Range
+  headers over several HTTP children at the same time. Each child asks for
+  the next free segment as soon as it has finished the previous one, so a
+  slow connection does not hold back the whole download. The message-body
+  of every segment is received directly into its place in the caller's
+  buffer.
+
+Copyright (c) 2026, Intel Corporation. All rights reserved.<BR>
+SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include "HttpBootDxe.h"
+
+/**
+  Count the elapsed time of the ranged download.
+
+  @param[in]  Event                 The event signaled.
+  @param[in]  Context               The HTTP_BOOT_RANGE_DOWNLOAD.
+
+**/
+STATIC
+VOID
+EFIAPI
+HttpBootRangeTick (
+  IN EFI_EVENT  Event,
+  IN VOID       *Context
+  )
+{
+  ((HTTP_BOOT_RANGE_DOWNLOAD *)Context)->Ticks++;
+}
+
+/**
+  Build the request headers which are common to all the range requests
+  of a connection. The Range header is added per request.
+
+  @param[in]       Private         The pointer to the driver's private data.
+  @param[in, out]  Conn            The connection to build the headers for.
+
+  @retval EFI_SUCCESS              The headers are built.
+  @retval EFI_UNSUPPORTED          The authentication scheme is not supported.
+  @retval EFI_OUT_OF_RESOURCES     Could not allocate needed resources.
+  @retval Others                   Unexpected error happened.
+
+**/
+STATIC
+EFI_STATUS
+HttpBootRangeBuildHeader (
+  IN     HTTP_BOOT_PRIVATE_DATA      *Private,
+  IN OUT HTTP_BOOT_RANGE_CONNECTION  *Conn
+  )
+{
+  EFI_STATUS  Status;
+  CHAR8       *HostName;
+  CHAR8       BaseAuthValue[80];
+
+  Conn->RequestHeader = HttpIoCreateHeader (HTTP_BOOT_RANGE_HEADER_COUNT);
+  if (Conn->RequestHeader == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  HostName = NULL;
+  Status   = HttpUrlGetHostName (
+               Private->BootFileUri,
+               Private->BootFileUriParser,
+               &HostName
+               );
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  Status = HttpIoSetHeader (Conn->RequestHeader, HTTP_HEADER_HOST, HostName);
+  FreePool (HostName);
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  Status = HttpIoSetHeader (Conn->RequestHeader, HTTP_HEADER_ACCEPT, "*/*");
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  Status = HttpIoSetHeader (Conn->RequestHeader, HTTP_HEADER_USER_AGENT, HTTP_USER_AGENT_EFI_HTTP_BOOT);
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  if (Private->AuthData != NULL) {
+    if ((Private->AuthScheme != NULL) && (CompareMem (Private->AuthScheme, "Basic", 5) != 0)) {
+      return EFI_UNSUPPORTED;
+    }
+
+    AsciiSPrint (BaseAuthValue, sizeof (BaseAuthValue), "%a %a", "Basic", Private->AuthData);
+    Status = HttpIoSetHeader (Conn->RequestHeader, HTTP_HEADER_AUTHORIZATION, BaseAuthValue);
+    if (EFI_ERROR (Status)) {
+      return Status;
+    }
+  }
+
+  //
+  // Make sure all the ranges come from the same entity the HEAD request has seen.
+  //
+  if (Private->LastModifiedOrEtag != NULL) {
+    if (Private->LastModifiedOrEtag[0] == '"') {
+      Status = HttpIoSetHeader (Conn->RequestHeader, HTTP_HEADER_IF_MATCH, Private->LastModifiedOrEtag);
+    } else {
+      Status = HttpIoSetHeader (Conn->RequestHeader, HTTP_HEADER_IF_UNMODIFIED_SINCE, Private->LastModifiedOrEtag);
+    }
+  }
+
+  return Status;
+}
+
+/**
+  Check the response header of a range request matches the requested range.
+
+  @param[in]  Download             The ranged download.
+  @param[in]  Conn                 The connection which received the response.
+
+  @retval EFI_SUCCESS              The server returned the requested range.
+  @retval EFI_UNSUPPORTED          The server did not return the requested range.
+  @retval Others                   The HTTP response reported an error.
+
+**/
+STATIC
+EFI_STATUS
+HttpBootRangeCheckResponse (
+  IN HTTP_BOOT_RANGE_DOWNLOAD    *Download,
+  IN HTTP_BOOT_RANGE_CONNECTION  *Conn
+  )
+{
+  EFI_HTTP_MESSAGE  *Message;
+  EFI_HTTP_HEADER   *HttpHeader;
+  CHAR8             *Value;
+
+  if (EFI_ERROR (Conn->HttpIo.RspToken.Status)) {
+    return Conn->HttpIo.RspToken.Status;
+  }
+
+  if (Conn->ResponseData.StatusCode != HTTP_STATUS_206_PARTIAL_CONTENT) {
+    return EFI_UNSUPPORTED;
+  }
+
+  //
+  // The message-body is received directly into the buffer, so only the
+  // identity transfer-coding with the exact length of the range is accepted.
+  //
+  Message    = Conn->HttpIo.RspToken.Message;
+  HttpHeader = HttpFindHeader (Message->HeaderCount, Message->Headers, HTTP_HEADER_CONTENT_LENGTH);
+  if ((HttpHeader == NULL) ||
+      (AsciiStrDecimalToUintn (HttpHeader->FieldValue) != Conn->End - Conn->Start + 1))
+  {
+    return EFI_UNSUPPORTED;
+  }
+
+  //
+  // Content-Range: bytes <range-start>-<range-end>/<size>
+  //
+  HttpHeader = HttpFindHeader (Message->HeaderCount, Message->Headers, HTTP_HEADER_CONTENT_RANGE);
+  if ((HttpHeader == NULL) || (AsciiStrnCmp (HttpHeader->FieldValue, "bytes ", 6) != 0)) {
+    return EFI_UNSUPPORTED;
+  }
+
+  Value = HttpHeader->FieldValue + 6;
+  if (AsciiStrDecimalToUintn (Value) != Conn->Start) {
+    return EFI_UNSUPPORTED;
+  }
+
+  Value = AsciiStrStr (Value, "-");
+  if ((Value == NULL) || (AsciiStrDecimalToUintn (Value + 1) != Conn->End)) {
+    return EFI_UNSUPPORTED;
+  }
+
+  Value = AsciiStrStr (Value, "/");
+  if ((Value == NULL) || (AsciiStrDecimalToUintn (Value + 1) != Download->FileSize)) {
+    return EFI_UNSUPPORTED;
+  }
+
+  return EFI_SUCCESS;
+}
+
+/**
+  Queue a response token on a connection, either for the response header or
+  for the rest of the message-body of the current range.
+
+  @param[in]       Download        The ranged download.
+  @param[in, out]  Conn            The connection to receive on.
+
+  @retval EFI_SUCCESS              The response token is queued.
+  @retval Others                   Failed to queue the response token.
+
+**/
+STATIC
+EFI_STATUS
+HttpBootRangeRecv (
+  IN     HTTP_BOOT_RANGE_DOWNLOAD    *Download,
+  IN OUT HTTP_BOOT_RANGE_CONNECTION  *Conn
+  )
+{
+  EFI_STATUS  Status;
+  HTTP_IO     *HttpIo;
+
+  HttpIo                  = &Conn->HttpIo;
+  HttpIo->RspToken.Status = EFI_NOT_READY;
+  if (Conn->State == HttpBootRangeRecvHeader) {
+    HttpIo->RspToken.Message->Data.Response = &Conn->ResponseData;
+    HttpIo->RspToken.Message->BodyLength    = 0;
+    HttpIo->RspToken.Message->Body          = NULL;
+  } else {
+    HttpIo->RspToken.Message->Data.Response = NULL;
+    HttpIo->RspToken.Message->BodyLength    = Conn->End - Conn->Start + 1 - Conn->ReceivedSize;
+    HttpIo->RspToken.Message->Body          = Download->Buffer + Conn->Start + Conn->ReceivedSize;
+  }
+
+  HttpIo->RspToken.Message->HeaderCount = 0;
+  HttpIo->RspToken.Message->Headers     = NULL;
+  HttpIo->IsRxDone                      = FALSE;
+
+  Status = gBS->SetTimer (HttpIo->TimeoutEvent, TimerRelative, HttpIo->Timeout * TICKS_PER_MS);
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  Status = HttpIo->Http->Response (HttpIo->Http, &HttpIo->RspToken);
+  if (EFI_ERROR (Status)) {
+    gBS->SetTimer (HttpIo->TimeoutEvent, TimerCancel, 0);
+  }
+
+  return Status;
+}
+
+/**
+  Request the next free segment of the boot file on a connection. The
+  connection is done if there is no segment left.
+
+  @param[in, out]  Download        The ranged download.
+  @param[in, out]  Conn            The connection to send the request on.
+
+  @retval EFI_SUCCESS              The request is queued or the connection is done.
+  @retval Others                   Failed to queue the request.
+
+**/
+STATIC
+EFI_STATUS
+HttpBootRangeRequestNext (
+  IN OUT HTTP_BOOT_RANGE_DOWNLOAD    *Download,
+  IN OUT HTTP_BOOT_RANGE_CONNECTION  *Conn
+  )
+{
+  EFI_STATUS              Status;
+  HTTP_IO                 *HttpIo;
+  HTTP_BOOT_PRIVATE_DATA  *Private;
+  CHAR8                   RangeValue[64];
+
+  if (Download->NextOffset >= Download->FileSize) {
+    Conn->State        = HttpBootRangeDone;
+    Conn->ElapsedTicks = Download->Ticks;
+    return EFI_SUCCESS;
+  }
+
+  Conn->Start          = Download->NextOffset;
+  Conn->End            = MIN (Download->NextOffset + Download->SegmentSize, Download->FileSize) - 1;
+  Conn->ReceivedSize   = 0;
+  Download->NextOffset = Conn->End + 1;
+
+  AsciiSPrint (RangeValue, sizeof (RangeValue), "bytes=%lu-%lu", (UINT64)Conn->Start, (UINT64)Conn->End);
+  Status = HttpIoSetHeader (Conn->RequestHeader, "Range", RangeValue);
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  HttpIo                                 = &Conn->HttpIo;
+  HttpIo->ReqToken.Status                = EFI_NOT_READY;
+  HttpIo->ReqToken.Message->Data.Request = &Conn->RequestData;
+  HttpIo->ReqToken.Message->HeaderCount  = Conn->RequestHeader->HeaderCount;
+  HttpIo->ReqToken.Message->Headers      = Conn->RequestHeader->Headers;
+  HttpIo->ReqToken.Message->BodyLength   = 0;
+  HttpIo->ReqToken.Message->Body         = NULL;
+
+  //
+  // Report the download only once to the HTTP Boot callback.
+  //
+  Private = Download->Private;
+  if (!Download->RequestNotified && (Private->HttpBootCallback != NULL)) {
+    Status = Private->HttpBootCallback->Callback (
+                                          Private->HttpBootCallback,
+                                          HttpBootHttpRequest,
+                                          FALSE,
+                                          sizeof (EFI_HTTP_MESSAGE),
+                                          (VOID *)HttpIo->ReqToken.Message
+                                          );
+    if (EFI_ERROR (Status)) {
+      return Status;
+    }
+
+    Download->RequestNotified = TRUE;
+  }
+
+  HttpIo->IsTxDone = FALSE;
+  Status           = HttpIo->Http->Request (HttpIo->Http, &HttpIo->ReqToken);
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  Conn->State = HttpBootRangeSendRequest;
+  Conn->Segments++;
+  return EFI_SUCCESS;
+}
+
+/**
+  Advance a connection once its pending token has completed.
+
+  @param[in, out]  Download        The ranged download.
+  @param[in, out]  Conn            The connection to process.
+
+  @retval EFI_SUCCESS              The connection is still in progress or done.
+  @retval EFI_TIMEOUT              No response was received in time.
+  @retval EFI_UNSUPPORTED          The server did not return the requested range.
+  @retval Others                   Unexpected error happened.
+
+**/
+STATIC
+EFI_STATUS
+HttpBootRangeProcess (
+  IN OUT HTTP_BOOT_RANGE_DOWNLOAD    *Download,
+  IN OUT HTTP_BOOT_RANGE_CONNECTION  *Conn
+  )
+{
+  EFI_STATUS              Status;
+  HTTP_IO                 *HttpIo;
+  EFI_HTTP_MESSAGE        *Message;
+  HTTP_BOOT_PRIVATE_DATA  *Private;
+
+  HttpIo  = &Conn->HttpIo;
+  Message = HttpIo->RspToken.Message;
+
+  switch (Conn->State) {
+    case HttpBootRangeSendRequest:
+      if (!HttpIo->IsTxDone) {
+        return EFI_SUCCESS;
+      }
+
+      if (EFI_ERROR (HttpIo->ReqToken.Status)) {
+        return HttpIo->ReqToken.Status;
+      }
+
+      Conn->State = HttpBootRangeRecvHeader;
+      return HttpBootRangeRecv (Download, Conn);
+
+    case HttpBootRangeRecvHeader:
+    case HttpBootRangeRecvBody:
+      if (!HttpIo->IsRxDone) {
+        if (!EFI_ERROR (gBS->CheckEvent (HttpIo->TimeoutEvent))) {
+          HttpIo->Http->Cancel (HttpIo->Http, &HttpIo->RspToken);
+          return EFI_TIMEOUT;
+        }
+
+        return EFI_SUCCESS;
+      }
+
+      gBS->SetTimer (HttpIo->TimeoutEvent, TimerCancel, 0);
+      HttpIo->IsRxDone = FALSE;
+
+      if (Conn->State == HttpBootRangeRecvHeader) {
+        Status = HttpBootRangeCheckResponse (Download, Conn);
+        if (Message->Headers != NULL) {
+          HttpFreeHeaderFields (Message->Headers, Message->HeaderCount);
+          Message->Headers     = NULL;
+          Message->HeaderCount = 0;
+        }
+
+        if (EFI_ERROR (Status)) {
+          DEBUG (
+            (DEBUG_WARN | DEBUG_INFO,
+             "HttpBootRangeProcess: Connection %d, range %lu-%lu rejected - %r, status code %d.\n",
+             Conn->Index,
+             (UINT64)Conn->Start,
+             (UINT64)Conn->End,
+             Status,
+             Conn->ResponseData.StatusCode)
+            );
+          return Status;
+        }
+
+        Conn->State = HttpBootRangeRecvBody;
+        return HttpBootRangeRecv (Download, Conn);
+      }
+
+      if (EFI_ERROR (HttpIo->RspToken.Status)) {
+        return HttpIo->RspToken.Status;
+      }
+
+      Private = Download->Private;
+      if ((Private->HttpBootCallback != NULL) && (Message->BodyLength != 0)) {
+        Status = Private->HttpBootCallback->Callback (
+                                              Private->HttpBootCallback,
+                                              HttpBootHttpEntityBody,
+                                              TRUE,
+                                              (UINT32)Message->BodyLength,
+                                              Message->Body
+                                              );
+        if (EFI_ERROR (Status)) {
+          return Status;
+        }
+      }
+
+      Conn->ReceivedSize     += Message->BodyLength;
+      Conn->TotalBytes       += Message->BodyLength;
+      Download->ReceivedSize += Message->BodyLength;
+
+      if (Conn->ReceivedSize < Conn->End - Conn->Start + 1) {
+        return HttpBootRangeRecv (Download, Conn);
+      }
+
+      //
+      // The range is complete, the connection is kept alive for the next one.
+      //
+      return HttpBootRangeRequestNext (Download, Conn);
+
+    default:
+      return EFI_SUCCESS;
+  }
+}
+
+/**
+  Print the throughput of the ranged download and of each connection.
+
+  @param[in]  Download             The completed ranged download.
+
+**/
+STATIC
+VOID
+HttpBootRangePrintStatistics (
+  IN HTTP_BOOT_RANGE_DOWNLOAD  *Download
+  )
+{
+  HTTP_BOOT_RANGE_CONNECTION  *Conn;
+  UINT32                      Index;
+  UINT64                      ElapsedMs;
+  UINT32                      Remainder;
+
+  ElapsedMs = MultU64x32 (Download->Ticks, HTTP_BOOT_RANGE_TICK_MS);
+  if (ElapsedMs == 0) {
+    ElapsedMs = HTTP_BOOT_RANGE_TICK_MS;
+  }
+
+  Print (
+    L"\n  Downloaded %lu Bytes in %lu.%03d s over %d connections, %lu KB/s\n",
+    (UINT64)Download->ReceivedSize,
+    DivU64x32Remainder (ElapsedMs, 1000, &Remainder),
+    Remainder,
+    Download->ConnectionCount,
+    DivU64x64Remainder (MultU64x32 (Download->ReceivedSize, 1000), MultU64x32 (ElapsedMs, 1024), NULL)
+    );
+
+  for (Index = 0; Index < Download->ConnectionCount; Index++) {
+    Conn      = &Download->Connection[Index];
+    ElapsedMs = MultU64x32 (Conn->ElapsedTicks, HTTP_BOOT_RANGE_TICK_MS);
+    if (ElapsedMs == 0) {
+      ElapsedMs = HTTP_BOOT_RANGE_TICK_MS;
+    }
+
+    Print (
+      L"    Connection %d: %lu Bytes in %d ranges, %lu.%03d s, %lu KB/s\n",
+      Index,
+      (UINT64)Conn->TotalBytes,
+      Conn->Segments,
+      DivU64x32Remainder (ElapsedMs, 1000, &Remainder),
+      Remainder,
+      DivU64x64Remainder (MultU64x32 (Conn->TotalBytes, 1000), MultU64x32 (ElapsedMs, 1024), NULL)
+      );
+  }
+}
+
+/**
+  Download the boot file as concurrent byte range requests over multiple
+  HTTP children, directly into the caller provided buffer.
+
+  The ranged download is only attempted if PcdHttpBootRangedConnections asks
+  for more than one connection, the HEAD request has reported the file size
+  and "Accept-Ranges: bytes", no proxy is in use and no interrupted download
+  is pending.
+
+  @param[in]       Private         The pointer to the driver's private data.
+  @param[in, out]  BufferSize      On input the size of Buffer in bytes. On output with a return
+                                   code of EFI_SUCCESS, the amount of data transferred to Buffer.
+  @param[out]      Buffer          The memory buffer to transfer the file to.
+  @param[out]      ImageType       The image type of the downloaded file.
+
+  @retval EFI_SUCCESS              The file was loaded.
+  @retval EFI_UNSUPPORTED          The ranged download is disabled or not applicable.
+  @retval EFI_OUT_OF_RESOURCES     Could not allocate needed resources.
+  @retval Others                   The download failed, the content of Buffer is undefined.
+
+**/
+EFI_STATUS
+HttpBootGetBootFileRanged (
+  IN     HTTP_BOOT_PRIVATE_DATA  *Private,
+  IN OUT UINTN                   *BufferSize,
+  OUT UINT8                      *Buffer,
+  OUT HTTP_BOOT_IMAGE_TYPE       *ImageType
+  )
+{
+  EFI_STATUS                  Status;
+  HTTP_BOOT_RANGE_DOWNLOAD    *Download;
+  HTTP_BOOT_RANGE_CONNECTION  *Conn;
+  UINT32                      ConnectionCount;
+  UINT32                      Index;
+  UINT32                      Active;
+  UINTN                       UrlSize;
+
+  ASSERT (Private != NULL);
+  ASSERT (BufferSize != NULL);
+  ASSERT (ImageType != NULL);
+
+  ConnectionCount = PcdGet8 (PcdHttpBootRangedConnections);
+  if ((ConnectionCount < 2) ||
+      !Private->AcceptRanges ||
+      (Private->ProxyUri != NULL) ||
+      (Private->PartialTransferredSize != 0) ||
+      (Private->BootFileSize == 0) ||
+      (*BufferSize < Private->BootFileSize) ||
+      (Buffer == NULL))
+  {
+    return EFI_UNSUPPORTED;
+  }
+
+  //
+  // Don't open more connections than there are minimum sized segments.
+  //
+  ConnectionCount = MIN (ConnectionCount, HTTP_BOOT_RANGE_MAX_CONNECTIONS);
+  if (ConnectionCount > (Private->BootFileSize + HTTP_BOOT_RANGE_MIN_SEGMENT_SIZE - 1) / HTTP_BOOT_RANGE_MIN_SEGMENT_SIZE) {
+    ConnectionCount = (UINT32)((Private->BootFileSize + HTTP_BOOT_RANGE_MIN_SEGMENT_SIZE - 1) / HTTP_BOOT_RANGE_MIN_SEGMENT_SIZE);
+  }
+
+  if (ConnectionCount < 2) {
+    return EFI_UNSUPPORTED;
+  }
+
+  Download = AllocateZeroPool (sizeof (HTTP_BOOT_RANGE_DOWNLOAD));
+  if (Download == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  Download->Private         = Private;
+  Download->Buffer          = Buffer;
+  Download->FileSize        = Private->BootFileSize;
+  Download->ConnectionCount = ConnectionCount;
+  Download->SegmentSize     = Download->FileSize / (ConnectionCount * HTTP_BOOT_RANGE_SEGMENTS_PER_CONNECTION) + 1;
+  Download->SegmentSize     = MAX (Download->SegmentSize, HTTP_BOOT_RANGE_MIN_SEGMENT_SIZE);
+
+  UrlSize       = AsciiStrSize (Private->BootFileUri);
+  Download->Url = AllocatePool (UrlSize * sizeof (CHAR16));
+  if (Download->Url == NULL) {
+    Status = EFI_OUT_OF_RESOURCES;
+    goto ON_EXIT;
+  }
+
+  AsciiStrToUnicodeStrS (Private->BootFileUri, Download->Url, UrlSize);
+
+  Status = gBS->CreateEvent (
+                  EVT_TIMER | EVT_NOTIFY_SIGNAL,
+                  TPL_CALLBACK,
+                  HttpBootRangeTick,
+                  Download,
+                  &Download->TickTimer
+                  );
+  if (EFI_ERROR (Status)) {
+    goto ON_EXIT;
+  }
+
+  //
+  // Create and configure one HTTP child per connection.
+  //
+  for (Index = 0; Index < ConnectionCount; Index++) {
+    Conn                     = &Download->Connection[Index];
+    Conn->Index              = Index;
+    Conn->RequestData.Method = HttpMethodGet;
+    Conn->RequestData.Url    = Download->Url;
+
+    Status = HttpBootCreateHttpIoInstance (Private, NULL, NULL, &Conn->HttpIo);
+    if (EFI_ERROR (Status)) {
+      goto ON_EXIT;
+    }
+
+    Conn->HttpCreated = TRUE;
+    Status            = HttpBootRangeBuildHeader (Private, Conn);
+    if (EFI_ERROR (Status)) {
+      goto ON_EXIT;
+    }
+  }
+
+  Status = gBS->SetTimer (Download->TickTimer, TimerPeriodic, HTTP_BOOT_RANGE_TICK_MS * TICKS_PER_MS);
+  if (EFI_ERROR (Status)) {
+    goto ON_EXIT;
+  }
+
+  for (Index = 0; Index < ConnectionCount; Index++) {
+    Status = HttpBootRangeRequestNext (Download, &Download->Connection[Index]);
+    if (EFI_ERROR (Status)) {
+      goto ON_EXIT;
+    }
+  }
+
+  //
+  // Poll all the connections until every segment is received.
+  //
+  do {
+    Active = 0;
+    for (Index = 0; Index < ConnectionCount; Index++) {
+      Conn = &Download->Connection[Index];
+      if (Conn->State == HttpBootRangeDone) {
+        continue;
+      }
+
+      Conn->HttpIo.Http->Poll (Conn->HttpIo.Http);
+      Status = HttpBootRangeProcess (Download, Conn);
+      if (EFI_ERROR (Status)) {
+        goto ON_EXIT;
+      }
+
+      if (Conn->State != HttpBootRangeDone) {
+        Active++;
+      }
+    }
+  } while (Active != 0);
+
+  gBS->SetTimer (Download->TickTimer, TimerCancel, 0);
+  ASSERT (Download->ReceivedSize == Download->FileSize);
+
+  HttpBootRangePrintStatistics (Download);
+
+  *BufferSize = Download->FileSize;
+  *ImageType  = Private->ImageType;
+  Status      = EFI_SUCCESS;
+
+ON_EXIT:
+  if (Download->TickTimer != NULL) {
+    gBS->CloseEvent (Download->TickTimer);
+  }
+
+  for (Index = 0; Index < ConnectionCount; Index++) {
+    Conn = &Download->Connection[Index];
+    if (Conn->HttpCreated) {
+      if (Conn->State != HttpBootRangeDone) {
+        Conn->HttpIo.Http->Cancel (Conn->HttpIo.Http, NULL);
+        if (Conn->HttpIo.RspToken.Message->Headers != NULL) {
+          HttpFreeHeaderFields (Conn->HttpIo.RspToken.Message->Headers, Conn->HttpIo.RspToken.Message->HeaderCount);
+        }
+      }
+
+      HttpIoDestroyIo (&Conn->HttpIo);
+    }
+
+    if (Conn->RequestHeader != NULL) {
+      HttpIoFreeHeader (Conn->RequestHeader);
+    }
+  }
+
+  //
+  // Flush the token notifications which still refer to the connections.
+  //
+  DispatchDpc ();
+
+  if (Download->Url != NULL) {
+    FreePool (Download->Url);
+  }
+
+  FreePool (Download);
+  return Status;
+}
@@ -0,0 +1,99 @@
+/** @file
+  Declaration of the parallel ranged boot file download.
+
+Copyright (c) 2026, Intel Corporation. All rights reserved.<BR>
+SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#ifndef __EFI_HTTP_BOOT_RANGE_H__
+#define __EFI_HTTP_BOOT_RANGE_H__
+
+#define HTTP_BOOT_RANGE_MAX_CONNECTIONS          16
+#define HTTP_BOOT_RANGE_MIN_SEGMENT_SIZE         SIZE_1MB
+#define HTTP_BOOT_RANGE_SEGMENTS_PER_CONNECTION  4
+#define HTTP_BOOT_RANGE_TICK_MS                  10
+#define HTTP_BOOT_RANGE_HEADER_COUNT             6
+
+typedef enum {
+  HttpBootRangeIdle,
+  HttpBootRangeSendRequest,
+  HttpBootRangeRecvHeader,
+  HttpBootRangeRecvBody,
+  HttpBootRangeDone
+} HTTP_BOOT_RANGE_STATE;
+
+//
+// One HTTP child downloading byte ranges of the boot file.
+//
+typedef struct {
+  UINT32                    Index;
+  HTTP_IO                   HttpIo;
+  BOOLEAN                   HttpCreated;
+  HTTP_IO_HEADER            *RequestHeader;
+  EFI_HTTP_REQUEST_DATA     RequestData;
+  EFI_HTTP_RESPONSE_DATA    ResponseData;
+  HTTP_BOOT_RANGE_STATE     State;
+
+  //
+  // The range in progress, End is inclusive.
+  //
+  UINTN                     Start;
+  UINTN                     End;
+  UINTN                     ReceivedSize;
+
+  //
+  // Statistics
+  //
+  UINTN                     TotalBytes;
+  UINT32                    Segments;
+  UINT64                    ElapsedTicks;
+} HTTP_BOOT_RANGE_CONNECTION;
+
+typedef struct {
+  HTTP_BOOT_PRIVATE_DATA        *Private;
+  UINT8                         *Buffer;
+  UINTN                         FileSize;
+  UINTN                         SegmentSize;
+  UINTN                         NextOffset;
+  UINTN                         ReceivedSize;
+  CHAR16                        *Url;
+  BOOLEAN                       RequestNotified;
+
+  EFI_EVENT                     TickTimer;
+  UINT64                        Ticks;
+
+  UINT32                        ConnectionCount;
+  HTTP_BOOT_RANGE_CONNECTION    Connection[HTTP_BOOT_RANGE_MAX_CONNECTIONS];
+} HTTP_BOOT_RANGE_DOWNLOAD;
+
+/**
+  Download the boot file as concurrent byte range requests over multiple
+  HTTP children, directly into the caller provided buffer.
+
+  The ranged download is only attempted if PcdHttpBootRangedConnections asks
+  for more than one connection, the HEAD request has reported the file size
+  and "Accept-Ranges: bytes", no proxy is in use and no interrupted download
+  is pending.
+
+  @param[in]       Private         The pointer to the driver's private data.
+  @param[in, out]  BufferSize      On input the size of Buffer in bytes. On output with a return
+                                   code of EFI_SUCCESS, the amount of data transferred to Buffer.
+  @param[out]      Buffer          The memory buffer to transfer the file to.
+  @param[out]      ImageType       The image type of the downloaded file.
+
+  @retval EFI_SUCCESS              The file was loaded.
+  @retval EFI_UNSUPPORTED          The ranged download is disabled or not applicable.
+  @retval EFI_OUT_OF_RESOURCES     Could not allocate needed resources.
+  @retval Others                   The download failed, the content of Buffer is undefined.
+
+**/
+EFI_STATUS
+HttpBootGetBootFileRanged (
+  IN     HTTP_BOOT_PRIVATE_DATA  *Private,
+  IN OUT UINTN                   *BufferSize,
+  OUT UINT8                      *Buffer,
+  OUT HTTP_BOOT_IMAGE_TYPE       *ImageType
+  );
+
+#endif
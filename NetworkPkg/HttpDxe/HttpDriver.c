@@ -67,6 +67,7 @@ HttpCreateService (
   HttpService->ControllerHandle            = Controller;
   HttpService->ChildrenNumber              = 0;
   InitializeListHead (&HttpService->ChildrenList);
+  InitializeListHead (&HttpService->IdleConnectionList);
 
   *ServiceData = HttpService;
   return EFI_SUCCESS;
@@ -90,6 +91,8 @@ HttpCleanService (
     return;
   }
 
+  HttpFlushIdleConnections (HttpService, UsingIpv6);
+
   if (!UsingIpv6) {
     if (HttpService->Tcp4ChildHandle != NULL) {
       gBS->CloseProtocol (
@@ -376,12 +379,14 @@ HttpDxeStart (
     ASSERT (HttpService != NULL);
 
     //
-    // Install the HttpServiceBinding Protocol onto Controller
+    // Install the HttpServiceBinding Protocol and the connection statistics onto Controller
     //
     Status = gBS->InstallMultipleProtocolInterfaces (
                     &ControllerHandle,
                     &gEfiHttpServiceBindingProtocolGuid,
                     &HttpService->ServiceBinding,
+                    &gEdkiiHttpConnectionStatisticsProtocolGuid,
+                    &HttpService->Statistics,
                     NULL
                     );
 
@@ -469,6 +474,8 @@ ON_ERROR:
                     &ControllerHandle,
                     &gEfiHttpServiceBindingProtocolGuid,
                     &HttpService->ServiceBinding,
+                    &gEdkiiHttpConnectionStatisticsProtocolGuid,
+                    &HttpService->Statistics,
                     NULL
                     );
     if (!EFI_ERROR (Status)) {
@@ -562,10 +569,13 @@ HttpDxeStop (
       HttpCleanService (HttpService, UsingIpv6);
 
       if ((HttpService->Tcp4ChildHandle == NULL) && (HttpService->Tcp6ChildHandle == NULL)) {
-        gBS->UninstallProtocolInterface (
+        gBS->UninstallMultipleProtocolInterfaces (
                NicHandle,
                &gEfiHttpServiceBindingProtocolGuid,
-               ServiceBinding
+               ServiceBinding,
+               &gEdkiiHttpConnectionStatisticsProtocolGuid,
+               &HttpService->Statistics,
+               NULL
                );
         FreePool (HttpService);
       }
@@ -1042,6 +1052,10 @@ HttpServiceBindingDestroyChild (
     return Status;
   }
 
+  //
+  // Keep a reusable connection open for later children before cleaning up.
+  //
+  HttpParkConnection (HttpInstance);
   HttpCleanProtocol (HttpInstance);
 
   OldTpl = gBS->RaiseTPL (TPL_CALLBACK);
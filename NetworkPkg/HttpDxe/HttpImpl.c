@@ -511,6 +511,9 @@ EfiHttpRequest (
         // If Https protocol used, the corresponding SessionState is EfiTlsSessionDataTransferring.
         // Check whether previous TCP packet sent out.
         //
+        if (NetMapGetCount (&HttpInstance->TxTokens) != 0) {
+          HttpInstance->Service->Statistics.PipelinedRequests++;
+        }
 
         if (EFI_ERROR (NetMapIterate (&HttpInstance->TxTokens, HttpTcpNotReady, NULL))) {
           //
@@ -565,6 +568,20 @@ EfiHttpRequest (
     }
   }
 
+  if (Configure && !ReConfigure && !HttpInstance->UseHttps && (Request->Method != HttpMethodConnect)) {
+    //
+    // First request of this HTTP child, reuse the idle connection to the same
+    // host left behind by a destroyed child if there is one. HTTPS children
+    // look for one in HttpInitSession () once their TLS session is configured.
+    //
+    if (!EFI_ERROR (HttpAdoptConnection (HttpInstance, HostName, RemotePort))) {
+      HttpInstance->RemotePort = RemotePort;
+      HttpInstance->RemoteHost = HostName;
+      HostName                 = NULL;
+      Configure                = FALSE;
+    }
+  }
+
   if (Configure) {
     //
     // Parse Url for IPv4 or IPv6 address, if failed, perform DNS resolution.
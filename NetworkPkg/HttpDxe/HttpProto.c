@@ -944,6 +944,676 @@ HttpCleanProtocol (
   TlsCloseTxRxEvent (HttpInstance);
 }
 
+/**
+  Close the connection of an idle connection entry and release it.
+
+  @param[in]  HttpService        The HTTP service owning the entry.
+  @param[in]  Idle               The idle connection to release.
+
+**/
+VOID
+HttpFreeIdleConnection (
+  IN HTTP_SERVICE          *HttpService,
+  IN HTTP_IDLE_CONNECTION  *Idle
+  )
+{
+  RemoveEntryList (&Idle->Link);
+  HttpService->IdleConnectionNumber--;
+
+  if (Idle->UseHttps) {
+    Idle->TlsSb->DestroyChild (Idle->TlsSb, Idle->TlsChildHandle);
+  }
+
+  if (!Idle->LocalAddressIsIPv6) {
+    //
+    // Resetting the configuration aborts the connection.
+    //
+    Idle->Tcp4->Configure (Idle->Tcp4, NULL);
+
+    gBS->CloseProtocol (
+           Idle->TcpChildHandle,
+           &gEfiTcp4ProtocolGuid,
+           HttpService->Ip4DriverBindingHandle,
+           HttpService->ControllerHandle
+           );
+
+    NetLibDestroyServiceChild (
+      HttpService->ControllerHandle,
+      HttpService->Ip4DriverBindingHandle,
+      &gEfiTcp4ServiceBindingProtocolGuid,
+      Idle->TcpChildHandle
+      );
+  } else {
+    Idle->Tcp6->Configure (Idle->Tcp6, NULL);
+
+    gBS->CloseProtocol (
+           Idle->TcpChildHandle,
+           &gEfiTcp6ProtocolGuid,
+           HttpService->Ip6DriverBindingHandle,
+           HttpService->ControllerHandle
+           );
+
+    NetLibDestroyServiceChild (
+      HttpService->ControllerHandle,
+      HttpService->Ip6DriverBindingHandle,
+      &gEfiTcp6ServiceBindingProtocolGuid,
+      Idle->TcpChildHandle
+      );
+  }
+
+  gBS->CloseEvent (Idle->ExpireEvent);
+  FreePool (Idle->RemoteHost);
+  FreePool (Idle);
+}
+
+/**
+  Release the idle connections which have been parked for longer than
+  HTTP_IDLE_CONNECTION_TIMEOUT seconds, the server has likely dropped them.
+
+  @param[in]  HttpService        The HTTP service.
+
+**/
+VOID
+HttpPurgeIdleConnections (
+  IN HTTP_SERVICE  *HttpService
+  )
+{
+  LIST_ENTRY            *Entry;
+  LIST_ENTRY            *Next;
+  HTTP_IDLE_CONNECTION  *Idle;
+
+  NET_LIST_FOR_EACH_SAFE (Entry, Next, &HttpService->IdleConnectionList) {
+    Idle = NET_LIST_USER_STRUCT (Entry, HTTP_IDLE_CONNECTION, Link);
+    if (!EFI_ERROR (gBS->CheckEvent (Idle->ExpireEvent))) {
+      HttpFreeIdleConnection (HttpService, Idle);
+    }
+  }
+}
+
+/**
+  Check whether the TCP connection of an HTTP child or idle entry is still established.
+
+  @param[in]  LocalAddressIsIPv6 TRUE for a TCP6 connection, FALSE for TCP4.
+  @param[in]  Tcp4               The TCP4 protocol of the connection.
+  @param[in]  Tcp6               The TCP6 protocol of the connection.
+
+  @retval TRUE                   The connection is established.
+  @retval FALSE                  The connection is closing, closed or in error.
+
+**/
+BOOLEAN
+HttpIsConnectionEstablished (
+  IN BOOLEAN            LocalAddressIsIPv6,
+  IN EFI_TCP4_PROTOCOL  *Tcp4,
+  IN EFI_TCP6_PROTOCOL  *Tcp6
+  )
+{
+  EFI_STATUS                 Status;
+  EFI_TCP4_CONNECTION_STATE  Tcp4State;
+  EFI_TCP6_CONNECTION_STATE  Tcp6State;
+
+  if (!LocalAddressIsIPv6) {
+    //
+    // Poll first so a FIN or RST received while idle is processed.
+    //
+    Tcp4->Poll (Tcp4);
+    Status = Tcp4->GetModeData (Tcp4, &Tcp4State, NULL, NULL, NULL, NULL);
+    return (BOOLEAN)(!EFI_ERROR (Status) && (Tcp4State == Tcp4StateEstablished));
+  }
+
+  Tcp6->Poll (Tcp6);
+  Status = Tcp6->GetModeData (Tcp6, &Tcp6State, NULL, NULL, NULL, NULL);
+  return (BOOLEAN)(!EFI_ERROR (Status) && (Tcp6State == Tcp6StateEstablished));
+}
+
+/**
+  Get the TLS configuration of the session of an HTTPS child.
+
+  @param[in]   HttpInstance      The HTTPS child with a configured TLS session.
+  @param[out]  TlsConfigKey      The TLS configuration of the session.
+
+  @retval EFI_SUCCESS            The TLS configuration is returned.
+  @retval Others                 The TLS child could not be queried.
+
+**/
+EFI_STATUS
+HttpGetTlsConfigKey (
+  IN  HTTP_PROTOCOL        *HttpInstance,
+  OUT HTTP_TLS_CONFIG_KEY  *TlsConfigKey
+  )
+{
+  UINTN  VerifyMethodSize;
+
+  ZeroMem (TlsConfigKey, sizeof (HTTP_TLS_CONFIG_KEY));
+  TlsConfigKey->VerifyHostFlags = HttpInstance->TlsConfigData.VerifyHost.Flags;
+
+  //
+  // Read the verify method back from the TLS child, the HttpEventTlsConfigured
+  // callback may have changed it.
+  //
+  VerifyMethodSize = sizeof (TlsConfigKey->VerifyMethod);
+  return HttpInstance->Tls->GetSessionData (
+                              HttpInstance->Tls,
+                              EfiTlsVerifyMethod,
+                              &TlsConfigKey->VerifyMethod,
+                              &VerifyMethodSize
+                              );
+}
+
+/**
+  Move the TLS and TLS configuration protocols of a TLS child to another handle.
+
+  @param[in]       From              The handle the TLS child is installed on.
+  @param[in, out]  To                The handle to move the TLS child to, or a
+                                     pointer to NULL to create a new handle.
+  @param[in]       Tls               The TLS protocol of the child.
+  @param[in]       TlsConfiguration  The TLS configuration protocol of the child.
+
+  @retval EFI_SUCCESS                The TLS child is installed on To.
+  @retval Others                     The TLS child could not be moved.
+
+**/
+EFI_STATUS
+HttpMoveTlsChild (
+  IN     EFI_HANDLE                      From,
+  IN OUT EFI_HANDLE                      *To,
+  IN     EFI_TLS_PROTOCOL                *Tls,
+  IN     EFI_TLS_CONFIGURATION_PROTOCOL  *TlsConfiguration
+  )
+{
+  EFI_STATUS  Status;
+
+  Status = gBS->UninstallMultipleProtocolInterfaces (
+                  From,
+                  &gEfiTlsProtocolGuid,
+                  Tls,
+                  &gEfiTlsConfigurationProtocolGuid,
+                  TlsConfiguration,
+                  NULL
+                  );
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  Status = gBS->InstallMultipleProtocolInterfaces (
+                  To,
+                  &gEfiTlsProtocolGuid,
+                  Tls,
+                  &gEfiTlsConfigurationProtocolGuid,
+                  TlsConfiguration,
+                  NULL
+                  );
+  if (EFI_ERROR (Status)) {
+    //
+    // Put the child back, this fails if From went away with its last protocol.
+    //
+    gBS->InstallMultipleProtocolInterfaces (
+           &From,
+           &gEfiTlsProtocolGuid,
+           Tls,
+           &gEfiTlsConfigurationProtocolGuid,
+           TlsConfiguration,
+           NULL
+           );
+  }
+
+  return Status;
+}
+
+/**
+  Check whether an idle connection can serve a request of an HTTP child.
+
+  @param[in]  HttpInstance       The HTTP child.
+  @param[in]  Idle               The idle connection.
+  @param[in]  HostName           The host name of the request URL.
+  @param[in]  RemotePort         The port of the request URL.
+  @param[in]  TlsConfigKey       The TLS configuration of the child for HTTPS,
+                                 NULL for HTTP.
+
+  @retval TRUE                   The idle connection goes to the same host and port
+                                 from the same local access point, with the same
+                                 TLS configuration for HTTPS.
+  @retval FALSE                  The idle connection does not match.
+
+**/
+BOOLEAN
+HttpIdleConnectionMatch (
+  IN HTTP_PROTOCOL         *HttpInstance,
+  IN HTTP_IDLE_CONNECTION  *Idle,
+  IN CHAR8                 *HostName,
+  IN UINT16                RemotePort,
+  IN HTTP_TLS_CONFIG_KEY   *TlsConfigKey OPTIONAL
+  )
+{
+  if ((Idle->LocalAddressIsIPv6 != HttpInstance->LocalAddressIsIPv6) ||
+      (Idle->UseHttps != (BOOLEAN)(TlsConfigKey != NULL)) ||
+      (Idle->RemotePort != RemotePort) ||
+      (AsciiStrCmp (Idle->RemoteHost, HostName) != 0))
+  {
+    return FALSE;
+  }
+
+  if (Idle->UseHttps && (CompareMem (&Idle->TlsConfigKey, TlsConfigKey, sizeof (HTTP_TLS_CONFIG_KEY)) != 0)) {
+    return FALSE;
+  }
+
+  if (!Idle->LocalAddressIsIPv6) {
+    if ((Idle->IPv4Node.UseDefaultAddress != HttpInstance->IPv4Node.UseDefaultAddress) ||
+        (Idle->IPv4Node.LocalPort != HttpInstance->IPv4Node.LocalPort))
+    {
+      return FALSE;
+    }
+
+    if (!Idle->IPv4Node.UseDefaultAddress &&
+        (!EFI_IP4_EQUAL (&Idle->IPv4Node.LocalAddress, &HttpInstance->IPv4Node.LocalAddress) ||
+         !EFI_IP4_EQUAL (&Idle->IPv4Node.LocalSubnet, &HttpInstance->IPv4Node.LocalSubnet)))
+    {
+      return FALSE;
+    }
+
+    return TRUE;
+  }
+
+  return (BOOLEAN)((Idle->Ipv6Node.LocalPort == HttpInstance->Ipv6Node.LocalPort) &&
+                   EFI_IP6_EQUAL (&Idle->Ipv6Node.LocalAddress, &HttpInstance->Ipv6Node.LocalAddress));
+}
+
+/**
+  Park the established connection of an HTTP child that is being destroyed in
+  the idle connection list of its service, so a later child sending a request
+  to the same host and port can reuse it.
+
+  Only connections without a proxy, with no request or response in flight and
+  not asked to be closed by the server are parked. For HTTPS the TLS session
+  must be transferring data, and it is parked with the connection under its
+  TLS configuration. The TCP and TLS children are detached from the HTTP
+  child, which can then be cleaned up as usual.
+
+  @param[in, out]  HttpInstance  The HTTP child being destroyed.
+
+**/
+VOID
+HttpParkConnection (
+  IN OUT HTTP_PROTOCOL  *HttpInstance
+  )
+{
+  EFI_STATUS            Status;
+  HTTP_SERVICE          *HttpService;
+  HTTP_IDLE_CONNECTION  *Idle;
+  HTTP_TLS_CONFIG_KEY   TlsConfigKey;
+  UINTN                 MaxIdle;
+
+  HttpService = HttpInstance->Service;
+  MaxIdle     = MIN (PcdGet8 (PcdHttpKeepAliveConnections), HTTP_IDLE_CONNECTION_MAX);
+
+  if ((MaxIdle == 0) ||
+      (HttpInstance->State != HTTP_STATE_TCP_CONNECTED) ||
+      HttpInstance->ConnectionClose ||
+      HttpInstance->ProxyConnected ||
+      (HttpInstance->RemoteHost == NULL) ||
+      (HttpInstance->MsgParser != NULL) ||
+      (HttpInstance->CacheBody != NULL) ||
+      (NetMapGetCount (&HttpInstance->TxTokens) != 0) ||
+      (NetMapGetCount (&HttpInstance->RxTokens) != 0))
+  {
+    return;
+  }
+
+  if (HttpInstance->UseHttps &&
+      (!HttpInstance->TlsAlreadyCreated || (HttpInstance->TlsSessionState != EfiTlsSessionDataTransferring)))
+  {
+    return;
+  }
+
+  if (!HttpIsConnectionEstablished (HttpInstance->LocalAddressIsIPv6, HttpInstance->Tcp4, HttpInstance->Tcp6)) {
+    return;
+  }
+
+  if (HttpInstance->UseHttps) {
+    Status = HttpGetTlsConfigKey (HttpInstance, &TlsConfigKey);
+    if (EFI_ERROR (Status)) {
+      return;
+    }
+  }
+
+  Idle = AllocateZeroPool (sizeof (HTTP_IDLE_CONNECTION));
+  if (Idle == NULL) {
+    return;
+  }
+
+  Status = gBS->CreateEvent (EVT_TIMER, TPL_CALLBACK, NULL, NULL, &Idle->ExpireEvent);
+  if (EFI_ERROR (Status)) {
+    FreePool (Idle);
+    return;
+  }
+
+  if (HttpInstance->UseHttps) {
+    //
+    // Move the TLS child off the HTTP handle, which goes away with the HTTP child.
+    //
+    Status = HttpMoveTlsChild (
+               HttpInstance->Handle,
+               &Idle->TlsChildHandle,
+               HttpInstance->Tls,
+               HttpInstance->TlsConfiguration
+               );
+    if (EFI_ERROR (Status)) {
+      gBS->CloseEvent (Idle->ExpireEvent);
+      FreePool (Idle);
+      return;
+    }
+
+    Idle->UseHttps                  = TRUE;
+    Idle->TlsConfigKey              = TlsConfigKey;
+    Idle->TlsSb                     = HttpInstance->TlsSb;
+    Idle->Tls                       = HttpInstance->Tls;
+    Idle->TlsConfiguration          = HttpInstance->TlsConfiguration;
+    HttpInstance->TlsAlreadyCreated = FALSE;
+  }
+
+  gBS->SetTimer (Idle->ExpireEvent, TimerRelative, HTTP_IDLE_CONNECTION_TIMEOUT * TICKS_PER_SECOND);
+
+  HttpPurgeIdleConnections (HttpService);
+  if (HttpService->IdleConnectionNumber >= MaxIdle) {
+    //
+    // Evict the oldest idle connection.
+    //
+    HttpFreeIdleConnection (
+      HttpService,
+      NET_LIST_HEAD (&HttpService->IdleConnectionList, HTTP_IDLE_CONNECTION, Link)
+      );
+  }
+
+  Idle->LocalAddressIsIPv6 = HttpInstance->LocalAddressIsIPv6;
+  Idle->RemoteHost         = HttpInstance->RemoteHost;
+  Idle->RemotePort         = HttpInstance->RemotePort;
+  HttpInstance->RemoteHost = NULL;
+
+  //
+  // Detach the TCP child from the HTTP child, the open by the driver stays
+  // with the idle connection.
+  //
+  if (!HttpInstance->LocalAddressIsIPv6) {
+    CopyMem (&Idle->IPv4Node, &HttpInstance->IPv4Node, sizeof (Idle->IPv4Node));
+    IP4_COPY_ADDRESS (&Idle->RemoteAddr, &HttpInstance->RemoteAddr);
+
+    gBS->CloseProtocol (
+           HttpInstance->Tcp4ChildHandle,
+           &gEfiTcp4ProtocolGuid,
+           HttpService->Ip4DriverBindingHandle,
+           HttpInstance->Handle
+           );
+
+    Idle->TcpChildHandle          = HttpInstance->Tcp4ChildHandle;
+    Idle->Tcp4                    = HttpInstance->Tcp4;
+    HttpInstance->Tcp4ChildHandle = NULL;
+    HttpInstance->Tcp4            = NULL;
+  } else {
+    CopyMem (&Idle->Ipv6Node, &HttpInstance->Ipv6Node, sizeof (Idle->Ipv6Node));
+    IP6_COPY_ADDRESS (&Idle->RemoteIpv6Addr, &HttpInstance->RemoteIpv6Addr);
+
+    gBS->CloseProtocol (
+           HttpInstance->Tcp6ChildHandle,
+           &gEfiTcp6ProtocolGuid,
+           HttpService->Ip6DriverBindingHandle,
+           HttpInstance->Handle
+           );
+
+    Idle->TcpChildHandle          = HttpInstance->Tcp6ChildHandle;
+    Idle->Tcp6                    = HttpInstance->Tcp6;
+    HttpInstance->Tcp6ChildHandle = NULL;
+    HttpInstance->Tcp6            = NULL;
+  }
+
+  HttpInstance->State = HTTP_STATE_TCP_CLOSED;
+
+  InsertTailList (&HttpService->IdleConnectionList, &Idle->Link);
+  HttpService->IdleConnectionNumber++;
+  HttpService->Statistics.IdleConnectionsParked++;
+
+  DEBUG ((DEBUG_VERBOSE, "HttpParkConnection: %a:%d parked\n", Idle->RemoteHost, Idle->RemotePort));
+}
+
+/**
+  Adopt an idle connection to HostName and RemotePort for the first request
+  of an HTTP child, instead of connecting again.
+
+  The TCP child created by Configure() is replaced by the idle one, and the
+  HTTP child is left in the connected state. An HTTPS child must have its TLS
+  session configured, only a connection parked with the same TLS configuration
+  is adopted and its TLS child replaces the one of the HTTPS child.
+
+  @param[in, out]  HttpInstance  The configured HTTP child without a connection.
+  @param[in]       HostName      The host name of the request URL.
+  @param[in]       RemotePort    The port of the request URL.
+
+  @retval EFI_SUCCESS            An idle connection was adopted.
+  @retval EFI_NOT_FOUND          No reusable idle connection, HttpInstance is unchanged.
+  @retval Others                 The TLS child of the idle connection could not be
+                                 moved, the HTTPS child has no TLS child left.
+
+**/
+EFI_STATUS
+HttpAdoptConnection (
+  IN OUT HTTP_PROTOCOL  *HttpInstance,
+  IN     CHAR8          *HostName,
+  IN     UINT16         RemotePort
+  )
+{
+  EFI_STATUS            Status;
+  HTTP_SERVICE          *HttpService;
+  HTTP_IDLE_CONNECTION  *Idle;
+  HTTP_TLS_CONFIG_KEY   TlsConfigKey;
+  LIST_ENTRY            *Entry;
+  LIST_ENTRY            *Next;
+  EFI_GUID              *TcpProtocolGuid;
+  EFI_HANDLE            DriverBindingHandle;
+  VOID                  *Interface;
+
+  HttpService = HttpInstance->Service;
+  if (IsListEmpty (&HttpService->IdleConnectionList)) {
+    return EFI_NOT_FOUND;
+  }
+
+  if (HttpInstance->UseHttps) {
+    Status = HttpGetTlsConfigKey (HttpInstance, &TlsConfigKey);
+    if (EFI_ERROR (Status)) {
+      return EFI_NOT_FOUND;
+    }
+  }
+
+  HttpPurgeIdleConnections (HttpService);
+
+  Idle = NULL;
+  NET_LIST_FOR_EACH_SAFE (Entry, Next, &HttpService->IdleConnectionList) {
+    Idle = NET_LIST_USER_STRUCT (Entry, HTTP_IDLE_CONNECTION, Link);
+    if (!HttpIdleConnectionMatch (HttpInstance, Idle, HostName, RemotePort, HttpInstance->UseHttps ? &TlsConfigKey : NULL)) {
+      Idle = NULL;
+      continue;
+    }
+
+    if (HttpIsConnectionEstablished (Idle->LocalAddressIsIPv6, Idle->Tcp4, Idle->Tcp6)) {
+      break;
+    }
+
+    //
+    // The server has closed the connection meanwhile.
+    //
+    HttpFreeIdleConnection (HttpService, Idle);
+    Idle = NULL;
+  }
+
+  if (Idle == NULL) {
+    return EFI_NOT_FOUND;
+  }
+
+  if (!HttpInstance->LocalAddressIsIPv6) {
+    TcpProtocolGuid     = &gEfiTcp4ProtocolGuid;
+    DriverBindingHandle = HttpService->Ip4DriverBindingHandle;
+  } else {
+    TcpProtocolGuid     = &gEfiTcp6ProtocolGuid;
+    DriverBindingHandle = HttpService->Ip6DriverBindingHandle;
+  }
+
+  Status = HttpCreateTcpConnCloseEvent (HttpInstance);
+  if (EFI_ERROR (Status)) {
+    return EFI_NOT_FOUND;
+  }
+
+  Status = gBS->OpenProtocol (
+                  Idle->TcpChildHandle,
+                  TcpProtocolGuid,
+                  &Interface,
+                  DriverBindingHandle,
+                  HttpInstance->Handle,
+                  EFI_OPEN_PROTOCOL_BY_CHILD_CONTROLLER
+                  );
+  if (EFI_ERROR (Status)) {
+    HttpCloseTcpConnCloseEvent (HttpInstance);
+    return EFI_NOT_FOUND;
+  }
+
+  if (Idle->UseHttps) {
+    //
+    // Replace the TLS child configured for this request with the one holding
+    // the established session, on the HTTP handle where callers look for it.
+    //
+    HttpInstance->TlsSb->DestroyChild (HttpInstance->TlsSb, HttpInstance->Handle);
+    HttpInstance->TlsAlreadyCreated = FALSE;
+
+    Status = HttpMoveTlsChild (Idle->TlsChildHandle, &HttpInstance->Handle, Idle->Tls, Idle->TlsConfiguration);
+    if (EFI_ERROR (Status)) {
+      gBS->CloseProtocol (Idle->TcpChildHandle, TcpProtocolGuid, DriverBindingHandle, HttpInstance->Handle);
+      HttpCloseTcpConnCloseEvent (HttpInstance);
+      HttpFreeIdleConnection (HttpService, Idle);
+      return Status;
+    }
+
+    HttpInstance->TlsAlreadyCreated = TRUE;
+    HttpInstance->Tls               = Idle->Tls;
+    HttpInstance->TlsConfiguration  = Idle->TlsConfiguration;
+    HttpInstance->TlsSessionState   = EfiTlsSessionDataTransferring;
+  }
+
+  //
+  // Replace the unused TCP child created by Configure() with the idle one.
+  //
+  if (!HttpInstance->LocalAddressIsIPv6) {
+    gBS->CloseProtocol (
+           HttpInstance->Tcp4ChildHandle,
+           &gEfiTcp4ProtocolGuid,
+           HttpService->Ip4DriverBindingHandle,
+           HttpService->ControllerHandle
+           );
+
+    gBS->CloseProtocol (
+           HttpInstance->Tcp4ChildHandle,
+           &gEfiTcp4ProtocolGuid,
+           HttpService->Ip4DriverBindingHandle,
+           HttpInstance->Handle
+           );
+
+    NetLibDestroyServiceChild (
+      HttpService->ControllerHandle,
+      HttpService->Ip4DriverBindingHandle,
+      &gEfiTcp4ServiceBindingProtocolGuid,
+      HttpInstance->Tcp4ChildHandle
+      );
+
+    HttpInstance->Tcp4ChildHandle = Idle->TcpChildHandle;
+    HttpInstance->Tcp4            = Idle->Tcp4;
+    IP4_COPY_ADDRESS (&HttpInstance->RemoteAddr, &Idle->RemoteAddr);
+  } else {
+    gBS->CloseProtocol (
+           HttpInstance->Tcp6ChildHandle,
+           &gEfiTcp6ProtocolGuid,
+           HttpService->Ip6DriverBindingHandle,
+           HttpService->ControllerHandle
+           );
+
+    gBS->CloseProtocol (
+           HttpInstance->Tcp6ChildHandle,
+           &gEfiTcp6ProtocolGuid,
+           HttpService->Ip6DriverBindingHandle,
+           HttpInstance->Handle
+           );
+
+    NetLibDestroyServiceChild (
+      HttpService->ControllerHandle,
+      HttpService->Ip6DriverBindingHandle,
+      &gEfiTcp6ServiceBindingProtocolGuid,
+      HttpInstance->Tcp6ChildHandle
+      );
+
+    HttpInstance->Tcp6ChildHandle = Idle->TcpChildHandle;
+    HttpInstance->Tcp6            = Idle->Tcp6;
+    IP6_COPY_ADDRESS (&HttpInstance->RemoteIpv6Addr, &Idle->RemoteIpv6Addr);
+  }
+
+  HttpInstance->State = HTTP_STATE_TCP_CONNECTED;
+
+  DEBUG ((DEBUG_VERBOSE, "HttpAdoptConnection: %a:%d reused\n", Idle->RemoteHost, Idle->RemotePort));
+
+  //
+  // The TCP and TLS children now belong to the HTTP child, only release the entry.
+  //
+  RemoveEntryList (&Idle->Link);
+  HttpService->IdleConnectionNumber--;
+  gBS->CloseEvent (Idle->ExpireEvent);
+  FreePool (Idle->RemoteHost);
+  FreePool (Idle);
+
+  HttpCountConnectionReuse (HttpInstance);
+  return EFI_SUCCESS;
+}
+
+/**
+  Close and release the idle connections of one IP version parked in the
+  HTTP service.
+
+  @param[in]  HttpService        The HTTP service.
+  @param[in]  UsingIpv6          TRUE to release TCP6 connections, FALSE for TCP4.
+
+**/
+VOID
+HttpFlushIdleConnections (
+  IN HTTP_SERVICE  *HttpService,
+  IN BOOLEAN       UsingIpv6
+  )
+{
+  LIST_ENTRY            *Entry;
+  LIST_ENTRY            *Next;
+  HTTP_IDLE_CONNECTION  *Idle;
+
+  NET_LIST_FOR_EACH_SAFE (Entry, Next, &HttpService->IdleConnectionList) {
+    Idle = NET_LIST_USER_STRUCT (Entry, HTTP_IDLE_CONNECTION, Link);
+    if (Idle->LocalAddressIsIPv6 == UsingIpv6) {
+      HttpFreeIdleConnection (HttpService, Idle);
+    }
+  }
+}
+
+/**
+  Account a connection an HTTP child adopted from the idle connection list in
+  the service statistics.
+
+  @param[in]  HttpInstance       The HTTP child.
+
+**/
+VOID
+HttpCountConnectionReuse (
+  IN HTTP_PROTOCOL  *HttpInstance
+  )
+{
+  HTTP_SERVICE  *HttpService;
+
+  HttpService = HttpInstance->Service;
+  HttpService->Statistics.IdleConnectionsReused++;
+  if (HttpInstance->UseHttps) {
+    HttpService->Statistics.TlsHandshakesAvoided++;
+  }
+}
+
 /**
   Establish TCP connection with HTTP server.
 
@@ -997,6 +1667,7 @@ HttpCreateConnection (
 
   if (!EFI_ERROR (Status)) {
     HttpInstance->State = HTTP_STATE_TCP_CONNECTED;
+    HttpInstance->Service->Statistics.TcpConnects++;
   }
 
   return Status;
@@ -1102,6 +1773,7 @@ HttpConfigureTcp4 (
   Tcp4Option->KeepAliveInterval   = HTTP_KEEP_ALIVE_INTERVAL;
   Tcp4Option->EnableNagle         = TRUE;
   Tcp4Option->EnableWindowScaling = TRUE;
+  Tcp4Option->EnableSelectiveAck  = TRUE;
   Tcp4CfgData->ControlOption      = Tcp4Option;
 
   if ((HttpInstance->State == HTTP_STATE_TCP_CONNECTED) ||
@@ -1186,6 +1858,7 @@ HttpConfigureTcp6 (
   Tcp6Option->KeepAliveInterval   = HTTP_KEEP_ALIVE_INTERVAL;
   Tcp6Option->EnableNagle         = TRUE;
   Tcp6Option->EnableWindowScaling = TRUE;
+  Tcp6Option->EnableSelectiveAck  = TRUE;
 
   if ((HttpInstance->State == HTTP_STATE_TCP_CONNECTED) ||
       (HttpInstance->State == HTTP_STATE_TCP_CLOSED))
@@ -1311,6 +1984,8 @@ HttpConnectTcp4 (
       TlsCloseTxRxEvent (HttpInstance);
       return Status;
     }
+
+    HttpInstance->Service->Statistics.TlsHandshakes++;
   }
 
   return Status;
@@ -1408,6 +2083,8 @@ HttpConnectTcp6 (
       TlsCloseTxRxEvent (HttpInstance);
       return Status;
     }
+
+    HttpInstance->Service->Statistics.TlsHandshakes++;
   }
 
   return Status;
@@ -1446,6 +2123,22 @@ HttpInitSession (
     if (EFI_ERROR (Status)) {
       return Status;
     }
+
+    if (Configure && !HttpInstance->ProxyConnected && (HttpInstance->Method != HttpMethodConnect)) {
+      //
+      // New HTTPS session, reuse an idle connection to the same host whose TLS
+      // session was configured the same way instead of connecting and doing
+      // the handshake again.
+      //
+      Status = HttpAdoptConnection (HttpInstance, HttpInstance->RemoteHost, HttpInstance->RemotePort);
+      if (!EFI_ERROR (Status)) {
+        return HttpCreateTcpTxEvent (Wrap);
+      }
+
+      if (Status != EFI_NOT_FOUND) {
+        return Status;
+      }
+    }
   }
 
   if (!HttpInstance->LocalAddressIsIPv6) {
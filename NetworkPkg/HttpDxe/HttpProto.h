@@ -49,17 +49,62 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 
 #define HTTP_URL_BUFFER_LEN  4096
 
+//
+// Idle connections kept for reuse by later HTTP children.
+//
+#define HTTP_IDLE_CONNECTION_MAX      16
+#define HTTP_IDLE_CONNECTION_TIMEOUT  5
+
+//
+// The TLS configuration an HTTPS connection was established with. The host
+// name to verify is the remote host, and the cipher list and CA certificates
+// come from the same platform variables for every child, so only what a child
+// or its HTTP callback can change per session is kept.
+//
+typedef struct {
+  EFI_TLS_VERIFY              VerifyMethod;
+  EFI_TLS_VERIFY_HOST_FLAG    VerifyHostFlags;
+} HTTP_TLS_CONFIG_KEY;
+
+//
+// An established TCP connection, and the TLS session over it for HTTPS,
+// parked by a destroyed HTTP child.
+//
+typedef struct {
+  LIST_ENTRY                        Link;
+  BOOLEAN                           LocalAddressIsIPv6;
+  EFI_HTTPv4_ACCESS_POINT           IPv4Node;
+  EFI_HTTPv6_ACCESS_POINT           Ipv6Node;
+  CHAR8                             *RemoteHost;
+  UINT16                            RemotePort;
+  EFI_IPv4_ADDRESS                  RemoteAddr;
+  EFI_IPv6_ADDRESS                  RemoteIpv6Addr;
+  EFI_HANDLE                        TcpChildHandle;
+  EFI_TCP4_PROTOCOL                 *Tcp4;
+  EFI_TCP6_PROTOCOL                 *Tcp6;
+  BOOLEAN                           UseHttps;
+  HTTP_TLS_CONFIG_KEY               TlsConfigKey;
+  EFI_SERVICE_BINDING_PROTOCOL      *TlsSb;
+  EFI_HANDLE                        TlsChildHandle;
+  EFI_TLS_PROTOCOL                  *Tls;
+  EFI_TLS_CONFIGURATION_PROTOCOL    *TlsConfiguration;
+  EFI_EVENT                         ExpireEvent;
+} HTTP_IDLE_CONNECTION;
+
 typedef struct _HTTP_SERVICE {
-  UINT32                          Signature;
-  EFI_SERVICE_BINDING_PROTOCOL    ServiceBinding;
-  EFI_HANDLE                      Ip4DriverBindingHandle;
-  EFI_HANDLE                      Ip6DriverBindingHandle;
-  EFI_HANDLE                      ControllerHandle;
-  EFI_HANDLE                      Tcp4ChildHandle;
-  EFI_HANDLE                      Tcp6ChildHandle;
-  LIST_ENTRY                      ChildrenList;
-  UINTN                           ChildrenNumber;
-  INTN                            State;
+  UINT32                                       Signature;
+  EFI_SERVICE_BINDING_PROTOCOL                 ServiceBinding;
+  EFI_HANDLE                                   Ip4DriverBindingHandle;
+  EFI_HANDLE                                   Ip6DriverBindingHandle;
+  EFI_HANDLE                                   ControllerHandle;
+  EFI_HANDLE                                   Tcp4ChildHandle;
+  EFI_HANDLE                                   Tcp6ChildHandle;
+  LIST_ENTRY                                   ChildrenList;
+  UINTN                                        ChildrenNumber;
+  INTN                                         State;
+  LIST_ENTRY                                   IdleConnectionList;
+  UINTN                                        IdleConnectionNumber;
+  EDKII_HTTP_CONNECTION_STATISTICS_PROTOCOL    Statistics;
 } HTTP_SERVICE;
 
 typedef struct {
@@ -343,6 +388,77 @@ HttpCleanProtocol (
   IN  HTTP_PROTOCOL  *HttpInstance
   );
 
+/**
+  Park the established connection of an HTTP child that is being destroyed in
+  the idle connection list of its service, so a later child sending a request
+  to the same host and port can reuse it.
+
+  Only connections without a proxy, with no request or response in flight and
+  not asked to be closed by the server are parked. For HTTPS the TLS session
+  must be transferring data, and it is parked with the connection under its
+  TLS configuration. The TCP and TLS children are detached from the HTTP
+  child, which can then be cleaned up as usual.
+
+  @param[in, out]  HttpInstance  The HTTP child being destroyed.
+
+**/
+VOID
+HttpParkConnection (
+  IN OUT HTTP_PROTOCOL  *HttpInstance
+  );
+
+/**
+  Adopt an idle connection to HostName and RemotePort for the first request
+  of an HTTP child, instead of connecting again.
+
+  The TCP child created by Configure() is replaced by the idle one, and the
+  HTTP child is left in the connected state. An HTTPS child must have its TLS
+  session configured, only a connection parked with the same TLS configuration
+  is adopted and its TLS child replaces the one of the HTTPS child.
+
+  @param[in, out]  HttpInstance  The configured HTTP child without a connection.
+  @param[in]       HostName      The host name of the request URL.
+  @param[in]       RemotePort    The port of the request URL.
+
+  @retval EFI_SUCCESS            An idle connection was adopted.
+  @retval EFI_NOT_FOUND          No reusable idle connection, HttpInstance is unchanged.
+  @retval Others                 The TLS child of the idle connection could not be
+                                 moved, the HTTPS child has no TLS child left.
+
+**/
+EFI_STATUS
+HttpAdoptConnection (
+  IN OUT HTTP_PROTOCOL  *HttpInstance,
+  IN     CHAR8          *HostName,
+  IN     UINT16         RemotePort
+  );
+
+/**
+  Close and release the idle connections of one IP version parked in the
+  HTTP service.
+
+  @param[in]  HttpService        The HTTP service.
+  @param[in]  UsingIpv6          TRUE to release TCP6 connections, FALSE for TCP4.
+
+**/
+VOID
+HttpFlushIdleConnections (
+  IN HTTP_SERVICE  *HttpService,
+  IN BOOLEAN       UsingIpv6
+  );
+
+/**
+  Account a connection an HTTP child adopted from the idle connection list in
+  the service statistics.
+
+  @param[in]  HttpInstance       The HTTP child.
+
+**/
+VOID
+HttpCountConnectionReuse (
+  IN HTTP_PROTOCOL  *HttpInstance
+  );
+
 /**
   Establish TCP connection with HTTP server.
 
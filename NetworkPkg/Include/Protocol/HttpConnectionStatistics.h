@@ -0,0 +1,55 @@
+/** @file
+  This file defines the EDKII HTTP Connection Statistics Protocol.
+
+  HttpDxe installs it on each controller it produces the HTTP service binding
+  on. The interface is the live counters of that HTTP service, so a consumer
+  reads it whenever it wants to know how much connection setup was done and
+  how much was avoided by reusing connections. Consumers must not write it.
+
+  Copyright (c) 2026, Intel Corporation. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+**/
+
+#ifndef EDKII_HTTP_CONNECTION_STATISTICS_H_
+#define EDKII_HTTP_CONNECTION_STATISTICS_H_
+
+#define EDKII_HTTP_CONNECTION_STATISTICS_PROTOCOL_GUID \
+  { \
+    0x77f81b0a, 0x96f9, 0x4fff, {0xa8, 0x7d, 0xc4, 0x6c, 0xba, 0x08, 0xa4, 0x2b} \
+  }
+
+///
+/// EDKII_HTTP_CONNECTION_STATISTICS_PROTOCOL
+///
+typedef struct {
+  ///
+  /// TCP connections established to a server or proxy.
+  ///
+  UINT64    TcpConnects;
+  ///
+  /// TLS handshakes completed.
+  ///
+  UINT64    TlsHandshakes;
+  ///
+  /// Connections kept open in the pool by destroyed HTTP children.
+  ///
+  UINT64    IdleConnectionsParked;
+  ///
+  /// Connections adopted from the pool, each one a TCP connect avoided.
+  ///
+  UINT64    IdleConnectionsReused;
+  ///
+  /// Adopted connections that carried a TLS session, each one a TLS
+  /// handshake avoided.
+  ///
+  UINT64    TlsHandshakesAvoided;
+  ///
+  /// Requests issued while an earlier request of the same child was still
+  /// outstanding.
+  ///
+  UINT64    PipelinedRequests;
+} EDKII_HTTP_CONNECTION_STATISTICS_PROTOCOL;
+
+extern EFI_GUID  gEdkiiHttpConnectionStatisticsProtocolGuid;
+
+#endif
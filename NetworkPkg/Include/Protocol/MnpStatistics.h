@@ -0,0 +1,46 @@
+/** @file
+  This file defines the EDKII MNP Statistics Protocol.
+
+  MnpDxe installs it on each MNP service handle, next to the MNP service
+  binding. The interface is the live packet counters of the network interface
+  the service runs on; the services of all VLANs of one interface share them.
+  Consumers must not write it.
+
+  Copyright (c) 2026, Intel Corporation. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+**/
+
+#ifndef EDKII_MNP_STATISTICS_H_
+#define EDKII_MNP_STATISTICS_H_
+
+#define EDKII_MNP_STATISTICS_PROTOCOL_GUID \
+  { \
+    0x715bc1c3, 0xe29e, 0x42ec, {0xbb, 0xda, 0xe0, 0xb1, 0x52, 0xe5, 0x4c, 0xb8} \
+  }
+
+///
+/// EDKII_MNP_STATISTICS_PROTOCOL
+///
+typedef struct {
+  ///
+  /// Frames received from SNP and accepted by MNP.
+  ///
+  UINT64    RxPackets;
+  ///
+  /// Received frames dropped: SNP receive errors, malformed frames, frames
+  /// for an unconfigured VLAN, instance queue overflows and receive timeouts.
+  ///
+  UINT64    RxDropped;
+  ///
+  /// Frames transmitted.
+  ///
+  UINT64    TxPackets;
+  ///
+  /// Frames that failed to transmit.
+  ///
+  UINT64    TxDropped;
+} EDKII_MNP_STATISTICS_PROTOCOL;
+
+extern EFI_GUID  gEdkiiMnpStatisticsProtocolGuid;
+
+#endif
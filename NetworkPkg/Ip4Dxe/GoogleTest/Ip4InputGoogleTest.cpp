@@ -0,0 +1,516 @@
+/** @file
+  Tests for the delivery of received packets to the IP4 children in
+  Ip4Input.c.
+
+  Copyright (c) 2026, Intel Corporation. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+**/
+#include <gtest/gtest.h>
+
+extern "C" {
+  #include <Uefi.h>
+  #include <Library/BaseLib.h>
+  #include <Library/BaseMemoryLib.h>
+  #include <Library/DebugLib.h>
+  #include <Library/DpcLib.h>
+  #include <Library/MemoryAllocationLib.h>
+  #include <Library/UefiBootServicesTableLib.h>
+  #include "../Ip4Impl.h"
+}
+
+////////////////////////////////////////////////////////////////////////
+// Defines
+////////////////////////////////////////////////////////////////////////
+
+#define IP4_INPUT_TEST_MAX_CHILDREN  8
+#define IP4_INPUT_TEST_PAYLOAD_LEN   1400
+
+////////////////////////////////////////////////////////////////////////
+// Symbol Definitions
+// These are not directly under test - but required to compile
+////////////////////////////////////////////////////////////////////////
+EFI_IPSEC2_PROTOCOL  *mIpSec          = NULL;
+BOOLEAN              mIpSec2Installed = FALSE;
+
+EFI_STATUS
+EFIAPI
+DispatchDpc (
+  VOID
+  )
+{
+  return EFI_SUCCESS;
+}
+
+IP4_ICMP_CLASS  mIcmpClass[1];
+
+IGMP_GROUP *
+Ip4FindGroup (
+  IN IGMP_SERVICE_DATA  *IgmpCtrl,
+  IN IP4_ADDR           Address
+  )
+{
+  return NULL;
+}
+
+VOID
+EFIAPI
+Ip4FreeTxToken (
+  IN VOID  *Context
+  )
+{
+}
+
+EFI_STATUS
+Ip4IcmpHandle (
+  IN IP4_SERVICE  *IpSb,
+  IN IP4_HEAD     *Head,
+  IN NET_BUF      *Packet
+  )
+{
+  return EFI_SUCCESS;
+}
+
+EFI_STATUS
+Ip4IgmpHandle (
+  IN IP4_SERVICE  *IpSb,
+  IN IP4_HEAD     *Head,
+  IN NET_BUF      *Packet
+  )
+{
+  return EFI_SUCCESS;
+}
+
+BOOLEAN
+Ip4OptionIsValid (
+  IN UINT8    *Option,
+  IN UINT32   OptionLen,
+  IN BOOLEAN  Rcvd
+  )
+{
+  return TRUE;
+}
+
+EFI_STATUS
+Ip4PrependHead (
+  IN OUT NET_BUF   *Packet,
+  IN     IP4_HEAD  *Head,
+  IN     UINT8     *Option,
+  IN     UINT32    OptLen
+  )
+{
+  return EFI_SUCCESS;
+}
+
+EFI_STATUS
+Ip4ReceiveFrame (
+  IN  IP4_INTERFACE       *Interface,
+  IN  IP4_PROTOCOL        *IpInstance       OPTIONAL,
+  IN  IP4_FRAME_CALLBACK  CallBack,
+  IN  VOID                *Context
+  )
+{
+  return EFI_SUCCESS;
+}
+
+EFI_STATUS
+EFIAPI
+Ip4SentPacketTicking (
+  IN NET_MAP       *Map,
+  IN NET_MAP_ITEM  *Item,
+  IN VOID          *Context
+  )
+{
+  return EFI_SUCCESS;
+}
+
+////////////////////////////////////////////////////////////////////////
+// Boot services used by the delivery and the recycling of a packet
+////////////////////////////////////////////////////////////////////////
+
+typedef struct {
+  EFI_EVENT_NOTIFY    Notify;
+  VOID                *Context;
+  UINTN               Signaled;
+} IP4_INPUT_TEST_EVENT;
+
+STATIC
+EFI_TPL
+EFIAPI
+Ip4InputTestRaiseTpl (
+  IN EFI_TPL  NewTpl
+  )
+{
+  return TPL_APPLICATION;
+}
+
+STATIC
+VOID
+EFIAPI
+Ip4InputTestRestoreTpl (
+  IN EFI_TPL  OldTpl
+  )
+{
+}
+
+STATIC
+EFI_STATUS
+EFIAPI
+Ip4InputTestFreePool (
+  IN VOID  *Buffer
+  )
+{
+  FreePool (Buffer);
+  return EFI_SUCCESS;
+}
+
+STATIC
+EFI_STATUS
+EFIAPI
+Ip4InputTestCreateEvent (
+  IN  UINT32            Type,
+  IN  EFI_TPL           NotifyTpl,
+  IN  EFI_EVENT_NOTIFY  NotifyFunction,
+  IN  VOID              *NotifyContext,
+  OUT EFI_EVENT         *Event
+  )
+{
+  IP4_INPUT_TEST_EVENT  *TestEvent;
+
+  TestEvent = (IP4_INPUT_TEST_EVENT *)AllocateZeroPool (sizeof (IP4_INPUT_TEST_EVENT));
+  if (TestEvent == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  TestEvent->Notify  = NotifyFunction;
+  TestEvent->Context = NotifyContext;
+  *Event             = TestEvent;
+  return EFI_SUCCESS;
+}
+
+STATIC
+EFI_STATUS
+EFIAPI
+Ip4InputTestSignalEvent (
+  IN EFI_EVENT  Event
+  )
+{
+  IP4_INPUT_TEST_EVENT  *TestEvent;
+
+  TestEvent = (IP4_INPUT_TEST_EVENT *)Event;
+  TestEvent->Signaled++;
+  if (TestEvent->Notify != NULL) {
+    TestEvent->Notify (Event, TestEvent->Context);
+  }
+
+  return EFI_SUCCESS;
+}
+
+STATIC
+EFI_STATUS
+EFIAPI
+Ip4InputTestCloseEvent (
+  IN EFI_EVENT  Event
+  )
+{
+  FreePool (Event);
+  return EFI_SUCCESS;
+}
+
+////////////////////////////////////////////////////////////////////////
+// Ip4Demultiplex Tests
+////////////////////////////////////////////////////////////////////////
+
+class Ip4InputDeliverTest : public ::testing::Test {
+protected:
+  EFI_BOOT_SERVICES *SavedBs;
+  EFI_BOOT_SERVICES Bs;
+  IP4_SERVICE IpSb;
+  IP4_INTERFACE IpIf;
+  IP4_PROTOCOL Instances[IP4_INPUT_TEST_MAX_CHILDREN];
+  EFI_IP4_COMPLETION_TOKEN Tokens[IP4_INPUT_TEST_MAX_CHILDREN];
+  UINTN ChildCount;
+  IP4_HEAD Head;
+  UINT8 Payload[IP4_INPUT_TEST_PAYLOAD_LEN];
+  UINT8 *Received;
+
+  virtual void
+  SetUp (
+    )
+  {
+    UINTN  Index;
+
+    ZeroMem (&Bs, sizeof (Bs));
+    Bs.RaiseTPL    = Ip4InputTestRaiseTpl;
+    Bs.RestoreTPL  = Ip4InputTestRestoreTpl;
+    Bs.FreePool    = Ip4InputTestFreePool;
+    Bs.CreateEvent = Ip4InputTestCreateEvent;
+    Bs.SignalEvent = Ip4InputTestSignalEvent;
+    Bs.CloseEvent  = Ip4InputTestCloseEvent;
+    SavedBs        = gBS;
+    gBS            = &Bs;
+
+    ZeroMem (&IpSb, sizeof (IpSb));
+    ZeroMem (&IpIf, sizeof (IpIf));
+    InitializeListHead (&IpSb.Interfaces);
+    InitializeListHead (&IpIf.IpInstances);
+    IpIf.Configured = TRUE;
+    InsertTailList (&IpSb.Interfaces, &IpIf.Link);
+    ChildCount = 0;
+
+    //
+    // A TCP segment from 192.168.0.1 to 192.168.0.2, in network byte order
+    //
+    ZeroMem (&Head, sizeof (Head));
+    Head.Ver      = 4;
+    Head.HeadLen  = IP4_MIN_HEADLEN >> 2;
+    Head.TotalLen = HTONS (IP4_MIN_HEADLEN + IP4_INPUT_TEST_PAYLOAD_LEN);
+    Head.Id       = HTONS (0x1234);
+    Head.Fragment = HTONS (IP4_HEAD_DF_MASK);
+    Head.Ttl      = 64;
+    Head.Protocol = EFI_IP_PROTO_TCP;
+    Head.Src      = HTONL (0xC0A80001);
+    Head.Dst      = HTONL (0xC0A80002);
+    Head.Checksum = (UINT16)(~NetblockChecksum ((UINT8 *)&Head, IP4_MIN_HEADLEN));
+
+    for (Index = 0; Index < sizeof (Payload); Index++) {
+      Payload[Index] = (UINT8)Index;
+    }
+
+    Received = NULL;
+  }
+
+  virtual void
+  TearDown (
+    )
+  {
+    Release ();
+    gBS = SavedBs;
+  }
+
+  //
+  // Recycle the packets delivered up, as the upper layer would, and
+  // remove the children.
+  //
+  VOID
+  Release (
+    )
+  {
+    UINTN  Index;
+
+    for (Index = 0; Index < ChildCount; Index++) {
+      if (Tokens[Index].Packet.RxData != NULL) {
+        gBS->SignalEvent (Tokens[Index].Packet.RxData->RecycleSignal);
+        Tokens[Index].Packet.RxData = NULL;
+      }
+
+      EXPECT_TRUE (IsListEmpty (&Instances[Index].Received));
+      EXPECT_TRUE (IsListEmpty (&Instances[Index].Delivered));
+      NetMapClean (&Instances[Index].RxTokens);
+      gBS->CloseEvent (Tokens[Index].Event);
+      RemoveEntryList (&Instances[Index].AddrLink);
+    }
+
+    ChildCount = 0;
+  }
+
+  //
+  // Add Count children that accept every packet, each with a pending
+  // receive token.
+  //
+  VOID
+  AddChildren (
+    UINTN  Count
+    )
+  {
+    IP4_PROTOCOL  *Instance;
+    UINTN         Index;
+
+    ASSERT_LE (Count, (UINTN)IP4_INPUT_TEST_MAX_CHILDREN);
+
+    for (Index = 0; Index < Count; Index++) {
+      Instance = &Instances[Index];
+      ZeroMem (Instance, sizeof (IP4_PROTOCOL));
+      Instance->Signature                    = IP4_PROTOCOL_SIGNATURE;
+      Instance->State                        = IP4_STATE_CONFIGED;
+      Instance->Service                      = &IpSb;
+      Instance->Interface                    = &IpIf;
+      Instance->ConfigData.AcceptPromiscuous = TRUE;
+      InitializeListHead (&Instance->Received);
+      InitializeListHead (&Instance->Delivered);
+      NetMapInit (&Instance->RxTokens);
+      EfiInitializeLock (&Instance->RecycleLock, TPL_NOTIFY);
+      InsertTailList (&IpIf.IpInstances, &Instance->AddrLink);
+
+      ZeroMem (&Tokens[Index], sizeof (EFI_IP4_COMPLETION_TOKEN));
+      ASSERT_EQ (gBS->CreateEvent (EVT_NOTIFY_SIGNAL, TPL_CALLBACK, NULL, NULL, &Tokens[Index].Event), EFI_SUCCESS);
+      ASSERT_EQ (NetMapInsertTail (&Instance->RxTokens, &Tokens[Index], NULL), EFI_SUCCESS);
+      ChildCount++;
+    }
+  }
+
+  //
+  // Build the packet as Ip4AccpetFrame () hands it to Ip4Demultiplex ():
+  // the head is in host byte order and trimmed off the packet data.
+  //
+  EFI_STATUS
+  Receive (
+    )
+  {
+    NET_BUF        *Packet;
+    UINT8          *Data;
+    IP4_CLIP_INFO  *Info;
+
+    Packet = NetbufAlloc (IP4_MIN_HEADLEN + sizeof (Payload));
+    if (Packet == NULL) {
+      return EFI_OUT_OF_RESOURCES;
+    }
+
+    Data = NetbufAllocSpace (Packet, IP4_MIN_HEADLEN + sizeof (Payload), NET_BUF_TAIL);
+    CopyMem (Data, &Head, IP4_MIN_HEADLEN);
+    CopyMem (Data + IP4_MIN_HEADLEN, Payload, sizeof (Payload));
+    Received = Data;
+
+    Packet->Ip.Ip4 = Ip4NtohHead ((IP4_HEAD *)Data);
+    NetbufTrim (Packet, IP4_MIN_HEADLEN, NET_BUF_HEAD);
+
+    Info = IP4_GET_CLIP_INFO (Packet);
+    ZeroMem (Info, sizeof (IP4_CLIP_INFO));
+    Info->Status   = EFI_SUCCESS;
+    Info->CastType = IP4_LOCAL_HOST;
+
+    return Ip4Demultiplex (&IpSb, Packet->Ip.Ip4, Packet, NULL, 0);
+  }
+
+  //
+  // Count the bytes delivered up in RxData that do not reference the
+  // frame received from the interface, head included.
+  //
+  UINTN
+  CopiedBytes (
+    EFI_IP4_RECEIVE_DATA  *RxData
+    )
+  {
+    UINT8  *End;
+    UINT8  *Fragment;
+    UINTN  Copied;
+    UINTN  Index;
+
+    End    = Received + IP4_MIN_HEADLEN + sizeof (Payload);
+    Copied = 0;
+
+    if (((UINT8 *)RxData->Header < Received) || ((UINT8 *)RxData->Header >= End)) {
+      Copied += RxData->HeaderLength;
+    }
+
+    for (Index = 0; Index < RxData->FragmentCount; Index++) {
+      Fragment = (UINT8 *)RxData->FragmentTable[Index].FragmentBuffer;
+      if ((Fragment < Received) || (Fragment >= End)) {
+        Copied += RxData->FragmentTable[Index].FragmentLength;
+      }
+    }
+
+    return Copied;
+  }
+
+  //
+  // Check that RxData carries the head and the payload that were sent.
+  //
+  VOID
+  ExpectReceived (
+    EFI_IP4_RECEIVE_DATA  *RxData
+    )
+  {
+    UINT8  Data[IP4_INPUT_TEST_PAYLOAD_LEN];
+    UINTN  Offset;
+    UINTN  Index;
+
+    ASSERT_NE (RxData, nullptr);
+    ASSERT_EQ (RxData->HeaderLength, IP4_MIN_HEADLEN);
+    EXPECT_EQ (CompareMem (RxData->Header, &Head, IP4_MIN_HEADLEN), 0);
+    ASSERT_EQ (RxData->DataLength, sizeof (Payload));
+
+    Offset = 0;
+    for (Index = 0; Index < RxData->FragmentCount; Index++) {
+      ASSERT_LE (Offset + RxData->FragmentTable[Index].FragmentLength, sizeof (Data));
+      CopyMem (Data + Offset, RxData->FragmentTable[Index].FragmentBuffer, RxData->FragmentTable[Index].FragmentLength);
+      Offset += RxData->FragmentTable[Index].FragmentLength;
+    }
+
+    ASSERT_EQ (Offset, sizeof (Payload));
+    EXPECT_EQ (CompareMem (Data, Payload, sizeof (Payload)), 0);
+  }
+};
+
+// Test Description:
+// A packet shared by two children reaches both with the head in network
+// byte order, and each child owns its head.
+TEST_F (Ip4InputDeliverTest, SharedPacketShouldHaveIndependentHeaders) {
+  EFI_IP4_RECEIVE_DATA  *First;
+  EFI_IP4_RECEIVE_DATA  *Second;
+
+  AddChildren (2);
+  ASSERT_EQ (Receive (), EFI_SUCCESS);
+
+  EXPECT_EQ (((IP4_INPUT_TEST_EVENT *)Tokens[0].Event)->Signaled, 1U);
+  EXPECT_EQ (((IP4_INPUT_TEST_EVENT *)Tokens[1].Event)->Signaled, 1U);
+  EXPECT_EQ (Tokens[0].Status, EFI_SUCCESS);
+  EXPECT_EQ (Tokens[1].Status, EFI_SUCCESS);
+
+  First  = Tokens[0].Packet.RxData;
+  Second = Tokens[1].Packet.RxData;
+  ExpectReceived (First);
+  ExpectReceived (Second);
+  ASSERT_NE (First->Header, Second->Header);
+
+  //
+  // An upper layer scribbling on its head does not change the other's.
+  //
+  SetMem (First->Header, IP4_MIN_HEADLEN, 0xA5);
+  EXPECT_EQ (CompareMem (Second->Header, &Head, IP4_MIN_HEADLEN), 0);
+}
+
+// Test Description:
+// A packet delivered to a single child is handed up as received.
+TEST_F (Ip4InputDeliverTest, UnsharedPacketShouldNotBeCopied) {
+  AddChildren (1);
+  ASSERT_EQ (Receive (), EFI_SUCCESS);
+
+  ExpectReceived (Tokens[0].Packet.RxData);
+  EXPECT_EQ (CopiedBytes (Tokens[0].Packet.RxData), 0U);
+}
+
+// Test Description:
+// Bytes copied per byte delivered when the packet is shared by 1 to
+// IP4_INPUT_TEST_MAX_CHILDREN children. Only the heads may be copied,
+// the payload is referenced by every child.
+TEST_F (Ip4InputDeliverTest, SharedPayloadShouldNotBeCopied) {
+  UINTN  Count;
+  UINTN  Index;
+  UINTN  Copied;
+  UINTN  Delivered;
+
+  for (Count = 1; Count <= IP4_INPUT_TEST_MAX_CHILDREN; Count *= 2) {
+    AddChildren (Count);
+    ASSERT_EQ (Receive (), EFI_SUCCESS);
+
+    Copied    = 0;
+    Delivered = 0;
+    for (Index = 0; Index < Count; Index++) {
+      ExpectReceived (Tokens[Index].Packet.RxData);
+      Copied    += CopiedBytes (Tokens[Index].Packet.RxData);
+      Delivered += Tokens[Index].Packet.RxData->DataLength;
+    }
+
+    EXPECT_LE (Copied, Count * IP4_MIN_HEADLEN);
+
+    //
+    // Report the bytes copied per 1000 bytes delivered.
+    //
+    RecordProperty (
+      "CopiedPer1000Delivered" + std::to_string (Count) + "Children",
+      (int)((Copied * 1000) / Delivered)
+      );
+
+    Release ();
+  }
+}
@@ -1240,9 +1240,11 @@ Ip4WrapRxData (
 
 /**
   Deliver the received packets to upper layer if there are both received
-  requests and enqueued packets. If the enqueued packet is shared, it will
-  duplicate it to a non-shared packet, release the shared packet, then
-  deliver the non-shared packet up.
+  requests and enqueued packets. If the enqueued packet is shared, a new
+  packet with a private copy of the IP head is created to reference the
+  shared data, or for a raw IP child, the packet is duplicated to a
+  non-shared packet. The shared packet is released, then the new packet
+  is delivered up.
 
   @param[in]  IpInstance         The IP child to deliver the packet up.
 
@@ -1283,6 +1285,32 @@ Ip4InstanceDeliverPacket (
       }
 
       RemoveEntryList (&Packet->List);
+    } else if (!IpInstance->ConfigData.RawData && (Packet->TotalSize != 0)) {
+      //
+      // The packet is shared. Only the IP head, which is converted to
+      // network byte order in place when wrapped, needs its own copy.
+      // Reference the data instead of duplicating it.
+      //
+      Dup = NetbufGetFragment (Packet, 0, Packet->TotalSize, IP4_MAX_HEADLEN);
+
+      if (Dup == NULL) {
+        return EFI_OUT_OF_RESOURCES;
+      }
+
+      Dup->Ip.Ip4 = (IP4_HEAD *)Dup->BlockOp[0].BlockHead;
+      CopyMem (Dup->Ip.Ip4, Packet->Ip.Ip4, Packet->Ip.Ip4->HeadLen << 2);
+
+      Wrap = Ip4WrapRxData (IpInstance, Dup);
+
+      if (Wrap == NULL) {
+        NetbufFree (Dup);
+        return EFI_OUT_OF_RESOURCES;
+      }
+
+      RemoveEntryList (&Packet->List);
+      NetbufFree (Packet);
+
+      Packet = Dup;
     } else {
       //
       // Create a duplicated packet if this packet is shared
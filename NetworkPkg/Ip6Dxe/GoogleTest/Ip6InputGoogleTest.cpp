@@ -0,0 +1,490 @@
+/** @file
+  Tests for the delivery of received packets to the IP6 children in
+  Ip6Input.c.
+
+  Copyright (c) 2026, Intel Corporation. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+**/
+#include <gtest/gtest.h>
+
+extern "C" {
+  #include <Uefi.h>
+  #include <Library/BaseLib.h>
+  #include <Library/BaseMemoryLib.h>
+  #include <Library/DebugLib.h>
+  #include <Library/DpcLib.h>
+  #include <Library/MemoryAllocationLib.h>
+  #include <Library/UefiBootServicesTableLib.h>
+  #include "../Ip6Impl.h"
+}
+
+////////////////////////////////////////////////////////////////////////
+// Defines
+////////////////////////////////////////////////////////////////////////
+
+#define IP6_INPUT_TEST_MAX_CHILDREN  8
+#define IP6_INPUT_TEST_PAYLOAD_LEN   1400
+
+////////////////////////////////////////////////////////////////////////
+// Symbol Definitions
+// These are not directly under test - but required to compile
+////////////////////////////////////////////////////////////////////////
+EFI_IPSEC2_PROTOCOL  *mIpSec          = NULL;
+BOOLEAN              mIpSec2Installed = FALSE;
+
+EFI_STATUS
+EFIAPI
+DispatchDpc (
+  VOID
+  )
+{
+  return EFI_SUCCESS;
+}
+
+VOID
+Ip6CancelPacket (
+  IN IP6_INTERFACE  *IpIf,
+  IN NET_BUF        *Packet,
+  IN EFI_STATUS     IoStatus
+  )
+{
+}
+
+IP6_MLD_GROUP *
+Ip6FindMldEntry (
+  IN IP6_SERVICE       *IpSb,
+  IN EFI_IPv6_ADDRESS  *MulticastAddr
+  )
+{
+  return NULL;
+}
+
+VOID
+EFIAPI
+Ip6FreeTxToken (
+  IN VOID  *Context
+  )
+{
+}
+
+EFI_STATUS
+Ip6IcmpHandle (
+  IN IP6_SERVICE     *IpSb,
+  IN EFI_IP6_HEADER  *Head,
+  IN NET_BUF         *Packet
+  )
+{
+  return EFI_SUCCESS;
+}
+
+EFI_STATUS
+Ip6LeaveGroup (
+  IN IP6_SERVICE       *IpSb,
+  IN EFI_IPv6_ADDRESS  *Address
+  )
+{
+  return EFI_SUCCESS;
+}
+
+EFI_STATUS
+Ip6ReceiveFrame (
+  IN  IP6_FRAME_CALLBACK  CallBack,
+  IN  IP6_SERVICE         *IpSb
+  )
+{
+  return EFI_SUCCESS;
+}
+
+////////////////////////////////////////////////////////////////////////
+// Boot services used by the delivery and the recycling of a packet
+////////////////////////////////////////////////////////////////////////
+
+typedef struct {
+  EFI_EVENT_NOTIFY    Notify;
+  VOID                *Context;
+  UINTN               Signaled;
+} IP6_INPUT_TEST_EVENT;
+
+STATIC
+EFI_TPL
+EFIAPI
+Ip6InputTestRaiseTpl (
+  IN EFI_TPL  NewTpl
+  )
+{
+  return TPL_APPLICATION;
+}
+
+STATIC
+VOID
+EFIAPI
+Ip6InputTestRestoreTpl (
+  IN EFI_TPL  OldTpl
+  )
+{
+}
+
+STATIC
+EFI_STATUS
+EFIAPI
+Ip6InputTestFreePool (
+  IN VOID  *Buffer
+  )
+{
+  FreePool (Buffer);
+  return EFI_SUCCESS;
+}
+
+STATIC
+EFI_STATUS
+EFIAPI
+Ip6InputTestCreateEvent (
+  IN  UINT32            Type,
+  IN  EFI_TPL           NotifyTpl,
+  IN  EFI_EVENT_NOTIFY  NotifyFunction,
+  IN  VOID              *NotifyContext,
+  OUT EFI_EVENT         *Event
+  )
+{
+  IP6_INPUT_TEST_EVENT  *TestEvent;
+
+  TestEvent = (IP6_INPUT_TEST_EVENT *)AllocateZeroPool (sizeof (IP6_INPUT_TEST_EVENT));
+  if (TestEvent == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  TestEvent->Notify  = NotifyFunction;
+  TestEvent->Context = NotifyContext;
+  *Event             = TestEvent;
+  return EFI_SUCCESS;
+}
+
+STATIC
+EFI_STATUS
+EFIAPI
+Ip6InputTestSignalEvent (
+  IN EFI_EVENT  Event
+  )
+{
+  IP6_INPUT_TEST_EVENT  *TestEvent;
+
+  TestEvent = (IP6_INPUT_TEST_EVENT *)Event;
+  TestEvent->Signaled++;
+  if (TestEvent->Notify != NULL) {
+    TestEvent->Notify (Event, TestEvent->Context);
+  }
+
+  return EFI_SUCCESS;
+}
+
+STATIC
+EFI_STATUS
+EFIAPI
+Ip6InputTestCloseEvent (
+  IN EFI_EVENT  Event
+  )
+{
+  FreePool (Event);
+  return EFI_SUCCESS;
+}
+
+////////////////////////////////////////////////////////////////////////
+// Ip6Demultiplex Tests
+////////////////////////////////////////////////////////////////////////
+
+class Ip6InputDeliverTest : public ::testing::Test {
+protected:
+  EFI_BOOT_SERVICES *SavedBs;
+  EFI_BOOT_SERVICES Bs;
+  IP6_SERVICE IpSb;
+  IP6_INTERFACE IpIf;
+  IP6_PROTOCOL Instances[IP6_INPUT_TEST_MAX_CHILDREN];
+  EFI_IP6_COMPLETION_TOKEN Tokens[IP6_INPUT_TEST_MAX_CHILDREN];
+  UINTN ChildCount;
+  EFI_IP6_HEADER Head;
+  UINT8 Payload[IP6_INPUT_TEST_PAYLOAD_LEN];
+  UINT8 *Received;
+
+  virtual void
+  SetUp (
+    )
+  {
+    UINTN  Index;
+
+    ZeroMem (&Bs, sizeof (Bs));
+    Bs.RaiseTPL    = Ip6InputTestRaiseTpl;
+    Bs.RestoreTPL  = Ip6InputTestRestoreTpl;
+    Bs.FreePool    = Ip6InputTestFreePool;
+    Bs.CreateEvent = Ip6InputTestCreateEvent;
+    Bs.SignalEvent = Ip6InputTestSignalEvent;
+    Bs.CloseEvent  = Ip6InputTestCloseEvent;
+    SavedBs        = gBS;
+    gBS            = &Bs;
+
+    ZeroMem (&IpSb, sizeof (IpSb));
+    ZeroMem (&IpIf, sizeof (IpIf));
+    InitializeListHead (&IpSb.Interfaces);
+    InitializeListHead (&IpIf.IpInstances);
+    IpIf.Configured = TRUE;
+    InsertTailList (&IpSb.Interfaces, &IpIf.Link);
+    ChildCount = 0;
+
+    //
+    // A TCP segment from 2001:db8::1 to 2001:db8::2, in network byte order
+    //
+    ZeroMem (&Head, sizeof (Head));
+    Head.Version                = 6;
+    Head.FlowLabelL             = HTONS (0x1234);
+    Head.PayloadLength          = HTONS (IP6_INPUT_TEST_PAYLOAD_LEN);
+    Head.NextHeader             = EFI_IP_PROTO_TCP;
+    Head.HopLimit               = 64;
+    Head.SourceAddress.Addr[0]  = 0x20;
+    Head.SourceAddress.Addr[1]  = 0x01;
+    Head.SourceAddress.Addr[2]  = 0x0d;
+    Head.SourceAddress.Addr[3]  = 0xb8;
+    Head.SourceAddress.Addr[15] = 1;
+    CopyMem (&Head.DestinationAddress, &Head.SourceAddress, sizeof (EFI_IPv6_ADDRESS));
+    Head.DestinationAddress.Addr[15] = 2;
+
+    for (Index = 0; Index < sizeof (Payload); Index++) {
+      Payload[Index] = (UINT8)Index;
+    }
+
+    Received = NULL;
+  }
+
+  virtual void
+  TearDown (
+    )
+  {
+    Release ();
+    gBS = SavedBs;
+  }
+
+  //
+  // Recycle the packets delivered up, as the upper layer would, and
+  // remove the children.
+  //
+  VOID
+  Release (
+    )
+  {
+    UINTN  Index;
+
+    for (Index = 0; Index < ChildCount; Index++) {
+      if (Tokens[Index].Packet.RxData != NULL) {
+        gBS->SignalEvent (Tokens[Index].Packet.RxData->RecycleSignal);
+        Tokens[Index].Packet.RxData = NULL;
+      }
+
+      EXPECT_TRUE (IsListEmpty (&Instances[Index].Received));
+      EXPECT_TRUE (IsListEmpty (&Instances[Index].Delivered));
+      NetMapClean (&Instances[Index].RxTokens);
+      gBS->CloseEvent (Tokens[Index].Event);
+      RemoveEntryList (&Instances[Index].AddrLink);
+    }
+
+    ChildCount = 0;
+  }
+
+  //
+  // Add Count children that accept every packet, each with a pending
+  // receive token.
+  //
+  VOID
+  AddChildren (
+    UINTN  Count
+    )
+  {
+    IP6_PROTOCOL  *Instance;
+    UINTN         Index;
+
+    ASSERT_LE (Count, (UINTN)IP6_INPUT_TEST_MAX_CHILDREN);
+
+    for (Index = 0; Index < Count; Index++) {
+      Instance = &Instances[Index];
+      ZeroMem (Instance, sizeof (IP6_PROTOCOL));
+      Instance->Signature                    = IP6_PROTOCOL_SIGNATURE;
+      Instance->State                        = IP6_STATE_CONFIGED;
+      Instance->Service                      = &IpSb;
+      Instance->Interface                    = &IpIf;
+      Instance->ConfigData.AcceptPromiscuous = TRUE;
+      InitializeListHead (&Instance->Received);
+      InitializeListHead (&Instance->Delivered);
+      NetMapInit (&Instance->RxTokens);
+      EfiInitializeLock (&Instance->RecycleLock, TPL_NOTIFY);
+      InsertTailList (&IpIf.IpInstances, &Instance->AddrLink);
+
+      ZeroMem (&Tokens[Index], sizeof (EFI_IP6_COMPLETION_TOKEN));
+      ASSERT_EQ (gBS->CreateEvent (EVT_NOTIFY_SIGNAL, TPL_CALLBACK, NULL, NULL, &Tokens[Index].Event), EFI_SUCCESS);
+      ASSERT_EQ (NetMapInsertTail (&Instance->RxTokens, &Tokens[Index], NULL), EFI_SUCCESS);
+      ChildCount++;
+    }
+  }
+
+  //
+  // Build the packet as Ip6AcceptFrame () hands it to Ip6Demultiplex ():
+  // the head is in host byte order and trimmed off the packet data.
+  //
+  EFI_STATUS
+  Receive (
+    )
+  {
+    NET_BUF        *Packet;
+    UINT8          *Data;
+    IP6_CLIP_INFO  *Info;
+
+    Packet = NetbufAlloc (sizeof (EFI_IP6_HEADER) + sizeof (Payload));
+    if (Packet == NULL) {
+      return EFI_OUT_OF_RESOURCES;
+    }
+
+    Data = NetbufAllocSpace (Packet, sizeof (EFI_IP6_HEADER) + sizeof (Payload), NET_BUF_TAIL);
+    CopyMem (Data, &Head, sizeof (EFI_IP6_HEADER));
+    CopyMem (Data + sizeof (EFI_IP6_HEADER), Payload, sizeof (Payload));
+    Received = Data;
+
+    Packet->Ip.Ip6 = Ip6NtohHead ((EFI_IP6_HEADER *)Data);
+    NetbufTrim (Packet, sizeof (EFI_IP6_HEADER), NET_BUF_HEAD);
+
+    Info = IP6_GET_CLIP_INFO (Packet);
+    ZeroMem (Info, sizeof (IP6_CLIP_INFO));
+    Info->Status   = EFI_SUCCESS;
+    Info->CastType = Ip6Unicast;
+
+    return Ip6Demultiplex (&IpSb, Packet->Ip.Ip6, Packet);
+  }
+
+  //
+  // Count the bytes delivered up in RxData that do not reference the
+  // frame received from the interface, head included.
+  //
+  UINTN
+  CopiedBytes (
+    EFI_IP6_RECEIVE_DATA  *RxData
+    )
+  {
+    UINT8  *End;
+    UINT8  *Fragment;
+    UINTN  Copied;
+    UINTN  Index;
+
+    End    = Received + sizeof (EFI_IP6_HEADER) + sizeof (Payload);
+    Copied = 0;
+
+    if (((UINT8 *)RxData->Header < Received) || ((UINT8 *)RxData->Header >= End)) {
+      Copied += RxData->HeaderLength;
+    }
+
+    for (Index = 0; Index < RxData->FragmentCount; Index++) {
+      Fragment = (UINT8 *)RxData->FragmentTable[Index].FragmentBuffer;
+      if ((Fragment < Received) || (Fragment >= End)) {
+        Copied += RxData->FragmentTable[Index].FragmentLength;
+      }
+    }
+
+    return Copied;
+  }
+
+  //
+  // Check that RxData carries the head and the payload that were sent.
+  //
+  VOID
+  ExpectReceived (
+    EFI_IP6_RECEIVE_DATA  *RxData
+    )
+  {
+    UINT8  Data[IP6_INPUT_TEST_PAYLOAD_LEN];
+    UINTN  Offset;
+    UINTN  Index;
+
+    ASSERT_NE (RxData, nullptr);
+    ASSERT_EQ (RxData->HeaderLength, sizeof (EFI_IP6_HEADER));
+    EXPECT_EQ (CompareMem (RxData->Header, &Head, sizeof (EFI_IP6_HEADER)), 0);
+    ASSERT_EQ (RxData->DataLength, sizeof (Payload));
+
+    Offset = 0;
+    for (Index = 0; Index < RxData->FragmentCount; Index++) {
+      ASSERT_LE (Offset + RxData->FragmentTable[Index].FragmentLength, sizeof (Data));
+      CopyMem (Data + Offset, RxData->FragmentTable[Index].FragmentBuffer, RxData->FragmentTable[Index].FragmentLength);
+      Offset += RxData->FragmentTable[Index].FragmentLength;
+    }
+
+    ASSERT_EQ (Offset, sizeof (Payload));
+    EXPECT_EQ (CompareMem (Data, Payload, sizeof (Payload)), 0);
+  }
+};
+
+// Test Description:
+// A packet shared by two children reaches both with the head in network
+// byte order, and each child owns its head.
+TEST_F (Ip6InputDeliverTest, SharedPacketShouldHaveIndependentHeaders) {
+  EFI_IP6_RECEIVE_DATA  *First;
+  EFI_IP6_RECEIVE_DATA  *Second;
+
+  AddChildren (2);
+  ASSERT_EQ (Receive (), EFI_SUCCESS);
+
+  EXPECT_EQ (((IP6_INPUT_TEST_EVENT *)Tokens[0].Event)->Signaled, 1U);
+  EXPECT_EQ (((IP6_INPUT_TEST_EVENT *)Tokens[1].Event)->Signaled, 1U);
+  EXPECT_EQ (Tokens[0].Status, EFI_SUCCESS);
+  EXPECT_EQ (Tokens[1].Status, EFI_SUCCESS);
+
+  First  = Tokens[0].Packet.RxData;
+  Second = Tokens[1].Packet.RxData;
+  ExpectReceived (First);
+  ExpectReceived (Second);
+  ASSERT_NE (First->Header, Second->Header);
+
+  //
+  // An upper layer scribbling on its head does not change the other's.
+  //
+  SetMem (First->Header, sizeof (EFI_IP6_HEADER), 0xA5);
+  EXPECT_EQ (CompareMem (Second->Header, &Head, sizeof (EFI_IP6_HEADER)), 0);
+}
+
+// Test Description:
+// A packet delivered to a single child is handed up as received.
+TEST_F (Ip6InputDeliverTest, UnsharedPacketShouldNotBeCopied) {
+  AddChildren (1);
+  ASSERT_EQ (Receive (), EFI_SUCCESS);
+
+  ExpectReceived (Tokens[0].Packet.RxData);
+  EXPECT_EQ (CopiedBytes (Tokens[0].Packet.RxData), 0U);
+}
+
+// Test Description:
+// Bytes copied per byte delivered when the packet is shared by 1 to
+// IP6_INPUT_TEST_MAX_CHILDREN children. Only the heads may be copied,
+// the payload is referenced by every child.
+TEST_F (Ip6InputDeliverTest, SharedPayloadShouldNotBeCopied) {
+  UINTN  Count;
+  UINTN  Index;
+  UINTN  Copied;
+  UINTN  Delivered;
+
+  for (Count = 1; Count <= IP6_INPUT_TEST_MAX_CHILDREN; Count *= 2) {
+    AddChildren (Count);
+    ASSERT_EQ (Receive (), EFI_SUCCESS);
+
+    Copied    = 0;
+    Delivered = 0;
+    for (Index = 0; Index < Count; Index++) {
+      ExpectReceived (Tokens[Index].Packet.RxData);
+      Copied    += CopiedBytes (Tokens[Index].Packet.RxData);
+      Delivered += Tokens[Index].Packet.RxData->DataLength;
+    }
+
+    EXPECT_LE (Copied, Count * sizeof (EFI_IP6_HEADER));
+
+    //
+    // Report the bytes copied per 1000 bytes delivered.
+    //
+    RecordProperty (
+      "CopiedPer1000Delivered" + std::to_string (Count) + "Children",
+      (int)((Copied * 1000) / Delivered)
+      );
+
+    Release ();
+  }
+}
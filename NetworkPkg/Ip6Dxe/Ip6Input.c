@@ -1450,9 +1450,10 @@ Ip6InstanceEnquePacket (
 
 /**
   Deliver the received packets to the upper layer if there are both received
-  requests and enqueued packets. If the enqueued packet is shared, it will
-  duplicate it to a non-shared packet, release the shared packet, then
-  deliver the non-shared packet up.
+  requests and enqueued packets. If the enqueued packet is shared, a new
+  packet with a private copy of the IP head is created to reference the
+  shared data, then the shared packet is released and the new packet is
+  delivered up.
 
   @param[in]  IpInstance         The IP child to deliver the packet up.
 
@@ -1490,6 +1491,32 @@ Ip6InstanceDeliverPacket (
       }
 
       RemoveEntryList (&Packet->List);
+    } else if (Packet->TotalSize != 0) {
+      //
+      // The packet is shared. Only the IP head, which is converted to
+      // network byte order in place when wrapped, needs its own copy.
+      // Reference the data instead of duplicating it.
+      //
+      Dup = NetbufGetFragment (Packet, 0, Packet->TotalSize, sizeof (EFI_IP6_HEADER));
+
+      if (Dup == NULL) {
+        return EFI_OUT_OF_RESOURCES;
+      }
+
+      Dup->Ip.Ip6 = (EFI_IP6_HEADER *)Dup->BlockOp[0].BlockHead;
+      CopyMem (Dup->Ip.Ip6, Packet->Ip.Ip6, sizeof (EFI_IP6_HEADER));
+
+      Wrap = Ip6WrapRxData (IpInstance, Dup);
+
+      if (Wrap == NULL) {
+        NetbufFree (Dup);
+        return EFI_OUT_OF_RESOURCES;
+      }
+
+      RemoveEntryList (&Packet->List);
+      NetbufFree (Packet);
+
+      Packet = Dup;
     } else {
       //
       // Create a duplicated packet if this packet is shared
@@ -513,8 +513,14 @@ MnpInitializeDeviceData (
   MnpDeviceData->TxBufCount = 0;
 
   //
-  // Create the system poll timer.
+  // Create the system poll timer. Timer events are only checked on a timer
+  // tick, so adaptive polling cannot poll faster than the platform tick. On
+  // OVMF the tick is 10ms and the 1ms minimum interval has no effect, only
+  // the receive batch helps there.
   //
+  MnpDeviceData->AdaptivePoll = PcdGetBool (PcdMnpAdaptivePolling);
+  MnpDeviceData->PollInterval = MNP_SYS_POLL_INTERVAL;
+
   Status = gBS->CreateEvent (
                   EVT_NOTIFY_SIGNAL | EVT_TIMER,
                   TPL_CALLBACK,
@@ -776,12 +782,14 @@ MnpCreateServiceData (
   MnpServiceData->Priority      = Priority;
 
   //
-  // Install the MNP Service Binding Protocol
+  // Install the MNP Service Binding Protocol and the packet counters of the device
   //
   Status = gBS->InstallMultipleProtocolInterfaces (
                   &MnpServiceHandle,
                   &gEfiManagedNetworkServiceBindingProtocolGuid,
                   &MnpServiceData->ServiceBinding,
+                  &gEdkiiMnpStatisticsProtocolGuid,
+                  &MnpDeviceData->Statistics,
                   NULL
                   );
 
@@ -811,12 +819,14 @@ MnpDestroyServiceData (
   EFI_STATUS  Status;
 
   //
-  // Uninstall the MNP Service Binding Protocol
+  // Uninstall the MNP Service Binding Protocol and the packet counters
   //
   Status = gBS->UninstallMultipleProtocolInterfaces (
                   MnpServiceData->ServiceHandle,
                   &gEfiManagedNetworkServiceBindingProtocolGuid,
                   &MnpServiceData->ServiceBinding,
+                  &gEdkiiMnpStatisticsProtocolGuid,
+                  &MnpServiceData->MnpDeviceData->Statistics,
                   NULL
                   );
   if (EFI_ERROR (Status)) {
@@ -1273,6 +1283,8 @@ MnpStart (
     }
 
     MnpDeviceData->EnableSystemPoll = EnableSystemPoll;
+    MnpDeviceData->PollInterval     = MNP_SYS_POLL_INTERVAL;
+    MnpDeviceData->IdlePollCount    = 0;
   }
 
   //
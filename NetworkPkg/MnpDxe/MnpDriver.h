@@ -15,6 +15,7 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #include <Protocol/SimpleNetwork.h>
 #include <Protocol/ServiceBinding.h>
 #include <Protocol/VlanConfig.h>
+#include <Protocol/MnpStatistics.h>
 
 #include <Library/BaseLib.h>
 #include <Library/BaseMemoryLib.h>
@@ -27,6 +28,7 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #include <Library/UefiRuntimeServicesTableLib.h>
 #include <Library/DevicePathLib.h>
 #include <Library/PrintLib.h>
+#include <Library/PcdLib.h>
 
 #include "ComponentName.h"
 
@@ -70,6 +72,14 @@ typedef struct {
   EFI_EVENT                      PollTimer;
   BOOLEAN                        EnableSystemPoll;
 
+  //
+  // With adaptive polling, the poll timer period shrinks when packets are
+  // received and grows back to MNP_SYS_POLL_INTERVAL when the link is idle.
+  //
+  BOOLEAN                        AdaptivePoll;
+  UINT64                         PollInterval;
+  UINT32                         IdlePollCount;
+
   EFI_EVENT                      TimeoutCheckTimer;
   EFI_EVENT                      MediaDetectTimer;
 
@@ -85,6 +95,11 @@ typedef struct {
   UINT32                         BufferLength;
   UINT32                         PaddingSize;
   NET_BUF                        *RxNbufCache;
+
+  //
+  // Packet counters, published on every MNP service handle of the device.
+  //
+  EDKII_MNP_STATISTICS_PROTOCOL  Statistics;
 } MNP_DEVICE_DATA;
 
 #define MNP_DEVICE_DATA_FROM_THIS(a) \
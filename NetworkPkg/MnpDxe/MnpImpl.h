@@ -14,6 +14,8 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #define NET_ETHER_FCS_SIZE  4
 
 #define MNP_SYS_POLL_INTERVAL        (10 * TICKS_PER_MS)    // 10 milliseconds
+#define MNP_SYS_POLL_INTERVAL_MIN    (1 * TICKS_PER_MS)     // 1 millisecond, if the timer tick allows it
+#define MNP_SYS_POLL_IDLE_THRESHOLD  4                      // Idle polls before the interval is doubled.
 #define MNP_TIMEOUT_CHECK_INTERVAL   (50 * TICKS_PER_MS)    // 50 milliseconds
 #define MNP_MEDIA_DETECT_INTERVAL    (500 * TICKS_PER_MS)   // 500 milliseconds
 #define MNP_TX_TIMEOUT_TIME          (500 * TICKS_PER_MS)   // 500 milliseconds
@@ -25,6 +27,11 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 
 #define MNP_MAX_RCVD_PACKET_QUE_SIZE  256
 
+//
+// Max number of packets received from SNP in one poll.
+//
+#define MNP_RX_BATCH_SIZE  32
+
 #define MNP_RECEIVE_UNICAST    0x01
 #define MNP_RECEIVE_BROADCAST  0x02
 
@@ -430,6 +437,24 @@ MnpReceivePacket (
   IN OUT MNP_DEVICE_DATA  *MnpDeviceData
   );
 
+/**
+  Receive and deliver the packets pending in Snp, up to MNP_RX_BATCH_SIZE
+  packets.
+
+  @param[in, out]  MnpDeviceData        Pointer to the mnp device context data.
+  @param[out]      Received             Pointer to the number of packets received,
+                                        optional.
+
+  @retval EFI_SUCCESS           At least one packet is received.
+  @retval Others                The status of the first MnpReceivePacket().
+
+**/
+EFI_STATUS
+MnpReceivePackets (
+  IN OUT MNP_DEVICE_DATA  *MnpDeviceData,
+  OUT    UINTN            *Received OPTIONAL
+  );
+
 /**
   Allocate a free NET_BUF from MnpDeviceData->FreeNbufQue. If there is none
   in the queue, first try to allocate some and add them into the queue, then
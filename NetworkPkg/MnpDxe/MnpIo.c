@@ -185,6 +185,35 @@ MnpBuildTxPacket (
   return EFI_SUCCESS;
 }
 
+/**
+  Change the period of the system poll timer, if adaptive polling is enabled
+  and the system poll is on.
+
+  @param[in, out]  MnpDeviceData      Pointer to the mnp device context data.
+  @param[in]       Interval           The new poll interval, in 100ns units.
+
+**/
+STATIC
+VOID
+MnpSetPollInterval (
+  IN OUT MNP_DEVICE_DATA  *MnpDeviceData,
+  IN     UINT64           Interval
+  )
+{
+  EFI_STATUS  Status;
+
+  if (!MnpDeviceData->AdaptivePoll || !MnpDeviceData->EnableSystemPoll ||
+      (MnpDeviceData->PollInterval == Interval))
+  {
+    return;
+  }
+
+  Status = gBS->SetTimer (MnpDeviceData->PollTimer, TimerPeriodic, Interval);
+  if (!EFI_ERROR (Status)) {
+    MnpDeviceData->PollInterval = Interval;
+  }
+}
+
 /**
   Synchronously send out the packet.
 
@@ -281,6 +310,18 @@ MnpSyncSendPacket (
 
 SIGNAL_TOKEN:
 
+  if (EFI_ERROR (Token->Status)) {
+    MnpDeviceData->Statistics.TxDropped++;
+  } else {
+    MnpDeviceData->Statistics.TxPackets++;
+
+    //
+    // A response is likely on its way, poll for it quickly.
+    //
+    MnpDeviceData->IdlePollCount = 0;
+    MnpSetPollInterval (MnpDeviceData, MNP_SYS_POLL_INTERVAL_MIN);
+  }
+
   gBS->SignalEvent (Token->Event);
 
   //
@@ -496,6 +537,7 @@ MnpQueueRcvdPacket (
     //
     MnpRecycleRxData (NULL, (VOID *)OldRxDataWrap);
     Instance->RcvdPacketQueueSize--;
+    Instance->MnpServiceData->MnpDeviceData->Statistics.RxDropped++;
   }
 
   //
@@ -887,6 +929,10 @@ MnpReceivePacket (
 
     DEBUG_CODE_END ();
 
+    if ((Status != EFI_NOT_READY) && (Status != EFI_NOT_STARTED)) {
+      MnpDeviceData->Statistics.RxDropped++;
+    }
+
     return Status;
   }
 
@@ -900,9 +946,12 @@ MnpReceivePacket (
        HeaderSize,
        BufLen)
       );
+    MnpDeviceData->Statistics.RxDropped++;
     return EFI_DEVICE_ERROR;
   }
 
+  MnpDeviceData->Statistics.RxPackets++;
+
   Trimmed = 0;
   if (Nbuf->TotalSize != BufLen) {
     //
@@ -927,6 +976,8 @@ MnpReceivePacket (
     //
     // VLAN is not set for this tagged frame, ignore this packet
     //
+    MnpDeviceData->Statistics.RxDropped++;
+
     if (Trimmed > 0) {
       NetbufAllocSpace (Nbuf, Trimmed, NET_BUF_TAIL);
     }
@@ -985,6 +1036,47 @@ EXIT:
   return Status;
 }
 
+/**
+  Receive and deliver the packets pending in Snp, up to MNP_RX_BATCH_SIZE
+  packets.
+
+  @param[in, out]  MnpDeviceData        Pointer to the mnp device context data.
+  @param[out]      Received             Pointer to the number of packets received,
+                                        optional.
+
+  @retval EFI_SUCCESS           At least one packet is received.
+  @retval Others                The status of the first MnpReceivePacket().
+
+**/
+EFI_STATUS
+MnpReceivePackets (
+  IN OUT MNP_DEVICE_DATA  *MnpDeviceData,
+  OUT    UINTN            *Received OPTIONAL
+  )
+{
+  EFI_STATUS  Status;
+  UINTN       Count;
+
+  Status = EFI_NOT_READY;
+
+  for (Count = 0; Count < MNP_RX_BATCH_SIZE; Count++) {
+    Status = MnpReceivePacket (MnpDeviceData);
+    if (EFI_ERROR (Status)) {
+      break;
+    }
+  }
+
+  if (Received != NULL) {
+    *Received = Count;
+  }
+
+  if (Count != 0) {
+    return EFI_SUCCESS;
+  }
+
+  return Status;
+}
+
 /**
   Remove the received packets if timeout occurs.
 
@@ -1044,6 +1136,7 @@ MnpCheckPacketTimeout (
           DEBUG ((DEBUG_WARN, "MnpCheckPacketTimeout: Received packet timeout.\n"));
           MnpRecycleRxData (NULL, RxDataWrap);
           Instance->RcvdPacketQueueSize--;
+          MnpDeviceData->Statistics.RxDropped++;
         }
       }
 
@@ -1099,6 +1192,8 @@ MnpSystemPoll (
   )
 {
   MNP_DEVICE_DATA  *MnpDeviceData;
+  UINTN            Received;
+  UINT64           Interval;
 
   MnpDeviceData = (MNP_DEVICE_DATA *)Context;
   NET_CHECK_SIGNATURE (MnpDeviceData, MNP_DEVICE_DATA_SIGNATURE);
@@ -1106,10 +1201,34 @@ MnpSystemPoll (
   //
   // Try to receive packets from Snp.
   //
-  MnpReceivePacket (MnpDeviceData);
+  MnpReceivePackets (MnpDeviceData, &Received);
 
   //
   // Dispatch the DPC queued by the NotifyFunction of rx token's events.
   //
   DispatchDpc ();
+
+  //
+  // Poll more often while packets are arriving, and back off gradually
+  // after several polls found nothing.
+  //
+  Interval = MnpDeviceData->PollInterval;
+  if (Received == MNP_RX_BATCH_SIZE) {
+    //
+    // Packets are left in Snp, poll as fast as possible.
+    //
+    MnpDeviceData->IdlePollCount = 0;
+    Interval                     = MNP_SYS_POLL_INTERVAL_MIN;
+  } else if (Received != 0) {
+    MnpDeviceData->IdlePollCount = 0;
+    Interval                     = MAX (Interval / 2, MNP_SYS_POLL_INTERVAL_MIN);
+  } else {
+    MnpDeviceData->IdlePollCount++;
+    if (MnpDeviceData->IdlePollCount >= MNP_SYS_POLL_IDLE_THRESHOLD) {
+      MnpDeviceData->IdlePollCount = 0;
+      Interval                     = MIN (Interval * 2, MNP_SYS_POLL_INTERVAL);
+    }
+  }
+
+  MnpSetPollInterval (MnpDeviceData, Interval);
 }
@@ -0,0 +1,593 @@
+/** @file
+  Tests for the SACK option, the SACK scoreboard and the congestion
+  control algorithms of TcpDxe.
+
+  Copyright (c) 2026, Intel Corporation. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+**/
+#include <gtest/gtest.h>
+
+extern "C" {
+  #include <Uefi.h>
+  #include <Library/BaseLib.h>
+  #include <Library/BaseMemoryLib.h>
+  #include <Library/DebugLib.h>
+  #include "../TcpMain.h"
+}
+
+////////////////////////////////////////////////////////////////////////
+// Symbol Definitions
+// These are not directly under test - but required to compile
+////////////////////////////////////////////////////////////////////////
+UINT32  mTcpTick = 1000;
+
+TCP_SEQNO  mRetransmitSeq;
+UINT32     mRetransmitLen;
+UINTN      mRetransmitCount;
+
+//
+// When not 0, the length TcpRetransmitRange () reports as sent, as if
+// a queued segment ended or the transmission failed (-1).
+//
+INTN  mRetransmitSent;
+
+INTN
+TcpRetransmitRange (
+  IN TCP_CB     *Tcb,
+  IN TCP_SEQNO  Seq,
+  IN UINT32     MaxLen
+  )
+{
+  mRetransmitSeq = Seq;
+  mRetransmitLen = MaxLen;
+  mRetransmitCount++;
+  if (mRetransmitSent != 0) {
+    return MIN (mRetransmitSent, (INTN)MaxLen);
+  }
+
+  return MaxLen;
+}
+
+////////////////////////////////////////////////////////////////////////
+// TcpParseOption Tests
+////////////////////////////////////////////////////////////////////////
+
+class TcpParseSackOptionTest : public ::testing::Test {
+protected:
+  UINT8 Buffer[sizeof (TCP_HEAD) + TCP_OPTION_MAX_LEN];
+  TCP_HEAD *Head;
+  TCP_OPTION Option;
+
+  virtual void
+  SetUp (
+    )
+  {
+    ZeroMem (Buffer, sizeof (Buffer));
+    Head = (TCP_HEAD *)Buffer;
+  }
+
+  INTN
+  Parse (
+    const UINT8  *Options,
+    UINTN        Length
+    )
+  {
+    CopyMem (Head + 1, Options, Length);
+    Head->HeadLen = (UINT8)((sizeof (TCP_HEAD) + Length) >> 2);
+    return TcpParseOption (Head, &Option);
+  }
+};
+
+// Test Description:
+// The SACK permitted option in a SYN is recognized.
+TEST_F (TcpParseSackOptionTest, SackPermittedShouldBeParsed) {
+  const UINT8  Options[] = {
+    TCP_OPTION_MSS,       TCP_OPTION_MSS_LEN,       0x05, 0xb4,
+    TCP_OPTION_NOP,       TCP_OPTION_NOP,
+    TCP_OPTION_SACK_PERM, TCP_OPTION_SACK_PERM_LEN
+  };
+
+  ASSERT_EQ (Parse (Options, sizeof (Options)), 0);
+  EXPECT_TRUE (TCP_FLG_ON (Option.Flag, TCP_OPTION_RCVD_MSS));
+  EXPECT_TRUE (TCP_FLG_ON (Option.Flag, TCP_OPTION_RCVD_SACK_PERM));
+  EXPECT_EQ (Option.Mss, 1460);
+}
+
+// Test Description:
+// The blocks of a SACK option behind a timestamp option are parsed.
+TEST_F (TcpParseSackOptionTest, SackBlocksShouldBeParsed) {
+  const UINT8  Options[] = {
+    TCP_OPTION_NOP,  TCP_OPTION_NOP, TCP_OPTION_TS, TCP_OPTION_TS_LEN,
+    0,               0,              0,             1,
+    0,               0,              0,             2,
+    TCP_OPTION_NOP,  TCP_OPTION_NOP, TCP_OPTION_SACK, 18,
+    0x00,            0x00,           0x10,          0x00,
+    0x00,            0x00,           0x20,          0x00,
+    0xff,            0xff,           0xff,          0xf0,
+    0x00,            0x00,           0x00,          0x10
+  };
+
+  ASSERT_EQ (Parse (Options, sizeof (Options)), 0);
+  EXPECT_TRUE (TCP_FLG_ON (Option.Flag, TCP_OPTION_RCVD_TS));
+  EXPECT_TRUE (TCP_FLG_ON (Option.Flag, TCP_OPTION_RCVD_SACK));
+  ASSERT_EQ (Option.SackNum, 2);
+  EXPECT_EQ (Option.SackBlock[0].Seq, 0x1000U);
+  EXPECT_EQ (Option.SackBlock[0].End, 0x2000U);
+  EXPECT_EQ (Option.SackBlock[1].Seq, 0xfffffff0U);
+  EXPECT_EQ (Option.SackBlock[1].End, 0x10U);
+}
+
+// Test Description:
+// A SACK option whose length isn't 2 + 8 * n is illegal.
+TEST_F (TcpParseSackOptionTest, SackWithBadLengthShouldFail) {
+  const UINT8  Options[] = {
+    TCP_OPTION_SACK, 11,
+    0,               0,0, 1, 0, 0, 0, 2, 0,
+    TCP_OPTION_EOP
+  };
+
+  EXPECT_EQ (Parse (Options, sizeof (Options)), -1);
+}
+
+// Test Description:
+// A SACK option running past the option field is illegal.
+TEST_F (TcpParseSackOptionTest, TruncatedSackShouldFail) {
+  const UINT8  Options[] = {
+    TCP_OPTION_NOP,  TCP_OPTION_NOP,
+    TCP_OPTION_SACK, 18,
+    0,               0,0, 1, 0, 0, 0, 2
+  };
+
+  EXPECT_EQ (Parse (Options, sizeof (Options)), -1);
+}
+
+// Test Description:
+// A SACK permitted option with a wrong length is illegal.
+TEST_F (TcpParseSackOptionTest, SackPermittedWithBadLengthShouldFail) {
+  const UINT8  Options[] = {
+    TCP_OPTION_NOP,       TCP_OPTION_NOP,
+    TCP_OPTION_SACK_PERM, 3
+  };
+
+  EXPECT_EQ (Parse (Options, sizeof (Options)), -1);
+}
+
+////////////////////////////////////////////////////////////////////////
+// TcpSynBuildOption and TcpBuildOption Tests
+////////////////////////////////////////////////////////////////////////
+
+class TcpBuildSackOptionTest : public ::testing::Test {
+protected:
+  TCP_CB Tcb;
+  NET_BUF *Nbuf;
+
+  virtual void
+  SetUp (
+    )
+  {
+    ZeroMem (&Tcb, sizeof (Tcb));
+    InitializeListHead (&Tcb.RcvQue);
+    Tcb.RcvMss = 1460;
+
+    Nbuf = NetbufAlloc (TCP_MAX_HEAD);
+    ASSERT_NE (Nbuf, nullptr);
+    NetbufReserve (Nbuf, TCP_MAX_HEAD);
+  }
+
+  virtual void
+  TearDown (
+    )
+  {
+    NET_BUF  *Node;
+
+    NetbufFree (Nbuf);
+
+    while (!IsListEmpty (&Tcb.RcvQue)) {
+      Node = NET_LIST_HEAD (&Tcb.RcvQue, NET_BUF, List);
+      RemoveEntryList (&Node->List);
+      NetbufFree (Node);
+    }
+  }
+
+  VOID
+  QueueSegment (
+    TCP_SEQNO  Seq,
+    TCP_SEQNO  End
+    )
+  {
+    NET_BUF  *Node;
+
+    Node = NetbufAlloc (1);
+    ASSERT_NE (Node, nullptr);
+    TCPSEG_NETBUF (Node)->Seq = Seq;
+    TCPSEG_NETBUF (Node)->End = End;
+    InsertTailList (&Tcb.RcvQue, &Node->List);
+  }
+
+  UINT32
+  GetUint32 (
+    UINTN  Offset
+    )
+  {
+    UINT8  *Data;
+
+    Data = NetbufGetByte (Nbuf, (UINT32)Offset, NULL);
+    return (UINT32)((Data[0] << 24) | (Data[1] << 16) | (Data[2] << 8) | Data[3]);
+  }
+};
+
+// Test Description:
+// The SYN of an active open offers SACK, unless SACK is disabled.
+TEST_F (TcpBuildSackOptionTest, SynShouldOfferSackPermitted) {
+  Tcb.CtrlFlag = TCP_CTRL_NO_TS | TCP_CTRL_NO_WS;
+  TCPSEG_NETBUF (Nbuf)->Flag = TCP_FLG_SYN;
+
+  ASSERT_EQ (TcpSynBuildOption (&Tcb, Nbuf), TCP_OPTION_SP_ALIGNED_LEN + TCP_OPTION_MSS_LEN);
+  EXPECT_EQ (GetUint32 (0), (UINT32)(TCP_OPTION_MSS_FAST | 1460));
+  EXPECT_EQ (GetUint32 (4), (UINT32)TCP_OPTION_SACK_PERM_FAST);
+}
+
+// Test Description:
+// The SYN/ACK of a passive open only offers SACK if the peer did.
+TEST_F (TcpBuildSackOptionTest, SynAckShouldOnlyEchoSackPermitted) {
+  Tcb.CtrlFlag = TCP_CTRL_NO_TS | TCP_CTRL_NO_WS;
+  TCPSEG_NETBUF (Nbuf)->Flag = TCP_FLG_SYN | TCP_FLG_ACK;
+
+  EXPECT_EQ (TcpSynBuildOption (&Tcb, Nbuf), TCP_OPTION_MSS_LEN);
+}
+
+// Test Description:
+// An ACK reports the out-of-order ranges, the most recent one first,
+// and no more than fit beside the timestamp option.
+TEST_F (TcpBuildSackOptionTest, AckShouldReportMostRecentRangeFirst) {
+  Tcb.CtrlFlag = TCP_CTRL_RCVD_SACK | TCP_CTRL_SND_TS;
+  Tcb.RcvNxt   = 1000;
+
+  QueueSegment (2000, 3000);
+  QueueSegment (3000, 4000);
+  QueueSegment (5000, 6000);
+  QueueSegment (7000, 8000);
+  QueueSegment (9000, 10000);
+  Tcb.RcvSackRecent = 7000;
+
+  ASSERT_EQ (TcpBuildOption (&Tcb, Nbuf), TCP_OPTION_MAX_LEN);
+
+  //
+  // The SACK option is in front of the timestamp option.
+  //
+  EXPECT_EQ (GetUint32 (0), (UINT32)(TCP_OPTION_SACK_FAST | 26));
+  EXPECT_EQ (GetUint32 (4), 7000U);
+  EXPECT_EQ (GetUint32 (8), 8000U);
+  EXPECT_EQ (GetUint32 (12), 2000U);
+  EXPECT_EQ (GetUint32 (16), 4000U);
+  EXPECT_EQ (GetUint32 (20), 5000U);
+  EXPECT_EQ (GetUint32 (24), 6000U);
+  EXPECT_EQ (GetUint32 (28), (UINT32)TCP_OPTION_TS_FAST);
+}
+
+// Test Description:
+// Without out-of-order data, no SACK is sent.
+TEST_F (TcpBuildSackOptionTest, NoSackWithoutOutOfOrderData) {
+  Tcb.CtrlFlag = TCP_CTRL_RCVD_SACK;
+  Tcb.RcvNxt   = 1000;
+
+  EXPECT_EQ (TcpBuildOption (&Tcb, Nbuf), 0);
+}
+
+////////////////////////////////////////////////////////////////////////
+// SACK scoreboard Tests
+////////////////////////////////////////////////////////////////////////
+
+class TcpSackScoreboardTest : public ::testing::Test {
+protected:
+  TCP_CB Tcb;
+  TCP_OPTION Option;
+
+  virtual void
+  SetUp (
+    )
+  {
+    ZeroMem (&Tcb, sizeof (Tcb));
+    ZeroMem (&Option, sizeof (Option));
+    Tcb.CtrlFlag = TCP_CTRL_RCVD_SACK;
+    Tcb.SndMss   = 1000;
+    Tcb.SndUna   = 10000;
+    Tcb.SndNxt   = 20000;
+    Tcb.HighRxt  = Tcb.SndUna;
+
+    mRetransmitCount = 0;
+    mRetransmitSent  = 0;
+  }
+
+  VOID
+  Sack (
+    TCP_SEQNO  Ack,
+    TCP_SEQNO  Seq,
+    TCP_SEQNO  End
+    )
+  {
+    Option.Flag                  = TCP_OPTION_RCVD_SACK;
+    Option.SackNum               = 1;
+    Option.SackBlock[0].Seq      = Seq;
+    Option.SackBlock[0].End      = End;
+    TcpSackUpdate (&Tcb, &Option, Ack);
+  }
+};
+
+// Test Description:
+// Overlapping and abutting ranges are merged and kept in order.
+TEST_F (TcpSackScoreboardTest, RangesShouldBeMerged) {
+  Sack (10000, 15000, 16000);
+  Sack (10000, 12000, 13000);
+  Sack (10000, 13000, 14000);
+  Sack (10000, 15500, 17000);
+
+  ASSERT_EQ (Tcb.SackBlockNum, 2);
+  EXPECT_EQ (Tcb.SackBlock[0].Seq, 12000U);
+  EXPECT_EQ (Tcb.SackBlock[0].End, 14000U);
+  EXPECT_EQ (Tcb.SackBlock[1].Seq, 15000U);
+  EXPECT_EQ (Tcb.SackBlock[1].End, 17000U);
+
+  Sack (10000, 11000, 18000);
+  ASSERT_EQ (Tcb.SackBlockNum, 1);
+  EXPECT_EQ (Tcb.SackBlock[0].Seq, 11000U);
+  EXPECT_EQ (Tcb.SackBlock[0].End, 18000U);
+}
+
+// Test Description:
+// Ranges outside SND.UNA and SND.NXT are dropped or trimmed.
+TEST_F (TcpSackScoreboardTest, BogusRangesShouldBeIgnored) {
+  Sack (10000, 5000, 9000);
+  Sack (10000, 19000, 21000);
+  Sack (10000, 16000, 15000);
+  EXPECT_EQ (Tcb.SackBlockNum, 0);
+
+  Sack (10000, 9000, 11000);
+  ASSERT_EQ (Tcb.SackBlockNum, 1);
+  EXPECT_EQ (Tcb.SackBlock[0].Seq, 10000U);
+  EXPECT_EQ (Tcb.SackBlock[0].End, 11000U);
+}
+
+// Test Description:
+// A cumulative ACK removes the ranges below it.
+TEST_F (TcpSackScoreboardTest, AckShouldTrimRanges) {
+  Sack (10000, 12000, 13000);
+  Sack (10000, 14000, 15000);
+
+  Option.Flag = 0;
+  TcpSackUpdate (&Tcb, &Option, 14500);
+
+  ASSERT_EQ (Tcb.SackBlockNum, 1);
+  EXPECT_EQ (Tcb.SackBlock[0].Seq, 14500U);
+  EXPECT_EQ (Tcb.SackBlock[0].End, 15000U);
+}
+
+// Test Description:
+// A full scoreboard drops the highest range.
+TEST_F (TcpSackScoreboardTest, FullScoreboardShouldDropHighestRange) {
+  UINT32  Index;
+
+  Tcb.SndNxt = 100000;
+  for (Index = 0; Index < TCP_SACK_SCOREBOARD_MAX; Index++) {
+    Sack (10000, 20000 + Index * 2000, 21000 + Index * 2000);
+  }
+
+  Sack (10000, 11000, 12000);
+  ASSERT_EQ (Tcb.SackBlockNum, TCP_SACK_SCOREBOARD_MAX);
+  EXPECT_EQ (Tcb.SackBlock[0].Seq, 11000U);
+  EXPECT_EQ (Tcb.SackBlock[TCP_SACK_SCOREBOARD_MAX - 1].Seq, 20000U + (TCP_SACK_SCOREBOARD_MAX - 2) * 2000);
+}
+
+// Test Description:
+// Data is lost once DupThresh ranges or more than 2 SMSS are SACKed above it.
+TEST_F (TcpSackScoreboardTest, IsLostShouldFollowRfc6675) {
+  Sack (10000, 11000, 12000);
+  EXPECT_FALSE (TcpSackIsLost (&Tcb, 10000));
+
+  Sack (10000, 13000, 14000);
+  EXPECT_FALSE (TcpSackIsLost (&Tcb, 10000));
+
+  Sack (10000, 15000, 16000);
+  EXPECT_TRUE (TcpSackIsLost (&Tcb, 10000));
+  EXPECT_FALSE (TcpSackIsLost (&Tcb, 11500));
+  EXPECT_FALSE (TcpSackIsLost (&Tcb, 12000));
+
+  Sack (10000, 16000, 17500);
+  EXPECT_TRUE (TcpSackIsLost (&Tcb, 12000));
+  EXPECT_TRUE (TcpSackIsLost (&Tcb, 14000));
+  EXPECT_FALSE (TcpSackIsLost (&Tcb, 17500));
+}
+
+// Test Description:
+// The pipe counts the data neither SACKed nor lost, plus retransmissions.
+TEST_F (TcpSackScoreboardTest, PipeShouldExcludeSackedAndLostData) {
+  EXPECT_EQ (TcpSackPipe (&Tcb), 10000U);
+
+  //
+  // Holes: [10000, 11000) lost, [12000, 14000) not lost,
+  // above the highest SACKed: [16000, 20000).
+  //
+  Sack (10000, 11000, 12000);
+  Sack (10000, 14000, 16000);
+  EXPECT_EQ (TcpSackPipe (&Tcb), 2000U + 4000U);
+
+  Tcb.HighRxt = 10500;
+  EXPECT_EQ (TcpSackPipe (&Tcb), 500U + 2000U + 4000U);
+}
+
+// Test Description:
+// The lost holes are retransmitted in order, then the others on request.
+TEST_F (TcpSackScoreboardTest, RetransmitShouldPickLostHoles) {
+  Sack (10000, 11000, 12000);
+  Sack (10000, 14000, 16000);
+
+  ASSERT_EQ (TcpSackRetransmitHole (&Tcb, TRUE), 1000U);
+  EXPECT_EQ (mRetransmitSeq, 10000U);
+  EXPECT_EQ (Tcb.HighRxt, 11000U);
+
+  EXPECT_EQ (TcpSackRetransmitHole (&Tcb, TRUE), 0U);
+  EXPECT_EQ (mRetransmitCount, 1U);
+
+  ASSERT_EQ (TcpSackRetransmitHole (&Tcb, FALSE), 1000U);
+  EXPECT_EQ (mRetransmitSeq, 12000U);
+  ASSERT_EQ (TcpSackRetransmitHole (&Tcb, FALSE), 1000U);
+  EXPECT_EQ (mRetransmitSeq, 13000U);
+  EXPECT_EQ (TcpSackRetransmitHole (&Tcb, FALSE), 0U);
+}
+
+// Test Description:
+// HighRxt only advances past the data actually retransmitted.
+TEST_F (TcpSackScoreboardTest, ShortRetransmitShouldLimitHighRxt) {
+  Sack (10000, 11000, 12000);
+  Sack (10000, 14000, 16000);
+
+  mRetransmitSent = 400;
+  ASSERT_EQ (TcpSackRetransmitHole (&Tcb, TRUE), 400U);
+  EXPECT_EQ (mRetransmitLen, 1000U);
+  EXPECT_EQ (Tcb.HighRxt, 10400U);
+
+  mRetransmitSent = 0;
+  ASSERT_EQ (TcpSackRetransmitHole (&Tcb, TRUE), 600U);
+  EXPECT_EQ (mRetransmitSeq, 10400U);
+  EXPECT_EQ (mRetransmitLen, 600U);
+  EXPECT_EQ (Tcb.HighRxt, 11000U);
+
+  mRetransmitSent = -1;
+  EXPECT_EQ (TcpSackRetransmitHole (&Tcb, FALSE), 0U);
+  EXPECT_EQ (mRetransmitSeq, 12000U);
+  EXPECT_EQ (Tcb.HighRxt, 11000U);
+}
+
+////////////////////////////////////////////////////////////////////////
+// Congestion control Tests
+////////////////////////////////////////////////////////////////////////
+
+// Test Description:
+// The integer cube root is rounded down.
+TEST (TcpCubeRootTest, CubeRootShouldRoundDown) {
+  EXPECT_EQ (TcpCubeRoot (0), 0U);
+  EXPECT_EQ (TcpCubeRoot (1), 1U);
+  EXPECT_EQ (TcpCubeRoot (7), 1U);
+  EXPECT_EQ (TcpCubeRoot (8), 2U);
+  EXPECT_EQ (TcpCubeRoot (9375), 21U);
+  EXPECT_EQ (TcpCubeRoot (1000000000000ULL), 10000U);
+  EXPECT_EQ (TcpCubeRoot (MAX_UINT64), (1U << 21) - 1);
+}
+
+class TcpCongestionTest : public ::testing::Test {
+protected:
+  TCP_CB Tcb;
+
+  virtual void
+  SetUp (
+    )
+  {
+    ZeroMem (&Tcb, sizeof (Tcb));
+    Tcb.SndMss = 1000;
+    Tcb.SndUna = 0;
+    Tcb.SndNxt = 100000;
+    Tcb.CWnd   = 100000;
+    mTcpTick   = 1000;
+  }
+};
+
+// Test Description:
+// NewReno is the default, it halves the data in flight after a loss.
+TEST_F (TcpCongestionTest, NewRenoShouldBeDefault) {
+  Tcb.CongestionControl = TcpGetCongestionControl ();
+  ASSERT_EQ (Tcb.CongestionControl, &mTcpNewReno);
+
+  Tcb.CongestionControl->Init (&Tcb);
+  EXPECT_EQ (Tcb.CongestionControl->Ssthresh (&Tcb), 50000U);
+
+  Tcb.CWnd = 10000;
+  Tcb.CongestionControl->CongAvoid (&Tcb, 1000);
+  EXPECT_EQ (Tcb.CWnd, 10100U);
+}
+
+// Test Description:
+// CUBIC reduces the window by beta_cubic and remembers WMax, with
+// fast convergence when the window didn't reach the previous WMax.
+TEST_F (TcpCongestionTest, CubicReductionShouldUseBeta) {
+  Tcb.CongestionControl = &mTcpCubic;
+  Tcb.CongestionControl->Init (&Tcb);
+
+  EXPECT_EQ (Tcb.CongestionControl->Ssthresh (&Tcb), 70000U);
+  EXPECT_EQ (Tcb.Cubic.WMax, 100000U);
+
+  Tcb.CWnd = 80000;
+  EXPECT_EQ (Tcb.CongestionControl->Ssthresh (&Tcb), 56000U);
+  EXPECT_EQ (Tcb.Cubic.WMax, 68000U);
+
+  Tcb.CWnd = 1000;
+  EXPECT_EQ (Tcb.CongestionControl->Ssthresh (&Tcb), 2000U);
+}
+
+// Test Description:
+// After a reduction, CUBIC grows quickly back toward WMax, slowly
+// around it, then probes beyond it.
+TEST_F (TcpCongestionTest, CubicShouldPlateauAtWMax) {
+  UINT32  Tick;
+  UINT32  Index;
+  UINT32  Previous;
+  UINT32  GrowthEarly;
+  UINT32  GrowthPlateau;
+
+  Tcb.CongestionControl = &mTcpCubic;
+  Tcb.CongestionControl->Init (&Tcb);
+  Tcb.Ssthresh = Tcb.CongestionControl->Ssthresh (&Tcb);
+  Tcb.CWnd     = Tcb.Ssthresh;
+  Tcb.SRtt     = 1 << TCP_RTT_SHIFT;
+
+  //
+  // K = cbrt (30000 * 5 * 125 / (2 * 1000)) = 21 ticks.
+  //
+  Tcb.CongestionControl->CongAvoid (&Tcb, 1000);
+  EXPECT_TRUE (Tcb.Cubic.EpochOn);
+  EXPECT_EQ (Tcb.Cubic.K, 21U);
+  EXPECT_EQ (Tcb.Cubic.Origin, 100000U);
+
+  GrowthEarly   = 0;
+  GrowthPlateau = 0;
+
+  //
+  // One RTT per tick, with one ACK per SMSS of the window.
+  //
+  for (Tick = 0; Tick < 40; Tick++) {
+    mTcpTick++;
+    Previous = Tcb.CWnd;
+
+    for (Index = 0; Index < Previous / Tcb.SndMss; Index++) {
+      Tcb.CongestionControl->CongAvoid (&Tcb, 1000);
+    }
+
+    EXPECT_GE (Tcb.CWnd, Previous);
+
+    if (Tick < 5) {
+      GrowthEarly += Tcb.CWnd - Previous;
+    } else if ((Tick >= 18) && (Tick < 23)) {
+      GrowthPlateau += Tcb.CWnd - Previous;
+      EXPECT_LE (Tcb.CWnd, 101000U);
+    }
+  }
+
+  EXPECT_GT (GrowthEarly, GrowthPlateau);
+  EXPECT_GT (Tcb.CWnd, 100000U);
+}
+
+// Test Description:
+// The window never grows by more than half of itself per ACK.
+TEST_F (TcpCongestionTest, CubicGrowthShouldBeCapped) {
+  UINT32  Previous;
+
+  Tcb.CongestionControl = &mTcpCubic;
+  Tcb.CongestionControl->Init (&Tcb);
+  Tcb.CWnd = 10000;
+
+  Tcb.CongestionControl->CongAvoid (&Tcb, 1000);
+  mTcpTick += 1000;
+  Previous = Tcb.CWnd;
+  Tcb.CongestionControl->CongAvoid (&Tcb, 10000);
+  EXPECT_GT (Tcb.CWnd, Previous);
+  EXPECT_LE (Tcb.CWnd, Previous + Previous / 2);
+}
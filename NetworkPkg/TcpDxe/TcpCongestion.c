@@ -0,0 +1,305 @@
+/** @file
+  TCP congestion control algorithms. The window grows as RFC5681
+  (NewReno) or RFC9438 (CUBIC) in congestion avoidance, the algorithm
+  is selected by PcdTcpCongestionControl.
+
+  Copyright (c) 2026, Intel Corporation. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include "TcpMain.h"
+
+//
+// CUBIC parameters of RFC9438: C is 0.4, beta_cubic is 0.7, so
+// the Reno-friendly alpha_cubic = 3 * (1 - beta) / (1 + beta) is 9/17,
+// and the fast convergence factor (1 + beta) / 2 is 17/20.
+//
+#define TCP_CUBIC_C_NUM          2
+#define TCP_CUBIC_C_DEN          5
+#define TCP_CUBIC_BETA_NUM       7
+#define TCP_CUBIC_BETA_DEN       10
+#define TCP_CUBIC_ALPHA_NUM      9
+#define TCP_CUBIC_ALPHA_DEN      17
+#define TCP_CUBIC_FAST_CONV_NUM  17
+#define TCP_CUBIC_FAST_CONV_DEN  20
+#define TCP_CUBIC_TICK_HZ3       (TCP_TICK_HZ * TCP_TICK_HZ * TCP_TICK_HZ)
+
+//
+// |t - K| is capped so that its cube fits in 64 bits with room to
+// spare. The window is capped at 1.5 * CWnd long before this anyway.
+//
+#define TCP_CUBIC_MAX_DELTA  (TCP_TICK_HZ * 200)
+
+/**
+  NewReno needs no state of its own.
+
+  @param[in, out]  Tcb      Pointer to the TCP_CB of this TCP instance.
+
+**/
+STATIC
+VOID
+TcpNewRenoInit (
+  IN OUT TCP_CB  *Tcb
+  )
+{
+}
+
+/**
+  Open the congestion window by about one SMSS per RTT, RFC5681.
+
+  @param[in, out]  Tcb      Pointer to the TCP_CB of this TCP instance.
+  @param[in]       Acked    The number of bytes newly ACKed.
+
+**/
+STATIC
+VOID
+TcpNewRenoCongAvoid (
+  IN OUT TCP_CB  *Tcb,
+  IN     UINT32  Acked
+  )
+{
+  Tcb->CWnd += MAX (Tcb->SndMss * Tcb->SndMss / Tcb->CWnd, 1);
+}
+
+/**
+  Halve the data in flight after a loss, RFC5681.
+
+  @param[in, out]  Tcb      Pointer to the TCP_CB of this TCP instance.
+
+  @return The new slow start threshold.
+
+**/
+STATIC
+UINT32
+TcpNewRenoSsthresh (
+  IN OUT TCP_CB  *Tcb
+  )
+{
+  UINT32  FlightSize;
+
+  FlightSize = TCP_SUB_SEQ (Tcb->SndNxt, Tcb->SndUna);
+
+  return MAX (FlightSize >> 1, (UINT32)(2 * Tcb->SndMss));
+}
+
+/**
+  Compute the integer cube root of a value, rounded down.
+
+  @param[in]  Value   The value.
+
+  @return The cube root of the value, at most 2^21 - 1.
+
+**/
+UINT32
+TcpCubeRoot (
+  IN UINT64  Value
+  )
+{
+  UINT32  Root;
+  UINT32  Candidate;
+  INTN    Bit;
+
+  Root = 0;
+
+  for (Bit = 20; Bit >= 0; Bit--) {
+    Candidate = Root | (1U << Bit);
+
+    if (MultU64x32 (MultU64x32 (Candidate, Candidate), Candidate) <= Value) {
+      Root = Candidate;
+    }
+  }
+
+  return Root;
+}
+
+/**
+  Reset the CUBIC state.
+
+  @param[in, out]  Tcb      Pointer to the TCP_CB of this TCP instance.
+
+**/
+STATIC
+VOID
+TcpCubicInit (
+  IN OUT TCP_CB  *Tcb
+  )
+{
+  ZeroMem (&Tcb->Cubic, sizeof (TCP_CUBIC));
+}
+
+/**
+  Open the congestion window toward the cubic function of the time
+  since the last reduction, RFC9438 section 4.2 to 4.4.
+
+  @param[in, out]  Tcb      Pointer to the TCP_CB of this TCP instance.
+  @param[in]       Acked    The number of bytes newly ACKed.
+
+**/
+STATIC
+VOID
+TcpCubicCongAvoid (
+  IN OUT TCP_CB  *Tcb,
+  IN     UINT32  Acked
+  )
+{
+  TCP_CUBIC  *Cubic;
+  UINT32     Time;
+  UINT32     Delta;
+  UINT64     Offset;
+  UINT64     Target;
+  UINT32     Alpha;
+
+  Cubic = &Tcb->Cubic;
+
+  if (!Cubic->EpochOn) {
+    //
+    // K is the time the window takes to grow back to WMax:
+    // K = cbrt ((WMax - CWnd) / (C * SMSS)), in TCP ticks.
+    //
+    Cubic->EpochOn = TRUE;
+    Cubic->Epoch   = mTcpTick;
+    Cubic->WEst    = Tcb->CWnd;
+
+    if (Tcb->CWnd < Cubic->WMax) {
+      Cubic->K = TcpCubeRoot (
+                   DivU64x32 (
+                     MultU64x32 (Cubic->WMax - Tcb->CWnd, TCP_CUBIC_C_DEN * TCP_CUBIC_TICK_HZ3),
+                     TCP_CUBIC_C_NUM * Tcb->SndMss
+                     )
+                   );
+      Cubic->Origin = Cubic->WMax;
+    } else {
+      Cubic->K      = 0;
+      Cubic->Origin = Tcb->CWnd;
+    }
+  }
+
+  //
+  // Target = W_cubic (t + RTT) = C * (t + RTT - K)^3 * SMSS + Origin.
+  //
+  Time = TCP_SUB_TIME (mTcpTick, Cubic->Epoch) + (Tcb->SRtt >> TCP_RTT_SHIFT);
+
+  if (Time >= Cubic->K) {
+    Delta = MIN (Time - Cubic->K, TCP_CUBIC_MAX_DELTA);
+  } else {
+    Delta = MIN (Cubic->K - Time, TCP_CUBIC_MAX_DELTA);
+  }
+
+  Offset = DivU64x32 (
+             MultU64x32 (MultU64x32 (MultU64x32 (Delta, Delta), Delta), TCP_CUBIC_C_NUM * Tcb->SndMss),
+             TCP_CUBIC_C_DEN * TCP_CUBIC_TICK_HZ3
+             );
+
+  if (Time >= Cubic->K) {
+    Target = Cubic->Origin + Offset;
+  } else if (Offset < Cubic->Origin) {
+    Target = Cubic->Origin - Offset;
+  } else {
+    Target = 0;
+  }
+
+  if (Target < Tcb->CWnd) {
+    Target = Tcb->CWnd;
+  } else if (Target > Tcb->CWnd + (Tcb->CWnd >> 1)) {
+    Target = Tcb->CWnd + (Tcb->CWnd >> 1);
+  }
+
+  //
+  // The window Reno would have, which grows by alpha_cubic SMSS per
+  // RTT, and by one SMSS per RTT once it passes WMax.
+  //
+  Alpha = TCP_CUBIC_ALPHA_NUM;
+  if (Cubic->WEst >= Cubic->WMax) {
+    Alpha = TCP_CUBIC_ALPHA_DEN;
+  }
+
+  Cubic->WEst += MAX (
+                   (UINT32)DivU64x32 (
+                             MultU64x32 (MultU64x32 (Acked, Tcb->SndMss), Alpha),
+                             TCP_CUBIC_ALPHA_DEN * Tcb->CWnd
+                             ),
+                   1
+                   );
+
+  if (Cubic->WEst > Target) {
+    //
+    // Reno-friendly region.
+    //
+    Tcb->CWnd = Cubic->WEst;
+  } else if (Target > Tcb->CWnd) {
+    Tcb->CWnd += MAX (
+                   (UINT32)DivU64x32 (MultU64x32 (Target - Tcb->CWnd, Acked), Tcb->CWnd),
+                   1
+                   );
+  }
+}
+
+/**
+  Reduce the window by beta_cubic after a loss and remember the window
+  before the reduction, RFC9438 section 4.6 and 4.7.
+
+  @param[in, out]  Tcb      Pointer to the TCP_CB of this TCP instance.
+
+  @return The new slow start threshold.
+
+**/
+STATIC
+UINT32
+TcpCubicSsthresh (
+  IN OUT TCP_CB  *Tcb
+  )
+{
+  TCP_CUBIC  *Cubic;
+  UINT32     Ssthresh;
+
+  Cubic = &Tcb->Cubic;
+
+  //
+  // Fast convergence: release bandwidth if the window
+  // didn't reach the previous WMax.
+  //
+  if (Tcb->CWnd < Cubic->WMax) {
+    Cubic->WMax = (UINT32)DivU64x32 (MultU64x32 (Tcb->CWnd, TCP_CUBIC_FAST_CONV_NUM), TCP_CUBIC_FAST_CONV_DEN);
+  } else {
+    Cubic->WMax = Tcb->CWnd;
+  }
+
+  Cubic->EpochOn = FALSE;
+
+  Ssthresh = (UINT32)DivU64x32 (MultU64x32 (Tcb->CWnd, TCP_CUBIC_BETA_NUM), TCP_CUBIC_BETA_DEN);
+
+  return MAX (Ssthresh, (UINT32)(2 * Tcb->SndMss));
+}
+
+CONST TCP_CONGESTION_CONTROL  mTcpNewReno = {
+  "NewReno",
+  TcpNewRenoInit,
+  TcpNewRenoCongAvoid,
+  TcpNewRenoSsthresh
+};
+
+CONST TCP_CONGESTION_CONTROL  mTcpCubic = {
+  "CUBIC",
+  TcpCubicInit,
+  TcpCubicCongAvoid,
+  TcpCubicSsthresh
+};
+
+/**
+  Get the congestion control algorithm selected by PcdTcpCongestionControl.
+
+  @return The congestion control algorithm, NewReno if the PCD is unknown.
+
+**/
+CONST TCP_CONGESTION_CONTROL *
+TcpGetCongestionControl (
+  VOID
+  )
+{
+  if (PcdGet8 (PcdTcpCongestionControl) == TCP_CONGESTION_CUBIC) {
+    return &mTcpCubic;
+  }
+
+  return &mTcpNewReno;
+}
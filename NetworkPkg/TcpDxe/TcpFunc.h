@@ -338,6 +338,24 @@ TcpDataToSend (
   IN INTN    Force
   );
 
+/**
+  Retransmit at most MaxLen bytes of data from sequence Seq.
+
+  @param[in]  Tcb     Pointer to the TCP_CB of this TCP instance.
+  @param[in]  Seq     The sequence number of the data to be retransmitted.
+  @param[in]  MaxLen  The maximum number of bytes to retransmit.
+
+  @return The length of the sequence space retransmitted, 0 if nothing is
+          retransmitted, or -1 if an error condition occurred.
+
+**/
+INTN
+TcpRetransmitRange (
+  IN TCP_CB     *Tcb,
+  IN TCP_SEQNO  Seq,
+  IN UINT32     MaxLen
+  );
+
 /**
   Retransmit the segment from sequence Seq.
 
@@ -657,6 +675,99 @@ Tcp6RefreshNeighbor (
   IN UINT32          Timeout
   );
 
+//
+// Functions in TcpSack.c
+//
+
+/**
+  Update the SACK scoreboard with an incoming ACK and its SACK option.
+
+  @param[in, out]  Tcb      Pointer to the TCP_CB of this TCP instance.
+  @param[in]       Option   Pointer to the options parsed from the segment.
+  @param[in]       Ack      The acknowledge sequence number of the segment.
+
+**/
+VOID
+TcpSackUpdate (
+  IN OUT TCP_CB      *Tcb,
+  IN     TCP_OPTION  *Option,
+  IN     TCP_SEQNO   Ack
+  );
+
+/**
+  Check whether the data at sequence Seq is deemed lost by the SACK
+  information, as IsLost () of RFC6675.
+
+  @param[in]  Tcb     Pointer to the TCP_CB of this TCP instance.
+  @param[in]  Seq     The sequence number to check.
+
+  @retval TRUE        The data is deemed lost.
+  @retval FALSE       The data is not deemed lost, or SACK isn't in use.
+
+**/
+BOOLEAN
+TcpSackIsLost (
+  IN TCP_CB     *Tcb,
+  IN TCP_SEQNO  Seq
+  );
+
+/**
+  Estimate the number of bytes in flight, as SetPipe () of RFC6675.
+
+  @param[in]  Tcb     Pointer to the TCP_CB of this TCP instance.
+
+  @return The number of bytes in flight.
+
+**/
+UINT32
+TcpSackPipe (
+  IN TCP_CB  *Tcb
+  );
+
+/**
+  Retransmit the first data of the scoreboard holes above HighRxt,
+  as NextSeg () of RFC6675 rule (1) or, if LostOnly is FALSE, rule (3).
+
+  @param[in, out]  Tcb       Pointer to the TCP_CB of this TCP instance.
+  @param[in]       LostOnly  Only retransmit the data deemed lost.
+
+  @return The number of bytes retransmitted, 0 if nothing is retransmitted.
+
+**/
+UINT32
+TcpSackRetransmitHole (
+  IN OUT TCP_CB   *Tcb,
+  IN     BOOLEAN  LostOnly
+  );
+
+//
+// Functions in TcpCongestion.c
+//
+
+/**
+  Compute the integer cube root of a value, rounded down.
+
+  @param[in]  Value   The value.
+
+  @return The cube root of the value, at most 2^21 - 1.
+
+**/
+UINT32
+TcpCubeRoot (
+  IN UINT64  Value
+  );
+
+/**
+  Get the congestion control algorithm selected by PcdTcpCongestionControl.
+
+  @return The congestion control algorithm, NewReno if the PCD is unknown.
+
+**/
+CONST TCP_CONGESTION_CONTROL *
+TcpGetCongestionControl (
+  VOID
+  );
+
 //
 // Functions in TcpDispatcher.c
 //
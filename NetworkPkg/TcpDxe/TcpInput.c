@@ -145,6 +145,94 @@ TcpFastRecover (
   }
 }
 
+/**
+  SACK based loss recovery defined in RFC6675. It is called after
+  SND.UNA and the SACK scoreboard are updated by the incoming ACK.
+
+  @param[in, out]  Tcb      Pointer to the TCP_CB of this TCP instance.
+  @param[in]       Seg      Segment that triggers the loss recovery.
+
+**/
+VOID
+TcpSackFastRecover (
+  IN OUT TCP_CB   *Tcb,
+  IN     TCP_SEG  *Seg
+  )
+{
+  UINT32  Pipe;
+  UINT32  Len;
+  INTN    Sent;
+
+  if (Tcb->CongestState != TCP_CONGEST_RECOVER) {
+    //
+    // Enter loss recovery, step (4) of RFC6675 section 5:
+    // set the recovery point and reduce the window, then
+    // retransmit the first unacknowledged data.
+    //
+    Tcb->Recover  = Tcb->SndNxt;
+    Tcb->Ssthresh = Tcb->CongestionControl->Ssthresh (Tcb);
+    Tcb->CWnd     = Tcb->Ssthresh;
+
+    Tcb->CongestState = TCP_CONGEST_RECOVER;
+    TCP_CLEAR_FLG (Tcb->CtrlFlag, TCP_CTRL_RTT_ON);
+
+    Len = Tcb->SndMss;
+    if (Tcb->SackBlockNum != 0) {
+      Len = MIN (Len, TCP_SUB_SEQ (Tcb->SackBlock[0].Seq, Tcb->SndUna));
+    }
+
+    Tcb->HighRxt = Tcb->SndUna;
+    if (Len != 0) {
+      Sent = TcpRetransmitRange (Tcb, Tcb->SndUna, Len);
+      if (Sent > 0) {
+        Tcb->HighRxt = Tcb->SndUna + (UINT32)Sent;
+      }
+    }
+
+    DEBUG (
+      (DEBUG_NET,
+       "TcpSackFastRecover: enter SACK recovery for TCB %p, recover point is %d\n",
+       Tcb,
+       Tcb->Recover)
+      );
+  } else if (TCP_SEQ_GEQ (Seg->Ack, Tcb->Recover)) {
+    //
+    // All the data outstanding when the recovery started is
+    // ACKed, exit the recovery. CWnd is already Ssthresh.
+    //
+    Tcb->CongestState = TCP_CONGEST_OPEN;
+    DEBUG (
+      (DEBUG_NET,
+       "TcpSackFastRecover: received a full ACK(%d) for TCB %p, exit SACK recovery\n",
+       Seg->Ack,
+       Tcb)
+      );
+    return;
+  }
+
+  //
+  // Step (C) of RFC6675 section 5: while the pipe leaves room
+  // for a full segment, retransmit the data deemed lost. New
+  // data is sent later by TcpToSendData, also limited by pipe.
+  // If there is no new data, retransmit the remaining holes.
+  //
+  Pipe = TcpSackPipe (Tcb);
+
+  while ((Pipe < Tcb->CWnd) && (Tcb->CWnd - Pipe >= Tcb->SndMss)) {
+    Len = TcpSackRetransmitHole (Tcb, TRUE);
+
+    if ((Len == 0) && (GET_SND_DATASIZE (Tcb->Sk) == 0)) {
+      Len = TcpSackRetransmitHole (Tcb, FALSE);
+    }
+
+    if (Len == 0) {
+      break;
+    }
+
+    Pipe += Len;
+  }
+}
+
 /**
   NewReno fast loss recovery defined in RFC3792.
 
@@ -563,6 +651,11 @@ TcpQueueData (
   Seg  = TCPSEG_NETBUF (Nbuf);
   Head = &Tcb->RcvQue;
 
+  //
+  // Remember the latest segment, it is reported first in SACK option.
+  //
+  Tcb->RcvSackRecent = Seg->Seq;
+
   //
   // Fast path to process normal case. That is,
   // no out-of-order segments are received.
@@ -724,6 +817,7 @@ TcpInput (
   TCP_SEQNO   Urg;
   UINT16      Checksum;
   INT32       Usable;
+  BOOLEAN     SackRecover;
   EFI_STATUS  Status;
 
   ASSERT ((Version == IP_VERSION_4) || (Version == IP_VERSION_6));
@@ -1213,6 +1307,14 @@ TcpInput (
     TcpSetTimer (Tcb, TCP_TIMER_REXMIT, Tcb->Rto);
   }
 
+  //
+  // Update the SACK scoreboard before the duplicate acks
+  // are checked, they both decide whether data is lost.
+  //
+  if (TCP_FLG_ON (Tcb->CtrlFlag, TCP_CTRL_RCVD_SACK)) {
+    TcpSackUpdate (Tcb, &Option, Seg->Ack);
+  }
+
   //
   // Count duplicate acks.
   //
@@ -1228,15 +1330,19 @@ TcpInput (
 
   //
   // Congestion avoidance, fast recovery and fast retransmission.
+  // With SACK, the loss recovery also starts as soon as the
+  // data at SEG.ACK is deemed lost by the SACKed data above.
   //
-  if (((Tcb->CongestState == TCP_CONGEST_OPEN) && (Tcb->DupAck < 3)) ||
+  SackRecover = FALSE;
+
+  if (((Tcb->CongestState == TCP_CONGEST_OPEN) && (Tcb->DupAck < TCP_DUP_THRESH) && !TcpSackIsLost (Tcb, Seg->Ack)) ||
       (Tcb->CongestState == TCP_CONGEST_LOSS))
   {
     if (TCP_SEQ_GT (Seg->Ack, Tcb->SndUna)) {
       if (Tcb->CWnd < Tcb->Ssthresh) {
         Tcb->CWnd += Tcb->SndMss;
       } else {
-        Tcb->CWnd += MAX (Tcb->SndMss * Tcb->SndMss / Tcb->CWnd, 1);
+        Tcb->CongestionControl->CongAvoid (Tcb, TCP_SUB_SEQ (Seg->Ack, Tcb->SndUna));
       }
 
       Tcb->CWnd = MIN (Tcb->CWnd, TCP_MAX_WIN << Tcb->SndWndScale);
@@ -1245,6 +1351,8 @@ TcpInput (
     if (Tcb->CongestState == TCP_CONGEST_LOSS) {
       TcpFastLossRecover (Tcb, Seg);
     }
+  } else if (TCP_FLG_ON (Tcb->CtrlFlag, TCP_CTRL_RCVD_SACK)) {
+    SackRecover = TRUE;
   } else {
     TcpFastRecover (Tcb, Seg);
   }
@@ -1269,6 +1377,10 @@ TcpInput (
     }
   }
 
+  if (SackRecover) {
+    TcpSackFastRecover (Tcb, Seg);
+  }
+
   //
   // Update window info
   //
@@ -17,6 +17,7 @@
 #include <Library/IpIoLib.h>
 #include <Library/DevicePathLib.h>
 #include <Library/PrintLib.h>
+#include <Library/PcdLib.h>
 
 #include "Socket.h"
 #include "TcpProto.h"
@@ -35,6 +36,9 @@ extern LIST_ENTRY  mTcpListenQue;
 extern TCP_SEQNO   mTcpGlobalSecret;
 extern UINT32      mTcpTick;
 
+extern CONST TCP_CONGESTION_CONTROL  mTcpNewReno;
+extern CONST TCP_CONGESTION_CONTROL  mTcpCubic;
+
 ///
 /// 30 seconds.
 ///
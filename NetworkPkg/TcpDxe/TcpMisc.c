@@ -142,6 +142,9 @@ TcpInitTcbLocal (
 
   Tcb->ProbeTimerOn = FALSE;
 
+  Tcb->SackBlockNum      = 0;
+  Tcb->CongestionControl = TcpGetCongestionControl ();
+
   return EFI_SUCCESS;
 }
 
@@ -190,6 +193,7 @@ TcpInitTcbPeer (
   }
 
   Tcb->CWnd = Tcb->SndMss;
+  Tcb->CongestionControl->Init (Tcb);
 
   Tcb->Irs    = Seg->Seq;
   Tcb->RcvNxt = Tcb->Irs + 1;
@@ -221,6 +225,10 @@ TcpInitTcbPeer (
     //
     Tcb->SndMss -= TCP_OPTION_TS_ALIGNED_LEN;
   }
+
+  if (TCP_FLG_ON (Opt->Flag, TCP_OPTION_RCVD_SACK_PERM) && !TCP_FLG_ON (Tcb->CtrlFlag, TCP_CTRL_NO_SACK)) {
+    TCP_SET_FLG (Tcb->CtrlFlag, TCP_CTRL_RCVD_SACK);
+  }
 }
 
 /**
@@ -160,6 +160,28 @@ TcpSynBuildOption (
     TcpPutUint32 (Data, TCP_OPTION_WS_FAST | TcpComputeScale (Tcb));
   }
 
+  //
+  // Build SACK permitted option, only when configured to
+  // use SACK, and either we are doing active open or we
+  // have received SACK permitted option from peer.
+  //
+  if (!TCP_FLG_ON (Tcb->CtrlFlag, TCP_CTRL_NO_SACK) &&
+      (!TCP_FLG_ON (TCPSEG_NETBUF (Nbuf)->Flag, TCP_FLG_ACK) ||
+       TCP_FLG_ON (Tcb->CtrlFlag, TCP_CTRL_RCVD_SACK))
+      )
+  {
+    Data = NetbufAllocSpace (
+             Nbuf,
+             TCP_OPTION_SP_ALIGNED_LEN,
+             NET_BUF_HEAD
+             );
+
+    ASSERT (Data != NULL);
+
+    Len += TCP_OPTION_SP_ALIGNED_LEN;
+    TcpPutUint32 (Data, TCP_OPTION_SACK_PERM_FAST);
+  }
+
   //
   // Build the MSS option.
   //
@@ -189,10 +211,16 @@ TcpBuildOption (
 {
   UINT8   *Data;
   UINT16  Len;
+  UINT32  DataLen;
 
   ASSERT ((Tcb != NULL) && (Nbuf != NULL) && (Nbuf->Tcp == NULL));
   Len = 0;
 
+  //
+  // The length of the segment data, before any option is prepended.
+  //
+  DataLen = Nbuf->TotalSize;
+
   //
   // Build the Timestamp option.
   //
@@ -214,6 +242,130 @@ TcpBuildOption (
     TcpPutUint32 (Data + 8, Tcb->TsRecent);
   }
 
+  //
+  // Build the SACK option to report the out-of-order data
+  // queued. It is only carried by segments without data so
+  // that the options never eat into the payload of a full
+  // sized segment.
+  //
+  if (TCP_FLG_ON (Tcb->CtrlFlag, TCP_CTRL_RCVD_SACK) &&
+      !TCP_FLG_ON (TCPSEG_NETBUF (Nbuf)->Flag, TCP_FLG_RST | TCP_FLG_SYN) &&
+      (DataLen == 0)
+      )
+  {
+    Len = (UINT16)(Len + TcpBuildSackOption (Tcb, Nbuf, (TCP_OPTION_MAX_LEN - Len - TCP_OPTION_SACK_HEAD_LEN) / TCP_OPTION_SACK_BLOCK_LEN));
+  }
+
+  return Len;
+}
+
+/**
+  Build the SACK option from the out-of-order data on the
+  receive queue, as specified in RFC2018.
+
+  The first block reports the range holding the most recently
+  received segment, the others follow in sequence order.
+
+  @param[in]  Tcb       Pointer to the TCP_CB of this TCP instance.
+  @param[in]  Nbuf      Pointer to the buffer to store the options.
+  @param[in]  MaxBlock  The maximum number of blocks to build.
+
+  @return             The length of the SACK option, 0 if none is built.
+
+**/
+UINT16
+TcpBuildSackOption (
+  IN TCP_CB   *Tcb,
+  IN NET_BUF  *Nbuf,
+  IN UINTN    MaxBlock
+  )
+{
+  TCP_SACK_BLOCK  Block[TCP_OPTION_MAX_SACK];
+  TCP_SACK_BLOCK  Range;
+  LIST_ENTRY      *Entry;
+  TCP_SEG         *Seg;
+  UINTN           Num;
+  UINTN           Index;
+  BOOLEAN         Found;
+  UINT8           *Data;
+  UINT16          Len;
+
+  MaxBlock = MIN (MaxBlock, TCP_OPTION_MAX_SACK);
+  if (MaxBlock == 0) {
+    return 0;
+  }
+
+  Num   = 0;
+  Found = FALSE;
+  Entry = Tcb->RcvQue.ForwardLink;
+
+  while (Entry != &Tcb->RcvQue) {
+    //
+    // Merge the contiguous segments on the sorted receive
+    // queue into one range.
+    //
+    Seg       = TCPSEG_NETBUF (NET_LIST_USER_STRUCT (Entry, NET_BUF, List));
+    Range.Seq = Seg->Seq;
+    Range.End = Seg->End;
+    Entry     = Entry->ForwardLink;
+
+    while (Entry != &Tcb->RcvQue) {
+      Seg = TCPSEG_NETBUF (NET_LIST_USER_STRUCT (Entry, NET_BUF, List));
+      if (TCP_SEQ_GT (Seg->Seq, Range.End)) {
+        break;
+      }
+
+      if (TCP_SEQ_GT (Seg->End, Range.End)) {
+        Range.End = Seg->End;
+      }
+
+      Entry = Entry->ForwardLink;
+    }
+
+    if (TCP_SEQ_LEQ (Range.End, Tcb->RcvNxt)) {
+      continue;
+    }
+
+    if (TCP_SEQ_LT (Range.Seq, Tcb->RcvNxt)) {
+      Range.Seq = Tcb->RcvNxt;
+    }
+
+    if (!Found && TCP_SEQ_LEQ (Range.Seq, Tcb->RcvSackRecent) && TCP_SEQ_LT (Tcb->RcvSackRecent, Range.End)) {
+      //
+      // The most recent range goes first, it may push
+      // the last of the others out.
+      //
+      Num = MIN (Num, MaxBlock - 1);
+      for (Index = Num; Index > 0; Index--) {
+        Block[Index] = Block[Index - 1];
+      }
+
+      Block[0] = Range;
+      Found    = TRUE;
+      Num++;
+    } else if ((Num + 1 < MaxBlock) || (Found && (Num < MaxBlock))) {
+      //
+      // One block is kept for the most recent range until it is found.
+      //
+      Block[Num] = Range;
+      Num++;
+    }
+  }
+
+  if (Num == 0) {
+    return 0;
+  }
+
+  Len  = (UINT16)(TCP_OPTION_SACK_HEAD_LEN + Num * TCP_OPTION_SACK_BLOCK_LEN);
+  Data = NetbufAllocSpace (Nbuf, Len, NET_BUF_HEAD);
+  ASSERT (Data != NULL);
+
+  TcpPutUint32 (Data, TCP_OPTION_SACK_FAST | (Len - 2));
+  for (Index = 0; Index < Num; Index++) {
+    TcpPutUint32 (Data + TCP_OPTION_SACK_HEAD_LEN + Index * TCP_OPTION_SACK_BLOCK_LEN, Block[Index].Seq);
+    TcpPutUint32 (Data + TCP_OPTION_SACK_HEAD_LEN + Index * TCP_OPTION_SACK_BLOCK_LEN + 4, Block[Index].End);
+  }
+
   return Len;
 }
 
@@ -239,10 +391,12 @@ TcpParseOption (
   UINT8  Cur;
   UINT8  Type;
   UINT8  Len;
+  UINT8  Index;
 
   ASSERT ((Tcp != NULL) && (Option != NULL));
 
-  Option->Flag = 0;
+  Option->Flag    = 0;
+  Option->SackNum = 0;
 
   TotalLen = (UINT8)((Tcp->HeadLen << 2) - sizeof (TCP_HEAD));
   if (TotalLen <= 0) {
@@ -311,6 +465,45 @@ TcpParseOption (
         Cur += TCP_OPTION_TS_LEN;
         break;
 
+      case TCP_OPTION_SACK_PERM:
+        if ((TotalLen - Cur < TCP_OPTION_SACK_PERM_LEN) || (Head[Cur + 1] != TCP_OPTION_SACK_PERM_LEN)) {
+          return -1;
+        }
+
+        TCP_SET_FLG (Option->Flag, TCP_OPTION_RCVD_SACK_PERM);
+
+        Cur += TCP_OPTION_SACK_PERM_LEN;
+        break;
+
+      case TCP_OPTION_SACK:
+        if (TotalLen - Cur < 2) {
+          return -1;
+        }
+
+        Len = Head[Cur + 1];
+
+        if ((Len < 2 + TCP_OPTION_SACK_BLOCK_LEN) || (TotalLen - Cur < Len) ||
+            (((Len - 2) % TCP_OPTION_SACK_BLOCK_LEN) != 0))
+        {
+          return -1;
+        }
+
+        //
+        // The option field can't hold more than TCP_OPTION_MAX_SACK blocks.
+        //
+        Option->SackNum = (UINT8)((Len - 2) / TCP_OPTION_SACK_BLOCK_LEN);
+        ASSERT (Option->SackNum <= TCP_OPTION_MAX_SACK);
+
+        for (Index = 0; Index < Option->SackNum; Index++) {
+          Option->SackBlock[Index].Seq = TcpGetUint32 (&Head[Cur + 2 + Index * TCP_OPTION_SACK_BLOCK_LEN]);
+          Option->SackBlock[Index].End = TcpGetUint32 (&Head[Cur + 6 + Index * TCP_OPTION_SACK_BLOCK_LEN]);
+        }
+
+        TCP_SET_FLG (Option->Flag, TCP_OPTION_RCVD_SACK);
+
+        Cur = (UINT8)(Cur + Len);
+        break;
+
       case TCP_OPTION_NOP:
         Cur++;
         break;
@@ -173,6 +173,7 @@ TcpDataToSend (
   UINT32  Len;
   UINT32  Left;
   UINT32  Limit;
+  UINT32  Pipe;
 
   Sk = Tcb->Sk;
   ASSERT (Sk != NULL);
@@ -191,6 +192,24 @@ TcpDataToSend (
     Limit = Tcb->SndUna + Tcb->CWnd;
   }
 
+  //
+  // During SACK based loss recovery, the data in flight is
+  // the pipe estimated as RFC6675 rather than SND.NXT - SND.UNA.
+  // New data can be sent as long as the pipe is below CWND.
+  //
+  if ((Tcb->CongestState == TCP_CONGEST_RECOVER) &&
+      TCP_FLG_ON (Tcb->CtrlFlag, TCP_CTRL_RCVD_SACK))
+  {
+    Pipe  = TcpSackPipe (Tcb);
+    Limit = Tcb->SndWl2 + Tcb->SndWnd;
+
+    if (Pipe >= Tcb->CWnd) {
+      Limit = Tcb->SndNxt;
+    } else if (TCP_SEQ_GT (Limit, Tcb->SndNxt + (Tcb->CWnd - Pipe))) {
+      Limit = Tcb->SndNxt + (Tcb->CWnd - Pipe);
+    }
+  }
+
   if (TCP_SEQ_GT (Limit, Tcb->SndNxt)) {
     Win = TCP_SUB_SEQ (Limit, Tcb->SndNxt);
   }
@@ -619,30 +638,36 @@ TcpGetSegment (
 }
 
 /**
-  Retransmit the segment from sequence Seq.
+  Retransmit at most MaxLen bytes of data from sequence Seq.
 
   @param[in]  Tcb     Pointer to the TCP_CB of this TCP instance.
-  @param[in]  Seq     The sequence number of the segment to be retransmitted.
+  @param[in]  Seq     The sequence number of the data to be retransmitted.
+  @param[in]  MaxLen  The maximum number of bytes to retransmit, such as
+                      the size of a hole in the SACK scoreboard.
 
-  @retval 0       Retransmission succeeded.
-  @retval -1      Error condition occurred.
+  @return The length of the sequence space retransmitted, which may be less
+          than MaxLen if the segment ends at a boundary of a queued segment,
+          or 0 if the send window is too small. -1 if an error occurred.
 
 **/
 INTN
-TcpRetransmit (
+TcpRetransmitRange (
   IN TCP_CB     *Tcb,
-  IN TCP_SEQNO  Seq
+  IN TCP_SEQNO  Seq,
+  IN UINT32     MaxLen
   )
 {
   NET_BUF  *Nbuf;
   UINT32   Len;
+  UINT32   Sent;
 
   //
   // Compute the maximum length of retransmission. It is
-  // limited by three factors:
+  // limited by four factors:
   // 1. Less than SndMss
   // 2. Must in the current send window
   // 3. Will not change the boundaries of queued segments.
+  // 4. Less than MaxLen
   //
 
   //
@@ -674,6 +699,7 @@ TcpRetransmit (
   }
 
   Len = MIN (Len, Tcb->SndMss);
+  Len = MIN (Len, MaxLen);
 
   Nbuf = TcpGetSegmentSndQue (Tcb, Seq, Len);
   if (Nbuf == NULL) {
@@ -684,6 +710,11 @@ TcpRetransmit (
     goto OnError;
   }
 
+  //
+  // TcpGetSegmentSndQue () stops at the end of the queued segment holding Seq.
+  //
+  Sent = TCP_SUB_SEQ (TCPSEG_NETBUF (Nbuf)->End, Seq);
+
   if (TcpTransmitSegment (Tcb, Nbuf) != 0) {
     goto OnError;
   }
@@ -702,7 +733,7 @@ TcpRetransmit (
   Nbuf->Tcp = NULL;
 
   NetbufFree (Nbuf);
-  return 0;
+  return (INTN)Sent;
 
 OnError:
   if (Nbuf != NULL) {
@@ -712,6 +743,29 @@ OnError:
   return -1;
 }
 
+/**
+  Retransmit the segment from sequence Seq.
+
+  @param[in]  Tcb     Pointer to the TCP_CB of this TCP instance.
+  @param[in]  Seq     The sequence number of the segment to be retransmitted.
+
+  @retval 0       Retransmission succeeded.
+  @retval -1      Error condition occurred.
+
+**/
+INTN
+TcpRetransmit (
+  IN TCP_CB     *Tcb,
+  IN TCP_SEQNO  Seq
+  )
+{
+  if (TcpRetransmitRange (Tcb, Seq, Tcb->SndMss) < 0) {
+    return -1;
+  }
+
+  return 0;
+}
+
 /**
   Verify that all the segments in SndQue are in good shape.
 
@@ -52,6 +52,15 @@
 #define TCP_CONGEST_LOSS     2      ///< Retxmit because of retxmit time out.
 #define TCP_CONGEST_OPEN     3      ///< TCP is opening its congestion window.
 
+//
+// Congestion control algorithms, selected by PcdTcpCongestionControl.
+//
+#define TCP_CONGESTION_NEWRENO  0   ///< RFC5681 congestion avoidance.
+#define TCP_CONGESTION_CUBIC    1   ///< RFC9438 CUBIC.
+
+#define TCP_DUP_THRESH           3  ///< DupThresh of RFC5681 and RFC6675.
+#define TCP_SACK_SCOREBOARD_MAX  16 ///< Max SACKed ranges kept by the sender.
+
 //
 // TCP control flags
 //
@@ -70,6 +79,8 @@
 #define TCP_CTRL_TIMER_ON      0x1000   ///< At least one of the timer is on.
 #define TCP_CTRL_RTT_ON        0x2000   ///< The RTT measurement is on.
 #define TCP_CTRL_ACK_NOW       0x4000   ///< Send the ACK now, don't delay.
+#define TCP_CTRL_NO_SACK       0x8000   ///< Disable SACK option.
+#define TCP_CTRL_RCVD_SACK     0x10000  ///< Received a SACK permitted option in syn.
 
 //
 // Timer related values
@@ -224,8 +235,82 @@ typedef struct _TCP_PEER {
   TCP_PORTNO        Port; ///< Port number, in network byte order.
 } TCP_PEER;
 
+///
+/// A range of sequence space reported by, or to, the peer in SACK option.
+///
+typedef struct _TCP_SACK_BLOCK {
+  TCP_SEQNO    Seq; ///< Left edge, the first sequence in the range.
+  TCP_SEQNO    End; ///< Right edge, the sequence of the last byte + 1.
+} TCP_SACK_BLOCK;
+
 typedef struct _TCP_CONTROL_BLOCK TCP_CB;
 
+/**
+  Initialize the congestion control state when the connection is established.
+
+  @param[in, out]  Tcb      Pointer to the TCP_CB of this TCP instance.
+
+**/
+typedef
+VOID
+(*TCP_CONGESTION_INIT) (
+  IN OUT TCP_CB  *Tcb
+  );
+
+/**
+  Open the congestion window in congestion avoidance, that is when
+  CWnd is no less than Ssthresh and new data is ACKed.
+
+  @param[in, out]  Tcb      Pointer to the TCP_CB of this TCP instance.
+  @param[in]       Acked    The number of bytes newly ACKed.
+
+**/
+typedef
+VOID
+(*TCP_CONGESTION_AVOID) (
+  IN OUT TCP_CB  *Tcb,
+  IN     UINT32  Acked
+  );
+
+/**
+  Compute the slow start threshold after a congestion event, either
+  a fast retransmission or a retransmission timeout.
+
+  @param[in, out]  Tcb      Pointer to the TCP_CB of this TCP instance.
+
+  @return The new slow start threshold.
+
+**/
+typedef
+UINT32
+(*TCP_CONGESTION_SSTHRESH) (
+  IN OUT TCP_CB  *Tcb
+  );
+
+///
+/// Congestion control algorithm. Slow start, fast retransmission and
+/// loss recovery are common, the algorithm decides how the window grows
+/// in congestion avoidance and how much it shrinks after a loss.
+///
+typedef struct _TCP_CONGESTION_CONTROL {
+  CHAR8                      *Name;
+  TCP_CONGESTION_INIT        Init;
+  TCP_CONGESTION_AVOID       CongAvoid;
+  TCP_CONGESTION_SSTHRESH    Ssthresh;
+} TCP_CONGESTION_CONTROL;
+
+///
+/// CUBIC state, RFC9438. Time is in TCP ticks.
+///
+typedef struct _TCP_CUBIC {
+  BOOLEAN    EpochOn;    ///< A congestion avoidance epoch is running.
+  UINT32     Epoch;      ///< When the current epoch started.
+  UINT32     K;          ///< Time for the window to grow back to Origin.
+  UINT32     Origin;     ///< Window at the plateau of the cubic function.
+  UINT32     WMax;       ///< Window before the last reduction.
+  UINT32     WEst;       ///< Reno-friendly window estimate.
+} TCP_CUBIC;
+
 ///
 /// TCP control block: it includes various states.
 ///
@@ -306,6 +391,21 @@ struct _TCP_CONTROL_BLOCK {
   UINT8               LossTimes;    ///< Number of retxmit timeouts in a row.
   TCP_SEQNO           LossRecover;  ///< Recover point for retxmit.
 
+  //
+  // RFC2018 and RFC6675 variables, about SACK and
+  // the SACK based loss recovery.
+  //
+  TCP_SACK_BLOCK      SackBlock[TCP_SACK_SCOREBOARD_MAX]; ///< Ranges SACKed by the peer, sorted.
+  UINT8               SackBlockNum;                       ///< Number of ranges in SackBlock.
+  TCP_SEQNO           HighRxt;                            ///< Highest sequence retransmitted in recovery.
+  TCP_SEQNO           RcvSackRecent;                      ///< Seq of the latest queued segment, reported first.
+
+  //
+  // Congestion control algorithm and its state.
+  //
+  CONST TCP_CONGESTION_CONTROL    *CongestionControl;
+  TCP_CUBIC                       Cubic;
+
   //
   // RFC7323
   // Addressing Window Retraction for TCP Window Scale Option.
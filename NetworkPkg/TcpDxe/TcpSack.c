@@ -0,0 +1,367 @@
+/** @file
+  TCP SACK scoreboard and the SACK based loss recovery helpers
+  specified in RFC2018 and RFC6675.
+
+  Copyright (c) 2026, Intel Corporation. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include "TcpMain.h"
+
+/**
+  Check whether the data in front of a SACKed range of the scoreboard
+  is deemed lost, as IsLost () of RFC6675: either DupThresh discontiguous
+  ranges, or more than (DupThresh - 1) * SMSS bytes, above it are SACKed.
+
+  @param[in]  Tcb     Pointer to the TCP_CB of this TCP instance.
+  @param[in]  Index   Index of the first SACKed range above the data.
+  @param[in]  Sacked  The number of bytes SACKed above the data.
+
+  @retval TRUE        The data is deemed lost.
+  @retval FALSE       The data is not deemed lost.
+
+**/
+STATIC
+BOOLEAN
+TcpSackHoleIsLost (
+  IN TCP_CB  *Tcb,
+  IN UINTN   Index,
+  IN UINT32  Sacked
+  )
+{
+  return (BOOLEAN)(((Tcb->SackBlockNum - Index) >= TCP_DUP_THRESH) ||
+                   (Sacked > (TCP_DUP_THRESH - 1) * (UINT32)Tcb->SndMss));
+}
+
+/**
+  Get the number of bytes SACKed in the scoreboard.
+
+  @param[in]  Tcb     Pointer to the TCP_CB of this TCP instance.
+
+  @return The number of bytes SACKed.
+
+**/
+STATIC
+UINT32
+TcpSackedBytes (
+  IN TCP_CB  *Tcb
+  )
+{
+  UINT32  Sacked;
+  UINTN   Index;
+
+  Sacked = 0;
+  for (Index = 0; Index < Tcb->SackBlockNum; Index++) {
+    Sacked += TCP_SUB_SEQ (Tcb->SackBlock[Index].End, Tcb->SackBlock[Index].Seq);
+  }
+
+  return Sacked;
+}
+
+/**
+  Insert a SACKed range into the scoreboard, merging it with the
+  ranges it overlaps or abuts. If the scoreboard is full, the highest
+  range is dropped, which only makes the sender more conservative.
+
+  @param[in, out]  Tcb      Pointer to the TCP_CB of this TCP instance.
+  @param[in]       Block    The range to insert.
+
+**/
+STATIC
+VOID
+TcpSackInsert (
+  IN OUT TCP_CB          *Tcb,
+  IN     TCP_SACK_BLOCK  *Block
+  )
+{
+  TCP_SACK_BLOCK  *Board;
+  TCP_SACK_BLOCK  New;
+  UINTN           Num;
+  UINTN           First;
+  UINTN           Last;
+
+  Board = Tcb->SackBlock;
+  Num   = Tcb->SackBlockNum;
+  New   = *Block;
+
+  //
+  // Find the first range that doesn't end before the new one.
+  //
+  for (First = 0; First < Num; First++) {
+    if (TCP_SEQ_GEQ (Board[First].End, New.Seq)) {
+      break;
+    }
+  }
+
+  //
+  // Absorb the ranges which overlap or abut the new one.
+  //
+  for (Last = First; Last < Num; Last++) {
+    if (TCP_SEQ_GT (Board[Last].Seq, New.End)) {
+      break;
+    }
+
+    if (TCP_SEQ_LT (Board[Last].Seq, New.Seq)) {
+      New.Seq = Board[Last].Seq;
+    }
+
+    if (TCP_SEQ_GT (Board[Last].End, New.End)) {
+      New.End = Board[Last].End;
+    }
+  }
+
+  if (Last > First) {
+    Board[First] = New;
+    CopyMem (&Board[First + 1], &Board[Last], (Num - Last) * sizeof (TCP_SACK_BLOCK));
+    Num -= Last - First - 1;
+  } else {
+    if (Num == TCP_SACK_SCOREBOARD_MAX) {
+      if (First == TCP_SACK_SCOREBOARD_MAX) {
+        return;
+      }
+
+      Num--;
+    }
+
+    CopyMem (&Board[First + 1], &Board[First], (Num - First) * sizeof (TCP_SACK_BLOCK));
+    Board[First] = New;
+    Num++;
+  }
+
+  Tcb->SackBlockNum = (UINT8)Num;
+}
+
+/**
+  Update the SACK scoreboard with an incoming ACK and its SACK option.
+
+  Caution: This function may receive untrusted input.
+  The SACK blocks are supplied by the peer, every block not entirely
+  within SND.UNA and SND.NXT is trimmed or ignored.
+
+  @param[in, out]  Tcb      Pointer to the TCP_CB of this TCP instance.
+  @param[in]       Option   Pointer to the options parsed from the segment.
+  @param[in]       Ack      The acknowledge sequence number of the segment.
+
+**/
+VOID
+TcpSackUpdate (
+  IN OUT TCP_CB      *Tcb,
+  IN     TCP_OPTION  *Option,
+  IN     TCP_SEQNO   Ack
+  )
+{
+  TCP_SACK_BLOCK  Block;
+  UINTN           Num;
+  UINTN           Index;
+
+  //
+  // Remove the ranges cumulatively ACKed, or beyond SND.NXT
+  // after the peer retracted its window.
+  //
+  Num = 0;
+  for (Index = 0; Index < Tcb->SackBlockNum; Index++) {
+    Block = Tcb->SackBlock[Index];
+
+    if (TCP_SEQ_LT (Block.Seq, Ack)) {
+      Block.Seq = Ack;
+    }
+
+    if (TCP_SEQ_GT (Block.End, Tcb->SndNxt)) {
+      Block.End = Tcb->SndNxt;
+    }
+
+    if (TCP_SEQ_LT (Block.Seq, Block.End)) {
+      Tcb->SackBlock[Num] = Block;
+      Num++;
+    }
+  }
+
+  Tcb->SackBlockNum = (UINT8)Num;
+
+  if (!TCP_FLG_ON (Option->Flag, TCP_OPTION_RCVD_SACK)) {
+    return;
+  }
+
+  for (Index = 0; Index < Option->SackNum; Index++) {
+    Block = Option->SackBlock[Index];
+
+    //
+    // Ignore the malformed blocks, the blocks beyond SND.NXT
+    // and the D-SACK blocks of RFC2883 below SND.UNA.
+    //
+    if (TCP_SEQ_GEQ (Block.Seq, Block.End) ||
+        TCP_SEQ_LEQ (Block.End, Ack) ||
+        TCP_SEQ_GT (Block.End, Tcb->SndNxt))
+    {
+      continue;
+    }
+
+    if (TCP_SEQ_LT (Block.Seq, Ack)) {
+      Block.Seq = Ack;
+    }
+
+    TcpSackInsert (Tcb, &Block);
+  }
+}
+
+/**
+  Check whether the data at sequence Seq is deemed lost by the SACK
+  information, as IsLost () of RFC6675.
+
+  @param[in]  Tcb     Pointer to the TCP_CB of this TCP instance.
+  @param[in]  Seq     The sequence number to check.
+
+  @retval TRUE        The data is deemed lost.
+  @retval FALSE       The data is not deemed lost, or SACK isn't in use.
+
+**/
+BOOLEAN
+TcpSackIsLost (
+  IN TCP_CB     *Tcb,
+  IN TCP_SEQNO  Seq
+  )
+{
+  UINT32  Sacked;
+  UINTN   Index;
+
+  if (!TCP_FLG_ON (Tcb->CtrlFlag, TCP_CTRL_RCVD_SACK)) {
+    return FALSE;
+  }
+
+  Sacked = TcpSackedBytes (Tcb);
+
+  for (Index = 0; Index < Tcb->SackBlockNum; Index++) {
+    if (TCP_SEQ_GT (Tcb->SackBlock[Index].Seq, Seq)) {
+      return TcpSackHoleIsLost (Tcb, Index, Sacked);
+    }
+
+    if (TCP_SEQ_LT (Seq, Tcb->SackBlock[Index].End)) {
+      //
+      // The data is SACKed.
+      //
+      return FALSE;
+    }
+
+    Sacked -= TCP_SUB_SEQ (Tcb->SackBlock[Index].End, Tcb->SackBlock[Index].Seq);
+  }
+
+  return FALSE;
+}
+
+/**
+  Estimate the number of bytes in flight, as SetPipe () of RFC6675.
+
+  The data not SACKed and not deemed lost is in flight, so is the data
+  retransmitted during the current recovery. It is computed per hole of
+  the scoreboard, since all the bytes in a hole are either lost or not.
+
+  @param[in]  Tcb     Pointer to the TCP_CB of this TCP instance.
+
+  @return The number of bytes in flight.
+
+**/
+UINT32
+TcpSackPipe (
+  IN TCP_CB  *Tcb
+  )
+{
+  TCP_SACK_BLOCK  *Block;
+  TCP_SEQNO       HoleSeq;
+  UINT32          HoleLen;
+  UINT32          Sacked;
+  UINT32          Pipe;
+  UINTN           Index;
+
+  Pipe    = 0;
+  Sacked  = TcpSackedBytes (Tcb);
+  HoleSeq = Tcb->SndUna;
+
+  for (Index = 0; Index < Tcb->SackBlockNum; Index++) {
+    Block = &Tcb->SackBlock[Index];
+
+    if (TCP_SEQ_LT (HoleSeq, Block->Seq)) {
+      HoleLen = TCP_SUB_SEQ (Block->Seq, HoleSeq);
+
+      if (!TcpSackHoleIsLost (Tcb, Index, Sacked)) {
+        Pipe += HoleLen;
+      }
+
+      if (TCP_SEQ_GT (Tcb->HighRxt, HoleSeq)) {
+        Pipe += MIN (HoleLen, TCP_SUB_SEQ (Tcb->HighRxt, HoleSeq));
+      }
+    }
+
+    Sacked -= TCP_SUB_SEQ (Block->End, Block->Seq);
+    HoleSeq = Block->End;
+  }
+
+  //
+  // The data above the highest SACKed range is never deemed lost.
+  //
+  if (TCP_SEQ_LT (HoleSeq, Tcb->SndNxt)) {
+    Pipe += TCP_SUB_SEQ (Tcb->SndNxt, HoleSeq);
+  }
+
+  return Pipe;
+}
+
+/**
+  Retransmit the first data of the scoreboard holes above HighRxt,
+  as NextSeg () of RFC6675 rule (1) or, if LostOnly is FALSE, rule (3).
+  HighRxt is advanced past the retransmitted data.
+
+  @param[in, out]  Tcb       Pointer to the TCP_CB of this TCP instance.
+  @param[in]       LostOnly  Only retransmit the data deemed lost.
+
+  @return The number of bytes retransmitted, 0 if nothing is retransmitted.
+
+**/
+UINT32
+TcpSackRetransmitHole (
+  IN OUT TCP_CB   *Tcb,
+  IN     BOOLEAN  LostOnly
+  )
+{
+  TCP_SACK_BLOCK  *Block;
+  TCP_SEQNO       Seq;
+  UINT32          Sacked;
+  UINT32          Len;
+  INTN            Sent;
+  UINTN           Index;
+
+  Sacked = TcpSackedBytes (Tcb);
+  Seq    = Tcb->SndUna;
+
+  for (Index = 0; Index < Tcb->SackBlockNum; Index++) {
+    Block = &Tcb->SackBlock[Index];
+
+    if (TCP_SEQ_LT (Seq, Tcb->HighRxt)) {
+      Seq = Tcb->HighRxt;
+    }
+
+    if (TCP_SEQ_LT (Seq, Block->Seq)) {
+      if (LostOnly && !TcpSackHoleIsLost (Tcb, Index, Sacked)) {
+        //
+        // The holes above have even less data SACKed above them.
+        //
+        return 0;
+      }
+
+      Len = MIN (TCP_SUB_SEQ (Block->Seq, Seq), Tcb->SndMss);
+
+      Sent = TcpRetransmitRange (Tcb, Seq, Len);
+      if (Sent <= 0) {
+        return 0;
+      }
+
+      Tcb->HighRxt = Seq + (UINT32)Sent;
+      return (UINT32)Sent;
+    }
+
+    Sacked -= TCP_SUB_SEQ (Block->End, Block->Seq);
+    Seq     = Block->End;
+  }
+
+  return 0;
+}
@@ -180,8 +180,6 @@ TcpRexmitTimeout (
   IN OUT TCP_CB  *Tcb
   )
 {
-  UINT32  FlightSize;
-
   DEBUG (
     (DEBUG_WARN,
      "TcpRexmitTimeout: transmission timeout for TCB %p\n",
@@ -189,16 +187,21 @@ TcpRexmitTimeout (
     );
 
   //
-  // Set the congestion window. FlightSize is the
-  // amount of data that has been sent but not
-  // yet ACKed.
+  // Set the congestion window. The slow start threshold
+  // is decided by the congestion control algorithm.
   //
-  FlightSize    = TCP_SUB_SEQ (Tcb->SndNxt, Tcb->SndUna);
-  Tcb->Ssthresh = MAX ((UINT32)(2 * Tcb->SndMss), FlightSize / 2);
+  Tcb->Ssthresh = Tcb->CongestionControl->Ssthresh (Tcb);
 
   Tcb->CWnd        = Tcb->SndMss;
   Tcb->LossRecover = Tcb->SndNxt;
 
+  //
+  // The receiver may have discarded the SACKed data, so
+  // the SACK information is cleared after a timeout as
+  // required by RFC2018.
+  //
+  Tcb->SackBlockNum = 0;
+
   Tcb->LossTimes++;
   if ((Tcb->LossTimes > Tcb->MaxRexmit) && !TCP_TIMER_ON (Tcb->EnabledTimer, TCP_TIMER_CONNECT)) {
     DEBUG (
@@ -171,6 +171,49 @@ HashAndExtend (
   return Status;
 }
 
+/**
+  Hash several independent data buffers, without extending any PCR.
+
+  Every buffer is hashed with the same hash algorithms as HashAndExtend() uses,
+  and its DigestList receives the digests. Hash engines that support it digest
+  all the buffers together, which is faster than hashing them one by one.
+
+  @param Buffers     Buffers to be hashed.
+  @param BufferCount Number of entries in Buffers.
+
+  @retval EFI_SUCCESS          The DigestList of every buffer is returned.
+  @retval EFI_UNSUPPORTED      The buffers cannot be hashed without extending a PCR.
+  @retval EFI_OUT_OF_RESOURCES No enough resource to hash the buffers.
+**/
+EFI_STATUS
+EFIAPI
+HashMultiBuffer (
+  IN OUT HASH_DATA_BUFFER  *Buffers,
+  IN UINTN                 BufferCount
+  )
+{
+  HASH_HANDLE  HashHandle;
+  UINTN        Index;
+
+  if (mHashInterfaceCount == 0) {
+    ASSERT (FALSE);
+    return EFI_UNSUPPORTED;
+  }
+
+  //
+  // TDX only measures with SHA384, which gains nothing from hashing the
+  // buffers together. Hash them one by one.
+  //
+  for (Index = 0; Index < BufferCount; Index++) {
+    ZeroMem (&Buffers[Index].DigestList, sizeof (Buffers[Index].DigestList));
+    HashStart (&HashHandle);
+    mHashInterface.HashUpdate (HashHandle, Buffers[Index].DataToHash, Buffers[Index].DataToHashLen);
+    mHashInterface.HashFinal (HashHandle, &Buffers[Index].DigestList);
+  }
+
+  return EFI_SUCCESS;
+}
+
 /**
   This service register Hash.
 
@@ -1,14 +1,17 @@
 /** @file
 
-  This driver produces Block I/O Protocol instances for virtio-blk devices.
+  This driver produces Block I/O and Block I/O 2 Protocol instances for
+  virtio-blk devices.
 
   The implementation is basic:
 
   - No attach/detach (ie. removable media).
 
-  - Although the non-blocking interfaces of EFI_BLOCK_IO2_PROTOCOL could be a
-    good match for multiple in-flight virtio-blk requests, we stick to
-    synchronous requests and EFI_BLOCK_IO_PROTOCOL for now.
+  - Requests are tracked in a fixed set of request slots per virtqueue. The
+    non-blocking interfaces of EFI_BLOCK_IO2_PROTOCOL keep several requests
+    in flight, spread over the virtqueues of a VIRTIO_BLK_F_MQ device, and
+    rely on a timer to complete them. Indirect descriptors are used when the
+    host offers them, so that a request takes a single ring descriptor.
 
   Copyright (C) 2012, Red Hat, Inc.
   Copyright (c) 2012 - 2018, Intel Corporation. All rights reserved.<BR>
@@ -177,12 +180,227 @@ VerifyReadWriteRequest (
 
 /**
 
-  Format a read / write / flush request as three consecutive virtio
-  descriptors, push them to the host, and poll for the response.
+  Complete a request the host has processed, or give up on an abandoned
+  request.
 
-  This is the main workhorse function. Two use cases are supported, read/write
-  and flush. The function may only be called after the request parameters have
-  been verified by
+  The data buffer is unmapped, and the request slot is released, unless the
+  request is synchronous: the waiting caller releases that slot after
+  retrieving the status. The event of an asynchronous request is signaled.
+
+  @param[in] Dev      The virtio-blk device.
+
+  @param[in] Queue    The virtqueue the request was submitted to.
+
+  @param[in] Index    The index of the request slot in Queue.
+
+**/
+STATIC
+VOID
+VirtioBlkCompleteRequest (
+  IN VBLK_DEV    *Dev,
+  IN VBLK_QUEUE  *Queue,
+  IN UINT16      Index
+  )
+{
+  VBLK_REQUEST  *Request;
+  EFI_STATUS    Status;
+  EFI_STATUS    UnmapStatus;
+
+  Request = &Queue->Requests[Index];
+  ASSERT (Request->InUse);
+  if (Request->Abandoned) {
+    Request->InUse = FALSE;
+    return;
+  }
+
+  ASSERT (Queue->InFlight > 0);
+  Queue->InFlight--;
+
+  Status = (Queue->SharedRequests[Index].HostStatus == VIRTIO_BLK_S_OK) ?
+           EFI_SUCCESS :
+           EFI_DEVICE_ERROR;
+
+  if (Request->BufferSize > 0) {
+    UnmapStatus = Dev->VirtIo->UnmapSharedBuffer (Dev->VirtIo, Request->BufferMapping);
+    if (EFI_ERROR (UnmapStatus) && !Request->RequestIsWrite && !EFI_ERROR (Status)) {
+      //
+      // Data from the bus master may not reach the caller; fail the request.
+      //
+      Status = EFI_DEVICE_ERROR;
+    }
+  }
+
+  if (Request->Token == NULL) {
+    Request->Status = Status;
+    Request->Done   = TRUE;
+    return;
+  }
+
+  Request->Token->TransactionStatus = Status;
+  gBS->SignalEvent (Request->Token->Event);
+  Request->InUse = FALSE;
+}
+
+/**
+
+  Give up on a device that returned a used element the driver cannot match
+  to a request in flight.
+
+  No further request is submitted, and no further used element is read from
+  any virtqueue of the device. All requests in flight fail with
+  EFI_DEVICE_ERROR. Their data buffers are unmapped and their slots are kept,
+  as for a request abandoned in VirtioBlkSubmitRequest().
+
+  The caller is responsible for running at TPL_NOTIFY.
+
+  @param[in] Dev  The virtio-blk device.
+
+**/
+STATIC
+VOID
+VirtioBlkFailDevice (
+  IN VBLK_DEV  *Dev
+  )
+{
+  VBLK_QUEUE    *Queue;
+  VBLK_REQUEST  *Request;
+  UINT16        QueueIndex;
+  UINT16        Index;
+
+  Dev->DeviceError = TRUE;
+
+  for (QueueIndex = 0; QueueIndex < Dev->NumQueues; QueueIndex++) {
+    Queue = &Dev->Queues[QueueIndex];
+    for (Index = 0; Index < Queue->RequestCount; Index++) {
+      Request = &Queue->Requests[Index];
+      if (!Request->InUse || Request->Abandoned || Request->Done) {
+        continue;
+      }
+
+      Request->Abandoned = TRUE;
+      ASSERT (Queue->InFlight > 0);
+      Queue->InFlight--;
+      if (Request->BufferSize > 0) {
+        Dev->VirtIo->UnmapSharedBuffer (Dev->VirtIo, Request->BufferMapping);
+      }
+
+      if (Request->Token == NULL) {
+        Request->Status = EFI_DEVICE_ERROR;
+        Request->Done   = TRUE;
+      } else {
+        Request->Token->TransactionStatus = EFI_DEVICE_ERROR;
+        gBS->SignalEvent (Request->Token->Event);
+      }
+    }
+  }
+}
+
+/**
+
+  Complete all requests of a virtqueue that the host has processed.
+
+  The caller is responsible for running at TPL_NOTIFY.
+
+  @param[in] Dev    The virtio-blk device.
+
+  @param[in] Queue  The virtqueue to process.
+
+**/
+STATIC
+VOID
+VirtioBlkProcessQueue (
+  IN VBLK_DEV    *Dev,
+  IN VBLK_QUEUE  *Queue
+  )
+{
+  UINT16  UsedIdx;
+  UINT32  DescIdx;
+
+  if (Dev->DeviceError) {
+    return;
+  }
+
+  //
+  // virtio-0.9.5, 2.4.2 Receiving Used Buffers From the Device
+  //
+  MemoryFence ();
+  UsedIdx = *Queue->Ring.Used.Idx;
+  MemoryFence ();
+
+  while (Queue->LastUsedIdx != UsedIdx) {
+    DescIdx = Queue->Ring.Used.UsedElem[Queue->LastUsedIdx % Queue->Ring.QueueSize].Id;
+    if (!Dev->IndirectDesc) {
+      if (DescIdx % VBLK_DESC_PER_REQUEST != 0) {
+        DescIdx = MAX_UINT32;
+      } else {
+        DescIdx /= VBLK_DESC_PER_REQUEST;
+      }
+    }
+
+    //
+    // The element must name the head of a request that is in flight and not
+    // completed yet. Anything else is a device bug; completing a slot the
+    // host does not own would corrupt the driver state.
+    //
+    if ((DescIdx >= Queue->RequestCount) ||
+        !Queue->Requests[DescIdx].InUse ||
+        Queue->Requests[DescIdx].Done)
+    {
+      DEBUG ((
+        DEBUG_ERROR,
+        "%a: bad used element %u at index %u\n",
+        __func__,
+        Queue->Ring.Used.UsedElem[Queue->LastUsedIdx % Queue->Ring.QueueSize].Id,
+        Queue->LastUsedIdx
+        ));
+      VirtioBlkFailDevice (Dev);
+      return;
+    }
+
+    VirtioBlkCompleteRequest (Dev, Queue, (UINT16)DescIdx);
+    Queue->LastUsedIdx++;
+  }
+}
+
+/**
+
+  Timer notification function that completes asynchronous requests.
+
+  @param[in] Event    Event whose notification function is being invoked.
+
+  @param[in] Context  Pointer to the VBLK_DEV structure.
+
+**/
+STATIC
+VOID
+EFIAPI
+VirtioBlkAsyncPoll (
+  IN  EFI_EVENT  Event,
+  IN  VOID       *Context
+  )
+{
+  VBLK_DEV  *Dev;
+  UINT16    QueueIndex;
+
+  Dev = Context;
+  for (QueueIndex = 0; QueueIndex < Dev->NumQueues; QueueIndex++) {
+    if (Dev->Queues[QueueIndex].InFlight > 0) {
+      VirtioBlkProcessQueue (Dev, &Dev->Queues[QueueIndex]);
+    }
+  }
+}
+
+/**
+
+  Format a read / write / flush request as virtio descriptors and push it to
+  the host, without waiting for the response.
+
+  The request takes a free request slot of one of the virtqueues, which are
+  used in turn. If all request slots are busy, the function polls the host
+  until one is released.
+
+  The function may only be called after the request parameters have been
+  verified by
   - specific checks in ReadBlocks() / WriteBlocks() / FlushBlocks(), and
   - VerifyReadWriteRequest() (for read/write only).
 
@@ -191,6 +409,13 @@ VerifyReadWriteRequest (
     @param[in] Dev             The virtio-blk device the request is targeted
                                at.
 
+    @param[in] Token           The token of an asynchronous request, or NULL
+                               for a synchronous request.
+
+    @param[out] QueueIndex     The virtqueue the request was submitted to.
+
+    @param[out] Index          The request slot the request occupies.
+
   Flush request:
 
     @param[in] Lba             Must be zero.
@@ -216,43 +441,44 @@ VerifyReadWriteRequest (
     @param[in] RequestIsWrite  TRUE iff data transfer goes from guest to
                                device.
 
-  Return values are common to both use cases, and are appropriate to be
-  forwarded by the EFI_BLOCK_IO_PROTOCOL functions (ReadBlocks(),
-  WriteBlocks(), FlushBlocks()).
 
+  @retval EFI_SUCCESS          The request has been pushed to the host.
 
-  @retval EFI_SUCCESS          Transfer complete.
-
-  @retval EFI_DEVICE_ERROR     Failed to notify host side via VirtIo write, or
-                               unable to parse host response, or host response
-                               is not VIRTIO_BLK_S_OK or failed to map Buffer
-                               for a bus master operation.
+  @retval EFI_DEVICE_ERROR     Failed to map Buffer for a bus master operation,
+                               or to notify host side via VirtIo write, or the
+                               device returned a bad used element earlier.
 
 **/
 STATIC
 EFI_STATUS
-EFIAPI
-SynchronousRequest (
-  IN              VBLK_DEV  *Dev,
-  IN              EFI_LBA   Lba,
-  IN              UINTN     BufferSize,
-  IN OUT volatile VOID      *Buffer,
-  IN              BOOLEAN   RequestIsWrite
+VirtioBlkSubmitRequest (
+  IN              VBLK_DEV             *Dev,
+  IN              EFI_LBA              Lba,
+  IN              UINTN                BufferSize,
+  IN OUT volatile VOID                 *Buffer,
+  IN              BOOLEAN              RequestIsWrite,
+  IN              EFI_BLOCK_IO2_TOKEN  *Token,
+  OUT             UINT16               *QueueIndex,
+  OUT             UINT16               *Index
   )
 {
-  UINT32                   BlockSize;
-  volatile VIRTIO_BLK_REQ  *Request;
-  volatile UINT8           *HostStatus;
-  VOID                     *HostStatusBuffer;
-  DESC_INDICES             Indices;
-  VOID                     *RequestMapping;
-  VOID                     *StatusMapping;
-  VOID                     *BufferMapping;
-  EFI_PHYSICAL_ADDRESS     BufferDeviceAddress;
-  EFI_PHYSICAL_ADDRESS     HostStatusDeviceAddress;
-  EFI_PHYSICAL_ADDRESS     RequestDeviceAddress;
-  EFI_STATUS               Status;
-  EFI_STATUS               UnmapStatus;
+  UINT32                        BlockSize;
+  VOID                          *BufferMapping;
+  EFI_PHYSICAL_ADDRESS          BufferDeviceAddress;
+  EFI_PHYSICAL_ADDRESS          SharedDeviceAddress;
+  EFI_STATUS                    Status;
+  EFI_TPL                       OldTpl;
+  VBLK_QUEUE                    *Queue;
+  VBLK_REQUEST                  *Request;
+  volatile VBLK_SHARED_REQUEST  *Shared;
+  volatile VRING_DESC           *Desc;
+  UINT16                        DescCount;
+  UINT16                        HeadDescIdx;
+  UINT16                        AvailIdx;
+  UINT16                        Attempt;
+  UINT16                        QueueNo;
+  UINT16                        Slot;
+  UINTN                         PollPeriodUsecs;
 
   BlockSize = Dev->BlockIoMedia.BlockSize;
 
@@ -274,54 +500,15 @@ SynchronousRequest (
   //
   ASSERT (BufferSize % BlockSize == 0);
 
-  Request = AllocateZeroPool (sizeof (*Request));
-  if (Request == NULL) {
-    return EFI_DEVICE_ERROR;
-  }
-
   //
-  // Prepare virtio-blk request header, setting zero size for flush.
-  // IO Priority is homogeneously 0.
+  // From virtio-0.9.5, 2.3.2 Descriptor Table:
+  // "no descriptor chain may be more than 2^32 bytes long in total".
   //
-  Request->Type = RequestIsWrite ?
-                  (BufferSize == 0 ? VIRTIO_BLK_T_FLUSH : VIRTIO_BLK_T_OUT) :
-                  VIRTIO_BLK_T_IN;
-  Request->IoPrio = 0;
-  Request->Sector = MultU64x32 (Lba, BlockSize / 512);
-
-  //
-  // Host status is bi-directional (we preset with a value and expect the
-  // device to update it). Allocate a host status buffer which can be mapped
-  // to access equally by both processor and the device.
+  // The predicate is ensured by the call contract above (for flush), or
+  // VerifyReadWriteRequest() (for read/write). It also implies that
+  // converting BufferSize to UINT32 will not truncate it.
   //
-  Status = Dev->VirtIo->AllocateSharedPages (
-                          Dev->VirtIo,
-                          EFI_SIZE_TO_PAGES (sizeof *HostStatus),
-                          &HostStatusBuffer
-                          );
-  if (EFI_ERROR (Status)) {
-    Status = EFI_DEVICE_ERROR;
-    goto FreeBlkRequest;
-  }
-
-  HostStatus = HostStatusBuffer;
-
-  //
-  // Map virtio-blk request header (must be done after request header is
-  // populated)
-  //
-  Status = VirtioMapAllBytesInSharedBuffer (
-             Dev->VirtIo,
-             VirtioOperationBusMasterRead,
-             (VOID *)Request,
-             sizeof (*Request),
-             &RequestDeviceAddress,
-             &RequestMapping
-             );
-  if (EFI_ERROR (Status)) {
-    Status = EFI_DEVICE_ERROR;
-    goto FreeHostStatusBuffer;
-  }
+  ASSERT (BufferSize <= SIZE_1GB);
 
   //
   // Map data buffer
@@ -338,170 +525,621 @@ SynchronousRequest (
                &BufferMapping
                );
     if (EFI_ERROR (Status)) {
-      Status = EFI_DEVICE_ERROR;
-      goto UnmapRequestBuffer;
+      return EFI_DEVICE_ERROR;
     }
   }
 
   //
-  // preset a host status for ourselves that we do not accept as success
-  //
-  *HostStatus = VIRTIO_BLK_S_IOERR;
+  // Find a free request slot, trying the virtqueues in turn. Keep slowing
+  // down until we reach a poll period of slightly above 1 ms.
+  //
+  PollPeriodUsecs = 1;
+  Request         = NULL;
+  while (TRUE) {
+    OldTpl = gBS->RaiseTPL (TPL_NOTIFY);
+    for (Attempt = 0; Attempt < Dev->NumQueues && Request == NULL; Attempt++) {
+      QueueNo        = Dev->NextQueue;
+      Queue          = &Dev->Queues[QueueNo];
+      Dev->NextQueue = (UINT16)((QueueNo + 1) % Dev->NumQueues);
+      if (Queue->InFlight == Queue->RequestCount) {
+        VirtioBlkProcessQueue (Dev, Queue);
+      }
+
+      if (Dev->DeviceError) {
+        break;
+      }
+
+      for (Slot = 0; Slot < Queue->RequestCount; Slot++) {
+        if (!Queue->Requests[Slot].InUse) {
+          Request = &Queue->Requests[Slot];
+          break;
+        }
+      }
+    }
 
-  //
-  // Map the Status Buffer with VirtioOperationBusMasterCommonBuffer so that
-  // both processor and device can access it.
-  //
-  Status = VirtioMapAllBytesInSharedBuffer (
-             Dev->VirtIo,
-             VirtioOperationBusMasterCommonBuffer,
-             HostStatusBuffer,
-             sizeof *HostStatus,
-             &HostStatusDeviceAddress,
-             &StatusMapping
-             );
-  if (EFI_ERROR (Status)) {
-    Status = EFI_DEVICE_ERROR;
-    goto UnmapDataBuffer;
+    if (Request != NULL) {
+      break;
+    }
+
+    if (Dev->DeviceError) {
+      gBS->RestoreTPL (OldTpl);
+      if (BufferSize > 0) {
+        Dev->VirtIo->UnmapSharedBuffer (Dev->VirtIo, BufferMapping);
+      }
+
+      return EFI_DEVICE_ERROR;
+    }
+
+    gBS->RestoreTPL (OldTpl);
+    gBS->Stall (PollPeriodUsecs); // calls AcpiTimerLib::MicroSecondDelay
+    if (PollPeriodUsecs < 1024) {
+      PollPeriodUsecs *= 2;
+    }
   }
 
-  VirtioPrepare (&Dev->Ring, &Indices);
+  *QueueIndex = QueueNo;
+  *Index      = Slot;
+  ZeroMem (Request, sizeof *Request);
+  Request->InUse          = TRUE;
+  Request->RequestIsWrite = RequestIsWrite;
+  Request->BufferSize     = BufferSize;
+  Request->BufferMapping  = BufferMapping;
+  Request->Token          = Token;
+  Queue->InFlight++;
 
   //
-  // ensured by VirtioBlkInit() -- this predicate, in combination with the
-  // lock-step progress, ensures we don't have to track free descriptors.
+  // Prepare virtio-blk request header, setting zero size for flush.
+  // IO Priority is homogeneously 0. Preset a host status for ourselves that
+  // we do not accept as success.
+  //
+  Shared                = &Queue->SharedRequests[Slot];
+  SharedDeviceAddress   = Queue->SharedRequestsDeviceAddress + Slot * sizeof (VBLK_SHARED_REQUEST);
+  Shared->Header.Type   = RequestIsWrite ?
+                          (BufferSize == 0 ? VIRTIO_BLK_T_FLUSH : VIRTIO_BLK_T_OUT) :
+                          VIRTIO_BLK_T_IN;
+  Shared->Header.IoPrio = 0;
+  Shared->Header.Sector = MultU64x32 (Lba, BlockSize / 512);
+  Shared->HostStatus    = VIRTIO_BLK_S_IOERR;
+
+  //
+  // With indirect descriptors, the request takes a single descriptor of the
+  // ring, which points to the descriptor table of the request slot. Otherwise
+  // the request slot owns VBLK_DESC_PER_REQUEST consecutive descriptors of the
+  // ring.
   //
-  ASSERT (Dev->Ring.QueueSize >= 3);
+  if (Dev->IndirectDesc) {
+    HeadDescIdx = Slot;
+    Desc        = Shared->Indirect;
+  } else {
+    HeadDescIdx = (UINT16)(Slot * VBLK_DESC_PER_REQUEST);
+    Desc        = &Queue->Ring.Desc[HeadDescIdx];
+  }
 
   //
   // virtio-blk header in first desc
   //
-  VirtioAppendDesc (
-    &Dev->Ring,
-    RequestDeviceAddress,
-    sizeof (*Request),
-    VRING_DESC_F_NEXT,
-    &Indices
-    );
+  Desc[0].Addr  = SharedDeviceAddress + OFFSET_OF (VBLK_SHARED_REQUEST, Header);
+  Desc[0].Len   = sizeof Shared->Header;
+  Desc[0].Flags = VRING_DESC_F_NEXT;
+  Desc[0].Next  = 1;
+  DescCount     = 1;
 
   //
   // data buffer for read/write in second desc
+  // VRING_DESC_F_WRITE is interpreted from the host's point of view.
   //
   if (BufferSize > 0) {
-    //
-    // From virtio-0.9.5, 2.3.2 Descriptor Table:
-    // "no descriptor chain may be more than 2^32 bytes long in total".
-    //
-    // The predicate is ensured by the call contract above (for flush), or
-    // VerifyReadWriteRequest() (for read/write). It also implies that
-    // converting BufferSize to UINT32 will not truncate it.
-    //
-    ASSERT (BufferSize <= SIZE_1GB);
+    Desc[DescCount].Addr  = BufferDeviceAddress;
+    Desc[DescCount].Len   = (UINT32)BufferSize;
+    Desc[DescCount].Flags = VRING_DESC_F_NEXT | (RequestIsWrite ? 0 : VRING_DESC_F_WRITE);
+    Desc[DescCount].Next  = (UINT16)(DescCount + 1);
+    DescCount++;
+  }
 
+  //
+  // host status in last (second or third) desc
+  //
+  Desc[DescCount].Addr  = SharedDeviceAddress + OFFSET_OF (VBLK_SHARED_REQUEST, HostStatus);
+  Desc[DescCount].Len   = sizeof Shared->HostStatus;
+  Desc[DescCount].Flags = VRING_DESC_F_WRITE;
+  Desc[DescCount].Next  = 0;
+  DescCount++;
+
+  if (!Dev->IndirectDesc) {
     //
-    // VRING_DESC_F_WRITE is interpreted from the host's point of view.
+    // Chain the descriptors by their index in the ring.
     //
-    VirtioAppendDesc (
-      &Dev->Ring,
-      BufferDeviceAddress,
-      (UINT32)BufferSize,
-      VRING_DESC_F_NEXT | (RequestIsWrite ? 0 : VRING_DESC_F_WRITE),
-      &Indices
-      );
+    Desc[0].Next = (UINT16)(Desc[0].Next + HeadDescIdx);
+    if (DescCount == VBLK_DESC_PER_REQUEST) {
+      Desc[1].Next = (UINT16)(Desc[1].Next + HeadDescIdx);
+    }
+  } else {
+    Desc        = &Queue->Ring.Desc[HeadDescIdx];
+    Desc->Addr  = SharedDeviceAddress + OFFSET_OF (VBLK_SHARED_REQUEST, Indirect);
+    Desc->Len   = (UINT32)(DescCount * sizeof (VRING_DESC));
+    Desc->Flags = VRING_DESC_F_INDIRECT;
+    Desc->Next  = 0;
   }
 
   //
-  // host status in last (second or third) desc
+  // virtio-0.9.5, 2.4.1.2 Updating the Available Ring
+  // virtio-0.9.5, 2.4.1.3 Updating the Index Field
   //
-  VirtioAppendDesc (
-    &Dev->Ring,
-    HostStatusDeviceAddress,
-    sizeof *HostStatus,
-    VRING_DESC_F_WRITE,
-    &Indices
-    );
-
-  //
-  // virtio-blk's only virtqueue is #0, called "requestq" (see Appendix D).
-  //
-  if ((VirtioFlush (
-         Dev->VirtIo,
-         0,
-         &Dev->Ring,
-         &Indices,
-         NULL
-         ) == EFI_SUCCESS) &&
-      (*HostStatus == VIRTIO_BLK_S_OK))
-  {
-    Status = EFI_SUCCESS;
-  } else {
+  AvailIdx                                                   = *Queue->Ring.Avail.Idx;
+  Queue->Ring.Avail.Ring[AvailIdx++ % Queue->Ring.QueueSize] = HeadDescIdx;
+
+  MemoryFence ();
+  *Queue->Ring.Avail.Idx = AvailIdx;
+
+  //
+  // virtio-0.9.5, 2.4.1.4 Notifying the Device -- gratuitous notifications are
+  // OK.
+  //
+  MemoryFence ();
+  Status = Dev->VirtIo->SetQueueNotify (Dev->VirtIo, QueueNo);
+  if (EFI_ERROR (Status)) {
+    //
+    // The host may still process the request at some point; keep its slot
+    // until then, but do not report the completion.
+    //
+    Request->Abandoned = TRUE;
+    Queue->InFlight--;
+    if (BufferSize > 0) {
+      Dev->VirtIo->UnmapSharedBuffer (Dev->VirtIo, BufferMapping);
+    }
+
     Status = EFI_DEVICE_ERROR;
   }
 
-  Dev->VirtIo->UnmapSharedBuffer (Dev->VirtIo, StatusMapping);
+  gBS->RestoreTPL (OldTpl);
+  return Status;
+}
+
+/**
+
+  Wait until the host processes a synchronous request, and release its request
+  slot.
+
+  @param[in] Dev         The virtio-blk device.
+
+  @param[in] QueueIndex  The virtqueue the request was submitted to.
+
+  @param[in] Index       The request slot the request occupies.
+
+  @return                The status of the request, see SynchronousRequest().
+
+**/
+STATIC
+EFI_STATUS
+VirtioBlkWaitRequest (
+  IN VBLK_DEV  *Dev,
+  IN UINT16    QueueIndex,
+  IN UINT16    Index
+  )
+{
+  VBLK_QUEUE    *Queue;
+  VBLK_REQUEST  *Request;
+  EFI_STATUS    Status;
+  EFI_TPL       OldTpl;
+  BOOLEAN       Done;
+  UINTN         PollPeriodUsecs;
+
+  Queue   = &Dev->Queues[QueueIndex];
+  Request = &Queue->Requests[Index];
+  Status  = EFI_DEVICE_ERROR;
+
+  //
+  // Keep slowing down until we reach a poll period of slightly above 1 ms.
+  //
+  PollPeriodUsecs = 1;
+  while (TRUE) {
+    OldTpl = gBS->RaiseTPL (TPL_NOTIFY);
+    VirtioBlkProcessQueue (Dev, Queue);
+    Done = Request->Done;
+    if (Done) {
+      Status         = Request->Status;
+      Request->InUse = FALSE;
+    }
+
+    gBS->RestoreTPL (OldTpl);
+    if (Done) {
+      return Status;
+    }
+
+    gBS->Stall (PollPeriodUsecs); // calls AcpiTimerLib::MicroSecondDelay
+    if (PollPeriodUsecs < 1024) {
+      PollPeriodUsecs *= 2;
+    }
+  }
+}
+
+/**
 
-UnmapDataBuffer:
-  if (BufferSize > 0) {
-    UnmapStatus = Dev->VirtIo->UnmapSharedBuffer (Dev->VirtIo, BufferMapping);
-    if (EFI_ERROR (UnmapStatus) && !RequestIsWrite && !EFI_ERROR (Status)) {
-      //
-      // Data from the bus master may not reach the caller; fail the request.
-      //
-      Status = EFI_DEVICE_ERROR;
+  Wait until the host processes all requests in flight.
+
+  @param[in] Dev  The virtio-blk device.
+
+**/
+STATIC
+VOID
+VirtioBlkDrain (
+  IN VBLK_DEV  *Dev
+  )
+{
+  EFI_TPL  OldTpl;
+  UINT16   QueueIndex;
+  UINTN    InFlight;
+  UINTN    PollPeriodUsecs;
+
+  PollPeriodUsecs = 1;
+  while (TRUE) {
+    InFlight = 0;
+    OldTpl   = gBS->RaiseTPL (TPL_NOTIFY);
+    for (QueueIndex = 0; QueueIndex < Dev->NumQueues; QueueIndex++) {
+      VirtioBlkProcessQueue (Dev, &Dev->Queues[QueueIndex]);
+      InFlight += Dev->Queues[QueueIndex].InFlight;
+    }
+
+    gBS->RestoreTPL (OldTpl);
+    if (InFlight == 0) {
+      return;
+    }
+
+    gBS->Stall (PollPeriodUsecs); // calls AcpiTimerLib::MicroSecondDelay
+    if (PollPeriodUsecs < 1024) {
+      PollPeriodUsecs *= 2;
     }
   }
+}
 
-UnmapRequestBuffer:
-  Dev->VirtIo->UnmapSharedBuffer (Dev->VirtIo, RequestMapping);
+/**
 
-FreeHostStatusBuffer:
-  Dev->VirtIo->FreeSharedPages (
-                 Dev->VirtIo,
-                 EFI_SIZE_TO_PAGES (sizeof *HostStatus),
-                 HostStatusBuffer
-                 );
+  Format a read / write / flush request as virtio descriptors, push them to
+  the host, and poll for the response.
 
-FreeBlkRequest:
-  FreePool ((VOID *)Request);
+  This is the main workhorse function of the synchronous interfaces. Two use
+  cases are supported, read/write and flush. The function may only be called
+  after the request parameters have been verified by
+  - specific checks in ReadBlocks() / WriteBlocks() / FlushBlocks(), and
+  - VerifyReadWriteRequest() (for read/write only).
 
-  return Status;
+  Parameters handled commonly:
+
+    @param[in] Dev             The virtio-blk device the request is targeted
+                               at.
+
+  Flush request:
+
+    @param[in] Lba             Must be zero.
+
+    @param[in] BufferSize      Must be zero.
+
+    @param[in out] Buffer      Ignored by the function.
+
+    @param[in] RequestIsWrite  Must be TRUE.
+
+  Read/Write request:
+
+    @param[in] Lba             Logical Block Address: number of logical blocks
+                               to skip from the beginning of the device.
+
+    @param[in] BufferSize      Size of buffer to transfer, in bytes. The caller
+                               is responsible to ensure this parameter is
+                               positive.
+
+    @param[in out] Buffer      The guest side area to read data from the device
+                               into, or write data to the device from.
+
+    @param[in] RequestIsWrite  TRUE iff data transfer goes from guest to
+                               device.
+
+  Return values are common to both use cases, and are appropriate to be
+  forwarded by the EFI_BLOCK_IO_PROTOCOL functions (ReadBlocks(),
+  WriteBlocks(), FlushBlocks()).
+
+
+  @retval EFI_SUCCESS          Transfer complete.
+
+  @retval EFI_DEVICE_ERROR     Failed to notify host side via VirtIo write, or
+                               unable to parse host response, or host response
+                               is not VIRTIO_BLK_S_OK or failed to map Buffer
+                               for a bus master operation.
+
+**/
+STATIC
+EFI_STATUS
+EFIAPI
+SynchronousRequest (
+  IN              VBLK_DEV  *Dev,
+  IN              EFI_LBA   Lba,
+  IN              UINTN     BufferSize,
+  IN OUT volatile VOID      *Buffer,
+  IN              BOOLEAN   RequestIsWrite
+  )
+{
+  EFI_STATUS  Status;
+  UINT16      QueueIndex;
+  UINT16      Index;
+
+  Status = VirtioBlkSubmitRequest (
+             Dev,
+             Lba,
+             BufferSize,
+             Buffer,
+             RequestIsWrite,
+             NULL,
+             &QueueIndex,
+             &Index
+             );
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  return VirtioBlkWaitRequest (Dev, QueueIndex, Index);
+}
+
+/**
+
+  Submit a read / write / flush request on behalf of the Block I/O 2 Protocol
+  interfaces.
+
+  The request is synchronous if Token is NULL or Token->Event is NULL.
+  Otherwise Token->Event is signaled when the request completes; the function
+  signals it before returning for an empty transfer.
+
+  The parameters are those of SynchronousRequest(), plus:
+
+  @param[in out] Token  The Block I/O 2 token of the request, or NULL.
+
+  @retval EFI_SUCCESS   The request completed, or it was queued and
+                        Token->Event is signaled upon its completion.
+
+  @return               Error codes from SynchronousRequest() and
+                        VirtioBlkSubmitRequest().
+
+**/
+STATIC
+EFI_STATUS
+AsynchronousRequest (
+  IN              VBLK_DEV             *Dev,
+  IN              EFI_LBA              Lba,
+  IN              UINTN                BufferSize,
+  IN OUT volatile VOID                 *Buffer,
+  IN              BOOLEAN              RequestIsWrite,
+  IN OUT          EFI_BLOCK_IO2_TOKEN  *Token
+  )
+{
+  UINT16  QueueIndex;
+  UINT16  Index;
+
+  if ((Token == NULL) || (Token->Event == NULL)) {
+    return SynchronousRequest (Dev, Lba, BufferSize, Buffer, RequestIsWrite);
+  }
+
+  Token->TransactionStatus = EFI_SUCCESS;
+  return VirtioBlkSubmitRequest (
+           Dev,
+           Lba,
+           BufferSize,
+           Buffer,
+           RequestIsWrite,
+           Token,
+           &QueueIndex,
+           &Index
+           );
+}
+
+/**
+
+  ReadBlocks() operation for virtio-blk.
+
+  See
+  - UEFI Spec 2.3.1 + Errata C, 12.8 EFI Block I/O Protocol, 12.8 EFI Block I/O
+    Protocol, EFI_BLOCK_IO_PROTOCOL.ReadBlocks().
+  - Driver Writer's Guide for UEFI 2.3.1 v1.01, 24.2.2. ReadBlocks() and
+    ReadBlocksEx() Implementation.
+
+  Parameter checks and conformant return values are implemented in
+  VerifyReadWriteRequest() and SynchronousRequest().
+
+  A zero BufferSize doesn't seem to be prohibited, so do nothing in that case,
+  successfully.
+
+**/
+EFI_STATUS
+EFIAPI
+VirtioBlkReadBlocks (
+  IN  EFI_BLOCK_IO_PROTOCOL  *This,
+  IN  UINT32                 MediaId,
+  IN  EFI_LBA                Lba,
+  IN  UINTN                  BufferSize,
+  OUT VOID                   *Buffer
+  )
+{
+  VBLK_DEV    *Dev;
+  EFI_STATUS  Status;
+
+  if (BufferSize == 0) {
+    return EFI_SUCCESS;
+  }
+
+  Dev    = VIRTIO_BLK_FROM_BLOCK_IO (This);
+  Status = VerifyReadWriteRequest (
+             &Dev->BlockIoMedia,
+             Lba,
+             BufferSize,
+             FALSE               // RequestIsWrite
+             );
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  return SynchronousRequest (
+           Dev,
+           Lba,
+           BufferSize,
+           Buffer,
+           FALSE       // RequestIsWrite
+           );
+}
+
+/**
+
+  WriteBlocks() operation for virtio-blk.
+
+  See
+  - UEFI Spec 2.3.1 + Errata C, 12.8 EFI Block I/O Protocol, 12.8 EFI Block I/O
+    Protocol, EFI_BLOCK_IO_PROTOCOL.WriteBlocks().
+  - Driver Writer's Guide for UEFI 2.3.1 v1.01, 24.2.3 WriteBlocks() and
+    WriteBlockEx() Implementation.
+
+  Parameter checks and conformant return values are implemented in
+  VerifyReadWriteRequest() and SynchronousRequest().
+
+  A zero BufferSize doesn't seem to be prohibited, so do nothing in that case,
+  successfully.
+
+**/
+EFI_STATUS
+EFIAPI
+VirtioBlkWriteBlocks (
+  IN EFI_BLOCK_IO_PROTOCOL  *This,
+  IN UINT32                 MediaId,
+  IN EFI_LBA                Lba,
+  IN UINTN                  BufferSize,
+  IN VOID                   *Buffer
+  )
+{
+  VBLK_DEV    *Dev;
+  EFI_STATUS  Status;
+
+  if (BufferSize == 0) {
+    return EFI_SUCCESS;
+  }
+
+  Dev    = VIRTIO_BLK_FROM_BLOCK_IO (This);
+  Status = VerifyReadWriteRequest (
+             &Dev->BlockIoMedia,
+             Lba,
+             BufferSize,
+             TRUE                // RequestIsWrite
+             );
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  return SynchronousRequest (
+           Dev,
+           Lba,
+           BufferSize,
+           Buffer,
+           TRUE        // RequestIsWrite
+           );
+}
+
+/**
+
+  FlushBlocks() operation for virtio-blk.
+
+  See
+  - UEFI Spec 2.3.1 + Errata C, 12.8 EFI Block I/O Protocol, 12.8 EFI Block I/O
+    Protocol, EFI_BLOCK_IO_PROTOCOL.FlushBlocks().
+  - Driver Writer's Guide for UEFI 2.3.1 v1.01, 24.2.4 FlushBlocks() and
+    FlushBlocksEx() Implementation.
+
+  If the underlying virtio-blk device doesn't support flushing (ie.
+  write-caching), then this function should not be called by higher layers,
+  according to EFI_BLOCK_IO_MEDIA characteristics set in VirtioBlkInit().
+  Should they do nonetheless, we do nothing, successfully.
+
+**/
+EFI_STATUS
+EFIAPI
+VirtioBlkFlushBlocks (
+  IN EFI_BLOCK_IO_PROTOCOL  *This
+  )
+{
+  VBLK_DEV  *Dev;
+
+  Dev = VIRTIO_BLK_FROM_BLOCK_IO (This);
+  if (!Dev->BlockIoMedia.WriteCaching) {
+    return EFI_SUCCESS;
+  }
+
+  //
+  // Cover the writes of Block I/O 2 requests still in flight.
+  //
+  VirtioBlkDrain (Dev);
+  return SynchronousRequest (
+           Dev,
+           0,      // Lba
+           0,      // BufferSize
+           NULL,   // Buffer
+           TRUE    // RequestIsWrite
+           );
+}
+
+/**
+
+  Reset() operation of EFI_BLOCK_IO2_PROTOCOL for virtio-blk.
+
+  See
+  - UEFI Spec 2.10, 13.10 Block I/O 2 Protocol, EFI_BLOCK_IO2_PROTOCOL.Reset().
+
+  If we managed to initialize and install the driver, then the device is
+  working correctly; the function only waits until the requests in flight
+  complete.
+
+**/
+EFI_STATUS
+EFIAPI
+VirtioBlkResetEx (
+  IN EFI_BLOCK_IO2_PROTOCOL  *This,
+  IN BOOLEAN                 ExtendedVerification
+  )
+{
+  VirtioBlkDrain (VIRTIO_BLK_FROM_BLOCK_IO2 (This));
+  return EFI_SUCCESS;
 }
 
 /**
 
-  ReadBlocks() operation for virtio-blk.
+  ReadBlocksEx() operation for virtio-blk.
 
   See
-  - UEFI Spec 2.3.1 + Errata C, 12.8 EFI Block I/O Protocol, 12.8 EFI Block I/O
-    Protocol, EFI_BLOCK_IO_PROTOCOL.ReadBlocks().
+  - UEFI Spec 2.10, 13.10 Block I/O 2 Protocol,
+    EFI_BLOCK_IO2_PROTOCOL.ReadBlocksEx().
   - Driver Writer's Guide for UEFI 2.3.1 v1.01, 24.2.2. ReadBlocks() and
     ReadBlocksEx() Implementation.
 
   Parameter checks and conformant return values are implemented in
-  VerifyReadWriteRequest() and SynchronousRequest().
-
-  A zero BufferSize doesn't seem to be prohibited, so do nothing in that case,
-  successfully.
+  VerifyReadWriteRequest() and AsynchronousRequest().
 
 **/
 EFI_STATUS
 EFIAPI
-VirtioBlkReadBlocks (
-  IN  EFI_BLOCK_IO_PROTOCOL  *This,
-  IN  UINT32                 MediaId,
-  IN  EFI_LBA                Lba,
-  IN  UINTN                  BufferSize,
-  OUT VOID                   *Buffer
+VirtioBlkReadBlocksEx (
+  IN     EFI_BLOCK_IO2_PROTOCOL  *This,
+  IN     UINT32                  MediaId,
+  IN     EFI_LBA                 Lba,
+  IN OUT EFI_BLOCK_IO2_TOKEN     *Token,
+  IN     UINTN                   BufferSize,
+  OUT    VOID                    *Buffer
   )
 {
   VBLK_DEV    *Dev;
   EFI_STATUS  Status;
 
   if (BufferSize == 0) {
+    if ((Token != NULL) && (Token->Event != NULL)) {
+      Token->TransactionStatus = EFI_SUCCESS;
+      gBS->SignalEvent (Token->Event);
+    }
+
     return EFI_SUCCESS;
   }
 
-  Dev    = VIRTIO_BLK_FROM_BLOCK_IO (This);
+  Dev    = VIRTIO_BLK_FROM_BLOCK_IO2 (This);
   Status = VerifyReadWriteRequest (
              &Dev->BlockIoMedia,
              Lba,
@@ -512,50 +1150,54 @@ VirtioBlkReadBlocks (
     return Status;
   }
 
-  return SynchronousRequest (
+  return AsynchronousRequest (
            Dev,
            Lba,
            BufferSize,
            Buffer,
-           FALSE       // RequestIsWrite
+           FALSE,      // RequestIsWrite
+           Token
            );
 }
 
 /**
 
-  WriteBlocks() operation for virtio-blk.
+  WriteBlocksEx() operation for virtio-blk.
 
   See
-  - UEFI Spec 2.3.1 + Errata C, 12.8 EFI Block I/O Protocol, 12.8 EFI Block I/O
-    Protocol, EFI_BLOCK_IO_PROTOCOL.WriteBlocks().
+  - UEFI Spec 2.10, 13.10 Block I/O 2 Protocol,
+    EFI_BLOCK_IO2_PROTOCOL.WriteBlocksEx().
   - Driver Writer's Guide for UEFI 2.3.1 v1.01, 24.2.3 WriteBlocks() and
     WriteBlockEx() Implementation.
 
   Parameter checks and conformant return values are implemented in
-  VerifyReadWriteRequest() and SynchronousRequest().
-
-  A zero BufferSize doesn't seem to be prohibited, so do nothing in that case,
-  successfully.
+  VerifyReadWriteRequest() and AsynchronousRequest().
 
 **/
 EFI_STATUS
 EFIAPI
-VirtioBlkWriteBlocks (
-  IN EFI_BLOCK_IO_PROTOCOL  *This,
-  IN UINT32                 MediaId,
-  IN EFI_LBA                Lba,
-  IN UINTN                  BufferSize,
-  IN VOID                   *Buffer
+VirtioBlkWriteBlocksEx (
+  IN     EFI_BLOCK_IO2_PROTOCOL  *This,
+  IN     UINT32                  MediaId,
+  IN     EFI_LBA                 Lba,
+  IN OUT EFI_BLOCK_IO2_TOKEN     *Token,
+  IN     UINTN                   BufferSize,
+  IN     VOID                    *Buffer
   )
 {
   VBLK_DEV    *Dev;
   EFI_STATUS  Status;
 
   if (BufferSize == 0) {
+    if ((Token != NULL) && (Token->Event != NULL)) {
+      Token->TransactionStatus = EFI_SUCCESS;
+      gBS->SignalEvent (Token->Event);
+    }
+
     return EFI_SUCCESS;
   }
 
-  Dev    = VIRTIO_BLK_FROM_BLOCK_IO (This);
+  Dev    = VIRTIO_BLK_FROM_BLOCK_IO2 (This);
   Status = VerifyReadWriteRequest (
              &Dev->BlockIoMedia,
              Lba,
@@ -566,49 +1208,59 @@ VirtioBlkWriteBlocks (
     return Status;
   }
 
-  return SynchronousRequest (
+  return AsynchronousRequest (
            Dev,
            Lba,
            BufferSize,
            Buffer,
-           TRUE        // RequestIsWrite
+           TRUE,       // RequestIsWrite
+           Token
            );
 }
 
 /**
 
-  FlushBlocks() operation for virtio-blk.
+  FlushBlocksEx() operation for virtio-blk.
 
   See
-  - UEFI Spec 2.3.1 + Errata C, 12.8 EFI Block I/O Protocol, 12.8 EFI Block I/O
-    Protocol, EFI_BLOCK_IO_PROTOCOL.FlushBlocks().
+  - UEFI Spec 2.10, 13.10 Block I/O 2 Protocol,
+    EFI_BLOCK_IO2_PROTOCOL.FlushBlocksEx().
   - Driver Writer's Guide for UEFI 2.3.1 v1.01, 24.2.4 FlushBlocks() and
     FlushBlocksEx() Implementation.
 
-  If the underlying virtio-blk device doesn't support flushing (ie.
-  write-caching), then this function should not be called by higher layers,
-  according to EFI_BLOCK_IO_MEDIA characteristics set in VirtioBlkInit().
-  Should they do nonetheless, we do nothing, successfully.
+  The virtio-blk flush request only covers the writes the host has completed,
+  so the function waits until the requests in flight complete before it
+  submits the flush request.
 
 **/
 EFI_STATUS
 EFIAPI
-VirtioBlkFlushBlocks (
-  IN EFI_BLOCK_IO_PROTOCOL  *This
+VirtioBlkFlushBlocksEx (
+  IN     EFI_BLOCK_IO2_PROTOCOL  *This,
+  IN OUT EFI_BLOCK_IO2_TOKEN     *Token
   )
 {
   VBLK_DEV  *Dev;
 
-  Dev = VIRTIO_BLK_FROM_BLOCK_IO (This);
-  return Dev->BlockIoMedia.WriteCaching ?
-         SynchronousRequest (
+  Dev = VIRTIO_BLK_FROM_BLOCK_IO2 (This);
+  if (!Dev->BlockIoMedia.WriteCaching) {
+    if ((Token != NULL) && (Token->Event != NULL)) {
+      Token->TransactionStatus = EFI_SUCCESS;
+      gBS->SignalEvent (Token->Event);
+    }
+
+    return EFI_SUCCESS;
+  }
+
+  VirtioBlkDrain (Dev);
+  return AsynchronousRequest (
            Dev,
            0,      // Lba
            0,      // BufferSize
            NULL,   // Buffer
-           TRUE    // RequestIsWrite
-           ) :
-         EFI_SUCCESS;
+           TRUE,   // RequestIsWrite
+           Token
+           );
 }
 
 /**
@@ -694,6 +1346,191 @@ VirtioBlkDriverBindingSupported (
   return Status;
 }
 
+/**
+
+  Set up a virtqueue of the virtio-blk device, and the request slots that use
+  it.
+
+  This function implements virtio-0.9.5, 2.2.1 Device Initialization Sequence,
+  step 4b and 4c, for one virtqueue.
+
+  @param[in out] Dev         The driver instance being configured.
+                             Dev->IndirectDesc must be set.
+
+  @param[in]     QueueIndex  The index of the virtqueue.
+
+  @param[in]     Queue       The virtqueue to set up.
+
+  @retval EFI_SUCCESS      The virtqueue has been set up.
+
+  @retval EFI_UNSUPPORTED  The host provides a virtqueue that is too small.
+
+  @return                  Error codes from VirtioRingInit(), VirtioRingMap(),
+                           the VirtIo protocol or
+                           VirtioMapAllBytesInSharedBuffer().
+
+**/
+STATIC
+EFI_STATUS
+VirtioBlkQueueInit (
+  IN OUT VBLK_DEV    *Dev,
+  IN     UINT16      QueueIndex,
+  OUT    VBLK_QUEUE  *Queue
+  )
+{
+  EFI_STATUS  Status;
+  UINT16      QueueSize;
+  UINT64      RingBaseShift;
+  UINTN       SharedPages;
+  VOID        *SharedRequests;
+
+  Status = Dev->VirtIo->SetQueueSel (Dev->VirtIo, QueueIndex);
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  Status = Dev->VirtIo->GetQueueNumMax (Dev->VirtIo, &QueueSize);
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  if (QueueSize < VBLK_DESC_PER_REQUEST) {
+    //
+    // A request uses at most three descriptors
+    //
+    return EFI_UNSUPPORTED;
+  }
+
+  Status = VirtioRingInit (Dev->VirtIo, QueueSize, &Queue->Ring);
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  //
+  // If anything fails from here on, we must release the ring resources
+  //
+  Status = VirtioRingMap (
+             Dev->VirtIo,
+             &Queue->Ring,
+             &RingBaseShift,
+             &Queue->RingMap
+             );
+  if (EFI_ERROR (Status)) {
+    goto ReleaseQueue;
+  }
+
+  //
+  // Additional steps for MMIO: align the queue appropriately, and set the
+  // size. If anything fails from here on, we must unmap the ring resources.
+  //
+  Status = Dev->VirtIo->SetQueueNum (Dev->VirtIo, QueueSize);
+  if (EFI_ERROR (Status)) {
+    goto UnmapQueue;
+  }
+
+  Status = Dev->VirtIo->SetQueueAlign (Dev->VirtIo, EFI_PAGE_SIZE);
+  if (EFI_ERROR (Status)) {
+    goto UnmapQueue;
+  }
+
+  //
+  // step 4c -- Report GPFN (guest-physical frame number) of queue.
+  //
+  Status = Dev->VirtIo->SetQueueAddress (
+                          Dev->VirtIo,
+                          &Queue->Ring,
+                          RingBaseShift
+                          );
+  if (EFI_ERROR (Status)) {
+    goto UnmapQueue;
+  }
+
+  //
+  // We poll the used ring; the host should not send interrupts.
+  //
+  *Queue->Ring.Avail.Flags = (UINT16)VRING_AVAIL_F_NO_INTERRUPT;
+
+  //
+  // Without indirect descriptors, every request slot owns
+  // VBLK_DESC_PER_REQUEST descriptors of the ring.
+  //
+  Queue->RequestCount = (UINT16)MIN (
+                                  Dev->IndirectDesc ? QueueSize : QueueSize / VBLK_DESC_PER_REQUEST,
+                                  VBLK_MAX_REQUESTS
+                                  );
+
+  //
+  // The request headers, the host statuses and the indirect descriptor
+  // tables are accessed equally by both processor and the device.
+  //
+  SharedPages = EFI_SIZE_TO_PAGES (Queue->RequestCount * sizeof (VBLK_SHARED_REQUEST));
+  Status      = Dev->VirtIo->AllocateSharedPages (
+                               Dev->VirtIo,
+                               SharedPages,
+                               &SharedRequests
+                               );
+  if (EFI_ERROR (Status)) {
+    goto UnmapQueue;
+  }
+
+  ZeroMem (SharedRequests, EFI_PAGES_TO_SIZE (SharedPages));
+  Status = VirtioMapAllBytesInSharedBuffer (
+             Dev->VirtIo,
+             VirtioOperationBusMasterCommonBuffer,
+             SharedRequests,
+             EFI_PAGES_TO_SIZE (SharedPages),
+             &Queue->SharedRequestsDeviceAddress,
+             &Queue->SharedRequestsMap
+             );
+  if (EFI_ERROR (Status)) {
+    goto FreeSharedRequests;
+  }
+
+  Queue->SharedRequests = SharedRequests;
+  Queue->LastUsedIdx    = 0;
+  Queue->InFlight       = 0;
+  return EFI_SUCCESS;
+
+FreeSharedRequests:
+  Dev->VirtIo->FreeSharedPages (Dev->VirtIo, SharedPages, SharedRequests);
+
+UnmapQueue:
+  Dev->VirtIo->UnmapSharedBuffer (Dev->VirtIo, Queue->RingMap);
+
+ReleaseQueue:
+  VirtioRingUninit (Dev->VirtIo, &Queue->Ring);
+
+  return Status;
+}
+
+/**
+
+  Release the resources of a virtqueue set up with VirtioBlkQueueInit().
+
+  The caller is responsible to stop the host from using the virtqueue first.
+
+  @param[in] Dev    The virtio-blk device.
+
+  @param[in] Queue  The virtqueue to release.
+
+**/
+STATIC
+VOID
+VirtioBlkQueueUninit (
+  IN VBLK_DEV    *Dev,
+  IN VBLK_QUEUE  *Queue
+  )
+{
+  Dev->VirtIo->UnmapSharedBuffer (Dev->VirtIo, Queue->SharedRequestsMap);
+  Dev->VirtIo->FreeSharedPages (
+                 Dev->VirtIo,
+                 EFI_SIZE_TO_PAGES (Queue->RequestCount * sizeof (VBLK_SHARED_REQUEST)),
+                 (VOID *)Queue->SharedRequests
+                 );
+  Dev->VirtIo->UnmapSharedBuffer (Dev->VirtIo, Queue->RingMap);
+  VirtioRingUninit (Dev->VirtIo, &Queue->Ring);
+}
+
 /**
 
   Set up all BlockIo and virtio-blk aspects of this driver for the specified
@@ -729,8 +1566,8 @@ VirtioBlkInit (
   UINT8   PhysicalBlockExp;
   UINT8   AlignmentOffset;
   UINT32  OptIoSize;
-  UINT16  QueueSize;
-  UINT64  RingBaseShift;
+  UINT16  NumQueues;
+  UINT16  QueueIndex;
 
   PhysicalBlockExp = 0;
   AlignmentOffset  = 0;
@@ -829,9 +1666,24 @@ VirtioBlkInit (
     }
   }
 
+  NumQueues = 1;
+  if (Features & VIRTIO_BLK_F_MQ) {
+    Status = VIRTIO_CFG_READ (Dev, NumQueues, &NumQueues);
+    if (EFI_ERROR (Status)) {
+      goto Failed;
+    }
+
+    //
+    // We may drive fewer virtqueues than the device provides.
+    //
+    NumQueues = (UINT16)MIN (MAX (NumQueues, 1), VBLK_MAX_QUEUES);
+  }
+
   Features &= VIRTIO_BLK_F_BLK_SIZE | VIRTIO_BLK_F_TOPOLOGY | VIRTIO_BLK_F_RO |
-              VIRTIO_BLK_F_FLUSH | VIRTIO_F_VERSION_1 |
-              VIRTIO_F_IOMMU_PLATFORM;
+              VIRTIO_BLK_F_FLUSH | VIRTIO_BLK_F_MQ | VIRTIO_F_VERSION_1 |
+              VIRTIO_F_IOMMU_PLATFORM | VIRTIO_F_RING_INDIRECT_DESC;
+
+  Dev->IndirectDesc = (BOOLEAN)((Features & VIRTIO_F_RING_INDIRECT_DESC) != 0);
 
   //
   // In virtio-1.0, feature negotiation is expected to complete before queue
@@ -845,67 +1697,19 @@ VirtioBlkInit (
   }
 
   //
-  // step 4b -- allocate virtqueue
-  //
-  Status = Dev->VirtIo->SetQueueSel (Dev->VirtIo, 0);
-  if (EFI_ERROR (Status)) {
-    goto Failed;
-  }
-
-  Status = Dev->VirtIo->GetQueueNumMax (Dev->VirtIo, &QueueSize);
-  if (EFI_ERROR (Status)) {
-    goto Failed;
-  }
-
-  if (QueueSize < 3) {
-    // SynchronousRequest() uses at most three descriptors
-    Status = EFI_UNSUPPORTED;
-    goto Failed;
-  }
-
-  Status = VirtioRingInit (Dev->VirtIo, QueueSize, &Dev->Ring);
-  if (EFI_ERROR (Status)) {
-    goto Failed;
-  }
-
-  //
-  // If anything fails from here on, we must release the ring resources
-  //
-  Status = VirtioRingMap (
-             Dev->VirtIo,
-             &Dev->Ring,
-             &RingBaseShift,
-             &Dev->RingMap
-             );
-  if (EFI_ERROR (Status)) {
-    goto ReleaseQueue;
-  }
-
-  //
-  // Additional steps for MMIO: align the queue appropriately, and set the
-  // size. If anything fails from here on, we must unmap the ring resources.
+  // step 4b, 4c -- allocate and report the virtqueues. If anything fails from
+  // here on, we must release the virtqueues set up.
   //
-  Status = Dev->VirtIo->SetQueueNum (Dev->VirtIo, QueueSize);
-  if (EFI_ERROR (Status)) {
-    goto UnmapQueue;
-  }
-
-  Status = Dev->VirtIo->SetQueueAlign (Dev->VirtIo, EFI_PAGE_SIZE);
-  if (EFI_ERROR (Status)) {
-    goto UnmapQueue;
+  for (QueueIndex = 0; QueueIndex < NumQueues; QueueIndex++) {
+    Status = VirtioBlkQueueInit (Dev, QueueIndex, &Dev->Queues[QueueIndex]);
+    if (EFI_ERROR (Status)) {
+      goto ReleaseQueues;
+    }
   }
 
-  //
-  // step 4c -- Report GPFN (guest-physical frame number) of queue.
-  //
-  Status = Dev->VirtIo->SetQueueAddress (
-                          Dev->VirtIo,
-                          &Dev->Ring,
-                          RingBaseShift
-                          );
-  if (EFI_ERROR (Status)) {
-    goto UnmapQueue;
-  }
+  Dev->NumQueues   = NumQueues;
+  Dev->NextQueue   = 0;
+  Dev->DeviceError = FALSE;
 
   //
   // step 5 -- Report understood features.
@@ -914,7 +1718,7 @@ VirtioBlkInit (
     Features &= ~(UINT64)(VIRTIO_F_VERSION_1 | VIRTIO_F_IOMMU_PLATFORM);
     Status    = Dev->VirtIo->SetGuestFeatures (Dev->VirtIo, Features);
     if (EFI_ERROR (Status)) {
-      goto UnmapQueue;
+      goto ReleaseQueues;
     }
   }
 
@@ -924,7 +1728,7 @@ VirtioBlkInit (
   NextDevStat |= VSTAT_DRIVER_OK;
   Status       = Dev->VirtIo->SetDeviceStatus (Dev->VirtIo, NextDevStat);
   if (EFI_ERROR (Status)) {
-    goto UnmapQueue;
+    goto ReleaseQueues;
   }
 
   //
@@ -937,6 +1741,11 @@ VirtioBlkInit (
   Dev->BlockIo.ReadBlocks            = &VirtioBlkReadBlocks;
   Dev->BlockIo.WriteBlocks           = &VirtioBlkWriteBlocks;
   Dev->BlockIo.FlushBlocks           = &VirtioBlkFlushBlocks;
+  Dev->BlockIo2.Media                = &Dev->BlockIoMedia;
+  Dev->BlockIo2.Reset                = &VirtioBlkResetEx;
+  Dev->BlockIo2.ReadBlocksEx         = &VirtioBlkReadBlocksEx;
+  Dev->BlockIo2.WriteBlocksEx        = &VirtioBlkWriteBlocksEx;
+  Dev->BlockIo2.FlushBlocksEx        = &VirtioBlkFlushBlocksEx;
   Dev->BlockIoMedia.MediaId          = 0;
   Dev->BlockIoMedia.RemovableMedia   = FALSE;
   Dev->BlockIoMedia.MediaPresent     = TRUE;
@@ -952,10 +1761,12 @@ VirtioBlkInit (
 
   DEBUG ((
     DEBUG_INFO,
-    "%a: LbaSize=0x%x[B] NumBlocks=0x%Lx[Lba]\n",
+    "%a: LbaSize=0x%x[B] NumBlocks=0x%Lx[Lba] Queues=%u Indirect=%d\n",
     __func__,
     Dev->BlockIoMedia.BlockSize,
-    Dev->BlockIoMedia.LastBlock + 1
+    Dev->BlockIoMedia.LastBlock + 1,
+    Dev->NumQueues,
+    Dev->IndirectDesc
     ));
 
   if (Features & VIRTIO_BLK_F_TOPOLOGY) {
@@ -982,11 +1793,11 @@ VirtioBlkInit (
 
   return EFI_SUCCESS;
 
-UnmapQueue:
-  Dev->VirtIo->UnmapSharedBuffer (Dev->VirtIo, Dev->RingMap);
-
-ReleaseQueue:
-  VirtioRingUninit (Dev->VirtIo, &Dev->Ring);
+ReleaseQueues:
+  while (QueueIndex > 0) {
+    QueueIndex--;
+    VirtioBlkQueueUninit (Dev, &Dev->Queues[QueueIndex]);
+  }
 
 Failed:
   //
@@ -1014,6 +1825,8 @@ VirtioBlkUninit (
   IN OUT VBLK_DEV  *Dev
   )
 {
+  UINT16  QueueIndex;
+
   //
   // Reset the virtual device -- see virtio-0.9.5, 2.2.2.1 Device Status. When
   // VIRTIO_CFG_WRITE() returns, the host will have learned to stay away from
@@ -1021,10 +1834,14 @@ VirtioBlkUninit (
   //
   Dev->VirtIo->SetDeviceStatus (Dev->VirtIo, 0);
 
-  Dev->VirtIo->UnmapSharedBuffer (Dev->VirtIo, Dev->RingMap);
-  VirtioRingUninit (Dev->VirtIo, &Dev->Ring);
+  for (QueueIndex = 0; QueueIndex < Dev->NumQueues; QueueIndex++) {
+    VirtioBlkQueueUninit (Dev, &Dev->Queues[QueueIndex]);
+  }
+
+  Dev->NumQueues = 0;
 
   SetMem (&Dev->BlockIo, sizeof Dev->BlockIo, 0x00);
+  SetMem (&Dev->BlockIo2, sizeof Dev->BlockIo2, 0x00);
   SetMem (&Dev->BlockIoMedia, sizeof Dev->BlockIoMedia, 0x00);
 }
 
@@ -1135,21 +1952,46 @@ VirtioBlkDriverBindingStart (
   }
 
   //
-  // Setup complete, attempt to export the driver instance's BlockIo interface.
+  // Complete the Block I/O 2 requests in the background.
+  //
+  Status = gBS->CreateEvent (
+                  EVT_TIMER | EVT_NOTIFY_SIGNAL,
+                  TPL_NOTIFY,
+                  &VirtioBlkAsyncPoll,
+                  Dev,
+                  &Dev->AsyncPoll
+                  );
+  if (EFI_ERROR (Status)) {
+    goto CloseExitBoot;
+  }
+
+  Status = gBS->SetTimer (Dev->AsyncPoll, TimerPeriodic, VBLK_ASYNC_POLL_PERIOD);
+  if (EFI_ERROR (Status)) {
+    goto CloseAsyncPoll;
+  }
+
+  //
+  // Setup complete, attempt to export the driver instance's BlockIo and
+  // BlockIo2 interfaces.
   //
   Dev->Signature = VBLK_SIG;
-  Status         = gBS->InstallProtocolInterface (
+  Status         = gBS->InstallMultipleProtocolInterfaces (
                           &DeviceHandle,
                           &gEfiBlockIoProtocolGuid,
-                          EFI_NATIVE_INTERFACE,
-                          &Dev->BlockIo
+                          &Dev->BlockIo,
+                          &gEfiBlockIo2ProtocolGuid,
+                          &Dev->BlockIo2,
+                          NULL
                           );
   if (EFI_ERROR (Status)) {
-    goto CloseExitBoot;
+    goto CloseAsyncPoll;
   }
 
   return EFI_SUCCESS;
 
+CloseAsyncPoll:
+  gBS->CloseEvent (Dev->AsyncPoll);
+
 CloseExitBoot:
   gBS->CloseEvent (Dev->ExitBoot);
 
@@ -1222,15 +2064,24 @@ VirtioBlkDriverBindingStop (
   //
   // Handle Stop() requests for in-use driver instances gracefully.
   //
-  Status = gBS->UninstallProtocolInterface (
+  Status = gBS->UninstallMultipleProtocolInterfaces (
                   DeviceHandle,
                   &gEfiBlockIoProtocolGuid,
-                  &Dev->BlockIo
+                  &Dev->BlockIo,
+                  &gEfiBlockIo2ProtocolGuid,
+                  &Dev->BlockIo2,
+                  NULL
                   );
   if (EFI_ERROR (Status)) {
     return Status;
   }
 
+  //
+  // Complete the Block I/O 2 requests still in flight before the virtqueues
+  // go away.
+  //
+  VirtioBlkDrain (Dev);
+  gBS->CloseEvent (Dev->AsyncPoll);
   gBS->CloseEvent (Dev->ExitBoot);
 
   VirtioBlkUninit (Dev);
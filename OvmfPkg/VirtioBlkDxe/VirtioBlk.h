@@ -1,7 +1,7 @@
 /** @file
 
-  Internal definitions for the virtio-blk driver, which produces Block I/O
-  Protocol instances for virtio-blk devices.
+  Internal definitions for the virtio-blk driver, which produces Block I/O and
+  Block I/O 2 Protocol instances for virtio-blk devices.
 
   Copyright (C) 2012, Red Hat, Inc.
 
@@ -13,6 +13,7 @@
 #define _VIRTIO_BLK_DXE_H_
 
 #include <Protocol/BlockIo.h>
+#include <Protocol/BlockIo2.h>
 #include <Protocol/ComponentName.h>
 #include <Protocol/DriverBinding.h>
 
@@ -20,6 +21,60 @@
 
 #define VBLK_SIG  SIGNATURE_32 ('V', 'B', 'L', 'K')
 
+//
+// Upper limits on the number of virtqueues driven, and on the number of
+// requests in flight per virtqueue.
+//
+#define VBLK_MAX_QUEUES    4
+#define VBLK_MAX_REQUESTS  32
+
+//
+// Number of descriptors a request takes: header, data buffer, status.
+//
+#define VBLK_DESC_PER_REQUEST  3
+
+//
+// Period of the timer that completes asynchronous requests.
+//
+#define VBLK_ASYNC_POLL_PERIOD  EFI_TIMER_PERIOD_MILLISECONDS (1)
+
+//
+// The parts of a request the host accesses, other than the data buffer. They
+// are allocated and mapped for all requests of a virtqueue at once.
+//
+typedef struct {
+  VRING_DESC        Indirect[VBLK_DESC_PER_REQUEST]; // if VRING_DESC_F_INDIRECT
+  VIRTIO_BLK_REQ    Header;
+  UINT8             HostStatus;
+  UINT8             Reserved[15];                    // keep Indirect aligned
+} VBLK_SHARED_REQUEST;
+
+//
+// Driver side state of a request slot.
+//
+typedef struct {
+  BOOLEAN                InUse;
+  BOOLEAN                Done;           // synchronous requests only
+  BOOLEAN                Abandoned;      // the host could not be notified
+  BOOLEAN                RequestIsWrite;
+  UINTN                  BufferSize;
+  VOID                   *BufferMapping;
+  EFI_BLOCK_IO2_TOKEN    *Token;         // NULL for synchronous requests
+  EFI_STATUS             Status;         // synchronous requests only
+} VBLK_REQUEST;
+
+typedef struct {
+  VRING                             Ring;
+  VOID                              *RingMap;
+  UINT16                            LastUsedIdx;
+  UINT16                            RequestCount;
+  UINT16                            InFlight;
+  volatile VBLK_SHARED_REQUEST      *SharedRequests;
+  EFI_PHYSICAL_ADDRESS              SharedRequestsDeviceAddress;
+  VOID                              *SharedRequestsMap;
+  VBLK_REQUEST                      Requests[VBLK_MAX_REQUESTS];
+} VBLK_QUEUE;
+
 typedef struct {
   //
   // Parts of this structure are initialized / torn down in various functions
@@ -31,15 +86,23 @@ typedef struct {
   UINT32                    Signature;         // DriverBindingStart  0
   VIRTIO_DEVICE_PROTOCOL    *VirtIo;           // DriverBindingStart  0
   EFI_EVENT                 ExitBoot;          // DriverBindingStart  0
-  VRING                     Ring;              // VirtioRingInit      2
+  EFI_EVENT                 AsyncPoll;         // DriverBindingStart  0
+  VBLK_QUEUE                Queues[VBLK_MAX_QUEUES]; // VirtioBlkQueueInit 2
+  UINT16                    NumQueues;         // VirtioBlkInit       1
+  UINT16                    NextQueue;         // VirtioBlkInit       1
+  BOOLEAN                   IndirectDesc;      // VirtioBlkInit       1
+  BOOLEAN                   DeviceError;       // VirtioBlkInit       1
   EFI_BLOCK_IO_PROTOCOL     BlockIo;           // VirtioBlkInit       1
+  EFI_BLOCK_IO2_PROTOCOL    BlockIo2;          // VirtioBlkInit       1
   EFI_BLOCK_IO_MEDIA        BlockIoMedia;      // VirtioBlkInit       1
-  VOID                      *RingMap;          // VirtioRingMap       2
 } VBLK_DEV;
 
 #define VIRTIO_BLK_FROM_BLOCK_IO(BlockIoPointer) \
         CR (BlockIoPointer, VBLK_DEV, BlockIo, VBLK_SIG)
 
+#define VIRTIO_BLK_FROM_BLOCK_IO2(BlockIo2Pointer) \
+        CR (BlockIo2Pointer, VBLK_DEV, BlockIo2, VBLK_SIG)
+
 /**
 
   Device probe function for this driver.
@@ -244,6 +307,84 @@ VirtioBlkFlushBlocks (
   IN EFI_BLOCK_IO_PROTOCOL  *This
   );
 
+//
+// UEFI Spec 2.10, 13.10 Block I/O 2 Protocol
+//
+
+/**
+
+  Reset() operation of EFI_BLOCK_IO2_PROTOCOL for virtio-blk.
+
+  The device is not reset; the function waits until all requests in flight
+  complete.
+
+**/
+
+EFI_STATUS
+EFIAPI
+VirtioBlkResetEx (
+  IN EFI_BLOCK_IO2_PROTOCOL  *This,
+  IN BOOLEAN                 ExtendedVerification
+  );
+
+/**
+
+  ReadBlocksEx() operation for virtio-blk.
+
+  If Token is NULL or Token->Event is NULL, the request is synchronous.
+  Otherwise the function returns once the request is queued, and
+  Token->Event is signaled when it completes.
+
+**/
+
+EFI_STATUS
+EFIAPI
+VirtioBlkReadBlocksEx (
+  IN     EFI_BLOCK_IO2_PROTOCOL  *This,
+  IN     UINT32                  MediaId,
+  IN     EFI_LBA                 Lba,
+  IN OUT EFI_BLOCK_IO2_TOKEN     *Token,
+  IN     UINTN                   BufferSize,
+  OUT    VOID                    *Buffer
+  );
+
+/**
+
+  WriteBlocksEx() operation for virtio-blk.
+
+  If Token is NULL or Token->Event is NULL, the request is synchronous.
+  Otherwise the function returns once the request is queued, and
+  Token->Event is signaled when it completes.
+
+**/
+
+EFI_STATUS
+EFIAPI
+VirtioBlkWriteBlocksEx (
+  IN     EFI_BLOCK_IO2_PROTOCOL  *This,
+  IN     UINT32                  MediaId,
+  IN     EFI_LBA                 Lba,
+  IN OUT EFI_BLOCK_IO2_TOKEN     *Token,
+  IN     UINTN                   BufferSize,
+  IN     VOID                    *Buffer
+  );
+
+/**
+
+  FlushBlocksEx() operation for virtio-blk.
+
+  The flush request is queued after all requests in flight complete, so it
+  covers every write submitted before it.
+
+**/
+
+EFI_STATUS
+EFIAPI
+VirtioBlkFlushBlocksEx (
+  IN     EFI_BLOCK_IO2_PROTOCOL  *This,
+  IN OUT EFI_BLOCK_IO2_TOKEN     *Token
+  );
+
 //
 // The purpose of the following scaffolding (EFI_COMPONENT_NAME_PROTOCOL and
 // EFI_COMPONENT_NAME2_PROTOCOL implementation) is to format the driver's name
@@ -87,6 +87,36 @@ HashAndExtend (
   OUT TPML_DIGEST_VALUES  *DigestList
   );
 
+///
+/// One of the independent data buffers hashed by HashMultiBuffer().
+///
+typedef struct {
+  VOID                  *DataToHash;
+  UINTN                 DataToHashLen;
+  TPML_DIGEST_VALUES    DigestList;
+} HASH_DATA_BUFFER;
+
+/**
+  Hash several independent data buffers, without extending any PCR.
+
+  Every buffer is hashed with the same hash algorithms as HashAndExtend() uses,
+  and its DigestList receives the digests. Hash engines that support it digest
+  all the buffers together, which is faster than hashing them one by one.
+
+  @param Buffers     Buffers to be hashed.
+  @param BufferCount Number of entries in Buffers.
+
+  @retval EFI_SUCCESS          The DigestList of every buffer is returned.
+  @retval EFI_UNSUPPORTED      The buffers cannot be hashed without extending a PCR.
+  @retval EFI_OUT_OF_RESOURCES No enough resource to hash the buffers.
+**/
+EFI_STATUS
+EFIAPI
+HashMultiBuffer (
+  IN OUT HASH_DATA_BUFFER  *Buffers,
+  IN UINTN                 BufferCount
+  );
+
 /**
   Start hash sequence.
 
@@ -133,6 +163,26 @@ EFI_STATUS
   OUT TPML_DIGEST_VALUES *DigestList
   );
 
+/**
+  Hash several independent data buffers.
+
+  @param Buffers     Buffers to be hashed. Their DigestList is not used.
+  @param BufferCount Number of entries in Buffers.
+  @param DigestLists Array of BufferCount digest lists, which receive the digest
+                     of the corresponding buffer.
+
+  @retval EFI_SUCCESS          The digests are returned.
+  @retval EFI_UNSUPPORTED      The buffers cannot be hashed together.
+  @retval EFI_OUT_OF_RESOURCES No enough resource to hash the buffers.
+**/
+typedef
+EFI_STATUS
+(EFIAPI *HASH_ALL_MULTI_BUFFER)(
+  IN CONST HASH_DATA_BUFFER *Buffers,
+  IN UINTN                  BufferCount,
+  OUT TPML_DIGEST_VALUES    *DigestLists
+  );
+
 #define HASH_ALGORITHM_SHA1_GUID    EFI_HASH_ALGORITHM_SHA1_GUID
 #define HASH_ALGORITHM_SHA256_GUID  EFI_HASH_ALGORITHM_SHA256_GUID
 #define HASH_ALGORITHM_SHA384_GUID  EFI_HASH_ALGORITHM_SHA384_GUID
@@ -143,10 +193,15 @@ EFI_STATUS
   }
 
 typedef struct {
-  EFI_GUID       HashGuid;
-  HASH_INIT      HashInit;
-  HASH_UPDATE    HashUpdate;
-  HASH_FINAL     HashFinal;
+  EFI_GUID                 HashGuid;
+  HASH_INIT                HashInit;
+  HASH_UPDATE              HashUpdate;
+  HASH_FINAL               HashFinal;
+  //
+  // Optional. If NULL, HashMultiBuffer() hashes the buffers one by one with
+  // HashInit, HashUpdate and HashFinal.
+  //
+  HASH_ALL_MULTI_BUFFER    HashAllMultiBuffer;
 } HASH_INTERFACE;
 
 /**
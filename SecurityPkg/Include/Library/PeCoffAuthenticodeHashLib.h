@@ -0,0 +1,81 @@
+/** @file
+  Provides the Authenticode hashing of PE/COFF images described in the PE/COFF
+  Specification 8.0 Appendix A.
+
+  The image is walked once and every range covered by the Authenticode hash is
+  passed, in place and in cache sized chunks, to all the hash contexts given by
+  the caller. Several digests of one image therefore cost a single pass over the
+  image data and no intermediate copies.
+
+Copyright (c) 2026, Intel Corporation. All rights reserved.<BR>
+SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#ifndef PE_COFF_AUTHENTICODE_HASH_LIB_H_
+#define PE_COFF_AUTHENTICODE_HASH_LIB_H_
+
+/**
+  Digests the content of a data buffer into a hash context.
+
+  The prototype matches the HashUpdate functions of BaseCryptLib, such as
+  Sha256Update (), so those can be used directly.
+
+  @param[in, out]  HashContext  Pointer to the hash context.
+  @param[in]       Data         Pointer to the buffer containing the data to be hashed.
+  @param[in]       DataSize     Size of Data buffer in bytes.
+
+  @retval TRUE   The data was digested.
+  @retval FALSE  The data could not be digested.
+
+**/
+typedef
+BOOLEAN
+(EFIAPI *PE_COFF_AUTHENTICODE_HASH_UPDATE)(
+  IN OUT VOID        *HashContext,
+  IN     CONST VOID  *Data,
+  IN     UINTN       DataSize
+  );
+
+///
+/// A hash context that takes part in the Authenticode hashing of an image.
+///
+typedef struct {
+  PE_COFF_AUTHENTICODE_HASH_UPDATE    HashUpdate;
+  VOID                                *HashContext;
+} PE_COFF_AUTHENTICODE_HASHER;
+
+/**
+  Digests the Authenticode ranges of a PE/COFF image into one or more hash
+  contexts.
+
+  The hash contexts must be initialized by the caller, and are finalized by the
+  caller once this function returns successfully. Every hash context receives
+  the same data in the same order.
+
+  Caution: This function may receive untrusted input.
+  PE/COFF image is external input, so this function validates every structure
+  it uses against ImageSize before accessing it.
+
+  @param[in]  Image        Pointer to the PE/COFF image.
+  @param[in]  ImageSize    Size of the PE/COFF image in bytes.
+  @param[in]  Hashers      The hash contexts the image is digested into.
+  @param[in]  HasherCount  Number of entries in Hashers.
+
+  @retval RETURN_SUCCESS            The image was digested into all the hash contexts.
+  @retval RETURN_INVALID_PARAMETER  Image or Hashers is NULL, or HasherCount is 0.
+  @retval RETURN_UNSUPPORTED        Image is not a well formed PE/COFF image.
+  @retval RETURN_OUT_OF_RESOURCES   There are not enough resources to sort the section table.
+  @retval RETURN_ABORTED            One of the HashUpdate functions failed.
+
+**/
+RETURN_STATUS
+EFIAPI
+PeCoffAuthenticodeHashImage (
+  IN CONST VOID                         *Image,
+  IN UINTN                              ImageSize,
+  IN CONST PE_COFF_AUTHENTICODE_HASHER  *Hashers,
+  IN UINTN                              HasherCount
+  );
+
+#endif
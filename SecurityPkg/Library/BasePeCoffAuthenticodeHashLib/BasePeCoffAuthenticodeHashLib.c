@@ -0,0 +1,338 @@
+/** @file
+  Authenticode hashing of PE/COFF images based on the PE/COFF Specification 8.0
+  Appendix A, shared by image verification and measured boot.
+
+  Caution: This file requires additional review when modified.
+  This library will have external input - PE/COFF image.
+  This external input must be validated carefully to avoid security issue like
+  buffer overflow, integer overflow.
+
+  PeCoffAuthenticodeHashImage() will accept untrusted PE/COFF image and validate
+  its data structure within this image buffer before use.
+
+Copyright (c) 2026, Intel Corporation. All rights reserved.<BR>
+SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include <Base.h>
+#include <IndustryStandard/PeImage.h>
+#include <Library/BaseLib.h>
+#include <Library/MemoryAllocationLib.h>
+#include <Library/PeCoffAuthenticodeHashLib.h>
+
+//
+// Amount of image data passed to every hash context in turn. The chunk stays
+// in the data cache while all the hash contexts digest it, so the image is
+// fetched from memory only once however many digests are calculated.
+//
+#define AUTHENTICODE_HASH_CHUNK_SIZE  SIZE_16KB
+
+/**
+  Digests a range of the image into every hash context.
+
+  @param[in]  Hashers      The hash contexts the range is digested into.
+  @param[in]  HasherCount  Number of entries in Hashers.
+  @param[in]  Image        Pointer to the PE/COFF image.
+  @param[in]  Offset       Offset of the range in the image.
+  @param[in]  Size         Size of the range in bytes.
+
+  @retval RETURN_SUCCESS  The range was digested into all the hash contexts.
+  @retval RETURN_ABORTED  One of the HashUpdate functions failed.
+
+**/
+STATIC
+RETURN_STATUS
+AuthenticodeHashRange (
+  IN CONST PE_COFF_AUTHENTICODE_HASHER  *Hashers,
+  IN UINTN                              HasherCount,
+  IN CONST UINT8                        *Image,
+  IN UINTN                              Offset,
+  IN UINTN                              Size
+  )
+{
+  UINTN  ChunkSize;
+  UINTN  Index;
+
+  while (Size > 0) {
+    ChunkSize = MIN (Size, AUTHENTICODE_HASH_CHUNK_SIZE);
+    for (Index = 0; Index < HasherCount; Index++) {
+      if (!Hashers[Index].HashUpdate (Hashers[Index].HashContext, Image + Offset, ChunkSize)) {
+        return RETURN_ABORTED;
+      }
+    }
+
+    Offset += ChunkSize;
+    Size   -= ChunkSize;
+  }
+
+  return RETURN_SUCCESS;
+}
+
+/**
+  Digests the Authenticode ranges of a PE/COFF image into one or more hash
+  contexts.
+
+  The hash contexts must be initialized by the caller, and are finalized by the
+  caller once this function returns successfully. Every hash context receives
+  the same data in the same order.
+
+  Caution: This function may receive untrusted input.
+  PE/COFF image is external input, so this function validates every structure
+  it uses against ImageSize before accessing it.
+
+  @param[in]  Image        Pointer to the PE/COFF image.
+  @param[in]  ImageSize    Size of the PE/COFF image in bytes.
+  @param[in]  Hashers      The hash contexts the image is digested into.
+  @param[in]  HasherCount  Number of entries in Hashers.
+
+  @retval RETURN_SUCCESS            The image was digested into all the hash contexts.
+  @retval RETURN_INVALID_PARAMETER  Image or Hashers is NULL, or HasherCount is 0.
+  @retval RETURN_UNSUPPORTED        Image is not a well formed PE/COFF image.
+  @retval RETURN_OUT_OF_RESOURCES   There are not enough resources to sort the section table.
+  @retval RETURN_ABORTED            One of the HashUpdate functions failed.
+
+**/
+RETURN_STATUS
+EFIAPI
+PeCoffAuthenticodeHashImage (
+  IN CONST VOID                         *Image,
+  IN UINTN                              ImageSize,
+  IN CONST PE_COFF_AUTHENTICODE_HASHER  *Hashers,
+  IN UINTN                              HasherCount
+  )
+{
+  RETURN_STATUS                        Status;
+  CONST UINT8                          *ImageBase;
+  CONST EFI_IMAGE_DOS_HEADER           *DosHdr;
+  EFI_IMAGE_OPTIONAL_HEADER_PTR_UNION  Hdr;
+  CONST EFI_IMAGE_SECTION_HEADER       *Section;
+  EFI_IMAGE_DATA_DIRECTORY             *SecDataDir;
+  UINT64                               PeCoffHeaderOffset;
+  UINT64                               OptionalHeaderOffset;
+  UINT64                               SectionTableOffset;
+  UINT64                               SecDataDirOffset;
+  UINTN                                CheckSumOffset;
+  UINT32                               SizeOfHeaders;
+  UINT32                               NumberOfRvaAndSizes;
+  UINT16                               NumberOfSections;
+  UINT16                               *SortedSections;
+  UINTN                                Index;
+  UINTN                                Pos;
+  UINT64                               SumOfBytesHashed;
+  UINT64                               CertSize;
+
+  if ((Image == NULL) || (Hashers == NULL) || (HasherCount == 0)) {
+    return RETURN_INVALID_PARAMETER;
+  }
+
+  ImageBase = (CONST UINT8 *)Image;
+
+  //
+  // Locate and validate the PE/COFF header. Every offset is computed in 64-bit
+  // arithmetic from 32-bit or smaller fields, so none of the sums can overflow.
+  //
+  PeCoffHeaderOffset = 0;
+  DosHdr             = (CONST EFI_IMAGE_DOS_HEADER *)ImageBase;
+  if ((ImageSize >= sizeof (EFI_IMAGE_DOS_HEADER)) && (DosHdr->e_magic == EFI_IMAGE_DOS_SIGNATURE)) {
+    PeCoffHeaderOffset = DosHdr->e_lfanew;
+  }
+
+  OptionalHeaderOffset = PeCoffHeaderOffset + sizeof (UINT32) + sizeof (EFI_IMAGE_FILE_HEADER);
+  if (OptionalHeaderOffset + sizeof (UINT16) > ImageSize) {
+    return RETURN_UNSUPPORTED;
+  }
+
+  Hdr.Pe32 = (EFI_IMAGE_NT_HEADERS32 *)(ImageBase + PeCoffHeaderOffset);
+  if (Hdr.Pe32->Signature != EFI_IMAGE_NT_SIGNATURE) {
+    return RETURN_UNSUPPORTED;
+  }
+
+  SectionTableOffset = OptionalHeaderOffset + Hdr.Pe32->FileHeader.SizeOfOptionalHeader;
+  NumberOfSections   = Hdr.Pe32->FileHeader.NumberOfSections;
+  if (SectionTableOffset + (UINT64)NumberOfSections * sizeof (EFI_IMAGE_SECTION_HEADER) > ImageSize) {
+    return RETURN_UNSUPPORTED;
+  }
+
+  if (Hdr.Pe32->OptionalHeader.Magic == EFI_IMAGE_NT_OPTIONAL_HDR32_MAGIC) {
+    //
+    // Use PE32 offset.
+    //
+    if (Hdr.Pe32->FileHeader.SizeOfOptionalHeader < OFFSET_OF (EFI_IMAGE_OPTIONAL_HEADER32, DataDirectory)) {
+      return RETURN_UNSUPPORTED;
+    }
+
+    CheckSumOffset      = (UINTN)(OptionalHeaderOffset + OFFSET_OF (EFI_IMAGE_OPTIONAL_HEADER32, CheckSum));
+    SecDataDirOffset    = OptionalHeaderOffset + OFFSET_OF (EFI_IMAGE_OPTIONAL_HEADER32, DataDirectory);
+    SizeOfHeaders       = Hdr.Pe32->OptionalHeader.SizeOfHeaders;
+    NumberOfRvaAndSizes = Hdr.Pe32->OptionalHeader.NumberOfRvaAndSizes;
+  } else if (Hdr.Pe32->OptionalHeader.Magic == EFI_IMAGE_NT_OPTIONAL_HDR64_MAGIC) {
+    //
+    // Use PE32+ offset.
+    //
+    if (Hdr.Pe32Plus->FileHeader.SizeOfOptionalHeader < OFFSET_OF (EFI_IMAGE_OPTIONAL_HEADER64, DataDirectory)) {
+      return RETURN_UNSUPPORTED;
+    }
+
+    CheckSumOffset      = (UINTN)(OptionalHeaderOffset + OFFSET_OF (EFI_IMAGE_OPTIONAL_HEADER64, CheckSum));
+    SecDataDirOffset    = OptionalHeaderOffset + OFFSET_OF (EFI_IMAGE_OPTIONAL_HEADER64, DataDirectory);
+    SizeOfHeaders       = Hdr.Pe32Plus->OptionalHeader.SizeOfHeaders;
+    NumberOfRvaAndSizes = Hdr.Pe32Plus->OptionalHeader.NumberOfRvaAndSizes;
+  } else {
+    //
+    // Invalid header magic number.
+    //
+    return RETURN_UNSUPPORTED;
+  }
+
+  SecDataDir = NULL;
+  if (NumberOfRvaAndSizes > EFI_IMAGE_DIRECTORY_ENTRY_SECURITY) {
+    SecDataDirOffset += EFI_IMAGE_DIRECTORY_ENTRY_SECURITY * sizeof (EFI_IMAGE_DATA_DIRECTORY);
+    if (SecDataDirOffset + sizeof (EFI_IMAGE_DATA_DIRECTORY) > SectionTableOffset) {
+      return RETURN_UNSUPPORTED;
+    }
+
+    SecDataDir = (EFI_IMAGE_DATA_DIRECTORY *)(ImageBase + SecDataDirOffset);
+  }
+
+  if ((SizeOfHeaders > ImageSize) ||
+      (CheckSumOffset + sizeof (UINT32) > SizeOfHeaders) ||
+      ((SecDataDir != NULL) && (SecDataDirOffset + sizeof (EFI_IMAGE_DATA_DIRECTORY) > SizeOfHeaders)))
+  {
+    return RETURN_UNSUPPORTED;
+  }
+
+  //
+  // 11. Build a temporary table of the IMAGE_SECTION_HEADER structures in the
+  // 12. image, sorted on 'PointerToRawData'. Only the section numbers are
+  //     sorted; sections with the same file offset keep their table order.
+  //
+  SortedSections = NULL;
+  Section        = (CONST EFI_IMAGE_SECTION_HEADER *)(ImageBase + SectionTableOffset);
+  if (NumberOfSections > 0) {
+    SortedSections = AllocatePool (NumberOfSections * sizeof (UINT16));
+    if (SortedSections == NULL) {
+      return RETURN_OUT_OF_RESOURCES;
+    }
+  }
+
+  SumOfBytesHashed = SizeOfHeaders;
+  for (Index = 0; Index < NumberOfSections; Index++) {
+    if ((Section[Index].SizeOfRawData != 0) &&
+        ((UINT64)Section[Index].PointerToRawData + Section[Index].SizeOfRawData > ImageSize))
+    {
+      Status = RETURN_UNSUPPORTED;
+      goto Done;
+    }
+
+    SumOfBytesHashed += Section[Index].SizeOfRawData;
+
+    Pos = Index;
+    while ((Pos > 0) && (Section[Index].PointerToRawData < Section[SortedSections[Pos - 1]].PointerToRawData)) {
+      SortedSections[Pos] = SortedSections[Pos - 1];
+      Pos--;
+    }
+
+    SortedSections[Pos] = (UINT16)Index;
+  }
+
+  //
+  // 3.  Calculate the distance from the base of the image header to the image checksum address.
+  // 4.  Hash the image header from its base to beginning of the image checksum.
+  // 5.  Skip over the image checksum (it occupies a single ULONG).
+  //
+  Status = AuthenticodeHashRange (Hashers, HasherCount, ImageBase, 0, CheckSumOffset);
+  if (RETURN_ERROR (Status)) {
+    goto Done;
+  }
+
+  if (SecDataDir == NULL) {
+    //
+    // 6.  Since there is no Cert Directory in optional header, hash everything
+    //     from the end of the checksum to the end of image header.
+    //
+    Status = AuthenticodeHashRange (
+               Hashers,
+               HasherCount,
+               ImageBase,
+               CheckSumOffset + sizeof (UINT32),
+               SizeOfHeaders - (CheckSumOffset + sizeof (UINT32))
+               );
+  } else {
+    //
+    // 7.  Hash everything from the end of the checksum to the start of the Cert Directory.
+    // 8.  Skip over the Cert Directory. (It is sizeof(IMAGE_DATA_DIRECTORY) bytes.)
+    // 9.  Hash everything from the end of the Cert Directory to the end of image header.
+    //
+    Status = AuthenticodeHashRange (
+               Hashers,
+               HasherCount,
+               ImageBase,
+               CheckSumOffset + sizeof (UINT32),
+               (UINTN)SecDataDirOffset - (CheckSumOffset + sizeof (UINT32))
+               );
+    if (!RETURN_ERROR (Status)) {
+      Status = AuthenticodeHashRange (
+                 Hashers,
+                 HasherCount,
+                 ImageBase,
+                 (UINTN)SecDataDirOffset + sizeof (EFI_IMAGE_DATA_DIRECTORY),
+                 SizeOfHeaders - ((UINTN)SecDataDirOffset + sizeof (EFI_IMAGE_DATA_DIRECTORY))
+                 );
+    }
+  }
+
+  if (RETURN_ERROR (Status)) {
+    goto Done;
+  }
+
+  //
+  // 13.  Walk through the sorted table and hash the entire section (using the
+  //      'SizeOfRawData' field in the section header to determine the amount
+  //      of data to hash).
+  // 14.  Add the section's 'SizeOfRawData' to SUM_OF_BYTES_HASHED; this was
+  //      done while the table was sorted.
+  // 15.  Repeat steps 13 and 14 for all the sections in the sorted table.
+  //
+  for (Index = 0; Index < NumberOfSections; Index++) {
+    Pos    = SortedSections[Index];
+    Status = AuthenticodeHashRange (
+               Hashers,
+               HasherCount,
+               ImageBase,
+               Section[Pos].PointerToRawData,
+               Section[Pos].SizeOfRawData
+               );
+    if (RETURN_ERROR (Status)) {
+      goto Done;
+    }
+  }
+
+  //
+  // 16.  If the file size is greater than SUM_OF_BYTES_HASHED, there is extra
+  //      data in the file that needs to be added to the hash. This data begins
+  //      at file offset SUM_OF_BYTES_HASHED and its length is:
+  //             FileSize  -  (CertDirectory->Size)
+  //
+  if (ImageSize > SumOfBytesHashed) {
+    CertSize = (SecDataDir == NULL) ? 0 : SecDataDir->Size;
+    if (ImageSize > CertSize + SumOfBytesHashed) {
+      Status = AuthenticodeHashRange (
+                 Hashers,
+                 HasherCount,
+                 ImageBase,
+                 (UINTN)SumOfBytesHashed,
+                 (UINTN)(ImageSize - CertSize - SumOfBytesHashed)
+                 );
+    } else if (ImageSize < CertSize + SumOfBytesHashed) {
+      Status = RETURN_UNSUPPORTED;
+    }
+  }
+
+Done:
+  if (SortedSections != NULL) {
+    FreePool (SortedSections);
+  }
+
+  return Status;
+}
@@ -0,0 +1,541 @@
+/** @file
+  Unit tests of the PE/COFF Authenticode hash library.
+
+  The hash contexts used here record the data they receive, so the tests check
+  the exact byte stream covered by the Authenticode hash rather than a digest.
+
+  Copyright (c) 2026, Intel Corporation. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include <Uefi.h>
+#include <IndustryStandard/PeImage.h>
+#include <Library/BaseLib.h>
+#include <Library/BaseMemoryLib.h>
+#include <Library/DebugLib.h>
+#include <Library/MemoryAllocationLib.h>
+#include <Library/PeCoffAuthenticodeHashLib.h>
+#include <Library/UnitTestLib.h>
+
+#define UNIT_TEST_APP_NAME     "PeCoffAuthenticodeHashLib Unit Tests"
+#define UNIT_TEST_APP_VERSION  "1.0"
+
+//
+// Layout of the test image. The section table lists the sections out of file
+// order, includes an empty section with a bogus file offset, and the image ends
+// with data that is not part of any section followed by the certificate table.
+//
+#define TEST_PE_HEADER_OFFSET   0x80
+#define TEST_SIZE_OF_HEADERS    0x400
+#define TEST_SECTION1_OFFSET    0x400
+#define TEST_SECTION1_SIZE      0x9000
+#define TEST_SECTION0_OFFSET    0x9400
+#define TEST_SECTION0_SIZE      0x300
+#define TEST_TRAILING_SIZE      0x80
+#define TEST_CERT_SIZE          0x80
+#define TEST_IMAGE_SIZE         (TEST_SECTION0_OFFSET + TEST_SECTION0_SIZE + TEST_TRAILING_SIZE + TEST_CERT_SIZE)
+#define TEST_NUMBER_OF_SECTION  3
+#define TEST_HASHER_COUNT       3
+
+typedef struct {
+  UINT8      *Data;
+  UINTN      Size;
+  UINTN      Calls;
+  UINTN      MaxChunk;
+  BOOLEAN    Fail;
+} RECORDING_HASH_CONTEXT;
+
+typedef struct {
+  UINT8    *Image;
+  UINTN    ImageSize;
+  UINT8    *Expected;
+  UINTN    ExpectedSize;
+} TEST_IMAGE;
+
+/**
+  Appends the data to the recording hash context.
+
+  @param[in, out]  HashContext  Pointer to the RECORDING_HASH_CONTEXT.
+  @param[in]       Data         Pointer to the data.
+  @param[in]       DataSize     Size of Data in bytes.
+
+  @retval TRUE   The data was recorded.
+  @retval FALSE  The context was set up to fail.
+
+**/
+STATIC
+BOOLEAN
+EFIAPI
+RecordingHashUpdate (
+  IN OUT VOID        *HashContext,
+  IN     CONST VOID  *Data,
+  IN     UINTN       DataSize
+  )
+{
+  RECORDING_HASH_CONTEXT  *Context;
+
+  Context = (RECORDING_HASH_CONTEXT *)HashContext;
+  if (Context->Fail) {
+    return FALSE;
+  }
+
+  Context->Data = ReallocatePool (Context->Size, Context->Size + DataSize, Context->Data);
+  if (Context->Data == NULL) {
+    return FALSE;
+  }
+
+  CopyMem (Context->Data + Context->Size, Data, DataSize);
+  Context->Size    += DataSize;
+  Context->Calls   += 1;
+  Context->MaxChunk = MAX (Context->MaxChunk, DataSize);
+  return TRUE;
+}
+
+/**
+  Builds a PE32+ test image with a certificate table, and the byte stream its
+  Authenticode hash covers.
+
+  @param[out]  Test  The test image.
+
+**/
+STATIC
+VOID
+BuildPe32PlusImage (
+  OUT TEST_IMAGE  *Test
+  )
+{
+  EFI_IMAGE_DOS_HEADER      *DosHdr;
+  EFI_IMAGE_NT_HEADERS64    *NtHdr;
+  EFI_IMAGE_SECTION_HEADER  *Section;
+  EFI_IMAGE_DATA_DIRECTORY  *SecDataDir;
+  UINTN                     CheckSumOffset;
+  UINTN                     SecDataDirOffset;
+  UINTN                     Index;
+
+  Test->ImageSize = TEST_IMAGE_SIZE;
+  Test->Image     = AllocatePool (Test->ImageSize);
+  Test->Expected  = AllocatePool (Test->ImageSize);
+  ASSERT (Test->Image != NULL && Test->Expected != NULL);
+
+  for (Index = 0; Index < Test->ImageSize; Index++) {
+    Test->Image[Index] = (UINT8)((Index * 7) ^ (Index >> 8));
+  }
+
+  ZeroMem (Test->Image, TEST_SIZE_OF_HEADERS);
+  DosHdr           = (EFI_IMAGE_DOS_HEADER *)Test->Image;
+  DosHdr->e_magic  = EFI_IMAGE_DOS_SIGNATURE;
+  DosHdr->e_lfanew = TEST_PE_HEADER_OFFSET;
+
+  NtHdr                                     = (EFI_IMAGE_NT_HEADERS64 *)(Test->Image + TEST_PE_HEADER_OFFSET);
+  NtHdr->Signature                          = EFI_IMAGE_NT_SIGNATURE;
+  NtHdr->FileHeader.Machine                 = IMAGE_FILE_MACHINE_X64;
+  NtHdr->FileHeader.NumberOfSections        = TEST_NUMBER_OF_SECTION;
+  NtHdr->FileHeader.SizeOfOptionalHeader    = sizeof (EFI_IMAGE_OPTIONAL_HEADER64);
+  NtHdr->OptionalHeader.Magic               = EFI_IMAGE_NT_OPTIONAL_HDR64_MAGIC;
+  NtHdr->OptionalHeader.CheckSum            = 0x12345678;
+  NtHdr->OptionalHeader.SizeOfHeaders       = TEST_SIZE_OF_HEADERS;
+  NtHdr->OptionalHeader.NumberOfRvaAndSizes = EFI_IMAGE_NUMBER_OF_DIRECTORY_ENTRIES;
+
+  SecDataDir                 = &NtHdr->OptionalHeader.DataDirectory[EFI_IMAGE_DIRECTORY_ENTRY_SECURITY];
+  SecDataDir->VirtualAddress = TEST_IMAGE_SIZE - TEST_CERT_SIZE;
+  SecDataDir->Size           = TEST_CERT_SIZE;
+
+  Section                     = (EFI_IMAGE_SECTION_HEADER *)(NtHdr + 1);
+  Section[0].PointerToRawData = TEST_SECTION0_OFFSET;
+  Section[0].SizeOfRawData    = TEST_SECTION0_SIZE;
+  Section[1].PointerToRawData = TEST_SECTION1_OFFSET;
+  Section[1].SizeOfRawData    = TEST_SECTION1_SIZE;
+  Section[2].PointerToRawData = MAX_UINT32;
+  Section[2].SizeOfRawData    = 0;
+
+  //
+  // Everything up to the certificate table, except the checksum and the
+  // certificate table directory entry.
+  //
+  CheckSumOffset     = TEST_PE_HEADER_OFFSET + OFFSET_OF (EFI_IMAGE_NT_HEADERS64, OptionalHeader.CheckSum);
+  SecDataDirOffset   = (UINTN)SecDataDir - (UINTN)Test->Image;
+  Test->ExpectedSize = 0;
+  for (Index = 0; Index < TEST_IMAGE_SIZE - TEST_CERT_SIZE; Index++) {
+    if ((Index >= CheckSumOffset) && (Index < CheckSumOffset + sizeof (UINT32))) {
+      continue;
+    }
+
+    if ((Index >= SecDataDirOffset) && (Index < SecDataDirOffset + sizeof (EFI_IMAGE_DATA_DIRECTORY))) {
+      continue;
+    }
+
+    Test->Expected[Test->ExpectedSize++] = Test->Image[Index];
+  }
+}
+
+/**
+  Builds a PE32 test image without DOS header and without certificate table
+  directory entry, and the byte stream its Authenticode hash covers.
+
+  @param[out]  Test  The test image.
+
+**/
+STATIC
+VOID
+BuildPe32Image (
+  OUT TEST_IMAGE  *Test
+  )
+{
+  EFI_IMAGE_NT_HEADERS32    *NtHdr;
+  EFI_IMAGE_SECTION_HEADER  *Section;
+  UINTN                     CheckSumOffset;
+  UINTN                     Index;
+
+  Test->ImageSize = 0x2000;
+  Test->Image     = AllocatePool (Test->ImageSize);
+  Test->Expected  = AllocatePool (Test->ImageSize);
+  ASSERT (Test->Image != NULL && Test->Expected != NULL);
+
+  for (Index = 0; Index < Test->ImageSize; Index++) {
+    Test->Image[Index] = (UINT8)(Index * 13);
+  }
+
+  ZeroMem (Test->Image, 0x200);
+  NtHdr                                     = (EFI_IMAGE_NT_HEADERS32 *)Test->Image;
+  NtHdr->Signature                          = EFI_IMAGE_NT_SIGNATURE;
+  NtHdr->FileHeader.Machine                 = IMAGE_FILE_MACHINE_I386;
+  NtHdr->FileHeader.NumberOfSections        = 1;
+  NtHdr->FileHeader.SizeOfOptionalHeader    = OFFSET_OF (EFI_IMAGE_OPTIONAL_HEADER32, DataDirectory) + 4 * sizeof (EFI_IMAGE_DATA_DIRECTORY);
+  NtHdr->OptionalHeader.Magic               = EFI_IMAGE_NT_OPTIONAL_HDR32_MAGIC;
+  NtHdr->OptionalHeader.CheckSum            = 0x87654321;
+  NtHdr->OptionalHeader.SizeOfHeaders       = 0x200;
+  NtHdr->OptionalHeader.NumberOfRvaAndSizes = 4;
+
+  Section                   = (EFI_IMAGE_SECTION_HEADER *)((UINT8 *)&NtHdr->OptionalHeader + NtHdr->FileHeader.SizeOfOptionalHeader);
+  Section->PointerToRawData = 0x200;
+  Section->SizeOfRawData    = 0x1000;
+
+  CheckSumOffset     = OFFSET_OF (EFI_IMAGE_NT_HEADERS32, OptionalHeader.CheckSum);
+  Test->ExpectedSize = 0;
+  for (Index = 0; Index < Test->ImageSize; Index++) {
+    if ((Index < CheckSumOffset) || (Index >= CheckSumOffset + sizeof (UINT32))) {
+      Test->Expected[Test->ExpectedSize++] = Test->Image[Index];
+    }
+  }
+}
+
+/**
+  Frees a test image.
+
+  @param[in]  Test  The test image.
+
+**/
+STATIC
+VOID
+FreeTestImage (
+  IN TEST_IMAGE  *Test
+  )
+{
+  FreePool (Test->Image);
+  FreePool (Test->Expected);
+}
+
+/**
+  Hashes a test image with a single recording hash context and checks that
+  the recorded stream matches the expected one.
+
+  @param[in]  Test  The test image.
+
+  @retval UNIT_TEST_PASSED             The recorded stream matches.
+  @retval UNIT_TEST_ERROR_TEST_FAILED  The recorded stream differs.
+
+**/
+STATIC
+UNIT_TEST_STATUS
+CheckImageStream (
+  IN TEST_IMAGE  *Test
+  )
+{
+  RECORDING_HASH_CONTEXT       Context;
+  PE_COFF_AUTHENTICODE_HASHER  Hasher;
+  RETURN_STATUS                Status;
+
+  ZeroMem (&Context, sizeof (Context));
+  Hasher.HashUpdate  = RecordingHashUpdate;
+  Hasher.HashContext = &Context;
+
+  Status = PeCoffAuthenticodeHashImage (Test->Image, Test->ImageSize, &Hasher, 1);
+  UT_ASSERT_NOT_EFI_ERROR (Status);
+  UT_ASSERT_EQUAL (Context.Size, Test->ExpectedSize);
+  UT_ASSERT_MEM_EQUAL (Context.Data, Test->Expected, Test->ExpectedSize);
+
+  FreePool (Context.Data);
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  Checks the stream hashed from a PE32+ image with a certificate table.
+
+  @param[in]  Context  Unused.
+
+  @retval UNIT_TEST_PASSED             The test passed.
+  @retval UNIT_TEST_ERROR_TEST_FAILED  The test failed.
+
+**/
+UNIT_TEST_STATUS
+EFIAPI
+TestPe32PlusImage (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  TEST_IMAGE        Test;
+  UNIT_TEST_STATUS  Result;
+
+  BuildPe32PlusImage (&Test);
+  Result = CheckImageStream (&Test);
+  FreeTestImage (&Test);
+  return Result;
+}
+
+/**
+  Checks the stream hashed from a PE32 image without certificate table.
+
+  @param[in]  Context  Unused.
+
+  @retval UNIT_TEST_PASSED             The test passed.
+  @retval UNIT_TEST_ERROR_TEST_FAILED  The test failed.
+
+**/
+UNIT_TEST_STATUS
+EFIAPI
+TestPe32Image (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  TEST_IMAGE        Test;
+  UNIT_TEST_STATUS  Result;
+
+  BuildPe32Image (&Test);
+  Result = CheckImageStream (&Test);
+  FreeTestImage (&Test);
+  return Result;
+}
+
+/**
+  Checks that several hash contexts receive the same stream, in chunks small
+  enough to stay in the data cache.
+
+  @param[in]  Context  Unused.
+
+  @retval UNIT_TEST_PASSED             The test passed.
+  @retval UNIT_TEST_ERROR_TEST_FAILED  The test failed.
+
+**/
+UNIT_TEST_STATUS
+EFIAPI
+TestMultipleHashers (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  TEST_IMAGE                   Test;
+  RECORDING_HASH_CONTEXT       Contexts[TEST_HASHER_COUNT];
+  PE_COFF_AUTHENTICODE_HASHER  Hashers[TEST_HASHER_COUNT];
+  RETURN_STATUS                Status;
+  UINTN                        Index;
+
+  BuildPe32PlusImage (&Test);
+  ZeroMem (Contexts, sizeof (Contexts));
+  for (Index = 0; Index < TEST_HASHER_COUNT; Index++) {
+    Hashers[Index].HashUpdate  = RecordingHashUpdate;
+    Hashers[Index].HashContext = &Contexts[Index];
+  }
+
+  Status = PeCoffAuthenticodeHashImage (Test.Image, Test.ImageSize, Hashers, TEST_HASHER_COUNT);
+  UT_ASSERT_NOT_EFI_ERROR (Status);
+
+  for (Index = 0; Index < TEST_HASHER_COUNT; Index++) {
+    UT_ASSERT_EQUAL (Contexts[Index].Size, Test.ExpectedSize);
+    UT_ASSERT_MEM_EQUAL (Contexts[Index].Data, Test.Expected, Test.ExpectedSize);
+    UT_ASSERT_EQUAL (Contexts[Index].Calls, Contexts[0].Calls);
+    UT_ASSERT_TRUE (Contexts[Index].MaxChunk <= SIZE_16KB);
+    FreePool (Contexts[Index].Data);
+  }
+
+  //
+  // The largest section is split across several calls.
+  //
+  UT_ASSERT_TRUE (Contexts[0].Calls > TEST_NUMBER_OF_SECTION + 3);
+
+  FreeTestImage (&Test);
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  Checks that malformed images and failing hash contexts are reported.
+
+  @param[in]  Context  Unused.
+
+  @retval UNIT_TEST_PASSED             The test passed.
+  @retval UNIT_TEST_ERROR_TEST_FAILED  The test failed.
+
+**/
+UNIT_TEST_STATUS
+EFIAPI
+TestMalformedImages (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  TEST_IMAGE                   Test;
+  RECORDING_HASH_CONTEXT       HashContext;
+  PE_COFF_AUTHENTICODE_HASHER  Hasher;
+  EFI_IMAGE_NT_HEADERS64       *NtHdr;
+  EFI_IMAGE_SECTION_HEADER     *Section;
+  UINT8                        *Saved;
+
+  BuildPe32PlusImage (&Test);
+  Saved = AllocateCopyPool (TEST_SIZE_OF_HEADERS, Test.Image);
+  UT_ASSERT_NOT_NULL (Saved);
+
+  NtHdr   = (EFI_IMAGE_NT_HEADERS64 *)(Test.Image + TEST_PE_HEADER_OFFSET);
+  Section = (EFI_IMAGE_SECTION_HEADER *)(NtHdr + 1);
+
+  ZeroMem (&HashContext, sizeof (HashContext));
+  Hasher.HashUpdate  = RecordingHashUpdate;
+  Hasher.HashContext = &HashContext;
+
+  UT_ASSERT_STATUS_EQUAL (PeCoffAuthenticodeHashImage (NULL, Test.ImageSize, &Hasher, 1), RETURN_INVALID_PARAMETER);
+  UT_ASSERT_STATUS_EQUAL (PeCoffAuthenticodeHashImage (Test.Image, Test.ImageSize, NULL, 1), RETURN_INVALID_PARAMETER);
+  UT_ASSERT_STATUS_EQUAL (PeCoffAuthenticodeHashImage (Test.Image, Test.ImageSize, &Hasher, 0), RETURN_INVALID_PARAMETER);
+
+  //
+  // Truncated image.
+  //
+  UT_ASSERT_STATUS_EQUAL (PeCoffAuthenticodeHashImage (Test.Image, TEST_PE_HEADER_OFFSET + 8, &Hasher, 1), RETURN_UNSUPPORTED);
+  UT_ASSERT_STATUS_EQUAL (PeCoffAuthenticodeHashImage (Test.Image, TEST_SIZE_OF_HEADERS - 1, &Hasher, 1), RETURN_UNSUPPORTED);
+
+  //
+  // Bad signature and magic.
+  //
+  NtHdr->Signature = 0;
+  UT_ASSERT_STATUS_EQUAL (PeCoffAuthenticodeHashImage (Test.Image, Test.ImageSize, &Hasher, 1), RETURN_UNSUPPORTED);
+  CopyMem (Test.Image, Saved, TEST_SIZE_OF_HEADERS);
+
+  NtHdr->OptionalHeader.Magic = 0x1234;
+  UT_ASSERT_STATUS_EQUAL (PeCoffAuthenticodeHashImage (Test.Image, Test.ImageSize, &Hasher, 1), RETURN_UNSUPPORTED);
+  CopyMem (Test.Image, Saved, TEST_SIZE_OF_HEADERS);
+
+  //
+  // Section table and headers larger than the image.
+  //
+  NtHdr->FileHeader.NumberOfSections = MAX_UINT16;
+  UT_ASSERT_STATUS_EQUAL (PeCoffAuthenticodeHashImage (Test.Image, Test.ImageSize, &Hasher, 1), RETURN_UNSUPPORTED);
+  CopyMem (Test.Image, Saved, TEST_SIZE_OF_HEADERS);
+
+  NtHdr->OptionalHeader.SizeOfHeaders = TEST_IMAGE_SIZE + 1;
+  UT_ASSERT_STATUS_EQUAL (PeCoffAuthenticodeHashImage (Test.Image, Test.ImageSize, &Hasher, 1), RETURN_UNSUPPORTED);
+  CopyMem (Test.Image, Saved, TEST_SIZE_OF_HEADERS);
+
+  NtHdr->OptionalHeader.SizeOfHeaders = OFFSET_OF (EFI_IMAGE_NT_HEADERS64, OptionalHeader.CheckSum);
+  UT_ASSERT_STATUS_EQUAL (PeCoffAuthenticodeHashImage (Test.Image, Test.ImageSize, &Hasher, 1), RETURN_UNSUPPORTED);
+  CopyMem (Test.Image, Saved, TEST_SIZE_OF_HEADERS);
+
+  //
+  // Section data past the end of the image, including 32-bit wrap around.
+  //
+  Section[0].SizeOfRawData = TEST_IMAGE_SIZE;
+  UT_ASSERT_STATUS_EQUAL (PeCoffAuthenticodeHashImage (Test.Image, Test.ImageSize, &Hasher, 1), RETURN_UNSUPPORTED);
+  CopyMem (Test.Image, Saved, TEST_SIZE_OF_HEADERS);
+
+  Section[0].SizeOfRawData = MAX_UINT32 - TEST_SECTION0_OFFSET + 2;
+  UT_ASSERT_STATUS_EQUAL (PeCoffAuthenticodeHashImage (Test.Image, Test.ImageSize, &Hasher, 1), RETURN_UNSUPPORTED);
+  CopyMem (Test.Image, Saved, TEST_SIZE_OF_HEADERS);
+
+  //
+  // Certificate table larger than the data that follows the sections.
+  //
+  NtHdr->OptionalHeader.DataDirectory[EFI_IMAGE_DIRECTORY_ENTRY_SECURITY].Size = TEST_CERT_SIZE + TEST_TRAILING_SIZE + 1;
+  UT_ASSERT_STATUS_EQUAL (PeCoffAuthenticodeHashImage (Test.Image, Test.ImageSize, &Hasher, 1), RETURN_UNSUPPORTED);
+  CopyMem (Test.Image, Saved, TEST_SIZE_OF_HEADERS);
+
+  //
+  // Failing hash context.
+  //
+  HashContext.Fail = TRUE;
+  UT_ASSERT_STATUS_EQUAL (PeCoffAuthenticodeHashImage (Test.Image, Test.ImageSize, &Hasher, 1), RETURN_ABORTED);
+
+  if (HashContext.Data != NULL) {
+    FreePool (HashContext.Data);
+  }
+
+  FreePool (Saved);
+  FreeTestImage (&Test);
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  Initialize the unit test framework, suite, and unit tests for the
+  PE/COFF Authenticode hash library and run the unit tests.
+
+  @retval  EFI_SUCCESS           All test cases were dispatched.
+  @retval  EFI_OUT_OF_RESOURCES  There are not enough resources available to
+                                 initialize the unit tests.
+**/
+STATIC
+EFI_STATUS
+EFIAPI
+UnitTestingEntry (
+  VOID
+  )
+{
+  EFI_STATUS                  Status;
+  UNIT_TEST_FRAMEWORK_HANDLE  Framework;
+  UNIT_TEST_SUITE_HANDLE      AuthenticodeHashTests;
+
+  Framework = NULL;
+
+  DEBUG ((DEBUG_INFO, "%a v%a\n", UNIT_TEST_APP_NAME, UNIT_TEST_APP_VERSION));
+
+  //
+  // Setup the test framework for running the tests.
+  //
+  Status = InitUnitTestFramework (&Framework, UNIT_TEST_APP_NAME, gEfiCallerBaseName, UNIT_TEST_APP_VERSION);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "Failed in InitUnitTestFramework. Status = %r\n", Status));
+    goto EXIT;
+  }
+
+  Status = CreateUnitTestSuite (&AuthenticodeHashTests, Framework, "PeCoffAuthenticodeHashLib Tests", "PeCoffAuthenticodeHashLib", NULL, NULL);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "Failed in CreateUnitTestSuite for PeCoffAuthenticodeHashLib Tests\n"));
+    Status = EFI_OUT_OF_RESOURCES;
+    goto EXIT;
+  }
+
+  //
+  // --------------Suite----------------Description-----------------------Name---------------Function-------------Pre---Post---Context-----------
+  //
+  AddTestCase (AuthenticodeHashTests, "PE32+ image with certificate", "Pe32PlusImage", TestPe32PlusImage, NULL, NULL, NULL);
+  AddTestCase (AuthenticodeHashTests, "PE32 image without certificate", "Pe32Image", TestPe32Image, NULL, NULL, NULL);
+  AddTestCase (AuthenticodeHashTests, "Multiple hash contexts", "MultipleHashers", TestMultipleHashers, NULL, NULL, NULL);
+  AddTestCase (AuthenticodeHashTests, "Malformed images", "MalformedImages", TestMalformedImages, NULL, NULL, NULL);
+
+  //
+  // Execute the tests.
+  //
+  Status = RunAllTestSuites (Framework);
+
+EXIT:
+  if (Framework != NULL) {
+    FreeUnitTestFramework (Framework);
+  }
+
+  return Status;
+}
+
+/**
+  Standard POSIX C entry point for host based unit test execution.
+**/
+int
+main (
+  int   argc,
+  char  *argv[]
+  )
+{
+  return UnitTestingEntry ();
+}
@@ -71,25 +71,6 @@ HASH_TABLE  mHash[] = {
 
 EFI_STRING  mHashTypeStr;
 
-/**
-  SecureBoot Hook for processing image verification.
-
-  @param[in] VariableName                 Name of Variable to be found.
-  @param[in] VendorGuid                   Variable vendor GUID.
-  @param[in] DataSize                     Size of Data found. If size is less than the
-                                          data, this value contains the required size.
-  @param[in] Data                         Data pointer.
-
-**/
-VOID
-EFIAPI
-SecureBootHook (
-  IN CHAR16    *VariableName,
-  IN EFI_GUID  *VendorGuid,
-  IN UINTN     DataSize,
-  IN VOID      *Data
-  );
-
 /**
   Reads contents of a PE/COFF image in memory buffer.
 
@@ -272,53 +253,21 @@ GetImageType (
 }
 
 /**
-  Calculate hash of Pe/Coff image based on the authenticode image hashing in
-  PE/COFF Specification 8.0 Appendix A
-
-  Caution: This function may receive untrusted input.
-  PE/COFF image is external input, so this function will validate its data structure
-  within this image buffer before use.
-
-  Notes: PE/COFF image has been checked by BasePeCoffLib PeCoffLoaderGetImageInfo() in
-  its caller function DxeImageVerificationHandler().
+  Select the hash algorithm of the digest held in mImageDigest, and set
+  mImageDigestSize, mCertType and mHashTypeStr accordingly.
 
   @param[in]    HashAlg   Hash algorithm type.
 
-  @retval TRUE            Successfully hash image.
-  @retval FALSE           Fail in hash image.
+  @retval TRUE            The hash algorithm is supported for image hashing.
+  @retval FALSE           The hash algorithm is not supported for image hashing.
 
 **/
+STATIC
 BOOLEAN
-HashPeImage (
+SelectImageDigestType (
   IN  UINT32  HashAlg
   )
 {
-  BOOLEAN                   Status;
-  EFI_IMAGE_SECTION_HEADER  *Section;
-  VOID                      *HashCtx;
-  UINTN                     CtxSize;
-  UINT8                     *HashBase;
-  UINTN                     HashSize;
-  UINTN                     SumOfBytesHashed;
-  EFI_IMAGE_SECTION_HEADER  *SectionHeader;
-  UINTN                     Index;
-  UINTN                     Pos;
-  UINT32                    CertSize;
-  UINT32                    NumberOfRvaAndSizes;
-
-  HashCtx       = NULL;
-  SectionHeader = NULL;
-  Status        = FALSE;
-
-  if ((HashAlg >= HASHALG_MAX)) {
-    return FALSE;
-  }
-
-  //
-  // Initialize context of hash.
-  //
-  ZeroMem (mImageDigest, MAX_DIGEST_SIZE);
-
   switch (HashAlg) {
  #ifndef DISABLE_SHA1_DEPRECATED_INTERFACES
     case HASHALG_SHA1:
@@ -347,262 +296,137 @@ HashPeImage (
   }
 
   mHashTypeStr = mHash[HashAlg].Name;
-  CtxSize      = mHash[HashAlg].GetContextSize ();
+  return TRUE;
+}
 
-  HashCtx = AllocatePool (CtxSize);
-  if (HashCtx == NULL) {
-    return FALSE;
-  }
+/**
+  Calculate hash of Pe/Coff image based on the authenticode image hashing in
+  PE/COFF Specification 8.0 Appendix A
 
-  // 1.  Load the image header into memory.
+  Caution: This function may receive untrusted input.
+  PE/COFF image is external input, so this function will validate its data structure
+  within this image buffer before use.
 
-  // 2.  Initialize a SHA hash context.
-  Status = mHash[HashAlg].HashInit (HashCtx);
+  Notes: PE/COFF image has been checked by BasePeCoffLib PeCoffLoaderGetImageInfo() in
+  its caller function DxeImageVerificationHandler().
 
-  if (!Status) {
-    goto Done;
-  }
+  @param[in]    HashAlg   Hash algorithm type.
 
-  //
-  // Measuring PE/COFF Image Header;
-  // But CheckSum field and SECURITY data directory (certificate) are excluded
-  //
+  @retval TRUE            Successfully hash image.
+  @retval FALSE           Fail in hash image.
 
-  //
-  // 3.  Calculate the distance from the base of the image header to the image checksum address.
-  // 4.  Hash the image header from its base to beginning of the image checksum.
-  //
-  HashBase = mImageBase;
-  if (mNtHeader.Pe32->OptionalHeader.Magic == EFI_IMAGE_NT_OPTIONAL_HDR32_MAGIC) {
-    //
-    // Use PE32 offset.
-    //
-    HashSize            = (UINTN)(&mNtHeader.Pe32->OptionalHeader.CheckSum) - (UINTN)HashBase;
-    NumberOfRvaAndSizes = mNtHeader.Pe32->OptionalHeader.NumberOfRvaAndSizes;
-  } else if (mNtHeader.Pe32->OptionalHeader.Magic == EFI_IMAGE_NT_OPTIONAL_HDR64_MAGIC) {
-    //
-    // Use PE32+ offset.
-    //
-    HashSize            = (UINTN)(&mNtHeader.Pe32Plus->OptionalHeader.CheckSum) - (UINTN)HashBase;
-    NumberOfRvaAndSizes = mNtHeader.Pe32Plus->OptionalHeader.NumberOfRvaAndSizes;
-  } else {
-    //
-    // Invalid header magic number.
-    //
-    Status = FALSE;
-    goto Done;
-  }
+**/
+BOOLEAN
+HashPeImage (
+  IN  UINT32  HashAlg
+  )
+{
+  BOOLEAN                      Status;
+  VOID                         *HashCtx;
+  PE_COFF_AUTHENTICODE_HASHER  Hasher;
 
-  Status = mHash[HashAlg].HashUpdate (HashCtx, HashBase, HashSize);
-  if (!Status) {
-    goto Done;
+  if ((HashAlg >= HASHALG_MAX)) {
+    return FALSE;
   }
 
   //
-  // 5.  Skip over the image checksum (it occupies a single ULONG).
+  // Initialize context of hash.
   //
-  if (NumberOfRvaAndSizes <= EFI_IMAGE_DIRECTORY_ENTRY_SECURITY) {
-    //
-    // 6.  Since there is no Cert Directory in optional header, hash everything
-    //     from the end of the checksum to the end of image header.
-    //
-    if (mNtHeader.Pe32->OptionalHeader.Magic == EFI_IMAGE_NT_OPTIONAL_HDR32_MAGIC) {
-      //
-      // Use PE32 offset.
-      //
-      HashBase = (UINT8 *)&mNtHeader.Pe32->OptionalHeader.CheckSum + sizeof (UINT32);
-      HashSize = mNtHeader.Pe32->OptionalHeader.SizeOfHeaders - ((UINTN)HashBase - (UINTN)mImageBase);
-    } else {
-      //
-      // Use PE32+ offset.
-      //
-      HashBase = (UINT8 *)&mNtHeader.Pe32Plus->OptionalHeader.CheckSum + sizeof (UINT32);
-      HashSize = mNtHeader.Pe32Plus->OptionalHeader.SizeOfHeaders - ((UINTN)HashBase - (UINTN)mImageBase);
-    }
-
-    if (HashSize != 0) {
-      Status = mHash[HashAlg].HashUpdate (HashCtx, HashBase, HashSize);
-      if (!Status) {
-        goto Done;
-      }
-    }
-  } else {
-    //
-    // 7.  Hash everything from the end of the checksum to the start of the Cert Directory.
-    //
-    if (mNtHeader.Pe32->OptionalHeader.Magic == EFI_IMAGE_NT_OPTIONAL_HDR32_MAGIC) {
-      //
-      // Use PE32 offset.
-      //
-      HashBase = (UINT8 *)&mNtHeader.Pe32->OptionalHeader.CheckSum + sizeof (UINT32);
-      HashSize = (UINTN)(&mNtHeader.Pe32->OptionalHeader.DataDirectory[EFI_IMAGE_DIRECTORY_ENTRY_SECURITY]) - (UINTN)HashBase;
-    } else {
-      //
-      // Use PE32+ offset.
-      //
-      HashBase = (UINT8 *)&mNtHeader.Pe32Plus->OptionalHeader.CheckSum + sizeof (UINT32);
-      HashSize = (UINTN)(&mNtHeader.Pe32Plus->OptionalHeader.DataDirectory[EFI_IMAGE_DIRECTORY_ENTRY_SECURITY]) - (UINTN)HashBase;
-    }
+  ZeroMem (mImageDigest, MAX_DIGEST_SIZE);
 
-    if (HashSize != 0) {
-      Status = mHash[HashAlg].HashUpdate (HashCtx, HashBase, HashSize);
-      if (!Status) {
-        goto Done;
-      }
-    }
+  if (!SelectImageDigestType (HashAlg)) {
+    return FALSE;
+  }
 
-    //
-    // 8.  Skip over the Cert Directory. (It is sizeof(IMAGE_DATA_DIRECTORY) bytes.)
-    // 9.  Hash everything from the end of the Cert Directory to the end of image header.
-    //
-    if (mNtHeader.Pe32->OptionalHeader.Magic == EFI_IMAGE_NT_OPTIONAL_HDR32_MAGIC) {
-      //
-      // Use PE32 offset
-      //
-      HashBase = (UINT8 *)&mNtHeader.Pe32->OptionalHeader.DataDirectory[EFI_IMAGE_DIRECTORY_ENTRY_SECURITY + 1];
-      HashSize = mNtHeader.Pe32->OptionalHeader.SizeOfHeaders - ((UINTN)HashBase - (UINTN)mImageBase);
-    } else {
-      //
-      // Use PE32+ offset.
-      //
-      HashBase = (UINT8 *)&mNtHeader.Pe32Plus->OptionalHeader.DataDirectory[EFI_IMAGE_DIRECTORY_ENTRY_SECURITY + 1];
-      HashSize = mNtHeader.Pe32Plus->OptionalHeader.SizeOfHeaders - ((UINTN)HashBase - (UINTN)mImageBase);
-    }
+  HashCtx = AllocatePool (mHash[HashAlg].GetContextSize ());
+  if (HashCtx == NULL) {
+    return FALSE;
+  }
 
-    if (HashSize != 0) {
-      Status = mHash[HashAlg].HashUpdate (HashCtx, HashBase, HashSize);
-      if (!Status) {
-        goto Done;
-      }
-    }
+  Status = mHash[HashAlg].HashInit (HashCtx);
+  if (Status) {
+    Hasher.HashUpdate  = mHash[HashAlg].HashUpdate;
+    Hasher.HashContext = HashCtx;
+    Status             = !RETURN_ERROR (PeCoffAuthenticodeHashImage (mImageBase, mImageSize, &Hasher, 1));
   }
 
-  //
-  // 10. Set the SUM_OF_BYTES_HASHED to the size of the header.
-  //
-  if (mNtHeader.Pe32->OptionalHeader.Magic == EFI_IMAGE_NT_OPTIONAL_HDR32_MAGIC) {
-    //
-    // Use PE32 offset.
-    //
-    SumOfBytesHashed = mNtHeader.Pe32->OptionalHeader.SizeOfHeaders;
-  } else {
-    //
-    // Use PE32+ offset
-    //
-    SumOfBytesHashed = mNtHeader.Pe32Plus->OptionalHeader.SizeOfHeaders;
+  if (Status) {
+    Status = mHash[HashAlg].HashFinal (HashCtx, mImageDigest);
   }
 
-  Section = (EFI_IMAGE_SECTION_HEADER *)(
-                                         mImageBase +
-                                         mPeCoffHeaderOffset +
-                                         sizeof (UINT32) +
-                                         sizeof (EFI_IMAGE_FILE_HEADER) +
-                                         mNtHeader.Pe32->FileHeader.SizeOfOptionalHeader
-                                         );
+  FreePool (HashCtx);
+  return Status;
+}
 
-  //
-  // 11. Build a temporary table of pointers to all the IMAGE_SECTION_HEADER
-  //     structures in the image. The 'NumberOfSections' field of the image
-  //     header indicates how big the table should be. Do not include any
-  //     IMAGE_SECTION_HEADERs in the table whose 'SizeOfRawData' field is zero.
-  //
-  SectionHeader = (EFI_IMAGE_SECTION_HEADER *)AllocateZeroPool (sizeof (EFI_IMAGE_SECTION_HEADER) * mNtHeader.Pe32->FileHeader.NumberOfSections);
-  if (SectionHeader == NULL) {
-    Status = FALSE;
-    goto Done;
-  }
+/**
+  Calculate the hashes of Pe/Coff image with every hash algorithm supported in
+  mHash, based on the authenticode image hashing in PE/COFF Specification 8.0
+  Appendix A. The image is walked once and every algorithm digests the same
+  data while it is still in the cache.
 
-  //
-  // 12.  Using the 'PointerToRawData' in the referenced section headers as
-  //      a key, arrange the elements in the table in ascending order. In other
-  //      words, sort the section headers according to the disk-file offset of
-  //      the section.
-  //
-  for (Index = 0; Index < mNtHeader.Pe32->FileHeader.NumberOfSections; Index++) {
-    Pos = Index;
-    while ((Pos > 0) && (Section->PointerToRawData < SectionHeader[Pos - 1].PointerToRawData)) {
-      CopyMem (&SectionHeader[Pos], &SectionHeader[Pos - 1], sizeof (EFI_IMAGE_SECTION_HEADER));
-      Pos--;
-    }
+  Caution: This function may receive untrusted input.
+  PE/COFF image is external input, so this function will validate its data structure
+  within this image buffer before use.
 
-    CopyMem (&SectionHeader[Pos], Section, sizeof (EFI_IMAGE_SECTION_HEADER));
-    Section += 1;
-  }
+  @param[out]   ImageDigests  Digest of the image for every hash algorithm type.
+  @param[out]   IsHashed      IsHashed[HashAlg] is TRUE if ImageDigests[HashAlg] holds
+                              the digest of the image.
 
-  //
-  // 13.  Walk through the sorted table, bring the corresponding section
-  //      into memory, and hash the entire section (using the 'SizeOfRawData'
-  //      field in the section header to determine the amount of data to hash).
-  // 14.  Add the section's 'SizeOfRawData' to SUM_OF_BYTES_HASHED .
-  // 15.  Repeat steps 13 and 14 for all the sections in the sorted table.
-  //
-  for (Index = 0; Index < mNtHeader.Pe32->FileHeader.NumberOfSections; Index++) {
-    Section = &SectionHeader[Index];
-    if (Section->SizeOfRawData == 0) {
+**/
+VOID
+HashPeImageAll (
+  OUT UINT8    ImageDigests[HASHALG_MAX][MAX_DIGEST_SIZE],
+  OUT BOOLEAN  IsHashed[HASHALG_MAX]
+  )
+{
+  VOID                         *HashCtx[HASHALG_MAX];
+  PE_COFF_AUTHENTICODE_HASHER  Hashers[HASHALG_MAX];
+  UINTN                        HasherCount;
+  RETURN_STATUS                Status;
+  UINT32                       HashAlg;
+
+  ZeroMem (ImageDigests, HASHALG_MAX * MAX_DIGEST_SIZE);
+  ZeroMem (IsHashed, HASHALG_MAX * sizeof (BOOLEAN));
+
+  HasherCount = 0;
+  for (HashAlg = 0; HashAlg < HASHALG_MAX; HashAlg++) {
+    HashCtx[HashAlg] = NULL;
+    if ((mHash[HashAlg].GetContextSize == NULL) || (mHash[HashAlg].HashInit == NULL) || (mHash[HashAlg].HashUpdate == NULL) || (mHash[HashAlg].HashFinal == NULL)) {
       continue;
     }
 
-    HashBase = mImageBase + Section->PointerToRawData;
-    HashSize = (UINTN)Section->SizeOfRawData;
+    HashCtx[HashAlg] = AllocatePool (mHash[HashAlg].GetContextSize ());
+    if (HashCtx[HashAlg] == NULL) {
+      continue;
+    }
 
-    Status = mHash[HashAlg].HashUpdate (HashCtx, HashBase, HashSize);
-    if (!Status) {
-      goto Done;
+    if (!mHash[HashAlg].HashInit (HashCtx[HashAlg])) {
+      FreePool (HashCtx[HashAlg]);
+      HashCtx[HashAlg] = NULL;
+      continue;
     }
 
-    SumOfBytesHashed += HashSize;
+    Hashers[HasherCount].HashUpdate  = mHash[HashAlg].HashUpdate;
+    Hashers[HasherCount].HashContext = HashCtx[HashAlg];
+    HasherCount++;
   }
 
-  //
-  // 16.  If the file size is greater than SUM_OF_BYTES_HASHED, there is extra
-  //      data in the file that needs to be added to the hash. This data begins
-  //      at file offset SUM_OF_BYTES_HASHED and its length is:
-  //             FileSize  -  (CertDirectory->Size)
-  //
-  if (mImageSize > SumOfBytesHashed) {
-    HashBase = mImageBase + SumOfBytesHashed;
+  Status = RETURN_UNSUPPORTED;
+  if (HasherCount > 0) {
+    Status = PeCoffAuthenticodeHashImage (mImageBase, mImageSize, Hashers, HasherCount);
+  }
 
-    if (NumberOfRvaAndSizes <= EFI_IMAGE_DIRECTORY_ENTRY_SECURITY) {
-      CertSize = 0;
-    } else {
-      if (mNtHeader.Pe32->OptionalHeader.Magic == EFI_IMAGE_NT_OPTIONAL_HDR32_MAGIC) {
-        //
-        // Use PE32 offset.
-        //
-        CertSize = mNtHeader.Pe32->OptionalHeader.DataDirectory[EFI_IMAGE_DIRECTORY_ENTRY_SECURITY].Size;
-      } else {
-        //
-        // Use PE32+ offset.
-        //
-        CertSize = mNtHeader.Pe32Plus->OptionalHeader.DataDirectory[EFI_IMAGE_DIRECTORY_ENTRY_SECURITY].Size;
-      }
+  for (HashAlg = 0; HashAlg < HASHALG_MAX; HashAlg++) {
+    if (HashCtx[HashAlg] == NULL) {
+      continue;
     }
 
-    if (mImageSize > CertSize + SumOfBytesHashed) {
-      HashSize = (UINTN)(mImageSize - CertSize - SumOfBytesHashed);
-
-      Status = mHash[HashAlg].HashUpdate (HashCtx, HashBase, HashSize);
-      if (!Status) {
-        goto Done;
-      }
-    } else if (mImageSize < CertSize + SumOfBytesHashed) {
-      Status = FALSE;
-      goto Done;
+    if (!RETURN_ERROR (Status)) {
+      IsHashed[HashAlg] = mHash[HashAlg].HashFinal (HashCtx[HashAlg], ImageDigests[HashAlg]);
     }
-  }
-
-  Status = mHash[HashAlg].HashFinal (HashCtx, mImageDigest);
-
-Done:
-  if (HashCtx != NULL) {
-    FreePool (HashCtx);
-  }
 
-  if (SectionHeader != NULL) {
-    FreePool (SectionHeader);
+    FreePool (HashCtx[HashAlg]);
   }
-
-  return Status;
 }
 
 /**
@@ -1693,6 +1517,8 @@ DxeImageVerificationHandler (
   BOOLEAN                       IsFound;
   UINT8                         HashAlg;
   BOOLEAN                       IsFoundInDatabase;
+  UINT8                         ImageDigests[HASHALG_MAX][MAX_DIGEST_SIZE];
+  BOOLEAN                       IsHashed[HASHALG_MAX];
 
   SignatureList     = NULL;
   SignatureListSize = 0;
@@ -1776,6 +1602,14 @@ DxeImageVerificationHandler (
     return EFI_ACCESS_DENIED;
   }
 
+  //
+  // Skip the verification of images that passed it before in this boot, if
+  // db, dbx and dbt did not change since.
+  //
+  if (ImageVerificationCacheLookup (FileBuffer, FileSize)) {
+    return EFI_SUCCESS;
+  }
+
   mImageBase = (UINT8 *)FileBuffer;
   mImageSize = FileSize;
 
@@ -1843,17 +1677,18 @@ DxeImageVerificationHandler (
     //
     // This image is not signed. The hash value of the image must match a record in the security database "db",
     // and not be reflected in the security data base "dbx".
+    // Every supported algorithm is calculated in a single pass over the image.
     //
-    HashAlg = sizeof (mHash) / sizeof (HASH_TABLE);
+    HashPeImageAll (ImageDigests, IsHashed);
+
+    HashAlg = HASHALG_MAX;
     while (HashAlg > 0) {
       HashAlg--;
-      if ((mHash[HashAlg].GetContextSize == NULL) || (mHash[HashAlg].HashInit == NULL) || (mHash[HashAlg].HashUpdate == NULL) || (mHash[HashAlg].HashFinal == NULL)) {
+      if (!IsHashed[HashAlg] || !SelectImageDigestType (HashAlg)) {
         continue;
       }
 
-      if (!HashPeImage (HashAlg)) {
-        continue;
-      }
+      CopyMem (mImageDigest, ImageDigests[HashAlg], mImageDigestSize);
 
       DbStatus = IsSignatureFoundInDatabase (
                    EFI_IMAGE_SECURITY_DATABASE1,
@@ -1886,6 +1721,7 @@ DxeImageVerificationHandler (
     }
 
     if (IsFoundInDatabase) {
+      ImageVerificationCacheAdd ();
       return EFI_SUCCESS;
     }
 
@@ -2022,6 +1858,7 @@ DxeImageVerificationHandler (
   }
 
   if (IsVerified) {
+    ImageVerificationCacheAdd ();
     return EFI_SUCCESS;
   }
 
@@ -2070,7 +1907,8 @@ Failed:
 /**
   On Ready To Boot Services Event notification handler.
 
-  Add the image execution information table if it is not in system configuration table.
+  Add the image execution information table if it is not in system configuration table,
+  and report the statistics of the verification cache.
 
   @param[in]  Event     Event whose notification function is being invoked
   @param[in]  Context   Pointer to the notification function's context
@@ -2086,6 +1924,8 @@ OnReadyToBoot (
   EFI_IMAGE_EXECUTION_INFO_TABLE  *ImageExeInfoTable;
   UINTN                           ImageExeInfoTableSize;
 
+  ImageVerificationCacheReport ();
+
   EfiGetSystemConfigurationTable (&gEfiImageSecurityDatabaseGuid, (VOID **)&ImageExeInfoTable);
   if (ImageExeInfoTable != NULL) {
     return;
@@ -23,6 +23,8 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #include <Library/DevicePathLib.h>
 #include <Library/SecurityManagementLib.h>
 #include <Library/PeCoffLib.h>
+#include <Library/PeCoffAuthenticodeHashLib.h>
+#include <Library/TimerLib.h>
 #include <Protocol/FirmwareVolume2.h>
 #include <Protocol/DevicePath.h>
 #include <Protocol/BlockIo.h>
@@ -195,4 +197,76 @@ typedef struct {
   HASH_FINAL               HashFinal;
 } HASH_TABLE;
 
+/**
+  SecureBoot Hook for processing image verification.
+
+  @param[in] VariableName                 Name of Variable to be found.
+  @param[in] VendorGuid                   Variable vendor GUID.
+  @param[in] DataSize                     Size of Data found. If size is less than the
+                                          data, this value contains the required size.
+  @param[in] Data                         Data pointer.
+
+**/
+VOID
+EFIAPI
+SecureBootHook (
+  IN CHAR16    *VariableName,
+  IN EFI_GUID  *VendorGuid,
+  IN UINTN     DataSize,
+  IN VOID      *Data
+  );
+
+/**
+  Looks up an image in the verification cache.
+
+  Must be called once per verification, before the image is verified. On a
+  miss, the key of the image is kept for ImageVerificationCacheAdd ().
+
+  @param[in]  FileBuffer  The file data of the image.
+  @param[in]  FileSize    The size of FileBuffer.
+
+  @retval TRUE   The image passed verification before and the databases did
+                 not change since. The db entries that authorized it were
+                 measured again.
+  @retval FALSE  The image must be verified.
+
+**/
+BOOLEAN
+ImageVerificationCacheLookup (
+  IN VOID   *FileBuffer,
+  IN UINTN  FileSize
+  );
+
+/**
+  Records a db entry measured while the current image is verified.
+
+  @param[in]  DataSize  The size of Data.
+  @param[in]  Data      The EFI_SIGNATURE_DATA entry of db.
+
+**/
+VOID
+ImageVerificationCacheAddAuthority (
+  IN UINTN  DataSize,
+  IN VOID   *Data
+  );
+
+/**
+  Adds the image looked up last to the cache. Must only be called once the
+  image passed verification.
+
+**/
+VOID
+ImageVerificationCacheAdd (
+  VOID
+  );
+
+/**
+  Reports the statistics of the verification cache.
+
+**/
+VOID
+ImageVerificationCacheReport (
+  VOID
+  );
+
 #endif
@@ -0,0 +1,376 @@
+/** @file
+  Cache of the images that passed verification during this boot.
+
+  Verifying a signed image runs the PKCS#7 verification of its Authenticode
+  signature against every certificate in db and dbx, which dominates the cost
+  of LoadImage () for option ROMs and applications loaded repeatedly. Once an
+  image passed, its SHA-256 digest is cached together with a digest of the
+  db, dbx and dbt contents it was verified against; loading byte-identical
+  file data while the databases are unchanged then succeeds without repeating
+  the verification.
+
+  Only successful verifications are cached, and the cache lives in boot
+  services memory for the current boot only. Any change to db, dbx or dbt
+  changes the database digest and so invalidates every entry.
+
+  The db entries measured into PCR 7 while an image is verified are kept with
+  its cache entry and measured again on every hit, so that the TCG event log
+  is the same as if the image had been verified.
+
+  Caution: This file requires additional review when modified.
+  This library will have external input - PE/COFF image.
+  The image is only hashed here, its content is not parsed.
+
+  Copyright (c) 2026, Intel Corporation. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include "DxeImageVerificationLib.h"
+
+#define IMAGE_VERIFICATION_CACHE_ENTRY_SIGNATURE  SIGNATURE_32 ('I', 'V', 'C', 'E')
+
+typedef struct {
+  UINT32        Signature;
+  LIST_ENTRY    Link;
+  UINT8         ImageDigest[SHA256_DIGEST_SIZE];
+  UINT8         DatabaseDigest[SHA256_DIGEST_SIZE];
+  //
+  // Time the verification took, in nanoseconds.
+  //
+  UINT64        VerificationTime;
+  //
+  // EFI_SIGNATURE_DATA entries of db measured during the verification, each
+  // preceded by its size as a UINT32.
+  //
+  UINTN         AuthoritySize;
+  UINT8         Authority[1];
+} IMAGE_VERIFICATION_CACHE_ENTRY;
+
+#define IMAGE_VERIFICATION_CACHE_ENTRY_FROM_LINK(a) \
+  CR (a, IMAGE_VERIFICATION_CACHE_ENTRY, Link, IMAGE_VERIFICATION_CACHE_ENTRY_SIGNATURE)
+
+//
+// Cache entries, most recently used first.
+//
+STATIC LIST_ENTRY  mImageVerificationCache = INITIALIZE_LIST_HEAD_VARIABLE (mImageVerificationCache);
+STATIC UINTN       mImageVerificationCacheCount;
+
+//
+// Key of the image being verified, valid if mCacheKeyValid is TRUE.
+//
+STATIC BOOLEAN  mCacheKeyValid;
+STATIC UINT8    mCacheImageDigest[SHA256_DIGEST_SIZE];
+STATIC UINT8    mCacheDatabaseDigest[SHA256_DIGEST_SIZE];
+STATIC UINT64   mCacheLookupStart;
+
+//
+// db entries measured since the last lookup.
+//
+STATIC UINT8  *mPendingAuthority;
+STATIC UINTN  mPendingAuthoritySize;
+STATIC UINTN  mPendingAuthorityMaxSize;
+
+STATIC VOID  *mDatabaseHashContext;
+
+//
+// Statistics, reported at ReadyToBoot.
+//
+STATIC UINTN   mCacheHits;
+STATIC UINTN   mCacheMisses;
+STATIC UINT64  mCacheTimeSaved;
+
+STATIC CHAR16  *mCachedDatabase[] = {
+  EFI_IMAGE_SECURITY_DATABASE,
+  EFI_IMAGE_SECURITY_DATABASE1,
+  EFI_IMAGE_SECURITY_DATABASE2
+};
+
+/**
+  Returns the time elapsed since a performance counter value was read.
+
+  @param[in]  Start  The earlier performance counter value.
+
+  @return The elapsed time in nanoseconds.
+
+**/
+STATIC
+UINT64
+ImageVerificationCacheElapsed (
+  IN UINT64  Start
+  )
+{
+  UINT64  End;
+  UINT64  StartValue;
+  UINT64  EndValue;
+
+  End = GetPerformanceCounter ();
+  GetPerformanceCounterProperties (&StartValue, &EndValue);
+  if (StartValue > EndValue) {
+    return GetTimeInNanoSecond (Start - End);
+  }
+
+  return GetTimeInNanoSecond (End - Start);
+}
+
+/**
+  Computes the SHA-256 digest of the content of db, dbx and dbt.
+
+  @param[out]  Digest  Receives the digest.
+
+  @retval TRUE   The digest was computed.
+  @retval FALSE  A database could not be read.
+
+**/
+STATIC
+BOOLEAN
+ImageVerificationCacheHashDatabases (
+  OUT UINT8  *Digest
+  )
+{
+  EFI_STATUS  Status;
+  UINTN       Index;
+  UINTN       DataSize;
+  UINT64      Size;
+  UINT8       *Data;
+  BOOLEAN     Result;
+
+  if (mDatabaseHashContext == NULL) {
+    mDatabaseHashContext = AllocatePool (Sha256GetContextSize ());
+    if (mDatabaseHashContext == NULL) {
+      return FALSE;
+    }
+  }
+
+  if (!Sha256Init (mDatabaseHashContext)) {
+    return FALSE;
+  }
+
+  for (Index = 0; Index < ARRAY_SIZE (mCachedDatabase); Index++) {
+    DataSize = 0;
+    Status   = gRT->GetVariable (mCachedDatabase[Index], &gEfiImageSecurityDatabaseGuid, NULL, &DataSize, NULL);
+    if (Status == EFI_NOT_FOUND) {
+      //
+      // Tell a missing database from an empty one.
+      //
+      Size = MAX_UINT64;
+      if (!Sha256Update (mDatabaseHashContext, &Size, sizeof (Size))) {
+        return FALSE;
+      }
+
+      continue;
+    }
+
+    if (Status != EFI_BUFFER_TOO_SMALL) {
+      return FALSE;
+    }
+
+    Data = AllocatePool (DataSize);
+    if (Data == NULL) {
+      return FALSE;
+    }
+
+    Status = gRT->GetVariable (mCachedDatabase[Index], &gEfiImageSecurityDatabaseGuid, NULL, &DataSize, Data);
+    Size   = DataSize;
+    Result = !EFI_ERROR (Status) &&
+             Sha256Update (mDatabaseHashContext, &Size, sizeof (Size)) &&
+             Sha256Update (mDatabaseHashContext, Data, DataSize);
+    FreePool (Data);
+    if (!Result) {
+      return FALSE;
+    }
+  }
+
+  return Sha256Final (mDatabaseHashContext, Digest);
+}
+
+/**
+  Looks up an image in the verification cache.
+
+  Must be called once per verification, before the image is verified. On a
+  miss, the key of the image is kept for ImageVerificationCacheAdd ().
+
+  @param[in]  FileBuffer  The file data of the image.
+  @param[in]  FileSize    The size of FileBuffer.
+
+  @retval TRUE   The image passed verification before and the databases did
+                 not change since. The db entries that authorized it were
+                 measured again.
+  @retval FALSE  The image must be verified.
+
+**/
+BOOLEAN
+ImageVerificationCacheLookup (
+  IN VOID   *FileBuffer,
+  IN UINTN  FileSize
+  )
+{
+  LIST_ENTRY                      *Link;
+  IMAGE_VERIFICATION_CACHE_ENTRY  *Entry;
+  UINTN                           Offset;
+  UINT32                          Size;
+  UINT64                          HitTime;
+
+  mCacheKeyValid        = FALSE;
+  mPendingAuthoritySize = 0;
+
+  if (PcdGet32 (PcdImageVerificationCacheEntries) == 0) {
+    return FALSE;
+  }
+
+  mCacheLookupStart = GetPerformanceCounter ();
+  if (!Sha256HashAll (FileBuffer, FileSize, mCacheImageDigest) ||
+      !ImageVerificationCacheHashDatabases (mCacheDatabaseDigest))
+  {
+    return FALSE;
+  }
+
+  mCacheKeyValid = TRUE;
+
+  for (Link = GetFirstNode (&mImageVerificationCache);
+       !IsNull (&mImageVerificationCache, Link);
+       Link = GetNextNode (&mImageVerificationCache, Link))
+  {
+    Entry = IMAGE_VERIFICATION_CACHE_ENTRY_FROM_LINK (Link);
+    if ((CompareMem (Entry->ImageDigest, mCacheImageDigest, SHA256_DIGEST_SIZE) != 0) ||
+        (CompareMem (Entry->DatabaseDigest, mCacheDatabaseDigest, SHA256_DIGEST_SIZE) != 0))
+    {
+      continue;
+    }
+
+    mCacheKeyValid = FALSE;
+    Offset         = 0;
+    while (Offset < Entry->AuthoritySize) {
+      Size = ReadUnaligned32 ((UINT32 *)&Entry->Authority[Offset]);
+      SecureBootHook (
+        EFI_IMAGE_SECURITY_DATABASE,
+        &gEfiImageSecurityDatabaseGuid,
+        Size,
+        &Entry->Authority[Offset + sizeof (UINT32)]
+        );
+      Offset += sizeof (UINT32) + Size;
+    }
+
+    RemoveEntryList (&Entry->Link);
+    InsertHeadList (&mImageVerificationCache, &Entry->Link);
+
+    HitTime = ImageVerificationCacheElapsed (mCacheLookupStart);
+    if (Entry->VerificationTime > HitTime) {
+      mCacheTimeSaved += Entry->VerificationTime - HitTime;
+    }
+
+    mCacheHits++;
+    return TRUE;
+  }
+
+  mCacheMisses++;
+  return FALSE;
+}
+
+/**
+  Records a db entry measured while the current image is verified.
+
+  @param[in]  DataSize  The size of Data.
+  @param[in]  Data      The EFI_SIGNATURE_DATA entry of db.
+
+**/
+VOID
+ImageVerificationCacheAddAuthority (
+  IN UINTN  DataSize,
+  IN VOID   *Data
+  )
+{
+  UINTN  NewSize;
+  UINT8  *NewAuthority;
+
+  if (!mCacheKeyValid) {
+    return;
+  }
+
+  NewSize = mPendingAuthoritySize + sizeof (UINT32) + DataSize;
+  if (NewSize > mPendingAuthorityMaxSize) {
+    NewAuthority = ReallocatePool (mPendingAuthoritySize, NewSize, mPendingAuthority);
+    if (NewAuthority == NULL) {
+      //
+      // The entry could not be measured again on a hit. Do not cache.
+      //
+      mCacheKeyValid = FALSE;
+      return;
+    }
+
+    mPendingAuthority        = NewAuthority;
+    mPendingAuthorityMaxSize = NewSize;
+  }
+
+  WriteUnaligned32 ((UINT32 *)&mPendingAuthority[mPendingAuthoritySize], (UINT32)DataSize);
+  CopyMem (&mPendingAuthority[mPendingAuthoritySize + sizeof (UINT32)], Data, DataSize);
+  mPendingAuthoritySize = NewSize;
+}
+
+/**
+  Adds the image looked up last to the cache. Must only be called once the
+  image passed verification.
+
+**/
+VOID
+ImageVerificationCacheAdd (
+  VOID
+  )
+{
+  IMAGE_VERIFICATION_CACHE_ENTRY  *Entry;
+  LIST_ENTRY                      *Link;
+
+  if (!mCacheKeyValid) {
+    return;
+  }
+
+  mCacheKeyValid = FALSE;
+
+  Entry = AllocatePool (OFFSET_OF (IMAGE_VERIFICATION_CACHE_ENTRY, Authority) + mPendingAuthoritySize);
+  if (Entry == NULL) {
+    return;
+  }
+
+  Entry->Signature = IMAGE_VERIFICATION_CACHE_ENTRY_SIGNATURE;
+  CopyMem (Entry->ImageDigest, mCacheImageDigest, SHA256_DIGEST_SIZE);
+  CopyMem (Entry->DatabaseDigest, mCacheDatabaseDigest, SHA256_DIGEST_SIZE);
+  Entry->VerificationTime = ImageVerificationCacheElapsed (mCacheLookupStart);
+  Entry->AuthoritySize    = mPendingAuthoritySize;
+  CopyMem (Entry->Authority, mPendingAuthority, mPendingAuthoritySize);
+
+  if (mImageVerificationCacheCount >= PcdGet32 (PcdImageVerificationCacheEntries)) {
+    //
+    // Evict the least recently used entry.
+    //
+    Link = GetPreviousNode (&mImageVerificationCache, &mImageVerificationCache);
+    RemoveEntryList (Link);
+    FreePool (IMAGE_VERIFICATION_CACHE_ENTRY_FROM_LINK (Link));
+    mImageVerificationCacheCount--;
+  }
+
+  InsertHeadList (&mImageVerificationCache, &Entry->Link);
+  mImageVerificationCacheCount++;
+}
+
+/**
+  Reports the statistics of the verification cache.
+
+**/
+VOID
+ImageVerificationCacheReport (
+  VOID
+  )
+{
+  if (PcdGet32 (PcdImageVerificationCacheEntries) == 0) {
+    return;
+  }
+
+  DEBUG ((
+    DEBUG_INFO,
+    "DxeImageVerificationLib: Verification cache - %lu hits, %lu misses, %lu entries, %lu us saved\n",
+    (UINT64)mCacheHits,
+    (UINT64)mCacheMisses,
+    (UINT64)mImageVerificationCacheCount,
+    DivU64x32 (mCacheTimeSaved, 1000)
+    ));
+}
@@ -18,6 +18,8 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #include <Library/BaseLib.h>
 #include <Library/TpmMeasurementLib.h>
 
+#include "DxeImageVerificationLib.h"
+
 typedef struct {
   CHAR16      *VariableName;
   EFI_GUID    *VendorGuid;
@@ -300,6 +302,8 @@ SecureBootHook (
     return;
   }
 
+  ImageVerificationCacheAddAuthority (DataSize, Data);
+
   if (IsDataMeasured (VariableName, VendorGuid, Data, DataSize)) {
     DEBUG ((DEBUG_ERROR, "MeasureSecureAuthorityVariable - IsDataMeasured\n"));
     return;
@@ -118,11 +118,67 @@ Sha256HashFinal (
   return EFI_SUCCESS;
 }
 
+/**
+  Hash several independent data buffers.
+
+  @param Buffers     Buffers to be hashed. Their DigestList is not used.
+  @param BufferCount Number of entries in Buffers.
+  @param DigestLists Array of BufferCount digest lists, which receive the digest
+                     of the corresponding buffer.
+
+  @retval EFI_SUCCESS          The digests are returned.
+  @retval EFI_UNSUPPORTED      The buffers cannot be hashed together.
+  @retval EFI_OUT_OF_RESOURCES No enough resource to hash the buffers.
+**/
+EFI_STATUS
+EFIAPI
+Sha256HashMultiBuffer (
+  IN CONST HASH_DATA_BUFFER  *Buffers,
+  IN UINTN                   BufferCount,
+  OUT TPML_DIGEST_VALUES     *DigestLists
+  )
+{
+  HASH_MULTI_BUFFER  *CryptBuffers;
+  UINTN              Index;
+  BOOLEAN            Result;
+
+  if (BufferCount == 0) {
+    return EFI_SUCCESS;
+  }
+
+  CryptBuffers = AllocatePool (sizeof (*CryptBuffers) * BufferCount);
+  if (CryptBuffers == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  //
+  // The digests are written in place into the digest lists.
+  //
+  for (Index = 0; Index < BufferCount; Index++) {
+    DigestLists[Index].count              = 1;
+    DigestLists[Index].digests[0].hashAlg = TPM_ALG_SHA256;
+    CryptBuffers[Index].Data              = Buffers[Index].DataToHash;
+    CryptBuffers[Index].DataSize          = Buffers[Index].DataToHashLen;
+    CryptBuffers[Index].HashValue         = DigestLists[Index].digests[0].digest.sha256;
+  }
+
+  Result = Sha256HashAllMultiBuffer (CryptBuffers, BufferCount);
+
+  FreePool (CryptBuffers);
+
+  if (!Result) {
+    return EFI_UNSUPPORTED;
+  }
+
+  return EFI_SUCCESS;
+}
+
 HASH_INTERFACE  mSha256InternalHashInstance = {
   HASH_ALGORITHM_SHA256_GUID,
   Sha256HashInit,
   Sha256HashUpdate,
   Sha256HashFinal,
+  Sha256HashMultiBuffer,
 };
 
 /**
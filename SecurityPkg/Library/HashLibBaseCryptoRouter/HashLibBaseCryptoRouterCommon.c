@@ -72,3 +72,57 @@ Tpm2SetHashToDigestList (
     );
   DigestList->count++;
 }
+
+/**
+  Hash several independent data buffers with one registered hash engine.
+
+  The hash engine digests all the buffers together if it supports it, otherwise
+  they are hashed one by one.
+
+  @param HashInterface  Hash interface of the hash engine.
+  @param Buffers        Buffers to be hashed.
+  @param BufferCount    Number of entries in Buffers.
+  @param DigestLists    Array of BufferCount digest lists, which receive the digest
+                        of the corresponding buffer.
+
+  @retval EFI_SUCCESS          The digests are returned.
+  @retval EFI_OUT_OF_RESOURCES No enough resource to hash the buffers.
+**/
+EFI_STATUS
+EFIAPI
+HashInterfaceMultiBuffer (
+  IN HASH_INTERFACE          *HashInterface,
+  IN CONST HASH_DATA_BUFFER  *Buffers,
+  IN UINTN                   BufferCount,
+  OUT TPML_DIGEST_VALUES     *DigestLists
+  )
+{
+  HASH_HANDLE  HashCtx;
+  UINTN        Index;
+  EFI_STATUS   Status;
+
+  if (HashInterface->HashAllMultiBuffer != NULL) {
+    Status = HashInterface->HashAllMultiBuffer (Buffers, BufferCount, DigestLists);
+    if (!EFI_ERROR (Status)) {
+      return EFI_SUCCESS;
+    }
+
+    //
+    // The engine may not be able to hash the buffers together, for example if
+    // the crypto service it relies on is not available. Hash them one by one.
+    //
+    DEBUG ((DEBUG_INFO, "Multi-buffer hash (%g) - %r, hash buffers one by one\n", &HashInterface->HashGuid, Status));
+  }
+
+  for (Index = 0; Index < BufferCount; Index++) {
+    Status = HashInterface->HashInit (&HashCtx);
+    if (EFI_ERROR (Status)) {
+      return Status;
+    }
+
+    HashInterface->HashUpdate (HashCtx, Buffers[Index].DataToHash, Buffers[Index].DataToHashLen);
+    HashInterface->HashFinal (HashCtx, &DigestLists[Index]);
+  }
+
+  return EFI_SUCCESS;
+}
@@ -35,4 +35,28 @@ Tpm2SetHashToDigestList (
   IN TPML_DIGEST_VALUES      *Digest
   );
 
+/**
+  Hash several independent data buffers with one registered hash engine.
+
+  The hash engine digests all the buffers together if it supports it, otherwise
+  they are hashed one by one.
+
+  @param HashInterface  Hash interface of the hash engine.
+  @param Buffers        Buffers to be hashed.
+  @param BufferCount    Number of entries in Buffers.
+  @param DigestLists    Array of BufferCount digest lists, which receive the digest
+                        of the corresponding buffer.
+
+  @retval EFI_SUCCESS          The digests are returned.
+  @retval EFI_OUT_OF_RESOURCES No enough resource to hash the buffers.
+**/
+EFI_STATUS
+EFIAPI
+HashInterfaceMultiBuffer (
+  IN HASH_INTERFACE          *HashInterface,
+  IN CONST HASH_DATA_BUFFER  *Buffers,
+  IN UINTN                   BufferCount,
+  OUT TPML_DIGEST_VALUES     *DigestLists
+  );
+
 #endif
@@ -312,6 +312,78 @@ HashAndExtend (
   return Status;
 }
 
+/**
+  Hash several independent data buffers, without extending any PCR.
+
+  Every buffer is hashed with the same hash algorithms as HashAndExtend() uses,
+  and its DigestList receives the digests. Hash engines that support it digest
+  all the buffers together, which is faster than hashing them one by one.
+
+  @param Buffers     Buffers to be hashed.
+  @param BufferCount Number of entries in Buffers.
+
+  @retval EFI_SUCCESS          The DigestList of every buffer is returned.
+  @retval EFI_UNSUPPORTED      The buffers cannot be hashed without extending a PCR.
+  @retval EFI_OUT_OF_RESOURCES No enough resource to hash the buffers.
+**/
+EFI_STATUS
+EFIAPI
+HashMultiBuffer (
+  IN OUT HASH_DATA_BUFFER  *Buffers,
+  IN UINTN                 BufferCount
+  )
+{
+  HASH_INTERFACE_HOB  *HashInterfaceHob;
+  TPML_DIGEST_VALUES  *Digests;
+  UINTN               Index;
+  UINTN               BufferIndex;
+  EFI_STATUS          Status;
+  UINT32              HashMask;
+
+  HashInterfaceHob = InternalGetHashInterfaceHob (&gEfiCallerIdGuid);
+  if (HashInterfaceHob == NULL) {
+    return EFI_UNSUPPORTED;
+  }
+
+  if (HashInterfaceHob->HashInterfaceCount == 0) {
+    return EFI_UNSUPPORTED;
+  }
+
+  CheckSupportedHashMaskMismatch (HashInterfaceHob);
+
+  for (BufferIndex = 0; BufferIndex < BufferCount; BufferIndex++) {
+    ZeroMem (&Buffers[BufferIndex].DigestList, sizeof (Buffers[BufferIndex].DigestList));
+  }
+
+  if (BufferCount == 0) {
+    return EFI_SUCCESS;
+  }
+
+  Digests = AllocatePool (sizeof (*Digests) * BufferCount);
+  if (Digests == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  Status = EFI_SUCCESS;
+  for (Index = 0; Index < HashInterfaceHob->HashInterfaceCount; Index++) {
+    HashMask = Tpm2GetHashMaskFromAlgo (&HashInterfaceHob->HashInterface[Index].HashGuid);
+    if ((HashMask & PcdGet32 (PcdTpm2HashMask)) != 0) {
+      Status = HashInterfaceMultiBuffer (&HashInterfaceHob->HashInterface[Index], Buffers, BufferCount, Digests);
+      if (EFI_ERROR (Status)) {
+        break;
+      }
+
+      for (BufferIndex = 0; BufferIndex < BufferCount; BufferIndex++) {
+        Tpm2SetHashToDigestList (&Buffers[BufferIndex].DigestList, &Digests[BufferIndex]);
+      }
+    }
+  }
+
+  FreePool (Digests);
+
+  return Status;
+}
+
 /**
   This service register Hash.
 
@@ -323,6 +323,35 @@ HashAndExtend (
   return EFI_SUCCESS;
 }
 
+/**
+  Hash several independent data buffers, without extending any PCR.
+
+  Every buffer is hashed with the same hash algorithms as HashAndExtend() uses,
+  and its DigestList receives the digests. Hash engines that support it digest
+  all the buffers together, which is faster than hashing them one by one.
+
+  @param Buffers     Buffers to be hashed.
+  @param BufferCount Number of entries in Buffers.
+
+  @retval EFI_SUCCESS          The DigestList of every buffer is returned.
+  @retval EFI_UNSUPPORTED      The buffers cannot be hashed without extending a PCR.
+  @retval EFI_OUT_OF_RESOURCES No enough resource to hash the buffers.
+**/
+EFI_STATUS
+EFIAPI
+HashMultiBuffer (
+  IN OUT HASH_DATA_BUFFER  *Buffers,
+  IN UINTN                 BufferCount
+  )
+{
+  //
+  // The digests of all the PCR banks are only returned by the TPM along with a
+  // PCR extend, and the TPM hashes one sequence at a time anyway. Callers fall
+  // back to HashAndExtend() for every buffer.
+  //
+  return EFI_UNSUPPORTED;
+}
+
 /**
   This service register Hash.
 
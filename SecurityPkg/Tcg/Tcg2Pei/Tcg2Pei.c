@@ -123,6 +123,15 @@ EFI_PLATFORM_FIRMWARE_BLOB  *mMeasuredChildFvInfo;
 UINT32                      mMeasuredMaxChildFvIndex = 0;
 UINT32                      mMeasuredChildFvIndex    = 0;
 
+//
+// FVs already reported when the measurement starts, and their digests. They are
+// hashed together by HashReportedFvs (), and then extended and logged one by one
+// in the usual order.
+//
+EFI_PLATFORM_FIRMWARE_BLOB  *mHashedFvInfo;
+HASH_DATA_BUFFER            *mHashedFvBuffer;
+UINTN                       mHashedFvCount = 0;
+
 #pragma pack (1)
 
 #define FV_HANDOFF_TABLE_DESC  "Fv(XXXXXXXX-XXXX-XXXX-XXXX-XXXXXXXXXXXX)"
@@ -589,47 +598,25 @@ GetFvName (
 }
 
 /**
-  Measure FV image.
-  Add it into the measured FV list after the FV is measured successfully.
+  Check whether the FV is excluded from the measurement by the platform.
 
   @param[in]  FvBase            Base address of FV image.
   @param[in]  FvLength          Length of FV image.
 
-  @retval EFI_SUCCESS           Fv image is measured successfully
-                                or it has been already measured.
-  @retval EFI_OUT_OF_RESOURCES  No enough memory to log the new event.
-  @retval EFI_DEVICE_ERROR      The command was unsuccessful.
-
+  @retval TRUE   The FV is reported by an FvInfo measurement excluded PPI.
+  @retval FALSE  The FV must be measured.
 **/
-EFI_STATUS
-MeasureFvImage (
+BOOLEAN
+IsMeasurementExcludedFv (
   IN EFI_PHYSICAL_ADDRESS  FvBase,
   IN UINT64                FvLength
   )
 {
   UINT32                                                 Index;
-  EFI_STATUS                                             Status;
-  EFI_PLATFORM_FIRMWARE_BLOB                             FvBlob;
-  FV_HANDOFF_TABLE_POINTERS2                             FvBlob2;
-  VOID                                                   *EventData;
-  VOID                                                   *FvName;
-  TCG_PCR_EVENT_HDR                                      TcgEventHdr;
   UINT32                                                 Instance;
-  UINT32                                                 Tpm2HashMask;
-  TPML_DIGEST_VALUES                                     DigestList;
-  UINT32                                                 DigestCount;
+  EFI_STATUS                                             Status;
   EFI_PEI_FIRMWARE_VOLUME_INFO_MEASUREMENT_EXCLUDED_PPI  *MeasurementExcludedFvPpi;
-  EDKII_PEI_FIRMWARE_VOLUME_INFO_PREHASHED_FV_PPI        *PrehashedFvPpi;
-  HASH_INFO                                              *PreHashInfo;
-  UINT32                                                 HashAlgoMask;
-  EFI_PHYSICAL_ADDRESS                                   FvOrgBase;
-  EFI_PHYSICAL_ADDRESS                                   FvDataBase;
-  EFI_PEI_HOB_POINTERS                                   Hob;
-  EDKII_MIGRATED_FV_INFO                                 *MigratedFvInfo;
 
-  //
-  // Check Excluded FV list
-  //
   Instance = 0;
   do {
     Status = PeiServicesLocatePpi (
@@ -643,9 +630,7 @@ MeasureFvImage (
         if (  (MeasurementExcludedFvPpi->Fv[Index].FvBase == FvBase)
            && (MeasurementExcludedFvPpi->Fv[Index].FvLength == FvLength))
         {
-          DEBUG ((DEBUG_INFO, "The FV which is excluded by Tcg2Pei starts at: 0x%x\n", FvBase));
-          DEBUG ((DEBUG_INFO, "The FV which is excluded by Tcg2Pei has the size: 0x%x\n", FvLength));
-          return EFI_SUCCESS;
+          return TRUE;
         }
       }
 
@@ -653,6 +638,388 @@ MeasureFvImage (
     }
   } while (!EFI_ERROR (Status));
 
+  return FALSE;
+}
+
+/**
+  Check whether the platform provides the digests of the FV.
+
+  @param[in]  FvBase            Base address of FV image.
+  @param[in]  FvLength          Length of FV image.
+
+  @retval TRUE   The FV is reported by an FvInfo prehashed FV PPI.
+  @retval FALSE  The FV is not prehashed.
+**/
+BOOLEAN
+IsPrehashedFv (
+  IN EFI_PHYSICAL_ADDRESS  FvBase,
+  IN UINT64                FvLength
+  )
+{
+  UINT32                                           Instance;
+  EFI_STATUS                                       Status;
+  EDKII_PEI_FIRMWARE_VOLUME_INFO_PREHASHED_FV_PPI  *PrehashedFvPpi;
+
+  Instance = 0;
+  do {
+    Status = PeiServicesLocatePpi (
+               &gEdkiiPeiFirmwareVolumeInfoPrehashedFvPpiGuid,
+               Instance,
+               NULL,
+               (VOID **)&PrehashedFvPpi
+               );
+    if (!EFI_ERROR (Status) && (PrehashedFvPpi->FvBase == FvBase) && (PrehashedFvPpi->FvLength == FvLength)) {
+      return TRUE;
+    }
+
+    Instance++;
+  } while (!EFI_ERROR (Status));
+
+  return FALSE;
+}
+
+/**
+  Get the original base address of the FV, and the address of its data, which
+  differ from the FV base address if the FV has been migrated.
+
+  @param[in]   FvBase            Base address of FV image.
+  @param[in]   FvLength          Length of FV image.
+  @param[out]  FvOrgBase         Original base address of FV image.
+  @param[out]  FvDataBase        Address of the data of FV image to be hashed.
+**/
+VOID
+GetMigratedFvBase (
+  IN  EFI_PHYSICAL_ADDRESS  FvBase,
+  IN  UINT64                FvLength,
+  OUT EFI_PHYSICAL_ADDRESS  *FvOrgBase,
+  OUT EFI_PHYSICAL_ADDRESS  *FvDataBase
+  )
+{
+  EFI_PEI_HOB_POINTERS    Hob;
+  EDKII_MIGRATED_FV_INFO  *MigratedFvInfo;
+
+  *FvOrgBase  = FvBase;
+  *FvDataBase = FvBase;
+  Hob.Raw     = GetFirstGuidHob (&gEdkiiMigratedFvInfoGuid);
+  while (Hob.Raw != NULL) {
+    MigratedFvInfo = GET_GUID_HOB_DATA (Hob);
+    if ((MigratedFvInfo->FvNewBase == (UINT32)FvBase) && (MigratedFvInfo->FvLength == (UINT32)FvLength)) {
+      //
+      // Found the migrated FV info
+      //
+      *FvOrgBase  = (EFI_PHYSICAL_ADDRESS)(UINTN)MigratedFvInfo->FvOrgBase;
+      *FvDataBase = (EFI_PHYSICAL_ADDRESS)(UINTN)MigratedFvInfo->FvDataBase;
+      break;
+    }
+
+    Hob.Raw = GET_NEXT_HOB (Hob);
+    Hob.Raw = GetNextGuidHob (&gEdkiiMigratedFvInfoGuid, Hob.Raw);
+  }
+}
+
+/**
+  Find an FV hashed by HashReportedFvs ().
+
+  The FV only matches if its base address, its length and the address of its
+  data are all the ones that were hashed.
+
+  @param[in]  FvBase            Base address of FV image.
+  @param[in]  FvLength          Length of FV image.
+  @param[in]  FvDataBase        Address of the data of FV image to be hashed.
+
+  @return Index of the FV in mHashedFvInfo and mHashedFvBuffer.
+  @retval MAX_UINTN  The FV has not been hashed.
+**/
+UINTN
+FindHashedFv (
+  IN EFI_PHYSICAL_ADDRESS  FvBase,
+  IN UINT64                FvLength,
+  IN EFI_PHYSICAL_ADDRESS  FvDataBase
+  )
+{
+  UINTN  Index;
+
+  for (Index = 0; Index < mHashedFvCount; Index++) {
+    if ((mHashedFvInfo[Index].BlobBase == FvBase) &&
+        (mHashedFvInfo[Index].BlobLength == FvLength) &&
+        (mHashedFvBuffer[Index].DataToHash == (VOID *)(UINTN)FvDataBase) &&
+        (mHashedFvBuffer[Index].DataToHashLen == FvLength))
+    {
+      return Index;
+    }
+  }
+
+  return MAX_UINTN;
+}
+
+/**
+  Check whether the contents of an FV can no longer change until it is
+  measured, so that it can be hashed ahead of its measurement.
+
+  That is the case when the producer of the FV has already copied it into
+  memory allocated for it, or when the FV is memory mapped outside of system
+  memory and its header declares it write-locked or not writable.
+
+  @param[in]  FvDataBase        Address of the data of FV image to be hashed.
+  @param[in]  FvLength          Length of FV image.
+
+  @retval TRUE   The FV can be hashed ahead of its measurement.
+  @retval FALSE  The FV must be hashed when it is measured.
+**/
+BOOLEAN
+IsImmutableFv (
+  IN EFI_PHYSICAL_ADDRESS  FvDataBase,
+  IN UINT64                FvLength
+  )
+{
+  EFI_PEI_HOB_POINTERS        Hob;
+  EFI_PHYSICAL_ADDRESS        Base;
+  UINT64                      Length;
+  EFI_FIRMWARE_VOLUME_HEADER  *FvHeader;
+
+  if (FvLength < sizeof (EFI_FIRMWARE_VOLUME_HEADER)) {
+    return FALSE;
+  }
+
+  Hob.Raw = GetFirstHob (EFI_HOB_TYPE_MEMORY_ALLOCATION);
+  while (Hob.Raw != NULL) {
+    Base   = Hob.MemoryAllocation->AllocDescriptor.MemoryBaseAddress;
+    Length = Hob.MemoryAllocation->AllocDescriptor.MemoryLength;
+    if ((FvDataBase >= Base) && (FvLength <= Length) && (FvDataBase - Base <= Length - FvLength)) {
+      return TRUE;
+    }
+
+    Hob.Raw = GET_NEXT_HOB (Hob);
+    Hob.Raw = GetNextHob (EFI_HOB_TYPE_MEMORY_ALLOCATION, Hob.Raw);
+  }
+
+  Hob.Raw = GetFirstHob (EFI_HOB_TYPE_RESOURCE_DESCRIPTOR);
+  while (Hob.Raw != NULL) {
+    Base   = Hob.ResourceDescriptor->PhysicalStart;
+    Length = Hob.ResourceDescriptor->ResourceLength;
+    if ((Hob.ResourceDescriptor->ResourceType == EFI_RESOURCE_SYSTEM_MEMORY) &&
+        (FvDataBase < Base + Length) && (Base < FvDataBase + FvLength))
+    {
+      return FALSE;
+    }
+
+    Hob.Raw = GET_NEXT_HOB (Hob);
+    Hob.Raw = GetNextHob (EFI_HOB_TYPE_RESOURCE_DESCRIPTOR, Hob.Raw);
+  }
+
+  FvHeader = (EFI_FIRMWARE_VOLUME_HEADER *)(UINTN)FvDataBase;
+  if ((FvHeader->Attributes & EFI_FVB2_MEMORY_MAPPED) == 0) {
+    return FALSE;
+  }
+
+  return (BOOLEAN)(((FvHeader->Attributes & EFI_FVB2_WRITE_LOCK_STATUS) != 0) ||
+                   ((FvHeader->Attributes & EFI_FVB2_WRITE_STATUS) == 0));
+}
+
+/**
+  Free the FVs hashed by HashReportedFvs ().
+**/
+VOID
+FreeHashedFvs (
+  VOID
+  )
+{
+  if (mHashedFvInfo != NULL) {
+    FreePool (mHashedFvInfo);
+    mHashedFvInfo = NULL;
+  }
+
+  if (mHashedFvBuffer != NULL) {
+    FreePool (mHashedFvBuffer);
+    mHashedFvBuffer = NULL;
+  }
+
+  mHashedFvCount = 0;
+}
+
+/**
+  Add an FV to the ones hashed by HashReportedFvs ().
+
+  @param[in]  FvBase            Base address of FV image.
+  @param[in]  FvLength          Length of FV image.
+  @param[in]  MaxFvCount        Number of entries allocated in the hashed FV list.
+**/
+VOID
+AddReportedFv (
+  IN EFI_PHYSICAL_ADDRESS  FvBase,
+  IN UINT64                FvLength,
+  IN UINTN                 MaxFvCount
+  )
+{
+  EFI_PHYSICAL_ADDRESS  FvOrgBase;
+  EFI_PHYSICAL_ADDRESS  FvDataBase;
+
+  if (mHashedFvCount >= MaxFvCount) {
+    return;
+  }
+
+  //
+  // Excluded and prehashed FVs are handled by MeasureFvImage () without hashing
+  // them, or only with the algorithms the platform did not prehash.
+  //
+  if (IsMeasurementExcludedFv (FvBase, FvLength) || IsPrehashedFv (FvBase, FvLength)) {
+    return;
+  }
+
+  GetMigratedFvBase (FvBase, FvLength, &FvOrgBase, &FvDataBase);
+  if ((FindHashedFv (FvBase, FvLength, FvDataBase) != MAX_UINTN) || !IsImmutableFv (FvDataBase, FvLength)) {
+    return;
+  }
+
+  mHashedFvInfo[mHashedFvCount].BlobBase        = FvBase;
+  mHashedFvInfo[mHashedFvCount].BlobLength      = FvLength;
+  mHashedFvBuffer[mHashedFvCount].DataToHash    = (VOID *)(UINTN)FvDataBase;
+  mHashedFvBuffer[mHashedFvCount].DataToHashLen = (UINTN)FvLength;
+  mHashedFvCount++;
+}
+
+/**
+  Hash together the BFV and the FVs already reported through FvInfo PPIs.
+
+  When the measurement starts, most platforms have reported several FVs, which
+  are then measured one by one: the BFV by MeasureMainBios (), and the other
+  ones by the FvInfo PPI notifications. Hashing them together lets the hash
+  engines digest them in parallel. MeasureFvImage () then only extends and logs
+  the precomputed digests, in the same order as before.
+
+  Only the FVs whose contents cannot change until they are measured are hashed
+  here, see IsImmutableFv (). The other ones, and all the FVs if they cannot be
+  hashed together, are hashed by MeasureFvImage ().
+
+  @param[in]  BfvBase            Base address of the BFV.
+  @param[in]  BfvLength          Length of the BFV.
+**/
+VOID
+HashReportedFvs (
+  IN EFI_PHYSICAL_ADDRESS  BfvBase,
+  IN UINT64                BfvLength
+  )
+{
+  EFI_GUID                          *FvInfoPpiGuid[2];
+  EFI_PEI_FIRMWARE_VOLUME_INFO_PPI  *Fv;
+  EFI_PEI_FIRMWARE_VOLUME_PPI       *FvPpi;
+  UINTN                             MaxFvCount;
+  UINTN                             GuidIndex;
+  UINTN                             Instance;
+  EFI_STATUS                        Status;
+
+  FvInfoPpiGuid[0] = &gEfiPeiFirmwareVolumeInfoPpiGuid;
+  FvInfoPpiGuid[1] = &gEfiPeiFirmwareVolumeInfo2PpiGuid;
+
+  //
+  // Count the reported FVs, plus the BFV.
+  //
+  MaxFvCount = 1;
+  for (GuidIndex = 0; GuidIndex < ARRAY_SIZE (FvInfoPpiGuid); GuidIndex++) {
+    for (Instance = 0; ; Instance++) {
+      Status = PeiServicesLocatePpi (FvInfoPpiGuid[GuidIndex], Instance, NULL, (VOID **)&Fv);
+      if (EFI_ERROR (Status)) {
+        break;
+      }
+
+      MaxFvCount++;
+    }
+  }
+
+  if (MaxFvCount < 2) {
+    return;
+  }
+
+  mHashedFvInfo   = AllocatePool (sizeof (*mHashedFvInfo) * MaxFvCount);
+  mHashedFvBuffer = AllocatePool (sizeof (*mHashedFvBuffer) * MaxFvCount);
+  if ((mHashedFvInfo == NULL) || (mHashedFvBuffer == NULL)) {
+    FreeHashedFvs ();
+    return;
+  }
+
+  AddReportedFv (BfvBase, BfvLength, MaxFvCount);
+
+  //
+  // Child FVs are not measured, see FirmwareVolumeInfoPpiNotifyCallback ().
+  //
+  for (GuidIndex = 0; GuidIndex < ARRAY_SIZE (FvInfoPpiGuid); GuidIndex++) {
+    for (Instance = 0; ; Instance++) {
+      Status = PeiServicesLocatePpi (FvInfoPpiGuid[GuidIndex], Instance, NULL, (VOID **)&Fv);
+      if (EFI_ERROR (Status)) {
+        break;
+      }
+
+      if ((Fv->ParentFvName != NULL) || (Fv->ParentFileName != NULL)) {
+        continue;
+      }
+
+      Status = PeiServicesLocatePpi (&Fv->FvFormat, 0, NULL, (VOID **)&FvPpi);
+      if (EFI_ERROR (Status)) {
+        continue;
+      }
+
+      AddReportedFv ((EFI_PHYSICAL_ADDRESS)(UINTN)Fv->FvInfo, Fv->FvInfoSize, MaxFvCount);
+    }
+  }
+
+  if (mHashedFvCount == 0) {
+    FreeHashedFvs ();
+    return;
+  }
+
+  Status = HashMultiBuffer (mHashedFvBuffer, mHashedFvCount);
+  DEBUG ((DEBUG_INFO, "Tcg2Pei hashed %d reported FVs together - %r\n", (UINT32)mHashedFvCount, Status));
+  if (EFI_ERROR (Status)) {
+    FreeHashedFvs ();
+  }
+}
+
+/**
+  Measure FV image.
+  Add it into the measured FV list after the FV is measured successfully.
+
+  @param[in]  FvBase            Base address of FV image.
+  @param[in]  FvLength          Length of FV image.
+
+  @retval EFI_SUCCESS           Fv image is measured successfully
+                                or it has been already measured.
+  @retval EFI_OUT_OF_RESOURCES  No enough memory to log the new event.
+  @retval EFI_DEVICE_ERROR      The command was unsuccessful.
+
+**/
+EFI_STATUS
+MeasureFvImage (
+  IN EFI_PHYSICAL_ADDRESS  FvBase,
+  IN UINT64                FvLength
+  )
+{
+  UINT32                                           Index;
+  EFI_STATUS                                       Status;
+  EFI_PLATFORM_FIRMWARE_BLOB                       FvBlob;
+  FV_HANDOFF_TABLE_POINTERS2                       FvBlob2;
+  VOID                                             *EventData;
+  VOID                                             *FvName;
+  TCG_PCR_EVENT_HDR                                TcgEventHdr;
+  UINT32                                           Instance;
+  UINT32                                           Tpm2HashMask;
+  TPML_DIGEST_VALUES                               DigestList;
+  UINTN                                            HashedFvIndex;
+  UINT32                                           DigestCount;
+  EDKII_PEI_FIRMWARE_VOLUME_INFO_PREHASHED_FV_PPI  *PrehashedFvPpi;
+  HASH_INFO                                        *PreHashInfo;
+  UINT32                                           HashAlgoMask;
+  EFI_PHYSICAL_ADDRESS                             FvOrgBase;
+  EFI_PHYSICAL_ADDRESS                             FvDataBase;
+
+  //
+  // Check Excluded FV list
+  //
+  if (IsMeasurementExcludedFv (FvBase, FvLength)) {
+    DEBUG ((DEBUG_INFO, "The FV which is excluded by Tcg2Pei starts at: 0x%x\n", FvBase));
+    DEBUG ((DEBUG_INFO, "The FV which is excluded by Tcg2Pei has the size: 0x%x\n", FvLength));
+    return EFI_SUCCESS;
+  }
+
   //
   // Check measured FV list
   //
@@ -717,23 +1084,7 @@ MeasureFvImage (
   //
   // Search the matched migration FV info
   //
-  FvOrgBase  = FvBase;
-  FvDataBase = FvBase;
-  Hob.Raw    = GetFirstGuidHob (&gEdkiiMigratedFvInfoGuid);
-  while (Hob.Raw != NULL) {
-    MigratedFvInfo = GET_GUID_HOB_DATA (Hob);
-    if ((MigratedFvInfo->FvNewBase == (UINT32)FvBase) && (MigratedFvInfo->FvLength == (UINT32)FvLength)) {
-      //
-      // Found the migrated FV info
-      //
-      FvOrgBase  = (EFI_PHYSICAL_ADDRESS)(UINTN)MigratedFvInfo->FvOrgBase;
-      FvDataBase = (EFI_PHYSICAL_ADDRESS)(UINTN)MigratedFvInfo->FvDataBase;
-      break;
-    }
-
-    Hob.Raw = GET_NEXT_HOB (Hob);
-    Hob.Raw = GetNextGuidHob (&gEdkiiMigratedFvInfoGuid, Hob.Raw);
-  }
+  GetMigratedFvBase (FvBase, FvLength, &FvOrgBase, &FvDataBase);
 
   //
   // Init the log event for FV measurement
@@ -761,6 +1112,8 @@ MeasureFvImage (
     EventData             = &FvBlob;
   }
 
+  HashedFvIndex = FindHashedFv (FvBase, FvLength, FvDataBase);
+
   if (Tpm2HashMask == 0) {
     //
     // FV pre-hash algos comply with current TPM hash requirement
@@ -776,6 +1129,23 @@ MeasureFvImage (
                );
     DEBUG ((DEBUG_INFO, "The pre-hashed FV which is extended & logged by Tcg2Pei starts at: 0x%x\n", FvBase));
     DEBUG ((DEBUG_INFO, "The pre-hashed FV which is extended & logged by Tcg2Pei has the size: 0x%x\n", FvLength));
+  } else if (HashedFvIndex != MAX_UINTN) {
+    //
+    // The FV is hashed along with the other reported FVs, only extend the digests
+    // to the TPM and log TCG event. The digests are used once.
+    //
+    Status = HashLogExtendEvent (
+               &mEdkiiTcgPpi,
+               EDKII_TCG_PRE_HASH,
+               (UINT8 *)&mHashedFvBuffer[HashedFvIndex].DigestList, // HashData
+               (UINTN)sizeof (TPML_DIGEST_VALUES),                  // HashDataLen
+               &TcgEventHdr,                                        // EventHdr
+               EventData                                            // EventData
+               );
+
+    mHashedFvInfo[HashedFvIndex].BlobLength = 0;
+    DEBUG ((DEBUG_INFO, "The FV which is measured by Tcg2Pei starts at: 0x%x\n", FvBase));
+    DEBUG ((DEBUG_INFO, "The FV which is measured by Tcg2Pei has the size: 0x%x\n", FvLength));
   } else {
     //
     // Hash the FV, extend digest to the TPM and log TCG event
@@ -864,6 +1234,8 @@ MeasureMainBios (
              );
   ASSERT_EFI_ERROR (Status);
 
+  HashReportedFvs ((EFI_PHYSICAL_ADDRESS)(UINTN)VolumeInfo.FvStart, VolumeInfo.FvSize);
+
   Status = MeasureFvImage ((EFI_PHYSICAL_ADDRESS)(UINTN)VolumeInfo.FvStart, VolumeInfo.FvSize);
 
   PERF_END_EX (mFileHandle, "EventRec", "Tcg2Pei", 0, PERF_ID_TCG2_PEI + 1);
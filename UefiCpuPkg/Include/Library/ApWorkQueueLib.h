@@ -0,0 +1,163 @@
+/** @file
+  AP work queue library.
+
+  Spreads loops and independent tasks across all enabled processors through the
+  MP services. Every processor owns a lock-free deque of submitted tasks; idle
+  processors steal from the deques of busy ones, and parallel loops are split
+  into chunks that any processor may claim.
+
+  All services may only be invoked from the BSP or from a task or loop body that
+  is already running under this library. Tasks and loop bodies may run on APs,
+  so they must not call boot services, PEI services or PPIs, but they may submit
+  and wait for further tasks and start nested parallel loops.
+
+  Copyright (c) 2026, Intel Corporation. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#ifndef AP_WORK_QUEUE_LIB_H_
+#define AP_WORK_QUEUE_LIB_H_
+
+#include <Uefi/UefiBaseType.h>
+
+/**
+  Body of a parallel loop, invoked once for every index of the loop range.
+
+  @param[in] Index    The loop index.
+  @param[in] Context  The context passed to ApWorkQueueParallelFor ().
+
+**/
+typedef
+VOID
+(EFIAPI *AP_WORK_QUEUE_LOOP_BODY)(
+  IN UINTN  Index,
+  IN VOID   *Context OPTIONAL
+  );
+
+/**
+  A task submitted to the work queue.
+
+  @param[in] Context  The context passed to ApWorkQueueSubmit ().
+
+  @return The status reported by ApWorkQueueWait () for this task.
+
+**/
+typedef
+EFI_STATUS
+(EFIAPI *AP_WORK_QUEUE_TASK)(
+  IN VOID  *Context OPTIONAL
+  );
+
+///
+/// Completion handle of a submitted task. The storage is owned by the caller
+/// and must stay valid until ApWorkQueueWait () returns for it. The fields are
+/// private to the library.
+///
+typedef struct {
+  AP_WORK_QUEUE_TASK    Task;
+  VOID                  *Context;
+  volatile UINT32       State;
+  EFI_STATUS            Status;
+} AP_WORK_QUEUE_FUTURE;
+
+/**
+  Returns the number of processors that take part in the work queue.
+
+  The count includes the BSP. It is 1 if no MP services are available.
+
+  @return The number of worker processors.
+
+**/
+UINTN
+EFIAPI
+ApWorkQueueGetWorkerCount (
+  VOID
+  );
+
+/**
+  Runs Body for every index in [Start, End) on all worker processors and
+  returns once every index has been processed.
+
+  The range is split into chunks of Grain consecutive indexes. The order in
+  which indexes are processed is unspecified.
+
+  @param[in] Start    First index of the loop range.
+  @param[in] End      One past the last index of the loop range.
+  @param[in] Grain    Number of consecutive indexes processed per chunk. Zero
+                      selects a chunk size based on the worker count.
+  @param[in] Body     The loop body.
+  @param[in] Context  Context passed to every Body invocation.
+
+  @retval EFI_SUCCESS            All indexes were processed.
+  @retval EFI_INVALID_PARAMETER  Body is NULL or End is less than Start.
+
+**/
+EFI_STATUS
+EFIAPI
+ApWorkQueueParallelFor (
+  IN UINTN                    Start,
+  IN UINTN                    End,
+  IN UINTN                    Grain,
+  IN AP_WORK_QUEUE_LOOP_BODY  Body,
+  IN VOID                     *Context OPTIONAL
+  );
+
+/**
+  Queues a task for execution by any worker processor.
+
+  When called from the BSP outside of a task, the task does not start before
+  ApWorkQueueWait () is called for it or for any other future; that call runs
+  every queued task on all processors. When called from a task, idle
+  processors may start the new task immediately.
+
+  @param[in]  Task     The task to run.
+  @param[in]  Context  Context passed to Task.
+  @param[out] Future   Caller-owned completion handle of the task.
+
+  @retval EFI_SUCCESS            The task was queued, or ran to completion
+                                 inline because the queue was full.
+  @retval EFI_INVALID_PARAMETER  Task or Future is NULL.
+
+**/
+EFI_STATUS
+EFIAPI
+ApWorkQueueSubmit (
+  IN  AP_WORK_QUEUE_TASK    Task,
+  IN  VOID                  *Context OPTIONAL,
+  OUT AP_WORK_QUEUE_FUTURE  *Future
+  );
+
+/**
+  Waits for a submitted task and returns its status.
+
+  While waiting, the calling processor runs queued tasks and loop chunks.
+
+  @param[in] Future  The completion handle filled by ApWorkQueueSubmit ().
+
+  @retval EFI_INVALID_PARAMETER  Future is NULL or was never submitted.
+  @return The status returned by the task.
+
+**/
+EFI_STATUS
+EFIAPI
+ApWorkQueueWait (
+  IN AP_WORK_QUEUE_FUTURE  *Future
+  );
+
+/**
+  Checks whether a submitted task has finished, without waiting.
+
+  @param[in] Future  The completion handle filled by ApWorkQueueSubmit ().
+
+  @retval TRUE   The task finished; ApWorkQueueWait () returns immediately.
+  @retval FALSE  The task has not finished or Future was never submitted.
+
+**/
+BOOLEAN
+EFIAPI
+ApWorkQueueIsComplete (
+  IN AP_WORK_QUEUE_FUTURE  *Future
+  );
+
+#endif
@@ -0,0 +1,674 @@
+/** @file
+  AP work queue library core, shared by the DXE, PEI and host instances.
+
+  Work runs in sessions. A session starts when the BSP waits for a task or
+  starts a parallel loop outside of a session: every worker processor then
+  executes queued tasks and loop chunks until no submitted task and no open
+  loop is left. Inside a session a processor that waits for a task or a loop
+  keeps executing other work until the awaited work is done.
+
+  Every processor owns a Chase-Lev deque indexed by its processor number.
+  Submitted tasks are pushed to the deque of the submitting processor; idle
+  processors pop their own deque first and steal from the deques of random
+  victims otherwise. Parallel loops live in a small table of loop slots that
+  every processor scans before looking for tasks.
+
+  Copyright (c) 2026, Intel Corporation. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include "ApWorkQueueLibInternal.h"
+
+STATIC BOOLEAN              mApWorkQueueInitialized = FALSE;
+STATIC UINTN                mApWorkQueueProcessorCount;
+STATIC UINTN                mApWorkQueueWorkerCount;
+STATIC AP_WORK_QUEUE_DEQUE  *mApWorkQueueDeques;
+STATIC AP_WORK_QUEUE_DEQUE  mApWorkQueueBspDeque;
+STATIC AP_WORK_QUEUE_LOOP   mApWorkQueueLoops[AP_WORK_QUEUE_MAX_LOOPS];
+
+//
+// Number of submitted tasks that have not finished plus the number of open
+// loops with unfinished chunks. Workers leave the session once it drops to 0.
+//
+STATIC volatile UINT32   mApWorkQueuePending       = 0;
+STATIC volatile BOOLEAN  mApWorkQueueSessionActive = FALSE;
+
+/**
+  Locates the MP services and allocates the per-processor deques on first use.
+
+  Only called on the BSP outside of a session.
+
+**/
+STATIC
+VOID
+ApWorkQueueInitialize (
+  VOID
+  )
+{
+  UINTN  ProcessorCount;
+  UINTN  WorkerCount;
+  UINTN  Index;
+
+  if (mApWorkQueueInitialized) {
+    return;
+  }
+
+  ApWorkQueueBackendInitialize (&ProcessorCount, &WorkerCount);
+
+  mApWorkQueueDeques = NULL;
+  if (WorkerCount > 1) {
+    mApWorkQueueDeques = AllocateZeroPool (ProcessorCount * sizeof (AP_WORK_QUEUE_DEQUE));
+  }
+
+  if (mApWorkQueueDeques == NULL) {
+    mApWorkQueueDeques         = &mApWorkQueueBspDeque;
+    mApWorkQueueProcessorCount = 1;
+    mApWorkQueueWorkerCount    = 1;
+  } else {
+    mApWorkQueueProcessorCount = ProcessorCount;
+    mApWorkQueueWorkerCount    = WorkerCount;
+  }
+
+  for (Index = 0; Index < mApWorkQueueProcessorCount; Index++) {
+    mApWorkQueueDeques[Index].Random = ((UINT32)Index * 0x9E3779B9) | 1;
+  }
+
+  DEBUG ((DEBUG_INFO, "%a: %d worker processors\n", __func__, mApWorkQueueWorkerCount));
+  mApWorkQueueInitialized = TRUE;
+}
+
+/**
+  Returns the deque index of the calling processor.
+
+  @return The index into mApWorkQueueDeques.
+
+**/
+STATIC
+UINTN
+ApWorkQueueCurrentProcessor (
+  VOID
+  )
+{
+  UINTN  Processor;
+
+  if (mApWorkQueueWorkerCount == 1) {
+    return 0;
+  }
+
+  Processor = ApWorkQueueBackendWhoAmI ();
+  ASSERT (Processor < mApWorkQueueProcessorCount);
+  return Processor;
+}
+
+/**
+  Pushes a task to the bottom of the deque of the calling processor.
+
+  @param[in] Deque   The deque owned by the calling processor.
+  @param[in] Future  The task to push.
+
+  @retval TRUE   The task was pushed.
+  @retval FALSE  The deque is full.
+
+**/
+STATIC
+BOOLEAN
+ApWorkQueueDequePush (
+  IN AP_WORK_QUEUE_DEQUE   *Deque,
+  IN AP_WORK_QUEUE_FUTURE  *Future
+  )
+{
+  UINT32  Bottom;
+
+  Bottom = Deque->Bottom;
+  if ((UINT32)(Bottom - Deque->Top) >= AP_WORK_QUEUE_DEQUE_SIZE) {
+    return FALSE;
+  }
+
+  Deque->Slots[Bottom & (AP_WORK_QUEUE_DEQUE_SIZE - 1)] = Future;
+  MemoryFence ();
+  Deque->Bottom = Bottom + 1;
+  return TRUE;
+}
+
+/**
+  Pops the most recently pushed task from the deque of the calling processor.
+
+  @param[in] Deque  The deque owned by the calling processor.
+
+  @return The task, or NULL if the deque is empty or a thief took the last task.
+
+**/
+STATIC
+AP_WORK_QUEUE_FUTURE *
+ApWorkQueueDequePop (
+  IN AP_WORK_QUEUE_DEQUE  *Deque
+  )
+{
+  UINT32                Bottom;
+  UINT32                Top;
+  AP_WORK_QUEUE_FUTURE  *Future;
+
+  //
+  // Claim the bottom slot before looking at Top. Only the owner writes Bottom,
+  // so the exchange always succeeds; it is used for its full fence, which
+  // orders the store against the load of Top that follows.
+  //
+  Bottom = Deque->Bottom - 1;
+  InterlockedCompareExchange32 (&Deque->Bottom, Bottom + 1, Bottom);
+  Top = Deque->Top;
+
+  if ((INT32)(Bottom - Top) < 0) {
+    Deque->Bottom = Bottom + 1;
+    return NULL;
+  }
+
+  Future = Deque->Slots[Bottom & (AP_WORK_QUEUE_DEQUE_SIZE - 1)];
+  if (Bottom != Top) {
+    return Future;
+  }
+
+  //
+  // Last task: race the thieves for it through Top.
+  //
+  if (InterlockedCompareExchange32 (&Deque->Top, Top, Top + 1) != Top) {
+    Future = NULL;
+  }
+
+  Deque->Bottom = Bottom + 1;
+  return Future;
+}
+
+/**
+  Steals the oldest task from the deque of another processor.
+
+  @param[in] Deque  The deque of the victim processor.
+
+  @return The task, or NULL if the deque is empty or another processor won it.
+
+**/
+STATIC
+AP_WORK_QUEUE_FUTURE *
+ApWorkQueueDequeSteal (
+  IN AP_WORK_QUEUE_DEQUE  *Deque
+  )
+{
+  UINT32                Top;
+  UINT32                Bottom;
+  AP_WORK_QUEUE_FUTURE  *Future;
+
+  Top = Deque->Top;
+  MemoryFence ();
+  Bottom = Deque->Bottom;
+
+  if ((INT32)(Bottom - Top) <= 0) {
+    return NULL;
+  }
+
+  Future = Deque->Slots[Top & (AP_WORK_QUEUE_DEQUE_SIZE - 1)];
+  if (InterlockedCompareExchange32 (&Deque->Top, Top, Top + 1) != Top) {
+    return NULL;
+  }
+
+  return Future;
+}
+
+/**
+  Runs a task taken from a deque and publishes its status.
+
+  @param[in] Future  The task to run.
+
+**/
+STATIC
+VOID
+ApWorkQueueRunTask (
+  IN AP_WORK_QUEUE_FUTURE  *Future
+  )
+{
+  EFI_STATUS  Status;
+
+  Future->State  = AP_WORK_QUEUE_FUTURE_RUNNING;
+  Status         = Future->Task (Future->Context);
+  Future->Status = Status;
+  MemoryFence ();
+
+  //
+  // The waiter may release the future as soon as it observes the done state,
+  // so the future must not be touched afterwards.
+  //
+  Future->State = AP_WORK_QUEUE_FUTURE_DONE;
+  InterlockedDecrement (&mApWorkQueuePending);
+}
+
+/**
+  Runs the indexes [Start, End) of a loop on the calling processor.
+
+  @param[in] Body     The loop body.
+  @param[in] Start    First index.
+  @param[in] End      One past the last index.
+  @param[in] Context  Context passed to Body.
+
+**/
+STATIC
+VOID
+ApWorkQueueRunRange (
+  IN AP_WORK_QUEUE_LOOP_BODY  Body,
+  IN UINTN                    Start,
+  IN UINTN                    End,
+  IN VOID                     *Context
+  )
+{
+  UINTN  Index;
+
+  for (Index = Start; Index < End; Index++) {
+    Body (Index, Context);
+  }
+}
+
+/**
+  Claims and runs chunks of an open loop until no unclaimed chunk is left.
+
+  @param[in] Loop  The loop slot.
+
+  @retval TRUE   At least one chunk was run.
+  @retval FALSE  The loop is not open or has no unclaimed chunk.
+
+**/
+STATIC
+BOOLEAN
+ApWorkQueueJoinLoop (
+  IN AP_WORK_QUEUE_LOOP  *Loop
+  )
+{
+  UINT32   Chunk;
+  UINTN    First;
+  UINTN    Last;
+  BOOLEAN  Ran;
+
+  if (Loop->State != AP_WORK_QUEUE_LOOP_OPEN) {
+    return FALSE;
+  }
+
+  //
+  // Register as participant before reading the loop, then check that the slot
+  // was not closed in between. The owner only recycles the slot after it saw
+  // it closing with no participant left.
+  //
+  Ran = FALSE;
+  InterlockedIncrement (&Loop->Active);
+  if (Loop->State == AP_WORK_QUEUE_LOOP_OPEN) {
+    while (Loop->NextChunk < Loop->ChunkCount) {
+      Chunk = InterlockedIncrement (&Loop->NextChunk) - 1;
+      if (Chunk >= Loop->ChunkCount) {
+        break;
+      }
+
+      First = Loop->Start + Chunk * Loop->Grain;
+      Last  = (Loop->End - First > Loop->Grain) ? First + Loop->Grain : Loop->End;
+      ApWorkQueueRunRange (Loop->Body, First, Last, Loop->Context);
+      Ran = TRUE;
+
+      if (InterlockedIncrement (&Loop->DoneChunks) == Loop->ChunkCount) {
+        InterlockedDecrement (&mApWorkQueuePending);
+      }
+    }
+  }
+
+  InterlockedDecrement (&Loop->Active);
+  return Ran;
+}
+
+/**
+  Runs one unit of work on the calling processor: chunks of an open loop, a
+  task of its own deque, or a task stolen from another processor.
+
+  @param[in] Processor  Deque index of the calling processor.
+
+  @retval TRUE   Some work was run.
+  @retval FALSE  No work was found.
+
+**/
+STATIC
+BOOLEAN
+ApWorkQueueRunOne (
+  IN UINTN  Processor
+  )
+{
+  AP_WORK_QUEUE_DEQUE   *Deque;
+  AP_WORK_QUEUE_FUTURE  *Future;
+  UINTN                 Index;
+  UINTN                 Victim;
+  UINT32                Random;
+
+  //
+  // Open loops come first: their owners are blocked until every chunk is done.
+  //
+  for (Index = 0; Index < AP_WORK_QUEUE_MAX_LOOPS; Index++) {
+    if (ApWorkQueueJoinLoop (&mApWorkQueueLoops[Index])) {
+      return TRUE;
+    }
+  }
+
+  Deque  = &mApWorkQueueDeques[Processor];
+  Future = ApWorkQueueDequePop (Deque);
+  if (Future != NULL) {
+    ApWorkQueueRunTask (Future);
+    return TRUE;
+  }
+
+  if (mApWorkQueueProcessorCount == 1) {
+    return FALSE;
+  }
+
+  for (Index = 0; Index < AP_WORK_QUEUE_STEAL_ATTEMPTS; Index++) {
+    Random        = Deque->Random;
+    Random       ^= Random << 13;
+    Random       ^= Random >> 17;
+    Random       ^= Random << 5;
+    Deque->Random = Random;
+
+    Victim = Random % mApWorkQueueProcessorCount;
+    if (Victim == Processor) {
+      continue;
+    }
+
+    Future = ApWorkQueueDequeSteal (&mApWorkQueueDeques[Victim]);
+    if (Future != NULL) {
+      ApWorkQueueRunTask (Future);
+      return TRUE;
+    }
+  }
+
+  return FALSE;
+}
+
+/**
+  Worker procedure of a session, run by every worker processor.
+
+  @param[in] Argument  Not used.
+
+**/
+STATIC
+VOID
+EFIAPI
+ApWorkQueueWorker (
+  IN VOID  *Argument
+  )
+{
+  UINTN  Processor;
+
+  Processor = ApWorkQueueCurrentProcessor ();
+  while (mApWorkQueuePending != 0) {
+    if (!ApWorkQueueRunOne (Processor)) {
+      CpuPause ();
+    }
+  }
+}
+
+/**
+  Runs a session on all worker processors. Returns once every submitted task
+  has finished and every open loop is done.
+
+  Only called on the BSP outside of a session.
+
+**/
+STATIC
+VOID
+ApWorkQueueRunSession (
+  VOID
+  )
+{
+  ASSERT (!mApWorkQueueSessionActive);
+
+  mApWorkQueueSessionActive = TRUE;
+  if (mApWorkQueueWorkerCount > 1) {
+    ApWorkQueueBackendRunOnAllProcessors (ApWorkQueueWorker, NULL);
+  } else {
+    ApWorkQueueWorker (NULL);
+  }
+
+  ASSERT (mApWorkQueuePending == 0);
+  mApWorkQueueSessionActive = FALSE;
+}
+
+/**
+  Returns the number of processors that take part in the work queue.
+
+  The count includes the BSP. It is 1 if no MP services are available.
+
+  @return The number of worker processors.
+
+**/
+UINTN
+EFIAPI
+ApWorkQueueGetWorkerCount (
+  VOID
+  )
+{
+  ApWorkQueueInitialize ();
+  return mApWorkQueueWorkerCount;
+}
+
+/**
+  Runs Body for every index in [Start, End) on all worker processors and
+  returns once every index has been processed.
+
+  The range is split into chunks of Grain consecutive indexes. The order in
+  which indexes are processed is unspecified.
+
+  @param[in] Start    First index of the loop range.
+  @param[in] End      One past the last index of the loop range.
+  @param[in] Grain    Number of consecutive indexes processed per chunk. Zero
+                      selects a chunk size based on the worker count.
+  @param[in] Body     The loop body.
+  @param[in] Context  Context passed to every Body invocation.
+
+  @retval EFI_SUCCESS            All indexes were processed.
+  @retval EFI_INVALID_PARAMETER  Body is NULL or End is less than Start.
+
+**/
+EFI_STATUS
+EFIAPI
+ApWorkQueueParallelFor (
+  IN UINTN                    Start,
+  IN UINTN                    End,
+  IN UINTN                    Grain,
+  IN AP_WORK_QUEUE_LOOP_BODY  Body,
+  IN VOID                     *Context OPTIONAL
+  )
+{
+  UINTN               Range;
+  UINT32              ChunkCount;
+  UINTN               Index;
+  UINTN               Processor;
+  AP_WORK_QUEUE_LOOP  *Loop;
+
+  if ((Body == NULL) || (End < Start)) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  if (End == Start) {
+    return EFI_SUCCESS;
+  }
+
+  ApWorkQueueInitialize ();
+
+  Range = End - Start;
+  if (Grain == 0) {
+    Grain = Range / (mApWorkQueueWorkerCount * AP_WORK_QUEUE_CHUNKS_PER_WORKER);
+    if (Grain == 0) {
+      Grain = 1;
+    }
+  }
+
+  //
+  // Keep the chunk count within the 32-bit chunk counters.
+  //
+  if (Range / Grain >= MAX_UINT32 - 1) {
+    Grain = Range / (MAX_UINT32 - 2) + 1;
+  }
+
+  ChunkCount = (UINT32)(Range / Grain + ((Range % Grain != 0) ? 1 : 0));
+
+  Loop = NULL;
+  if ((mApWorkQueueWorkerCount > 1) && (ChunkCount > 1)) {
+    for (Index = 0; Index < AP_WORK_QUEUE_MAX_LOOPS; Index++) {
+      if (InterlockedCompareExchange32 (
+            &mApWorkQueueLoops[Index].State,
+            AP_WORK_QUEUE_LOOP_FREE,
+            AP_WORK_QUEUE_LOOP_INIT
+            ) == AP_WORK_QUEUE_LOOP_FREE)
+      {
+        Loop = &mApWorkQueueLoops[Index];
+        break;
+      }
+    }
+  }
+
+  if (Loop == NULL) {
+    ApWorkQueueRunRange (Body, Start, End, Context);
+    return EFI_SUCCESS;
+  }
+
+  Loop->Start      = Start;
+  Loop->End        = End;
+  Loop->Grain      = Grain;
+  Loop->Body       = Body;
+  Loop->Context    = Context;
+  Loop->ChunkCount = ChunkCount;
+  Loop->NextChunk  = 0;
+  Loop->DoneChunks = 0;
+  InterlockedIncrement (&mApWorkQueuePending);
+  MemoryFence ();
+  Loop->State = AP_WORK_QUEUE_LOOP_OPEN;
+
+  if (!mApWorkQueueSessionActive) {
+    ApWorkQueueRunSession ();
+  } else {
+    Processor = ApWorkQueueCurrentProcessor ();
+    ApWorkQueueJoinLoop (Loop);
+    while (Loop->DoneChunks != ChunkCount) {
+      if (!ApWorkQueueRunOne (Processor)) {
+        CpuPause ();
+      }
+    }
+  }
+
+  //
+  // Close the slot, then wait for late participants that registered before
+  // they could see it closing. The exchange orders the store of the closing
+  // state against the load of Active.
+  //
+  InterlockedCompareExchange32 (&Loop->State, AP_WORK_QUEUE_LOOP_OPEN, AP_WORK_QUEUE_LOOP_CLOSING);
+  while (Loop->Active != 0) {
+    CpuPause ();
+  }
+
+  Loop->State = AP_WORK_QUEUE_LOOP_FREE;
+  return EFI_SUCCESS;
+}
+
+/**
+  Queues a task for execution by any worker processor.
+
+  When called from the BSP outside of a task, the task does not start before
+  ApWorkQueueWait () is called for it or for any other future; that call runs
+  every queued task on all processors. When called from a task, idle
+  processors may start the new task immediately.
+
+  @param[in]  Task     The task to run.
+  @param[in]  Context  Context passed to Task.
+  @param[out] Future   Caller-owned completion handle of the task.
+
+  @retval EFI_SUCCESS            The task was queued, or ran to completion
+                                 inline because the queue was full.
+  @retval EFI_INVALID_PARAMETER  Task or Future is NULL.
+
+**/
+EFI_STATUS
+EFIAPI
+ApWorkQueueSubmit (
+  IN  AP_WORK_QUEUE_TASK    Task,
+  IN  VOID                  *Context OPTIONAL,
+  OUT AP_WORK_QUEUE_FUTURE  *Future
+  )
+{
+  if ((Task == NULL) || (Future == NULL)) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  ApWorkQueueInitialize ();
+
+  Future->Task    = Task;
+  Future->Context = Context;
+  Future->Status  = EFI_NOT_READY;
+  Future->State   = AP_WORK_QUEUE_FUTURE_PENDING;
+  InterlockedIncrement (&mApWorkQueuePending);
+
+  if (!ApWorkQueueDequePush (&mApWorkQueueDeques[ApWorkQueueCurrentProcessor ()], Future)) {
+    ApWorkQueueRunTask (Future);
+  }
+
+  return EFI_SUCCESS;
+}
+
+/**
+  Waits for a submitted task and returns its status.
+
+  While waiting, the calling processor runs queued tasks and loop chunks.
+
+  @param[in] Future  The completion handle filled by ApWorkQueueSubmit ().
+
+  @retval EFI_INVALID_PARAMETER  Future is NULL or was never submitted.
+  @return The status returned by the task.
+
+**/
+EFI_STATUS
+EFIAPI
+ApWorkQueueWait (
+  IN AP_WORK_QUEUE_FUTURE  *Future
+  )
+{
+  UINTN  Processor;
+
+  if (  (Future == NULL)
+     || (Future->State < AP_WORK_QUEUE_FUTURE_PENDING)
+     || (Future->State > AP_WORK_QUEUE_FUTURE_DONE))
+  {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  if (Future->State != AP_WORK_QUEUE_FUTURE_DONE) {
+    if (!mApWorkQueueSessionActive) {
+      ApWorkQueueRunSession ();
+    } else {
+      Processor = ApWorkQueueCurrentProcessor ();
+      while (Future->State != AP_WORK_QUEUE_FUTURE_DONE) {
+        if (!ApWorkQueueRunOne (Processor)) {
+          CpuPause ();
+        }
+      }
+    }
+  }
+
+  ASSERT (Future->State == AP_WORK_QUEUE_FUTURE_DONE);
+  return Future->Status;
+}
+
+/**
+  Checks whether a submitted task has finished, without waiting.
+
+  @param[in] Future  The completion handle filled by ApWorkQueueSubmit ().
+
+  @retval TRUE   The task finished; ApWorkQueueWait () returns immediately.
+  @retval FALSE  The task has not finished or Future was never submitted.
+
+**/
+BOOLEAN
+EFIAPI
+ApWorkQueueIsComplete (
+  IN AP_WORK_QUEUE_FUTURE  *Future
+  )
+{
+  return (BOOLEAN)((Future != NULL) && (Future->State == AP_WORK_QUEUE_FUTURE_DONE));
+}
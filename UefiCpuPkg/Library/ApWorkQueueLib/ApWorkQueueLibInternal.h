@@ -0,0 +1,155 @@
+/** @file
+  Internal definitions shared by the AP work queue library core and the MP
+  services backends of the DXE, PEI and host instances.
+
+  Copyright (c) 2026, Intel Corporation. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#ifndef AP_WORK_QUEUE_LIB_INTERNAL_H_
+#define AP_WORK_QUEUE_LIB_INTERNAL_H_
+
+#include <Uefi.h>
+#include <Library/ApWorkQueueLib.h>
+#include <Library/BaseLib.h>
+#include <Library/DebugLib.h>
+#include <Library/MemoryAllocationLib.h>
+#include <Library/SynchronizationLib.h>
+
+//
+// Number of task slots in every per-processor deque. Must be a power of two.
+// A task submitted to a full deque runs inline on the submitting processor.
+//
+#define AP_WORK_QUEUE_DEQUE_SIZE  128
+
+//
+// Number of parallel loops that can be open at the same time. A loop started
+// while all slots are in use runs inline on the calling processor.
+//
+#define AP_WORK_QUEUE_MAX_LOOPS  8
+
+//
+// Number of chunks every worker gets on average when ApWorkQueueParallelFor ()
+// picks the chunk size.
+//
+#define AP_WORK_QUEUE_CHUNKS_PER_WORKER  4
+
+//
+// Number of random victims an idle processor probes before it gives up
+// stealing for one round.
+//
+#define AP_WORK_QUEUE_STEAL_ATTEMPTS  4
+
+//
+// AP_WORK_QUEUE_FUTURE.State values.
+//
+#define AP_WORK_QUEUE_FUTURE_UNSUBMITTED  0
+#define AP_WORK_QUEUE_FUTURE_PENDING      1
+#define AP_WORK_QUEUE_FUTURE_RUNNING      2
+#define AP_WORK_QUEUE_FUTURE_DONE         3
+
+//
+// AP_WORK_QUEUE_LOOP.State values.
+//
+#define AP_WORK_QUEUE_LOOP_FREE     0
+#define AP_WORK_QUEUE_LOOP_INIT     1
+#define AP_WORK_QUEUE_LOOP_OPEN     2
+#define AP_WORK_QUEUE_LOOP_CLOSING  3
+
+///
+/// Fixed-size Chase-Lev work-stealing deque. The owning processor pushes and
+/// pops at Bottom, other processors steal at Top. Top and Bottom only grow and
+/// are compared with wrap-around arithmetic.
+///
+typedef struct {
+  volatile UINT32                   Top;
+  volatile UINT32                   Bottom;
+  AP_WORK_QUEUE_FUTURE *volatile    Slots[AP_WORK_QUEUE_DEQUE_SIZE];
+  //
+  // State of the victim selection generator, only used by the owner.
+  //
+  UINT32                            Random;
+} AP_WORK_QUEUE_DEQUE;
+
+///
+/// A parallel loop that any worker processor may join. Participants claim
+/// chunks of Grain indexes through NextChunk.
+///
+typedef struct {
+  volatile UINT32            State;
+  //
+  // Number of processors currently claiming chunks of this loop. The slot is
+  // only reused once the loop is closing and no participant is left.
+  //
+  volatile UINT32            Active;
+  volatile UINT32            NextChunk;
+  volatile UINT32            DoneChunks;
+  UINT32                     ChunkCount;
+  UINTN                      Start;
+  UINTN                      End;
+  UINTN                      Grain;
+  AP_WORK_QUEUE_LOOP_BODY    Body;
+  VOID                       *Context;
+} AP_WORK_QUEUE_LOOP;
+
+/**
+  Procedure run by every worker processor during a session.
+
+  @param[in] Argument  Argument passed to ApWorkQueueBackendRunOnAllProcessors ().
+
+**/
+typedef
+VOID
+(EFIAPI *AP_WORK_QUEUE_PROCEDURE)(
+  IN VOID  *Argument
+  );
+
+/**
+  Locates the MP services and reports the processors that take part in the
+  work queue.
+
+  On failure the backend reports a single worker and runs every session on
+  the BSP alone.
+
+  @param[out] ProcessorCount  Number of processor numbers ApWorkQueueBackendWhoAmI ()
+                              may return. Processor numbers are below this value.
+  @param[out] WorkerCount     Number of enabled processors, including the BSP.
+
+**/
+VOID
+ApWorkQueueBackendInitialize (
+  OUT UINTN  *ProcessorCount,
+  OUT UINTN  *WorkerCount
+  );
+
+/**
+  Returns the number of the calling processor.
+
+  @return The processor number, below the ProcessorCount reported by
+          ApWorkQueueBackendInitialize ().
+
+**/
+UINTN
+ApWorkQueueBackendWhoAmI (
+  VOID
+  );
+
+/**
+  Runs Procedure on the BSP and on all enabled APs at the same time, and
+  returns once every processor returned from Procedure.
+
+  Must be called on the BSP. If the APs cannot be started, Procedure runs on
+  the BSP alone.
+
+  @param[in] Procedure  The procedure to run.
+  @param[in] Argument   Argument passed to Procedure.
+
+**/
+VOID
+ApWorkQueueBackendRunOnAllProcessors (
+  IN AP_WORK_QUEUE_PROCEDURE  Procedure,
+  IN VOID                     *Argument
+  );
+
+#endif
@@ -0,0 +1,189 @@
+/** @file
+  MP services backend of the AP work queue library for DXE drivers and UEFI
+  applications, on top of EFI_MP_SERVICES_PROTOCOL.
+
+  The APs are started in non-blocking mode so that the BSP can take part in the
+  session. The BSP does not wait for the completion event; it counts the APs
+  that returned from the session procedure instead.
+
+  Copyright (c) 2026, Intel Corporation. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include "ApWorkQueueLibInternal.h"
+#include <Library/UefiBootServicesTableLib.h>
+#include <Protocol/MpService.h>
+
+//
+// Number of times StartupAllAPs () is retried while APs that just returned
+// from the previous session have not been reported idle yet.
+//
+#define DXE_AP_WORK_QUEUE_STARTUP_RETRIES  10000
+
+STATIC EFI_MP_SERVICES_PROTOCOL  *mMpServices = NULL;
+STATIC EFI_EVENT                 mApDoneEvent = NULL;
+STATIC AP_WORK_QUEUE_PROCEDURE   mApProcedure;
+STATIC VOID                      *mApArgument;
+STATIC volatile UINT32           mApExitCount;
+
+/**
+  Session entry point of the APs.
+
+  @param[in] Buffer  Not used.
+
+**/
+STATIC
+VOID
+EFIAPI
+DxeApWorkQueueApProcedure (
+  IN VOID  *Buffer
+  )
+{
+  mApProcedure (mApArgument);
+  InterlockedIncrement (&mApExitCount);
+}
+
+/**
+  Locates the MP services and reports the processors that take part in the
+  work queue.
+
+  On failure the backend reports a single worker and runs every session on
+  the BSP alone.
+
+  @param[out] ProcessorCount  Number of processor numbers ApWorkQueueBackendWhoAmI ()
+                              may return. Processor numbers are below this value.
+  @param[out] WorkerCount     Number of enabled processors, including the BSP.
+
+**/
+VOID
+ApWorkQueueBackendInitialize (
+  OUT UINTN  *ProcessorCount,
+  OUT UINTN  *WorkerCount
+  )
+{
+  EFI_STATUS  Status;
+  UINTN       NumberOfProcessors;
+  UINTN       NumberOfEnabledProcessors;
+
+  *ProcessorCount = 1;
+  *WorkerCount    = 1;
+
+  Status = gBS->LocateProtocol (&gEfiMpServiceProtocolGuid, NULL, (VOID **)&mMpServices);
+  if (EFI_ERROR (Status)) {
+    mMpServices = NULL;
+    return;
+  }
+
+  Status = mMpServices->GetNumberOfProcessors (mMpServices, &NumberOfProcessors, &NumberOfEnabledProcessors);
+  if (EFI_ERROR (Status) || (NumberOfEnabledProcessors < 2)) {
+    return;
+  }
+
+  //
+  // StartupAllAPs () only runs in non-blocking mode with an event. The event
+  // has no notification function and is never waited for.
+  //
+  Status = gBS->CreateEvent (0, TPL_CALLBACK, NULL, NULL, &mApDoneEvent);
+  if (EFI_ERROR (Status)) {
+    mApDoneEvent = NULL;
+    return;
+  }
+
+  *ProcessorCount = NumberOfProcessors;
+  *WorkerCount    = NumberOfEnabledProcessors;
+}
+
+/**
+  Returns the number of the calling processor.
+
+  @return The processor number, below the ProcessorCount reported by
+          ApWorkQueueBackendInitialize ().
+
+**/
+UINTN
+ApWorkQueueBackendWhoAmI (
+  VOID
+  )
+{
+  EFI_STATUS  Status;
+  UINTN       ProcessorNumber;
+
+  if (mMpServices == NULL) {
+    return 0;
+  }
+
+  Status = mMpServices->WhoAmI (mMpServices, &ProcessorNumber);
+  ASSERT_EFI_ERROR (Status);
+  return ProcessorNumber;
+}
+
+/**
+  Runs Procedure on the BSP and on all enabled APs at the same time, and
+  returns once every processor returned from Procedure.
+
+  Must be called on the BSP. If the APs cannot be started, Procedure runs on
+  the BSP alone.
+
+  @param[in] Procedure  The procedure to run.
+  @param[in] Argument   Argument passed to Procedure.
+
+**/
+VOID
+ApWorkQueueBackendRunOnAllProcessors (
+  IN AP_WORK_QUEUE_PROCEDURE  Procedure,
+  IN VOID                     *Argument
+  )
+{
+  EFI_STATUS  Status;
+  UINTN       NumberOfProcessors;
+  UINTN       NumberOfEnabledProcessors;
+  UINTN       Retry;
+
+  if ((mMpServices == NULL) || (mApDoneEvent == NULL)) {
+    Procedure (Argument);
+    return;
+  }
+
+  Status = mMpServices->GetNumberOfProcessors (mMpServices, &NumberOfProcessors, &NumberOfEnabledProcessors);
+  if (EFI_ERROR (Status) || (NumberOfEnabledProcessors < 2)) {
+    Procedure (Argument);
+    return;
+  }
+
+  mApProcedure = Procedure;
+  mApArgument  = Argument;
+  mApExitCount = 0;
+
+  for (Retry = 0; ; Retry++) {
+    Status = mMpServices->StartupAllAPs (
+                            mMpServices,
+                            DxeApWorkQueueApProcedure,
+                            FALSE,
+                            mApDoneEvent,
+                            0,
+                            NULL,
+                            NULL
+                            );
+    if ((Status != EFI_NOT_READY) || (Retry == DXE_AP_WORK_QUEUE_STARTUP_RETRIES)) {
+      break;
+    }
+
+    CpuPause ();
+  }
+
+  if (EFI_ERROR (Status)) {
+    //
+    // The APs are busy with other work or the MP services no longer accept
+    // non-blocking calls. The BSP drains the queue alone.
+    //
+    DEBUG ((DEBUG_VERBOSE, "%a: StartupAllAPs - %r, running on the BSP only\n", __func__, Status));
+    Procedure (Argument);
+    return;
+  }
+
+  Procedure (Argument);
+  while (mApExitCount != NumberOfEnabledProcessors - 1) {
+    CpuPause ();
+  }
+}
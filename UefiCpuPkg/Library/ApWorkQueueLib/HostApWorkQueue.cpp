@@ -0,0 +1,96 @@
+/** @file
+  Host thread backend of the AP work queue library for host-based unit tests.
+
+  Every session spawns one host thread per emulated AP; the calling thread acts
+  as the BSP. At least HOST_AP_WORK_QUEUE_MIN_WORKERS workers are emulated so
+  that stealing and loop sharing are exercised on small build machines too.
+
+  Copyright (c) 2026, Intel Corporation. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include <thread>
+#include <vector>
+
+extern "C" {
+  #include "ApWorkQueueLibInternal.h"
+}
+
+#define HOST_AP_WORK_QUEUE_MIN_WORKERS  4
+#define HOST_AP_WORK_QUEUE_MAX_WORKERS  16
+
+static UINTN               mHostWorkerCount = 1;
+static thread_local UINTN  mHostProcessorNumber;
+
+/**
+  Reports the emulated processors that take part in the work queue.
+
+  @param[out] ProcessorCount  Number of processor numbers ApWorkQueueBackendWhoAmI ()
+                              may return. Processor numbers are below this value.
+  @param[out] WorkerCount     Number of enabled processors, including the BSP.
+
+**/
+VOID
+ApWorkQueueBackendInitialize (
+  OUT UINTN  *ProcessorCount,
+  OUT UINTN  *WorkerCount
+  )
+{
+  UINTN  Count;
+
+  Count = std::thread::hardware_concurrency ();
+  Count = MAX (Count, HOST_AP_WORK_QUEUE_MIN_WORKERS);
+  Count = MIN (Count, HOST_AP_WORK_QUEUE_MAX_WORKERS);
+
+  mHostWorkerCount = Count;
+  *ProcessorCount  = Count;
+  *WorkerCount     = Count;
+}
+
+/**
+  Returns the number of the calling processor.
+
+  @return The emulated processor number. The thread that initialized the
+          library is processor 0.
+
+**/
+UINTN
+ApWorkQueueBackendWhoAmI (
+  VOID
+  )
+{
+  return mHostProcessorNumber;
+}
+
+/**
+  Runs Procedure on the calling thread and on one host thread per emulated AP,
+  and returns once every thread returned from Procedure.
+
+  @param[in] Procedure  The procedure to run.
+  @param[in] Argument   Argument passed to Procedure.
+
+**/
+VOID
+ApWorkQueueBackendRunOnAllProcessors (
+  IN AP_WORK_QUEUE_PROCEDURE  Procedure,
+  IN VOID                     *Argument
+  )
+{
+  std::vector<std::thread>  Aps;
+  UINTN                     Index;
+
+  for (Index = 1; Index < mHostWorkerCount; Index++) {
+    Aps.emplace_back (
+          [Procedure, Argument, Index]() {
+      mHostProcessorNumber = Index;
+      Procedure (Argument);
+    }
+          );
+  }
+
+  Procedure (Argument);
+  for (auto &Ap : Aps) {
+    Ap.join ();
+  }
+}
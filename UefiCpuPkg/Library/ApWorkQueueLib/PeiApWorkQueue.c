@@ -0,0 +1,115 @@
+/** @file
+  MP services backend of the AP work queue library for PEIMs, on top of
+  EFI_PEI_MP_SERVICES2_PPI.
+
+  The library keeps its state in global variables, so it may only be used by
+  PEIMs that run from memory after permanent memory is installed.
+
+  Copyright (c) 2026, Intel Corporation. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include <PiPei.h>
+
+#include "ApWorkQueueLibInternal.h"
+#include <Library/PeiServicesLib.h>
+#include <Ppi/MpServices2.h>
+
+STATIC EFI_PEI_MP_SERVICES2_PPI  *mMpServices2 = NULL;
+
+/**
+  Locates the MP services and reports the processors that take part in the
+  work queue.
+
+  On failure the backend reports a single worker and runs every session on
+  the BSP alone.
+
+  @param[out] ProcessorCount  Number of processor numbers ApWorkQueueBackendWhoAmI ()
+                              may return. Processor numbers are below this value.
+  @param[out] WorkerCount     Number of enabled processors, including the BSP.
+
+**/
+VOID
+ApWorkQueueBackendInitialize (
+  OUT UINTN  *ProcessorCount,
+  OUT UINTN  *WorkerCount
+  )
+{
+  EFI_STATUS  Status;
+  UINTN       NumberOfProcessors;
+  UINTN       NumberOfEnabledProcessors;
+
+  *ProcessorCount = 1;
+  *WorkerCount    = 1;
+
+  Status = PeiServicesLocatePpi (&gEfiPeiMpServices2PpiGuid, 0, NULL, (VOID **)&mMpServices2);
+  if (EFI_ERROR (Status)) {
+    mMpServices2 = NULL;
+    return;
+  }
+
+  Status = mMpServices2->GetNumberOfProcessors (mMpServices2, &NumberOfProcessors, &NumberOfEnabledProcessors);
+  if (EFI_ERROR (Status) || (NumberOfEnabledProcessors < 2)) {
+    mMpServices2 = NULL;
+    return;
+  }
+
+  *ProcessorCount = NumberOfProcessors;
+  *WorkerCount    = NumberOfEnabledProcessors;
+}
+
+/**
+  Returns the number of the calling processor.
+
+  @return The processor number, below the ProcessorCount reported by
+          ApWorkQueueBackendInitialize ().
+
+**/
+UINTN
+ApWorkQueueBackendWhoAmI (
+  VOID
+  )
+{
+  EFI_STATUS  Status;
+  UINTN       ProcessorNumber;
+
+  if (mMpServices2 == NULL) {
+    return 0;
+  }
+
+  Status = mMpServices2->WhoAmI (mMpServices2, &ProcessorNumber);
+  ASSERT_EFI_ERROR (Status);
+  return ProcessorNumber;
+}
+
+/**
+  Runs Procedure on the BSP and on all enabled APs at the same time, and
+  returns once every processor returned from Procedure.
+
+  Must be called on the BSP. If the APs cannot be started, Procedure runs on
+  the BSP alone.
+
+  @param[in] Procedure  The procedure to run.
+  @param[in] Argument   Argument passed to Procedure.
+
+**/
+VOID
+ApWorkQueueBackendRunOnAllProcessors (
+  IN AP_WORK_QUEUE_PROCEDURE  Procedure,
+  IN VOID                     *Argument
+  )
+{
+  EFI_STATUS  Status;
+
+  if (mMpServices2 == NULL) {
+    Procedure (Argument);
+    return;
+  }
+
+  Status = mMpServices2->StartupAllCPUs (mMpServices2, Procedure, 0, Argument);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_VERBOSE, "%a: StartupAllCPUs - %r, running on the BSP only\n", __func__, Status));
+    Procedure (Argument);
+  }
+}
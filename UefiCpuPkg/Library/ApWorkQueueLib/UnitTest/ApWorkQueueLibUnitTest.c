@@ -0,0 +1,548 @@
+/** @file
+  Unit tests of the AP work queue library, run on the host thread backend.
+
+  Copyright (c) 2026, Intel Corporation. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include <Uefi.h>
+#include <Library/ApWorkQueueLib.h>
+#include <Library/BaseLib.h>
+#include <Library/BaseMemoryLib.h>
+#include <Library/DebugLib.h>
+#include <Library/MemoryAllocationLib.h>
+#include <Library/SynchronizationLib.h>
+#include <Library/UnitTestLib.h>
+
+#define UNIT_TEST_APP_NAME     "ApWorkQueueLib Unit Tests"
+#define UNIT_TEST_APP_VERSION  "1.0"
+
+#define LOOP_RANGE_SIZE    100003
+#define MATRIX_ROWS        37
+#define MATRIX_COLUMNS     1009
+#define TASK_COUNT         64
+#define OVERFLOW_TASKS     300
+#define FIBONACCI_INPUT    20
+#define FIBONACCI_RESULT   6765
+#define STEAL_SPIN_LIMIT   100000000
+
+typedef struct {
+  UINTN              Start;
+  volatile UINT32    *Hits;
+} LOOP_CONTEXT;
+
+typedef struct {
+  UINTN         Input;
+  UINTN         Result;
+  EFI_STATUS    Status;
+} TASK_CONTEXT;
+
+typedef struct {
+  volatile UINT32    *Hits;
+  UINTN              Grain;
+} MATRIX_CONTEXT;
+
+typedef struct {
+  UINTN    N;
+  UINTN    Result;
+} FIBONACCI_CONTEXT;
+
+STATIC volatile UINT32  mRunningTasks;
+STATIC volatile UINT32  mMaxRunningTasks;
+
+/**
+  Loop body counting every visit of an index.
+
+  @param[in] Index    The loop index.
+  @param[in] Context  The LOOP_CONTEXT.
+
+**/
+STATIC
+VOID
+EFIAPI
+CountIndex (
+  IN UINTN  Index,
+  IN VOID   *Context
+  )
+{
+  LOOP_CONTEXT  *Loop;
+
+  Loop = (LOOP_CONTEXT *)Context;
+  InterlockedIncrement (&Loop->Hits[Index - Loop->Start]);
+}
+
+/**
+  Task squaring its input and returning the status requested by the test.
+
+  @param[in] Context  The TASK_CONTEXT.
+
+  @return The status stored in the TASK_CONTEXT.
+
+**/
+STATIC
+EFI_STATUS
+EFIAPI
+SquareTask (
+  IN VOID  *Context
+  )
+{
+  TASK_CONTEXT  *Task;
+
+  Task         = (TASK_CONTEXT *)Context;
+  Task->Result = Task->Input * Task->Input;
+  return Task->Status;
+}
+
+/**
+  Task computing a Fibonacci number by submitting and waiting for two
+  sub-tasks, which exercises nested submission and helping waits.
+
+  @param[in] Context  The FIBONACCI_CONTEXT.
+
+  @retval EFI_SUCCESS  The result was computed.
+
+**/
+STATIC
+EFI_STATUS
+EFIAPI
+FibonacciTask (
+  IN VOID  *Context
+  )
+{
+  FIBONACCI_CONTEXT     *Fibonacci;
+  FIBONACCI_CONTEXT     Children[2];
+  AP_WORK_QUEUE_FUTURE  Futures[2];
+  EFI_STATUS            Status;
+
+  Fibonacci = (FIBONACCI_CONTEXT *)Context;
+  if (Fibonacci->N < 2) {
+    Fibonacci->Result = Fibonacci->N;
+    return EFI_SUCCESS;
+  }
+
+  Children[0].N = Fibonacci->N - 1;
+  Children[1].N = Fibonacci->N - 2;
+  Status        = ApWorkQueueSubmit (FibonacciTask, &Children[0], &Futures[0]);
+  ASSERT_EFI_ERROR (Status);
+  Status = ApWorkQueueSubmit (FibonacciTask, &Children[1], &Futures[1]);
+  ASSERT_EFI_ERROR (Status);
+
+  ApWorkQueueWait (&Futures[1]);
+  ApWorkQueueWait (&Futures[0]);
+  Fibonacci->Result = Children[0].Result + Children[1].Result;
+  return EFI_SUCCESS;
+}
+
+/**
+  Outer loop body of the nested loop test, starting an inner parallel loop
+  over one matrix row.
+
+  @param[in] Index    The matrix row.
+  @param[in] Context  The MATRIX_CONTEXT.
+
+**/
+STATIC
+VOID
+EFIAPI
+MatrixRow (
+  IN UINTN  Index,
+  IN VOID   *Context
+  )
+{
+  MATRIX_CONTEXT  *Matrix;
+  LOOP_CONTEXT    Row;
+  EFI_STATUS      Status;
+
+  Matrix    = (MATRIX_CONTEXT *)Context;
+  Row.Start = 0;
+  Row.Hits  = &Matrix->Hits[Index * MATRIX_COLUMNS];
+  Status    = ApWorkQueueParallelFor (0, MATRIX_COLUMNS, Matrix->Grain, CountIndex, &Row);
+  ASSERT_EFI_ERROR (Status);
+}
+
+/**
+  Task that stays running until another task runs at the same time, or until
+  a spin limit expires.
+
+  @param[in] Context  Not used.
+
+  @retval EFI_SUCCESS  Always.
+
+**/
+STATIC
+EFI_STATUS
+EFIAPI
+OverlapTask (
+  IN VOID  *Context
+  )
+{
+  UINT32  Running;
+  UINT32  Max;
+  UINTN   Spin;
+
+  Running = InterlockedIncrement (&mRunningTasks);
+  do {
+    Max = mMaxRunningTasks;
+  } while ((Running > Max) && (InterlockedCompareExchange32 (&mMaxRunningTasks, Max, Running) != Max));
+
+  for (Spin = 0; (Spin < STEAL_SPIN_LIMIT) && (mMaxRunningTasks < 2); Spin++) {
+    CpuPause ();
+  }
+
+  InterlockedDecrement (&mRunningTasks);
+  return EFI_SUCCESS;
+}
+
+/**
+  Verifies that the host backend emulates several worker processors.
+
+  @param[in] Context  Not used.
+
+  @retval UNIT_TEST_PASSED  The test passed.
+
+**/
+STATIC
+UNIT_TEST_STATUS
+EFIAPI
+TestWorkerCount (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  UT_ASSERT_TRUE (ApWorkQueueGetWorkerCount () > 1);
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  Verifies the parameter checks of the loop and task services.
+
+  @param[in] Context  Not used.
+
+  @retval UNIT_TEST_PASSED  The test passed.
+
+**/
+STATIC
+UNIT_TEST_STATUS
+EFIAPI
+TestInvalidParameters (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  AP_WORK_QUEUE_FUTURE  Future;
+  LOOP_CONTEXT          Loop;
+
+  UT_ASSERT_STATUS_EQUAL (ApWorkQueueParallelFor (0, 10, 1, NULL, NULL), EFI_INVALID_PARAMETER);
+  UT_ASSERT_STATUS_EQUAL (ApWorkQueueParallelFor (10, 9, 1, CountIndex, &Loop), EFI_INVALID_PARAMETER);
+  UT_ASSERT_NOT_EFI_ERROR (ApWorkQueueParallelFor (10, 10, 1, CountIndex, &Loop));
+
+  UT_ASSERT_STATUS_EQUAL (ApWorkQueueSubmit (NULL, NULL, &Future), EFI_INVALID_PARAMETER);
+  UT_ASSERT_STATUS_EQUAL (ApWorkQueueSubmit (SquareTask, NULL, NULL), EFI_INVALID_PARAMETER);
+
+  ZeroMem (&Future, sizeof (Future));
+  UT_ASSERT_STATUS_EQUAL (ApWorkQueueWait (&Future), EFI_INVALID_PARAMETER);
+  UT_ASSERT_STATUS_EQUAL (ApWorkQueueWait (NULL), EFI_INVALID_PARAMETER);
+  UT_ASSERT_FALSE (ApWorkQueueIsComplete (&Future));
+  UT_ASSERT_FALSE (ApWorkQueueIsComplete (NULL));
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  Verifies that a parallel loop visits every index exactly once for several
+  chunk sizes, including ranges that do not start at 0.
+
+  @param[in] Context  Not used.
+
+  @retval UNIT_TEST_PASSED  The test passed.
+
+**/
+STATIC
+UNIT_TEST_STATUS
+EFIAPI
+TestParallelForCoverage (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  STATIC CONST UINTN  Grains[] = { 0, 1, 7, 4096, LOOP_RANGE_SIZE, LOOP_RANGE_SIZE * 2 };
+  STATIC CONST UINTN  Starts[] = { 0, 5, MAX_UINTN - LOOP_RANGE_SIZE };
+  LOOP_CONTEXT        Loop;
+  UINTN               GrainIndex;
+  UINTN               StartIndex;
+  UINTN               Index;
+
+  Loop.Hits = AllocatePool (LOOP_RANGE_SIZE * sizeof (UINT32));
+  UT_ASSERT_NOT_NULL (Loop.Hits);
+
+  for (StartIndex = 0; StartIndex < ARRAY_SIZE (Starts); StartIndex++) {
+    for (GrainIndex = 0; GrainIndex < ARRAY_SIZE (Grains); GrainIndex++) {
+      ZeroMem ((VOID *)Loop.Hits, LOOP_RANGE_SIZE * sizeof (UINT32));
+      Loop.Start = Starts[StartIndex];
+      UT_ASSERT_NOT_EFI_ERROR (
+        ApWorkQueueParallelFor (Loop.Start, Loop.Start + LOOP_RANGE_SIZE, Grains[GrainIndex], CountIndex, &Loop)
+        );
+      for (Index = 0; Index < LOOP_RANGE_SIZE; Index++) {
+        UT_ASSERT_EQUAL (Loop.Hits[Index], 1);
+      }
+    }
+  }
+
+  FreePool ((VOID *)Loop.Hits);
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  Verifies that parallel loops started from inside a parallel loop complete
+  and visit every index exactly once.
+
+  @param[in] Context  Not used.
+
+  @retval UNIT_TEST_PASSED  The test passed.
+
+**/
+STATIC
+UNIT_TEST_STATUS
+EFIAPI
+TestNestedParallelFor (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  MATRIX_CONTEXT  Matrix;
+  UINTN           Index;
+
+  Matrix.Hits  = AllocateZeroPool (MATRIX_ROWS * MATRIX_COLUMNS * sizeof (UINT32));
+  Matrix.Grain = 16;
+  UT_ASSERT_NOT_NULL (Matrix.Hits);
+
+  UT_ASSERT_NOT_EFI_ERROR (ApWorkQueueParallelFor (0, MATRIX_ROWS, 1, MatrixRow, &Matrix));
+  for (Index = 0; Index < MATRIX_ROWS * MATRIX_COLUMNS; Index++) {
+    UT_ASSERT_EQUAL (Matrix.Hits[Index], 1);
+  }
+
+  FreePool ((VOID *)Matrix.Hits);
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  Verifies that futures report the result and status of their tasks.
+
+  @param[in] Context  Not used.
+
+  @retval UNIT_TEST_PASSED  The test passed.
+
+**/
+STATIC
+UNIT_TEST_STATUS
+EFIAPI
+TestFutures (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  TASK_CONTEXT          Tasks[TASK_COUNT];
+  AP_WORK_QUEUE_FUTURE  Futures[TASK_COUNT];
+  UINTN                 Index;
+
+  for (Index = 0; Index < TASK_COUNT; Index++) {
+    Tasks[Index].Input  = Index;
+    Tasks[Index].Result = 0;
+    Tasks[Index].Status = ((Index % 5) == 3) ? EFI_ABORTED : EFI_SUCCESS;
+    UT_ASSERT_NOT_EFI_ERROR (ApWorkQueueSubmit (SquareTask, &Tasks[Index], &Futures[Index]));
+  }
+
+  //
+  // Waiting for the last task drains the whole queue.
+  //
+  UT_ASSERT_STATUS_EQUAL (ApWorkQueueWait (&Futures[TASK_COUNT - 1]), Tasks[TASK_COUNT - 1].Status);
+  for (Index = 0; Index < TASK_COUNT; Index++) {
+    UT_ASSERT_TRUE (ApWorkQueueIsComplete (&Futures[Index]));
+    UT_ASSERT_STATUS_EQUAL (ApWorkQueueWait (&Futures[Index]), Tasks[Index].Status);
+    UT_ASSERT_EQUAL (Tasks[Index].Result, Index * Index);
+  }
+
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  Verifies tasks that submit and wait for sub-tasks.
+
+  @param[in] Context  Not used.
+
+  @retval UNIT_TEST_PASSED  The test passed.
+
+**/
+STATIC
+UNIT_TEST_STATUS
+EFIAPI
+TestNestedTasks (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  FIBONACCI_CONTEXT     Fibonacci;
+  AP_WORK_QUEUE_FUTURE  Future;
+
+  Fibonacci.N      = FIBONACCI_INPUT;
+  Fibonacci.Result = 0;
+  UT_ASSERT_NOT_EFI_ERROR (ApWorkQueueSubmit (FibonacciTask, &Fibonacci, &Future));
+  UT_ASSERT_NOT_EFI_ERROR (ApWorkQueueWait (&Future));
+  UT_ASSERT_EQUAL (Fibonacci.Result, FIBONACCI_RESULT);
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  Verifies that tasks submitted to a full deque run inline and that every
+  task still completes.
+
+  @param[in] Context  Not used.
+
+  @retval UNIT_TEST_PASSED  The test passed.
+
+**/
+STATIC
+UNIT_TEST_STATUS
+EFIAPI
+TestDequeOverflow (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  TASK_CONTEXT          *Tasks;
+  AP_WORK_QUEUE_FUTURE  *Futures;
+  UINTN                 Index;
+  UINTN                 Inline;
+
+  Tasks   = AllocateZeroPool (OVERFLOW_TASKS * sizeof (TASK_CONTEXT));
+  Futures = AllocateZeroPool (OVERFLOW_TASKS * sizeof (AP_WORK_QUEUE_FUTURE));
+  UT_ASSERT_NOT_NULL (Tasks);
+  UT_ASSERT_NOT_NULL (Futures);
+
+  //
+  // Tasks submitted from the BSP outside of a session only start once the BSP
+  // waits, so every task completed on return from ApWorkQueueSubmit () ran
+  // inline because the deque was full.
+  //
+  Inline = 0;
+  for (Index = 0; Index < OVERFLOW_TASKS; Index++) {
+    Tasks[Index].Input = Index;
+    UT_ASSERT_NOT_EFI_ERROR (ApWorkQueueSubmit (SquareTask, &Tasks[Index], &Futures[Index]));
+    if (ApWorkQueueIsComplete (&Futures[Index])) {
+      Inline++;
+    }
+  }
+
+  UT_ASSERT_TRUE (Inline > 0);
+  UT_ASSERT_TRUE (Inline < OVERFLOW_TASKS);
+
+  for (Index = 0; Index < OVERFLOW_TASKS; Index++) {
+    UT_ASSERT_NOT_EFI_ERROR (ApWorkQueueWait (&Futures[Index]));
+    UT_ASSERT_EQUAL (Tasks[Index].Result, Index * Index);
+  }
+
+  FreePool (Tasks);
+  FreePool (Futures);
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  Verifies that idle processors steal tasks that were all queued on the BSP.
+
+  @param[in] Context  Not used.
+
+  @retval UNIT_TEST_PASSED  The test passed.
+
+**/
+STATIC
+UNIT_TEST_STATUS
+EFIAPI
+TestStealing (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  AP_WORK_QUEUE_FUTURE  Futures[8];
+  UINTN                 Index;
+
+  mRunningTasks    = 0;
+  mMaxRunningTasks = 0;
+  for (Index = 0; Index < ARRAY_SIZE (Futures); Index++) {
+    UT_ASSERT_NOT_EFI_ERROR (ApWorkQueueSubmit (OverlapTask, NULL, &Futures[Index]));
+  }
+
+  for (Index = 0; Index < ARRAY_SIZE (Futures); Index++) {
+    UT_ASSERT_NOT_EFI_ERROR (ApWorkQueueWait (&Futures[Index]));
+  }
+
+  UT_ASSERT_TRUE (mMaxRunningTasks >= 2);
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  Initialize the unit test framework, suite, and unit tests for the
+  ApWorkQueueLib and run the ApWorkQueueLib unit tests.
+
+  @retval  EFI_SUCCESS           All test cases were dispatched.
+  @retval  EFI_OUT_OF_RESOURCES  There are not enough resources available to
+                                 initialize the unit tests.
+**/
+STATIC
+EFI_STATUS
+EFIAPI
+UnitTestingEntry (
+  VOID
+  )
+{
+  EFI_STATUS                  Status;
+  UNIT_TEST_FRAMEWORK_HANDLE  Framework;
+  UNIT_TEST_SUITE_HANDLE      ApWorkQueueTests;
+
+  Framework = NULL;
+
+  DEBUG ((DEBUG_INFO, "%a v%a\n", UNIT_TEST_APP_NAME, UNIT_TEST_APP_VERSION));
+
+  //
+  // Setup the test framework for running the tests.
+  //
+  Status = InitUnitTestFramework (&Framework, UNIT_TEST_APP_NAME, gEfiCallerBaseName, UNIT_TEST_APP_VERSION);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "Failed in InitUnitTestFramework. Status = %r\n", Status));
+    goto EXIT;
+  }
+
+  Status = CreateUnitTestSuite (&ApWorkQueueTests, Framework, "ApWorkQueueLib Tests", "ApWorkQueueLib", NULL, NULL);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "Failed in CreateUnitTestSuite for ApWorkQueueLib Tests\n"));
+    Status = EFI_OUT_OF_RESOURCES;
+    goto EXIT;
+  }
+
+  //
+  // --------------Suite-----------Description--------------Name----------Function--------Pre---Post-------------------Context-----------
+  //
+  AddTestCase (ApWorkQueueTests, "Worker count", "WorkerCount", TestWorkerCount, NULL, NULL, NULL);
+  AddTestCase (ApWorkQueueTests, "Invalid parameters", "InvalidParameters", TestInvalidParameters, NULL, NULL, NULL);
+  AddTestCase (ApWorkQueueTests, "Parallel loop coverage", "ParallelForCoverage", TestParallelForCoverage, NULL, NULL, NULL);
+  AddTestCase (ApWorkQueueTests, "Nested parallel loops", "NestedParallelFor", TestNestedParallelFor, NULL, NULL, NULL);
+  AddTestCase (ApWorkQueueTests, "Futures", "Futures", TestFutures, NULL, NULL, NULL);
+  AddTestCase (ApWorkQueueTests, "Nested tasks", "NestedTasks", TestNestedTasks, NULL, NULL, NULL);
+  AddTestCase (ApWorkQueueTests, "Deque overflow", "DequeOverflow", TestDequeOverflow, NULL, NULL, NULL);
+  AddTestCase (ApWorkQueueTests, "Work stealing", "Stealing", TestStealing, NULL, NULL, NULL);
+
+  //
+  // Execute the tests.
+  //
+  Status = RunAllTestSuites (Framework);
+
+EXIT:
+  if (Framework != NULL) {
+    FreeUnitTestFramework (Framework);
+  }
+
+  return Status;
+}
+
+/**
+  Standard POSIX C entry point for host based unit test execution.
+**/
+int
+main (
+  int   argc,
+  char  *argv[]
+  )
+{
+  return UnitTestingEntry ();
+}